@@ -8,6 +8,7 @@
 #include "Utility.h"
 #include "ProgramManager.h"
 #include "Program.h"
+#include "BatchRenderer.h"
 
 Voxel::UI::AnimatedImage::AnimatedImage(const std::string & name)
 	: RenderNode(name)
@@ -159,6 +160,11 @@ void Voxel::UI::AnimatedImage::build(const std::vector<float>& vertices, const s
 	glDeleteBuffers(1, &vbo);
 	glDeleteBuffers(1, &uvbo);
 	glDeleteBuffers(1, &ibo);
+
+	// Keep copy for batch
+	batchVertices.assign(vertices.begin(), vertices.end());
+	batchUVs.assign(uvs.begin(), uvs.end());
+	batchIndices.assign(indices.begin(), indices.end());
 }
 
 void Voxel::UI::AnimatedImage::start()
@@ -246,6 +252,8 @@ void Voxel::UI::AnimatedImage::update(const float delta)
 		// Frame changed. Update bounding box size
 		boundingBox.size = frameSizes.at(currentFrameIndex);
 
+		markBoundingVolumeDirty();
+
 #if V_DEBUG && V_DEBUG_DRAW_UI_BOUNDING_BOX && V_DEBUG_DRAW_ANIMATED_IMAGE_BOUNDING_BOX
 		// If debug, ui bounding box and animated image bounding box is enabled, create debug boudning box line
 		createDebugBoundingBoxLine();
@@ -324,7 +332,7 @@ bool Voxel::UI::AnimatedImage::updateMouseMove(const glm::vec2 & mousePosition,
 			auto rit = children.rbegin();
 			for (; rit != children.rend();)
 			{
-				bool result = (rit->second)->updateMouseMove(mousePosition, mouseDelta);
+				bool result = (rit->second)->updateMouseMoveCulled(mousePosition, mouseDelta);
 				if (result)
 				{
 					// child hovered
@@ -344,7 +352,7 @@ bool Voxel::UI::AnimatedImage::updateMouseMove(const glm::vec2 & mousePosition,
 
 				for (; rit != children.rend(); rit++)
 				{
-					(rit->second)->updateMouseMoveFalse();
+					(rit->second)->updateMouseMoveFalseCulled();
 				}
 
 				updateMouseMoveFalse();
@@ -443,15 +451,28 @@ bool Voxel::UI::AnimatedImage::updateMouseRelease(const glm::vec2 & mousePositio
 	}
 }
 
+bool Voxel::UI::AnimatedImage::appendBatch(BatchRenderer & batchRenderer)
+{
+	if (texture == nullptr || batchIndices.empty())
+	{
+		return false;
+	}
+
+	// Only current frame
+	batchRenderer.appendGeometry(texture, batchVertices, batchUVs, batchIndices, currentIndex, 6, glm::scale(modelMat, glm::vec3(scale, 1)), glm::vec4(color, opacity));
+
+	return true;
+}
+
 void Voxel::UI::AnimatedImage::renderSelf()
 {
 	if (texture == nullptr) return;
 	if (program == nullptr) return;
 
 	program->use(true);
-	program->setUniformMat4("modelMat", glm::scale(modelMat, glm::vec3(scale, 1)));
-	program->setUniformFloat("opacity", opacity);
-	program->setUniformVec3("color", color);
+	program->setUniformMat4(SID("modelMat"), glm::scale(modelMat, glm::vec3(scale, 1)));
+	program->setUniformFloat(SID("opacity"), opacity);
+	program->setUniformVec3(SID("color"), color);
 
 	texture->activate(GL_TEXTURE0);
 	texture->bind();
@@ -468,9 +489,9 @@ void Voxel::UI::AnimatedImage::renderSelf()
 	{
 		auto lineProgram = ProgramManager::getInstance().getProgram(Voxel::ProgramManager::PROGRAM_NAME::LINE_SHADER);
 		lineProgram->use(true);
-		lineProgram->setUniformMat4("modelMat", modelMat);
-		lineProgram->setUniformMat4("viewMat", glm::mat4(1.0f));
-		lineProgram->setUniformVec4("lineColor", glm::vec4(1.0f));
+		lineProgram->setUniformMat4(SID("modelMat"), modelMat);
+		lineProgram->setUniformMat4(SID("viewMat"), glm::mat4(1.0f));
+		lineProgram->setUniformVec4(SID("lineColor"), glm::vec4(1.0f));
 
 		glBindVertexArray(bbVao);
 		glDrawArrays(GL_LINES, 0, 8);
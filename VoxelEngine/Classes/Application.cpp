@@ -20,8 +20,11 @@
 #include "FontManager.h"
 #include "FileSystem.h"
 #include "Logger.h"
+#include "AsyncLogger.h"
+#include "FrameProfiler.h"
 #include "GLView.h"
 #include "LocalizationTags.h"
+#include "AssetLoader.h"
 
 // boost. 
 //#include <boost\predef.h>
@@ -43,6 +46,9 @@ Application::Application()
 	auto logger = &Voxel::Logger::getInstance();
 
 	logger->info("[Application] Initializing application");
+
+	// Worker threads log through async logger. Started after logger so it's destroyed before logger.
+	AsyncLogger::getInstance().start();
 	/*
 	// old version
 	cout << "Creating Application" << endl;
@@ -66,6 +72,8 @@ Application::~Application()
 {
 	cleanUp();
 
+	AsyncLogger::getInstance().stop();
+
 	Voxel::Logger::getInstance().flush();
 }
 
@@ -82,6 +90,9 @@ void Application::init()
 
 	initFonts();
 
+	// Loader threads decode assets. Uploads run in main loop.
+	AssetLoader::getInstance().init();
+
 	initSpriteSheets();
 
 	initDirector();
@@ -125,11 +136,12 @@ void Voxel::Application::initFonts()
 	auto& fm = FontManager::getInstance();
 	auto& setting = Setting::getInstance();
 
-	if (!fm.addFont("Pixel.ttf", 10, 0, setting.getLocalizationTag()))
+	// Menu and debug fonts are used right away. Preload.
+	if (!fm.addFont("Pixel.ttf", 10, 0, setting.getLocalizationTag(), true))
 	{
 	}
 
-	if (!fm.addFont("Pixel.ttf", 10, 2, setting.getLocalizationTag()))
+	if (!fm.addFont("Pixel.ttf", 10, 2, setting.getLocalizationTag(), true))
 	{
 
 	}
@@ -147,14 +159,19 @@ void Voxel::Application::initFonts()
 
 void Voxel::Application::initSpriteSheets()
 {
-	auto& sm = SpriteSheetManager::getInstance();
+	auto& loader = AssetLoader::getInstance();
 
-	sm.addSpriteSheet("GlobalSpriteSheet.json");
-	sm.addSpriteSheet("CursorSpriteSheet.json");
+	// Decode in parallel. Director and cursor need these right away, so wait.
+	std::vector<std::shared_ptr<AssetHandle>> handles;
+
+	handles.push_back(loader.loadSpriteSheetAsync("GlobalSpriteSheet.json"));
+	handles.push_back(loader.loadSpriteSheetAsync("CursorSpriteSheet.json"));
 
 #if V_DEBUG
-	sm.addSpriteSheet("DebugSpriteSheet.json");
+	handles.push_back(loader.loadSpriteSheetAsync("DebugSpriteSheet.json"));
 #endif
+
+	loader.wait(handles);
 }
 
 void Application::run()
@@ -170,6 +187,8 @@ void Application::run()
 
 	// Reset time
 	glView->resetTime();		
+
+	V_PROFILE_THREAD_NAME("Main");
 		
 	// Iterate while GLView is running
 	while (glView->isRunning())
@@ -190,6 +209,7 @@ void Application::run()
 		else
 		{
 			// Not skipping frame. Update game.
+			V_PROFILE_ZONE("Update");
 			
 			// Update input handler
 			// Note: this only updates controllers.
@@ -206,24 +226,40 @@ void Application::run()
 			director->update(static_cast<float>(glView->getElaspedTime()));
 		}
 
+		// Upload assets that loader threads decoded. Limited by time budget so loading doesn't stall frame.
+		{
+			V_PROFILE_ZONE("Asset upload");
+			AssetLoader::getInstance().update();
+		}
+
 		// Wipe input data for current frame
 		input.postUpdate();
 
-		// Render director
-		director->render();
+		{
+			V_PROFILE_ZONE("Render");
+
+			// Render director
+			director->render();
 
-		// Clear depth buffer and render above current buffer
-		glClear(GL_DEPTH_BUFFER_BIT);
-		glDepthFunc(GL_ALWAYS);
+			// Clear depth buffer and render above current buffer
+			glClear(GL_DEPTH_BUFFER_BIT);
+			glDepthFunc(GL_ALWAYS);
 
-		// render cursor
-		cursor->render();
+			// render cursor
+			cursor->render();
+
+			// render fade
+			director->renderFade();
+		}
 
-		// render fade
-		director->renderFade();
+		// Texts are built and rendered for this frame. Font atlas can be evicted now.
+		FontManager::getInstance().update();
 
 		// Swap buffer and poll events. All glfw events are called here.
-		glView->render();
+		{
+			V_PROFILE_ZONE("Swap");
+			glView->render();
+		}
 
 #if V_DEBUG
 		// loop finished
@@ -234,6 +270,9 @@ void Application::run()
 			std::cout << "GL Error: " << glewGetErrorString(error) << "\n";
 		}
 #endif
+
+		// Collect zones of this frame
+		V_PROFILE_END_FRAME();
 	}
 	// Main while loop ends
 	
@@ -294,6 +333,9 @@ void Voxel::Application::cleanUp()
 	// Release fonts
 	FontManager::getInstance().clear();
 
+	// Stop loading. Drops assets that are not uploaded.
+	AssetLoader::getInstance().release();
+
 	// Release director
 	if (director)
 	{
@@ -0,0 +1,362 @@
+// pch
+#include "PreCompiled.h"
+
+#include "AssetLoader.h"
+
+// cpp
+#include <thread>
+#include <chrono>
+
+// voxel
+#include "ThreadPool.h"
+#include "Texture2D.h"
+#include "SpriteSheet.h"
+#include "CookedSpriteSheet.h"
+#include "Utility.h"
+
+using namespace Voxel;
+
+const unsigned int Voxel::AssetLoader::DEFAULT_THREAD_COUNT = 2;
+const float Voxel::AssetLoader::DEFAULT_UPLOAD_BUDGET = 4.0f;
+
+Voxel::AssetHandle::AssetHandle(const std::string & name, const State state)
+	: name(name)
+	, state(state)
+{}
+
+std::string Voxel::AssetHandle::getName() const
+{
+	return name;
+}
+
+AssetHandle::State Voxel::AssetHandle::getState() const
+{
+	return state.load();
+}
+
+bool Voxel::AssetHandle::isDone() const
+{
+	return state.load() != State::LOADING;
+}
+
+bool Voxel::AssetHandle::isReady() const
+{
+	return state.load() == State::READY;
+}
+
+Voxel::AssetLoader::AssetLoader()
+	: loaderPool(nullptr)
+{}
+
+Voxel::AssetLoader::~AssetLoader()
+{
+	release();
+}
+
+void Voxel::AssetLoader::init(const unsigned int threadCount)
+{
+	if (loaderPool == nullptr)
+	{
+		loaderPool = new ThreadPool(std::max(1u, threadCount));
+	}
+}
+
+void Voxel::AssetLoader::release()
+{
+	if (loaderPool)
+	{
+		// Joins threads. Tasks that are running finish and queue their uploads.
+		delete loaderPool;
+		loaderPool = nullptr;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(uploadMutex);
+		uploadQueue.clear();
+	}
+
+	for (auto& e : pendingHandles)
+	{
+		(e.second)->state.store(AssetHandle::State::FAILED);
+	}
+
+	pendingHandles.clear();
+}
+
+void Voxel::AssetLoader::addTask(const std::function<void()>& task)
+{
+	if (loaderPool)
+	{
+		loaderPool->addTask(task);
+	}
+	else
+	{
+		// Not initialized. Decode on main thread. Upload still goes through queue.
+		task();
+	}
+}
+
+void Voxel::AssetLoader::addUpload(const std::function<void()>& upload)
+{
+	std::unique_lock<std::mutex> lock(uploadMutex);
+	uploadQueue.push_back(upload);
+}
+
+void Voxel::AssetLoader::finish(const std::shared_ptr<AssetHandle>& handle, const bool success)
+{
+	handle->state.store(success ? AssetHandle::State::READY : AssetHandle::State::FAILED);
+
+	pendingHandles.erase(handle->name);
+
+	if (!success)
+	{
+		std::cout << "[AssetLoader] Failed to load " << handle->name << "\n";
+	}
+}
+
+std::shared_ptr<AssetHandle> Voxel::AssetLoader::loadSpriteSheetAsync(const std::string & jsonFileName)
+{
+	std::string fileName;
+	std::string ext = "";
+
+	Utility::String::fileNameToNameAndExt(jsonFileName, fileName, ext);
+
+	if (ext.empty())
+	{
+		ext = ".json";
+	}
+
+	fileName += ext;
+
+	if (SpriteSheetManager::getInstance().hasSpriteSheet(fileName))
+	{
+		return std::make_shared<AssetHandle>(fileName, AssetHandle::State::READY);
+	}
+
+	auto find_it = pendingHandles.find(fileName);
+	if (find_it != pendingHandles.end())
+	{
+		return find_it->second;
+	}
+
+	auto handle = std::make_shared<AssetHandle>(fileName, AssetHandle::State::LOADING);
+	pendingHandles.emplace(fileName, handle);
+
+	addTask([this, handle, fileName]()
+	{
+		// Cooked sprite sheet only needs file mapping here. Pixels are uploaded from mapped file.
+		std::shared_ptr<CookedSpriteSheet> cooked(CookedSpriteSheet::openForDataFile(fileName));
+
+		if (cooked)
+		{
+			// Read file in to memory here, so upload on main thread doesn't wait for disk on page fault
+			cooked->prefetch();
+
+			addUpload([this, handle, fileName, cooked]()
+			{
+				auto& sm = SpriteSheetManager::getInstance();
+
+				bool success = sm.hasSpriteSheet(fileName);
+
+				if (!success)
+				{
+					auto ss = SpriteSheet::createFromCooked(*cooked);
+
+					success = sm.addSpriteSheet(fileName, ss);
+
+					if (!success && ss)
+					{
+						delete ss;
+					}
+				}
+
+				finish(handle, success);
+			});
+
+			return;
+		}
+
+		// std::function needs copyable lambda
+		auto data = std::make_shared<SpriteSheet::Data>();
+		auto image = std::make_shared<Texture2D::DecodedImage>();
+
+		bool decoded = false;
+
+		try
+		{
+			decoded = SpriteSheet::parse(fileName, *data) && Texture2D::decodeImage(data->textureName, *image);
+		}
+		catch (const std::exception& e)
+		{
+			std::cout << "[AssetLoader] " << fileName << ": " << e.what() << "\n";
+		}
+
+		addUpload([this, handle, fileName, data, image, decoded]()
+		{
+			bool success = false;
+
+			if (decoded)
+			{
+				auto& sm = SpriteSheetManager::getInstance();
+
+				if (sm.hasSpriteSheet(fileName))
+				{
+					// Loaded synchronously while decoding
+					success = true;
+				}
+				else
+				{
+					auto ss = SpriteSheet::createFromData(*data, *image);
+
+					success = sm.addSpriteSheet(fileName, ss);
+
+					if (!success && ss)
+					{
+						delete ss;
+					}
+				}
+			}
+
+			finish(handle, success);
+		});
+	});
+
+	return handle;
+}
+
+std::shared_ptr<AssetHandle> Voxel::AssetLoader::loadTextureAsync(const std::string & textureName)
+{
+	if (TextureManager::getInstance().hasTexture(Utility::String::removeFileExtFromFileName(textureName)))
+	{
+		return std::make_shared<AssetHandle>(textureName, AssetHandle::State::READY);
+	}
+
+	auto find_it = pendingHandles.find(textureName);
+	if (find_it != pendingHandles.end())
+	{
+		return find_it->second;
+	}
+
+	auto handle = std::make_shared<AssetHandle>(textureName, AssetHandle::State::LOADING);
+	pendingHandles.emplace(textureName, handle);
+
+	addTask([this, handle, textureName]()
+	{
+		auto image = std::make_shared<Texture2D::DecodedImage>();
+
+		bool decoded = false;
+
+		try
+		{
+			decoded = Texture2D::decodeImage(textureName, *image);
+		}
+		catch (const std::exception& e)
+		{
+			std::cout << "[AssetLoader] " << textureName << ": " << e.what() << "\n";
+		}
+
+		addUpload([this, handle, textureName, image, decoded]()
+		{
+			bool success = false;
+
+			if (decoded)
+			{
+				success = Texture2D::createFromDecodedImage(textureName, *image, GL_TEXTURE_2D, false) != nullptr;
+			}
+
+			finish(handle, success);
+		});
+	});
+
+	return handle;
+}
+
+std::shared_ptr<AssetHandle> Voxel::AssetLoader::runAsync(const std::string & name, const std::function<bool()>& task)
+{
+	auto handle = std::make_shared<AssetHandle>(name, AssetHandle::State::LOADING);
+	pendingHandles.emplace(name, handle);
+
+	addTask([this, handle, name, task]()
+	{
+		bool success = false;
+
+		try
+		{
+			success = task();
+		}
+		catch (const std::exception& e)
+		{
+			std::cout << "[AssetLoader] " << name << ": " << e.what() << "\n";
+		}
+
+		// Nothing to upload. Handle is only finished on main thread like other assets.
+		addUpload([this, handle, success]()
+		{
+			finish(handle, success);
+		});
+	});
+
+	return handle;
+}
+
+void Voxel::AssetLoader::update(const float budgetMilliSeconds)
+{
+	auto start = Utility::Time::now();
+
+	while (true)
+	{
+		std::function<void()> upload;
+
+		{
+			std::unique_lock<std::mutex> lock(uploadMutex);
+
+			if (uploadQueue.empty())
+			{
+				break;
+			}
+
+			upload = uploadQueue.front();
+			uploadQueue.pop_front();
+		}
+
+		upload();
+
+		const float elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Utility::Time::now() - start).count() / 1000.0f;
+
+		if (elapsed >= budgetMilliSeconds)
+		{
+			break;
+		}
+	}
+}
+
+void Voxel::AssetLoader::wait(const std::vector<std::shared_ptr<AssetHandle>>& handles)
+{
+	while (!isDone(handles))
+	{
+		update(std::numeric_limits<float>::max());
+
+		if (!isDone(handles))
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+}
+
+bool Voxel::AssetLoader::isDone(const std::vector<std::shared_ptr<AssetHandle>>& handles)
+{
+	for (auto& handle : handles)
+	{
+		if (handle && !handle->isDone())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+unsigned int Voxel::AssetLoader::getPendingCount() const
+{
+	return static_cast<unsigned int>(pendingHandles.size());
+}
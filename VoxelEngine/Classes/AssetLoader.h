@@ -0,0 +1,168 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+// cpp
+#include <string>
+#include <list>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+
+namespace Voxel
+{
+	// foward declaration
+	class ThreadPool;
+
+	/**
+	*	@class AssetHandle
+	*	@brief State of asset that is requested to AssetLoader. Shared by loader and requester.
+	*/
+	class AssetHandle
+	{
+		friend class AssetLoader;
+	public:
+		enum class State
+		{
+			LOADING = 0,		// Reading, decoding or waiting for upload
+			READY,				// Asset is in its manager
+			FAILED,				// Failed to read, decode or upload
+		};
+	private:
+		// Name of asset. File name.
+		std::string name;
+
+		// Current state
+		std::atomic<State> state;
+	public:
+		// Constructor
+		AssetHandle(const std::string& name, const State state);
+
+		// Destructor
+		~AssetHandle() = default;
+
+		// Get name of asset
+		std::string getName() const;
+
+		// Get current state
+		State getState() const;
+
+		// Check if asset finished loading whether it failed or not
+		bool isDone() const;
+
+		// Check if asset is ready to use
+		bool isReady() const;
+	};
+
+	/**
+	*	@class AssetLoader
+	*	@brief Loads assets in background and uploads to GPU on main thread.
+	*
+	*	File reads and image and json decoding run on loader threads. Decoded assets are queued for upload.
+	*	Sprite sheet that is cooked (CookedSpriteSheet) is mapped instead of decoded.
+	*	Main thread drains upload queue every frame in update() under time budget, so large batch of assets is spread over frames.
+	*	Uploaded assets are added to same managers (TextureManager, SpriteSheetManager) that synchronous loading uses,
+	*	so code that uses asset doesn't change. Request asset early, then use it once handle is ready.
+	*
+	*	All functions except constructor must be called on main thread.
+	*/
+	class AssetLoader
+	{
+	public:
+		// Number of loader threads
+		static const unsigned int DEFAULT_THREAD_COUNT;
+
+		// Max time to spend on uploads in single frame in milliseconds
+		static const float DEFAULT_UPLOAD_BUDGET;
+	private:
+		// Constructor
+		AssetLoader();
+
+		// Destructor
+		~AssetLoader();
+
+		// Delete copy, move, assign operators
+		AssetLoader(AssetLoader const&) = delete;             // Copy construct
+		AssetLoader(AssetLoader&&) = delete;                  // Move construct
+		AssetLoader& operator=(AssetLoader const&) = delete;  // Copy assign
+		AssetLoader& operator=(AssetLoader &&) = delete;      // Move assign
+
+		// Loader threads. nullptr if not initialized. Then assets are decoded on main thread.
+		ThreadPool* loaderPool;
+
+		// Uploads that are waiting for main thread
+		std::list<std::function<void()>> uploadQueue;
+
+		// Mutex for upload queue
+		std::mutex uploadMutex;
+
+		// Handles of assets that are loading. Same asset requested twice shares handle.
+		std::unordered_map<std::string, std::shared_ptr<AssetHandle>> pendingHandles;
+
+		// Run decode task on loader thread
+		void addTask(const std::function<void()>& task);
+
+		// Add upload to queue. Called from loader thread.
+		void addUpload(const std::function<void()>& upload);
+
+		// Update handle state and remove from pending
+		void finish(const std::shared_ptr<AssetHandle>& handle, const bool success);
+	public:
+		// Get singleton instance
+		static AssetLoader& getInstance()
+		{
+			static AssetLoader instance;
+			return instance;
+		}
+
+		/**
+		*	Spawns loader threads.
+		*	@param threadCount Number of loader threads.
+		*/
+		void init(const unsigned int threadCount = DEFAULT_THREAD_COUNT);
+
+		// Joins loader threads and drops uploads that are not done. Call before OpenGL context is destroyed.
+		void release();
+
+		/**
+		*	Load sprite sheet in background. Sprite sheet is added to SpriteSheetManager once it's uploaded.
+		*	@param jsonFileName Json file name for sprite sheet.
+		*	@return Handle of sprite sheet. Ready right away if sprite sheet is already loaded.
+		*/
+		std::shared_ptr<AssetHandle> loadSpriteSheetAsync(const std::string& jsonFileName);
+
+		/**
+		*	Load texture in background. Texture is added to TextureManager once it's uploaded.
+		*	@param textureName Image file name in texture directory.
+		*	@return Handle of texture. Ready right away if texture is already loaded.
+		*/
+		std::shared_ptr<AssetHandle> loadTextureAsync(const std::string& textureName);
+
+		/**
+		*	Runs task in background. Use for work that doesn't touch OpenGL, like generating data before scene starts.
+		*	@param name Name of task. Must not be same as other pending asset.
+		*	@param task Task to run on loader thread. Returns false if it failed.
+		*	@return Handle of task. Ready on main thread after task returns true.
+		*/
+		std::shared_ptr<AssetHandle> runAsync(const std::string& name, const std::function<bool()>& task);
+
+		/**
+		*	Runs queued uploads until budget is used. Runs at least one upload if queue isn't empty.
+		*	@param budgetMilliSeconds Max time to spend in milliseconds.
+		*/
+		void update(const float budgetMilliSeconds = DEFAULT_UPLOAD_BUDGET);
+
+		// Blocks until all handles are done. Runs uploads while waiting.
+		void wait(const std::vector<std::shared_ptr<AssetHandle>>& handles);
+
+		// Check if all handles are done
+		static bool isDone(const std::vector<std::shared_ptr<AssetHandle>>& handles);
+
+		// Get number of assets that are loading
+		unsigned int getPendingCount() const;
+	};
+}
+
+#endif
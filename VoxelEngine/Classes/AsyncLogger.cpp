@@ -0,0 +1,413 @@
+// pch
+#include "PreCompiled.h"
+
+#include "AsyncLogger.h"
+
+// cpp
+#include <cstdio>
+#include <cstring>
+
+// voxel
+#include "Logger.h"
+
+using namespace Voxel;
+
+const unsigned int Voxel::AsyncLogger::RING_CAPACITY = 4096;
+const std::chrono::milliseconds Voxel::AsyncLogger::FLUSH_INTERVAL = std::chrono::milliseconds(10);
+
+namespace
+{
+	// Ring of thread. Released when thread ends so other thread can reuse it.
+	struct ThreadRing
+	{
+		Voxel::LogRing* ring = nullptr;
+
+		~ThreadRing()
+		{
+			if (ring)
+			{
+				ring->release();
+			}
+		}
+	};
+
+	thread_local ThreadRing threadRing;
+
+	// Record used while flusher isn't running. Printed immediately.
+	thread_local Voxel::LogRecord immediateRecord;
+
+	// Keeps lines from different threads from mixing while printing immediately.
+	std::mutex immediateMutex;
+}
+
+Voxel::AsyncLogger::AsyncLogger()
+	: startTime(std::chrono::steady_clock::now())
+	, nextThreadIndex(0)
+	, running(false)
+	, flushedCount(0)
+	, droppedCount(0)
+	, flushCount(0)
+{}
+
+Voxel::AsyncLogger::~AsyncLogger()
+{
+	stop();
+}
+
+void Voxel::AsyncLogger::start(Sink sink)
+{
+	if (running.load())
+	{
+		return;
+	}
+
+	if (sink)
+	{
+		this->sink = sink;
+	}
+	else
+	{
+		this->sink = [](const LogLevel level, const std::string& line)
+		{
+			auto& logger = Logger::getInstance();
+
+			switch (level)
+			{
+			case LogLevel::WARN:
+				logger.warn(line);
+				break;
+			case LogLevel::ERR:
+				logger.error(line);
+				break;
+			default:
+				logger.info(line);
+				break;
+			}
+		};
+	}
+
+	flushedCount.store(0);
+	droppedCount.store(0);
+	flushCount.store(0);
+
+	running.store(true);
+
+	flusher = std::thread(&AsyncLogger::flushLoop, this);
+}
+
+void Voxel::AsyncLogger::stop()
+{
+	if (!running.exchange(false))
+	{
+		return;
+	}
+
+	requestFlush();
+
+	if (flusher.joinable())
+	{
+		flusher.join();
+	}
+
+	// Records that were written while flusher was stopping
+	flushAll();
+}
+
+bool Voxel::AsyncLogger::isRunning() const
+{
+	return running.load();
+}
+
+void Voxel::AsyncLogger::requestFlush()
+{
+	flushCondition.notify_one();
+}
+
+LogRing * Voxel::AsyncLogger::getThreadRing()
+{
+	if (threadRing.ring)
+	{
+		return threadRing.ring;
+	}
+
+	std::unique_lock<std::mutex> lock(ringMutex);
+
+	const unsigned int threadIndex = nextThreadIndex++;
+
+	// Reuse ring of thread that ended
+	for (auto& ring : rings)
+	{
+		if (ring->isReleased() && ring->empty())
+		{
+			ring->acquire(threadIndex);
+			threadRing.ring = ring.get();
+
+			return threadRing.ring;
+		}
+	}
+
+	rings.push_back(std::unique_ptr<LogRing>(new LogRing(RING_CAPACITY)));
+	rings.back()->acquire(threadIndex);
+
+	threadRing.ring = rings.back().get();
+
+	return threadRing.ring;
+}
+
+LogRecord * Voxel::AsyncLogger::beginRecord(const LogLevel level, const char * format)
+{
+	LogRecord* record = nullptr;
+
+	if (running.load(std::memory_order_relaxed))
+	{
+		LogRing* ring = getThreadRing();
+
+		record = ring->beginWrite();
+
+		if (record == nullptr)
+		{
+			return nullptr;
+		}
+
+		record->threadIndex = ring->getThreadIndex();
+	}
+	else
+	{
+		record = &immediateRecord;
+		record->threadIndex = 0;
+	}
+
+	record->format = format;
+	record->time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+	record->level = level;
+	record->argCount = 0;
+
+	return record;
+}
+
+void Voxel::AsyncLogger::commitRecord(LogRecord * record)
+{
+	if (record == &immediateRecord)
+	{
+		std::string message;
+		format(*record, message);
+		message += '\n';
+
+		std::unique_lock<std::mutex> lock(immediateMutex);
+		std::cout << message;
+
+		return;
+	}
+
+	threadRing.ring->commit();
+
+	if (record->level >= LogLevel::WARN)
+	{
+		requestFlush();
+	}
+}
+
+void Voxel::AsyncLogger::flushLoop()
+{
+	while (running.load())
+	{
+		// Keep draining while there are records. Wait only when idle.
+		if (flushAll() == 0)
+		{
+			std::unique_lock<std::mutex> lock(flushMutex);
+			flushCondition.wait_for(lock, FLUSH_INTERVAL);
+		}
+	}
+}
+
+unsigned int Voxel::AsyncLogger::flushAll()
+{
+	{
+		std::unique_lock<std::mutex> lock(ringMutex);
+
+		drainingRings.clear();
+
+		for (auto& ring : rings)
+		{
+			drainingRings.push_back(ring.get());
+		}
+	}
+
+	batch.clear();
+
+	for (auto ring : drainingRings)
+	{
+		ring->drain(batch);
+
+		const unsigned long long dropped = ring->takeDropped();
+
+		if (dropped > 0)
+		{
+			droppedCount.fetch_add(dropped);
+
+			line = "[AsyncLogger] Dropped " + std::to_string(dropped) + " logs from thread #" + std::to_string(ring->getThreadIndex());
+			sink(LogLevel::WARN, line);
+		}
+	}
+
+	const unsigned int size = static_cast<unsigned int>(batch.size());
+
+	if (size == 0)
+	{
+		return 0;
+	}
+
+	// Each ring is in order. Sort across threads.
+	batchOrder.resize(size);
+
+	for (unsigned int i = 0; i < size; i++)
+	{
+		batchOrder[i] = i;
+	}
+
+	std::stable_sort(batchOrder.begin(), batchOrder.end(), [this](const unsigned int a, const unsigned int b) { return batch[a].time < batch[b].time; });
+
+	char prefix[64];
+
+	for (auto index : batchOrder)
+	{
+		auto& record = batch[index];
+
+		std::snprintf(prefix, sizeof(prefix), "[%.6f] [#%u] ", static_cast<double>(record.time) / 1000000000.0, record.threadIndex);
+
+		line = prefix;
+		format(record, line);
+
+		sink(record.level, line);
+	}
+
+	flushedCount.fetch_add(size);
+	flushCount.fetch_add(1);
+
+	return size;
+}
+
+void Voxel::AsyncLogger::setArg(LogArg & arg, const char * value)
+{
+	arg.type = LogArg::Type::STRING;
+
+	if (value == nullptr)
+	{
+		value = "(null)";
+	}
+
+	std::strncpy(arg.str, value, LogArg::MAX_STRING_LENGTH);
+	arg.str[LogArg::MAX_STRING_LENGTH] = '\0';
+}
+
+void Voxel::AsyncLogger::setArg(LogArg & arg, const std::string & value)
+{
+	setArg(arg, value.c_str());
+}
+
+void Voxel::AsyncLogger::setArg(LogArg & arg, const glm::ivec2 & value)
+{
+	arg.type = LogArg::Type::IVEC2;
+	arg.iv[0] = value.x;
+	arg.iv[1] = value.y;
+}
+
+void Voxel::AsyncLogger::setArg(LogArg & arg, const glm::vec3 & value)
+{
+	arg.type = LogArg::Type::VEC3;
+	arg.v[0] = value.x;
+	arg.v[1] = value.y;
+	arg.v[2] = value.z;
+}
+
+void Voxel::AsyncLogger::appendArg(std::string & line, const LogArg & arg)
+{
+	char buffer[64];
+
+	switch (arg.type)
+	{
+	case LogArg::Type::INT:
+		std::snprintf(buffer, sizeof(buffer), "%lld", arg.i);
+		break;
+	case LogArg::Type::UINT:
+		std::snprintf(buffer, sizeof(buffer), "%llu", arg.u);
+		break;
+	case LogArg::Type::FLOAT:
+		std::snprintf(buffer, sizeof(buffer), "%g", arg.f);
+		break;
+	case LogArg::Type::STRING:
+		line += arg.str;
+		return;
+	case LogArg::Type::IVEC2:
+		std::snprintf(buffer, sizeof(buffer), "(%d, %d)", arg.iv[0], arg.iv[1]);
+		break;
+	case LogArg::Type::VEC3:
+		std::snprintf(buffer, sizeof(buffer), "(%g, %g, %g)", arg.v[0], arg.v[1], arg.v[2]);
+		break;
+	default:
+		return;
+	}
+
+	line += buffer;
+}
+
+void Voxel::AsyncLogger::format(const LogRecord & record, std::string & line)
+{
+	const char* c = record.format;
+	const char* textStart = c;
+	unsigned int argIndex = 0;
+
+	while (*c != '\0')
+	{
+		if (c[0] == '{' && c[1] == '}' && argIndex < record.argCount)
+		{
+			line.append(textStart, c);
+			appendArg(line, record.args[argIndex]);
+			argIndex++;
+
+			c += 2;
+			textStart = c;
+		}
+		else
+		{
+			c++;
+		}
+	}
+
+	line.append(textStart, c);
+}
+
+const char * Voxel::AsyncLogger::levelToString(const LogLevel level)
+{
+	switch (level)
+	{
+	case LogLevel::TRACE:
+		return "trace";
+	case LogLevel::DEBUG:
+		return "debug";
+	case LogLevel::INFO:
+		return "info";
+	case LogLevel::WARN:
+		return "warn";
+	case LogLevel::ERR:
+		return "error";
+	default:
+		return "unknown";
+	}
+}
+
+AsyncLogger::Stats Voxel::AsyncLogger::getStats() const
+{
+	Stats stats;
+
+	stats.flushedCount = flushedCount.load();
+	stats.droppedCount = droppedCount.load();
+	stats.flushCount = flushCount.load();
+
+	{
+		std::unique_lock<std::mutex> lock(ringMutex);
+		stats.ringCount = static_cast<unsigned int>(rings.size());
+	}
+
+	return stats;
+}
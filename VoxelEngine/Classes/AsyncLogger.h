@@ -0,0 +1,316 @@
+#ifndef ASYNC_LOGGER_H
+#define ASYNC_LOGGER_H
+
+// cpp
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <condition_variable>
+#include <type_traits>
+
+// glm
+#include <glm\glm.hpp>
+
+// voxel
+#include "Config.h"
+#include "ThreadEventRing.h"
+
+namespace Voxel
+{
+	/**
+	*	@enum LogLevel
+	*	@brief Level of log. Same order as V_LOG_LEVEL.
+	*/
+	enum class LogLevel : unsigned char
+	{
+		TRACE = 0,
+		DEBUG,
+		INFO,
+		WARN,
+		ERR,		// ERROR is macro in Windows.h
+	};
+
+	/**
+	*	@struct LogArg
+	*	@brief Argument of log. Stored as value so it can be formatted later on flusher thread.
+	*/
+	struct LogArg
+	{
+	public:
+		// Strings longer than this are truncated
+		static const unsigned int MAX_STRING_LENGTH = 23;
+
+		enum class Type : unsigned char
+		{
+			INT = 0,
+			UINT,
+			FLOAT,
+			STRING,
+			IVEC2,
+			VEC3,
+		};
+
+		Type type;
+
+		union
+		{
+			long long i;
+			unsigned long long u;
+			double f;
+			char str[MAX_STRING_LENGTH + 1];
+			int iv[2];
+			float v[3];
+		};
+	};
+
+	/**
+	*	@struct LogRecord
+	*	@brief Single log in ring buffer. Format is formatted when flusher writes it.
+	*/
+	struct LogRecord
+	{
+	public:
+		static const unsigned int MAX_ARGS = 6;
+
+		// Must be string literal. Each {} is replaced by next argument.
+		const char* format;
+		// Nano seconds since logger started
+		long long time;
+		// Index of thread that logged
+		unsigned int threadIndex;
+		LogLevel level;
+		unsigned char argCount;
+		LogArg args[MAX_ARGS];
+	};
+
+	// Ring of each thread that logs
+	typedef ThreadEventRing<LogRecord> LogRing;
+
+	/**
+	*	@class AsyncLogger
+	*	@brief Low latency logger for hot paths and worker threads.
+	*
+	*	Each thread writes record to its own LogRing. Nothing is formatted and no lock is taken on the calling thread.
+	*	Background flusher thread drains all rings, sorts records by time, formats them and passes each line to sink.
+	*	Default sink writes to Logger (log file, and console if V_DEBUG_LOG_CONSOLE is enabled).
+	*
+	*	Use V_LOG_TRACE, V_LOG_DEBUG, V_LOG_INFO, V_LOG_WARN and V_LOG_ERROR.
+	*	Levels below V_LOG_LEVEL are compiled out and arguments are not evaluated.
+	*	Format must be string literal. Each {} is replaced by argument in order.
+	*	Arguments can be integer, float, string (truncated to 23 characters), glm::ivec2 and glm::vec3.
+	*
+	*	While flusher isn't running (headless modes, before Application init), logs are formatted and printed to std::cout immediately.
+	*/
+	class AsyncLogger
+	{
+	public:
+		// Receives formatted line. Called on flusher thread only.
+		typedef std::function<void(const LogLevel level, const std::string& line)> Sink;
+
+		struct Stats
+		{
+			// Number of records passed to sink
+			unsigned long long flushedCount;
+			// Number of records dropped because ring was full
+			unsigned long long droppedCount;
+			// Number of times flusher drained rings
+			unsigned long long flushCount;
+			// Number of rings. Same as number of threads that logged, unless rings were reused.
+			unsigned int ringCount;
+		};
+	private:
+		// Constructor
+		AsyncLogger();
+
+		// Destructor. Stops flusher.
+		~AsyncLogger();
+
+		// Number of records in each thread's ring
+		static const unsigned int RING_CAPACITY;
+
+		// Time flusher waits when there was nothing to flush
+		static const std::chrono::milliseconds FLUSH_INTERVAL;
+
+		// Time when logger was created. Record time is relative to this.
+		const std::chrono::steady_clock::time_point startTime;
+
+		// All rings. Rings are never deleted until logger is destroyed, so flusher can read them without lock.
+		std::vector<std::unique_ptr<LogRing>> rings;
+		mutable std::mutex ringMutex;
+
+		// Index for next thread that logs
+		unsigned int nextThreadIndex;
+
+		// Flusher
+		std::thread flusher;
+		std::atomic<bool> running;
+		std::mutex flushMutex;
+		std::condition_variable flushCondition;
+		Sink sink;
+
+		// Records of single flush, order of records sorted by time and rings to drain. Flusher thread only.
+		std::vector<LogRecord> batch;
+		std::vector<unsigned int> batchOrder;
+		std::vector<LogRing*> drainingRings;
+		std::string line;
+
+		// Stats
+		std::atomic<unsigned long long> flushedCount;
+		std::atomic<unsigned long long> droppedCount;
+		std::atomic<unsigned long long> flushCount;
+
+		// Get ring of calling thread. Creates or reuses one on first call of thread.
+		LogRing* getThreadRing();
+
+		// Get record to write on calling thread's ring. Returns nullptr if ring is full.
+		LogRecord* beginRecord(const LogLevel level, const char* format);
+
+		// Publish record. Prints immediately if flusher isn't running.
+		void commitRecord(LogRecord* record);
+
+		// Flusher thread loop
+		void flushLoop();
+
+		// Drain rings and write to sink. Returns number of records written.
+		unsigned int flushAll();
+
+		// Set argument
+		template<typename T>
+		static typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type setArg(LogArg& arg, const T value)
+		{
+			arg.type = LogArg::Type::INT;
+			arg.i = static_cast<long long>(value);
+		}
+
+		template<typename T>
+		static typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type setArg(LogArg& arg, const T value)
+		{
+			arg.type = LogArg::Type::UINT;
+			arg.u = static_cast<unsigned long long>(value);
+		}
+
+		template<typename T>
+		static typename std::enable_if<std::is_floating_point<T>::value>::type setArg(LogArg& arg, const T value)
+		{
+			arg.type = LogArg::Type::FLOAT;
+			arg.f = static_cast<double>(value);
+		}
+
+		static void setArg(LogArg& arg, const char* value);
+		static void setArg(LogArg& arg, const std::string& value);
+		static void setArg(LogArg& arg, const glm::ivec2& value);
+		static void setArg(LogArg& arg, const glm::vec3& value);
+
+		// Pack arguments to record
+		static void packArgs(LogRecord&) {}
+
+		template<typename T, typename... Args>
+		static void packArgs(LogRecord& record, const T& value, const Args&... args)
+		{
+			if (record.argCount < LogRecord::MAX_ARGS)
+			{
+				setArg(record.args[record.argCount], value);
+				record.argCount++;
+
+				packArgs(record, args...);
+			}
+		}
+
+		// Format argument
+		static void appendArg(std::string& line, const LogArg& arg);
+	public:
+		static AsyncLogger& getInstance()
+		{
+			static AsyncLogger instance;
+			return instance;
+		}
+
+		AsyncLogger(AsyncLogger const&) = delete;             // Copy construct
+		AsyncLogger(AsyncLogger&&) = delete;                  // Move construct
+		AsyncLogger& operator=(AsyncLogger const&) = delete;  // Copy assign
+		AsyncLogger& operator=(AsyncLogger &&) = delete;      // Move assign
+
+		/**
+		*	Start flusher thread.
+		*	@param sink Receives formatted lines. Writes to Logger if empty.
+		*/
+		void start(Sink sink = Sink());
+
+		// Flush remaining records and stop flusher thread.
+		void stop();
+
+		// Check if flusher is running
+		bool isRunning() const;
+
+		// Wake flusher. Doesn't wait.
+		void requestFlush();
+
+		/**
+		*	Log. Use V_LOG_* macros instead, so level can be compiled out.
+		*	@param level Level of log. Warn and error wakes flusher.
+		*	@param format String literal. Each {} is replaced by argument.
+		*	@param args Arguments.
+		*/
+		template<typename... Args>
+		void log(const LogLevel level, const char* format, const Args&... args)
+		{
+			LogRecord* record = beginRecord(level, format);
+
+			if (record)
+			{
+				packArgs(*record, args...);
+				commitRecord(record);
+			}
+		}
+
+		/**
+		*	Format message of record. Replaces each {} in format with argument.
+		*	@param record Record to format.
+		*	@param line String to append message.
+		*/
+		static void format(const LogRecord& record, std::string& line);
+
+		// Get name of level
+		static const char* levelToString(const LogLevel level);
+
+		Stats getStats() const;
+	};
+}
+
+// Log with level. Compiled out if level is lower than V_LOG_LEVEL.
+#if V_LOG_LEVEL <= 0
+#define V_LOG_TRACE(...) Voxel::AsyncLogger::getInstance().log(Voxel::LogLevel::TRACE, __VA_ARGS__)
+#else
+#define V_LOG_TRACE(...) ((void)0)
+#endif
+
+#if V_LOG_LEVEL <= 1
+#define V_LOG_DEBUG(...) Voxel::AsyncLogger::getInstance().log(Voxel::LogLevel::DEBUG, __VA_ARGS__)
+#else
+#define V_LOG_DEBUG(...) ((void)0)
+#endif
+
+#if V_LOG_LEVEL <= 2
+#define V_LOG_INFO(...) Voxel::AsyncLogger::getInstance().log(Voxel::LogLevel::INFO, __VA_ARGS__)
+#else
+#define V_LOG_INFO(...) ((void)0)
+#endif
+
+#if V_LOG_LEVEL <= 3
+#define V_LOG_WARN(...) Voxel::AsyncLogger::getInstance().log(Voxel::LogLevel::WARN, __VA_ARGS__)
+#else
+#define V_LOG_WARN(...) ((void)0)
+#endif
+
+#if V_LOG_LEVEL <= 4
+#define V_LOG_ERROR(...) Voxel::AsyncLogger::getInstance().log(Voxel::LogLevel::ERR, __VA_ARGS__)
+#else
+#define V_LOG_ERROR(...) ((void)0)
+#endif
+
+#endif
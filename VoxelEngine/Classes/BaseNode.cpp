@@ -7,6 +7,7 @@ unsigned int Voxel::UI::BaseNode::idCounter = 0;
 
 Voxel::UI::BaseNode::BaseNode(const std::string & name)
 	: name(name)
+	, nameID(name)
 	, id(++BaseNode::idCounter)
 {}
 
@@ -18,4 +19,9 @@ unsigned int Voxel::UI::BaseNode::getID() const
 std::string Voxel::UI::BaseNode::getName() const
 {
 	return name;
+}
+
+Voxel::StringID Voxel::UI::BaseNode::getNameID() const
+{
+	return nameID;
 }
\ No newline at end of file
@@ -19,6 +19,7 @@
 // Voxel
 #include "ZOrder.h"
 #include "Shape.h"
+#include "StringID.h"
 
 namespace Voxel
 {
@@ -54,6 +55,9 @@ namespace Voxel
 			// name
 			std::string name;
 
+			// Interned name. Used to find node by name.
+			StringID nameID;
+
 			// id
 			unsigned int id;
 		public:
@@ -69,6 +73,11 @@ namespace Voxel
 			*	Get name of ui
 			*/
 			std::string getName() const;
+
+			/**
+			*	Get interned name of ui
+			*/
+			StringID getNameID() const;
 		};
 	}
 }
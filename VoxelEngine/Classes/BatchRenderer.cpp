@@ -0,0 +1,368 @@
+// pch
+#include "PreCompiled.h"
+
+#include "BatchRenderer.h"
+
+// voxel
+#include "RenderNode.h"
+#include "Texture2D.h"
+#include "ProgramManager.h"
+#include "Program.h"
+
+using namespace Voxel;
+
+Voxel::UI::BatchRenderer::BatchRenderer()
+	: vao(0)
+	, vbo(0)
+	, ibo(0)
+	, vertexCapacity(0)
+	, indexCapacity(0)
+{}
+
+Voxel::UI::BatchRenderer::~BatchRenderer()
+{
+	if (vbo)
+	{
+		glDeleteBuffers(1, &vbo);
+	}
+
+	if (ibo)
+	{
+		glDeleteBuffers(1, &ibo);
+	}
+
+	if (vao)
+	{
+		glDeleteVertexArrays(1, &vao);
+	}
+}
+
+void Voxel::UI::BatchRenderer::clear()
+{
+	vertices.clear();
+	indices.clear();
+	draws.clear();
+}
+
+bool Voxel::UI::BatchRenderer::appendStream(const std::vector<float>& vertexData, const std::vector<float>* colorData, const std::vector<float>& uvData, const std::vector<unsigned int>& indexData, const unsigned int indexOffset, const unsigned int indexCount, const glm::mat4 & modelMat, const glm::vec4 & color)
+{
+	if (indexCount == 0) return false;
+	if (indexOffset + indexCount > indexData.size()) return false;
+
+	// Find range of vertices that indices refer. Button and AnimatedImage only draw 1 frame out of all.
+	unsigned int minIndex = indexData.at(indexOffset);
+	unsigned int maxIndex = minIndex;
+
+	for (unsigned int i = indexOffset; i < indexOffset + indexCount; i++)
+	{
+		minIndex = std::min(minIndex, indexData.at(i));
+		maxIndex = std::max(maxIndex, indexData.at(i));
+	}
+
+	if ((maxIndex * 3) + 2 >= vertexData.size() || (maxIndex * 2) + 1 >= uvData.size())
+	{
+		// Invalid geometry
+		return false;
+	}
+
+	if (colorData && (maxIndex * 3) + 2 >= colorData->size())
+	{
+		return false;
+	}
+
+	const unsigned int baseVertex = static_cast<unsigned int>(vertices.size());
+
+	for (unsigned int i = minIndex; i <= maxIndex; i++)
+	{
+		Vertex vertex;
+		vertex.position = glm::vec3(modelMat * glm::vec4(vertexData[i * 3], vertexData[i * 3 + 1], vertexData[i * 3 + 2], 1.0f));
+		vertex.uv = glm::vec2(uvData[i * 2], uvData[i * 2 + 1]);
+
+		if (colorData)
+		{
+			vertex.color = glm::vec4((*colorData)[i * 3], (*colorData)[i * 3 + 1], (*colorData)[i * 3 + 2], color.a);
+		}
+		else
+		{
+			vertex.color = color;
+		}
+
+		vertices.push_back(vertex);
+	}
+
+	for (unsigned int i = indexOffset; i < indexOffset + indexCount; i++)
+	{
+		indices.push_back(indexData[i] - minIndex + baseVertex);
+	}
+
+	return true;
+}
+
+void Voxel::UI::BatchRenderer::addBatch(const Draw::Shader shader, Texture2D * texture, const bool outlined, const glm::vec3 & outlineColor, const unsigned int indexOffset, const unsigned int indexCount)
+{
+	if (!draws.empty())
+	{
+		auto& last = draws.back();
+
+		if (last.type == Draw::Type::BATCH && last.shader == shader && last.texture == texture && last.outlined == outlined && last.outlineColor == outlineColor)
+		{
+			// Same batch. Merge.
+			last.indexCount += indexCount;
+			return;
+		}
+	}
+
+	// Texture or shader changed or previous draw wasn't batch. Start new batch.
+	Draw draw;
+	draw.type = Draw::Type::BATCH;
+	draw.shader = shader;
+	draw.texture = texture;
+	draw.outlined = outlined;
+	draw.outlineColor = outlineColor;
+	draw.indexOffset = indexOffset;
+	draw.indexCount = indexCount;
+	draw.node = nullptr;
+
+	draws.push_back(draw);
+}
+
+void Voxel::UI::BatchRenderer::appendGeometry(Texture2D * texture, const std::vector<float>& vertexData, const std::vector<float>& uvData, const std::vector<unsigned int>& indexData, const unsigned int indexOffset, const unsigned int indexCount, const glm::mat4 & modelMat, const glm::vec4 & color)
+{
+	if (texture == nullptr) return;
+
+	const unsigned int streamIndexOffset = static_cast<unsigned int>(indices.size());
+
+	if (appendStream(vertexData, nullptr, uvData, indexData, indexOffset, indexCount, modelMat, color))
+	{
+		addBatch(Draw::Shader::TEXTURE, texture, false, glm::vec3(0.0f), streamIndexOffset, indexCount);
+	}
+}
+
+void Voxel::UI::BatchRenderer::appendTextGeometry(Texture2D * texture, const std::vector<float>& vertexData, const std::vector<float>& colorData, const std::vector<float>& uvData, const std::vector<unsigned int>& indexData, const unsigned int indexCount, const glm::mat4 & modelMat, const float opacity, const bool outlined, const glm::vec3 & outlineColor)
+{
+	if (texture == nullptr) return;
+
+	const unsigned int streamIndexOffset = static_cast<unsigned int>(indices.size());
+
+	if (appendStream(vertexData, &colorData, uvData, indexData, 0, indexCount, modelMat, glm::vec4(1.0f, 1.0f, 1.0f, opacity)))
+	{
+		// Outline color doesn't matter if it's not outlined
+		addBatch(Draw::Shader::TEXT, texture, outlined, outlined ? outlineColor : glm::vec3(0.0f), streamIndexOffset, indexCount);
+	}
+}
+
+void Voxel::UI::BatchRenderer::addRenderSelf(RenderNode * node)
+{
+	if (node == nullptr) return;
+
+	Draw draw;
+	draw.type = Draw::Type::RENDER_SELF;
+	draw.shader = Draw::Shader::TEXTURE;
+	draw.texture = nullptr;
+	draw.outlined = false;
+	draw.outlineColor = glm::vec3(0.0f);
+	draw.indexOffset = 0;
+	draw.indexCount = 0;
+	draw.node = node;
+
+	draws.push_back(draw);
+}
+
+void Voxel::UI::BatchRenderer::addRender(TransformNode * node)
+{
+	if (node == nullptr) return;
+
+	Draw draw;
+	draw.type = Draw::Type::RENDER;
+	draw.shader = Draw::Shader::TEXTURE;
+	draw.texture = nullptr;
+	draw.outlined = false;
+	draw.outlineColor = glm::vec3(0.0f);
+	draw.indexOffset = 0;
+	draw.indexCount = 0;
+	draw.node = node;
+
+	draws.push_back(draw);
+}
+
+void Voxel::UI::BatchRenderer::initBuffers()
+{
+	auto program = ProgramManager::getInstance().getProgram(ProgramManager::PROGRAM_NAME::UI_BATCH_SHADER);
+
+	glGenVertexArrays(1, &vao);
+	glBindVertexArray(vao);
+
+	glGenBuffers(1, &vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+	GLint vertLoc = program->getAttribLocation("vert");
+	glEnableVertexAttribArray(vertLoc);
+	glVertexAttribPointer(vertLoc, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offsetof(Vertex, position)));
+
+	GLint uvVertLoc = program->getAttribLocation("uvVert");
+	glEnableVertexAttribArray(uvVertLoc);
+	glVertexAttribPointer(uvVertLoc, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offsetof(Vertex, uv)));
+
+	GLint colorLoc = program->getAttribLocation("color");
+	glEnableVertexAttribArray(colorLoc);
+	glVertexAttribPointer(colorLoc, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offsetof(Vertex, color)));
+
+	glGenBuffers(1, &ibo);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+
+	glBindVertexArray(0);
+}
+
+void Voxel::UI::BatchRenderer::loadBuffers()
+{
+	if (vao == 0)
+	{
+		initBuffers();
+	}
+
+	glBindVertexArray(vao);
+
+	const unsigned int vertexCount = static_cast<unsigned int>(vertices.size());
+	const unsigned int indexCount = static_cast<unsigned int>(indices.size());
+
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+	if (vertexCount > vertexCapacity)
+	{
+		// Grow by double to avoid reallocating every time new ui is added
+		vertexCapacity = std::max(vertexCount, vertexCapacity * 2);
+	}
+
+	// Orphan previous buffer so driver doesn't wait for previous frame to finish
+	glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * vertexCapacity, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Vertex) * vertexCount, &vertices.front());
+
+	if (indexCount > indexCapacity)
+	{
+		indexCapacity = std::max(indexCount, indexCapacity * 2);
+	}
+
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * indexCapacity, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(unsigned int) * indexCount, &indices.front());
+}
+
+void Voxel::UI::BatchRenderer::render()
+{
+	if (draws.empty()) return;
+
+	auto& pm = ProgramManager::getInstance();
+	Program* programs[] = { pm.getProgram(ProgramManager::PROGRAM_NAME::UI_BATCH_SHADER), pm.getProgram(ProgramManager::PROGRAM_NAME::UI_TEXT_BATCH_SHADER) };
+
+	if (!indices.empty())
+	{
+		loadBuffers();
+	}
+
+	// Program that is in use. nullptr if custom draw used its own program, vao and texture.
+	Program* boundProgram = nullptr;
+	Texture2D* boundTexture = nullptr;
+
+	for (auto& draw : draws)
+	{
+		if (draw.type == Draw::Type::BATCH)
+		{
+			Program* program = programs[static_cast<int>(draw.shader)];
+
+			if (boundProgram == nullptr)
+			{
+				glBindVertexArray(vao);
+			}
+
+			if (boundProgram != program)
+			{
+				program->use(true);
+				program->setUniformInt(SID("tex"), 0);
+
+				boundProgram = program;
+			}
+
+			if (boundTexture != draw.texture)
+			{
+				draw.texture->activate(GL_TEXTURE0);
+				draw.texture->bind();
+
+				boundTexture = draw.texture;
+			}
+
+			if (draw.shader == Draw::Shader::TEXT)
+			{
+				if (draw.outlined)
+				{
+					program->setUniformBool(SID("outlined"), true);
+					program->setUniformInt(SID("outlineSize"), 2);
+					program->setUniformVec3(SID("outlineColor"), draw.outlineColor);
+
+					auto textureSize = draw.texture->getTextureSize();
+					program->setUniformFloat(SID("textureWidth"), static_cast<float>(textureSize.x));
+					program->setUniformFloat(SID("textureHeight"), static_cast<float>(textureSize.y));
+				}
+				else
+				{
+					program->setUniformBool(SID("outlined"), false);
+				}
+			}
+
+			glDrawElements(GL_TRIANGLES, draw.indexCount, GL_UNSIGNED_INT, (void*)(draw.indexOffset * sizeof(GLuint)));
+		}
+		else
+		{
+			if (draw.type == Draw::Type::RENDER_SELF)
+			{
+				static_cast<RenderNode*>(draw.node)->renderSelf();
+			}
+			else
+			{
+				draw.node->render();
+			}
+
+			// Node might changed program, vao and texture
+			boundProgram = nullptr;
+			boundTexture = nullptr;
+		}
+	}
+}
+
+const std::vector<Voxel::UI::BatchRenderer::Draw>& Voxel::UI::BatchRenderer::getDraws() const
+{
+	return draws;
+}
+
+unsigned int Voxel::UI::BatchRenderer::getDrawCount() const
+{
+	return static_cast<unsigned int>(draws.size());
+}
+
+unsigned int Voxel::UI::BatchRenderer::getBatchCount() const
+{
+	unsigned int count = 0;
+
+	for (auto& draw : draws)
+	{
+		if (draw.type == Draw::Type::BATCH)
+		{
+			count++;
+		}
+	}
+
+	return count;
+}
+
+unsigned int Voxel::UI::BatchRenderer::getUnbatchedDrawCount() const
+{
+	return getDrawCount() - getBatchCount();
+}
+
+unsigned int Voxel::UI::BatchRenderer::getVertexCount() const
+{
+	return static_cast<unsigned int>(vertices.size());
+}
+
+unsigned int Voxel::UI::BatchRenderer::getTriangleCount() const
+{
+	return static_cast<unsigned int>(indices.size() / 3);
+}
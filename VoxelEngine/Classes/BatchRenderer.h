@@ -0,0 +1,192 @@
+#ifndef BATCH_RENDERER_H
+#define BATCH_RENDERER_H
+
+// cpp
+#include <vector>
+
+// glm
+#include <glm\glm.hpp>
+
+// gl
+#include <GL\glew.h>
+
+namespace Voxel
+{
+	// foward declaration
+	class Texture2D;
+
+	namespace UI
+	{
+		// foward declaration
+		class TransformNode;
+		class RenderNode;
+
+		/**
+		*	@class BatchRenderer
+		*	@brief Collects ui geometry that shares same texture in to single vertex stream and draws with minimum draw calls.
+		*
+		*	Canvas walks ui tree in same order as RenderNode::render() and each node appends its geometry with appendGeometry().
+		*	Geometry is transformed to canvas space on CPU with node's model matrix, so consecutive nodes that share same texture
+		*	(sprite sheet) end up in same batch regardless of their transformation, color or opacity.
+		*	Text is batched with text shader. Consecutive texts that share font and outline end up in same batch.
+		*	Nodes that can't be batched (ProgressTimer, ParticleSystem, etc) are added with addRenderSelf() or addRender()
+		*	and render themselves, which breaks current batch.
+		*
+		*	Building batch is CPU only. It doesn't need OpenGL context until render() is called,
+		*	so batch and draw counts can be checked without window.
+		*/
+		class BatchRenderer
+		{
+		public:
+			// Single vertex in stream. Position is already transformed by node's model matrix.
+			struct Vertex
+			{
+				glm::vec3 position;
+				glm::vec2 uv;
+				// rgb is color, a is opacity.
+				glm::vec4 color;
+			};
+
+			// Single draw in render order
+			struct Draw
+			{
+				enum class Type
+				{
+					BATCH = 0,		// Draws range of indices with texture
+					RENDER_SELF,	// Calls RenderNode::renderSelf()
+					RENDER,			// Calls TransformNode::render(). Renders node and its children.
+				};
+
+				// Shader of batch
+				enum class Shader
+				{
+					TEXTURE = 0,	// Texture multiplied by vertex color
+					TEXT,			// Font atlas. Red channel is coverage. Can be outlined.
+				};
+
+				Type type;
+
+				Shader shader;
+
+				// Texture of batch. nullptr if it's not batch.
+				Texture2D* texture;
+
+				// Outline of text batch
+				bool outlined;
+				glm::vec3 outlineColor;
+
+				// Index range in stream
+				unsigned int indexOffset;
+				unsigned int indexCount;
+
+				// Node that renders itself. nullptr if it's batch.
+				TransformNode* node;
+			};
+		private:
+			// Vertex and index stream of current frame
+			std::vector<Vertex> vertices;
+			std::vector<unsigned int> indices;
+
+			// Draws in render order
+			std::vector<Draw> draws;
+
+			// gl
+			GLuint vao;
+			GLuint vbo;
+			GLuint ibo;
+
+			// Size of buffers on GPU in number of elements. Buffers only grow.
+			unsigned int vertexCapacity;
+			unsigned int indexCapacity;
+
+			// Append vertices that index range refers and indices to stream. Returns false if geometry is invalid.
+			bool appendStream(const std::vector<float>& vertexData, const std::vector<float>* colorData, const std::vector<float>& uvData, const std::vector<unsigned int>& indexData, const unsigned int indexOffset, const unsigned int indexCount, const glm::mat4& modelMat, const glm::vec4& color);
+
+			// Merge indices that were just appended to last draw if it's same batch. Else, start new batch.
+			void addBatch(const Draw::Shader shader, Texture2D* texture, const bool outlined, const glm::vec3& outlineColor, const unsigned int indexOffset, const unsigned int indexCount);
+
+			// Creates vao and buffers
+			void initBuffers();
+
+			// Uploads stream to GPU. Reallocates buffer if stream exceeds capacity
+			void loadBuffers();
+		public:
+			// Constructor
+			BatchRenderer();
+
+			// Destructor. Releases buffers.
+			~BatchRenderer();
+
+			/**
+			*	Clears all draws. Keeps capacity of stream for next frame.
+			*/
+			void clear();
+
+			/**
+			*	Append indexed geometry of node to stream.
+			*	Only vertices that are referenced by index range are appended.
+			*	If last draw is batch with same texture, geometry is merged to it. Else, starts new batch.
+			*	@param texture Texture of geometry.
+			*	@param vertexData Vertex positions in node space. 3 floats per vertex.
+			*	@param uvData Texture coordinates. 2 floats per vertex.
+			*	@param indexData Indices of triangles.
+			*	@param indexOffset Index of first index to append.
+			*	@param indexCount Number of indices to append.
+			*	@param modelMat Model matrix of node. Applied on CPU.
+			*	@param color Color and opacity of node.
+			*/
+			void appendGeometry(Texture2D* texture, const std::vector<float>& vertexData, const std::vector<float>& uvData, const std::vector<unsigned int>& indexData, const unsigned int indexOffset, const unsigned int indexCount, const glm::mat4& modelMat, const glm::vec4& color);
+
+			/**
+			*	Append glyph quads of text to stream. Drawn with text shader.
+			*	If last draw is text batch with same texture and outline, geometry is merged to it. Else, starts new batch.
+			*	@param texture Font texture.
+			*	@param vertexData Vertex positions in node space. 3 floats per vertex.
+			*	@param colorData Vertex colors. 3 floats per vertex.
+			*	@param uvData Texture coordinates. 2 floats per vertex.
+			*	@param indexData Indices of triangles.
+			*	@param indexCount Number of indices to append from start.
+			*	@param modelMat Model matrix of node. Applied on CPU.
+			*	@param opacity Opacity of text.
+			*	@param outlined true if text is outlined.
+			*	@param outlineColor Color of outline.
+			*/
+			void appendTextGeometry(Texture2D* texture, const std::vector<float>& vertexData, const std::vector<float>& colorData, const std::vector<float>& uvData, const std::vector<unsigned int>& indexData, const unsigned int indexCount, const glm::mat4& modelMat, const float opacity, const bool outlined, const glm::vec3& outlineColor);
+
+			/**
+			*	Add node that renders itself with renderSelf(). Breaks current batch.
+			*/
+			void addRenderSelf(RenderNode* node);
+
+			/**
+			*	Add node that renders itself and its children with render(). Breaks current batch.
+			*/
+			void addRender(TransformNode* node);
+
+			/**
+			*	Uploads stream and executes all draws in order.
+			*/
+			void render();
+
+			// Get all draws in order
+			const std::vector<Draw>& getDraws() const;
+
+			// Get number of draws, including batches and nodes that render themselves.
+			unsigned int getDrawCount() const;
+
+			// Get number of batches.
+			unsigned int getBatchCount() const;
+
+			// Get number of draws that isn't batched.
+			unsigned int getUnbatchedDrawCount() const;
+
+			// Get number of vertices in stream
+			unsigned int getVertexCount() const;
+
+			// Get number of triangles in stream
+			unsigned int getTriangleCount() const;
+		};
+	}
+}
+
+#endif
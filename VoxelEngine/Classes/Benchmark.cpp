@@ -0,0 +1,105 @@
+// pch
+#include "PreCompiled.h"
+
+#include "Benchmark.h"
+
+using namespace Voxel;
+
+bool Voxel::Benchmark::parseArguments(const int argc, const char * argv[], const std::vector<Argument>& arguments, const std::string & usage)
+{
+	// argv[0] is exe, argv[1] is flag
+	try
+	{
+		for (unsigned int i = 0; i < arguments.size(); i++)
+		{
+			const int index = static_cast<int>(i) + 2;
+
+			if (index < argc)
+			{
+				*arguments.at(i).value = std::stoi(argv[index]);
+			}
+		}
+	}
+	catch (...)
+	{
+		std::cout << "Usage: " << std::string(argc > 1 ? argv[1] : "") << " " << usage << "\n";
+		return false;
+	}
+
+	for (auto& argument : arguments)
+	{
+		*argument.value = std::max(argument.min, *argument.value);
+	}
+
+	return true;
+}
+
+std::vector<int> Voxel::Benchmark::doublingSteps(const int first, const int max)
+{
+	std::vector<int> steps;
+
+	for (int step = std::max(1, first); step < max; step *= 2)
+	{
+		steps.push_back(step);
+	}
+
+	steps.push_back(max);
+
+	return steps;
+}
+
+float Voxel::Benchmark::toMilliSeconds(const std::chrono::steady_clock::time_point & start, const std::chrono::steady_clock::time_point & end)
+{
+	return toNanoSeconds(start, end) / 1000000.0f;
+}
+
+float Voxel::Benchmark::toMicroSeconds(const std::chrono::steady_clock::time_point & start, const std::chrono::steady_clock::time_point & end)
+{
+	return toNanoSeconds(start, end) / 1000.0f;
+}
+
+float Voxel::Benchmark::toNanoSeconds(const std::chrono::steady_clock::time_point & start, const std::chrono::steady_clock::time_point & end)
+{
+	return static_cast<float>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+Voxel::Benchmark::ResultLine::ResultLine(const std::string & tag, const std::string & title)
+	: first(true)
+{
+	if (tag.empty())
+	{
+		ss << "  ";
+	}
+	else
+	{
+		ss << "[" << tag << "] ";
+	}
+
+	if (!title.empty())
+	{
+		ss << title << ": ";
+	}
+}
+
+void Voxel::Benchmark::ResultLine::separate()
+{
+	if (first)
+	{
+		first = false;
+	}
+	else
+	{
+		ss << ", ";
+	}
+}
+
+Voxel::Benchmark::ResultLine & Voxel::Benchmark::ResultLine::addChecks(const std::string & error)
+{
+	return add("checks", error.empty() ? std::string("ok") : "FAILED (" + error + ")");
+}
+
+void Voxel::Benchmark::ResultLine::print()
+{
+	ss << "\n";
+	std::cout << ss.str();
+}
@@ -0,0 +1,104 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+// cpp
+#include <string>
+#include <vector>
+#include <sstream>
+#include <chrono>
+
+namespace Voxel
+{
+	/**
+	*	@namespace Benchmark
+	*	@brief Shared parts of headless modes that run instead of application.
+	*
+	*	Each mode has static runFromCommandLine(argc, argv) that returns exit code for process and is added as one row
+	*	to mode table in main.cpp. Helpers here parse arguments, measure time and print result lines in same format.
+	*/
+	namespace Benchmark
+	{
+		// Entry of headless mode. argv[1] is flag of mode. Returns exit code for process.
+		typedef int(*Entry)(const int argc, const char* argv[]);
+
+		// Row of mode table
+		struct Mode
+		{
+			const char* flag;
+			Entry entry;
+		};
+
+		// Integer argument of mode
+		struct Argument
+		{
+			// Default value. Overwritten if argument is given.
+			int* value;
+			// Value is clamped to this
+			int min;
+		};
+
+		/**
+		*	Parses integer arguments after flag in order. argv[2] is first argument. Missing arguments keep default value.
+		*	@param arguments Arguments in order.
+		*	@param usage Arguments of mode for usage message. For example, "[radius] [seed]".
+		*	@return true if all given arguments are numbers. Else, prints usage and returns false.
+		*/
+		bool parseArguments(const int argc, const char* argv[], const std::vector<Argument>& arguments, const std::string& usage);
+
+		/**
+		*	Get first, first * 2, first * 4, ... and max. Only max if first isn't less than max.
+		*	Used for thread counts and sizes of each run.
+		*/
+		std::vector<int> doublingSteps(const int first, const int max);
+
+		// Elapsed time between time points
+		float toMilliSeconds(const std::chrono::steady_clock::time_point& start, const std::chrono::steady_clock::time_point& end);
+		float toMicroSeconds(const std::chrono::steady_clock::time_point& start, const std::chrono::steady_clock::time_point& end);
+		float toNanoSeconds(const std::chrono::steady_clock::time_point& start, const std::chrono::steady_clock::time_point& end);
+
+		/**
+		*	@class ResultLine
+		*	@brief Prints single line of result as "[Tag] title: name: value unit, name: value unit, ...".
+		*
+		*	Empty tag indents line instead, for details of previous line.
+		*/
+		class ResultLine
+		{
+		private:
+			std::ostringstream ss;
+
+			// true if nothing has been added after tag
+			bool first;
+
+			// Write separator before next item
+			void separate();
+		public:
+			/**
+			*	Constructor
+			*	@param tag Name of benchmark. Empty to indent.
+			*	@param title Name of run. Written after tag. Can be empty.
+			*/
+			ResultLine(const std::string& tag, const std::string& title = "");
+
+			// Destructor
+			~ResultLine() = default;
+
+			// Add named value
+			template<typename T>
+			ResultLine& add(const std::string& name, const T& value, const std::string& unit = "")
+			{
+				separate();
+				ss << name << ": " << value << unit;
+				return *this;
+			}
+
+			// Add result of checks. ok if error is empty.
+			ResultLine& addChecks(const std::string& error);
+
+			// Print line to console
+			void print();
+		};
+	}
+}
+
+#endif
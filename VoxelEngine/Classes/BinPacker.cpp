@@ -51,6 +51,12 @@ Voxel::Bin::BinPacker::~BinPacker()
 
 void Voxel::Bin::BinPacker::init(const glm::vec2 & boundary)
 {
+	if (root)
+	{
+		// Reinitialize. Drop all items
+		delete root;
+	}
+
 	root = createItemNode(glm::vec2(0), boundary);
 }
 
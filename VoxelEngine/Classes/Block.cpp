@@ -89,6 +89,20 @@ bool Voxel::Block::isEmpty()
 	}
 }
 
+bool Voxel::Block::isLeaves()
+{
+	switch (id)
+	{
+	case BLOCK_ID::OAK_LEAVES:
+	case BLOCK_ID::BIRCH_LEAVES:
+	case BLOCK_ID::SPRUCE_LEAVES:
+	case BLOCK_ID::PINE_LEAVES:
+		return true;
+	default:
+		return false;
+	}
+}
+
 bool Voxel::Block::isCollidable()
 {
 	if (id == BLOCK_ID::AIR)
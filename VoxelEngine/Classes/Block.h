@@ -78,6 +78,9 @@ namespace Voxel
 		// Check if block is solid block (cube with size of 1)
 		virtual bool isSolid();
 
+		// Check if block is leaves of any tree
+		bool isLeaves();
+
 		// Check if block is solid. Solid blocks are 1 sized cube. anything else that isn't complete cube (that is transparent, or size is less than 1) is not solid
 		//bool isSolid();
 
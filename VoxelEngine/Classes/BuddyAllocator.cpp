@@ -0,0 +1,357 @@
+// pch
+#include "PreCompiled.h"
+
+#include "BuddyAllocator.h"
+
+// cpp
+#include <algorithm>
+
+using namespace Voxel;
+
+const BuddyAllocator::Handle Voxel::BuddyAllocator::INVALID_HANDLE = 0xFFFFFFFF;
+
+static unsigned int roundUpToPowerOfTwo(unsigned int value)
+{
+	unsigned int result = 1;
+
+	while (result < value)
+	{
+		result <<= 1;
+	}
+
+	return result;
+}
+
+Voxel::BuddyAllocator::BuddyAllocator(const unsigned int capacity, const unsigned int minBlockSize)
+	: minBlockSize(roundUpToPowerOfTwo(std::max(1u, minBlockSize)))
+	, maxOrder(0)
+	, allocatedSize(0)
+	, requestedSize(0)
+	, allocationCount(0)
+{
+	const unsigned int roundedCapacity = roundUpToPowerOfTwo(std::max(capacity, this->minBlockSize));
+
+	while (getBlockSize(maxOrder) < roundedCapacity)
+	{
+		maxOrder++;
+	}
+
+	freeBlocks.resize(maxOrder + 1);
+	freeBlocks.at(maxOrder).insert(0);
+}
+
+unsigned int Voxel::BuddyAllocator::getOrder(const unsigned int size) const
+{
+	unsigned int order = 0;
+
+	while (getBlockSize(order) < size)
+	{
+		order++;
+	}
+
+	return order;
+}
+
+unsigned int Voxel::BuddyAllocator::getBlockSize(const unsigned int order) const
+{
+	return minBlockSize << order;
+}
+
+bool Voxel::BuddyAllocator::takeBlock(const unsigned int order, unsigned int & offset)
+{
+	// Find smallest free block that fits
+	unsigned int from = order;
+
+	while (from <= maxOrder && freeBlocks.at(from).empty())
+	{
+		from++;
+	}
+
+	if (from > maxOrder)
+	{
+		return false;
+	}
+
+	auto& blocks = freeBlocks.at(from);
+	offset = *blocks.begin();
+	blocks.erase(blocks.begin());
+
+	// Split. Keep lower half, free upper half.
+	while (from > order)
+	{
+		from--;
+		freeBlocks.at(from).insert(offset + getBlockSize(from));
+	}
+
+	return true;
+}
+
+void Voxel::BuddyAllocator::putBlock(unsigned int offset, unsigned int order)
+{
+	while (order < maxOrder)
+	{
+		const unsigned int buddy = offset ^ getBlockSize(order);
+
+		auto& blocks = freeBlocks.at(order);
+		auto find_it = blocks.find(buddy);
+
+		if (find_it == blocks.end())
+		{
+			break;
+		}
+
+		// Merge
+		blocks.erase(find_it);
+		offset = std::min(offset, buddy);
+		order++;
+	}
+
+	freeBlocks.at(order).insert(offset);
+}
+
+BuddyAllocator::Handle Voxel::BuddyAllocator::allocate(const unsigned int size)
+{
+	if (size == 0 || size > getCapacity())
+	{
+		return INVALID_HANDLE;
+	}
+
+	const unsigned int order = getOrder(size);
+
+	unsigned int offset = 0;
+
+	if (!takeBlock(order, offset))
+	{
+		return INVALID_HANDLE;
+	}
+
+	Handle handle = INVALID_HANDLE;
+
+	if (freeHandles.empty())
+	{
+		handle = static_cast<Handle>(allocations.size());
+		allocations.push_back(Allocation());
+	}
+	else
+	{
+		handle = freeHandles.back();
+		freeHandles.pop_back();
+	}
+
+	auto& allocation = allocations.at(handle);
+	allocation.offset = offset;
+	allocation.size = size;
+	allocation.order = order;
+	allocation.used = true;
+
+	allocatedSize += getBlockSize(order);
+	requestedSize += size;
+	allocationCount++;
+
+	return handle;
+}
+
+void Voxel::BuddyAllocator::release(const Handle handle)
+{
+	if (handle >= allocations.size())
+	{
+		return;
+	}
+
+	auto& allocation = allocations.at(handle);
+
+	if (!allocation.used)
+	{
+		// Released twice
+		assert(false);
+		return;
+	}
+
+	putBlock(allocation.offset, allocation.order);
+
+	allocatedSize -= getBlockSize(allocation.order);
+	requestedSize -= allocation.size;
+	allocationCount--;
+
+	allocation.used = false;
+	freeHandles.push_back(handle);
+}
+
+void Voxel::BuddyAllocator::reset()
+{
+	for (auto& blocks : freeBlocks)
+	{
+		blocks.clear();
+	}
+
+	freeBlocks.at(maxOrder).insert(0);
+
+	allocations.clear();
+	freeHandles.clear();
+
+	allocatedSize = 0;
+	requestedSize = 0;
+	allocationCount = 0;
+}
+
+bool Voxel::BuddyAllocator::grow()
+{
+	const unsigned int capacity = getCapacity();
+
+	if (capacity > 0x7FFFFFFF)
+	{
+		return false;
+	}
+
+	auto& top = freeBlocks.at(maxOrder);
+
+	if (top.find(0) != top.end())
+	{
+		// Whole range is free. Becomes lower half of new range.
+		top.erase(0);
+		maxOrder++;
+		freeBlocks.resize(maxOrder + 1);
+		freeBlocks.at(maxOrder).insert(0);
+	}
+	else
+	{
+		maxOrder++;
+		freeBlocks.resize(maxOrder + 1);
+		freeBlocks.at(maxOrder - 1).insert(capacity);
+	}
+
+	return true;
+}
+
+std::vector<BuddyAllocator::Move> Voxel::BuddyAllocator::compact()
+{
+	std::vector<Handle> handles;
+	handles.reserve(allocationCount);
+
+	const unsigned int size = static_cast<unsigned int>(allocations.size());
+
+	for (Handle handle = 0; handle < size; handle++)
+	{
+		if (allocations.at(handle).used)
+		{
+			handles.push_back(handle);
+		}
+	}
+
+	// Biggest first. Same size keeps address order so blocks that are already packed don't move.
+	std::sort(handles.begin(), handles.end(), [this](const Handle a, const Handle b)
+	{
+		auto& lhs = allocations.at(a);
+		auto& rhs = allocations.at(b);
+
+		if (lhs.order != rhs.order)
+		{
+			return lhs.order > rhs.order;
+		}
+
+		return lhs.offset < rhs.offset;
+	});
+
+	for (auto& blocks : freeBlocks)
+	{
+		blocks.clear();
+	}
+
+	freeBlocks.at(maxOrder).insert(0);
+
+	std::vector<Move> moves;
+
+	for (auto handle : handles)
+	{
+		auto& allocation = allocations.at(handle);
+
+		unsigned int offset = 0;
+
+		// Can't fail. Live blocks fit before, and sorted placement doesn't waste space.
+		bool result = takeBlock(allocation.order, offset);
+		assert(result);
+
+		if (offset != allocation.offset)
+		{
+			Move move;
+			move.handle = handle;
+			move.from = allocation.offset;
+			move.to = offset;
+			move.size = allocation.size;
+
+			moves.push_back(move);
+
+			allocation.offset = offset;
+		}
+	}
+
+	return moves;
+}
+
+unsigned int Voxel::BuddyAllocator::getOffset(const Handle handle) const
+{
+	return allocations.at(handle).offset;
+}
+
+unsigned int Voxel::BuddyAllocator::getSize(const Handle handle) const
+{
+	return allocations.at(handle).size;
+}
+
+bool Voxel::BuddyAllocator::canAllocate(const unsigned int size) const
+{
+	if (size == 0 || size > getCapacity())
+	{
+		return false;
+	}
+
+	for (unsigned int order = getOrder(size); order <= maxOrder; order++)
+	{
+		if (!freeBlocks.at(order).empty())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+unsigned int Voxel::BuddyAllocator::getAllocatedSize(const unsigned int size) const
+{
+	return getBlockSize(getOrder(size));
+}
+
+unsigned int Voxel::BuddyAllocator::getCapacity() const
+{
+	return getBlockSize(maxOrder);
+}
+
+BuddyAllocator::Stats Voxel::BuddyAllocator::getStats() const
+{
+	Stats stats;
+	stats.capacity = getCapacity();
+	stats.allocatedSize = allocatedSize;
+	stats.requestedSize = requestedSize;
+	stats.freeSize = 0;
+	stats.largestFreeBlock = 0;
+	stats.allocationCount = allocationCount;
+	stats.freeBlockCount = 0;
+
+	for (unsigned int order = 0; order <= maxOrder; order++)
+	{
+		auto& blocks = freeBlocks.at(order);
+
+		if (!blocks.empty())
+		{
+			const unsigned int blockSize = getBlockSize(order);
+
+			stats.freeSize += blockSize * static_cast<unsigned int>(blocks.size());
+			stats.freeBlockCount += static_cast<unsigned int>(blocks.size());
+			stats.largestFreeBlock = blockSize;
+		}
+	}
+
+	stats.fragmentation = stats.freeSize > 0 ? 1.0f - (static_cast<float>(stats.largestFreeBlock) / static_cast<float>(stats.freeSize)) : 0.0f;
+
+	return stats;
+}
@@ -0,0 +1,148 @@
+#ifndef BUDDY_ALLOCATOR_H
+#define BUDDY_ALLOCATOR_H
+
+// cpp
+#include <vector>
+#include <set>
+
+namespace Voxel
+{
+	/**
+	*	@class BuddyAllocator
+	*	@brief Sub allocates range of units with power of two size classes.
+	*
+	*	Doesn't own memory. Only tracks offsets, so it can be used for GPU buffer or tested without OpenGL.
+	*	Unit can be anything (byte, vertex, index). Offset of each block is multiple of block size.
+	*	Free block merges with its buddy on release. Free blocks are kept in address order per size class,
+	*	so allocation always takes lowest address and live blocks stay packed at front.
+	*
+	*	Allocation is referred by handle. Offset of handle can change on compact(), so don't cache offset.
+	*/
+	class BuddyAllocator
+	{
+	public:
+		typedef unsigned int Handle;
+
+		static const Handle INVALID_HANDLE;
+
+		// Allocation moved by compact()
+		struct Move
+		{
+			Handle handle;
+			unsigned int from;
+			unsigned int to;
+			unsigned int size;
+		};
+
+		struct Stats
+		{
+			// Total units
+			unsigned int capacity;
+			// Units in allocated blocks. Includes round up to block size.
+			unsigned int allocatedSize;
+			// Units requested by allocate()
+			unsigned int requestedSize;
+			// Units in free blocks
+			unsigned int freeSize;
+			// Biggest allocation that can succeed
+			unsigned int largestFreeBlock;
+			unsigned int allocationCount;
+			unsigned int freeBlockCount;
+			// 0 if all free units are in one block. Close to 1 if free units are scattered in small blocks.
+			float fragmentation;
+		};
+	private:
+		struct Allocation
+		{
+			unsigned int offset;
+			unsigned int size;
+			unsigned int order;
+			bool used;
+		};
+
+		// Size of smallest block
+		unsigned int minBlockSize;
+
+		// Block size of order n is minBlockSize << n. Max order is whole range.
+		unsigned int maxOrder;
+
+		// Offset of free blocks by order
+		std::vector<std::set<unsigned int>> freeBlocks;
+
+		// Allocations by handle
+		std::vector<Allocation> allocations;
+		std::vector<Handle> freeHandles;
+
+		unsigned int allocatedSize;
+		unsigned int requestedSize;
+		unsigned int allocationCount;
+
+		// Get smallest order that fits size
+		unsigned int getOrder(const unsigned int size) const;
+
+		// Get size of block in order
+		unsigned int getBlockSize(const unsigned int order) const;
+
+		// Take free block in order. Splits bigger block if needed.
+		bool takeBlock(const unsigned int order, unsigned int& offset);
+
+		// Put block back and merge with buddy
+		void putBlock(unsigned int offset, unsigned int order);
+	public:
+		/**
+		*	Constructor
+		*	@param capacity Number of units. Rounded up to power of two.
+		*	@param minBlockSize Size of smallest block in units. Rounded up to power of two.
+		*/
+		BuddyAllocator(const unsigned int capacity, const unsigned int minBlockSize);
+
+		// Destructor
+		~BuddyAllocator() = default;
+
+		/**
+		*	Allocate block.
+		*	@param size Number of units.
+		*	@return Handle of allocation. INVALID_HANDLE if there isn't free block that fits.
+		*/
+		Handle allocate(const unsigned int size);
+
+		// Release allocation.
+		void release(const Handle handle);
+
+		// Release all allocations.
+		void reset();
+
+		/**
+		*	Double capacity. New half is free. Existing offsets doesn't change.
+		*	@return false if capacity can't be doubled.
+		*/
+		bool grow();
+
+		/**
+		*	Pack live allocations to front so free space becomes few large blocks.
+		*	Places biggest allocations first, which leaves no gap between power of two blocks.
+		*	@return Allocations that moved. Caller must copy data. Source and destination of different moves can overlap.
+		*/
+		std::vector<Move> compact();
+
+		// Get offset of allocation
+		unsigned int getOffset(const Handle handle) const;
+
+		// Get size requested for allocation
+		unsigned int getSize(const Handle handle) const;
+
+		// Check if allocation of size can succeed without grow or compact
+		bool canAllocate(const unsigned int size) const;
+
+		// Get block size that size is rounded up to
+		unsigned int getAllocatedSize(const unsigned int size) const;
+
+		// Get total units
+		unsigned int getCapacity() const;
+
+		// Get stats. Iterates free lists.
+		Stats getStats() const;
+	};
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include "Quad.h"
 #include "ProgramManager.h"
 #include "Program.h"
+#include "BatchRenderer.h"
 #include "Utility.h"
 #include "InputHandler.h"
 
@@ -152,6 +153,11 @@ void Voxel::UI::Button::build(const std::vector<float>& vertices, const std::vec
 	glDeleteBuffers(1, &uvbo);
 	glDeleteBuffers(1, &ibo);
 
+	// Keep copy for batch
+	batchVertices.assign(vertices.begin(), vertices.end());
+	batchUVs.assign(uvs.begin(), uvs.end());
+	batchIndices.assign(indices.begin(), indices.end());
+
 #if V_DEBUG && V_DEBUG_DRAW_UI_BOUNDING_BOX && V_DEBUG_DRAW_BUTTON_BOUNDING_BOX
 	createDebugBoundingBoxLine();
 #endif
@@ -264,7 +270,7 @@ bool Voxel::UI::Button::updateMouseMove(const glm::vec2 & mousePosition, const g
 			auto rit = children.rbegin();
 			for(; rit != children.rend();)
 			{
-				bool result = (rit->second)->updateMouseMove(mousePosition, mouseDelta);
+				bool result = (rit->second)->updateMouseMoveCulled(mousePosition, mouseDelta);
 				if (result)
 				{
 					// child hovered
@@ -284,7 +290,7 @@ bool Voxel::UI::Button::updateMouseMove(const glm::vec2 & mousePosition, const g
 
 				for (; rit != children.rend(); rit++)
 				{
-					(rit->second)->updateMouseMoveFalse();
+					(rit->second)->updateMouseMoveFalseCulled();
 				}
 
 				updateMouseMoveFalse();
@@ -409,15 +415,28 @@ void Voxel::UI::Button::setOnCancelledCallbackFunc(const std::function<void(Voxe
 	onCancelled = func;
 }
 
+bool Voxel::UI::Button::appendBatch(BatchRenderer & batchRenderer)
+{
+	if (texture == nullptr || batchIndices.empty())
+	{
+		return false;
+	}
+
+	// Only current frame
+	batchRenderer.appendGeometry(texture, batchVertices, batchUVs, batchIndices, currentIndex, 6, glm::scale(modelMat, glm::vec3(scale, 1)), glm::vec4(color, opacity));
+
+	return true;
+}
+
 void Voxel::UI::Button::renderSelf()
 {
 	if (texture == nullptr) return;
 	if (program == nullptr) return;
 
 	program->use(true);
-	program->setUniformMat4("modelMat", glm::scale(modelMat, glm::vec3(scale, 1)));
-	program->setUniformFloat("opacity", opacity);
-	program->setUniformVec3("color", color);
+	program->setUniformMat4(SID("modelMat"), glm::scale(modelMat, glm::vec3(scale, 1)));
+	program->setUniformFloat(SID("opacity"), opacity);
+	program->setUniformVec3(SID("color"), color);
 
 	texture->activate(GL_TEXTURE0);
 	texture->bind();
@@ -434,9 +453,9 @@ void Voxel::UI::Button::renderSelf()
 	{
 		auto lineProgram = ProgramManager::getInstance().getProgram(Voxel::ProgramManager::PROGRAM_NAME::LINE_SHADER);
 		lineProgram->use(true);
-		lineProgram->setUniformMat4("modelMat", modelMat);
-		lineProgram->setUniformMat4("viewMat", glm::mat4(1.0f));
-		lineProgram->setUniformVec4("lineColor", glm::vec4(1.0f));
+		lineProgram->setUniformMat4(SID("modelMat"), modelMat);
+		lineProgram->setUniformMat4(SID("viewMat"), glm::mat4(1.0f));
+		lineProgram->setUniformVec4(SID("lineColor"), glm::vec4(1.0f));
 
 		glBindVertexArray(bbVao);
 		glDrawArrays(GL_LINES, 0, 8);
@@ -60,6 +60,9 @@ namespace Voxel
 			*/
 			virtual void build(const std::vector<float>& vertices, const std::vector<float>& uvs, const std::vector<unsigned int>& indices);
 
+			// Append current frame to batch
+			bool appendBatch(BatchRenderer& batchRenderer) override;
+
 			// update mouse move
 			bool updateButtonMouseMove(const glm::vec2& mousePosition, const glm::vec2& mouseDelta);
 		public:
@@ -6,6 +6,9 @@
 // Voxel
 #include "Camera.h"
 #include "Logger.h"
+#include "FrameProfiler.h"
+
+const unsigned int Voxel::UI::Canvas::HIT_TREE_LEAF_SIZE = 4;
 
 Voxel::UI::Canvas::Canvas(const glm::vec2& size, const glm::vec2& centerPosition)
 	: TransformNode("")
@@ -47,6 +50,8 @@ glm::mat4 Voxel::UI::Canvas::getModelMatrix()
 
 void Voxel::UI::Canvas::update(const float delta)
 {
+	V_PROFILE_ZONE("UI::Canvas::update");
+
 	for (auto& e : children)
 	{
 		(e.second)->update(delta);
@@ -59,14 +64,40 @@ bool Voxel::UI::Canvas::updateMouseMove(const glm::vec2 & mousePosition, const g
 
 	if (visibility)
 	{
+		if (needToUpdateBoundingVolume)
+		{
+			buildHitTree();
+		}
+
+		// Children under mouse
+		auto& targets = hitTreeTargets;
+		targets.clear();
+		queryHitTree(mousePosition, targets);
+
+		// Children that handled mouse move on last update. They need update to get mouse exit or keep dragging.
+		targets.insert(targets.end(), activeHitTreeEntries.begin(), activeHitTreeEntries.end());
+
+		// Entries are in z order.
+		std::sort(targets.begin(), targets.end());
+		targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+
+		activeHitTreeEntries.clear();
+
 		bool moved = false;
-		for (auto& e : children)
+		for (auto index : targets)
 		{
-			bool result = (e.second)->updateMouseMove(mousePosition, mouseDelta);
+			auto node = hitTreeEntries.at(index).node;
+
+			bool result = node->updateMouseMoveCulled(mousePosition, mouseDelta);
 			if (result)
 			{
 				moved = true;
 			}
+
+			if (node->isMouseMoveActive())
+			{
+				activeHitTreeEntries.push_back(index);
+			}
 		}
 
 		return moved;
@@ -129,12 +160,179 @@ void Voxel::UI::Canvas::render()
 {
 	if (!visibility) return;
 
+#if V_UI_BATCH
+	updateBatch();
+
+	batchRenderer.render();
+#else
 	// Iterate children
 	for (auto& e : children)
 	{
 		// Multiply model matrix with screen space
 		(e.second)->render();
 	}
+#endif
+}
+
+void Voxel::UI::Canvas::buildBatch(BatchRenderer & batchRenderer)
+{
+	if (!visibility) return;
+
+	// Iterate children
+	for (auto& e : children)
+	{
+		(e.second)->buildBatch(batchRenderer);
+	}
+}
+
+void Voxel::UI::Canvas::updateBatch()
+{
+	batchRenderer.clear();
+
+	if (!visibility) return;
+
+	// Rebuild what needs gl first. Walking tree to build batch is CPU only.
+	for (auto& e : children)
+	{
+		(e.second)->prepareBatch();
+	}
+
+	buildBatch(batchRenderer);
+}
+
+const Voxel::UI::BatchRenderer & Voxel::UI::Canvas::getBatchRenderer() const
+{
+	return batchRenderer;
+}
+
+void Voxel::UI::Canvas::buildHitTree()
+{
+	// Updates bounding volume of all dirty children
+	getBoundingVolume();
+
+	hitTreeEntries.clear();
+	hitTreeIndices.clear();
+	hitTree.clear();
+	activeHitTreeEntries.clear();
+
+	for (auto& e : children)
+	{
+		auto volume = (e.second)->getBoundingVolume();
+
+		HitTreeEntry entry;
+		entry.node = e.second;
+		entry.min = volume.getMin();
+		entry.max = volume.getMax();
+
+		if ((e.second)->isMouseMoveActive())
+		{
+			// Keep active children. Removed children won't be in entries anymore.
+			activeHitTreeEntries.push_back(static_cast<unsigned int>(hitTreeEntries.size()));
+		}
+
+		hitTreeIndices.push_back(static_cast<unsigned int>(hitTreeEntries.size()));
+		hitTreeEntries.push_back(entry);
+	}
+
+	if (!hitTreeEntries.empty())
+	{
+		hitTree.reserve(hitTreeEntries.size() * 2);
+
+		buildHitTreeNode(0, static_cast<unsigned int>(hitTreeIndices.size()));
+	}
+}
+
+int Voxel::UI::Canvas::buildHitTreeNode(const unsigned int first, const unsigned int count)
+{
+	HitTreeNode node;
+	node.min = glm::vec2(std::numeric_limits<float>::max());
+	node.max = glm::vec2(std::numeric_limits<float>::lowest());
+	node.left = -1;
+	node.right = -1;
+	node.first = first;
+	node.count = count;
+
+	for (unsigned int i = first; i < first + count; i++)
+	{
+		auto& entry = hitTreeEntries.at(hitTreeIndices.at(i));
+
+		node.min = glm::min(node.min, entry.min);
+		node.max = glm::max(node.max, entry.max);
+	}
+
+	const int nodeIndex = static_cast<int>(hitTree.size());
+	hitTree.push_back(node);
+
+	if (count <= HIT_TREE_LEAF_SIZE)
+	{
+		// Leaf
+		return nodeIndex;
+	}
+
+	// Split by median on longest axis
+	const auto size = node.max - node.min;
+	const int axis = (size.x >= size.y) ? 0 : 1;
+	const unsigned int half = count / 2;
+
+	auto begin = hitTreeIndices.begin() + first;
+
+	std::nth_element(begin, begin + half, begin + count, [this, axis](const unsigned int lhs, const unsigned int rhs)
+	{
+		auto& l = hitTreeEntries.at(lhs);
+		auto& r = hitTreeEntries.at(rhs);
+
+		return (l.min[axis] + l.max[axis]) < (r.min[axis] + r.max[axis]);
+	});
+
+	const int left = buildHitTreeNode(first, half);
+	const int right = buildHitTreeNode(first + half, count - half);
+
+	// Vector might have grown. Access by index.
+	hitTree.at(nodeIndex).left = left;
+	hitTree.at(nodeIndex).right = right;
+	hitTree.at(nodeIndex).count = 0;
+
+	return nodeIndex;
+}
+
+void Voxel::UI::Canvas::queryHitTree(const glm::vec2 & point, std::vector<unsigned int>& result)
+{
+	if (hitTree.empty()) return;
+
+	auto& stack = hitTreeStack;
+	stack.clear();
+	stack.push_back(0);
+
+	while (!stack.empty())
+	{
+		auto& node = hitTree.at(stack.back());
+		stack.pop_back();
+
+		if (point.x < node.min.x || point.x > node.max.x || point.y < node.min.y || point.y > node.max.y)
+		{
+			continue;
+		}
+
+		if (node.left == -1)
+		{
+			// Leaf. Test each children
+			for (unsigned int i = node.first; i < node.first + node.count; i++)
+			{
+				auto index = hitTreeIndices.at(i);
+				auto& entry = hitTreeEntries.at(index);
+
+				if (entry.min.x <= point.x && point.x <= entry.max.x && entry.min.y <= point.y && point.y <= entry.max.y)
+				{
+					result.push_back(index);
+				}
+			}
+		}
+		else
+		{
+			stack.push_back(node.left);
+			stack.push_back(node.right);
+		}
+	}
 }
 
 #if V_DEBUG && V_DEBUG_PRINT
@@ -5,6 +5,7 @@
 
 // voxel
 #include "Config.h"
+#include "BatchRenderer.h"
 
 namespace Voxel
 {
@@ -42,6 +43,60 @@ namespace Voxel
 			// Center position of canvas in screen space. Center of monitor screen is 0
 			glm::vec2 centerPosition;
 
+			// Batches all ui in canvas.
+			BatchRenderer batchRenderer;
+
+			// Node of bounding volume hierarchy over children's bounding volume.
+			struct HitTreeNode
+			{
+				glm::vec2 min;
+				glm::vec2 max;
+
+				// Index of child nodes in hitTree. -1 if leaf.
+				int left;
+				int right;
+
+				// Range of leaf in hitTreeIndices
+				unsigned int first;
+				unsigned int count;
+			};
+
+			// Child of canvas with its bounding volume.
+			struct HitTreeEntry
+			{
+				TransformNode* node;
+				glm::vec2 min;
+				glm::vec2 max;
+			};
+
+			// Max number of entries in leaf
+			static const unsigned int HIT_TREE_LEAF_SIZE;
+
+			// Children in z order.
+			std::vector<HitTreeEntry> hitTreeEntries;
+
+			// Index of hitTreeEntries, sorted by hit tree leaves.
+			std::vector<unsigned int> hitTreeIndices;
+
+			// Bounding volume hierarchy. First node is root. Rebuilt when bounding volume of any children changed.
+			std::vector<HitTreeNode> hitTree;
+
+			// Index of hitTreeEntries that were active on last mouse move.
+			std::vector<unsigned int> activeHitTreeEntries;
+
+			// Scratch buffers for mouse move. Kept, so mouse move doesn't allocate.
+			std::vector<unsigned int> hitTreeTargets;
+			std::vector<int> hitTreeStack;
+
+			// Rebuilds hit tree with children's bounding volume
+			void buildHitTree();
+
+			// Builds node for range of hitTreeIndices. Returns index of node.
+			int buildHitTreeNode(const unsigned int first, const unsigned int count);
+
+			// Finds index of hitTreeEntries that contains point and appends to result
+			void queryHitTree(const glm::vec2& point, std::vector<unsigned int>& result);
+
 			// Override
 			void updateModelMatrix() override;
 
@@ -104,6 +159,23 @@ namespace Voxel
 			*/
 			void render() override;
 
+			/**
+			*	Add all UI to batch renderer in render order. Doesn't need OpenGL context.
+			*	@param batchRenderer Batch renderer to add.
+			*/
+			void buildBatch(BatchRenderer& batchRenderer) override;
+
+			/**
+			*	Clears batch renderer, prepares all UI and builds batch. Called by render() before draw.
+			*	Building doesn't need OpenGL context, but preparing can (see Text::prepareBatch).
+			*/
+			void updateBatch();
+
+			/**
+			*	Get batch renderer that was used on last render.
+			*/
+			const BatchRenderer& getBatchRenderer() const;
+
 #if V_DEBUG && V_DEBUG_PRINT
 			void print();
 #endif
@@ -364,7 +364,7 @@ bool Voxel::UI::CheckBox::updateMouseMove(const glm::vec2 & mousePosition, const
 			auto rit = children.rbegin();
 			for (; rit != children.rend();)
 			{
-				bool result = (rit->second)->updateMouseMove(mousePosition, mouseDelta);
+				bool result = (rit->second)->updateMouseMoveCulled(mousePosition, mouseDelta);
 				if (result)
 				{
 					// child hovered
@@ -384,7 +384,7 @@ bool Voxel::UI::CheckBox::updateMouseMove(const glm::vec2 & mousePosition, const
 
 				for (; rit != children.rend(); rit++)
 				{
-					(rit->second)->updateMouseMoveFalse();
+					(rit->second)->updateMouseMoveFalseCulled();
 				}
 
 				updateMouseMoveFalse();
@@ -555,9 +555,9 @@ void Voxel::UI::CheckBox::renderSelf()
 	if (program == nullptr) return;
 
 	program->use(true);
-	program->setUniformMat4("modelMat", glm::scale(modelMat, glm::vec3(scale, 1)));
-	program->setUniformFloat("opacity", opacity);
-	program->setUniformVec3("color", color);
+	program->setUniformMat4(SID("modelMat"), glm::scale(modelMat, glm::vec3(scale, 1)));
+	program->setUniformFloat(SID("opacity"), opacity);
+	program->setUniformVec3(SID("color"), color);
 
 	texture->activate(GL_TEXTURE0);
 	texture->bind();
@@ -574,9 +574,9 @@ void Voxel::UI::CheckBox::renderSelf()
 	{
 		auto lineProgram = ProgramManager::getInstance().getProgram(Voxel::ProgramManager::PROGRAM_NAME::LINE_SHADER);
 		lineProgram->use(true);
-		lineProgram->setUniformMat4("modelMat", modelMat);
-		lineProgram->setUniformMat4("viewMat", glm::mat4(1.0f));
-		lineProgram->setUniformVec4("lineColor", glm::vec4(1.0f));
+		lineProgram->setUniformMat4(SID("modelMat"), modelMat);
+		lineProgram->setUniformMat4(SID("viewMat"), glm::mat4(1.0f));
+		lineProgram->setUniformVec4(SID("lineColor"), glm::vec4(1.0f));
 
 		glBindVertexArray(bbVao);
 		glDrawArrays(GL_LINES, 0, 8);
@@ -8,7 +8,6 @@
 #include "ChunkMesh.h"
 #include "Utility.h"
 #include "HeightMap.h"
-#include "ProgramManager.h"
 #include "Program.h"
 
 using namespace Voxel;
@@ -96,10 +95,15 @@ void Voxel::Chunk::initRandomEngine(const std::string & worldSeed)
 }
 
 void Voxel::Chunk::updateModelMat(const glm::vec3 & playerPosition)
+{
+	modelMat = glm::translate(glm::mat4(1.0f), getRelativeOrigin(playerPosition));
+}
+
+glm::vec3 Voxel::Chunk::getRelativeOrigin(const glm::vec3 & center) const
 {
 	auto chunkWP = glm::vec3(worldPosition.x - Constant::CHUNK_BORDER_SIZE_HALF, 0.0f, worldPosition.z - Constant::CHUNK_BORDER_SIZE_HALF);
 
-	modelMat = glm::translate(glm::mat4(1.0f), chunkWP - playerPosition);
+	return chunkWP - center;
 }
 
 void Voxel::Chunk::unload()
@@ -340,57 +344,6 @@ int Voxel::Chunk::findMaxY()
 	return max;
 }
 
-void Voxel::Chunk::render(const glm::vec3& playerPosition)
-{
-	auto program = ProgramManager::getInstance().getProgram(ProgramManager::PROGRAM_NAME::BLOCK_SHADER);
-
-	if (chunkMesh)
-	{
-		if (chunkMesh->isRenderable())
-		{
-			// Ready to render
-			bool result = chunkMesh->bind();
-			if (result)
-			{
-				updateModelMat(playerPosition);
-				program->setUniformMat4("modelMat", modelMat);
-				chunkMesh->render();
-			}
-			else
-			{
-				assert(false);
-			}
-		}
-		else
-		{
-			// mesh is not renderable. See if it can load
-			if (chunkMesh->isBufferLoadable())
-			{
-				chunkMesh->loadBuffer(program);
-
-				// Now ready to render
-				bool result = chunkMesh->bind();
-				if (result)
-				{
-					updateModelMat(playerPosition);
-					program->setUniformMat4("modelMat", modelMat);
-					chunkMesh->render();
-				}
-				else
-				{
-					assert(false);
-				}
-			}
-			else
-			{
-				// Not renderable, buffer not ready.
-				return;
-			}
-		}
-	}
-	// Doens't have chunk mesh. should be error
-}
-
 void Voxel::Chunk::setActive(const bool state)
 {
 	active = state;
@@ -416,7 +369,7 @@ void Voxel::Chunk::releaseMesh()
 	if (chunkMesh)
 	{
 		// delete mesh
-		chunkMesh->releaseVAO();
+		chunkMesh->releaseGeometry();
 	}
 }
 
@@ -94,6 +94,9 @@ namespace Voxel
 
 		void updateModelMat(const glm::vec3& playerPosition);
 
+		// Get position of chunk's min corner relative to center. Translation of model matrix.
+		glm::vec3 getRelativeOrigin(const glm::vec3& center) const;
+
 		// Generates chunk.
 		bool generate();
 
@@ -122,9 +125,6 @@ namespace Voxel
 
 		int findMaxY();
 
-		// Render chunk
-		void render(const glm::vec3& playerPosition);
-
 		// Set active state
 		void setActive(const bool state);
 		// Get active state
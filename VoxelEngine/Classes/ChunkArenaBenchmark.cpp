@@ -0,0 +1,477 @@
+// pch
+#include "PreCompiled.h"
+
+#include "ChunkArenaBenchmark.h"
+
+// cpp
+#include <thread>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <cstring>
+
+// voxel
+#include "BuddyAllocator.h"
+#include "StagingRing.h"
+#include "ChunkGeometryArena.h"
+#include "Benchmark.h"
+#include "Utility.h"
+
+using namespace Voxel;
+
+namespace
+{
+	// Live allocation of allocator run
+	struct LiveBlock
+	{
+		BuddyAllocator::Handle handle;
+		// Written to first and last unit of block. Unique per allocation.
+		unsigned int stamp;
+	};
+
+	// Stamp first and last unit of allocation in buffer
+	void stampBlock(const BuddyAllocator& allocator, const LiveBlock& block, std::vector<unsigned int>& buffer)
+	{
+		const unsigned int offset = allocator.getOffset(block.handle);
+
+		buffer.at(offset) = block.stamp;
+		buffer.at(offset + allocator.getSize(block.handle) - 1) = block.stamp;
+	}
+
+	// Copy moved ranges in buffer same as ChunkGeometryArena::compactBuffer. Returns error if move doesn't match allocator.
+	std::string applyMoves(const BuddyAllocator& allocator, const std::vector<BuddyAllocator::Move>& moves, std::vector<unsigned int>& buffer)
+	{
+		std::vector<unsigned int> temp;
+
+		for (auto& move : moves)
+		{
+			temp.insert(temp.end(), buffer.begin() + move.from, buffer.begin() + move.from + move.size);
+		}
+
+		unsigned int tempOffset = 0;
+
+		for (auto& move : moves)
+		{
+			if (allocator.getOffset(move.handle) != move.to || allocator.getSize(move.handle) != move.size)
+			{
+				return "move of handle " + std::to_string(move.handle) + " doesn't match its offset or size";
+			}
+
+			std::copy(temp.begin() + tempOffset, temp.begin() + tempOffset + move.size, buffer.begin() + move.to);
+			tempOffset += move.size;
+		}
+
+		return "";
+	}
+
+	// Check that live blocks don't overlap, keep their contents, and free space adds up to capacity
+	std::string checkAllocator(const BuddyAllocator& allocator, const std::vector<LiveBlock>& live, const std::vector<unsigned int>& buffer)
+	{
+		auto stats = allocator.getStats();
+
+		if (stats.allocatedSize + stats.freeSize != stats.capacity)
+		{
+			return "allocated " + std::to_string(stats.allocatedSize) + " + free " + std::to_string(stats.freeSize) + " != capacity " + std::to_string(stats.capacity);
+		}
+
+		if (stats.allocationCount != live.size())
+		{
+			return std::to_string(stats.allocationCount) + " allocations in allocator, " + std::to_string(live.size()) + " live";
+		}
+
+		// (offset, block size) of each live block
+		std::vector<std::pair<unsigned int, unsigned int>> blocks;
+		blocks.reserve(live.size());
+
+		unsigned long long allocatedSize = 0;
+
+		for (auto& block : live)
+		{
+			const unsigned int offset = allocator.getOffset(block.handle);
+			const unsigned int size = allocator.getSize(block.handle);
+			const unsigned int blockSize = allocator.getAllocatedSize(size);
+
+			if (offset + blockSize > stats.capacity)
+			{
+				return "handle " + std::to_string(block.handle) + " ends out of capacity";
+			}
+
+			if (buffer.at(offset) != block.stamp || buffer.at(offset + size - 1) != block.stamp)
+			{
+				return "contents of handle " + std::to_string(block.handle) + " are lost";
+			}
+
+			blocks.push_back(std::make_pair(offset, blockSize));
+			allocatedSize += blockSize;
+		}
+
+		if (allocatedSize != stats.allocatedSize)
+		{
+			return "live blocks have " + std::to_string(allocatedSize) + " units, allocator " + std::to_string(stats.allocatedSize);
+		}
+
+		std::sort(blocks.begin(), blocks.end());
+
+		for (size_t i = 1; i < blocks.size(); i++)
+		{
+			if (blocks.at(i - 1).first + blocks.at(i - 1).second > blocks.at(i).first)
+			{
+				return "blocks at " + std::to_string(blocks.at(i - 1).first) + " and " + std::to_string(blocks.at(i).first) + " overlap";
+			}
+		}
+
+		return "";
+	}
+}
+
+Voxel::ChunkArenaBenchmark::ChunkArenaBenchmark(const unsigned int operations, const unsigned int stagedMeshes, const int threadCount)
+	: operations(operations)
+	, stagedMeshes(stagedMeshes)
+	, threadCount(threadCount)
+{}
+
+ChunkArenaBenchmark::AllocatorResult Voxel::ChunkArenaBenchmark::runAllocator()
+{
+	// Units are vertices. Same as vertex allocator of arena.
+	BuddyAllocator allocator(ChunkGeometryArena::DEFAULT_VERTEX_CAPACITY, ChunkGeometryArena::MIN_VERTEX_BLOCK);
+
+	std::mt19937 engine(12345);
+	// Most chunks are surface with few thousands vertices. Some are mountains or caves.
+	std::lognormal_distribution<float> sizeDist(8.5f, 0.8f);
+	std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+
+	// Around render distance 12
+	const unsigned int liveTarget = 450;
+
+	std::vector<LiveBlock> live;
+	live.reserve(liveTarget * 2);
+
+	// Stands for GPU buffer. Only stamps are written.
+	std::vector<unsigned int> buffer(allocator.getCapacity(), 0);
+	unsigned int nextStamp = 1;
+
+	AllocatorResult result;
+	result.operations = operations;
+	result.peakAllocations = 0;
+	result.growCount = 0;
+	result.compactCount = 0;
+	result.movedSize = 0;
+
+	// Time of operations. Checks after compact and grow aren't included.
+	float elapsedNanoSeconds = 0.0f;
+
+	auto start = Utility::Time::now();
+
+	for (unsigned int i = 0; i < operations && result.error.empty(); i++)
+	{
+		// Keep number of live meshes around target
+		const float allocateChance = live.size() < liveTarget ? 0.6f : 0.4f;
+
+		if (live.empty() || chance(engine) < allocateChance)
+		{
+			const unsigned int size = std::max(1u, std::min(static_cast<unsigned int>(sizeDist(engine)), 65535u));
+
+			auto handle = allocator.allocate(size);
+			bool changed = false;
+
+			if (handle == BuddyAllocator::INVALID_HANDLE && allocator.getStats().freeSize >= allocator.getAllocatedSize(size))
+			{
+				auto moves = allocator.compact();
+
+				for (auto& move : moves)
+				{
+					result.movedSize += move.size;
+				}
+
+				result.error = applyMoves(allocator, moves, buffer);
+				result.compactCount++;
+				changed = true;
+
+				handle = allocator.allocate(size);
+			}
+
+			while (handle == BuddyAllocator::INVALID_HANDLE && allocator.grow())
+			{
+				result.growCount++;
+				changed = true;
+
+				// Existing offsets doesn't change. New half is free.
+				buffer.resize(allocator.getCapacity(), 0);
+
+				handle = allocator.allocate(size);
+			}
+
+			if (handle == BuddyAllocator::INVALID_HANDLE)
+			{
+				result.error = "allocation of " + std::to_string(size) + " failed";
+				break;
+			}
+
+			LiveBlock block;
+			block.handle = handle;
+			block.stamp = nextStamp++;
+
+			stampBlock(allocator, block, buffer);
+
+			live.push_back(block);
+			result.peakAllocations = std::max(result.peakAllocations, static_cast<unsigned int>(live.size()));
+
+			if (changed && result.error.empty())
+			{
+				auto checkStart = Utility::Time::now();
+				elapsedNanoSeconds += Benchmark::toNanoSeconds(start, checkStart);
+
+				result.error = checkAllocator(allocator, live, buffer);
+
+				start = Utility::Time::now();
+			}
+		}
+		else
+		{
+			// Random chunk unloads or remeshes
+			const size_t index = static_cast<size_t>(engine() % live.size());
+
+			allocator.release(live.at(index).handle);
+
+			live.at(index) = live.back();
+			live.pop_back();
+		}
+	}
+
+	auto end = Utility::Time::now();
+	elapsedNanoSeconds += Benchmark::toNanoSeconds(start, end);
+
+	result.nanoSecondsPerOperation = elapsedNanoSeconds / static_cast<float>(std::max(1u, operations));
+
+	if (result.error.empty())
+	{
+		result.error = checkAllocator(allocator, live, buffer);
+	}
+
+	auto before = allocator.getStats();
+
+	auto compactStart = Utility::Time::now();
+	auto moves = allocator.compact();
+	auto compactEnd = Utility::Time::now();
+
+	if (result.error.empty())
+	{
+		result.error = applyMoves(allocator, moves, buffer);
+	}
+
+	if (result.error.empty())
+	{
+		result.error = checkAllocator(allocator, live, buffer);
+	}
+
+	auto after = allocator.getStats();
+
+	// Compaction packs live blocks to front, so all free space must be after them
+	for (size_t i = 0; i < live.size() && result.error.empty(); i++)
+	{
+		auto handle = live.at(i).handle;
+
+		if (allocator.getOffset(handle) + allocator.getAllocatedSize(allocator.getSize(handle)) > after.allocatedSize)
+		{
+			result.error = "handle " + std::to_string(handle) + " isn't packed after compaction";
+		}
+	}
+
+	result.fragmentationBefore = before.fragmentation;
+	result.fragmentationAfter = after.fragmentation;
+	result.compactMilliSeconds = Benchmark::toMilliSeconds(compactStart, compactEnd);
+	result.utilization = after.allocatedSize > 0 ? static_cast<float>(after.requestedSize) / static_cast<float>(after.allocatedSize) : 1.0f;
+	result.capacity = after.capacity;
+
+	return result;
+}
+
+ChunkArenaBenchmark::StagingResult Voxel::ChunkArenaBenchmark::runStaging(const bool loadAll)
+{
+	StagingRing ring(64 * 1024 * 1024);
+
+	struct Staged
+	{
+		StagingRing::Block block;
+		std::vector<char> fallback;
+	};
+
+	std::deque<Staged> queue;
+	std::mutex queueMutex;
+
+	std::atomic<unsigned int> produced(0);
+	std::atomic<unsigned long long> stagedBytes(0);
+
+	auto produce = [&](const int threadIndex)
+	{
+		std::mt19937 engine(static_cast<unsigned int>(threadIndex + 1));
+		// 40 bytes per vertex, 4 bytes per index
+		std::uniform_int_distribution<unsigned int> sizeDist(2000 * 44, 20000 * 44);
+
+		std::vector<char> mesh(20000 * 44, 1);
+
+		while (produced.fetch_add(1) < stagedMeshes)
+		{
+			const unsigned int size = sizeDist(engine);
+
+			// Building mesh takes a while. Without this, workers outrun main thread and ring is full for reason real game doesn't have.
+			auto buildStart = Utility::Time::now();
+			while (std::chrono::duration_cast<std::chrono::microseconds>(Utility::Time::now() - buildStart).count() < 50)
+			{
+				std::this_thread::yield();
+			}
+
+			Staged staged;
+
+			char* data = nullptr;
+
+			if (ring.allocate(size, staged.block))
+			{
+				data = ring.getData(staged.block);
+			}
+			else
+			{
+				staged.fallback.resize(size);
+				data = staged.fallback.data();
+			}
+
+			std::memcpy(data, mesh.data(), size);
+
+			stagedBytes.fetch_add(size);
+
+			std::unique_lock<std::mutex> lock(queueMutex);
+			queue.push_back(std::move(staged));
+		}
+	};
+
+	auto start = Utility::Time::now();
+
+	std::vector<std::thread> threads;
+
+	for (int i = 0; i < threadCount; i++)
+	{
+		threads.push_back(std::thread(produce, i));
+	}
+
+	// Main thread. Loads in staging order, or only meshes of visible chunks.
+	std::mt19937 engine(777);
+	std::deque<Staged> offScreen;
+	unsigned int received = 0;
+
+	while (received < stagedMeshes)
+	{
+		Staged staged;
+		bool found = false;
+
+		{
+			std::unique_lock<std::mutex> lock(queueMutex);
+
+			if (!queue.empty())
+			{
+				staged = std::move(queue.front());
+				queue.pop_front();
+				found = true;
+			}
+		}
+
+		if (!found)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		received++;
+
+		if (!loadAll && engine() % 8 == 0)
+		{
+			// Chunk is off screen. Stays staged while player looks away.
+			offScreen.push_back(std::move(staged));
+		}
+		else
+		{
+			ring.release(staged.block);
+		}
+	}
+
+	for (auto& staged : offScreen)
+	{
+		ring.release(staged.block);
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	auto end = Utility::Time::now();
+
+	auto stats = ring.getStats();
+
+	StagingResult result;
+	result.loadAll = loadAll;
+	result.threadCount = threadCount;
+	result.blockCount = stats.allocationCount + stats.failedAllocationCount;
+	result.failedCount = stats.failedAllocationCount;
+	result.megaBytesPerSecond = static_cast<float>(stagedBytes.load()) / (1024.0f * 1024.0f) / (Benchmark::toMilliSeconds(start, end) / 1000.0f);
+	result.peakUsedSize = stats.peakUsedSize;
+	result.capacity = stats.capacity;
+
+	return result;
+}
+
+void Voxel::ChunkArenaBenchmark::printResult(const AllocatorResult & result)
+{
+	Benchmark::ResultLine("ChunkArenaBenchmark", "allocator")
+		.add("ops", result.operations)
+		.add("per op", result.nanoSecondsPerOperation, "ns")
+		.add("peak meshes", result.peakAllocations)
+		.add("capacity", result.capacity, " vertices")
+		.add("grows", result.growCount)
+		.add("compactions", result.compactCount)
+		.add("moved", result.movedSize, " vertices")
+		.add("fragmentation", result.fragmentationBefore)
+		.add("after compaction", result.fragmentationAfter)
+		.add("compaction", result.compactMilliSeconds, "ms")
+		.add("utilization", result.utilization)
+		.addChecks(result.error)
+		.print();
+}
+
+void Voxel::ChunkArenaBenchmark::printResult(const StagingResult & result)
+{
+	Benchmark::ResultLine("ChunkArenaBenchmark", result.loadAll ? "staging (load all)" : "staging (load visible)")
+		.add("threads", result.threadCount)
+		.add("blocks", result.blockCount)
+		.add("ring full", result.failedCount)
+		.add("throughput", result.megaBytesPerSecond, "MB/s")
+		.add("peak", std::to_string(result.peakUsedSize / (1024 * 1024)) + " / " + std::to_string(result.capacity / (1024 * 1024)), "MB")
+		.print();
+}
+
+bool Voxel::ChunkArenaBenchmark::run()
+{
+	auto allocatorResult = runAllocator();
+	printResult(allocatorResult);
+
+	printResult(runStaging(false));
+	printResult(runStaging(true));
+
+	return allocatorResult.error.empty();
+}
+
+int Voxel::ChunkArenaBenchmark::runFromCommandLine(const int argc, const char * argv[])
+{
+	// argv[0] is exe, argv[1] is --arena-bench
+	int operations = 1000000;
+	int stagedMeshes = 20000;
+	int threadCount = static_cast<int>(std::thread::hardware_concurrency());
+
+	if (!Benchmark::parseArguments(argc, argv, { { &operations, 1 }, { &stagedMeshes, 1 }, { &threadCount, 1 } }, "[operations] [staged meshes] [thread count]"))
+	{
+		return 1;
+	}
+
+	ChunkArenaBenchmark benchmark(static_cast<unsigned int>(operations), static_cast<unsigned int>(stagedMeshes), threadCount);
+	return benchmark.run() ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+#ifndef CHUNK_ARENA_BENCHMARK_H
+#define CHUNK_ARENA_BENCHMARK_H
+
+// cpp
+#include <string>
+#include <vector>
+
+namespace Voxel
+{
+	/**
+	*	@class ChunkArenaBenchmark
+	*	@brief Stress tests chunk geometry sub allocation and staging without window or OpenGL context.
+	*
+	*	Allocator run: allocates and releases chunk mesh sized blocks in random order like chunks loading and unloading
+	*	while player walks. Compacts or grows with same policy as ChunkGeometryArena and reports fragmentation.
+	*	Staging run: worker threads stage mesh sized blocks to StagingRing while main thread consumes them,
+	*	and reports throughput and how often ring was full. Runs twice. First loads only visible meshes, so meshes of
+	*	off screen chunks (1 in 8) stay staged and pin the ring. Second loads every mesh in staging order like ChunkMap does.
+	*
+	*	Allocator run stamps each allocation in buffer that stands for GPU buffer and copies moves of compact() like arena does.
+	*	After each compact and grow and at end, checks that live allocations don't overlap, keep their contents under same handle,
+	*	and that allocated and free space add up to capacity. Returns non zero exit code if any check fails.
+	*
+	*	Run with: VoxelEngine.exe --arena-bench [operations] [staged meshes] [thread count]
+	*/
+	class ChunkArenaBenchmark
+	{
+	public:
+		struct AllocatorResult
+		{
+			unsigned int operations;
+			unsigned int peakAllocations;
+			unsigned int growCount;
+			unsigned int compactCount;
+			// Units copied by compactions
+			unsigned long long movedSize;
+			float nanoSecondsPerOperation;
+			// Before and after final compaction
+			float fragmentationBefore;
+			float fragmentationAfter;
+			float compactMilliSeconds;
+			// requested / allocated. Lost to round up.
+			float utilization;
+			unsigned int capacity;
+			// Empty if all checks passed
+			std::string error;
+		};
+
+		struct StagingResult
+		{
+			bool loadAll;
+			int threadCount;
+			unsigned long long blockCount;
+			unsigned long long failedCount;
+			float megaBytesPerSecond;
+			unsigned int peakUsedSize;
+			unsigned int capacity;
+		};
+	private:
+		unsigned int operations;
+		unsigned int stagedMeshes;
+		int threadCount;
+
+		AllocatorResult runAllocator();
+		// Stage meshes. If loadAll is false, meshes of off screen chunks aren't loaded until end of run.
+		StagingResult runStaging(const bool loadAll);
+
+		void printResult(const AllocatorResult& result);
+		void printResult(const StagingResult& result);
+	public:
+		/**
+		*	Constructor
+		*	@param operations Number of allocations and releases in allocator run.
+		*	@param stagedMeshes Number of meshes staged in staging run.
+		*	@param threadCount Number of worker threads in staging run.
+		*/
+		ChunkArenaBenchmark(const unsigned int operations, const unsigned int stagedMeshes, const int threadCount);
+
+		// Destructor
+		~ChunkArenaBenchmark() = default;
+
+		/**
+		*	Run both.
+		*	@return true if all checks of allocator run passed.
+		*/
+		bool run();
+
+		/**
+		*	Parses arguments after --arena-bench and runs benchmark.
+		*	@return Exit code for process.
+		*/
+		static int runFromCommandLine(const int argc, const char* argv[]);
+	};
+}
+
+#endif
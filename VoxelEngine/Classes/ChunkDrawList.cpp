@@ -0,0 +1,291 @@
+// pch
+#include "PreCompiled.h"
+
+#include "ChunkDrawList.h"
+
+// voxel
+#include "Program.h"
+#include "Application.h"
+#include "Config.h"
+#include "ChunkUtil.h"
+
+using namespace Voxel;
+
+static_assert(sizeof(DrawElementsIndirectCommand) == 20, "DrawElementsIndirectCommand must match OpenGL layout");
+
+Voxel::ChunkDrawList::ChunkDrawList()
+	: totalIndices(0)
+{}
+
+void Voxel::ChunkDrawList::clear()
+{
+	entries.clear();
+	commands.clear();
+	draws.clear();
+
+	totalIndices = 0;
+}
+
+void Voxel::ChunkDrawList::reserve(const unsigned int size)
+{
+	entries.reserve(size);
+	commands.reserve(size);
+	draws.reserve(size);
+}
+
+void Voxel::ChunkDrawList::add(const GLuint vao, const GLuint indexCount, const GLuint firstIndex, const GLint baseVertex, const glm::vec3 & origin, const glm::vec3 & center)
+{
+	Entry entry;
+
+	entry.command.count = indexCount;
+	entry.command.instanceCount = 1;
+	entry.command.firstIndex = firstIndex;
+	entry.command.baseVertex = baseVertex;
+	entry.command.baseInstance = 0;
+
+	entry.draw.vao = vao;
+	entry.draw.origin = origin;
+	entry.draw.distance = glm::dot(center, center);
+
+	entries.push_back(entry);
+
+	totalIndices += indexCount;
+}
+
+void Voxel::ChunkDrawList::sort()
+{
+	// Front to back
+	std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.draw.distance < b.draw.distance; });
+
+	commands.resize(entries.size());
+	draws.resize(entries.size());
+
+	const unsigned int size = static_cast<unsigned int>(entries.size());
+
+	for (unsigned int i = 0; i < size; i++)
+	{
+		commands[i] = entries[i].command;
+		commands[i].baseInstance = i;
+
+		draws[i] = entries[i].draw;
+	}
+}
+
+const std::vector<DrawElementsIndirectCommand>& Voxel::ChunkDrawList::getCommands() const
+{
+	return commands;
+}
+
+const std::vector<ChunkDraw>& Voxel::ChunkDrawList::getDraws() const
+{
+	return draws;
+}
+
+unsigned int Voxel::ChunkDrawList::size() const
+{
+	return static_cast<unsigned int>(entries.size());
+}
+
+bool Voxel::ChunkDrawList::empty() const
+{
+	return entries.empty();
+}
+
+unsigned long long Voxel::ChunkDrawList::getTotalIndices() const
+{
+	return totalIndices;
+}
+
+
+
+
+void Voxel::ChunkDrawListBuilder::build(const std::vector<ChunkDrawRecord>& records, const glm::vec3 & center, ChunkDrawList & drawList)
+{
+	drawList.clear();
+	drawList.reserve(static_cast<unsigned int>(records.size()));
+
+	for (auto& record : records)
+	{
+		if (record.vao == 0 || record.indexCount == 0)
+		{
+			continue;
+		}
+
+		// Same as Chunk::getRelativeOrigin
+		const glm::vec3 origin(record.worldPosition.x - Constant::CHUNK_BORDER_SIZE_HALF - center.x, -center.y, record.worldPosition.z - Constant::CHUNK_BORDER_SIZE_HALF - center.z);
+		const glm::vec3 chunkCenter(record.worldPosition.x - center.x, 0.0f, record.worldPosition.z - center.z);
+
+		drawList.add(record.vao, record.indexCount, record.firstIndex, record.baseVertex, origin, chunkCenter);
+	}
+
+	drawList.sort();
+}
+
+
+
+
+Voxel::GLChunkRenderBackend::GLChunkRenderBackend(Program * program)
+	: program(program)
+	, modelMatLocation(program->findUniformLocation(SID("modelMat")))
+	, originLocation(program->getAttribLocation("chunkOrigin"))
+	, indirectBuffer(0)
+	, drawBuffer(0)
+	, capacity(0)
+{
+	glGenBuffers(1, &indirectBuffer);
+	glGenBuffers(1, &drawBuffer);
+}
+
+Voxel::GLChunkRenderBackend::~GLChunkRenderBackend()
+{
+	if (indirectBuffer)
+	{
+		glDeleteBuffers(1, &indirectBuffer);
+	}
+
+	if (drawBuffer)
+	{
+		glDeleteBuffers(1, &drawBuffer);
+	}
+}
+
+void Voxel::GLChunkRenderBackend::upload(const GLenum target, const GLuint buffer, const void * data, const unsigned int stride, const unsigned int size)
+{
+	glBindBuffer(target, buffer);
+
+	// Orphan. Previous frame's draws can still be reading old storage.
+	glBufferData(target, static_cast<GLsizeiptr>(capacity) * stride, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(target, 0, static_cast<GLsizeiptr>(size) * stride, data);
+}
+
+void Voxel::GLChunkRenderBackend::submit(const ChunkDrawList & drawList)
+{
+	auto& commands = drawList.getCommands();
+	auto& draws = drawList.getDraws();
+
+	const unsigned int size = static_cast<unsigned int>(commands.size());
+
+	if (size == 0)
+	{
+		return;
+	}
+
+	if (size > capacity)
+	{
+		capacity = std::max(size, capacity * 2);
+	}
+
+	upload(GL_DRAW_INDIRECT_BUFFER, indirectBuffer, commands.data(), sizeof(DrawElementsIndirectCommand), size);
+	upload(GL_ARRAY_BUFFER, drawBuffer, draws.data(), sizeof(ChunkDraw), size);
+
+	// Translation is per draw attribute
+	program->setUniformMat4(modelMatLocation, glm::mat4(1.0f));
+
+	unsigned int drawCallCount = 0;
+	unsigned int first = 0;
+
+	while (first < size)
+	{
+		const GLuint vao = draws[first].vao;
+
+		unsigned int last = first + 1;
+
+		while (last < size && draws[last].vao == vao)
+		{
+			last++;
+		}
+
+		glBindVertexArray(vao);
+
+		// Attribute pointer is vertex array state. Draw buffer is same object every frame, so this is cheap.
+		glBindBuffer(GL_ARRAY_BUFFER, drawBuffer);
+		glEnableVertexAttribArray(originLocation);
+		glVertexAttribPointer(originLocation, 3, GL_FLOAT, GL_FALSE, sizeof(ChunkDraw), reinterpret_cast<const void*>(offsetof(ChunkDraw, origin)));
+		glVertexAttribDivisor(originLocation, 1);
+
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, reinterpret_cast<const void*>(static_cast<uintptr_t>(first) * sizeof(DrawElementsIndirectCommand)), static_cast<GLsizei>(last - first), sizeof(DrawElementsIndirectCommand));
+
+		drawCallCount++;
+		first = last;
+	}
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+#if V_DEBUG
+	auto glView = Application::getInstance().getGLView();
+#if V_DEBUG_COUNT_DRAW_CALLS
+	if (glView->doesCountDrawCalls())
+	{
+		for (unsigned int i = 0; i < drawCallCount; i++)
+		{
+			glView->incrementDrawCall();
+		}
+	}
+#endif
+#if V_DEBUG_COUNT_VISIBLE_VERTICES
+	if (glView->doesCountVerticesSize())
+	{
+		glView->addVerticesSize(static_cast<int>(drawList.getTotalIndices()));
+	}
+#endif
+#endif
+}
+
+
+
+
+Voxel::NullChunkRenderBackend::NullChunkRenderBackend()
+	: submitCount(0)
+	, drawCount(0)
+	, indexCount(0)
+	, vaoChangeCount(0)
+{}
+
+void Voxel::NullChunkRenderBackend::submit(const ChunkDrawList & drawList)
+{
+	submitCount++;
+
+	GLuint boundVao = 0;
+
+	for (auto& draw : drawList.getDraws())
+	{
+		if (draw.vao != boundVao)
+		{
+			vaoChangeCount++;
+			boundVao = draw.vao;
+		}
+	}
+
+	drawCount += drawList.size();
+	indexCount += drawList.getTotalIndices();
+}
+
+void Voxel::NullChunkRenderBackend::reset()
+{
+	submitCount = 0;
+	drawCount = 0;
+	indexCount = 0;
+	vaoChangeCount = 0;
+}
+
+unsigned int Voxel::NullChunkRenderBackend::getSubmitCount() const
+{
+	return submitCount;
+}
+
+unsigned long long Voxel::NullChunkRenderBackend::getDrawCount() const
+{
+	return drawCount;
+}
+
+unsigned long long Voxel::NullChunkRenderBackend::getIndexCount() const
+{
+	return indexCount;
+}
+
+unsigned long long Voxel::NullChunkRenderBackend::getVaoChangeCount() const
+{
+	return vaoChangeCount;
+}
@@ -0,0 +1,256 @@
+#ifndef CHUNK_DRAW_LIST_H
+#define CHUNK_DRAW_LIST_H
+
+// cpp
+#include <vector>
+
+// gl
+#include <GL\glew.h>
+
+// glm
+#include <glm\glm.hpp>
+
+namespace Voxel
+{
+	// foward declaration
+	class Program;
+
+	/**
+	*	@struct DrawElementsIndirectCommand
+	*	@brief Same layout as OpenGL's indirect draw command. Array of this can be uploaded to GL_DRAW_INDIRECT_BUFFER as is.
+	*/
+	struct DrawElementsIndirectCommand
+	{
+	public:
+		GLuint count;
+		GLuint instanceCount;
+		GLuint firstIndex;
+		GLint baseVertex;
+		GLuint baseInstance;
+	};
+
+	/**
+	*	@struct ChunkDraw
+	*	@brief Per draw data that isn't in indirect command. Array of this is uploaded as is, and origin is read as instanced attribute.
+	*/
+	struct ChunkDraw
+	{
+	public:
+		// Vertex array of mesh
+		GLuint vao;
+		// Position of chunk's min corner relative to render center. Translation of model matrix.
+		glm::vec3 origin;
+		// Squared distance from render center to chunk's center. Sort key.
+		float distance;
+	};
+
+	/**
+	*	@struct ChunkDrawRecord
+	*	@brief Chunk's mesh ranges and position. Input of ChunkDrawListBuilder.
+	*/
+	struct ChunkDrawRecord
+	{
+	public:
+		// Vertex array of mesh
+		GLuint vao;
+		// Number of indices. Record with 0 is skipped.
+		GLuint indexCount;
+		// Offset in index buffer in number of indices
+		GLuint firstIndex;
+		// Offset in vertex buffer in number of vertices
+		GLint baseVertex;
+		// Chunk's center in world. y is ignored.
+		glm::vec3 worldPosition;
+	};
+
+	/**
+	*	@class ChunkDrawList
+	*	@brief Flat list of chunk draws for single frame. Built after culling and submitted to ChunkRenderBackend.
+	*
+	*	Draws are sorted front to back so near chunks fill depth buffer first.
+	*	After sort, commands and draws are parallel arrays. Command's baseInstance is index of draw,
+	*	so shader can find per draw data when commands are submitted with multi draw indirect.
+	*	Doesn't use OpenGL, so it can be built and benchmarked without context.
+	*/
+	class ChunkDrawList
+	{
+	private:
+		// Draws and commands before sort
+		struct Entry
+		{
+			DrawElementsIndirectCommand command;
+			ChunkDraw draw;
+		};
+
+		std::vector<Entry> entries;
+
+		// Sorted
+		std::vector<DrawElementsIndirectCommand> commands;
+		std::vector<ChunkDraw> draws;
+
+		// Sum of index count
+		unsigned long long totalIndices;
+	public:
+		// Constructor
+		ChunkDrawList();
+
+		// Destructor
+		~ChunkDrawList() = default;
+
+		// Clear list. Keeps capacity for next frame
+		void clear();
+
+		// Reserve space for number of draws
+		void reserve(const unsigned int size);
+
+		/**
+		*	Add draw
+		*	@param vao Vertex array of mesh.
+		*	@param indexCount Number of indices to draw.
+		*	@param firstIndex Offset in index buffer in number of indices.
+		*	@param baseVertex Offset in vertex buffer in number of vertices.
+		*	@param origin Position of chunk's min corner relative to render center.
+		*	@param center Position of chunk's center relative to render center. Used to sort.
+		*/
+		void add(const GLuint vao, const GLuint indexCount, const GLuint firstIndex, const GLint baseVertex, const glm::vec3& origin, const glm::vec3& center);
+
+		// Sort draws front to back and build commands. Call after adding all draws.
+		void sort();
+
+		// Get sorted commands. Valid after sort().
+		const std::vector<DrawElementsIndirectCommand>& getCommands() const;
+
+		// Get sorted draws. Parallel to commands. Valid after sort().
+		const std::vector<ChunkDraw>& getDraws() const;
+
+		// Get number of draws
+		unsigned int size() const;
+
+		// Check if list is empty
+		bool empty() const;
+
+		// Get sum of index count of all draws
+		unsigned long long getTotalIndices() const;
+	};
+
+	/**
+	*	@class ChunkDrawListBuilder
+	*	@brief Builds sorted draw list from chunk records. Doesn't use OpenGL.
+	*
+	*	ChunkMap collects records of visible chunks that have loaded mesh and builds draw list with this.
+	*	Benchmark builds same list from generated records.
+	*/
+	class ChunkDrawListBuilder
+	{
+	public:
+		/**
+		*	Clear draw list, add all records and sort.
+		*	@param records Chunk records. Records without vao or indices are skipped.
+		*	@param center Render center. Draws are relative to this.
+		*	@param drawList Draw list to build.
+		*/
+		static void build(const std::vector<ChunkDrawRecord>& records, const glm::vec3& center, ChunkDrawList& drawList);
+	};
+
+	/**
+	*	@class ChunkRenderBackend
+	*	@brief Submits chunk draw list. Lets ChunkMap render without knowing how draws are issued.
+	*/
+	class ChunkRenderBackend
+	{
+	public:
+		// Destructor
+		virtual ~ChunkRenderBackend() = default;
+
+		/**
+		*	Submit draws.
+		*	@param drawList Sorted draw list.
+		*/
+		virtual void submit(const ChunkDrawList& drawList) = 0;
+	};
+
+	/**
+	*	@class GLChunkRenderBackend
+	*	@brief Draws chunk draw list with block shader using multi draw indirect.
+	*
+	*	Commands are uploaded to indirect buffer and draws are uploaded to per draw buffer every frame.
+	*	Chunk origin is instanced vertex attribute (divisor 1) that reads from per draw buffer.
+	*	Command's baseInstance is index of draw, so each draw reads its own origin. This works with OpenGL 4.3,
+	*	which doesn't have gl_BaseInstance or gl_DrawID in shader.
+	*	Consecutive draws that share vertex array are issued with single glMultiDrawElementsIndirect.
+	*	Chunk meshes share vertex array of ChunkGeometryArena, so this is one draw call per frame.
+	*/
+	class GLChunkRenderBackend : public ChunkRenderBackend
+	{
+	private:
+		// Block shader
+		Program* program;
+
+		// Location of modelMat uniform
+		GLint modelMatLocation;
+
+		// Location of chunkOrigin attribute
+		GLint originLocation;
+
+		// Commands
+		GLuint indirectBuffer;
+
+		// Draws. Source of chunkOrigin attribute.
+		GLuint drawBuffer;
+
+		// Number of draws that buffers can hold
+		unsigned int capacity;
+
+		// Orphan buffer and upload data. Grows buffer if size is larger than capacity.
+		void upload(const GLenum target, const GLuint buffer, const void* data, const unsigned int stride, const unsigned int size);
+	public:
+		/**
+		*	Constructor. Creates buffers.
+		*	@param program Block shader program.
+		*/
+		GLChunkRenderBackend(Program* program);
+
+		// Destructor. Deletes buffers.
+		~GLChunkRenderBackend();
+
+		// Draw all commands
+		void submit(const ChunkDrawList& drawList) override;
+	};
+
+	/**
+	*	@class NullChunkRenderBackend
+	*	@brief Doesn't draw. Counts what would be drawn. For benchmark and running without OpenGL context.
+	*/
+	class NullChunkRenderBackend : public ChunkRenderBackend
+	{
+	private:
+		// Number of submits
+		unsigned int submitCount;
+
+		// Total number of draws and indices in all submits
+		unsigned long long drawCount;
+		unsigned long long indexCount;
+
+		// Number of times vertex array changes between draws. Same as number of multi draw calls GLChunkRenderBackend issues.
+		unsigned long long vaoChangeCount;
+	public:
+		// Constructor
+		NullChunkRenderBackend();
+
+		// Destructor
+		~NullChunkRenderBackend() = default;
+
+		// Count draws
+		void submit(const ChunkDrawList& drawList) override;
+
+		// Reset counters
+		void reset();
+
+		unsigned int getSubmitCount() const;
+		unsigned long long getDrawCount() const;
+		unsigned long long getIndexCount() const;
+		unsigned long long getVaoChangeCount() const;
+	};
+}
+
+#endif
@@ -0,0 +1,244 @@
+// pch
+#include "PreCompiled.h"
+
+#include "ChunkDrawListBenchmark.h"
+
+// voxel
+#include "ChunkUtil.h"
+#include "Benchmark.h"
+#include "Utility.h"
+
+using namespace Voxel;
+
+Voxel::ChunkDrawListBenchmark::ChunkDrawListBenchmark(const int frames)
+	: frames(frames)
+{}
+
+void Voxel::ChunkDrawListBenchmark::generateRecords(const int renderDistance, std::vector<ChunkDrawRecord>& records)
+{
+	records.clear();
+
+	GLuint firstIndex = 0;
+	GLint baseVertex = 0;
+
+	for (int x = -renderDistance; x <= renderDistance; x++)
+	{
+		for (int z = -renderDistance; z <= renderDistance; z++)
+		{
+			// Same as findVisibleChunk. Circular render distance
+			if ((x * x) + (z * z) > (renderDistance * renderDistance))
+			{
+				continue;
+			}
+
+			const unsigned int index = static_cast<unsigned int>(records.size());
+
+			ChunkDrawRecord record;
+
+			// All meshes share arena's vao.
+			record.vao = 1;
+
+			// Index count varies like real meshes. Some chunks are empty (all air).
+			record.indexCount = (index % 17 == 16) ? 0 : 6000 + ((index * 2654435761u) % 12000);
+			record.firstIndex = firstIndex;
+			record.baseVertex = baseVertex;
+			record.worldPosition = glm::vec3(static_cast<float>(x) * Constant::CHUNK_BORDER_SIZE, 0.0f, static_cast<float>(z) * Constant::CHUNK_BORDER_SIZE);
+
+			firstIndex += record.indexCount;
+			baseVertex += static_cast<GLint>(record.indexCount / 6) * 4;
+
+			records.push_back(record);
+		}
+	}
+}
+
+std::string Voxel::ChunkDrawListBenchmark::checkDrawList(const std::vector<ChunkDrawRecord>& records, const ChunkDrawList & drawList) const
+{
+	unsigned int expectedDraws = 0;
+	unsigned long long expectedIndices = 0;
+
+	for (auto& record : records)
+	{
+		if (record.vao != 0 && record.indexCount != 0)
+		{
+			expectedDraws++;
+			expectedIndices += record.indexCount;
+		}
+	}
+
+	if (drawList.size() != expectedDraws)
+	{
+		return "draw count " + std::to_string(drawList.size()) + " != " + std::to_string(expectedDraws);
+	}
+
+	if (drawList.getTotalIndices() != expectedIndices)
+	{
+		return "index count " + std::to_string(drawList.getTotalIndices()) + " != " + std::to_string(expectedIndices);
+	}
+
+	auto& commands = drawList.getCommands();
+	auto& draws = drawList.getDraws();
+
+	if (commands.size() != expectedDraws || draws.size() != expectedDraws)
+	{
+		return "commands and draws aren't parallel";
+	}
+
+	for (unsigned int i = 0; i < expectedDraws; i++)
+	{
+		if (commands[i].baseInstance != i)
+		{
+			return "baseInstance of command #" + std::to_string(i) + " is " + std::to_string(commands[i].baseInstance);
+		}
+
+		if (commands[i].instanceCount != 1 || commands[i].count == 0)
+		{
+			return "invalid command #" + std::to_string(i);
+		}
+
+		if (i > 0 && draws[i - 1].distance > draws[i].distance)
+		{
+			return "draw #" + std::to_string(i) + " is nearer than previous draw";
+		}
+	}
+
+	return "";
+}
+
+std::string Voxel::ChunkDrawListBenchmark::checkBackend(const std::vector<ChunkDrawRecord>& records, const NullChunkRenderBackend & backend) const
+{
+	unsigned long long expectedDraws = 0;
+	unsigned long long expectedIndices = 0;
+
+	for (auto& record : records)
+	{
+		if (record.vao != 0 && record.indexCount != 0)
+		{
+			expectedDraws++;
+			expectedIndices += record.indexCount;
+		}
+	}
+
+	const unsigned long long frameCount = static_cast<unsigned long long>(frames);
+
+	if (backend.getSubmitCount() != static_cast<unsigned int>(frames))
+	{
+		return "backend submit count " + std::to_string(backend.getSubmitCount()) + " != " + std::to_string(frames);
+	}
+
+	if (backend.getDrawCount() != expectedDraws * frameCount)
+	{
+		return "backend draw count " + std::to_string(backend.getDrawCount()) + " != " + std::to_string(expectedDraws * frameCount);
+	}
+
+	if (backend.getIndexCount() != expectedIndices * frameCount)
+	{
+		return "backend index count " + std::to_string(backend.getIndexCount()) + " != " + std::to_string(expectedIndices * frameCount);
+	}
+
+	// Single shared vao. Bound once per frame.
+	if (backend.getVaoChangeCount() != frameCount)
+	{
+		return "backend vao change count " + std::to_string(backend.getVaoChangeCount()) + " != " + std::to_string(frameCount);
+	}
+
+	return "";
+}
+
+ChunkDrawListBenchmark::Result Voxel::ChunkDrawListBenchmark::runOnce(const int renderDistance)
+{
+	std::vector<ChunkDrawRecord> records;
+	generateRecords(renderDistance, records);
+
+	ChunkDrawList drawList;
+	NullChunkRenderBackend backend;
+
+	float buildTime = 0;
+	float submitTime = 0;
+
+	Result result;
+	result.renderDistance = renderDistance;
+
+	for (int frame = 0; frame < frames; frame++)
+	{
+		// Player walks along x axis
+		const glm::vec3 center(static_cast<float>(frame) * 0.37f, 0.0f, static_cast<float>(frame) * 0.11f);
+
+		auto start = Utility::Time::now();
+
+		ChunkDrawListBuilder::build(records, center, drawList);
+
+		auto built = Utility::Time::now();
+
+		backend.submit(drawList);
+
+		auto end = Utility::Time::now();
+
+		buildTime += Benchmark::toMicroSeconds(start, built);
+		submitTime += Benchmark::toMicroSeconds(built, end);
+
+		if (result.error.empty())
+		{
+			result.error = checkDrawList(records, drawList);
+		}
+	}
+
+	if (result.error.empty())
+	{
+		result.error = checkBackend(records, backend);
+	}
+
+	result.drawCount = drawList.size();
+	result.vaoChangeCount = backend.getVaoChangeCount() / static_cast<unsigned long long>(frames);
+	result.buildMicroSeconds = buildTime / static_cast<float>(frames);
+	result.submitMicroSeconds = submitTime / static_cast<float>(frames);
+
+	return result;
+}
+
+void Voxel::ChunkDrawListBenchmark::printResult(const Result & result)
+{
+	Benchmark::ResultLine("ChunkDrawListBenchmark")
+		.add("render distance", result.renderDistance)
+		.add("draws", result.drawCount)
+		.add("vao changes", result.vaoChangeCount)
+		.add("build", result.buildMicroSeconds, "us")
+		.add("submit", result.submitMicroSeconds, "us")
+		.add("total", result.buildMicroSeconds + result.submitMicroSeconds, "us per frame")
+		.addChecks(result.error)
+		.print();
+}
+
+bool Voxel::ChunkDrawListBenchmark::run(const std::vector<int>& renderDistances)
+{
+	std::cout << "[ChunkDrawListBenchmark] Frames: " << frames << "\n";
+
+	bool passed = true;
+
+	for (auto renderDistance : renderDistances)
+	{
+		auto result = runOnce(renderDistance);
+
+		printResult(result);
+
+		passed = passed && result.error.empty();
+	}
+
+	return passed;
+}
+
+int Voxel::ChunkDrawListBenchmark::runFromCommandLine(const int argc, const char * argv[])
+{
+	// argv[0] is exe, argv[1] is --drawlist-bench
+	int maxRenderDistance = 32;
+	int frames = 1000;
+
+	if (!Benchmark::parseArguments(argc, argv, { { &maxRenderDistance, 1 }, { &frames, 1 } }, "[max render distance] [frames]"))
+	{
+		return 1;
+	}
+
+	ChunkDrawListBenchmark benchmark(frames);
+
+	return benchmark.run(Benchmark::doublingSteps(4, maxRenderDistance)) ? 0 : 1;
+}
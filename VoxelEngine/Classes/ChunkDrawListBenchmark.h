@@ -0,0 +1,83 @@
+#ifndef CHUNK_DRAW_LIST_BENCHMARK_H
+#define CHUNK_DRAW_LIST_BENCHMARK_H
+
+// cpp
+#include <vector>
+#include <string>
+
+// voxel
+#include "ChunkDrawList.h"
+
+namespace Voxel
+{
+	/**
+	*	@class ChunkDrawListBenchmark
+	*	@brief Measures building, sorting and submitting chunk draw list without window or OpenGL context.
+	*
+	*	Generates records for every chunk in render distance, builds draw list with ChunkDrawListBuilder like ChunkMap does
+	*	and submits it to NullChunkRenderBackend. Render center moves each frame so order changes like when player walks.
+	*	Records share single vertex array like meshes in ChunkGeometryArena, and some have empty mesh.
+	*
+	*	After each run, checks that draws are sorted front to back, command's baseInstance is index of draw,
+	*	empty meshes are skipped and backend counted every draw. Returns non zero exit code if any check fails.
+	*
+	*	Run with: VoxelEngine.exe --drawlist-bench [max render distance] [frames]
+	*/
+	class ChunkDrawListBenchmark
+	{
+	public:
+		// Result of single run. Times are in microseconds per frame.
+		struct Result
+		{
+			int renderDistance;
+			unsigned int drawCount;
+			unsigned long long vaoChangeCount;
+			float buildMicroSeconds;
+			float submitMicroSeconds;
+			// Empty if all checks passed
+			std::string error;
+		};
+	private:
+		// Number of frames per run
+		int frames;
+
+		// Generate record for every chunk in render distance
+		void generateRecords(const int renderDistance, std::vector<ChunkDrawRecord>& records);
+
+		// Check draw list built from records. Returns error message or empty string.
+		std::string checkDrawList(const std::vector<ChunkDrawRecord>& records, const ChunkDrawList& drawList) const;
+
+		// Check backend counters after all frames. Returns error message or empty string.
+		std::string checkBackend(const std::vector<ChunkDrawRecord>& records, const NullChunkRenderBackend& backend) const;
+
+		// Runs frames with given render distance
+		Result runOnce(const int renderDistance);
+
+		// Print result of single run
+		void printResult(const Result& result);
+	public:
+		/**
+		*	Constructor
+		*	@param frames Number of frames per run.
+		*/
+		ChunkDrawListBenchmark(const int frames);
+
+		// Destructor
+		~ChunkDrawListBenchmark() = default;
+
+		/**
+		*	Runs benchmark for each render distance.
+		*	@param renderDistances Render distance for each run.
+		*	@return true if all checks passed.
+		*/
+		bool run(const std::vector<int>& renderDistances);
+
+		/**
+		*	Parses arguments after --drawlist-bench and runs benchmark with render distance 4, 8, 16, ... up to max.
+		*	@return Exit code for process.
+		*/
+		static int runFromCommandLine(const int argc, const char* argv[]);
+	};
+}
+
+#endif
@@ -0,0 +1,325 @@
+// pch
+#include "PreCompiled.h"
+
+#include "ChunkGeometryArena.h"
+
+// voxel
+#include "Program.h"
+
+using namespace Voxel;
+
+// 512K vertices (20 MB) and 1M indices (4 MB). Doubles when full.
+const unsigned int Voxel::ChunkGeometryArena::DEFAULT_VERTEX_CAPACITY = 1 << 19;
+const unsigned int Voxel::ChunkGeometryArena::DEFAULT_INDEX_CAPACITY = 1 << 20;
+
+// Near empty chunk has few hundred vertices
+const unsigned int Voxel::ChunkGeometryArena::MIN_VERTEX_BLOCK = 256;
+const unsigned int Voxel::ChunkGeometryArena::MIN_INDEX_BLOCK = 512;
+
+static_assert(sizeof(ChunkVertex) == sizeof(float) * 10, "ChunkVertex must be tightly packed");
+
+Voxel::ChunkGeometryArena::ChunkGeometryArena()
+	: vertexAllocator(DEFAULT_VERTEX_CAPACITY, MIN_VERTEX_BLOCK)
+	, indexAllocator(DEFAULT_INDEX_CAPACITY, MIN_INDEX_BLOCK)
+	, vao(0)
+	, vbo(0)
+	, ibo(0)
+	, vertLoc(-1)
+	, colorLoc(-1)
+	, normalLoc(-1)
+	, compactCount(0)
+	, growCount(0)
+{}
+
+Voxel::ChunkGeometryArena::~ChunkGeometryArena()
+{
+	if (vao)
+	{
+		glDeleteVertexArrays(1, &vao);
+	}
+
+	if (vbo)
+	{
+		glDeleteBuffers(1, &vbo);
+	}
+
+	if (ibo)
+	{
+		glDeleteBuffers(1, &ibo);
+	}
+}
+
+void Voxel::ChunkGeometryArena::init(Program * program)
+{
+	vertLoc = program->getAttribLocation("vert");
+	colorLoc = program->getAttribLocation("color");
+	normalLoc = program->getAttribLocation("normal");
+
+	glGenBuffers(1, &vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertexAllocator.getCapacity()) * sizeof(ChunkVertex), nullptr, GL_DYNAMIC_DRAW);
+
+	glGenBuffers(1, &ibo);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indexAllocator.getCapacity()) * sizeof(GLuint), nullptr, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+	glGenVertexArrays(1, &vao);
+
+	bindAttributes();
+}
+
+bool Voxel::ChunkGeometryArena::isInitialized() const
+{
+	return vao != 0;
+}
+
+void Voxel::ChunkGeometryArena::bindAttributes()
+{
+	glBindVertexArray(vao);
+
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+	// vert
+	glEnableVertexAttribArray(vertLoc);
+	glVertexAttribPointer(vertLoc, 3, GL_FLOAT, GL_FALSE, sizeof(ChunkVertex), reinterpret_cast<const void*>(offsetof(ChunkVertex, position)));
+
+	// color
+	glEnableVertexAttribArray(colorLoc);
+	glVertexAttribPointer(colorLoc, 4, GL_FLOAT, GL_FALSE, sizeof(ChunkVertex), reinterpret_cast<const void*>(offsetof(ChunkVertex, color)));
+
+	// normal
+	glEnableVertexAttribArray(normalLoc);
+	glVertexAttribPointer(normalLoc, 3, GL_FLOAT, GL_FALSE, sizeof(ChunkVertex), reinterpret_cast<const void*>(offsetof(ChunkVertex, normal)));
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+
+	glBindVertexArray(0);
+}
+
+BuddyAllocator::Handle Voxel::ChunkGeometryArena::allocateFrom(BuddyAllocator & allocator, GLuint & buffer, const unsigned int stride, const unsigned int size)
+{
+	auto handle = allocator.allocate(size);
+
+	if (handle != BuddyAllocator::INVALID_HANDLE)
+	{
+		return handle;
+	}
+
+	// Enough free space, but scattered. Pack and retry.
+	if (allocator.getStats().freeSize >= allocator.getAllocatedSize(size))
+	{
+		compactBuffer(allocator, buffer, stride);
+
+		handle = allocator.allocate(size);
+	}
+
+	while (handle == BuddyAllocator::INVALID_HANDLE)
+	{
+		if (!allocator.grow())
+		{
+			return BuddyAllocator::INVALID_HANDLE;
+		}
+
+		growBuffer(allocator, buffer, stride);
+
+		handle = allocator.allocate(size);
+	}
+
+	return handle;
+}
+
+void Voxel::ChunkGeometryArena::compactBuffer(BuddyAllocator & allocator, GLuint buffer, const unsigned int stride)
+{
+	auto moves = allocator.compact();
+
+	compactCount++;
+
+	if (moves.empty())
+	{
+		return;
+	}
+
+	// Source and destination of moves can overlap. Copy moved ranges to temporary buffer first.
+	GLsizeiptr tempSize = 0;
+
+	for (auto& move : moves)
+	{
+		tempSize += static_cast<GLsizeiptr>(move.size) * stride;
+	}
+
+	GLuint temp = 0;
+	glGenBuffers(1, &temp);
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, temp);
+	glBufferData(GL_COPY_WRITE_BUFFER, tempSize, nullptr, GL_STREAM_COPY);
+
+	glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+
+	GLintptr tempOffset = 0;
+
+	for (auto& move : moves)
+	{
+		const GLsizeiptr size = static_cast<GLsizeiptr>(move.size) * stride;
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(move.from) * stride, tempOffset, size);
+		tempOffset += size;
+	}
+
+	glBindBuffer(GL_COPY_READ_BUFFER, temp);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+
+	tempOffset = 0;
+
+	for (auto& move : moves)
+	{
+		const GLsizeiptr size = static_cast<GLsizeiptr>(move.size) * stride;
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, tempOffset, static_cast<GLintptr>(move.to) * stride, size);
+		tempOffset += size;
+	}
+
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	glDeleteBuffers(1, &temp);
+}
+
+void Voxel::ChunkGeometryArena::growBuffer(BuddyAllocator & allocator, GLuint & buffer, const unsigned int stride)
+{
+	// Allocator already grew. Old buffer is lower half.
+	const GLsizeiptr newSize = static_cast<GLsizeiptr>(allocator.getCapacity()) * stride;
+	const GLsizeiptr oldSize = newSize / 2;
+
+	GLuint newBuffer = 0;
+	glGenBuffers(1, &newBuffer);
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+	glBufferData(GL_COPY_WRITE_BUFFER, newSize, nullptr, GL_DYNAMIC_DRAW);
+
+	glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+	glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, oldSize);
+
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	glDeleteBuffers(1, &buffer);
+	buffer = newBuffer;
+
+	growCount++;
+
+	// Vertex array still points old buffer
+	bindAttributes();
+}
+
+bool Voxel::ChunkGeometryArena::allocate(const unsigned int vertexCount, const unsigned int indexCount, Allocation & allocation)
+{
+	allocation.vertexHandle = allocateFrom(vertexAllocator, vbo, sizeof(ChunkVertex), vertexCount);
+
+	if (allocation.vertexHandle == BuddyAllocator::INVALID_HANDLE)
+	{
+		return false;
+	}
+
+	allocation.indexHandle = allocateFrom(indexAllocator, ibo, sizeof(GLuint), indexCount);
+
+	if (allocation.indexHandle == BuddyAllocator::INVALID_HANDLE)
+	{
+		vertexAllocator.release(allocation.vertexHandle);
+		allocation.vertexHandle = BuddyAllocator::INVALID_HANDLE;
+		return false;
+	}
+
+	return true;
+}
+
+void Voxel::ChunkGeometryArena::upload(const Allocation & allocation, const ChunkVertex * vertices, const unsigned int vertexCount, const unsigned int * indices, const unsigned int indexCount)
+{
+	assert(vertexAllocator.getSize(allocation.vertexHandle) == vertexCount);
+	assert(indexAllocator.getSize(allocation.indexHandle) == indexCount);
+
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(vertexAllocator.getOffset(allocation.vertexHandle)) * sizeof(ChunkVertex), static_cast<GLsizeiptr>(vertexCount) * sizeof(ChunkVertex), vertices);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// Don't change element buffer of bound vertex array
+	glBindVertexArray(0);
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLintptr>(indexAllocator.getOffset(allocation.indexHandle)) * sizeof(GLuint), static_cast<GLsizeiptr>(indexCount) * sizeof(GLuint), indices);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void Voxel::ChunkGeometryArena::release(Allocation & allocation)
+{
+	if (allocation.vertexHandle != BuddyAllocator::INVALID_HANDLE)
+	{
+		vertexAllocator.release(allocation.vertexHandle);
+	}
+
+	if (allocation.indexHandle != BuddyAllocator::INVALID_HANDLE)
+	{
+		indexAllocator.release(allocation.indexHandle);
+	}
+
+	allocation = Allocation();
+}
+
+void Voxel::ChunkGeometryArena::deferRelease(Allocation & allocation)
+{
+	if (allocation.vertexHandle != BuddyAllocator::INVALID_HANDLE || allocation.indexHandle != BuddyAllocator::INVALID_HANDLE)
+	{
+		std::unique_lock<std::mutex> lock(deferredReleaseMutex);
+		deferredReleases.push_back(allocation);
+	}
+
+	allocation = Allocation();
+}
+
+void Voxel::ChunkGeometryArena::releaseDeferred()
+{
+	std::vector<Allocation> releases;
+
+	{
+		std::unique_lock<std::mutex> lock(deferredReleaseMutex);
+		releases.swap(deferredReleases);
+	}
+
+	for (auto& allocation : releases)
+	{
+		release(allocation);
+	}
+}
+
+GLuint Voxel::ChunkGeometryArena::getVAO() const
+{
+	return vao;
+}
+
+GLuint Voxel::ChunkGeometryArena::getFirstIndex(const Allocation & allocation) const
+{
+	return static_cast<GLuint>(indexAllocator.getOffset(allocation.indexHandle));
+}
+
+GLint Voxel::ChunkGeometryArena::getBaseVertex(const Allocation & allocation) const
+{
+	return static_cast<GLint>(vertexAllocator.getOffset(allocation.vertexHandle));
+}
+
+BuddyAllocator::Stats Voxel::ChunkGeometryArena::getVertexStats() const
+{
+	return vertexAllocator.getStats();
+}
+
+BuddyAllocator::Stats Voxel::ChunkGeometryArena::getIndexStats() const
+{
+	return indexAllocator.getStats();
+}
+
+unsigned int Voxel::ChunkGeometryArena::getCompactCount() const
+{
+	return compactCount;
+}
+
+unsigned int Voxel::ChunkGeometryArena::getGrowCount() const
+{
+	return growCount;
+}
@@ -0,0 +1,162 @@
+#ifndef CHUNK_GEOMETRY_ARENA_H
+#define CHUNK_GEOMETRY_ARENA_H
+
+// cpp
+#include <vector>
+#include <mutex>
+
+// gl
+#include <GL\glew.h>
+
+// glm
+#include <glm\glm.hpp>
+
+// voxel
+#include "BuddyAllocator.h"
+
+namespace Voxel
+{
+	// foward declaration
+	class Program;
+
+	/**
+	*	@struct ChunkVertex
+	*	@brief Interleaved vertex of chunk mesh. Layout in arena's vertex buffer.
+	*/
+	struct ChunkVertex
+	{
+	public:
+		glm::vec3 position;
+		glm::vec4 color;
+		glm::vec3 normal;
+	};
+
+	/**
+	*	@class ChunkGeometryArena
+	*	@brief Single vertex buffer and index buffer that all chunk meshes are sub allocated from.
+	*
+	*	Chunk mesh holds allocation (handles) instead of owning vertex array and buffers.
+	*	Uploading mesh is glBufferSubData to its range, and all meshes share one vertex array,
+	*	so draws only differ by first index and base vertex.
+	*
+	*	Ranges are managed by BuddyAllocator in units of vertices and indices.
+	*	When allocation fails, arena compacts if there is enough free space, otherwise doubles buffer.
+	*	Both copy on GPU with glCopyBufferSubData. Offsets can change, so query them every frame.
+	*
+	*	Main thread only, except deferRelease. Chunk (and its mesh) can be destroyed on worker thread that held
+	*	last reference, so mesh defers release and main thread frees it on releaseDeferred.
+	*/
+	class ChunkGeometryArena
+	{
+	public:
+		// Initial capacity
+		static const unsigned int DEFAULT_VERTEX_CAPACITY;
+		static const unsigned int DEFAULT_INDEX_CAPACITY;
+
+		// Smallest block
+		static const unsigned int MIN_VERTEX_BLOCK;
+		static const unsigned int MIN_INDEX_BLOCK;
+
+		struct Allocation
+		{
+			BuddyAllocator::Handle vertexHandle;
+			BuddyAllocator::Handle indexHandle;
+
+			Allocation() : vertexHandle(BuddyAllocator::INVALID_HANDLE), indexHandle(BuddyAllocator::INVALID_HANDLE) {}
+
+			bool isValid() const { return vertexHandle != BuddyAllocator::INVALID_HANDLE && indexHandle != BuddyAllocator::INVALID_HANDLE; }
+		};
+	private:
+		BuddyAllocator vertexAllocator;
+		BuddyAllocator indexAllocator;
+
+		// OpenGL objects
+		GLuint vao;
+		GLuint vbo;
+		GLuint ibo;
+
+		// Attribute locations of block shader
+		GLint vertLoc;
+		GLint colorLoc;
+		GLint normalLoc;
+
+		unsigned int compactCount;
+		unsigned int growCount;
+
+		// Allocations released from any thread. Freed on main thread by releaseDeferred.
+		std::vector<Allocation> deferredReleases;
+		std::mutex deferredReleaseMutex;
+
+		// Set attribute pointers and index buffer to vao. Call after buffer changes.
+		void bindAttributes();
+
+		/**
+		*	Allocate from allocator. Compacts or grows buffer if needed.
+		*	@param allocator Allocator of buffer. Vertex or index allocator.
+		*	@param buffer Vertex or index buffer. Replaced with new buffer if it grows.
+		*	@param stride Size of single element in bytes.
+		*	@param size Number of elements to allocate.
+		*	@return INVALID_HANDLE if buffer can't grow.
+		*/
+		BuddyAllocator::Handle allocateFrom(BuddyAllocator& allocator, GLuint& buffer, const unsigned int stride, const unsigned int size);
+
+		// Apply moves from allocator's compact to buffer
+		void compactBuffer(BuddyAllocator& allocator, GLuint buffer, const unsigned int stride);
+
+		// Copy buffer to new buffer with allocator's new capacity
+		void growBuffer(BuddyAllocator& allocator, GLuint& buffer, const unsigned int stride);
+	public:
+		// Constructor
+		ChunkGeometryArena();
+
+		// Destructor. Deletes buffers.
+		~ChunkGeometryArena();
+
+		/**
+		*	Create buffers and vertex array.
+		*	@param program Block shader.
+		*/
+		void init(Program* program);
+
+		// Check if init is called
+		bool isInitialized() const;
+
+		/**
+		*	Allocate space for mesh.
+		*	@param vertexCount Number of vertices.
+		*	@param indexCount Number of indices.
+		*	@param allocation Allocated ranges.
+		*	@return false if arena can't fit mesh.
+		*/
+		bool allocate(const unsigned int vertexCount, const unsigned int indexCount, Allocation& allocation);
+
+		// Upload mesh to allocated ranges. Sizes must be same as allocate.
+		void upload(const Allocation& allocation, const ChunkVertex* vertices, const unsigned int vertexCount, const unsigned int* indices, const unsigned int indexCount);
+
+		// Release ranges. Allocation becomes invalid.
+		void release(Allocation& allocation);
+
+		// Queue ranges to release on releaseDeferred. Can be called from any thread. Allocation becomes invalid.
+		void deferRelease(Allocation& allocation);
+
+		// Release queued ranges. Call on main thread before allocating.
+		void releaseDeferred();
+
+		// Get vertex array that all meshes share
+		GLuint getVAO() const;
+
+		// Get offset of allocation in index buffer in number of indices
+		GLuint getFirstIndex(const Allocation& allocation) const;
+
+		// Get offset of allocation in vertex buffer in number of vertices
+		GLint getBaseVertex(const Allocation& allocation) const;
+
+		// Get stats
+		BuddyAllocator::Stats getVertexStats() const;
+		BuddyAllocator::Stats getIndexStats() const;
+		unsigned int getCompactCount() const;
+		unsigned int getGrowCount() const;
+	};
+}
+
+#endif
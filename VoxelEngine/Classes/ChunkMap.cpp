@@ -19,17 +19,27 @@
 #include "ChunkMesh.h"
 #include "Application.h"
 #include "Ray.h"
+#include "ThreadPool.h"
+#include "AsyncLogger.h"
+#include "FrameProfiler.h"
 
 using namespace Voxel;
 
+// 64 MB
+const unsigned int Voxel::ChunkMap::STAGING_RING_SIZE = 64 * 1024 * 1024;
+const float Voxel::ChunkMap::MESH_UPLOAD_BUDGET = 2.0f;
+
 Voxel::ChunkMap::ChunkMap()
 	: currentChunkPos(0)
-	, blockOutlineVao(0)
-	, renderChunksMode(true)
-	, renderBlockOutlineMode(true)
-	, updateChunksMode(true)
 	, minXZ(0)
 	, maxXZ(0)
+	, renderChunksMode(true)
+	, updateChunksMode(true)
+	, blockOutlineVao(0)
+	, renderBlockOutlineMode(true)
+	, stagingRing(STAGING_RING_SIZE)
+	, renderBackend(nullptr)
+	, renderCenter(0.0f)
 #if V_DEBUG
 #if V_DEBUG_CHUNK_BORDER_LINE
 	, chunkBorderVao(0)
@@ -55,11 +65,16 @@ Voxel::ChunkMap::~ChunkMap()
 	{
 		glDeleteVertexArrays(1, &blockOutlineVao);
 	}
+
+	if (renderBackend)
+	{
+		delete renderBackend;
+	}
 }
 
 std::vector<glm::vec2> Voxel::ChunkMap::initChunkNearPlayer(const glm::vec3 & playerPosition, const int renderDistance)
 {
-	std::cout << "[ChunkMap] Player is at (" << playerPosition.x << ", " << playerPosition.y << ", " << playerPosition.z << ")\n";
+	V_LOG_INFO("[ChunkMap] Player is at {}", playerPosition);
 
 	// Only need player x and z to find which chunk that player is in. This is world position
 	int chunkX = static_cast<int>(playerPosition.x) / Constant::CHUNK_SECTION_WIDTH;
@@ -68,7 +83,7 @@ std::vector<glm::vec2> Voxel::ChunkMap::initChunkNearPlayer(const glm::vec3 & pl
 	if (playerPosition.x < 0) chunkX -= 1;
 	if (playerPosition.z < 0) chunkZ -= 1;
 
-	std::cout << "[ChunkMap] Player is in chunk (" << chunkX << ", " << chunkZ << ")\n";
+	V_LOG_INFO("[ChunkMap] Player is in chunk ({}, {})", chunkX, chunkZ);
 
 	currentChunkPos.x = chunkX;
 	currentChunkPos.y = chunkZ;
@@ -134,7 +149,7 @@ std::vector<glm::vec2> Voxel::ChunkMap::initChunkNearPlayer(const glm::vec3 & pl
 		}
 	}
 
-	std::cout << "Chunk map size = " << map.size() << std::endl;
+	V_LOG_DEBUG("[ChunkMap] Chunk map size = {}", map.size());
 
 	// Returns chunks coordinates that need to be processed (gen, build mesh, etc). Actually all chunks that is generated here.
 	return chunkCoordinates;
@@ -175,7 +190,7 @@ void Voxel::ChunkMap::initActiveChunks()
 		}
 	}
 
-	std::cout << "Active chunk size = " << activeChunks.size() * activeChunks.front().size() << std::endl;
+	V_LOG_DEBUG("[ChunkMap] Active chunk size = {}", activeChunks.size() * activeChunks.front().size());
 }
 
 void Voxel::ChunkMap::initBlockOutline(Program* program)
@@ -266,11 +281,19 @@ void Voxel::ChunkMap::initBlockOutline(Program* program)
 
 void ChunkMap::clear()
 {
+	visibleChunks.clear();
+	drawRecords.clear();
+
+	{
+		std::unique_lock<std::mutex> lock(stagedMeshMutex);
+		stagedMeshQueue.clear();
+	}
+	drawList.clear();
+
 	map.clear();
 	chunkLUT.clear();
 	currentChunkPos = glm::ivec2(0);
 	activeChunks.clear();
-	regionTerrainsMap.clear();
 
 	minXZ = glm::ivec2(0);
 	maxXZ = glm::ivec2(0);
@@ -613,7 +636,7 @@ ChunkMap::BQR Voxel::ChunkMap::isBlockAtWorldXYZOpaque(const int x, const int y,
 	// Retruns 3 if chunk doesn't exsits.
 	// Returns 4 if chunk is inactive
 
-	//auto start = Utility::Time::now();
+	// No zone here. This runs many times per frame, so it's measured as part of caller's zone (Player collision, raycast).
 
 	glm::ivec3 blockLocalPos;
 	glm::ivec3 chunkSectionPos;
@@ -669,8 +692,6 @@ ChunkMap::BQR Voxel::ChunkMap::isBlockAtWorldXYZOpaque(const int x, const int y,
 		result = BQR::NO_CHUNK;
 	}
 
-	//auto end = Utility::Time::now();
-	//std::cout << "block query t: " << Utility::Time::toMicroSecondString(start, end) << std::endl;
 	// block quert takes 0 micro seconds usually, but sometime spikes to 15 ish.
 
 	return result;
@@ -757,7 +778,7 @@ void Voxel::ChunkMap::placeBlockAt(const glm::ivec3 & blockWorldCoordinate, cons
 	else
 	{
 		// Player is impossible to place block where chunk doesn't exists.
-		std::cout << "[ChunkMap] Error. Tried to place block where chunk doesn't exists.\n";
+		V_LOG_ERROR("[ChunkMap] Error. Tried to place block where chunk doesn't exists.");
 		return;
 	}
 }
@@ -805,7 +826,7 @@ void Voxel::ChunkMap::placeBlockAt(const glm::ivec3 & blockWorldCoordinate, cons
 	else
 	{
 		// Player is impossible to place block where chunk doesn't exists.
-		std::cout << "[ChunkMap] Error. Tried to place block where chunk doesn't exists\n";
+		V_LOG_ERROR("[ChunkMap] Error. Tried to place block where chunk doesn't exists");
 		return;
 	}
 }
@@ -854,7 +875,7 @@ void Voxel::ChunkMap::placeBlockAt(const glm::ivec3 & blockWorldCoordinate, cons
 	else
 	{
 		// Player is impossible to place block where chunk doesn't exists.
-		std::cout << "[ChunkMap] Error. Tried to place block where chunk doesn't exists. at(" << chunkSectionPos.x << ", " << chunkSectionPos.z << "), bp(" << blockWorldCoordinate.x << ", " << blockWorldCoordinate.y << ", " << blockWorldCoordinate.z << "), bID(" << (int)blockID << ")\n";
+		V_LOG_ERROR("[ChunkMap] Error. Tried to place block where chunk doesn't exists. at({}, {}), bp({}, {}, {}), bID({})", chunkSectionPos.x, chunkSectionPos.z, blockWorldCoordinate.x, blockWorldCoordinate.y, blockWorldCoordinate.z, static_cast<int>(blockID));
 		return;
 	}
 }
@@ -894,7 +915,7 @@ void Voxel::ChunkMap::removeBlockAt(const glm::ivec3 & blockWorldCoordinate, Chu
 				}
 				else
 				{
-					std::cout << "[ChunkMap] Error. Tried to break block where chunk section doesn't exists\n";
+					V_LOG_ERROR("[ChunkMap] Error. Tried to break block where chunk section doesn't exists");
 					return;
 				}
 			}
@@ -904,7 +925,7 @@ void Voxel::ChunkMap::removeBlockAt(const glm::ivec3 & blockWorldCoordinate, Chu
 	else
 	{
 		// Player is impossible to place block where chunk doesn't exists.
-		std::cout << "[ChunkMap] Error. Tried to break block where chunk doesn't exists\n";
+		V_LOG_ERROR("[ChunkMap] Error. Tried to break block where chunk doesn't exists");
 		return;
 	}
 }
@@ -1046,6 +1067,165 @@ float Voxel::ChunkMap::raycastCamera(const glm::vec3& rayStart, const glm::vec3&
 	return maxCameraRange;
 }
 
+void Voxel::ChunkMap::raycastBlocks(const std::vector<RayQuery>& queries, std::vector<RayQueryResult>& results, ThreadPool * threadPool)
+{
+	const unsigned int size = static_cast<unsigned int>(queries.size());
+
+	results.resize(size);
+
+	if (size == 0)
+	{
+		return;
+	}
+
+	auto castRange = [this, &queries, &results](const unsigned int begin, const unsigned int end)
+	{
+		for (unsigned int i = begin; i < end; i++)
+		{
+			traverseRay(queries.at(i), results.at(i));
+		}
+	};
+
+	if (threadPool)
+	{
+		// Each range is big enough to amortize scheduling, small enough to balance rays with different length
+		const unsigned int grainSize = 64;
+		threadPool->parallelFor(size, grainSize, castRange);
+	}
+	else
+	{
+		castRange(0, size);
+	}
+}
+
+void Voxel::ChunkMap::traverseRay(const RayQuery & query, RayQueryResult & result)
+{
+	result.block = nullptr;
+	result.face = Cube::Face::NONE;
+	result.blockWorldCoordinate = glm::ivec3(0);
+	result.distance = query.maxDistance;
+
+	const float length = glm::length(query.direction);
+	if (length == 0.0f || query.maxDistance <= 0.0f)
+	{
+		return;
+	}
+
+	const glm::vec3 dir = query.direction / length;
+	const float maxFloat = std::numeric_limits<float>::max();
+
+	// Block that ray is currently in
+	glm::ivec3 curBlockPos = glm::ivec3(glm::floor(query.origin));
+
+	// Step direction, distance between block borders and distance to next block border for each axis
+	glm::ivec3 step(0);
+	glm::vec3 tDelta(maxFloat);
+	glm::vec3 tMax(maxFloat);
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		if (dir[axis] > 0.0f)
+		{
+			step[axis] = 1;
+			tDelta[axis] = 1.0f / dir[axis];
+			tMax[axis] = (static_cast<float>(curBlockPos[axis] + 1) - query.origin[axis]) * tDelta[axis];
+		}
+		else if (dir[axis] < 0.0f)
+		{
+			step[axis] = -1;
+			tDelta[axis] = -1.0f / dir[axis];
+			tMax[axis] = (query.origin[axis] - static_cast<float>(curBlockPos[axis])) * tDelta[axis];
+		}
+	}
+
+	// Face that ray enters the block when it steps in each axis. 
+	const Cube::Face enterFace[3] = 
+	{
+		(step.x > 0) ? Cube::Face::LEFT : Cube::Face::RIGHT,
+		(step.y > 0) ? Cube::Face::BOTTOM : Cube::Face::TOP,
+		(step.z > 0) ? Cube::Face::FRONT : Cube::Face::BACK,
+	};
+
+	// Cache chunk and chunk section. Only query when ray enters new one.
+	std::shared_ptr<Chunk> chunk = nullptr;
+	glm::ivec2 chunkXZ(0);
+	bool chunkQueried = false;
+
+	ChunkSection* chunkSection = nullptr;
+	int chunkSectionY = -1;
+
+	float t = 0.0f;
+	Cube::Face face = Cube::Face::NONE;
+
+	while (t <= query.maxDistance)
+	{
+		if (curBlockPos.y >= 0 && curBlockPos.y < Constant::HEIGHEST_BLOCK_Y)
+		{
+			// Floor division. Works with negative coordinate.
+			const int cx = (curBlockPos.x >= 0) ? (curBlockPos.x / Constant::CHUNK_SECTION_WIDTH) : ((curBlockPos.x + 1) / Constant::CHUNK_SECTION_WIDTH) - 1;
+			const int cz = (curBlockPos.z >= 0) ? (curBlockPos.z / Constant::CHUNK_SECTION_LENGTH) : ((curBlockPos.z + 1) / Constant::CHUNK_SECTION_LENGTH) - 1;
+			const int cy = curBlockPos.y / Constant::CHUNK_SECTION_HEIGHT;
+
+			if (!chunkQueried || cx != chunkXZ.x || cz != chunkXZ.y)
+			{
+				// Entered new chunk
+				chunkXZ = glm::ivec2(cx, cz);
+				chunk = getChunkAtXZ(cx, cz);
+				chunkQueried = true;
+
+				if (chunk && (!chunk->isActive() || !chunk->isGenerated()))
+				{
+					// Can't access block that is in inactive chunk. Chunk sections of chunk that isn't generated yet can be changed by workers.
+					chunk = nullptr;
+				}
+
+				chunkSection = nullptr;
+				chunkSectionY = -1;
+			}
+
+			if (chunk && cy != chunkSectionY)
+			{
+				// Entered new chunk section
+				chunkSectionY = cy;
+				chunkSection = chunk->getChunkSectionAtY(cy);
+			}
+
+			// Start block is ignored (face is none)
+			if (chunkSection && face != Cube::Face::NONE)
+			{
+				const int lx = curBlockPos.x - (cx * Constant::CHUNK_SECTION_WIDTH);
+				const int ly = curBlockPos.y - (cy * Constant::CHUNK_SECTION_HEIGHT);
+				const int lz = curBlockPos.z - (cz * Constant::CHUNK_SECTION_LENGTH);
+
+				if (chunkSection->isBlockOccupied(lx, ly, lz))
+				{
+					// hit
+					result.block = chunkSection->getBlockAt(lx, ly, lz);
+					result.face = face;
+					result.blockWorldCoordinate = curBlockPos;
+					result.distance = t;
+					return;
+				}
+			}
+		}
+		else if ((curBlockPos.y < 0 && step.y <= 0) || (curBlockPos.y >= Constant::HEIGHEST_BLOCK_Y && step.y >= 0))
+		{
+			// Out of world and never comes back.
+			return;
+		}
+
+		// Step to next block on axis that has closest border
+		int axis = 0;
+		if (tMax.y < tMax[axis]) axis = 1;
+		if (tMax.z < tMax[axis]) axis = 2;
+
+		t = tMax[axis];
+		tMax[axis] += tDelta[axis];
+		curBlockPos[axis] += step[axis];
+		face = enterFace[axis];
+	}
+}
+
 void Voxel::ChunkMap::releaseChunk(const glm::ivec2 & coordinate)
 {
 	if (hasChunkAtXZ(coordinate.x, coordinate.y))
@@ -1140,7 +1320,7 @@ void Voxel::ChunkMap::update(const glm::ivec2& chunkDist, ChunkWorkManager * wor
 										v
 	*/
 
-	//auto start = Utility::Time::now();
+	V_PROFILE_ZONE("ChunkMap::update");
 
 	if (chunkDist.x != 0)
 	{
@@ -1153,13 +1333,13 @@ void Voxel::ChunkMap::update(const glm::ivec2& chunkDist, ChunkWorkManager * wor
 			if (chunkDist.x < 0)
 			{
 				// Moved to west
-				std::cout << "Player moved to west. chunkDist.x = " << chunkDist.x << std::endl;
+				V_LOG_DEBUG("[ChunkMap] Player moved to west. chunkDist.x = {}", chunkDist.x);
 				moveWest(workManager);
 			}
 			else
 			{
 				// moved to east
-				std::cout << "Player moved to east. chunkDist.x = " << chunkDist.x << std::endl;
+				V_LOG_DEBUG("[ChunkMap] Player moved to east. chunkDist.x = {}", chunkDist.x);
 				moveEast(workManager);
 			}
 		}
@@ -1177,13 +1357,13 @@ void Voxel::ChunkMap::update(const glm::ivec2& chunkDist, ChunkWorkManager * wor
 			if (chunkDist.y < 0)
 			{
 				// Move to north
-				std::cout << "Player moved to north. chunkDist.y = " << chunkDist.y << std::endl;
+				V_LOG_DEBUG("[ChunkMap] Player moved to north. chunkDist.y = {}", chunkDist.y);
 				moveNorth(workManager);
 			}
 			else
 			{
 				// Moved to sourth
-				std::cout << "Player moved to south. chunkDist.y = " << chunkDist.y << std::endl;
+				V_LOG_DEBUG("[ChunkMap] Player moved to south. chunkDist.y = {}", chunkDist.y);
 				moveSouth(workManager);
 			}
 		}
@@ -1191,9 +1371,6 @@ void Voxel::ChunkMap::update(const glm::ivec2& chunkDist, ChunkWorkManager * wor
 	// Else, didn't move in Z axis
 
 	workManager->notify();
-
-	//auto end = Utility::Time::now();
-	//std::cout << "Chunk loader update took: " << Utility::Time::toMilliSecondString(start, end) << std::endl;
 }
 
 void Voxel::ChunkMap::moveWest(ChunkWorkManager* wm)
@@ -1704,11 +1881,13 @@ bool Voxel::ChunkMap::isChunkOnEdge(const glm::ivec2 & chunkXZ)
 
 int Voxel::ChunkMap::findVisibleChunk(const int renderDistance)
 {
-	//auto start = Utility::Time::now();
+	V_PROFILE_ZONE("ChunkMap::findVisibleChunk");
 
 	// Count number of visible chunk for debug
 	int count = 0;
 
+	visibleChunks.clear();
+
 	// iterate chunk map
 	for (auto& e : map)
 	{
@@ -1735,6 +1914,8 @@ int Voxel::ChunkMap::findVisibleChunk(const int renderDistance)
 						{
 							chunk->setVisibility(true);
 
+							visibleChunks.push_back(chunk);
+
 							auto mesh = chunk->getMesh();
 
 							if (mesh->isRenderable())
@@ -1753,9 +1934,7 @@ int Voxel::ChunkMap::findVisibleChunk(const int renderDistance)
 		}
 	}
 
-	//auto end = Utility::Time::now();
-	//std::cout << "t = " << Utility::Time::toMicroSecondString(start, end) << "\n";
-	// 100000 ns (0.1 ms)
+	// Usually takes 100000 ns (0.1 ms)
 
 	return count;
 }
@@ -1849,127 +2028,80 @@ void Voxel::ChunkMap::setUpdateChunkMapMode(const bool mode)
 	updateChunksMode = mode;
 }
 
-void Voxel::ChunkMap::setRegionTerrainType(const unsigned int regionID, const Terrain & terrainType)
-{
-	if (regionTerrainsMap.find(regionID) == regionTerrainsMap.end())
-	{
-		regionTerrainsMap.emplace(regionID, terrainType);
-	}
-}
-
-std::unordered_map<unsigned int, Terrain>& Voxel::ChunkMap::getRegionTerrainsMap()
-{
-	return regionTerrainsMap;
-}
-
 glm::ivec2 Voxel::ChunkMap::getCurrentChunkXZ()
 {
 	return currentChunkPos;
 }
 
-void Voxel::ChunkMap::queryNearByCollidableBlocksInXZ(const glm::vec3 & playerPosition, std::vector<Block*>& collidableBlocks)
+bool Voxel::ChunkMap::isAnyBlockOccupiedInRange(const glm::ivec3 & minBlockWorldCoordinate, const glm::ivec3 & maxBlockWorldCoordinate)
 {
-	auto standingBlockWorldPos = glm::ivec3(0);
-	standingBlockWorldPos.x = static_cast<int>((playerPosition.x >= 0) ? playerPosition.x : glm::floor(playerPosition.x));
-	standingBlockWorldPos.y = static_cast<int>((playerPosition.y >= 0) ? playerPosition.y : 0);
-	standingBlockWorldPos.z = static_cast<int>((playerPosition.z >= 0) ? playerPosition.z : glm::floor(playerPosition.z));
-
-	// Query only near by in XZ axis. Bottom of over top blocks aren't counted
+	// Clamp y to world height
+	const int minY = std::max(minBlockWorldCoordinate.y, 0);
+	const int maxY = std::min(maxBlockWorldCoordinate.y, Constant::HEIGHEST_BLOCK_Y - 1);
 
-	int startX = standingBlockWorldPos.x - 1;
-	int startY = standingBlockWorldPos.y;
-	int startZ = standingBlockWorldPos.z - 1;
-	int endX = standingBlockWorldPos.x + 1;
-	int endY = standingBlockWorldPos.y + 3;
-	int endZ = standingBlockWorldPos.z + 1;
+	if (minY > maxY)
+	{
+		return false;
+	}
 
-	for (int x = startX; x <= endX; x++)
+	for (int x = minBlockWorldCoordinate.x; x <= maxBlockWorldCoordinate.x; x++)
 	{
-		for (int z = startZ; z <= endZ; z++)
+		// Floor division. Works with negative coordinate.
+		const int cx = (x >= 0) ? (x / Constant::CHUNK_SECTION_WIDTH) : ((x + 1) / Constant::CHUNK_SECTION_WIDTH) - 1;
+		const int lx = x - (cx * Constant::CHUNK_SECTION_WIDTH);
+
+		// Cache chunk. Only query when z enters new chunk
+		std::shared_ptr<Chunk> chunk = nullptr;
+		int chunkZ = 0;
+		bool chunkQueried = false;
+
+		for (int z = minBlockWorldCoordinate.z; z <= maxBlockWorldCoordinate.z; z++)
 		{
-			for (int y = startY; y <= endY; y++)
+			const int cz = (z >= 0) ? (z / Constant::CHUNK_SECTION_LENGTH) : ((z + 1) / Constant::CHUNK_SECTION_LENGTH) - 1;
+			const int lz = z - (cz * Constant::CHUNK_SECTION_LENGTH);
+
+			if (!chunkQueried || cz != chunkZ)
 			{
-				Block* block = getBlockAtWorldXYZ(x, y, z);
-				if (block)
-				{
-					if (block->isCollidable())
-					{
-						collidableBlocks.push_back(block);
-					}
-				}
+				chunkZ = cz;
+				chunk = getChunkAtXZ(cx, cz);
+				chunkQueried = true;
 			}
-		}
-	}
-}
-
-void Voxel::ChunkMap::queryBottomCollidableBlocksInY(const glm::vec3 & playerPosition, std::vector<Block*>& collidableBlocks)
-{
-	auto standingBlockWorldPos = glm::ivec3(0);
-	standingBlockWorldPos.x = static_cast<int>((playerPosition.x >= 0) ? playerPosition.x : glm::floor(playerPosition.x));
-	standingBlockWorldPos.y = static_cast<int>((playerPosition.y >= 0) ? playerPosition.y : 0);
-	standingBlockWorldPos.z = static_cast<int>((playerPosition.z >= 0) ? playerPosition.z : glm::floor(playerPosition.z));
 
-	// Query only near by in XZ axis. Bottom of over top blocks aren't counted
+			if (chunk == nullptr || !chunk->isActive() || !chunk->isGenerated())
+			{
+				// Can't access block that is in inactive chunk. Chunk sections of chunk that isn't generated yet can be changed by workers.
+				continue;
+			}
 
-	int startX = standingBlockWorldPos.x - 1;
-	int startY = standingBlockWorldPos.y - 1;
-	int startZ = standingBlockWorldPos.z - 1;
-	int endX = standingBlockWorldPos.x + 1;
-	int endY = standingBlockWorldPos.y;
-	int endZ = standingBlockWorldPos.z + 1;
+			ChunkSection* chunkSection = nullptr;
+			int chunkSectionY = -1;
 
-	for (int x = startX; x <= endX; x++)
-	{
-		for (int z = startZ; z <= endZ; z++)
-		{
-			for (int y = startY; y <= endY; y++)
+			for (int y = minY; y <= maxY; y++)
 			{
-				Block* block = getBlockAtWorldXYZ(x, y, z);
-				if (block)
+				const int cy = y / Constant::CHUNK_SECTION_HEIGHT;
+
+				if (cy != chunkSectionY)
 				{
-					if (block->isCollidable())
-					{
-						collidableBlocks.push_back(block);
-					}
+					chunkSectionY = cy;
+					chunkSection = chunk->getChunkSectionAtY(cy);
 				}
-			}
-		}
-	}
-}
-
-void Voxel::ChunkMap::queryTopCollidableBlocksInY(const glm::vec3 & playerPosition, std::vector<Block*>& collidableBlocks)
-{
-	auto standingBlockWorldPos = glm::ivec3(0);
-	standingBlockWorldPos.x = static_cast<int>((playerPosition.x >= 0) ? playerPosition.x : glm::floor(playerPosition.x));
-	standingBlockWorldPos.y = static_cast<int>((playerPosition.y >= 0) ? playerPosition.y : 0);
-	standingBlockWorldPos.z = static_cast<int>((playerPosition.z >= 0) ? playerPosition.z : glm::floor(playerPosition.z));
 
-	// Query only near by in XZ axis. Bottom of over top blocks aren't counted
-
-	int startX = standingBlockWorldPos.x - 1;
-	int startY = standingBlockWorldPos.y + 2;
-	int startZ = standingBlockWorldPos.z - 1;
-	int endX = standingBlockWorldPos.x + 1;
-	int endY = standingBlockWorldPos.y + 3;
-	int endZ = standingBlockWorldPos.z + 1;
+				if (chunkSection == nullptr)
+				{
+					// Whole section is air. Skip to next section
+					y = ((cy + 1) * Constant::CHUNK_SECTION_HEIGHT) - 1;
+					continue;
+				}
 
-	for (int x = startX; x <= endX; x++)
-	{
-		for (int z = startZ; z <= endZ; z++)
-		{
-			for (int y = startY; y <= endY; y++)
-			{
-				Block* block = getBlockAtWorldXYZ(x, y, z);
-				if (block)
+				if (chunkSection->isBlockOccupied(lx, y - (cy * Constant::CHUNK_SECTION_HEIGHT), lz))
 				{
-					if (block->isCollidable())
-					{
-						collidableBlocks.push_back(block);
-					}
+					return true;
 				}
 			}
 		}
 	}
+
+	return false;
 }
 
 void Voxel::ChunkMap::queryNearByBlocks(const glm::vec3 & position, std::vector<Block*>& collidableBlocks)
@@ -2027,29 +2159,165 @@ int Voxel::ChunkMap::getTopYAt(const glm::vec2 & position)
 
 void Voxel::ChunkMap::render(const glm::vec3& playerPosition)
 {
+	// Load every staged mesh, including chunks that aren't visible. Mesh that isn't loaded keeps its staging and stalls ring.
+	loadStagedMeshes(MESH_UPLOAD_BUDGET);
+
 	if (renderChunksMode)
 	{
-		for (auto& e : map)
+		renderCenter = playerPosition;
+
+		collectDrawRecords();
+
+		ChunkDrawListBuilder::build(drawRecords, renderCenter, drawList);
+
+		if (renderBackend == nullptr)
+		{
+			renderBackend = new GLChunkRenderBackend(ProgramManager::getInstance().getProgram(ProgramManager::PROGRAM_NAME::BLOCK_SHADER));
+		}
+
+		renderBackend->submit(drawList);
+	}
+}
+
+void Voxel::ChunkMap::loadStagedMeshes(const float budgetMilliSeconds)
+{
+	V_PROFILE_ZONE("ChunkMap::loadStagedMeshes");
+
+	if (!geometryArena.isInitialized())
+	{
+		geometryArena.init(ProgramManager::getInstance().getProgram(ProgramManager::PROGRAM_NAME::BLOCK_SHADER));
+	}
+
+	// Free geometry of meshes that were released or destroyed since last frame
+	geometryArena.releaseDeferred();
+
+	auto start = Utility::Time::now();
+
+	while (true)
+	{
+		std::shared_ptr<Chunk> chunk;
+
 		{
-			// Get chunk raw pointer. 
-			auto chunk = (e.second).get();
-			if (chunk != nullptr)
+			std::unique_lock<std::mutex> lock(stagedMeshMutex);
+
+			if (stagedMeshQueue.empty())
 			{
-				if (chunk->isActive())
-				{
-					if (chunk->isGenerated())
-					{
-						if (chunk->isVisible())
-						{
-							chunk->render(playerPosition);
-						}
-					}
-				}
+				break;
 			}
+
+			chunk = stagedMeshQueue.front().lock();
+			stagedMeshQueue.pop_front();
+		}
+
+		if (chunk == nullptr)
+		{
+			// Chunk is released
+			continue;
+		}
+
+		auto chunkMesh = chunk->getMesh();
+
+		if (chunkMesh == nullptr || !chunkMesh->isBufferLoadable())
+		{
+			// Cleared, or already loaded because chunk was queued again
+			continue;
+		}
+
+		// Previous geometry stays renderable until new one is loaded
+		chunkMesh->loadBuffer(&geometryArena);
+
+		if (chunkMesh->isBufferLoadable())
+		{
+			// Arena can't grow. Try again next frame.
+			std::unique_lock<std::mutex> lock(stagedMeshMutex);
+			stagedMeshQueue.push_front(chunk);
+			break;
+		}
+
+		const float elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Utility::Time::now() - start).count() / 1000.0f;
+
+		if (elapsed >= budgetMilliSeconds)
+		{
+			break;
 		}
 	}
 }
 
+void Voxel::ChunkMap::collectDrawRecords()
+{
+	drawRecords.clear();
+	drawRecords.reserve(visibleChunks.size());
+
+	for (auto& chunk : visibleChunks)
+	{
+		// Chunk can be released or meshed again after culling
+		if (!chunk->isActive() || !chunk->isGenerated() || !chunk->isVisible())
+		{
+			continue;
+		}
+
+		auto chunkMesh = chunk->getMesh();
+
+		if (chunkMesh == nullptr)
+		{
+			continue;
+		}
+
+		if (!chunkMesh->isRenderable())
+		{
+			// Not renderable, buffer not ready.
+			continue;
+		}
+
+		const int indexCount = chunkMesh->getIndicesSize();
+
+		if (indexCount <= 0)
+		{
+			continue;
+		}
+
+		ChunkDrawRecord record;
+		record.vao = chunkMesh->getVAO();
+		record.indexCount = static_cast<GLuint>(indexCount);
+		record.firstIndex = chunkMesh->getFirstIndex();
+		record.baseVertex = chunkMesh->getBaseVertex();
+		record.worldPosition = chunk->worldPosition;
+
+		drawRecords.push_back(record);
+	}
+}
+
+void Voxel::ChunkMap::setRenderBackend(ChunkRenderBackend * backend)
+{
+	if (renderBackend)
+	{
+		delete renderBackend;
+	}
+
+	renderBackend = backend;
+}
+
+const ChunkDrawList & Voxel::ChunkMap::getDrawList() const
+{
+	return drawList;
+}
+
+StagingRing * Voxel::ChunkMap::getStagingRing()
+{
+	return &stagingRing;
+}
+
+void Voxel::ChunkMap::addStagedMesh(const std::shared_ptr<Chunk>& chunk)
+{
+	std::unique_lock<std::mutex> lock(stagedMeshMutex);
+	stagedMeshQueue.push_back(chunk);
+}
+
+const ChunkGeometryArena & Voxel::ChunkMap::getGeometryArena() const
+{
+	return geometryArena;
+}
+
 
 void Voxel::ChunkMap::renderBlockOutline(Program * lineProgram, const glm::vec3& blockPosition)
 {
@@ -2058,8 +2326,8 @@ void Voxel::ChunkMap::renderBlockOutline(Program * lineProgram, const glm::vec3&
 		glBindVertexArray(blockOutlineVao);
 
 		glm::mat4 cubeMat = glm::translate(glm::mat4(1.0f), blockPosition);
-		lineProgram->setUniformMat4("modelMat", cubeMat);
-		lineProgram->setUniformVec4("lineColor", glm::vec4(1.0f));
+		lineProgram->setUniformMat4(SID("modelMat"), cubeMat);
+		lineProgram->setUniformVec4(SID("lineColor"), glm::vec4(1.0f));
 
 		glDrawElements(GL_LINES, 24, GL_UNSIGNED_INT, 0);
 
@@ -2262,6 +2530,7 @@ void Voxel::ChunkMap::updateChunkBorderDebugLineModelMat()
 	auto chunk = getChunkAtXZ(currentChunkPos);
 	if (chunk)
 	{
+		chunk->updateModelMat(renderCenter);
 		chunkBorderModelMat = chunk->modelMat;
 	}
 }
@@ -2272,8 +2541,8 @@ void Voxel::ChunkMap::renderChunkBorder(Program * program)
 	{
 		glBindVertexArray(chunkBorderVao);
 
-		program->setUniformMat4("modelMat", chunkBorderModelMat);
-		program->setUniformVec4("lineColor", glm::vec4(1.0f));
+		program->setUniformMat4(SID("modelMat"), chunkBorderModelMat);
+		program->setUniformVec4(SID("lineColor"), glm::vec4(1.0f));
 
 		glDrawArrays(GL_LINES, 0, chunkBorderLineSize);
 
@@ -2309,8 +2578,8 @@ void Voxel::ChunkMap::renderCameraChunkBorder(Program * program, const glm::vec3
 
 			glm::mat4 modelMat = glm::translate(glm::mat4(1.0f), chunkWP - cameraPosition);
 
-			program->setUniformMat4("modelMat", modelMat);
-			program->setUniformVec4("lineColor", glm::vec4(1.0f));
+			program->setUniformMat4(SID("modelMat"), modelMat);
+			program->setUniformVec4(SID("lineColor"), glm::vec4(1.0f));
 
 			glDrawArrays(GL_LINES, 0, chunkBorderLineSize);
 
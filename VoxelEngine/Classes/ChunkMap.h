@@ -6,6 +6,7 @@
 #include <unordered_set>
 #include <memory>
 #include <mutex>
+#include <deque>
 
 // glm
 #include <glm\glm.hpp>
@@ -20,6 +21,9 @@
 #include "Shape.h"
 #include "Cube.h"
 #include "Terrain.h"
+#include "ChunkDrawList.h"
+#include "ChunkGeometryArena.h"
+#include "StagingRing.h"
 
 namespace Voxel
 {
@@ -28,6 +32,7 @@ namespace Voxel
 	class ChunkWorkManager;
 	class Region;
 	class Program;
+	class ThreadPool;
 
 	// Raycast result
 	struct RayResult	
@@ -39,6 +44,32 @@ namespace Voxel
 		Cube::Face face;
 	};
 
+	// Single ray for batched raycast
+	struct RayQuery
+	{
+	public:
+		// Start position of ray in world
+		glm::vec3 origin;
+		// Direction of ray. Doesn't have to be normalized.
+		glm::vec3 direction;
+		// Maximum distance that ray travels
+		float maxDistance;
+	};
+
+	// Batched raycast result
+	struct RayQueryResult
+	{
+	public:
+		// Nullptr if ray didn't hit
+		Block* block;
+		// The face that ray hit
+		Cube::Face face;
+		// World coordinate of block that ray hit. Only valid if block isn't nullptr
+		glm::ivec3 blockWorldCoordinate;
+		// Distance from ray's origin to hit point. maxDistance if ray didn't hit
+		float distance;
+	};
+
 	// shortcut with custom comparator
 	typedef std::unordered_map<glm::ivec2, std::shared_ptr<Chunk>, KeyFuncs, KeyFuncs> ChunkUnorderedMap;
 
@@ -54,6 +85,12 @@ namespace Voxel
 	class ChunkMap
 	{
 	private:
+		// Size of staging ring in bytes. Meshes that don't fit are staged on heap.
+		static const unsigned int STAGING_RING_SIZE;
+
+		// Max time to spend on loading staged meshes per frame in milliseconds
+		static const float MESH_UPLOAD_BUDGET;
+
 		// chunk map
 		ChunkUnorderedMap map;
 
@@ -69,9 +106,6 @@ namespace Voxel
 		// 2D list that keep tracks the active chunk coordinates
 		std::list<std::list<glm::ivec2>> activeChunks;
 
-		// Cache the terrain type for each region. This is used when work manager generates chunk's hight map. chunk has region map and need terrain type for each region value in region map.
-		std::unordered_map<unsigned int, Terrain> regionTerrainsMap;
-
 		// Chunk map's min and max XZ coordinate
 		glm::ivec2 minXZ;
 		glm::ivec2 maxXZ;
@@ -86,6 +120,40 @@ namespace Voxel
 		GLuint blockOutlineVao;
 		bool renderBlockOutlineMode;
 
+		// Chunks that passed culling in last findVisibleChunk(). Only these are visited to build draw list.
+		std::vector<std::shared_ptr<Chunk>> visibleChunks;
+
+		// Records of visible chunks that have renderable mesh. Rebuilt every frame
+		std::vector<ChunkDrawRecord> drawRecords;
+
+		// Draws of visible chunks. Rebuilt every frame
+		ChunkDrawList drawList;
+
+		// Mesh data that workers built and main thread hasn't loaded yet
+		StagingRing stagingRing;
+
+		// Chunks that staged mesh, in staging order. Loaded regardless of visibility, so ring is reclaimed in order.
+		std::deque<std::weak_ptr<Chunk>> stagedMeshQueue;
+		std::mutex stagedMeshMutex;
+
+		// Geometry of all chunk meshes
+		ChunkGeometryArena geometryArena;
+
+		// Submits draw list. GLChunkRenderBackend by default.
+		ChunkRenderBackend* renderBackend;
+
+		// Center position of last render. Chunks are rendered relative to this.
+		glm::vec3 renderCenter;
+
+		/**
+		*	Load staged meshes to arena in staging order until budget is used. Loads at least one mesh if queue isn't empty.
+		*	@param budgetMilliSeconds Max time to spend in milliseconds.
+		*/
+		void loadStagedMeshes(const float budgetMilliSeconds);
+
+		// Collect draw records of visible chunks that have loaded mesh.
+		void collectDrawRecords();
+
 		/**
 		*	Move chunk map to west (negative x)
 		*	@param wm ChunkWorkManager pointer to add work.
@@ -157,6 +225,16 @@ namespace Voxel
 		*	@param wm ChunkWorkManager pointer to add work.
 		*/
 		void removeColNorth(ChunkWorkManager* wm);
+
+		/**
+		*	Traverse voxels along the ray and stops at first occupied block.
+		*	Walks block by block (3D DDA) and reads chunk section's occupancy mask. 
+		*	Chunk and chunk section are only queried when ray enters new one.
+		*	Thread safe as long as main thread doesn't modify the map during the call.
+		*	@param query Ray to cast
+		*	@param result A ref of result to get.
+		*/
+		void traverseRay(const RayQuery& query, RayQueryResult& result);
 	public:
 		// constructor
 		ChunkMap();
@@ -343,6 +421,18 @@ namespace Voxel
 		*	@return Minimum distance from camera's position and player's eye.
 		*/
 		float raycastCamera(const glm::vec3& rayStart, const glm::vec3& rayEnd, const float maxCameraRange);
+
+		/**
+		*	Raycasts batch of rays. 
+		*	Unlike raycastBlock, this steps exactly 1 block at a time and never misses block.
+		*	Block that ray starts in is ignored, same as raycastBlock.
+		*	Rays are split in ranges and resolved on thread pool. Blocks until all rays are resolved. 
+		*	Do not modify chunk map (place, remove, release) until this returns.
+		*	@param queries List of rays to cast.
+		*	@param results A ref list of results to get. Resized to size of queries, in same order.
+		*	@param threadPool Thread pool to run raycast. If nullptr, runs on calling thread.
+		*/
+		void raycastBlocks(const std::vector<RayQuery>& queries, std::vector<RayQueryResult>& results, ThreadPool* threadPool = nullptr);
 		
 		/**
 		*	Release chunk.
@@ -391,7 +481,7 @@ namespace Voxel
 		void update(const glm::ivec2& chunkDist, ChunkWorkManager* workManager);
 				
 		/**
-		*	Find visible chunks based on render distance
+		*	Find visible chunks based on render distance. Visible chunks are kept to build draw list on render.
 		*	@param renderDistance Number of chunks that are rendered from player's position.
 		*	@return Number of visible chunks.
 		*/
@@ -429,34 +519,18 @@ namespace Voxel
 		*/
 		void setUpdateChunkMapMode(const bool mode);
 
-		// Set terrain type for region
-		void setRegionTerrainType(const unsigned int regionID, const Terrain& terrainType);
-		std::unordered_map<unsigned int, Terrain>& getRegionTerrainsMap();
-			
 		// Get current chunk xz pos
 		glm::ivec2 getCurrentChunkXZ();
 		
 		/**
-		*	Queries collidable blocks near player in x and z axis primarily. This doesn't queries blocks underneath or above.
-		*	Range of query is 1 block wide and long.
-		*	@param playerPosition Player's position to query.
-		*	@param collidableBlocks A ref list of block pointers that are collidable.
-		*/
-		void queryNearByCollidableBlocksInXZ(const glm::vec3& playerPosition, std::vector<Block*>& collidableBlocks);
-
-		/**
-		*	Queries collidable blocks that are under player's position. 
-		*	@param playerPosition Player's position to query.
-		*	@param collidableBlocks A ref list of block pointers that are collidable.
-		*/
-		void queryBottomCollidableBlocksInY(const glm::vec3& playerPosition, std::vector<Block*>& collidableBlocks);
-
-		/**
-		*	Queries collidable blocks that are above player's position.
-		*	@param playerPosition Player's position to query.
-		*	@param collidableBlocks A ref list of block pointers that are collidable.
+		*	Checks if any block in range is not air. Reads chunk section's occupancy mask, so no block pointer is touched.
+		*	Chunk and chunk section are only queried when range enters new one. Doesn't allocate.
+		*	Blocks in chunk that doesn't exist or is inactive, and blocks out of world height are treated as air.
+		*	@param minBlockWorldCoordinate Minimum block world coordinate of range. Inclusive.
+		*	@param maxBlockWorldCoordinate Maximum block world coordinate of range. Inclusive.
+		*	@return true if there is at least 1 block that isn't air in range. Else, false.
 		*/
-		void queryTopCollidableBlocksInY(const glm::vec3& playerPosition, std::vector<Block*>& collidableBlocks);
+		bool isAnyBlockOccupiedInRange(const glm::ivec3& minBlockWorldCoordinate, const glm::ivec3& maxBlockWorldCoordinate);
 
 		/**
 		*	Queries collidable blocks nearby the given position, range of 1.
@@ -471,6 +545,24 @@ namespace Voxel
 		// render chunks
 		void render(const glm::vec3& playerPosition);
 
+		/**
+		*	Set render backend. ChunkMap owns backend. Use NullChunkRenderBackend to run without drawing.
+		*	@param backend Backend to set. Previous backend is released.
+		*/
+		void setRenderBackend(ChunkRenderBackend* backend);
+
+		// Get draw list that is built on last render
+		const ChunkDrawList& getDrawList() const;
+
+		// Get staging ring. Worker threads stage chunk mesh here.
+		StagingRing* getStagingRing();
+
+		// Queue chunk that staged mesh to be loaded. Thread safe.
+		void addStagedMesh(const std::shared_ptr<Chunk>& chunk);
+
+		// Get geometry arena
+		const ChunkGeometryArena& getGeometryArena() const;
+
 		// render block outline
 		void renderBlockOutline(Program* lineProgram, const glm::vec3& blockPosition);
 
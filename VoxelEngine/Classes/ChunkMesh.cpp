@@ -3,22 +3,21 @@
 
 #include "ChunkMesh.h"
 
+// cpp
+#include <cstring>
+
 // voxel
 #include "Config.h"
-#include "ProgramManager.h"
-#include "Program.h"
-#include "InputHandler.h"
 #include "Utility.h"
 
 using namespace Voxel;
 
 ChunkMesh::ChunkMesh()
-	: vao(0)
-	, vbo(0)
-	, cbo(0)
-	, nbo(0)
-	, ibo(0)
+	: stagingRing(nullptr)
+	, stagedVertexCount(0)
+	, stagedIndexCount(0)
 	, indicesSize(0)
+	, arena(nullptr)
 {
 	renderable.store(false);
 	loadable.store(false);
@@ -26,187 +25,144 @@ ChunkMesh::ChunkMesh()
 
 ChunkMesh::~ChunkMesh()
 {
-	// clear vectors
-	vertices.clear();
-	colors.clear();
-	normals.clear();
-	indices.clear();
+	std::unique_lock<std::mutex> lock(stagingMutex);
+	releaseStaging();
 
-	// Delte vao
-	if (vao)
+	// Last reference of chunk can be dropped on worker thread. Main thread releases range in arena.
+	if (arena)
 	{
-		glDeleteVertexArrays(1, &vao);
+		arena->deferRelease(allocation);
 	}
 }
 
-void Voxel::ChunkMesh::initBuffer(const std::vector<float>& vertices, const std::vector<float>& colors, const std::vector<float>& normals, const std::vector<unsigned int>& indices)
+const char * Voxel::ChunkMesh::getStagedData() const
 {
-	// clear vectors
-	this->vertices.clear();
-	this->colors.clear();
-	this->indices.clear();
-
-	// Copy vertices
-	this->vertices = vertices;
-	this->colors = colors;
-	this->indices = indices;
-	this->normals = normals;
-	this->indicesSize = static_cast<int>(indices.size());
-
-	loadable.store(true);
-
-	if (vao != 0)
+	if (stagingBlock.isValid())
 	{
-		markAsUpdated();
+		return stagingRing->getData(stagingBlock);
+	}
+	else
+	{
+		return fallbackStaging.data();
 	}
 }
 
-void Voxel::ChunkMesh::loadBuffer(Program* program)
+void Voxel::ChunkMesh::releaseStaging()
 {
-	if (vao != 0)
+	if (stagingBlock.isValid())
 	{
-		glDeleteVertexArrays(1, &vao);
+		stagingRing->release(stagingBlock);
 	}
 
-	//auto start = Utility::Time::now();
-	// 1. VAO
-	// Generate vertex array object
-	glGenVertexArrays(1, &vao);
-	// Bind it
-	glBindVertexArray(vao);
-
-	// 2. VBO
-	// Generate buffer object
-	glGenBuffers(1, &vbo);
-	// Bind it
-	glBindBuffer(GL_ARRAY_BUFFER, vbo);
-	// Load cube vertices
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * vertices.size(), &vertices.front(), GL_STATIC_DRAW);
-
-	// Enable vertices attrib
-	GLint vertLoc = program->getAttribLocation("vert");
-	GLint colorLoc = program->getAttribLocation("color");
-	GLint normalLoc = program->getAttribLocation("normal");
-
-	// vert
-	glEnableVertexAttribArray(vertLoc);
-	glVertexAttribPointer(vertLoc, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
-
-	// 3. CBO
-	// Generate buffer boejct
-	glGenBuffers(1, &cbo);
-	// Bind it
-	glBindBuffer(GL_ARRAY_BUFFER, cbo);
-	// load color data
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * colors.size(), &colors.front(), GL_STATIC_DRAW);
-
-	// color
-	glEnableVertexAttribArray(colorLoc);
-	glVertexAttribPointer(colorLoc, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
-
-	// 4. NBO
-	// Generate buffer boejct
-	glGenBuffers(1, &nbo);
-	// Bind it
-	glBindBuffer(GL_ARRAY_BUFFER, nbo);
-	// load normal vector data
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * normals.size(), &normals.front(), GL_STATIC_DRAW);
-
-	// normal
-	glEnableVertexAttribArray(normalLoc);
-	glVertexAttribPointer(normalLoc, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
-
-	// 5. IBO
-	// Generate indices object
-	glGenBuffers(1, &ibo);
-	// Bind indices
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
-	// Load indices
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * indices.size(), &indices.front(), GL_STATIC_DRAW);
-
-	glBindVertexArray(0);
-
-	// Delte buffers
-	glDeleteBuffers(1, &vbo);
-	glDeleteBuffers(1, &cbo);
-	glDeleteBuffers(1, &nbo);
-	glDeleteBuffers(1, &ibo);
-
-	vbo = 0;
-	cbo = 0;
-	nbo = 0;
-	ibo = 0;
-
-	this->vertices.clear();
-	this->colors.clear();
-	this->normals.clear();
-	this->indices.clear();
-
-	renderable.store(true);
-	loadable.store(false);
+	// Free memory. Fallback is rare.
+	std::vector<char>().swap(fallbackStaging);
 
-	//auto end = Utility::Time::now();
-	//std::cout << "Loading buffer Elapsed time: " << Utility::Time::toMilliSecondString(start, end) << std::endl;
+	stagedVertexCount = 0;
+	stagedIndexCount = 0;
 }
 
-void Voxel::ChunkMesh::markAsUpdated()
+void Voxel::ChunkMesh::initBuffer(const std::vector<float>& vertices, const std::vector<float>& colors, const std::vector<float>& normals, const std::vector<unsigned int>& indices, StagingRing* stagingRing)
 {
-	renderable.store(false);
-}
+	const unsigned int vertexCount = static_cast<unsigned int>(vertices.size() / 3);
+	const unsigned int indexCount = static_cast<unsigned int>(indices.size());
 
-bool ChunkMesh::bind()
-{
-	if (vao)
+	const unsigned int vertexSize = vertexCount * sizeof(ChunkVertex);
+	const unsigned int size = vertexSize + (indexCount * sizeof(unsigned int));
+
+	std::unique_lock<std::mutex> lock(stagingMutex);
+
+	// Previous data that wasn't loaded is replaced
+	releaseStaging();
+
+	this->stagingRing = stagingRing;
+
+	char* data = nullptr;
+
+	if (stagingRing && stagingRing->allocate(size, stagingBlock))
 	{
-		glBindVertexArray(vao);
-		return true;
+		data = stagingRing->getData(stagingBlock);
 	}
 	else
 	{
-		return false;
+		fallbackStaging.resize(size);
+		data = fallbackStaging.data();
 	}
-}
 
-void ChunkMesh::render()
-{
-	assert(indicesSize > 0);
-	glDrawElements(GL_TRIANGLES, indicesSize, GL_UNSIGNED_INT, 0);
+	// Interleave
+	ChunkVertex* dst = reinterpret_cast<ChunkVertex*>(data);
 
-#if V_DEBUG
-	auto glView = Application::getInstance().getGLView();
-#if V_DEBUG_COUNT_DRAW_CALLS
-	if (glView->doesCountDrawCalls())
+	for (unsigned int i = 0; i < vertexCount; i++)
 	{
-		glView->incrementDrawCall();
+		const unsigned int v = i * 3;
+		const unsigned int c = i * 4;
+
+		dst[i].position = glm::vec3(vertices[v], vertices[v + 1], vertices[v + 2]);
+		dst[i].color = glm::vec4(colors[c], colors[c + 1], colors[c + 2], colors[c + 3]);
+		dst[i].normal = glm::vec3(normals[v], normals[v + 1], normals[v + 2]);
 	}
-#endif
-#if V_DEBUG_COUNT_VISIBLE_VERTICES
-	if (glView->doesCountVerticesSize())
+
+	if (indexCount > 0)
 	{
-		glView->addVerticesSize(indicesSize);
+		std::memcpy(data + vertexSize, indices.data(), indexCount * sizeof(unsigned int));
 	}
-#endif
-#endif
 
+	stagedVertexCount = vertexCount;
+	stagedIndexCount = indexCount;
+
+	loadable.store(true);
 }
 
-void ChunkMesh::unbind()
+void Voxel::ChunkMesh::loadBuffer(ChunkGeometryArena* arena)
 {
-	glBindVertexArray(0);
+	std::unique_lock<std::mutex> lock(stagingMutex);
+
+	if (!loadable.load())
+	{
+		return;
+	}
+
+	ChunkGeometryArena::Allocation newAllocation;
+
+	if (stagedIndexCount > 0)
+	{
+		if (!arena->allocate(stagedVertexCount, stagedIndexCount, newAllocation))
+		{
+			// Arena can't grow. Keep staged data and try again later.
+			return;
+		}
+
+		const char* data = getStagedData();
+
+		arena->upload(newAllocation, reinterpret_cast<const ChunkVertex*>(data), stagedVertexCount, reinterpret_cast<const unsigned int*>(data + (stagedVertexCount * sizeof(ChunkVertex))), stagedIndexCount);
+	}
+
+	// Swap to new geometry. Old one was drawn until now.
+	if (this->arena)
+	{
+		this->arena->release(allocation);
+	}
+
+	this->arena = arena;
+	allocation = newAllocation;
+	indicesSize = static_cast<int>(stagedIndexCount);
+
+	releaseStaging();
+
+	renderable.store(true);
+	loadable.store(false);
 }
 
-void Voxel::ChunkMesh::releaseVAO()
+void Voxel::ChunkMesh::releaseGeometry()
 {
-	if (vao)
+	std::unique_lock<std::mutex> lock(stagingMutex);
+
+	// Can be called from worker thread. Main thread releases range in arena.
+	if (arena)
 	{
-		glDeleteVertexArrays(1, &vao);
+		arena->deferRelease(allocation);
 	}
 
-	vao = 0;
-	vbo = 0;
-	cbo = 0;
-	nbo = 0;
-	ibo = 0;
+	indicesSize = 0;
 
 	renderable.store(false);
 	loadable.store(false);
@@ -214,12 +170,13 @@ void Voxel::ChunkMesh::releaseVAO()
 
 void Voxel::ChunkMesh::clearBuffers()
 {
-	vertices.clear();
-	colors.clear();
-	normals.clear();
-	indices.clear();
+	std::unique_lock<std::mutex> lock(stagingMutex);
+
+	releaseStaging();
+
 	indicesSize = 0;
 
+	loadable.store(false);
 }
 
 bool Voxel::ChunkMesh::isRenderable()
@@ -232,3 +189,42 @@ bool Voxel::ChunkMesh::isBufferLoadable()
 	// Check if mesh has buffer.
 	return loadable.load();
 }
+
+unsigned int Voxel::ChunkMesh::getVertexCount()
+{
+	std::unique_lock<std::mutex> lock(stagingMutex);
+
+	return stagedVertexCount;
+}
+
+unsigned int Voxel::ChunkMesh::getStagedIndexCount()
+{
+	std::unique_lock<std::mutex> lock(stagingMutex);
+
+	return stagedIndexCount;
+}
+
+int Voxel::ChunkMesh::getIndicesSize() const
+{
+	return indicesSize;
+}
+
+GLuint Voxel::ChunkMesh::getVAO() const
+{
+	if (arena && allocation.isValid())
+	{
+		return arena->getVAO();
+	}
+
+	return 0;
+}
+
+GLuint Voxel::ChunkMesh::getFirstIndex() const
+{
+	return arena->getFirstIndex(allocation);
+}
+
+GLint Voxel::ChunkMesh::getBaseVertex() const
+{
+	return arena->getBaseVertex(allocation);
+}
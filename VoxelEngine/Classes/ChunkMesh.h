@@ -4,6 +4,7 @@
 // cpp
 #include <vector>
 #include <atomic>
+#include <mutex>
 
 // gl
 #include <GL\glew.h>
@@ -11,58 +12,93 @@
 // glm
 #include <glm\glm.hpp>
 
+// voxel
+#include "StagingRing.h"
+#include "ChunkGeometryArena.h"
+
 namespace Voxel
 {
-	class Program;
-
 	/**
 	*	@class ChunkMesh
-	*	@brief Contains vertices data of chunk. Also manages OpenGL objects
+	*	@brief Contains vertices data of chunk. Geometry lives in ChunkGeometryArena.
+	*
+	*	Worker thread writes interleaved vertices and indices to StagingRing (initBuffer).
+	*	Main thread copies staged data to arena (loadBuffer) and releases staging.
+	*	Mesh only holds allocation of arena, not buffers.
 	*/
 	class ChunkMesh
 	{
 	private:
-		// temporary vertices vectors. This gets cleared once data is loaded
-		std::vector<float> vertices;
-		std::vector<float> colors;
-		std::vector<float> normals;
-		std::vector<unsigned int> indices;
+		// Staged data waiting to be loaded. [ChunkVertex * stagedVertexCount][unsigned int * stagedIndexCount]
+		StagingRing* stagingRing;
+		StagingRing::Block stagingBlock;
+		// Used when ring is full
+		std::vector<char> fallbackStaging;
+		unsigned int stagedVertexCount;
+		unsigned int stagedIndexCount;
+
+		// Locks staging. Worker writes while main thread can load previous data.
+		std::mutex stagingMutex;
 
+		// Number of indices loaded to arena
 		int indicesSize;
 
 		std::atomic<bool> renderable;
 		std::atomic<bool> loadable;
 		
-		// Opengl objects
-		GLuint vao;	// vertex array object
-		GLuint vbo;	// vertex buffer object (cube)
-		GLuint cbo;	// color buffer object
-		GLuint nbo;
-		GLuint ibo;	// index buffer object 
-
-		// Mark this mesh as updated and need to update buffer.
-		void markAsUpdated();
+		// Ranges in arena
+		ChunkGeometryArena* arena;
+		ChunkGeometryArena::Allocation allocation;
+
+		// Get staged data. Lock staging before call.
+		const char* getStagedData() const;
+
+		// Release staged data. Lock staging before call.
+		void releaseStaging();
 	public:
 		ChunkMesh();
 		~ChunkMesh();
 
-		void initBuffer(const std::vector<float>& vertices, const std::vector<float>& colors, const std::vector<float>& normals, const std::vector<unsigned int>& indices);
-		void loadBuffer(Program* program);
+		/**
+		*	Stage mesh data. Called by worker thread.
+		*	@param stagingRing Ring to stage data. Falls back to heap if ring is full or nullptr.
+		*/
+		void initBuffer(const std::vector<float>& vertices, const std::vector<float>& colors, const std::vector<float>& normals, const std::vector<unsigned int>& indices, StagingRing* stagingRing);
 
-		bool bind();
-		void render();
-		void unbind();
+		/**
+		*	Load staged data to arena. Previous geometry is released after new one is loaded.
+		*	@param arena Arena to load. Must be initialized.
+		*/
+		void loadBuffer(ChunkGeometryArena* arena);
 
-		// Release mesh. Delete vao and set bools to false
-		void releaseVAO();
-		// Clear all buffers(vertices, colors, indices)
+		// Release mesh. Queue arena allocation to release and set bools to false
+		void releaseGeometry();
+		// Clear staged data
 		void clearBuffers();
 		
-		// Check if it mesh is renderable. True if vao is not 0 or has buffer to load
+		// Check if it mesh is renderable. True if geometry is loaded to arena
 		bool isRenderable();
-		// Check if mesh buffer can be loaded to gPU
+		// Check if mesh has staged data to load to GPU
 		bool isBufferLoadable();
+
+		// Get number of vertices waiting to be loaded to GPU. 0 once buffer is loaded.
+		unsigned int getVertexCount();
+
+		// Get number of indices waiting to be loaded to GPU. 0 once buffer is loaded.
+		unsigned int getStagedIndexCount();
+
+		// Get number of indices.
+		int getIndicesSize() const;
+
+		// Get vertex array object. 0 if buffer isn't loaded.
+		GLuint getVAO() const;
+
+		// Get offset in arena's index buffer. Can change when arena compacts.
+		GLuint getFirstIndex() const;
+
+		// Get offset in arena's vertex buffer. Can change when arena compacts.
+		GLint getBaseVertex() const;
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
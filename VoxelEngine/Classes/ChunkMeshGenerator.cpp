@@ -14,6 +14,15 @@
 
 using namespace Voxel;
 
+Voxel::ChunkMeshGenerator::ChunkMeshGenerator()
+	: blockShadeMode(-1)
+{}
+
+void Voxel::ChunkMeshGenerator::setBlockShadeMode(const int mode)
+{
+	blockShadeMode = mode;
+}
+
 void Voxel::ChunkMeshGenerator::generateChunkMesh(Chunk * chunk, ChunkMap * chunkMap)
 {
 	std::vector<float> vertices;
@@ -26,7 +35,7 @@ void Voxel::ChunkMeshGenerator::generateChunkMesh(Chunk * chunk, ChunkMap * chun
 
 	//auto chunkStart = Utility::Time::now();
 
-	int shadeMode = Setting::getInstance().getBlockShadeMode();
+	int shadeMode = (blockShadeMode < 0) ? Setting::getInstance().getBlockShadeMode() : blockShadeMode;
 
 	// Iterate all chunk sections O(16)
 	int indicesOffsetPerBlock = 0;
@@ -359,7 +368,7 @@ void Voxel::ChunkMeshGenerator::generateChunkMesh(Chunk * chunk, ChunkMap * chun
 	
 
 	//auto bStart = Utility::Time::now();
-	chunk->chunkMesh->initBuffer(vertices, colors, normals, indices);
+	chunk->chunkMesh->initBuffer(vertices, colors, normals, indices, chunkMap->getStagingRing());
 	//auto bEnd = Utility::Time::now();
 	//std::cout << "initBuffer t: " << Utility::Time::toMicroSecondString(bStart, bEnd) << std::endl;
 	// initbuffer takes 30~10 micro seconds
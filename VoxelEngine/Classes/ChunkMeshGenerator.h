@@ -43,6 +43,9 @@ namespace Voxel
 	class ChunkMeshGenerator
 	{
 	private:
+		// Block shade mode to use. -1 reads from Setting.
+		int blockShadeMode;
+
 		/**
 		*	Generate mesh for solid block
 		*	@param [in] worldPosition World position of block.
@@ -51,9 +54,15 @@ namespace Voxel
 		*/
 		//void generateSolidBlockMesh(const glm::vec3& worldPosition, const glm::vec4& color, const Cube::Face faces, int& indicesOffsetPerBlock);
 	public:
-		ChunkMeshGenerator() = default;
+		ChunkMeshGenerator();
 		~ChunkMeshGenerator() = default;
 
+		/**
+		*	Overrides block shade mode from Setting. Tools without Setting (headless benchmark) must set this.
+		*	@param mode 0 = none, 1 = minimum, 2 = maximum. -1 to use Setting.
+		*/
+		void setBlockShadeMode(const int mode);
+
 		// Generates mesh for single chunk
 		void generateChunkMesh(Chunk* chunk, ChunkMap* chunkMap);
 	};
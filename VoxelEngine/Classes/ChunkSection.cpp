@@ -100,6 +100,7 @@ void Voxel::ChunkSection::init(const std::vector<std::vector<int>>& heightMap, c
 					auto newBlock = Block::create(glm::ivec3(blockX, localY, blockZ), position);
 					//newBlock->setColor(color);
 					blocks.at(localBlockXYZToIndex(blockX, localY, blockZ)) = newBlock;
+					occupancyMask.set(localBlockXYZToIndex(blockX, localY, blockZ));
 
 					if ((heightY - blockY) > 2)
 					{
@@ -158,6 +159,7 @@ bool ChunkSection::init(const int x, const int y, const int z, const glm::vec3&
 
 	blocks.clear();
 	blocks.resize(Constant::TOTAL_BLOCKS, nullptr);
+	occupancyMask.reset();
 
 	int yStart = y * Constant::CHUNK_SECTION_HEIGHT;
 	//auto color = Color::getRandomColor();
@@ -186,6 +188,7 @@ bool ChunkSection::init(const int x, const int y, const int z, const glm::vec3&
 					auto newBlock = Block::create(glm::ivec3(blockX, localY, blockZ), position);
 					//newBlock->setColor(color);
 					blocks.at(localBlockXYZToIndex(blockX, localY, blockZ)) = newBlock;
+					occupancyMask.set(localBlockXYZToIndex(blockX, localY, blockZ));
 
 					if (newBlock->getBlockID() != Block::BLOCK_ID::AIR)
 					{
@@ -218,6 +221,7 @@ bool Voxel::ChunkSection::initEmpty(const int x, const int y, const int z, const
 
 	blocks.clear();
 	blocks.resize(Constant::TOTAL_BLOCKS, nullptr);
+	occupancyMask.reset();
 
 	return true;
 }
@@ -273,6 +277,7 @@ void Voxel::ChunkSection::setBlockAt(const int x, const int y, const int z, cons
 			{
 				// Block isn't air
 				blocks.at(index) = Block::create(glm::ivec3(x, y, z), position);
+				occupancyMask.set(index);
 				blocks.at(index)->setBlockID(blockID);
 
 				nonAirBlockSize++;
@@ -287,6 +292,7 @@ void Voxel::ChunkSection::setBlockAt(const int x, const int y, const int z, cons
 				// Remove block
 				delete blocks.at(index);
 				blocks.at(index) = nullptr;
+				occupancyMask.reset(index);
 
 				nonAirBlockSize--;
 			}
@@ -326,6 +332,7 @@ void Voxel::ChunkSection::setBlockAt(const int x, const int y, const int z, cons
 			{
 				// Block isn't air
 				blocks.at(index) = Block::create(glm::ivec3(x, y, z), position);
+				occupancyMask.set(index);
 				blocks.at(index)->setBlockID(blockID);
 				blocks.at(index)->setColorU3(color);
 
@@ -341,6 +348,7 @@ void Voxel::ChunkSection::setBlockAt(const int x, const int y, const int z, cons
 				// Remove block
 				delete blocks.at(index);
 				blocks.at(index) = nullptr;
+				occupancyMask.reset(index);
 
 				nonAirBlockSize--;
 			}
@@ -380,6 +388,7 @@ void Voxel::ChunkSection::setBlockAt(const int x, const int y, const int z, cons
 			{
 				// Block isn't air
 				blocks.at(index) = Block::create(glm::ivec3(x, y, z), position);
+				occupancyMask.set(index);
 				blocks.at(index)->setBlockID(blockID);
 				blocks.at(index)->setColor(color);
 
@@ -395,6 +404,7 @@ void Voxel::ChunkSection::setBlockAt(const int x, const int y, const int z, cons
 				// Remove block
 				delete blocks.at(index);
 				blocks.at(index) = nullptr;
+				occupancyMask.reset(index);
 
 				nonAirBlockSize--;
 			}
@@ -442,6 +452,16 @@ int Voxel::ChunkSection::getLocalTopY(const int localX, const int localZ)
 	return maxY;
 }
 
+bool Voxel::ChunkSection::isBlockOccupied(const int x, const int y, const int z) const
+{
+	if (x < 0 || x >= Constant::CHUNK_SECTION_WIDTH || y < 0 || y >= Constant::CHUNK_SECTION_HEIGHT || z < 0 || z >= Constant::CHUNK_SECTION_LENGTH)
+	{
+		return false;
+	}
+
+	return occupancyMask.test(Math::XYZToBlockIndex(x, y, z));
+}
+
 glm::vec3 Voxel::ChunkSection::getWorldPosition()
 {
 	return worldPosition;
@@ -3,12 +3,14 @@
 
 // cpp
 #include <vector>
+#include <bitset>
 
 // glm
 #include <glm\glm.hpp>
 
 // voxel
 #include "Block.h"
+#include "ChunkUtil.h"
 
 namespace Voxel
 {
@@ -40,6 +42,9 @@ namespace Voxel
 		// 16 x 16 x 16 blocks. TODO: Consider using Octree.
 		std::vector<Block*> blocks;
 
+		// 1 bit per block. Bit is set if block is not air. Same index as blocks. Used for fast queries (raycast, etc) without touching block pointers.
+		std::bitset<Constant::TOTAL_BLOCKS> occupancyMask;
+
 		void init(const std::vector<std::vector<int>>& heightMap, const std::vector<std::vector<float>>& colorMap);
 		bool init(const int x, const int y, const int z, const glm::vec3& chunkPosition, const std::vector<unsigned int>& regionMap, const std::vector<std::vector<int>>& heightMap, const std::vector<std::vector<float>>& colorMap);
 
@@ -63,6 +68,12 @@ namespace Voxel
 
 		int getLocalTopY(const int localX, const int localZ);
 
+		/**
+		*	Check if block at local coordinate is not air. Only reads occupancy mask.
+		*	@return true if block exists and it's not air. False if block is air or coordinate is out of section.
+		*/
+		bool isBlockOccupied(const int x, const int y, const int z) const;
+
 		// Get world position of chunk. Center of chunk.
 		glm::vec3 getWorldPosition();
 
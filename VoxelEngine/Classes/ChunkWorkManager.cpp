@@ -17,6 +17,8 @@
 #include "Color.h"
 #include "HeightMap.h"
 #include "TreeBuilder.h"
+#include "AsyncLogger.h"
+#include "FrameProfiler.h"
 
 using namespace Voxel;
 
@@ -30,6 +32,7 @@ ChunkWorkManager::ChunkWorkManager()
 	running.store(false);
 	firstInitDone.store(false);
 	workState.store(WORK_STATE::IDLE);
+	runningWorkCount.store(0);
 }
 
 void Voxel::ChunkWorkManager::addPreGenerateWork(const glm::ivec2 & coordinate, const bool highPriority)
@@ -46,6 +49,8 @@ void Voxel::ChunkWorkManager::addPreGenerateWork(const glm::ivec2 & coordinate,
 		preGenerateQueue.push_back(coordinate);
 	}
 
+	profiler.onEnqueue(ChunkWorkProfiler::Stage::PRE_GENERATE, coordinate);
+
 	cv.notify_one();
 }
 
@@ -70,6 +75,14 @@ void Voxel::ChunkWorkManager::addPreGenerateWorks(const std::vector<glm::ivec2>&
 		}
 	}
 
+	if (profiler.isEnabled())
+	{
+		for (auto xz : coordinates)
+		{
+			profiler.onEnqueue(ChunkWorkProfiler::Stage::PRE_GENERATE, xz);
+		}
+	}
+
 	//auto end = Utility::Time::now();
 	//std::cout << "addLoad() took: " << Utility::Time::toMilliSecondString(start, end) << std::endl;
 
@@ -90,6 +103,8 @@ void Voxel::ChunkWorkManager::addSmoothWork(const glm::ivec2 & coordinate, const
 		smoothQueue.push_back(coordinate);
 	}
 
+	profiler.onEnqueue(ChunkWorkProfiler::Stage::SMOOTH, coordinate);
+
 	cv.notify_one();
 }
 
@@ -107,6 +122,8 @@ void Voxel::ChunkWorkManager::addStructureWork(const glm::ivec2 & coordinate, co
 		addStructureQueue.push_back(coordinate);
 	}
 
+	profiler.onEnqueue(ChunkWorkProfiler::Stage::ADD_STRUCTURE, coordinate);
+
 	cv.notify_one();
 }
 
@@ -124,6 +141,8 @@ void Voxel::ChunkWorkManager::addGenerateWork(const glm::ivec2 & coordinate, con
 		generateQueue.push_back(coordinate);
 	}
 
+	profiler.onEnqueue(ChunkWorkProfiler::Stage::GENERATE, coordinate);
+
 	cv.notify_one();
 }
 
@@ -148,6 +167,14 @@ void Voxel::ChunkWorkManager::addGenerateWorks(const std::vector<glm::ivec2>& co
 		}
 	}
 
+	if (profiler.isEnabled())
+	{
+		for (auto xz : coordinates)
+		{
+			profiler.onEnqueue(ChunkWorkProfiler::Stage::GENERATE, xz);
+		}
+	}
+
 	//auto end = Utility::Time::now();
 	//std::cout << "addLoad() took: " << Utility::Time::toMilliSecondString(start, end) << std::endl;
 
@@ -168,6 +195,8 @@ void Voxel::ChunkWorkManager::addBuildMeshWork(const glm::ivec2 & coordinate, co
 		buildMeshQueue.push_back(coordinate);
 	}
 
+	profiler.onEnqueue(ChunkWorkProfiler::Stage::BUILD_MESH, coordinate);
+
 	cv.notify_one();
 }
 
@@ -191,6 +220,14 @@ void Voxel::ChunkWorkManager::addBuildMeshWorks(const std::vector<glm::ivec2>& c
 		}
 	}
 
+	if (profiler.isEnabled())
+	{
+		for (auto xz : coordinates)
+		{
+			profiler.onEnqueue(ChunkWorkProfiler::Stage::BUILD_MESH, xz);
+		}
+	}
+
 	cv.notify_one();
 }
 
@@ -208,6 +245,8 @@ void Voxel::ChunkWorkManager::addRefreshWork(const glm::ivec2 & coordinate, cons
 		refreshMeshQueue.push_back(coordinate);
 	}
 
+	profiler.onEnqueue(ChunkWorkProfiler::Stage::REFRESH_MESH, coordinate);
+
 	cv.notify_one();
 }
 
@@ -409,12 +448,33 @@ std::string Voxel::ChunkWorkManager::getDebugOutput()
 		log += "F: " + std::to_string(unloadFinishedQueue.size());
 	}
 
+	if (profiler.isEnabled())
+	{
+		// Average utilization of all threads
+		auto snapshot = profiler.getSnapshot();
+		float utilization = 0.0f;
+
+		for (auto u : snapshot.threadUtilization)
+		{
+			utilization += u;
+		}
+
+		if (!snapshot.threadUtilization.empty())
+		{
+			utilization /= static_cast<float>(snapshot.threadUtilization.size());
+		}
+
+		log += " / U: " + std::to_string(static_cast<int>(utilization * 100.0f)) + "%";
+	}
+
 	return log;
 }
 
 
-void Voxel::ChunkWorkManager::work(ChunkMap* map, ChunkMeshGenerator* meshGenerator, World* world)
+void Voxel::ChunkWorkManager::work(ChunkMap* map, ChunkMeshGenerator* meshGenerator, World* world, const int threadIndex)
 {
+	V_PROFILE_THREAD_NAME("Chunk worker #" + std::to_string(threadIndex));
+
 	// loop while it's running
 	//std::cout << "Thraed #" << std::this_thread::get_id() << " started to build mesh \n";
 	while (running)
@@ -439,7 +499,7 @@ void Voxel::ChunkWorkManager::work(ChunkMap* map, ChunkMeshGenerator* meshGenera
 			// Scope lock
 			std::unique_lock<std::mutex> lock(queueMutex);
 
-			std::cout << "Clearing all the work\n";
+			V_LOG_DEBUG("[ChunkWorkManager] Clearing all the work");
 			
 			// empty all the queue. 
 			preGenerateQueue.clear();
@@ -449,6 +509,8 @@ void Voxel::ChunkWorkManager::work(ChunkMap* map, ChunkMeshGenerator* meshGenera
 			buildMeshQueue.clear();
 			refreshMeshQueue.clear();
 
+			profiler.clearPending();
+
 			workState.store(WORK_STATE::WAITING_MAIN_THREAD);
 		}
 		else if (workState.load() == WORK_STATE::RUNNING)
@@ -480,12 +542,16 @@ void Voxel::ChunkWorkManager::work(ChunkMap* map, ChunkMeshGenerator* meshGenera
 					chunkXZ = preGenerateQueue.front();
 					preGenerateQueue.pop_front();
 					workType = WorkType::PRE_GENERATE;
+
+					profiler.onDequeue(ChunkWorkProfiler::Stage::PRE_GENERATE, chunkXZ, threadIndex);
 				}
 				else if (!smoothQueue.empty())
 				{
 					chunkXZ = smoothQueue.front();
 					smoothQueue.pop_front();
 					workType = WorkType::SMOOTH;
+
+					profiler.onDequeue(ChunkWorkProfiler::Stage::SMOOTH, chunkXZ, threadIndex);
 				}
 				// If there is nothing to pregenerate, generate chunk. (generates blocks)
 				else if (!generateQueue.empty())
@@ -493,12 +559,16 @@ void Voxel::ChunkWorkManager::work(ChunkMap* map, ChunkMeshGenerator* meshGenera
 					chunkXZ = generateQueue.front();
 					generateQueue.pop_front();
 					workType = WorkType::GENERATE;
+
+					profiler.onDequeue(ChunkWorkProfiler::Stage::GENERATE, chunkXZ, threadIndex);
 				}
 				else if (!addStructureQueue.empty())
 				{
 					chunkXZ = addStructureQueue.front();
 					addStructureQueue.pop_front();
 					workType = WorkType::ADD_STRUCTURE;
+
+					profiler.onDequeue(ChunkWorkProfiler::Stage::ADD_STRUCTURE, chunkXZ, threadIndex);
 				}
 				// If there is nothing to generate, start to build mesh
 				else if (!buildMeshQueue.empty())
@@ -506,20 +576,38 @@ void Voxel::ChunkWorkManager::work(ChunkMap* map, ChunkMeshGenerator* meshGenera
 					chunkXZ = buildMeshQueue.front();
 					buildMeshQueue.pop_front();
 					workType = WorkType::BUILD_MESH;
+
+					profiler.onDequeue(ChunkWorkProfiler::Stage::BUILD_MESH, chunkXZ, threadIndex);
 				}
 				else if (!refreshMeshQueue.empty())
 				{
 					chunkXZ = refreshMeshQueue.front();
 					refreshMeshQueue.pop_front();
-					workType = WorkType::BUILD_MESH;
+					workType = WorkType::REFRESH_MESH;
+
+					profiler.onDequeue(ChunkWorkProfiler::Stage::REFRESH_MESH, chunkXZ, threadIndex);
 				}
 				//Else, flag is 0. 
 				else
 				{
 					continue;
 				}
+
+				// Popped under lock, so isIdle() never sees empty queues while this work is pending.
+				runningWorkCount++;
+			}
+
+			// Only read clock while profiling
+			const bool measure = profiler.isEnabled();
+			std::chrono::steady_clock::time_point workStart;
+
+			if (measure)
+			{
+				workStart = Utility::Time::now();
 			}
 
+			// Zone of stage. Shows up in worker's row in frame profiler.
+			V_PROFILE_ZONE(ChunkWorkProfiler::getStageName(toProfilerStage(workType)));
 
 			if (map && meshGenerator)
 			{
@@ -542,7 +630,7 @@ void Voxel::ChunkWorkManager::work(ChunkMap* map, ChunkMeshGenerator* meshGenera
 					// Chunk is valid most of the time to be honest. However, just in case.
 					if (chunk)
 					{
-						//std::cout << "PreGen " << Utility::Log::vec2ToStr(chunkXZ) << "\n";
+						V_LOG_TRACE("[ChunkWorkManager] PreGen {}", chunkXZ);
 
 						// Check if chunk has already pre generated.. 
 						if (chunk->preGenerated.load())
@@ -567,8 +655,8 @@ void Voxel::ChunkWorkManager::work(ChunkMap* map, ChunkMeshGenerator* meshGenera
 							float x = (chunkXZ.x * Constant::CHUNK_BORDER_SIZE);
 							float z = (chunkXZ.y * Constant::CHUNK_BORDER_SIZE);
 
-							// region ID look up table
-							std::unordered_set<unsigned int> regionIDSet;
+							// Terrain of each region in chunk. Out of boundary is -1.
+							std::unordered_map<unsigned int, Terrain> regionTerrains;
 
 							// iterate all blocks in x and z axis
 							for (int i = 0; i < Constant::CHUNK_SECTION_WIDTH; i++)
@@ -578,88 +666,32 @@ void Voxel::ChunkWorkManager::work(ChunkMap* map, ChunkMeshGenerator* meshGenera
 									// get block pos. Add 0.5f because noise returns 0 if input is 0
 									glm::vec2 blockXZPos = glm::vec2(x + 0.5f, z + 0.5f);
 
-									// First, check if block is in boundary
-									bool inBoundary = world->isPointInBoundary(blockXZPos);
-
-									// init region ID
-									unsigned int regionID = -1;
-
-									if (inBoundary)
-									{
-										// Block is in boundary. Find cloest region to block pos
-										unsigned int closestRegionID = world->findClosestRegionToPoint(blockXZPos);
-
-										// get the region
-										auto region = world->getRegion(closestRegionID);
-
-										if (region->isBorder())
-										{
-											// Region is border. Just use closest
-											regionID = closestRegionID;
-										}
-										else
-										{
-											// Check if closest region has block 
-											if (region->isPointIsInRegion(blockXZPos))
-											{
-												// found
-												regionID = closestRegionID;
-											}
-											else
-											{
-												// Nope, check if neighbor regions has block
-												if (region->isPointIsInRegionNeighbor(blockXZPos, regionID))
-												{
-													// found it.
-												}
-												else
-												{
-													// Even neighbor regions doesn't have this block. Can't figure out why, assert false it.
-													assert(false);
-												}
-											}
-										}
-									}
+									// Find region that has block. -1 if block is out of boundary.
+									unsigned int regionID = world->findRegionAtPoint(blockXZPos);
 
 									// convert to index
 									auto index = static_cast<int>(i + (Constant::CHUNK_SECTION_WIDTH * j));
 
-									// This method can't be fail. It will must find closest region unless block is out of boundary
 									regionMap.at(index) = regionID;
 
 									// step z.
 									z += step;
 
-									// Save region id in set. 
-									auto find_it = regionIDSet.find(regionID);
-									if (find_it == regionIDSet.end())
+									// Save terrain of new region
+									if (regionTerrains.find(regionID) == regionTerrains.end())
 									{
-										// New region ID
-										if (inBoundary)
+										if (regionID == -1)
 										{
-											if (regionID == -1)
-											{
-												// Failed to find region
-												assert(false);
-											}
-											else
-											{
-												// block is not out of boundary. 
-												// Get terarin type of region
-												auto terrainType = world->getRegion(regionID)->getTerrainType();
-
-												// Save it
-												map->setRegionTerrainType(regionID, terrainType);
-											}
+											// block is out of boundary
+											regionTerrains.emplace(regionID, Terrain());
 										}
 										else
 										{
-											// block is out of boundary
-											map->setRegionTerrainType(-1, Terrain());
+											// Get terarin type of region
+											Terrain terrainType;
+											world->getRegionTerrainType(regionID, terrainType);
+											regionTerrains.emplace(regionID, terrainType);
 										}
-
-										// Save region ID
-										regionIDSet.emplace(regionID);
 									}
 								}
 
@@ -669,8 +701,7 @@ void Voxel::ChunkWorkManager::work(ChunkMap* map, ChunkMeshGenerator* meshGenera
 							}
 
 							// Generate height map.
-							// Todo: Not sure if we need to store map for region ID and terrain type. Remove it and store locally here.
-							HeightMap::generateHeightMapForChunk(chunk->getPosition(), chunk->heightMap, regionMap, map->getRegionTerrainsMap());
+							HeightMap::generateHeightMapForChunk(chunk->getPosition(), chunk->heightMap, regionMap, regionTerrains);
 
 							// Generate plain height map
 							std::vector<std::vector<int>> plainHeightMap;
@@ -682,7 +713,7 @@ void Voxel::ChunkWorkManager::work(ChunkMap* map, ChunkMeshGenerator* meshGenera
 							// Mark chunk as unsmoothed
 							chunk->smoothed.store(false);
 
-							if (regionIDSet.size() == 1)
+							if (regionTerrains.size() == 1)
 							{
 								// There is only 1 region in this chunk.
 								chunk->setRegionMap(regionMap.front());
@@ -731,7 +762,7 @@ void Voxel::ChunkWorkManager::work(ChunkMap* map, ChunkMeshGenerator* meshGenera
 								// check if chunk has multiple regions.
 								if (chunk->hasMultipleRegion())
 								{
-									//std::cout << "Smooth " << Utility::Log::vec2ToStr(chunkXZ) << "\n";
+									V_LOG_TRACE("[ChunkWorkManager] Smooth {}", chunkXZ);
 
 									// Get nearby chunks
 									std::vector<std::vector<std::shared_ptr<Chunk>>> nearByChunks = map->getNearByChunks(chunkXZ);
@@ -903,7 +934,7 @@ void Voxel::ChunkWorkManager::work(ChunkMap* map, ChunkMeshGenerator* meshGenera
 								}
 								// Else, chunk has already smoothed
 
-								//std::cout << "Gen " << Utility::Log::vec2ToStr(chunkXZ) << "\n";
+								V_LOG_TRACE("[ChunkWorkManager] Gen {}", chunkXZ);
 
 								// Generate chunk sections
 								chunk->generateChunkSections(2, chunk->findMaxY() / Constant::CHUNK_SECTION_HEIGHT);
@@ -936,7 +967,7 @@ void Voxel::ChunkWorkManager::work(ChunkMap* map, ChunkMeshGenerator* meshGenera
 					// Chunk must be valid and is active (Just in case)
 					if (chunk && chunk->isActive())
 					{
-						//std::cout << "AddStructure " << Utility::Log::vec2ToStr(chunkXZ) << "\n";
+						V_LOG_TRACE("[ChunkWorkManager] AddStructure {}", chunkXZ);
 						/*
 							Trick of using random.
 
@@ -960,11 +991,10 @@ void Voxel::ChunkWorkManager::work(ChunkMap* map, ChunkMeshGenerator* meshGenera
 						{
 							// get region id
 							auto regionID = chunk->getFirstRegion();
-							auto region = world->getRegion(regionID);
+							Biome biomeType;
 
-							if (region)
+							if (world->getRegionBiomeType(regionID, biomeType))
 							{
-								auto biomeType = region->getBiomeType();
 
 								// Check if biome can spawn grasses
 								if (biomeType.hasPlants())
@@ -1017,7 +1047,7 @@ void Voxel::ChunkWorkManager::work(ChunkMap* map, ChunkMeshGenerator* meshGenera
 						}
 					}
 				}
-				else if (workType == WorkType::BUILD_MESH)
+				else if (workType == WorkType::BUILD_MESH || workType == WorkType::REFRESH_MESH)
 				{
 					//std::cout << "BuildMesh";
 					//auto s = Utility::Time::now();
@@ -1030,12 +1060,13 @@ void Voxel::ChunkWorkManager::work(ChunkMap* map, ChunkMeshGenerator* meshGenera
 							auto mesh = chunk->getMesh();
 							if (mesh)
 							{
-								//std::cout << "Build mesh " << Utility::Log::vec2ToStr(chunkXZ) << "\n";
+								V_LOG_TRACE("[ChunkWorkManager] Build mesh {}", chunkXZ);
 								// There can be two cases. 
 								// 1. Chunk is newly generated and need mesh.
 								// 2. Chunk already has mesh but need to refresh
 								//auto s = Utility::Time::now();
 								meshGenerator->generateChunkMesh(chunk.get(), map);
+								map->addStagedMesh(chunk);
 								//std::cout << "Done\n";
 								//auto e = Utility::Time::now();
 								//std::cout << "m t: " << Utility::Time::toMilliSecondString(s, e) << std::endl;
@@ -1052,9 +1083,18 @@ void Voxel::ChunkWorkManager::work(ChunkMap* map, ChunkMeshGenerator* meshGenera
 			}
 			else
 			{
+				runningWorkCount--;
 				throw std::runtime_error("Map or chunk mesh generator is nullptr.");
 			}
 
+			if (measure)
+			{
+				profiler.onWorkEnd(toProfilerStage(workType), chunkXZ, threadIndex, workStart, Utility::Time::now());
+			}
+
+			// Next step is already queued, so decrement after.
+			runningWorkCount--;
+
 
 			//std::cout << "Thraed #" << std::this_thread::get_id() << " has (" << ticket.chunkCoordinate.x << ", " << ticket.chunkCoordinate.y << "), Type: " << static_cast<int>(ticket.type) << std::endl;
 
@@ -1091,21 +1131,55 @@ void Voxel::ChunkWorkManager::createThreads(ChunkMap* map, ChunkMeshGenerator* m
 	// Debug. For now, just use 1 thread
 	threadCount = 1;
 
-	std::cout << "[ChunkWorkManager] Spawning " << threadCount << " thread(s)\n";
-	
 	// for now, just use 1 thread. Using more than 1 thread doesn't really improves the loading performance
 	// (I guess because if mutex lock)
+	spawnThreads(map, meshGenerator, world, threadCount);
+}
+
+void Voxel::ChunkWorkManager::spawnThreads(ChunkMap * map, ChunkMeshGenerator * meshGenerator, World * world, const int threadCount)
+{
+	V_LOG_INFO("[ChunkWorkManager] Spawning {} thread(s)", threadCount);
+
 	if (running)
 	{
+		// Slots must exist before threads pop works
+		profiler.setThreadCount(static_cast<int>(workerThreads.size()) + threadCount);
+
 		for (int i = 0; i < threadCount; i++)
 		{
-			workerThreads.push_back(std::thread(&ChunkWorkManager::work, this, map, meshGenerator, world));
+			const int threadIndex = static_cast<int>(workerThreads.size());
+			workerThreads.push_back(std::thread(&ChunkWorkManager::work, this, map, meshGenerator, world, threadIndex));
 		}
 	}
 
 	workState.store(WORK_STATE::RUNNING);
 }
 
+ChunkWorkProfiler::Stage Voxel::ChunkWorkManager::toProfilerStage(const WorkType workType)
+{
+	switch (workType)
+	{
+	case WorkType::PRE_GENERATE:
+		return ChunkWorkProfiler::Stage::PRE_GENERATE;
+	case WorkType::SMOOTH:
+		return ChunkWorkProfiler::Stage::SMOOTH;
+	case WorkType::GENERATE:
+		return ChunkWorkProfiler::Stage::GENERATE;
+	case WorkType::ADD_STRUCTURE:
+		return ChunkWorkProfiler::Stage::ADD_STRUCTURE;
+	case WorkType::REFRESH_MESH:
+		return ChunkWorkProfiler::Stage::REFRESH_MESH;
+	case WorkType::BUILD_MESH:
+	default:
+		return ChunkWorkProfiler::Stage::BUILD_MESH;
+	}
+}
+
+ChunkWorkProfiler * Voxel::ChunkWorkManager::getProfiler()
+{
+	return &profiler;
+}
+
 bool Voxel::ChunkWorkManager::isFirstInitDone()
 {
 	return firstInitDone.load();
@@ -1139,6 +1213,14 @@ bool Voxel::ChunkWorkManager::isGeneratingChunks()
 	return (preGenerateQueue.empty() == false) || (smoothQueue.empty() == false) || (generateQueue.empty() == false) || (addStructureQueue.empty() == false);
 }
 
+bool Voxel::ChunkWorkManager::isIdle()
+{
+	// Scope lock
+	std::unique_lock<std::mutex> lock(queueMutex);
+
+	return isAllWorkQueueEmpty() && runningWorkCount.load() == 0;
+}
+
 void Voxel::ChunkWorkManager::notify()
 {
 	cv.notify_one();
@@ -1166,6 +1248,8 @@ void Voxel::ChunkWorkManager::joinThread()
 		smoothQueue.clear();
 		buildMeshQueue.clear();
 		refreshMeshQueue.clear();
+
+		profiler.clearPending();
 	}
 
 	cv.notify_one();
@@ -1177,11 +1261,13 @@ void Voxel::ChunkWorkManager::joinThread()
 
 	cv.notify_one();
 
-	for (auto& thread : workerThreads)
+	for (unsigned int i = 0; i < workerThreads.size(); i++)
 	{
+		auto& thread = workerThreads.at(i);
+
 		if (thread.joinable())
 		{
-			std::cout << "joining thread #" << thread.get_id() << std::endl;
+			V_LOG_DEBUG("[ChunkWorkManager] Joining thread #{}", i);
 			thread.join();
 		}
 	}
@@ -16,6 +16,7 @@
 
 // voxel
 #include "ChunkUtil.h"
+#include "ChunkWorkProfiler.h"
 
 namespace Voxel
 {
@@ -49,7 +50,8 @@ namespace Voxel
 			SMOOTH,
 			GENERATE,
 			ADD_STRUCTURE,
-			BUILD_MESH
+			BUILD_MESH,
+			REFRESH_MESH
 		};
 
 		enum class WORK_STATE
@@ -97,8 +99,17 @@ namespace Voxel
 		// Condition variable that makes thread to wait if main thread is busy or there is no work to do
 		std::condition_variable cv;
 
+		// Number of works that threads popped from queue and still working on.
+		std::atomic<int> runningWorkCount;
+
+		// Measures works. Disabled by default.
+		ChunkWorkProfiler profiler;
+
 		// For mesh build thread
-		void work(ChunkMap* map, ChunkMeshGenerator* meshGenerator, World* world);
+		void work(ChunkMap* map, ChunkMeshGenerator* meshGenerator, World* world, const int threadIndex);
+
+		// Convert work type to profiler stage
+		static ChunkWorkProfiler::Stage toProfilerStage(const WorkType workType);
 
 		// True if all work queue is empty
 		bool isAllWorkQueueEmpty();
@@ -151,6 +162,15 @@ namespace Voxel
 		// Creates the thread. Make sure you call once after run.
 		void createThreads(ChunkMap* map, ChunkMeshGenerator* meshGenerator, World* world, const int coreCount);
 
+		/**
+		*	Spawns exact number of threads. Make sure you call once after run.
+		*	@param threadCount Number of worker threads to spawn.
+		*/
+		void spawnThreads(ChunkMap* map, ChunkMeshGenerator* meshGenerator, World* world, const int threadCount);
+
+		// Get profiler. Enable it to measure works.
+		ChunkWorkProfiler* getProfiler();
+
 		bool isFirstInitDone();
 
 		// Clear all work order
@@ -168,6 +188,9 @@ namespace Voxel
 		// Check if chunk work manager is generating chunks yet
 		bool isGeneratingChunks();
 
+		// Check if all queues are empty and no thread is working. Locked by queueMutex
+		bool isIdle();
+
 		// notify condition variable
 		void notify();
 
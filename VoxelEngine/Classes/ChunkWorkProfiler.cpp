@@ -0,0 +1,493 @@
+// pch
+#include "PreCompiled.h"
+
+#include "ChunkWorkProfiler.h"
+
+// voxel
+#include "Utility.h"
+
+using namespace Voxel;
+
+const unsigned int ChunkWorkProfiler::MaxTraceEvents = 1 << 18;
+
+Voxel::ChunkWorkProfiler::Histogram::Histogram()
+{
+	clear();
+}
+
+int Voxel::ChunkWorkProfiler::Histogram::toBucketIndex(const unsigned long long microSeconds)
+{
+	if (microSeconds < 4)
+	{
+		return static_cast<int>(microSeconds);
+	}
+
+	// Find highest bit
+	int octave = 2;
+	while ((microSeconds >> (octave + 1)) != 0)
+	{
+		octave++;
+	}
+
+	const int index = 4 + (octave - 2) * 4 + static_cast<int>((microSeconds >> (octave - 2)) & 3);
+
+	return std::min(index, BUCKET_COUNT - 1);
+}
+
+unsigned long long Voxel::ChunkWorkProfiler::Histogram::toBucketUpperBound(const int index)
+{
+	if (index < 4)
+	{
+		return static_cast<unsigned long long>(index);
+	}
+
+	const int octave = (index - 4) / 4 + 2;
+	const unsigned long long sub = static_cast<unsigned long long>((index - 4) % 4);
+
+	return ((4 + sub + 1) << (octave - 2)) - 1;
+}
+
+void Voxel::ChunkWorkProfiler::Histogram::add(const unsigned long long microSeconds)
+{
+	buckets.at(toBucketIndex(microSeconds))++;
+
+	count++;
+	totalMicroSeconds += microSeconds;
+
+	if (microSeconds > maxMicroSeconds)
+	{
+		maxMicroSeconds = microSeconds;
+	}
+}
+
+void Voxel::ChunkWorkProfiler::Histogram::merge(const Histogram & other)
+{
+	for (int i = 0; i < BUCKET_COUNT; i++)
+	{
+		buckets.at(i) += other.buckets.at(i);
+	}
+
+	count += other.count;
+	totalMicroSeconds += other.totalMicroSeconds;
+	maxMicroSeconds = std::max(maxMicroSeconds, other.maxMicroSeconds);
+}
+
+void Voxel::ChunkWorkProfiler::Histogram::clear()
+{
+	buckets.fill(0);
+	count = 0;
+	totalMicroSeconds = 0;
+	maxMicroSeconds = 0;
+}
+
+unsigned long long Voxel::ChunkWorkProfiler::Histogram::getCount() const
+{
+	return count;
+}
+
+unsigned long long Voxel::ChunkWorkProfiler::Histogram::getTotalMicroSeconds() const
+{
+	return totalMicroSeconds;
+}
+
+unsigned long long Voxel::ChunkWorkProfiler::Histogram::getMaxMicroSeconds() const
+{
+	return maxMicroSeconds;
+}
+
+float Voxel::ChunkWorkProfiler::Histogram::getMeanMicroSeconds() const
+{
+	if (count == 0)
+	{
+		return 0.0f;
+	}
+
+	return static_cast<float>(totalMicroSeconds) / static_cast<float>(count);
+}
+
+unsigned long long Voxel::ChunkWorkProfiler::Histogram::getPercentile(const float percentile) const
+{
+	if (count == 0)
+	{
+		return 0;
+	}
+
+	// Number of samples that must be at or below result
+	const unsigned long long target = std::max(1ull, static_cast<unsigned long long>(glm::clamp(percentile, 0.0f, 1.0f) * static_cast<float>(count)));
+
+	unsigned long long sum = 0;
+
+	for (int i = 0; i < BUCKET_COUNT; i++)
+	{
+		sum += buckets.at(i);
+
+		if (sum >= target)
+		{
+			return std::min(toBucketUpperBound(i), maxMicroSeconds);
+		}
+	}
+
+	return maxMicroSeconds;
+}
+
+Voxel::ChunkWorkProfiler::ChunkWorkProfiler()
+{
+	enabled.store(false);
+	traceEnabled.store(false);
+	startTime.store(toNanoSeconds(Utility::Time::now()));
+}
+
+long long Voxel::ChunkWorkProfiler::toNanoSeconds(const std::chrono::steady_clock::time_point & time)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+void Voxel::ChunkWorkProfiler::clearAll()
+{
+	for (auto& slot : threadSlots)
+	{
+		// Scope lock
+		std::unique_lock<std::mutex> lock(slot->slotMutex);
+
+		for (auto& histogram : slot->durations)
+		{
+			histogram.clear();
+		}
+
+		for (auto& histogram : slot->queueWaits)
+		{
+			histogram.clear();
+		}
+
+		slot->chunkLatency.clear();
+		slot->busyMicroSeconds = 0;
+		slot->workCount = 0;
+		slot->traceEvents.clear();
+		slot->buildingChunk = false;
+	}
+
+	// Times that are still queued are older than this, so they are ignored when popped.
+	startTime.store(toNanoSeconds(Utility::Time::now()));
+}
+
+ChunkWorkProfiler::ThreadSlot * Voxel::ChunkWorkProfiler::getThreadSlot(const int threadIndex)
+{
+	if (threadIndex >= 0 && threadIndex < static_cast<int>(threadSlots.size()))
+	{
+		return threadSlots.at(threadIndex).get();
+	}
+
+	return nullptr;
+}
+
+void Voxel::ChunkWorkProfiler::setEnabled(const bool enabled)
+{
+	if (enabled && !this->enabled.load())
+	{
+		clearAll();
+	}
+
+	this->enabled.store(enabled);
+}
+
+bool Voxel::ChunkWorkProfiler::isEnabled() const
+{
+	return enabled.load(std::memory_order_relaxed);
+}
+
+void Voxel::ChunkWorkProfiler::setTraceEnabled(const bool enabled)
+{
+	traceEnabled.store(enabled);
+}
+
+bool Voxel::ChunkWorkProfiler::isTraceEnabled() const
+{
+	return traceEnabled.load(std::memory_order_relaxed);
+}
+
+void Voxel::ChunkWorkProfiler::reset()
+{
+	clearAll();
+}
+
+void Voxel::ChunkWorkProfiler::setThreadCount(const int threadCount)
+{
+	while (static_cast<int>(threadSlots.size()) < threadCount)
+	{
+		threadSlots.push_back(std::unique_ptr<ThreadSlot>(new ThreadSlot()));
+		threadSlots.back()->busyMicroSeconds = 0;
+		threadSlots.back()->workCount = 0;
+		threadSlots.back()->buildingChunk = false;
+	}
+}
+
+void Voxel::ChunkWorkProfiler::clearPending()
+{
+	for (auto& times : enqueueTimes)
+	{
+		times.clear();
+	}
+
+	chunkStartTimes.clear();
+}
+
+void Voxel::ChunkWorkProfiler::onEnqueue(const Stage stage, const glm::ivec2 & chunkXZ)
+{
+	if (!isEnabled()) return;
+
+	auto now = Utility::Time::now();
+
+	// If same chunk is already in queue, keep the older time
+	enqueueTimes.at(static_cast<int>(stage)).emplace(chunkXZ, now);
+
+	if (stage == Stage::PRE_GENERATE)
+	{
+		chunkStartTimes.emplace(chunkXZ, now);
+	}
+}
+
+void Voxel::ChunkWorkProfiler::onDequeue(const Stage stage, const glm::ivec2 & chunkXZ, const int threadIndex)
+{
+	if (!isEnabled()) return;
+
+	auto slot = getThreadSlot(threadIndex);
+
+	if (slot == nullptr)
+	{
+		return;
+	}
+
+	auto now = Utility::Time::now();
+	const long long start = startTime.load();
+
+	auto& times = enqueueTimes.at(static_cast<int>(stage));
+	auto find_it = times.find(chunkXZ);
+
+	// Scope lock. Only contended while snapshot is taken.
+	std::unique_lock<std::mutex> lock(slot->slotMutex);
+
+	if (find_it != times.end())
+	{
+		// Chunk queued before profiler was enabled or reset isn't counted
+		if (toNanoSeconds(find_it->second) >= start)
+		{
+			slot->queueWaits.at(static_cast<int>(stage)).add(static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::microseconds>(now - find_it->second).count()));
+		}
+
+		times.erase(find_it);
+	}
+
+	if (stage == Stage::BUILD_MESH)
+	{
+		slot->buildingChunk = false;
+
+		auto start_it = chunkStartTimes.find(chunkXZ);
+
+		if (start_it != chunkStartTimes.end())
+		{
+			if (toNanoSeconds(start_it->second) >= start)
+			{
+				// Latency is added when thread finishes mesh
+				slot->buildingChunkStart = start_it->second;
+				slot->buildingChunk = true;
+			}
+
+			chunkStartTimes.erase(start_it);
+		}
+	}
+}
+
+void Voxel::ChunkWorkProfiler::onWorkEnd(const Stage stage, const glm::ivec2 & chunkXZ, const int threadIndex, const std::chrono::steady_clock::time_point & start, const std::chrono::steady_clock::time_point & end)
+{
+	if (!isEnabled()) return;
+
+	auto slot = getThreadSlot(threadIndex);
+
+	if (slot == nullptr)
+	{
+		return;
+	}
+
+	const unsigned long long duration = static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+	const long long startMicroSeconds = (toNanoSeconds(start) - startTime.load()) / 1000;
+
+	// Scope lock. Only contended while snapshot is taken.
+	std::unique_lock<std::mutex> lock(slot->slotMutex);
+
+	slot->durations.at(static_cast<int>(stage)).add(duration);
+	slot->busyMicroSeconds += duration;
+	slot->workCount++;
+
+	if (stage == Stage::BUILD_MESH && slot->buildingChunk)
+	{
+		slot->chunkLatency.add(static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::microseconds>(end - slot->buildingChunkStart).count()));
+		slot->buildingChunk = false;
+	}
+
+	if (isTraceEnabled() && slot->traceEvents.size() < MaxTraceEvents)
+	{
+		TraceEvent e;
+		e.stage = stage;
+		e.threadIndex = threadIndex;
+		e.chunkXZ = chunkXZ;
+		e.startMicroSeconds = startMicroSeconds;
+		e.durationMicroSeconds = static_cast<long long>(duration);
+
+		slot->traceEvents.push_back(e);
+	}
+}
+
+ChunkWorkProfiler::Snapshot Voxel::ChunkWorkProfiler::getSnapshot()
+{
+	Snapshot snapshot;
+
+	const long long elapsed = toNanoSeconds(Utility::Time::now()) - startTime.load();
+	snapshot.elapsedSeconds = static_cast<float>(elapsed) / 1000000000.0f;
+
+	for (auto& slot : threadSlots)
+	{
+		// Scope lock
+		std::unique_lock<std::mutex> lock(slot->slotMutex);
+
+		for (int i = 0; i < STAGE_COUNT; i++)
+		{
+			snapshot.durations.at(i).merge(slot->durations.at(i));
+			snapshot.queueWaits.at(i).merge(slot->queueWaits.at(i));
+		}
+
+		snapshot.chunkLatency.merge(slot->chunkLatency);
+
+		snapshot.threadUtilization.push_back(elapsed > 0 ? static_cast<float>(slot->busyMicroSeconds) / (static_cast<float>(elapsed) / 1000.0f) : 0.0f);
+		snapshot.threadWorkCount.push_back(slot->workCount);
+	}
+
+	return snapshot;
+}
+
+std::vector<std::string> Voxel::ChunkWorkProfiler::getSummary()
+{
+	std::vector<std::string> lines;
+
+	if (!isEnabled())
+	{
+		lines.push_back("Chunk work profiler is disabled");
+		return lines;
+	}
+
+	auto snapshot = getSnapshot();
+
+	std::stringstream ss;
+	ss << std::fixed << std::setprecision(2) << "elapsed: " << snapshot.elapsedSeconds << "s";
+	lines.push_back(ss.str());
+
+	for (int i = 0; i < STAGE_COUNT; i++)
+	{
+		auto& duration = snapshot.durations.at(i);
+		auto& wait = snapshot.queueWaits.at(i);
+
+		if (duration.getCount() == 0 && wait.getCount() == 0)
+		{
+			continue;
+		}
+
+		ss.str("");
+		ss << stageToString(static_cast<Stage>(i))
+			<< " n: " << duration.getCount()
+			<< " mean: " << static_cast<int>(duration.getMeanMicroSeconds()) << "us"
+			<< " p50: " << duration.getPercentile(0.5f) << "us"
+			<< " p99: " << duration.getPercentile(0.99f) << "us"
+			<< " max: " << duration.getMaxMicroSeconds() << "us"
+			<< " / wait p50: " << wait.getPercentile(0.5f) << "us"
+			<< " p99: " << wait.getPercentile(0.99f) << "us";
+		lines.push_back(ss.str());
+	}
+
+	ss.str("");
+	ss << "chunk latency n: " << snapshot.chunkLatency.getCount()
+		<< " p50: " << (snapshot.chunkLatency.getPercentile(0.5f) / 1000) << "ms"
+		<< " p99: " << (snapshot.chunkLatency.getPercentile(0.99f) / 1000) << "ms"
+		<< " max: " << (snapshot.chunkLatency.getMaxMicroSeconds() / 1000) << "ms";
+	lines.push_back(ss.str());
+
+	ss.str("");
+	ss << "threads:";
+	for (unsigned int i = 0; i < snapshot.threadUtilization.size(); i++)
+	{
+		ss << " #" << i << " " << static_cast<int>(snapshot.threadUtilization.at(i) * 100.0f) << "% (" << snapshot.threadWorkCount.at(i) << ")";
+	}
+	lines.push_back(ss.str());
+
+	return lines;
+}
+
+bool Voxel::ChunkWorkProfiler::exportChromeTrace(const std::string & path)
+{
+	std::vector<TraceEvent> events;
+
+	for (auto& slot : threadSlots)
+	{
+		// Scope lock. Copy so writing file doesn't block worker threads.
+		std::unique_lock<std::mutex> lock(slot->slotMutex);
+		events.insert(events.end(), slot->traceEvents.begin(), slot->traceEvents.end());
+	}
+
+	std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	// Complete events ("ph": "X"). Each worker thread is a row.
+	file << "{\"traceEvents\":[\n";
+
+	for (unsigned int i = 0; i < events.size(); i++)
+	{
+		auto& e = events.at(i);
+
+		file << "{\"name\":\"" << stageToString(e.stage) << "\",\"cat\":\"chunk\",\"ph\":\"X\""
+			<< ",\"ts\":" << e.startMicroSeconds
+			<< ",\"dur\":" << e.durationMicroSeconds
+			<< ",\"pid\":0,\"tid\":" << e.threadIndex
+			<< ",\"args\":{\"x\":" << e.chunkXZ.x << ",\"z\":" << e.chunkXZ.y << "}}";
+
+		if (i + 1 < events.size())
+		{
+			file << ",";
+		}
+
+		file << "\n";
+	}
+
+	file << "],\"displayTimeUnit\":\"ms\"}\n";
+
+	file.close();
+
+	return true;
+}
+
+const char * Voxel::ChunkWorkProfiler::getStageName(const Stage stage)
+{
+	switch (stage)
+	{
+	case Stage::PRE_GENERATE:
+		return "PRE_GENERATE";
+	case Stage::SMOOTH:
+		return "SMOOTH";
+	case Stage::GENERATE:
+		return "GENERATE";
+	case Stage::ADD_STRUCTURE:
+		return "ADD_STRUCTURE";
+	case Stage::BUILD_MESH:
+		return "BUILD_MESH";
+	case Stage::REFRESH_MESH:
+		return "REFRESH_MESH";
+	default:
+		return "UNKNOWN";
+	}
+}
+
+std::string Voxel::ChunkWorkProfiler::stageToString(const Stage stage)
+{
+	return getStageName(stage);
+}
@@ -0,0 +1,228 @@
+#ifndef CHUNK_WORK_PROFILER_H
+#define CHUNK_WORK_PROFILER_H
+
+// cpp
+#include <array>
+#include <vector>
+#include <memory>
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+
+// glm
+#include <glm\glm.hpp>
+
+// voxel
+#include "ChunkUtil.h"
+
+namespace Voxel
+{
+	/**
+	*	@class ChunkWorkProfiler
+	*	@brief Measures works in ChunkWorkManager.
+	*
+	*	Records duration of each stage, time that chunk waited in queue, busy time of each worker thread
+	*	and end to end latency of chunk (from first PRE_GENERATE queue to BUILD_MESH finish).
+	*	Optionally records every work as event and exports to Chrome trace json (chrome://tracing).
+	*	Works are also recorded by FrameProfiler as zones named by getStageName() when it's compiled in.
+	*
+	*	Disabled by default. While disabled, every call returns after single atomic load.
+	*	Queue bookkeeping (onEnqueue, onDequeue, clearPending) must be called while holding ChunkWorkManager's queueMutex,
+	*	so chunk is stamped before any worker can pop it and profiler adds no lock of its own to queues.
+	*	Each worker thread adds measurements to its own slot, which is only contended while snapshot is taken.
+	*/
+	class ChunkWorkProfiler
+	{
+	public:
+		enum class Stage
+		{
+			PRE_GENERATE = 0,
+			SMOOTH,
+			GENERATE,
+			ADD_STRUCTURE,
+			BUILD_MESH,
+			REFRESH_MESH,
+			COUNT
+		};
+
+		static const int STAGE_COUNT = static_cast<int>(Stage::COUNT);
+
+		/**
+		*	@class Histogram
+		*	@brief Histogram of durations in micro seconds.
+		*
+		*	0 ~ 3 us have own bucket. Above that, each power of 2 range is split in 4 buckets,
+		*	so percentile is within 25% of real value. Covers up to 2^26 us (67 seconds).
+		*/
+		class Histogram
+		{
+		public:
+			static const int BUCKET_COUNT = 4 + (26 - 2) * 4;
+		private:
+			std::array<unsigned long long, BUCKET_COUNT> buckets;
+			unsigned long long count;
+			unsigned long long totalMicroSeconds;
+			unsigned long long maxMicroSeconds;
+
+			// Get bucket index for duration
+			static int toBucketIndex(const unsigned long long microSeconds);
+			// Get largest duration that falls in bucket
+			static unsigned long long toBucketUpperBound(const int index);
+		public:
+			Histogram();
+
+			void add(const unsigned long long microSeconds);
+			// Add all samples of other histogram
+			void merge(const Histogram& other);
+			void clear();
+
+			unsigned long long getCount() const;
+			unsigned long long getTotalMicroSeconds() const;
+			unsigned long long getMaxMicroSeconds() const;
+			float getMeanMicroSeconds() const;
+
+			/**
+			*	Get estimated percentile.
+			*	@param percentile Value between 0 and 1.
+			*	@return Upper bound of bucket that percentile falls. Clamped to max.
+			*/
+			unsigned long long getPercentile(const float percentile) const;
+		};
+
+		// Copy of all measurements at certain time.
+		struct Snapshot
+		{
+			// Time spent on work. Indexed by Stage
+			std::array<Histogram, STAGE_COUNT> durations;
+			// Time spent in queue before thread pops it. Indexed by Stage
+			std::array<Histogram, STAGE_COUNT> queueWaits;
+			// Time from first PRE_GENERATE queue to BUILD_MESH finish
+			Histogram chunkLatency;
+			// Busy time / elapsed time of each worker thread. 0 ~ 1
+			std::vector<float> threadUtilization;
+			// Number of works each thread did
+			std::vector<unsigned long long> threadWorkCount;
+			// Time since enabled or reset
+			float elapsedSeconds;
+		};
+	private:
+		// Single work. Only recorded while trace is enabled.
+		struct TraceEvent
+		{
+			Stage stage;
+			int threadIndex;
+			glm::ivec2 chunkXZ;
+			// Relative to startTime
+			long long startMicroSeconds;
+			long long durationMicroSeconds;
+		};
+
+		// Max number of trace events per thread. Older events are kept, new events are dropped once full.
+		static const unsigned int MaxTraceEvents;
+
+		// Measurements of single worker thread
+		struct ThreadSlot
+		{
+			// Locked by owner thread and snapshot
+			std::mutex slotMutex;
+
+			std::array<Histogram, STAGE_COUNT> durations;
+			std::array<Histogram, STAGE_COUNT> queueWaits;
+			Histogram chunkLatency;
+
+			unsigned long long busyMicroSeconds;
+			unsigned long long workCount;
+
+			std::vector<TraceEvent> traceEvents;
+
+			// Start time of chunk that thread is building mesh for. Set when BUILD_MESH is popped.
+			std::chrono::steady_clock::time_point buildingChunkStart;
+			bool buildingChunk;
+		};
+
+		// True if recording
+		std::atomic<bool> enabled;
+		// True if recording trace event. Only works while enabled.
+		std::atomic<bool> traceEnabled;
+
+		// Time when profiler was enabled or reset. Nano seconds of steady clock. Queued times before this are ignored.
+		std::atomic<long long> startTime;
+
+		// Slot of each worker thread. Indexed by thread index. Only resized before threads are spawned.
+		std::vector<std::unique_ptr<ThreadSlot>> threadSlots;
+
+		// Time when chunk was added to each queue. Removed when popped. Guarded by queueMutex.
+		std::array<std::unordered_map<glm::ivec2, std::chrono::steady_clock::time_point, KeyFuncs, KeyFuncs>, STAGE_COUNT> enqueueTimes;
+
+		// Time when chunk was first added to PRE_GENERATE queue. Removed when BUILD_MESH is popped. Guarded by queueMutex.
+		std::unordered_map<glm::ivec2, std::chrono::steady_clock::time_point, KeyFuncs, KeyFuncs> chunkStartTimes;
+
+		// Clears all thread slots and restarts elapsed time
+		void clearAll();
+
+		// Get slot of worker thread. nullptr if index is out of range.
+		ThreadSlot* getThreadSlot(const int threadIndex);
+
+		// Convert steady clock time to nano seconds
+		static long long toNanoSeconds(const std::chrono::steady_clock::time_point& time);
+	public:
+		ChunkWorkProfiler();
+		~ChunkWorkProfiler() = default;
+
+		// Enable or disable. Enabling clears previous measurements.
+		void setEnabled(const bool enabled);
+		bool isEnabled() const;
+
+		// Enable or disable trace event recording.
+		void setTraceEnabled(const bool enabled);
+		bool isTraceEnabled() const;
+
+		// Clears all measurements and restarts elapsed time.
+		void reset();
+
+		// Set number of worker threads. Call before threads are spawned.
+		void setThreadCount(const int threadCount);
+
+		// Drops all queued times. Call when work queues are cleared. Must hold queueMutex.
+		void clearPending();
+
+		// Call when chunk is added to stage's queue. Must hold queueMutex.
+		void onEnqueue(const Stage stage, const glm::ivec2& chunkXZ);
+
+		// Call when worker thread pops chunk from stage's queue. Must hold queueMutex.
+		void onDequeue(const Stage stage, const glm::ivec2& chunkXZ, const int threadIndex);
+
+		/**
+		*	Call when worker thread finished work. Adds chunk latency if stage is BUILD_MESH.
+		*	@param stage Stage of work.
+		*	@param chunkXZ Chunk coordinate.
+		*	@param threadIndex Index of worker thread.
+		*	@param start Time when work started.
+		*	@param end Time when work ended.
+		*/
+		void onWorkEnd(const Stage stage, const glm::ivec2& chunkXZ, const int threadIndex, const std::chrono::steady_clock::time_point& start, const std::chrono::steady_clock::time_point& end);
+
+		// Copy current measurements
+		Snapshot getSnapshot();
+
+		// Get multi line summary of current measurements.
+		std::vector<std::string> getSummary();
+
+		/**
+		*	Export recorded trace events to Chrome trace json.
+		*	@param path Path of json file.
+		*	@return true if file was written.
+		*/
+		bool exportChromeTrace(const std::string& path);
+
+		// Get name of stage as string literal. Used as FrameProfiler zone name.
+		static const char* getStageName(const Stage stage);
+
+		// Get name of stage
+		static std::string stageToString(const Stage stage);
+	};
+}
+
+#endif
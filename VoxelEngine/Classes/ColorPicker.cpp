@@ -413,7 +413,7 @@ bool Voxel::UI::ColorPicker::updateMouseMove(const glm::vec2 & mousePosition, co
 			auto rit = children.rbegin();
 			for (; rit != children.rend();)
 			{
-				bool result = (rit->second)->updateMouseMove(mousePosition, mouseDelta);
+				bool result = (rit->second)->updateMouseMoveCulled(mousePosition, mouseDelta);
 				if (result)
 				{
 					// child hovered
@@ -433,7 +433,7 @@ bool Voxel::UI::ColorPicker::updateMouseMove(const glm::vec2 & mousePosition, co
 
 				for (; rit != children.rend(); rit++)
 				{
-					(rit->second)->updateMouseMoveFalse();
+					(rit->second)->updateMouseMoveFalseCulled();
 				}
 
 				updateMouseMoveFalse();
@@ -581,8 +581,8 @@ void Voxel::UI::ColorPicker::renderSelf()
 	if (palleteProgram == nullptr) return;
 
 	palleteProgram->use(true);
-	palleteProgram->setUniformMat4("modelMat", glm::scale(modelMat, glm::vec3(scale, 1)));
-	palleteProgram->setUniformVec4("palleteColor", palleteColor);
+	palleteProgram->setUniformMat4(SID("modelMat"), glm::scale(modelMat, glm::vec3(scale, 1)));
+	palleteProgram->setUniformVec4(SID("palleteColor"), palleteColor);
 
 	if (palleteVao)
 	{
@@ -594,9 +594,9 @@ void Voxel::UI::ColorPicker::renderSelf()
 	if (program == nullptr) return;
 
 	program->use(true);
-	program->setUniformMat4("modelMat", glm::scale(iconModelMat, glm::vec3(scale, 1)));
-	program->setUniformFloat("opacity", opacity);
-	program->setUniformVec3("color", iconColor);
+	program->setUniformMat4(SID("modelMat"), glm::scale(iconModelMat, glm::vec3(scale, 1)));
+	program->setUniformFloat(SID("opacity"), opacity);
+	program->setUniformVec3(SID("color"), iconColor);
 
 	texture->activate(GL_TEXTURE0);
 	texture->bind();
@@ -15,6 +15,30 @@
 #define V_BUILD_NUMBER 1
 #endif
 
+/**
+*	@def V_FONT_DISK_CACHE
+*	If enabled, preloaded font atlas and glyph metrics are saved to user directory and loaded on next launch without FreeType.
+*/
+#ifndef V_FONT_DISK_CACHE
+#define V_FONT_DISK_CACHE 1
+#endif
+
+/**
+*	@def V_UI_BATCH
+*	If enabled, canvas batches ui that shares same texture in to single draw call.
+*/
+#ifndef V_UI_BATCH
+#define V_UI_BATCH 1
+#endif
+
+/**
+*	@def V_PROFILER
+*	If enabled, V_PROFILE_* macros record scoped zones for FrameProfiler. Recording is off until enabled at run time.
+*/
+#ifndef V_PROFILER
+#define V_PROFILER 1
+#endif
+
 /**
 *	@def V_DEBUG
 *	If enabled, all sub debug defines will be applied. 
@@ -250,4 +274,17 @@
 #endif
 // Sub debug defiens ends. V_DEBUG
 
+/**
+*	@def V_LOG_LEVEL
+*	Minimum level of V_LOG_* macros. Logs below this level are compiled out.
+*	0: trace, 1: debug, 2: info, 3: warn, 4: error, 5: off
+*/
+#ifndef V_LOG_LEVEL
+#if V_DEBUG
+#define V_LOG_LEVEL 1
+#else
+#define V_LOG_LEVEL 2
+#endif
+#endif
+
 #endif	// CONFIG_H
\ No newline at end of file
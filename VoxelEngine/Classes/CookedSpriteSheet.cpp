@@ -0,0 +1,465 @@
+// pch
+#include "PreCompiled.h"
+
+#include "CookedSpriteSheet.h"
+
+// cpp
+#include <cstring>
+
+// voxel
+#include "FileSystem.h"
+#include "Utility.h"
+
+using namespace Voxel;
+
+const std::string Voxel::CookedSpriteSheet::FILE_EXTENSION = ".vss";
+const unsigned int Voxel::CookedSpriteSheet::MAGIC = 0x42535356;	// 'VSSB'
+const unsigned int Voxel::CookedSpriteSheet::VERSION = 1;
+const unsigned int Voxel::CookedSpriteSheet::PIXEL_ALIGNMENT = 16;
+
+static_assert(sizeof(CookedSpriteSheet::Header) == 60, "Cooked sprite sheet header must be packed");
+static_assert(sizeof(CookedSpriteSheet::Entry) == 40, "Cooked sprite sheet entry must be packed");
+
+Voxel::CookedSpriteSheet::CookedSpriteSheet()
+	: file(INVALID_HANDLE_VALUE)
+	, mapping(nullptr)
+	, view(nullptr)
+	, size(0)
+	, header(nullptr)
+{}
+
+Voxel::CookedSpriteSheet::~CookedSpriteSheet()
+{
+	if (view)
+	{
+		UnmapViewOfFile(view);
+	}
+
+	if (mapping)
+	{
+		CloseHandle(mapping);
+	}
+
+	if (file != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(file);
+	}
+}
+
+CookedSpriteSheet * Voxel::CookedSpriteSheet::open(const std::string & filePath)
+{
+	auto newCSS = new CookedSpriteSheet();
+
+	if (newCSS->init(filePath))
+	{
+		return newCSS;
+	}
+
+	delete newCSS;
+	return nullptr;
+}
+
+CookedSpriteSheet * Voxel::CookedSpriteSheet::openForDataFile(const std::string & dataFileName)
+{
+	auto& fs = FileSystem::getInstance();
+
+	const std::string cookedFilePath = getCookedFilePath(dataFileName);
+
+	if (!fs.isRegularFile(cookedFilePath))
+	{
+		return nullptr;
+	}
+
+	// TexturePacker writes json and png together, so json's time is enough to check if cooked file is stale.
+	const std::string dataFilePath = fs.getWorkingDirectory() + "/spritesheets/" + dataFileName;
+
+	if (fs.getLastWriteTime(cookedFilePath) < fs.getLastWriteTime(dataFilePath))
+	{
+		return nullptr;
+	}
+
+	return open(cookedFilePath);
+}
+
+std::string Voxel::CookedSpriteSheet::getCookedFilePath(const std::string & dataFileName)
+{
+	return FileSystem::getInstance().getWorkingDirectory() + "/spritesheets/" + Utility::String::removeFileExtFromFileName(dataFileName) + FILE_EXTENSION;
+}
+
+bool Voxel::CookedSpriteSheet::init(const std::string & filePath)
+{
+	file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(Header)))
+	{
+		return false;
+	}
+
+	size = static_cast<unsigned long long>(fileSize.QuadPart);
+
+	mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (mapping == nullptr)
+	{
+		return false;
+	}
+
+	view = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+
+	if (view == nullptr)
+	{
+		return false;
+	}
+
+	header = reinterpret_cast<const Header*>(view);
+
+	if (header->magic != MAGIC || header->version != VERSION || header->pixelFormat != PixelFormat::RAW)
+	{
+		return false;
+	}
+
+	const unsigned long long entryCount = header->entryCount;
+
+	// Check all sections are in file
+	if (header->displacementOffset + entryCount * sizeof(int) > size
+		|| header->entryOffset + entryCount * sizeof(Entry) > size
+		|| static_cast<unsigned long long>(header->nameOffset) + header->nameSize > size
+		|| static_cast<unsigned long long>(header->textureNameOffset) + header->textureNameLength > header->nameSize
+		|| static_cast<unsigned long long>(header->pixelOffset) + header->pixelSize > size
+		|| static_cast<unsigned long long>(header->width) * header->height * header->channel != header->pixelSize)
+	{
+		return false;
+	}
+
+	auto entries = getEntries();
+
+	for (unsigned int i = 0; i < header->entryCount; i++)
+	{
+		if (static_cast<unsigned long long>(entries[i].nameOffset) + entries[i].nameLength > header->nameSize)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+unsigned long long Voxel::CookedSpriteSheet::write(const std::string & filePath, const SpriteSheet::Data & data, const Texture2D::DecodedImage & image)
+{
+	if (image.data == nullptr || image.width == 0 || image.height == 0 || image.channel == 0)
+	{
+		return 0;
+	}
+
+	std::vector<std::string> keys;
+	keys.reserve(data.frames.size());
+
+	for (auto& frame : data.frames)
+	{
+		keys.push_back(frame.imageName);
+	}
+
+	std::vector<int> displacements;
+	std::vector<unsigned int> slots;
+
+	if (!buildPerfectHash(keys, displacements, slots))
+	{
+		return 0;
+	}
+
+	const unsigned int entryCount = static_cast<unsigned int>(data.frames.size());
+
+	// Names. Texture name first, then entry names in frame order
+	std::string names = data.textureName;
+
+	const float textureWidth = static_cast<float>(image.width);
+	const float textureHeight = static_cast<float>(image.height);
+
+	std::vector<Entry> entries(entryCount);
+
+	for (unsigned int i = 0; i < entryCount; i++)
+	{
+		auto& frame = data.frames.at(i);
+		auto& entry = entries.at(slots.at(i));
+
+		entry.nameOffset = static_cast<unsigned int>(names.size());
+		entry.nameLength = static_cast<unsigned int>(frame.imageName.size());
+		entry.x = frame.position.x;
+		entry.y = frame.position.y;
+		entry.width = frame.width;
+		entry.height = frame.height;
+
+		// Same as SpriteSheet::initImageEntries. Texture's y is flipped when it's read by stb_image.
+		entry.uvOriginX = entry.x / textureWidth;
+		entry.uvOriginY = (entry.y + entry.height) / textureHeight;
+		entry.uvEndX = (entry.x + entry.width) / textureWidth;
+		entry.uvEndY = entry.y / textureHeight;
+
+		names += frame.imageName;
+	}
+
+	Header header;
+	header.magic = MAGIC;
+	header.version = VERSION;
+	header.width = static_cast<unsigned int>(image.width);
+	header.height = static_cast<unsigned int>(image.height);
+	header.channel = static_cast<unsigned int>(image.channel);
+	header.pixelFormat = PixelFormat::RAW;
+	header.entryCount = entryCount;
+	header.displacementOffset = sizeof(Header);
+	header.entryOffset = header.displacementOffset + entryCount * sizeof(int);
+	header.nameOffset = header.entryOffset + entryCount * sizeof(Entry);
+	header.nameSize = static_cast<unsigned int>(names.size());
+	header.textureNameOffset = 0;
+	header.textureNameLength = static_cast<unsigned int>(data.textureName.size());
+	header.pixelOffset = (header.nameOffset + header.nameSize + PIXEL_ALIGNMENT - 1) / PIXEL_ALIGNMENT * PIXEL_ALIGNMENT;
+	header.pixelSize = header.width * header.height * header.channel;
+
+	std::ofstream ofs(filePath, std::ios::binary | std::ios::trunc);
+
+	if (!ofs.is_open())
+	{
+		return 0;
+	}
+
+	const std::vector<char> padding(header.pixelOffset - (header.nameOffset + header.nameSize), 0);
+
+	ofs.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+	ofs.write(reinterpret_cast<const char*>(displacements.data()), entryCount * sizeof(int));
+	ofs.write(reinterpret_cast<const char*>(entries.data()), entryCount * sizeof(Entry));
+	ofs.write(names.data(), names.size());
+	ofs.write(padding.data(), padding.size());
+	ofs.write(reinterpret_cast<const char*>(image.data), header.pixelSize);
+
+	if (!ofs.good())
+	{
+		return 0;
+	}
+
+	return static_cast<unsigned long long>(header.pixelOffset) + header.pixelSize;
+}
+
+unsigned int Voxel::CookedSpriteSheet::hash(const char * str, const unsigned int length, const unsigned int seed)
+{
+	unsigned int h = 2166136261u ^ (seed * 0x9E3779B9u);
+
+	for (unsigned int i = 0; i < length; i++)
+	{
+		h ^= static_cast<unsigned char>(str[i]);
+		h *= 16777619u;
+	}
+
+	// Final mix. FNV alone has poor low bits for short keys
+	h ^= h >> 16;
+	h *= 0x85EBCA6Bu;
+	h ^= h >> 13;
+	h *= 0xC2B2AE35u;
+	h ^= h >> 16;
+
+	return h;
+}
+
+bool Voxel::CookedSpriteSheet::buildPerfectHash(const std::vector<std::string>& keys, std::vector<int>& displacements, std::vector<unsigned int>& slots)
+{
+	const unsigned int count = static_cast<unsigned int>(keys.size());
+
+	displacements.assign(count, 0);
+	slots.assign(count, 0);
+
+	if (count == 0)
+	{
+		return true;
+	}
+
+	// Group keys by bucket
+	std::vector<std::vector<unsigned int>> buckets(count);
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		auto& key = keys.at(i);
+		buckets.at(hash(key.c_str(), static_cast<unsigned int>(key.size()), 0) % count).push_back(i);
+	}
+
+	// Largest bucket first. It's hardest to place.
+	std::vector<unsigned int> order(count);
+	for (unsigned int i = 0; i < count; i++)
+	{
+		order.at(i) = i;
+	}
+
+	std::stable_sort(order.begin(), order.end(), [&buckets](const unsigned int a, const unsigned int b) { return buckets.at(a).size() > buckets.at(b).size(); });
+
+	std::vector<bool> used(count, false);
+
+	// Max seed to try per bucket before giving up
+	const unsigned int maxSeed = 1u << 24;
+
+	auto it = order.begin();
+
+	for (; it != order.end() && buckets.at(*it).size() > 1; ++it)
+	{
+		auto& bucket = buckets.at(*it);
+
+		std::vector<unsigned int> bucketSlots;
+		bucketSlots.reserve(bucket.size());
+
+		unsigned int seed = 1;
+
+		for (; seed < maxSeed; seed++)
+		{
+			bucketSlots.clear();
+
+			bool fit = true;
+
+			for (auto keyIndex : bucket)
+			{
+				auto& key = keys.at(keyIndex);
+				unsigned int slot = hash(key.c_str(), static_cast<unsigned int>(key.size()), seed) % count;
+
+				if (used.at(slot) || std::find(bucketSlots.begin(), bucketSlots.end(), slot) != bucketSlots.end())
+				{
+					fit = false;
+					break;
+				}
+
+				bucketSlots.push_back(slot);
+			}
+
+			if (fit)
+			{
+				break;
+			}
+		}
+
+		if (seed == maxSeed)
+		{
+			// Duplicated keys
+			return false;
+		}
+
+		displacements.at(*it) = static_cast<int>(seed);
+
+		for (unsigned int i = 0; i < bucket.size(); i++)
+		{
+			used.at(bucketSlots.at(i)) = true;
+			slots.at(bucket.at(i)) = bucketSlots.at(i);
+		}
+	}
+
+	// Single key buckets take free slots directly
+	unsigned int freeSlot = 0;
+
+	for (; it != order.end() && buckets.at(*it).size() == 1; ++it)
+	{
+		while (used.at(freeSlot))
+		{
+			freeSlot++;
+		}
+
+		used.at(freeSlot) = true;
+
+		displacements.at(*it) = -static_cast<int>(freeSlot) - 1;
+		slots.at(buckets.at(*it).front()) = freeSlot;
+	}
+
+	// Rest of buckets are empty and keeps 0.
+
+	return true;
+}
+
+unsigned int Voxel::CookedSpriteSheet::findSlot(const int * displacements, const unsigned int count, const char * key, const unsigned int length)
+{
+	if (count == 0)
+	{
+		return count;
+	}
+
+	const int displacement = displacements[hash(key, length, 0) % count];
+
+	if (displacement < 0)
+	{
+		return static_cast<unsigned int>(-displacement - 1);
+	}
+	else
+	{
+		return hash(key, length, static_cast<unsigned int>(displacement)) % count;
+	}
+}
+
+std::string Voxel::CookedSpriteSheet::getTextureName() const
+{
+	return std::string(reinterpret_cast<const char*>(view + header->nameOffset + header->textureNameOffset), header->textureNameLength);
+}
+
+void Voxel::CookedSpriteSheet::getImage(Texture2D::DecodedImage & image) const
+{
+	// Texture2D doesn't write to image data.
+	image.data = const_cast<unsigned char*>(view + header->pixelOffset);
+	image.width = static_cast<int>(header->width);
+	image.height = static_cast<int>(header->height);
+	image.channel = static_cast<int>(header->channel);
+	image.ownsData = false;
+}
+
+void Voxel::CookedSpriteSheet::prefetch() const
+{
+	SYSTEM_INFO systemInfo;
+	GetSystemInfo(&systemInfo);
+
+	const unsigned long long pageSize = static_cast<unsigned long long>(systemInfo.dwPageSize);
+
+	// Reading single byte faults whole page in. Volatile so read isn't optimized out.
+	volatile unsigned char sink = 0;
+
+	for (unsigned long long offset = 0; offset < size; offset += pageSize)
+	{
+		sink ^= view[offset];
+	}
+
+	(void)sink;
+}
+
+unsigned int Voxel::CookedSpriteSheet::getEntryCount() const
+{
+	return header->entryCount;
+}
+
+const int * Voxel::CookedSpriteSheet::getDisplacements() const
+{
+	return reinterpret_cast<const int*>(view + header->displacementOffset);
+}
+
+const CookedSpriteSheet::Entry * Voxel::CookedSpriteSheet::getEntries() const
+{
+	return reinterpret_cast<const Entry*>(view + header->entryOffset);
+}
+
+std::string Voxel::CookedSpriteSheet::getEntryName(const Entry & entry) const
+{
+	return std::string(reinterpret_cast<const char*>(view + header->nameOffset + entry.nameOffset), entry.nameLength);
+}
+
+const CookedSpriteSheet::Entry * Voxel::CookedSpriteSheet::findEntry(const std::string & name) const
+{
+	const unsigned int slot = findSlot(getDisplacements(), header->entryCount, name.c_str(), static_cast<unsigned int>(name.size()));
+
+	if (slot >= header->entryCount)
+	{
+		return nullptr;
+	}
+
+	auto entry = getEntries() + slot;
+
+	if (entry->nameLength == name.size() && std::memcmp(view + header->nameOffset + entry->nameOffset, name.c_str(), name.size()) == 0)
+	{
+		return entry;
+	}
+
+	return nullptr;
+}
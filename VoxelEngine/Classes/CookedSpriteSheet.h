@@ -0,0 +1,193 @@
+#ifndef COOKED_SPRITE_SHEET_H
+#define COOKED_SPRITE_SHEET_H
+
+// cpp
+#include <string>
+#include <vector>
+
+// voxel
+#include "SpriteSheet.h"
+#include "Texture2D.h"
+
+namespace Voxel
+{
+	/**
+	*	@class CookedSpriteSheet
+	*	@brief Sprite sheet that is cooked offline to single binary file. File is memory mapped and read in place.
+	*
+	*	Cooked file (.vss) has header, perfect hash displacement table, entries in hash slot order, entry names and
+	*	pixels that are already decoded. Loading doesn't parse json or decode png, so it's bound by file read.
+	*	Pixels are uploaded straight from mapped memory.
+	*
+	*	Layout. All values are 32 bit little endian.
+	*	[Header][int displacement * entryCount][Entry * entryCount][names][padding][pixels]
+	*
+	*	Cooked by SpriteSheetCooker (--cook-sprite-sheets). Json and png stays as source.
+	*	Cooked file is ignored if it's older than json, so stale file falls back to json and png.
+	*/
+	class CookedSpriteSheet
+	{
+	public:
+		// File extention of cooked sprite sheet
+		static const std::string FILE_EXTENSION;
+
+		// Magic number. 'VSSB'
+		static const unsigned int MAGIC;
+
+		// Format version. Increase when layout changes.
+		static const unsigned int VERSION;
+
+		// Alignment of pixel data in file
+		static const unsigned int PIXEL_ALIGNMENT;
+
+		// Format of pixel data.
+		enum class PixelFormat : unsigned int
+		{
+			RAW = 0,			// 8 bit per channel. Same as Texture2D::decodeImage
+			// Block compressed formats will be added here
+		};
+
+		struct Header
+		{
+		public:
+			unsigned int magic;
+			unsigned int version;
+			// texture
+			unsigned int width;
+			unsigned int height;
+			unsigned int channel;
+			PixelFormat pixelFormat;
+			// entries
+			unsigned int entryCount;
+			unsigned int displacementOffset;
+			unsigned int entryOffset;
+			unsigned int nameOffset;
+			unsigned int nameSize;
+			// Texture name is in names
+			unsigned int textureNameOffset;
+			unsigned int textureNameLength;
+			// pixels
+			unsigned int pixelOffset;
+			unsigned int pixelSize;
+		};
+
+		// Image entry. UV is computed by cooker.
+		struct Entry
+		{
+		public:
+			// Offset from start of names
+			unsigned int nameOffset;
+			unsigned int nameLength;
+			float x;
+			float y;
+			float width;
+			float height;
+			float uvOriginX;
+			float uvOriginY;
+			float uvEndX;
+			float uvEndY;
+		};
+	private:
+		// Constructor
+		CookedSpriteSheet();
+
+		// win32 file and mapping handle
+		void* file;
+		void* mapping;
+
+		// Mapped file
+		const unsigned char* view;
+		unsigned long long size;
+
+		// Header in mapped file
+		const Header* header;
+
+		// Map file and validate header
+		bool init(const std::string& filePath);
+	public:
+		// Destructor. Unmaps file
+		~CookedSpriteSheet();
+
+		// Delete copy
+		CookedSpriteSheet(CookedSpriteSheet const&) = delete;
+		CookedSpriteSheet& operator=(CookedSpriteSheet const&) = delete;
+
+		/**
+		*	Map cooked file.
+		*	@param filePath Full path of cooked file.
+		*	@return Cooked sprite sheet if file is valid. Else, nullptr.
+		*/
+		static CookedSpriteSheet* open(const std::string& filePath);
+
+		/**
+		*	Map cooked file of sprite sheet data file if it exists and isn't older than data file. Thread safe.
+		*	@param dataFileName Json file name in sprite sheet directory.
+		*	@return Cooked sprite sheet if it's up to date. Else, nullptr.
+		*/
+		static CookedSpriteSheet* openForDataFile(const std::string& dataFileName);
+
+		// Get full path of cooked file for json file name in sprite sheet directory
+		static std::string getCookedFilePath(const std::string& dataFileName);
+
+		/**
+		*	Write cooked file.
+		*	@param filePath Full path of cooked file.
+		*	@param data Parsed sprite sheet data.
+		*	@param image Decoded sprite sheet texture.
+		*	@return Number of bytes written. 0 if failed.
+		*/
+		static unsigned long long write(const std::string& filePath, const SpriteSheet::Data& data, const Texture2D::DecodedImage& image);
+
+		// Hash for perfect hash. FNV-1a with seed and final mix
+		static unsigned int hash(const char* str, const unsigned int length, const unsigned int seed);
+
+		/**
+		*	Build minimal perfect hash (hash and displace) for keys.
+		*	Key is hashed with seed 0 to find bucket. Bucket stores seed to hash its keys to free slots,
+		*	or -(slot + 1) if bucket has single key.
+		*	@param keys Unique keys.
+		*	@param displacements Displacement of each bucket. Same size as keys.
+		*	@param slots Slot of each key.
+		*	@return true if hash is built.
+		*/
+		static bool buildPerfectHash(const std::vector<std::string>& keys, std::vector<int>& displacements, std::vector<unsigned int>& slots);
+
+		/**
+		*	Find slot of key. Key might not be in table, so caller must compare key in slot.
+		*	@param displacements Displacement table built by buildPerfectHash.
+		*	@param count Number of keys.
+		*	@return Slot. count if table is empty.
+		*/
+		static unsigned int findSlot(const int* displacements, const unsigned int count, const char* key, const unsigned int length);
+
+		// Get texture file name
+		std::string getTextureName() const;
+
+		// Set image to pixels in mapped file. Image doesn't own pixels, so this must outlive image.
+		void getImage(Texture2D::DecodedImage& image) const;
+
+		/**
+		*	Read every page of mapped file, so it's in memory before it's used.
+		*	Mapping doesn't read file. Without this, first read of pixels (texture upload on main thread) waits for disk.
+		*	Call on loading thread.
+		*/
+		void prefetch() const;
+
+		// Get number of entries
+		unsigned int getEntryCount() const;
+
+		// Get displacement table
+		const int* getDisplacements() const;
+
+		// Get entries in slot order
+		const Entry* getEntries() const;
+
+		// Get name of entry
+		std::string getEntryName(const Entry& entry) const;
+
+		// Find entry by name. nullptr if doesn't exist.
+		const Entry* findEntry(const std::string& name) const;
+	};
+}
+
+#endif
@@ -26,7 +26,7 @@ Voxel::Cursor::~Cursor()
 bool Voxel::Cursor::init()
 {
 	// Initialize cursors
-	auto ss = SpriteSheetManager::getInstance().getSpriteSheetByKey("CursorSpriteSheet");
+	auto ss = SpriteSheetManager::getInstance().getSpriteSheetByKey(SID("CursorSpriteSheet"));
 
 	// pointer
 	this->texture = ss->getTexture();
@@ -162,7 +162,7 @@ void Voxel::Cursor::updateBoundary()
 
 void Voxel::Cursor::setCursorType(const CursorType cursorType)
 {
-	auto ss = SpriteSheetManager::getInstance().getSpriteSheetByKey("CursorSpriteSheet");
+	auto ss = SpriteSheetManager::getInstance().getSpriteSheetByKey(SID("CursorSpriteSheet"));
 
 	const ImageEntry* imageEntry = nullptr;
 
@@ -222,10 +222,10 @@ void Voxel::Cursor::render()
 			auto program = ProgramManager::getInstance().getProgram(ProgramManager::PROGRAM_NAME::UI_TEXTURE_SHADER);
 
 			program->use(true);
-			program->setUniformMat4("projMat", Camera::mainCamera->getProjection(Camera::UIFovy));
-			program->setUniformMat4("modelMat", glm::translate(glm::translate(Camera::mainCamera->getScreenSpaceMatrix(), glm::vec3(position.x, position.y, 0)), glm::vec3(-pivot.x * size.x, -pivot.y * size.y, 0)));
-			program->setUniformFloat("opacity", 1.0f);
-			program->setUniformVec3("color", glm::vec3(1.0f));
+			program->setUniformMat4(SID("projMat"), Camera::mainCamera->getProjection(Camera::UIFovy));
+			program->setUniformMat4(SID("modelMat"), glm::translate(glm::translate(Camera::mainCamera->getScreenSpaceMatrix(), glm::vec3(position.x, position.y, 0)), glm::vec3(-pivot.x * size.x, -pivot.y * size.y, 0)));
+			program->setUniformFloat(SID("opacity"), 1.0f);
+			program->setUniformVec3(SID("color"), glm::vec3(1.0f));
 
 			texture->activate(GL_TEXTURE0);
 			texture->bind();
@@ -3,13 +3,29 @@
 
 #include "DataTree.h"
 
+// cpp
+#include <cstring>
+#include <cerrno>
+
 // voxel
 #include "Config.h"
 #include "Logger.h"
+#include "FileSystem.h"
 
 using namespace Voxel;
 
-std::unordered_map<std::string, bool> DataTree::boolAliases = {
+const std::string DataTree::COMPILED_FILE_EXTENSION = ".vdt";
+const unsigned int DataTree::INVALID_NODE = 0xFFFFFFFF;
+// "VDT1"
+const unsigned int DataTree::MAGIC = 0x31544456;
+const unsigned int DataTree::VERSION = 1;
+
+// Aliases for bool type
+static const struct
+{
+	const char* alias;
+	bool value;
+} boolAliases[] = {
 	{"yes", true},
 	{"no", false},
 	{"y", true},
@@ -20,8 +36,32 @@ std::unordered_map<std::string, bool> DataTree::boolAliases = {
 
 char DataTree::commentSymbol = '#';
 
-DataTree::DataTree(const std::string& key, const std::string& value) : key(key), value(value)
-{}
+// Space and tab. New line ends line.
+static inline bool isIndent(const char c)
+{
+	return c == ' ' || c == '\t';
+}
+
+static inline bool isNewLineChar(const char c)
+{
+	// We are ignoring CR+LF here. CR is empty line.
+	return c == '\n' || c == '\r';
+}
+
+DataTree::DataTree()
+{
+	Node root;
+	root.keyOffset = 0;
+	root.keyLength = 0;
+	root.valueOffset = 0;
+	root.valueLength = 0;
+	root.firstChild = INVALID_NODE;
+	root.lastChild = INVALID_NODE;
+	root.nextSibling = INVALID_NODE;
+	root.childCount = 0;
+
+	nodes.push_back(root);
+}
 
 DataTree::~DataTree()
 {
@@ -30,7 +70,7 @@ DataTree::~DataTree()
 
 DataTree* DataTree::create()
 {
-	return new DataTree(std::string(), std::string());
+	return new DataTree();
 }
 
 DataTree* DataTree::create(const std::string& fileName)
@@ -40,27 +80,38 @@ DataTree* DataTree::create(const std::string& fileName)
 		return nullptr;
 	}
 
-	std::string fileData = std::string();
-	std::ifstream file(fileName);
+	auto& fs = FileSystem::getInstance();
+
+	// Compiled file. Text file can be missing if only compiled file is shipped.
+	const std::string compiledFilePath = getCompiledFilePath(fileName);
 
-	if (file.is_open())
+	if (fs.isRegularFile(compiledFilePath) && fs.getLastWriteTime(compiledFilePath) >= fs.getLastWriteTime(fileName))
 	{
-		// Simply using while loop and getline to read file instead of using file size method because file size wasn't correct.
-		std::string line;
-		while (std::getline(file, line))
+		DataTree* data = createFromCompiled(compiledFilePath);
+
+		if (data)
 		{
-			fileData += (line + "\n");
+			return data;
 		}
-		
+
+		// Broken or old version. Use text file.
+	}
+
+	std::vector<char> fileData;
+
+	if (readFile(fileName, fileData))
+	{
 		// check data
-		if (fileData.empty() || fileData.size() <= 0)
+		if (fileData.empty())
 		{
 			//Data is empty or size is 0. 
 			return nullptr;
 		}
 
-		DataTree* data = new DataTree("ROOT_KEY", "ROOT_VALUE");
-		bool result = data->parse(fileData);
+		DataTree* data = new DataTree();
+		data->buffer.swap(fileData);
+
+		bool result = data->parse();
 
 		if (result == false)
 		{
@@ -69,8 +120,6 @@ DataTree* DataTree::create(const std::string& fileName)
 			return nullptr;
 		}
 
-		file.close();
-
 		return data;
 	}
 	else
@@ -79,345 +128,445 @@ DataTree* DataTree::create(const std::string& fileName)
 		auto logger = &Voxel::Logger::getInstance();
 		logger->consoleInfo("[DataTree] Failed to open file \"" + fileName + "\"");
 		logger->consoleInfo("[DataTree] Creating new one.");
+#endif
 
 		std::ofstream newFile(fileName, std::fstream::out);
 		newFile.close();
 
-		DataTree* data = new DataTree("ROOT_KEY", "ROOT_VALUE");
-
 		// nothing to fill
+		return new DataTree();
+	}
+}
 
-		return data;
-#endif
+DataTree * Voxel::DataTree::createFromData(const char * data, const unsigned int size)
+{
+	if (data == nullptr || size == 0)
+	{
+		return nullptr;
 	}
+
+	DataTree* dataTree = new DataTree();
+	dataTree->buffer.assign(data, data + size);
+
+	if (dataTree->parse() == false)
+	{
+		delete dataTree;
+		return nullptr;
+	}
+
+	return dataTree;
 }
 
-bool DataTree::parse(const std::string& fileData)
+DataTree * Voxel::DataTree::createFromCompiled(const std::string & compiledFilePath)
 {
-	// check one more time just because
-	if (fileData.empty())
+	std::vector<char> compiledData;
+
+	if (!readFile(compiledFilePath, compiledData))
 	{
-		return false;
+		return nullptr;
+	}
+
+	DataTree* data = new DataTree();
+
+	if (data->loadCompiled(compiledData) == false)
+	{
+		delete data;
+		return nullptr;
 	}
 
-	// Parse data
-	int startingIndex = 0;
-	return this->parseData(fileData, startingIndex, -1);
+	return data;
 }
 
-bool DataTree::parseData(const std::string& fileData, int& curIndex, int curDepth)
+bool Voxel::DataTree::readFile(const std::string & filePath, std::vector<char>& data)
 {
-	// Success flag
-	bool success = true;
+	// Binary mode. Text mode converts CR+LF, which made file size wrong.
+	std::ifstream file(filePath, std::ios::binary | std::ios::ate);
 
-	// Return if current index is bigger than file size
-	if (curIndex >= fileData.size()) { return true; }
+	if (!file.is_open())
+	{
+		return false;
+	}
 
-	// Get index where next line starts
-	int nextLineIndex = this->findNewLineIndex(fileData, curIndex) + 1;
+	const std::streamoff size = file.tellg();
 
-	// Return if next line index is current index
-	if (nextLineIndex == curIndex){ return true; }
+	if (size < 0)
+	{
+		return false;
+	}
+
+	data.resize(static_cast<size_t>(size));
+
+	if (size > 0)
+	{
+		file.seekg(0, std::ios::beg);
+		file.read(data.data(), size);
+
+		if (file.gcount() != size)
+		{
+			return false;
+		}
+	}
 
-	// Find hwere comment index starts
-	int commentIndex = findCommentSymbolOrNewLineIndex(fileData, curIndex);
-	// Find the first index where non whitespace starts
-	int nonWhiteSpaceIndex = findFirstNonWhitespaceIndex(fileData, curIndex);
+	return true;
+}
 
-	// If comment index is before the first non whitesapce character, the entire line is comment
-	if (commentIndex <= nonWhiteSpaceIndex)
+bool DataTree::parse()
+{
+	// check one more time just because
+	if (buffer.empty())
 	{
-		// Skip to next line
-		curIndex = nextLineIndex;
-		return parseData(fileData, curIndex, curDepth);
+		return false;
 	}
-	
-	// If current line isn't comment, parse it.
-	int parsingDepth = getCurrentDepth(fileData, curIndex);
-	// Get the size of data
-	const int size = fileData.size();
 
-	//Key and Value
-	std::string newKey;
-	std::string newValue;
+	const unsigned int size = static_cast<unsigned int>(buffer.size());
+	const char* data = buffer.data();
+
+	// Depth and node of lines that can be parent of next line. Root is shallower than any line.
+	std::vector<std::pair<int, unsigned int>> parents;
+	parents.reserve(16);
+	parents.push_back(std::make_pair(-1, 0));
+
+	unsigned int lineStart = 0;
 
-	// Check depth
-	if (parsingDepth > curDepth)
+	while (lineStart < size)
 	{
-		// Parsing dpeth is deeper than current depth. So advance.
-		curDepth = parsingDepth;
+		unsigned int lineEnd = lineStart;
 
-		// Run while recursion ends with same depth
-		while (curDepth <= parsingDepth)
+		while (lineEnd < size && !isNewLineChar(data[lineEnd]))
 		{
-			// Get index where next line starts
-			nextLineIndex = findNewLineIndex(fileData, curIndex) + 1;
-			// Parse the key
-			newKey = parseKey(fileData, size, parsingDepth + curIndex, nextLineIndex, curIndex);
+			lineEnd++;
+		}
+
+		// Depth is number of indent characters before key
+		unsigned int keyStart = lineStart;
+
+		while (keyStart < lineEnd && isIndent(data[keyStart]))
+		{
+			keyStart++;
+		}
+
+		// Skip empty line and comment line
+		if (keyStart < lineEnd && data[keyStart] != commentSymbol)
+		{
+			unsigned int keyEnd = keyStart;
+
+			while (keyEnd < lineEnd && !isIndent(data[keyEnd]) && data[keyEnd] != commentSymbol)
+			{
+				keyEnd++;
+			}
+
+			// Value is rest of the line until comment. Trimmed.
+			unsigned int valueStart = keyEnd;
 
-			// Only if key is valid
-			if (newKey.size() > 0 && newKey.empty() == false)
+			while (valueStart < lineEnd && isIndent(data[valueStart]))
 			{
-				// Parse value
-				newValue = parseValue(fileData, size, curIndex);
+				valueStart++;
 			}
 
-			// Add new key and value to children.
-			this->children[newKey] = new DataTree(newKey, newValue);
-			// Advance current index to next line
-			curIndex = nextLineIndex;
-			// Recursively parse data on new child
-			success = this->children[newKey]->parseData(fileData, curIndex, parsingDepth);
+			unsigned int valueEnd = valueStart;
 
-			// Update parsing depth
-			parsingDepth = getCurrentDepth(fileData, curIndex);
+			while (valueEnd < lineEnd && data[valueEnd] != commentSymbol)
+			{
+				valueEnd++;
+			}
+
+			while (valueEnd > valueStart && isIndent(data[valueEnd - 1]))
+			{
+				valueEnd--;
+			}
+
+			const int depth = static_cast<int>(keyStart - lineStart);
+
+			while (parents.back().first >= depth)
+			{
+				parents.pop_back();
+			}
+
+			const unsigned int node = addChild(parents.back().second, keyStart, keyEnd - keyStart, valueStart, valueEnd - valueStart);
+
+			parents.push_back(std::make_pair(depth, node));
 		}
+
+		lineStart = lineEnd + 1;
 	}
 
-	// Really no point of using bool as return. Used for debugging.
-	return success;
+	return true;
 }
 
-const std::string DataTree::parseKey(const std::string& fileData, const int size, const int start, const int end, int& curIndex)
+bool Voxel::DataTree::loadCompiled(const std::vector<char>& data)
 {
-	// Parsing depth is on same level with current dpeth. 
-	// Start from index after depth
-	// If starting pos is larger than next line index, skip
-	std::string newKey = std::string();
-	if (start < end)
+	if (data.size() < sizeof(CompiledHeader))
 	{
-		// Ignore whitespace after dpeth
-		curIndex = findWhitespace(fileData, start + 1);
-		newKey = fileData.substr(start, curIndex < size ? curIndex - start : std::string::npos);
+		return false;
 	}
 
-	return newKey;
-}
+	CompiledHeader header;
+	std::memcpy(&header, data.data(), sizeof(CompiledHeader));
 
-const std::string DataTree::parseValue(const std::string& fileData, const int size, int& curIndex)
-{
-	// Advance till we find valid character as key
-	curIndex = findFirstNonWhitespaceIndex(fileData, curIndex);
-	// End is until we hind comment or new line
-	const int end = findCommentSymbolOrNewLineIndex(fileData, curIndex);
-
-	std::string newValue = std::string();
-
-	if (curIndex < size && end > curIndex)
+	if (header.magic != MAGIC || header.version != VERSION || header.nodeCount == 0)
 	{
-		newValue = fileData.substr(curIndex, end - curIndex);
+		return false;
 	}
-	else
+
+	const size_t nodesSize = static_cast<size_t>(header.nodeCount) * sizeof(Node);
+
+	if (data.size() != sizeof(CompiledHeader) + nodesSize + header.bufferSize)
 	{
-		newValue = std::string();
+		return false;
 	}
 
-	return trim(newValue);
-}
+	nodes.resize(header.nodeCount);
+	std::memcpy(nodes.data(), data.data() + sizeof(CompiledHeader), nodesSize);
 
-int DataTree::findNewLineIndex(const std::string& fileData, int curIndex)
-{
-	// Get size of data
-	size_t dataSize = fileData.size();
-	unsigned int i = 0;
-	// Loop until it finds new line char
-	for (i = curIndex; i < dataSize && !isNewLineChar(fileData[i]); i++)
+	buffer.assign(data.begin() + sizeof(CompiledHeader) + nodesSize, data.end());
+
+	// Validate, so broken file can't read out of range
+	for (auto& node : nodes)
 	{
-		if (isNewLineChar(fileData[i]))
+		if (static_cast<unsigned long long>(node.keyOffset) + node.keyLength > header.bufferSize
+			|| static_cast<unsigned long long>(node.valueOffset) + node.valueLength > header.bufferSize)
 		{
-			return i;
+			return false;
+		}
+
+		if ((node.firstChild != INVALID_NODE && node.firstChild >= header.nodeCount)
+			|| (node.lastChild != INVALID_NODE && node.lastChild >= header.nodeCount)
+			|| (node.nextSibling != INVALID_NODE && node.nextSibling >= header.nodeCount))
+		{
+			return false;
 		}
 	}
 
-	return i;
+	return true;
 }
 
-bool DataTree::isNewLineChar(const char& c)
+bool Voxel::DataTree::compile(const std::string & fileName, const std::string & compiledFileName)
 {
-	// We are ignoring CR+LF here. 
-	if (c == '\n' || c == '\r')
+	std::vector<char> fileData;
+
+	if (!readFile(fileName, fileData) || fileData.empty())
 	{
-		return true;
+		return false;
 	}
-	else
+
+	DataTree dataTree;
+	dataTree.buffer.swap(fileData);
+
+	if (!dataTree.parse())
+	{
+		return false;
+	}
+
+	// Copy only keys and values. Drops comments and indents.
+	std::vector<Node> compiledNodes = dataTree.nodes;
+	std::vector<char> compiledBuffer;
+	compiledBuffer.reserve(dataTree.buffer.size());
+
+	for (auto& node : compiledNodes)
+	{
+		const unsigned int keyOffset = static_cast<unsigned int>(compiledBuffer.size());
+		compiledBuffer.insert(compiledBuffer.end(), dataTree.buffer.begin() + node.keyOffset, dataTree.buffer.begin() + node.keyOffset + node.keyLength);
+		node.keyOffset = keyOffset;
+
+		const unsigned int valueOffset = static_cast<unsigned int>(compiledBuffer.size());
+		compiledBuffer.insert(compiledBuffer.end(), dataTree.buffer.begin() + node.valueOffset, dataTree.buffer.begin() + node.valueOffset + node.valueLength);
+		node.valueOffset = valueOffset;
+	}
+
+	CompiledHeader header;
+	header.magic = MAGIC;
+	header.version = VERSION;
+	header.nodeCount = static_cast<unsigned int>(compiledNodes.size());
+	header.bufferSize = static_cast<unsigned int>(compiledBuffer.size());
+
+	std::ofstream out(compiledFileName.empty() ? getCompiledFilePath(fileName) : compiledFileName, std::ios::binary | std::ios::trunc);
+
+	if (!out.is_open())
 	{
 		return false;
 	}
+
+	out.write(reinterpret_cast<const char*>(&header), sizeof(CompiledHeader));
+	out.write(reinterpret_cast<const char*>(compiledNodes.data()), compiledNodes.size() * sizeof(Node));
+	out.write(compiledBuffer.data(), compiledBuffer.size());
+
+	return out.good();
 }
 
-bool DataTree::isWhitespace(const char& c)
+std::string Voxel::DataTree::getCompiledFilePath(const std::string & fileName)
 {
-	// Consider space, tab, newline as whitespace
-	return (c == ' ' || c == '\t' || c == '\n' || c == '\r');
+	return fileName + COMPILED_FILE_EXTENSION;
 }
 
-int DataTree::findCommentSymbolOrNewLineIndex(const std::string& fileData, int curIndex)
+unsigned int Voxel::DataTree::addChild(const unsigned int parent, const unsigned int keyOffset, const unsigned int keyLength, const unsigned int valueOffset, const unsigned int valueLength)
 {
-	// start from current index
-	unsigned int i = curIndex;
-	// stop at newline
-	unsigned int end = findNewLineIndex(fileData, curIndex);
+	const unsigned int existing = findChild(parent, boost::string_view(buffer.data() + keyOffset, keyLength));
 
-	while (i < end)
+	if (existing != INVALID_NODE)
 	{
-		if (fileData[i] == DataTree::commentSymbol)
-		{
-			break;
-		}
+		// Same key again. Replaces previous one.
+		auto& node = nodes.at(existing);
+		node.valueOffset = valueOffset;
+		node.valueLength = valueLength;
+		node.firstChild = INVALID_NODE;
+		node.lastChild = INVALID_NODE;
+		node.childCount = 0;
 
-		i++;
+		return existing;
 	}
 
-	return i;
-}
+	Node node;
+	node.keyOffset = keyOffset;
+	node.keyLength = keyLength;
+	node.valueOffset = valueOffset;
+	node.valueLength = valueLength;
+	node.firstChild = INVALID_NODE;
+	node.lastChild = INVALID_NODE;
+	node.nextSibling = INVALID_NODE;
+	node.childCount = 0;
 
-int DataTree::findFirstNonWhitespaceIndex(const std::string& fileData, int curIndex)
-{
-	// start from current index
-	unsigned int i = curIndex;
-	// end of file
-	size_t size = fileData.size();
+	const unsigned int index = static_cast<unsigned int>(nodes.size());
+	nodes.push_back(node);
 
-	// Because newline considered as newline, iterate til end
-	for (; i < size; i++)
-	{
-		bool whitespace = isWhitespace(fileData[i]);
-		bool newLine = isNewLineChar(fileData[i]);
+	auto& parentNode = nodes.at(parent);
 
-		if (whitespace && !newLine)
-		{
-			continue;
-		}
-		else
-		{
-			break;
-		}
+	if (parentNode.lastChild == INVALID_NODE)
+	{
+		parentNode.firstChild = index;
+	}
+	else
+	{
+		nodes.at(parentNode.lastChild).nextSibling = index;
 	}
 
-	return i;
+	parentNode.lastChild = index;
+	parentNode.childCount++;
+
+	return index;
 }
 
-int DataTree::getCurrentDepth(const std::string& fileData, int curIndex)
+unsigned int Voxel::DataTree::findChild(const unsigned int parent, const boost::string_view & key) const
 {
-	unsigned int i = curIndex;
-	size_t size = fileData.size();
-
-	int counter = 0;
-
-	for (; i < size; i++)
+	for (unsigned int child = nodes[parent].firstChild; child != INVALID_NODE; child = nodes[child].nextSibling)
 	{
-		bool whitespace = isWhitespace(fileData[i]);
-
-		if (!whitespace)
+		if (getKeyView(child) == key)
 		{
-			// Depth identation ends. Get diff
-			return i - curIndex;
+			return child;
 		}
 	}
 
-	// Wasn't able to find any depth. 
-	return -1;
+	return INVALID_NODE;
 }
 
-int DataTree::findWhitespace(const std::string& fileData, int curIndex)
+unsigned int Voxel::DataTree::findNode(const std::string & key) const
 {
-	unsigned int i = curIndex;
-	size_t size = fileData.size();
+	if (key.empty())
+	{
+		return INVALID_NODE;
+	}
 
-	for (; i < size; i++)
+	unsigned int node = 0;
+	size_t start = 0;
+
+	// Walk each key seperated by '.'. Doesn't split to strings.
+	while (node != INVALID_NODE)
 	{
-		bool whitespace = isWhitespace(fileData[i]);
-		if (whitespace)
+		const size_t end = key.find('.', start);
+		const size_t length = (end == std::string::npos ? key.size() : end) - start;
+
+		node = findChild(node, boost::string_view(key.data() + start, length));
+
+		if (end == std::string::npos)
 		{
 			break;
 		}
+
+		start = end + 1;
 	}
 
-	return i;
+	return node;
 }
 
-const std::string DataTree::getKey()
+unsigned int Voxel::DataTree::appendString(const boost::string_view & str)
 {
-	return this->key;
+	const unsigned int offset = static_cast<unsigned int>(buffer.size());
+
+	buffer.insert(buffer.end(), str.begin(), str.end());
+
+	return offset;
 }
 
-const std::string DataTree::getValue()
+boost::string_view Voxel::DataTree::getKeyView(const unsigned int node) const
 {
-	return this->value;
+	auto& n = nodes[node];
+	return boost::string_view(buffer.data() + n.keyOffset, n.keyLength);
 }
 
-const std::string DataTree::getValueFromKey(int curIndex, const std::vector<std::string>& keys)
+boost::string_view Voxel::DataTree::getValueView(const unsigned int node) const
 {
-	// Reject empty keys
-	if (keys.empty()) { return std::string(); };
-
-	const size_t size = keys.size();
+	auto& n = nodes[node];
+	return boost::string_view(buffer.data() + n.valueOffset, n.valueLength);
+}
 
-	// Check size
-	if (curIndex >= size) { return std::string(); };
+bool Voxel::DataTree::getValueCString(const std::string & key, char * str, const unsigned int size) const
+{
+	const unsigned int node = findNode(key);
 
-	// Find key
-	auto find_it = this->children.find(keys.at(curIndex));
-	if (find_it == this->children.end())
+	if (node == INVALID_NODE)
 	{
-		// Key doesn't exists
-		return std::string();
-	}
-	else
-	{
-		if (curIndex == (size - 1))
-		{
-			// If index is last, get value
-			return this->children[keys.at(curIndex)]->value;
-		}
-		else
-		{
-			return this->children[keys.at(curIndex)]->getValueFromKey(curIndex + 1, keys);
-		}
+		return false;
 	}
-}
 
-const std::vector<std::string> DataTree::splitKeys(const std::string& key)
-{
-	std::vector<std::string> splitKeys;
+	auto value = getValueView(node);
 
-	std::stringstream ss(key);
-	std::string item;
-	while (std::getline(ss, item, '.')) 
+	if (value.empty() || value.size() >= size)
 	{
-		splitKeys.push_back(item);
+		return false;
 	}
 
-	return splitKeys;
+	std::memcpy(str, value.data(), value.size());
+	str[value.size()] = '\0';
+
+	return true;
 }
 
 const int DataTree::getInt(const std::string& key)
 {
-	const std::string valueStr = getString(key);
-	int valueInteger = 0;
-	try
+	char str[64];
+
+	if (!getValueCString(key, str, sizeof(str)))
 	{
-		valueInteger = std::stoi(valueStr);
+		return 0;
 	}
-	catch (...)
+
+	char* end = nullptr;
+	errno = 0;
+	const long valueInteger = std::strtol(str, &end, 10);
+
+	if (end == str || errno == ERANGE || valueInteger > std::numeric_limits<int>::max() || valueInteger < std::numeric_limits<int>::min())
 	{
-		valueInteger = 0;
+		return 0;
 	}
 
-	return valueInteger;
+	return static_cast<int>(valueInteger);
 }
 
 const float DataTree::getFloat(const std::string& key)
 {
-	const std::string valueStr = getString(key);
-	float valueFloat = 0.0f;
-	try
+	char str[64];
+
+	if (!getValueCString(key, str, sizeof(str)))
 	{
-		valueFloat = std::stof(valueStr);
+		return 0.0f;
 	}
-	catch (...)
+
+	char* end = nullptr;
+	errno = 0;
+	const float valueFloat = std::strtof(str, &end);
+
+	if (end == str || errno == ERANGE)
 	{
-		valueFloat = 0.0f;
+		return 0.0f;
 	}
 
 	return valueFloat;
@@ -425,15 +574,20 @@ const float DataTree::getFloat(const std::string& key)
 
 const double DataTree::getDouble(const std::string& key)
 {
-	const std::string valueStr = getString(key);
-	double valueDouble = 0.0;
-	try
+	char str[64];
+
+	if (!getValueCString(key, str, sizeof(str)))
 	{
-		valueDouble = std::stod(valueStr);
+		return 0.0;
 	}
-	catch (...)
+
+	char* end = nullptr;
+	errno = 0;
+	const double valueDouble = std::strtod(str, &end);
+
+	if (end == str || errno == ERANGE)
 	{
-		valueDouble = 0.0;
+		return 0.0;
 	}
 
 	return valueDouble;
@@ -441,24 +595,53 @@ const double DataTree::getDouble(const std::string& key)
 
 const bool DataTree::getBool(const std::string& key)
 {
-	std::string valueStr = getString(key); 
-	std::transform(valueStr.begin(), valueStr.end(), valueStr.begin(), ::tolower);
-	auto find_it = DataTree::boolAliases.find(valueStr);
-	if (find_it != DataTree::boolAliases.end())
+	const unsigned int node = findNode(key);
+
+	if (node == INVALID_NODE)
 	{
-		return find_it->second;
+		return false;
 	}
-	else
+
+	auto value = getValueView(node);
+
+	// Case insensitive
+	for (auto& e : boolAliases)
 	{
-		return false;
+		const size_t length = std::strlen(e.alias);
+
+		if (length != value.size())
+		{
+			continue;
+		}
+
+		size_t i = 0;
+
+		while (i < length && std::tolower(static_cast<unsigned char>(value[i])) == e.alias[i])
+		{
+			i++;
+		}
+
+		if (i == length)
+		{
+			return e.value;
+		}
 	}
+
+	return false;
 }
 
 const std::string DataTree::getString(const std::string& key)
 {
-	auto splitedKeys = splitKeys(key);
-	std::string value = getValueFromKey(0, splitedKeys);
-	return value;
+	const unsigned int node = findNode(key);
+
+	if (node == INVALID_NODE)
+	{
+		return std::string();
+	}
+
+	auto value = getValueView(node);
+
+	return std::string(value.data(), value.size());
 }
 
 const bool DataTree::setInt(const std::string& key, const int value, const bool overwrite)
@@ -517,100 +700,82 @@ const bool DataTree::setString(const std::string& key, const std::string& value,
 	if (key.empty()) { return false; }
 
 	// Empty value is accepted. It erases the string value.
-	auto splitedKeys = splitKeys(key);
+	unsigned int treeNode = 0;
+	size_t start = 0;
+
+	bool newKey = false;
 
-	// Empty splitted keys are rejceted
-	if (splitedKeys.empty()) { return false; }
+	while (true)
+	{
+		const size_t end = key.find('.', start);
+		const size_t length = (end == std::string::npos ? key.size() : end) - start;
 
-	unsigned int i = 0;
-	const unsigned size = splitedKeys.size();
+		// Empty key in path is rejected
+		if (length == 0) { return false; }
 
-	DataTree* treeNode = this;
+		const boost::string_view splitedKey(key.data() + start, length);
 
-	bool newKey = false;
+		const unsigned int child = findChild(treeNode, splitedKey);
 
-	for (; i < size; i++)
-	{
-		auto find_it = treeNode->children.find(splitedKeys.at(i));
-		if (find_it != treeNode->children.end())
+		if (child != INVALID_NODE)
 		{
 			// Key exists
-			treeNode = find_it->second;
-			continue;
+			treeNode = child;
 		}
 		else
 		{
 			// Key doesn't exists. Add new path.
-			treeNode->children[splitedKeys.at(i)] = new DataTree(splitedKeys.at(i), std::string());
-			treeNode = treeNode->children[splitedKeys.at(i)];
+			const unsigned int keyOffset = appendString(splitedKey);
+			treeNode = addChild(treeNode, keyOffset, static_cast<unsigned int>(length), 0, 0);
 			newKey = true;
 		}
-	}
 
-	if (newKey)
-	{
-		// It's a new key. Overwrite doesn't matter.
-		treeNode->value = value;
-	}
-	else
-	{
-		// Existing key. Check for overwrite
-		if (overwrite)
+		if (end == std::string::npos)
 		{
-			treeNode->value = value;
+			break;
 		}
-		//Else, do nothing.
+
+		start = end + 1;
+	}
+
+	// It's a new key. Overwrite doesn't matter.
+	if (newKey || overwrite)
+	{
+		// Previous value stays in buffer until cleared
+		const unsigned int valueOffset = appendString(value);
+
+		nodes.at(treeNode).valueOffset = valueOffset;
+		nodes.at(treeNode).valueLength = static_cast<unsigned int>(value.size());
 	}
+	//Else, do nothing.
 
 	return true;
 }
 
 const bool DataTree::hasKey(const std::string key)
 {
-	if (key.empty()) { return false; }
-
-	return hasKey(splitKeys(key));
+	return findNode(key) != INVALID_NODE;
 }
 
-const bool DataTree::hasKey(const std::vector<std::string> splitedKeys)
+const int DataTree::getChildrenSize()
 {
-	if (splitedKeys.empty()) { return false; }
-
-	DataTree* treeNode = this;
-
-	unsigned int i = 0;
-	const unsigned int size = splitedKeys.size();
-
-	for (; i < size; i++)
-	{
-		auto find_it = treeNode->children.find(splitedKeys.at(i));
-		if (find_it != treeNode->children.end())
-		{
-			// Key exists
-			treeNode = find_it->second;
-			continue;
-		}
-		else
-		{
-			return false;
-		}
-	}
-
-	return true;
+	return static_cast<int>(nodes.front().childCount);
 }
 
-const int DataTree::getChildrenSize()
+unsigned int Voxel::DataTree::getNodeCount() const
 {
-	return this->children.size();
+	return static_cast<unsigned int>(nodes.size());
 }
 
 const std::vector<std::string> DataTree::getKeySet()
 {
 	std::vector<std::string> keySet;
+	keySet.reserve(nodes.front().childCount);
 
-	for (auto child : this->children)
+	for (unsigned int child = nodes.front().firstChild; child != INVALID_NODE; child = nodes[child].nextSibling)
 	{
-		keySet.push_back(child.first);
+		auto key = getKeyView(child);
+		keySet.push_back(std::string(key.data(), key.size()));
 	}
 
 	return keySet;
@@ -620,136 +785,52 @@ const std::vector<std::string> DataTree::getKeySet(const std::string& key)
 {
 	std::vector<std::string> keySet;
 
-	if (key.empty())
+	const unsigned int targetNode = findNode(key);
+	if (targetNode == INVALID_NODE)
 	{
 		return keySet;
 	}
 
-	DataTree* targetTree = traverse(splitKeys(key));
-	if (targetTree == nullptr)
+	for (unsigned int child = nodes[targetNode].firstChild; child != INVALID_NODE; child = nodes[child].nextSibling)
 	{
-		return keySet;
+		auto childKey = getKeyView(child);
+		keySet.push_back(std::string(childKey.data(), childKey.size()));
 	}
 
-	keySet = targetTree->getKeySet();
-
 	return keySet;
 }
 
-const std::string DataTree::dataToString(DataTree* treeNode, int depth)
-{
-	std::string data = std::string();
-
-	if (treeNode->children.empty())
-	{
-		return treeNode->value + "\n";
-	}
-	else
-	{
-		const std::vector<std::string> keySet = treeNode->getKeySet();
-
-		int count = 0;
-		for (const auto key : keySet)
-		{
-			int childrenCount = treeNode->children[key]->getChildrenSize();
-			if (childrenCount != 0)
-			{
-				data += (key + " " + treeNode->children[key]->value + "\n");
-				for (unsigned int i = 0; i <= depth; i++)
-				{
-					data += "\t";
-				}
-			}
-			else
-			{
-				data += (key + " ");
-			}
-
-			data += dataToString(treeNode->children[key], depth + 1);
-
-			if (count < keySet.size() - 1)
-			{
-				for (unsigned int i = 0; i < depth; i++)
-				{
-					data += "\t";
-				}
-			}
-
-			count++;
-		}
-
-		return data;
-	}
-}
-
-DataTree* DataTree::traverse(const std::vector<std::string>& splitedKeys)
+void Voxel::DataTree::nodeToString(const unsigned int node, const int depth, std::string & data) const
 {
-	if (splitedKeys.empty())
+	// Children are written in order they were parsed or added
+	for (unsigned int child = nodes[node].firstChild; child != INVALID_NODE; child = nodes[child].nextSibling)
 	{
-		return nullptr;
-	}
+		data.append(static_cast<size_t>(depth), '\t');
 
-	unsigned int i = 0;
-	const unsigned size = splitedKeys.size();
+		auto key = getKeyView(child);
+		data.append(key.data(), key.size());
 
-	DataTree* treeNode = this;
-
-	bool newKey = false;
-
-	for (; i < size; i++)
-	{
-		auto find_it = treeNode->children.find(splitedKeys.at(i));
-		if (find_it != treeNode->children.end())
+		auto value = getValueView(child);
+		if (!value.empty())
 		{
-			// Key exists
-			treeNode = find_it->second;
-			continue;
+			data += ' ';
+			data.append(value.data(), value.size());
 		}
-		else
-		{
-			// Key doesn't exists. Add new path.
-			treeNode = nullptr;
-			break;
-		}
-	}
-
-	return treeNode;
-}
 
-const std::string DataTree::trim(const std::string& str)
-{
-	std::string result = str;
-
-	{
-		//Trim whitespace
-		const auto strBegin = result.find_first_not_of(' ');
-		if (strBegin == std::string::npos)
-			return ""; // no content
-
-		const auto strEnd = result.find_last_not_of(' ');
-		const auto strRange = strEnd - strBegin + 1;
-
-		result = result.substr(strBegin, strRange);
-	}
-
-	{
-		//Trim tab
-		const auto strBegin = result.find_first_not_of('\t');
-		if (strBegin == std::string::npos)
-			return ""; // no content
+		data += '\n';
 
-		const auto strEnd = result.find_last_not_of('\t');
-		const auto strRange = strEnd - strBegin + 1;
-
-		result = result.substr(strBegin, strRange);
+		nodeToString(child, depth + 1, data);
 	}
-
-	return result;
 }
 
 const std::string DataTree::toString()
 {
-	return dataToString(this, 0);
+	std::string data;
+	data.reserve(buffer.size());
+
+	nodeToString(0, 0, data);
+
+	return data;
 }
 
 void DataTree::save(const std::string& fileName)
@@ -762,11 +843,12 @@ void DataTree::save(const std::string& fileName)
 
 void DataTree::clear()
 {
-	for (const auto& child : this->children)
-	{
-		if (&child != nullptr)
-		{
-			delete (&child)->second;
-		}
-	}
-}
\ No newline at end of file
+	buffer.clear();
+
+	nodes.resize(1);
+
+	auto& root = nodes.front();
+	root.firstChild = INVALID_NODE;
+	root.lastChild = INVALID_NODE;
+	root.childCount = 0;
+}
@@ -3,7 +3,10 @@
 
 // cpp
 #include <string>
-#include <unordered_map>
+#include <vector>
+
+// boost
+#include <boost\utility\string_view.hpp>
 
 namespace Voxel
 {
@@ -14,176 +17,117 @@ namespace Voxel
 	*
 	*	This class stores data from a file it parses.
 	*	If parse fails, this instances does nothing.
+	*
+	*	File is read once to a buffer and parsed in place. Nodes are stored in single array
+	*	and keys and values are ranges in buffer, so loading doesn't allocate per node.
+	*	Shipped data files can be compiled to binary form (see compile()), which is loaded without parsing.
 	*/
 	class DataTree
 	{
+	public:
+		// Extension of compiled file. Compiled file is placed next to text file.
+		static const std::string COMPILED_FILE_EXTENSION;
 	private:
-		//* Private default constructor. Initializes instance.
-		DataTree(const std::string& key, const std::string& value);
+		// Node index that doesn't exist
+		static const unsigned int INVALID_NODE;
+
+		// Compiled file
+		static const unsigned int MAGIC;
+		static const unsigned int VERSION;
+
+		/**
+		*	@struct Node
+		*	@brief Key and value are ranges in buffer. Children are linked in file order.
+		*
+		*	Plain data, so nodes of compiled file are copied as is.
+		*/
+		struct Node
+		{
+			unsigned int keyOffset;
+			unsigned int keyLength;
+			unsigned int valueOffset;
+			unsigned int valueLength;
+			unsigned int firstChild;
+			unsigned int lastChild;
+			unsigned int nextSibling;
+			unsigned int childCount;
+		};
+
+		struct CompiledHeader
+		{
+			unsigned int magic;
+			unsigned int version;
+			unsigned int nodeCount;
+			unsigned int bufferSize;
+		};
+
+		//* Private default constructor. Initializes instance with root node.
+		DataTree();
 
 		// Comment symbol. '#' by default
 		static char commentSymbol;
 
-		// A key
-		std::string key;
-
-		// A value
-		std::string value;
+		// File data. Keys and values point here. Values set after load are appended.
+		std::vector<char> buffer;
 
-		// Aliases for bool type
-		static std::unordered_map<std::string, bool> boolAliases;
-
-		// children
-		std::unordered_map<std::string, DataTree*> children;
+		// All nodes. Root is first.
+		std::vector<Node> nodes;
 
 		/**
-		*	Parse the file data
-		*	@param fileData A string file data
-		*	@return True if successfully loads data.
+		*	Read whole file in single read.
+		*	@param filePath Path of file.
+		*	@param data Data of file.
+		*	@return True if file is read.
 		*/
-		bool parse(const std::string& fileData);
+		static bool readFile(const std::string& filePath, std::vector<char>& data);
 
 		/**
-		*	Helper function for parse function. It's recursive.
-		*	@param fileData A string file data
-		*	@param curIndex A int reference for index that currently parser pointing to on string data.
-		*	@param curDepth Current depth of parser on each recursive stack.
+		*	Parse buffer.
+		*	@note Line is key, whitespace and value. Depth of line is number of tabs or spaces before key.
+		*	Line that is deeper than previous line is child of it. Rest of line after comment symbol is ignored.
 		*	@return True if successfully loads data.
 		*/
-		bool parseData(const std::string& fileData, int& curIndex, int curDepth);
-
-		/**
-		*	Find index where first new line occurs from current index
-		*	@param fileData A string file data
-		*	@param curIndex A int reference for index that currently parser pointing to on string data.
-		*	@return A index where first new line character is. Returns file size if fails to find any.
-		*/
-		int findNewLineIndex(const std::string& fileData, int curIndex);
-
-		/**
-		*	Find either comment symbol or new line character from current index.
-		*	@param fileData A string file data
-		*	@param curIndex A int reference for index that currently parser pointing to on string data.
-		*	@return A index where either first comment symbol or new line character is. Returns file size if fails to find any.
-		*/
-		int findCommentSymbolOrNewLineIndex(const std::string& fileData, int curIndex);
-
-		/**
-		*	Find first non whitespace character from current index
-		*	@param fileData A string file data
-		*	@param curIndex A int reference for index that currently parser pointing to on string data.
-		*	@return A index where first non whitespace character is. Returns file size if fails to find any.
-		*/
-		int findFirstNonWhitespaceIndex(const std::string& fileData, int curIndex);
-
-		/**
-		*	Find first whitespace character from current index
-		*	@param fileData A string file data
-		*	@param curIndex A int reference for index that currently parser pointing to on string data.
-		*	@return A index where first whitespace character is. Returns file size if fails to find any.
-		*/
-		int findWhitespace(const std::string& fileData, int curIndex);
-
-		/**
-		*	Get current depth base on current index.
-		*	@note Tab, space, newline are considered as single depth.
-		*	@param fileData A string file data
-		*	@param curIndex A int reference for index that currently parser pointing to on string data.
-		*	@return Current depth. -1 if there isn't any depth to find.
-		*/
-		int getCurrentDepth(const std::string& fileData, int curIndex);
+		bool parse();
 
 		/**
-		*	Checks if character is new line character
-		*	@note Only checks CR and LF seperately. Doesn't check CR+LF.
-		*	@param Character to check.
-		*	@return True if character is newline character. Else, false.
+		*	Load compiled file. Doesn't parse. Copies nodes and buffer.
+		*	@param data Data of compiled file.
+		*	@return True if data is valid.
 		*/
-		bool isNewLineChar(const char& c);
+		bool loadCompiled(const std::vector<char>& data);
 
-		/**
-		*	Checks if character is whitespace.
-		*	@note Tab, space, newline are considered as single depth.
-		*	@param Character to check.
-		*	@return True if character is whitespace character. Else, false.
-		*/
-		bool isWhitespace(const char& c);
+		// Add child node. Node with same key is replaced like key is set again.
+		unsigned int addChild(const unsigned int parent, const unsigned int keyOffset, const unsigned int keyLength, const unsigned int valueOffset, const unsigned int valueLength);
 
-		/**
-		*	Parse key from the data string.
-		*	@param fileData A string file data
-		*	@param size Size of data string
-		*	@param start An index where parse starts.
-		*	@param end An index where parse ends.
-		*	@param curIndex Current index where parser is pointing to file data string.
-		*	@return A key string. Empty string if key doesn't exists.
-		*/
-		const std::string parseKey(const std::string& fileData, const int size, const int start, const int end, int& curIndex);
-
-		/**
-		*	Parse value from the data string.
-		*	@param fileData A string file data
-		*	@param size Size of data string
-		*	@param curIndex Current index where parser is pointing to file data string.
-		*	@return A value string. Empty string if key doesn't exists.
-		*/
-		const std::string parseValue(const std::string& fileData, const int size, int& curIndex);
+		// Find child with key. INVALID_NODE if doesn't exist.
+		unsigned int findChild(const unsigned int parent, const boost::string_view& key) const;
 
-		/**
-		*	Get key.
-		*	@return Key as string.
-		*/
-		const std::string getKey();
+		// Find node with key path seperated by '.'. INVALID_NODE if doesn't exist.
+		unsigned int findNode(const std::string& key) const;
 
-		/**
-		*	Get value.
-		*	@return Value as string.
-		*/
-		const std::string getValue();
+		// Append string to buffer. Returns offset. String must not point to buffer.
+		unsigned int appendString(const boost::string_view& str);
 
-		/**
-		*	Checks if data already has key.
-		*	@param splitedKeys A splitted keys to check.
-		*	@return True if data has same key. Else, false.
-		*/
-		const bool hasKey(const std::vector<std::string> splitedKeys);
+		// Get key of node
+		boost::string_view getKeyView(const unsigned int node) const;
 
-		/**
-		*	Get value from key
-		*	@param keys A sequence of key path of value.
-		*	@return A value as string.
-		*/
-		const std::string getValueFromKey(int curIndex, const std::vector<std::string>& keys);
+		// Get value of node
+		boost::string_view getValueView(const unsigned int node) const;
 
 		/**
-		*	Split key
-		*	@param A key string to split.
-		*	@return Key string set as vector.
+		*	Copy value to null terminated string for number conversion. Doesn't allocate.
+		*	@return False if value doesn't exist or is too long.
 		*/
-		const std::vector<std::string> splitKeys(const std::string& key);
+		bool getValueCString(const std::string& key, char* str, const unsigned int size) const;
 
 		/**
-		*	Convert data to string
-		*	@param treeNode A DataTree to convert
+		*	Convert node to string
+		*	@param node A node to convert
 		*	@param depth Current depth of data.
+		*	@param data String to append.
 		*	@note This is recursive function.
-		*	@return String data.
-		*/
-		const std::string dataToString(DataTree* treeNode, int depth);
-
-		/**
-		*	Traverse to specific DataTree instance in tree.
-		*	@param splitedKeys A key to find.
-		*	@return DataTree instance if exists. Else, nullptr;
 		*/
-		DataTree* traverse(const std::vector<std::string>& splitedKeys);
-
-		/**
-		*	Trims extra whitespaces at the end of string
-		*	@param str String to trim
-		*	@return Trimed string.
-		*/
-		const std::string trim(const std::string& str);
+		void nodeToString(const unsigned int node, const int depth, std::string& data) const;
 	public:
 		/**
 		*	Creates empty DataTree instance.
@@ -193,12 +137,38 @@ namespace Voxel
 
 		/**
 		*	Creates DataTree instance.
+		*	@note Loads compiled file instead if it exists and isn't older than text file.
 		*	@param fileName A name of data file to load. Empty string is rejected.
-		*	@param filePath A optional path for the file to read. If path is empty, then it uses default path.
 		*	@return A DataTree instance. Returns nullptr if rejected.
 		*/
 		static DataTree* create(const std::string& fileName);
 
+		/**
+		*	Creates DataTree instance from text data in memory.
+		*	@param data Text data.
+		*	@param size Size of data.
+		*	@return A DataTree instance. Returns nullptr if data is empty.
+		*/
+		static DataTree* createFromData(const char* data, const unsigned int size);
+
+		/**
+		*	Creates DataTree instance from compiled file.
+		*	@param compiledFilePath Path of compiled file.
+		*	@return A DataTree instance. Returns nullptr if file is missing or invalid.
+		*/
+		static DataTree* createFromCompiled(const std::string& compiledFilePath);
+
+		/**
+		*	Compiles text data file to binary form.
+		*	@param fileName A name of data file to compile.
+		*	@param compiledFileName A name of compiled file. Uses getCompiledFilePath(fileName) if empty.
+		*	@return True if compiled file is written.
+		*/
+		static bool compile(const std::string& fileName, const std::string& compiledFileName = std::string());
+
+		// Get path of compiled file for text data file
+		static std::string getCompiledFilePath(const std::string& fileName);
+
 		//* Destructor. 
 		~DataTree();
 
@@ -339,6 +309,9 @@ namespace Voxel
 		*/
 		const int getChildrenSize();
 
+		// Get number of nodes including root
+		unsigned int getNodeCount() const;
+
 		/**
 		*	Saves data to file
 		*	@note File will be get overwritten if file with same name exists
@@ -0,0 +1,197 @@
+// pch
+#include "PreCompiled.h"
+
+#include "DataTreeBenchmark.h"
+
+// cpp
+#include <memory>
+
+// voxel
+#include "DataTree.h"
+#include "DataTreeCooker.h"
+#include "FileSystem.h"
+#include "Benchmark.h"
+#include "Utility.h"
+
+using namespace Voxel;
+
+Voxel::DataTreeBenchmark::DataTreeBenchmark(const int iterations)
+	: iterations(iterations)
+{}
+
+DataTreeBenchmark::Result Voxel::DataTreeBenchmark::runFile(const std::string & filePath)
+{
+	Result result;
+	result.name = fs::path(filePath).filename().string();
+	result.nodeCount = 0;
+	result.parseMicroSeconds = 0;
+	result.textLoadMicroSeconds = 0;
+	result.compiledLoadMicroSeconds = 0;
+
+	std::ifstream file(filePath, std::ios::binary);
+	const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	file.close();
+
+	result.size = static_cast<unsigned int>(text.size());
+
+	if (text.empty())
+	{
+		return result;
+	}
+
+	// Parse only
+	auto start = Utility::Time::now();
+
+	for (int i = 0; i < iterations; i++)
+	{
+		std::unique_ptr<DataTree> dataTree(DataTree::createFromData(text.data(), static_cast<unsigned int>(text.size())));
+		result.nodeCount = dataTree->getNodeCount();
+	}
+
+	auto end = Utility::Time::now();
+
+	result.parseMicroSeconds = Benchmark::toMicroSeconds(start, end) / static_cast<float>(iterations);
+
+	// Loads go through DataTree::create like game does. Copy in working directory has no cooked file next to it,
+	// so create reads and parses text. Then it's cooked next to copy, so create loads compiled form.
+	auto& fileSystem = FileSystem::getInstance();
+
+	const std::string loadFilePath = fileSystem.getWorkingDirectory() + "/datatree-bench-load.txt";
+	const std::string compiledFilePath = DataTree::getCompiledFilePath(loadFilePath);
+
+	fileSystem.deleteFile(compiledFilePath);
+
+	std::ofstream copy(loadFilePath, std::ios::binary);
+	copy.write(text.data(), text.size());
+	copy.close();
+
+	// Text
+	start = Utility::Time::now();
+
+	for (int i = 0; i < iterations; i++)
+	{
+		std::unique_ptr<DataTree> dataTree(DataTree::create(loadFilePath));
+	}
+
+	end = Utility::Time::now();
+
+	result.textLoadMicroSeconds = Benchmark::toMicroSeconds(start, end) / static_cast<float>(iterations);
+
+	// Compiled
+	if (DataTree::compile(loadFilePath))
+	{
+		start = Utility::Time::now();
+
+		for (int i = 0; i < iterations; i++)
+		{
+			std::unique_ptr<DataTree> dataTree(DataTree::create(loadFilePath));
+		}
+
+		end = Utility::Time::now();
+
+		result.compiledLoadMicroSeconds = Benchmark::toMicroSeconds(start, end) / static_cast<float>(iterations);
+
+		fileSystem.deleteFile(compiledFilePath);
+	}
+
+	fileSystem.deleteFile(loadFilePath);
+
+	return result;
+}
+
+DataTreeBenchmark::Result Voxel::DataTreeBenchmark::runGenerated(const int sections)
+{
+	// Same shape as particle system data. Sections with nested groups of values.
+	std::stringstream ss;
+
+	for (int s = 0; s < sections; s++)
+	{
+		ss << "section" << s << "\n";
+
+		for (int g = 0; g < 8; g++)
+		{
+			ss << "\tgroup" << g << " # comment\n";
+
+			for (int v = 0; v < 8; v++)
+			{
+				ss << "\t\tvalue" << v << " " << (s * 0.5f + v) << "\n";
+			}
+		}
+	}
+
+	const std::string filePath = FileSystem::getInstance().getWorkingDirectory() + "/datatree-bench.txt";
+
+	std::ofstream out(filePath, std::ios::binary);
+	out << ss.str();
+	out.close();
+
+	auto result = runFile(filePath);
+	result.name = "generated (" + std::to_string(sections) + " sections)";
+
+	FileSystem::getInstance().deleteFile(filePath);
+
+	return result;
+}
+
+void Voxel::DataTreeBenchmark::printResult(const Result & result)
+{
+	Benchmark::ResultLine("DataTreeBenchmark", result.name)
+		.add("size", result.size, " bytes")
+		.add("nodes", result.nodeCount)
+		.add("parse", result.parseMicroSeconds, "us")
+		.add("text load", result.textLoadMicroSeconds, "us")
+		.add("compiled load", result.compiledLoadMicroSeconds, "us")
+		.print();
+}
+
+void Voxel::DataTreeBenchmark::run()
+{
+	std::cout << "[DataTreeBenchmark] Iterations: " << iterations << "\n";
+
+	auto& fs = FileSystem::getInstance();
+
+	std::vector<std::string> filePaths = DataTreeCooker::findDataFiles();
+
+	// Data trees that are loaded on start up
+	const std::string userSettingFilePath = fs.getUserDirectory() + "\\user.txt";
+	if (fs.isRegularFile(userSettingFilePath))
+	{
+		filePaths.push_back(userSettingFilePath);
+	}
+
+	float totalText = 0;
+	float totalCompiled = 0;
+
+	for (auto& filePath : filePaths)
+	{
+		auto result = runFile(filePath);
+
+		printResult(result);
+
+		totalText += result.textLoadMicroSeconds;
+		totalCompiled += result.compiledLoadMicroSeconds;
+	}
+
+	std::cout << "[DataTreeBenchmark] All " << filePaths.size() << " data files, text: " << totalText << "us, compiled: " << totalCompiled << "us\n";
+
+	for (int sections : { 16, 256 })
+	{
+		printResult(runGenerated(sections));
+	}
+}
+
+int Voxel::DataTreeBenchmark::runFromCommandLine(const int argc, const char * argv[])
+{
+	// argv[0] is exe, argv[1] is --datatree-bench
+	int iterations = 1000;
+
+	if (!Benchmark::parseArguments(argc, argv, { { &iterations, 1 } }, "[iterations]"))
+	{
+		return 1;
+	}
+
+	DataTreeBenchmark benchmark(iterations);
+	benchmark.run();
+
+	return 0;
+}
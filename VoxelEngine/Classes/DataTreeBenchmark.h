@@ -0,0 +1,64 @@
+#ifndef DATA_TREE_BENCHMARK_H
+#define DATA_TREE_BENCHMARK_H
+
+// cpp
+#include <string>
+#include <vector>
+
+namespace Voxel
+{
+	/**
+	*	@class DataTreeBenchmark
+	*	@brief Measures loading data trees without window or OpenGL context.
+	*
+	*	For each shipped data file and user setting, times parsing text in memory, and DataTree::create on copy of file
+	*	without and with cooked file next to it, which loads text and compiled form like game does. Also parses generated data with many nodes to show throughput.
+	*	Each time is mean of given number of iterations.
+	*
+	*	Run with: VoxelEngine.exe --datatree-bench [iterations]
+	*/
+	class DataTreeBenchmark
+	{
+	public:
+		// Result of single file. Times are in microseconds.
+		struct Result
+		{
+			std::string name;
+			unsigned int size;
+			unsigned int nodeCount;
+			float parseMicroSeconds;
+			float textLoadMicroSeconds;
+			float compiledLoadMicroSeconds;
+		};
+	private:
+		int iterations;
+
+		// Measure single file
+		Result runFile(const std::string& filePath);
+
+		// Measure generated data
+		Result runGenerated(const int sections);
+
+		void printResult(const Result& result);
+	public:
+		/**
+		*	Constructor
+		*	@param iterations Number of loads per measurement.
+		*/
+		DataTreeBenchmark(const int iterations);
+
+		// Destructor
+		~DataTreeBenchmark() = default;
+
+		// Runs benchmark with all data files
+		void run();
+
+		/**
+		*	Parses arguments after --datatree-bench and runs benchmark.
+		*	@return Exit code for process.
+		*/
+		static int runFromCommandLine(const int argc, const char* argv[]);
+	};
+}
+
+#endif
@@ -0,0 +1,110 @@
+// pch
+#include "PreCompiled.h"
+
+#include "DataTreeCooker.h"
+
+// cpp
+#include <memory>
+
+// voxel
+#include "DataTree.h"
+#include "FileSystem.h"
+#include "Benchmark.h"
+
+using namespace Voxel;
+
+std::vector<std::string> Voxel::DataTreeCooker::findDataFiles()
+{
+	std::vector<std::string> filePaths;
+
+	const fs::path dir(FileSystem::getInstance().getWorkingDirectory() + "/Data/ParticleSystem");
+
+	if (!fs::is_directory(dir))
+	{
+		return filePaths;
+	}
+
+	for (auto& e : fs::directory_iterator(dir))
+	{
+		if (fs::is_regular_file(e.path()) && e.path().extension() != DataTree::COMPILED_FILE_EXTENSION)
+		{
+			filePaths.push_back(e.path().string());
+		}
+	}
+
+	std::sort(filePaths.begin(), filePaths.end());
+
+	return filePaths;
+}
+
+bool Voxel::DataTreeCooker::cook(const std::string & filePath)
+{
+	const std::string compiledFilePath = DataTree::getCompiledFilePath(filePath);
+
+	if (!DataTree::compile(filePath, compiledFilePath))
+	{
+		std::cout << "[DataTreeCooker] Failed to compile " << filePath << "\n";
+		return false;
+	}
+
+	// Compare with text file. Both write same text if compiled file is correct.
+	std::unique_ptr<DataTree> compiled(DataTree::createFromCompiled(compiledFilePath));
+
+	std::ifstream file(filePath, std::ios::binary);
+	const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	std::unique_ptr<DataTree> parsed(DataTree::createFromData(text.data(), static_cast<unsigned int>(text.size())));
+
+	if (compiled == nullptr || parsed == nullptr || compiled->toString() != parsed->toString())
+	{
+		std::cout << "[DataTreeCooker] Compiled file doesn't match " << filePath << "\n";
+
+		// Don't leave broken file. Runtime falls back to text file.
+		FileSystem::getInstance().deleteFile(compiledFilePath);
+		return false;
+	}
+
+	Benchmark::ResultLine("DataTreeCooker", filePath)
+		.add("nodes", compiled->getNodeCount())
+		.add("text", text.size(), " bytes")
+		.add("compiled", FileSystem::getInstance().getFileSize(compiledFilePath), " bytes")
+		.print();
+
+	return true;
+}
+
+int Voxel::DataTreeCooker::runFromCommandLine(const int argc, const char * argv[])
+{
+	// argv[0] is exe, argv[1] is --cook-data-trees
+	std::vector<std::string> filePaths;
+
+	for (int i = 2; i < argc; i++)
+	{
+		filePaths.push_back(std::string(argv[i]));
+	}
+
+	if (filePaths.empty())
+	{
+		filePaths = findDataFiles();
+	}
+
+	if (filePaths.empty())
+	{
+		std::cout << "Usage: --cook-data-trees [data file paths...]\n";
+		return 1;
+	}
+
+	int failed = 0;
+
+	for (auto& filePath : filePaths)
+	{
+		if (!cook(filePath))
+		{
+			failed++;
+		}
+	}
+
+	std::cout << "[DataTreeCooker] Cooked " << (filePaths.size() - failed) << " / " << filePaths.size() << " data files\n";
+
+	return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,43 @@
+#ifndef DATA_TREE_COOKER_H
+#define DATA_TREE_COOKER_H
+
+// cpp
+#include <string>
+#include <vector>
+
+namespace Voxel
+{
+	/**
+	*	@class DataTreeCooker
+	*	@brief Compiles shipped data tree files to binary form without window or OpenGL context.
+	*
+	*	Writes .vdt file next to each text file (see DataTree::compile). DataTree::create loads compiled file
+	*	while it's newer than text file, so editing text file falls back to parsing until it's cooked again.
+	*	Each compiled file is loaded back and compared with text file to verify it.
+	*
+	*	Run with: VoxelEngine.exe --cook-data-trees [data file paths...]
+	*	Cooks all files in Data/ParticleSystem if no file is given.
+	*	Returns non zero if any file failed to cook.
+	*/
+	class DataTreeCooker
+	{
+	public:
+		// Find shipped data files
+		static std::vector<std::string> findDataFiles();
+
+		/**
+		*	Compile and verify single file.
+		*	@param filePath Path of text data file.
+		*	@return True if compiled file is written and matches text file.
+		*/
+		static bool cook(const std::string& filePath);
+
+		/**
+		*	Parses arguments after --cook-data-trees and cooks files.
+		*	@return Exit code for process.
+		*/
+		static int runFromCommandLine(const int argc, const char* argv[]);
+	};
+}
+
+#endif
@@ -17,17 +17,23 @@
 #include "Region.h"
 #include "Camera.h"
 #include "ChunkMap.h"
+#include "ChunkWorkManager.h"
 #include "Setting.h"
 #include "Calendar.h"
+#include "WeatherSystem.h"
 #include "TreeBuilder.h"
 #include "UIActions.h"
+#include "ThreadPool.h"
+#include "FrameProfiler.h"
+#include "FrameProfilerView.h"
 
 using namespace Voxel;
 
 DebugConsole::DebugConsole()
 	: openingConsole(false)
-	, debugCanvas(nullptr)
 	, debugOutputVisibility(false)
+	, lastCommandIndex(0)
+	, debugCanvas(nullptr)
 	, fpsNumber(nullptr)
 	, resolutionNumber(nullptr)
 	, vsyncMode(nullptr)
@@ -39,13 +45,15 @@ DebugConsole::DebugConsole()
 	, playerRotation(nullptr)
 	, playerLookingAt(nullptr)
 	, chunkNumbers(nullptr)
-	, lastCommandIndex(0)
+	, profilerView(nullptr)
 	, player(nullptr)
 	, game(nullptr)
 	, world(nullptr)
 	, chunkMap(nullptr)
+	, chunkWorkManager(nullptr)
 	, settingPtr(nullptr)
 	, calendar(nullptr)
+	, weatherSystem(nullptr)
 #if V_DEBUG && V_DEBUG_UI_TEST
 	, testImage(nullptr)
 	, testAnimatedImage(nullptr)
@@ -68,6 +76,11 @@ DebugConsole::~DebugConsole()
 		delete debugCanvas;
 	}
 
+	if (profilerView)
+	{
+		delete profilerView;
+	}
+
 	Application::getInstance().getGLView()->onFPSCounted = nullptr;
 }
 
@@ -209,6 +222,9 @@ void Voxel::DebugConsole::init()
 	drawCallAndVertCount->setVisibility(false);
 	debugCanvas->addChild(drawCallAndVertCount, 0);
 
+	profilerView = new FrameProfilerView();
+	profilerView->init(debugCanvas);
+
 	debugCanvas->print();
 }
 
@@ -421,10 +437,9 @@ bool Voxel::DebugConsole::executeCommand(const std::string & command)
 								return false;
 							}
 
-							auto region = world->getRegion(regionID);
-							if (region)
+							glm::vec2 regionSitePos;
+							if (world->getRegionSitePosition(regionID, regionSitePos))
 							{
-								auto regionSitePos = region->getSitePosition();
 
 								// y is -1 because we are traveling to place where chunk doesn exsits, so we don't know the top y value
 								game->teleportPlayer(glm::vec3(regionSitePos.x, -1, regionSitePos.y));
@@ -770,6 +785,28 @@ bool Voxel::DebugConsole::executeCommand(const std::string & command)
 						addCommandHistory(command);
 						return true;
 					}
+					else if (arg1 == "raybench" || arg1 == "rbench")
+					{
+						// chunkmap raybench [ray count]
+						int rayCount = 0;
+						try
+						{
+							rayCount = std::stoi(arg2);
+						}
+						catch (...)
+						{
+							return false;
+						}
+
+						if (rayCount <= 0)
+						{
+							return false;
+						}
+
+						runRaycastBenchmark(static_cast<unsigned int>(rayCount));
+						addCommandHistory(command);
+						return true;
+					}
 					else if (arg1 == "print" || arg1 == "p")
 					{
 						if (arg2 == "all" || arg2 == "a")
@@ -852,6 +889,182 @@ bool Voxel::DebugConsole::executeCommand(const std::string & command)
 					}
 				}
 			}
+			else if (commandStr == "chunkworkmanager" || commandStr == "cwm")
+			{
+				auto profiler = chunkWorkManager->getProfiler();
+
+				if (size == 3)
+				{
+					auto arg1 = split.at(1);
+					auto arg2 = split.at(2);
+
+					if (arg1 == "profile" || arg1 == "pf")
+					{
+						if (arg2 == "true" || arg2 == "false")
+						{
+							bool arg2Bool = arg2 == "true" ? true : false;
+
+							profiler->setEnabled(arg2Bool);
+							if (arg2Bool)
+							{
+								executedCommandHistory.push_back("Enabled chunk work profiler");
+							}
+							else
+							{
+								executedCommandHistory.push_back("Disabled chunk work profiler");
+							}
+							addCommandHistory(command);
+							return true;
+						}
+						else if (arg2 == "reset")
+						{
+							profiler->reset();
+							executedCommandHistory.push_back("Reset chunk work profiler");
+							addCommandHistory(command);
+							return true;
+						}
+						else if (arg2 == "print" || arg2 == "p")
+						{
+							auto lines = profiler->getSummary();
+							for (auto& line : lines)
+							{
+								std::cout << "[ChunkWorkManager] " << line << "\n";
+								executedCommandHistory.push_back(line);
+							}
+							addCommandHistory(command);
+							return true;
+						}
+					}
+					else if (arg1 == "trace" || arg1 == "t")
+					{
+						if (arg2 == "true" || arg2 == "false")
+						{
+							bool arg2Bool = arg2 == "true" ? true : false;
+
+							// Trace needs profiler
+							if (arg2Bool && !profiler->isEnabled())
+							{
+								profiler->setEnabled(true);
+							}
+
+							profiler->setTraceEnabled(arg2Bool);
+							if (arg2Bool)
+							{
+								executedCommandHistory.push_back("Enabled chunk work trace");
+							}
+							else
+							{
+								executedCommandHistory.push_back("Disabled chunk work trace");
+							}
+							addCommandHistory(command);
+							return true;
+						}
+					}
+				}
+				else if (size == 4)
+				{
+					auto arg1 = split.at(1);
+					auto arg2 = split.at(2);
+
+					if ((arg1 == "trace" || arg1 == "t") && (arg2 == "save" || arg2 == "s"))
+					{
+						// cwm trace save [path]. Open with chrome://tracing
+						auto path = split.at(3);
+						if (profiler->exportChromeTrace(path))
+						{
+							executedCommandHistory.push_back("Saved chunk work trace to " + path);
+						}
+						else
+						{
+							executedCommandHistory.push_back("Failed to save chunk work trace to " + path);
+						}
+						addCommandHistory(command);
+						return true;
+					}
+				}
+			}
+			else if (commandStr == "profiler" || commandStr == "prof")
+			{
+				auto& profiler = FrameProfiler::getInstance();
+
+				if (size == 2)
+				{
+					auto arg1 = split.at(1);
+
+					if (arg1 == "true" || arg1 == "false")
+					{
+						bool arg1Bool = arg1 == "true" ? true : false;
+
+						profiler.setEnabled(arg1Bool);
+						if (arg1Bool)
+						{
+							executedCommandHistory.push_back("Enabled frame profiler");
+						}
+						else
+						{
+							executedCommandHistory.push_back("Disabled frame profiler");
+						}
+						addCommandHistory(command);
+						return true;
+					}
+					else if (arg1 == "print" || arg1 == "p")
+					{
+						auto lines = profiler.getSummary();
+						for (auto& line : lines)
+						{
+							std::cout << "[FrameProfiler] " << line << "\n";
+							executedCommandHistory.push_back(line);
+						}
+						addCommandHistory(command);
+						return true;
+					}
+				}
+				else if (size == 3)
+				{
+					auto arg1 = split.at(1);
+					auto arg2 = split.at(2);
+
+					if (arg1 == "view" || arg1 == "v")
+					{
+						if (arg2 == "true" || arg2 == "false")
+						{
+							bool arg2Bool = arg2 == "true" ? true : false;
+
+							// View needs frames
+							if (arg2Bool && !FrameProfiler::isEnabled())
+							{
+								profiler.setEnabled(true);
+							}
+
+							profilerView->setVisibility(arg2Bool);
+							if (arg2Bool)
+							{
+								executedCommandHistory.push_back("Opened frame profiler view");
+							}
+							else
+							{
+								executedCommandHistory.push_back("Closed frame profiler view");
+							}
+							addCommandHistory(command);
+							return true;
+						}
+					}
+					else if (arg1 == "save" || arg1 == "s")
+					{
+						// profiler save [path]. Open with chrome://tracing
+						if (profiler.exportChromeTrace(arg2))
+						{
+							executedCommandHistory.push_back("Saved frame profiler trace to " + arg2);
+						}
+						else
+						{
+							executedCommandHistory.push_back("Failed to save frame profiler trace to " + arg2);
+						}
+						addCommandHistory(command);
+						return true;
+					}
+				}
+			}
 			else if (commandStr == "camera")
 			{
 				if (size == 4)
@@ -1292,6 +1505,52 @@ bool Voxel::DebugConsole::executeCommand(const std::string & command)
 					}
 				}
 			}
+			else if (commandStr == "weather")
+			{
+				// weather clear|rain|snow [intensity]
+				if (size == 2 || size == 3)
+				{
+					auto arg1 = split.at(1);
+
+					float intensity = 1.0f;
+
+					if (size == 3)
+					{
+						try
+						{
+							intensity = std::stof(split.at(2));
+						}
+						catch (...)
+						{
+							return false;
+						}
+					}
+
+					WeatherSystem::Weather weather;
+
+					if (arg1 == "clear")
+					{
+						weather = WeatherSystem::Weather::CLEAR;
+					}
+					else if (arg1 == "rain")
+					{
+						weather = WeatherSystem::Weather::RAIN;
+					}
+					else if (arg1 == "snow")
+					{
+						weather = WeatherSystem::Weather::SNOW;
+					}
+					else
+					{
+						return false;
+					}
+
+					weatherSystem->setWeather(weather, intensity);
+					executedCommandHistory.push_back("Weather set to " + WeatherSystem::weatherToString(weather) + " (" + std::to_string(weatherSystem->getIntensity()) + ")");
+					addCommandHistory(command);
+					return true;
+				}
+			}
 			else if (commandStr == "time")
 			{
 				if (size == 3)
@@ -1439,6 +1698,66 @@ bool Voxel::DebugConsole::executeCommand(const std::string & command)
 	return false;
 }
 
+void Voxel::DebugConsole::runRaycastBenchmark(const unsigned int rayCount)
+{
+	// Same rays for all thread counts
+	std::mt19937 engine(0);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+	const glm::vec3 eyePosition = player->getEyePosition();
+	const float range = 64.0f;
+
+	std::vector<RayQuery> queries(rayCount);
+
+	for (auto& query : queries)
+	{
+		glm::vec3 dir(0.0f);
+
+		// Pick random direction in unit sphere
+		while (glm::length(dir) < 0.01f || glm::length(dir) > 1.0f)
+		{
+			dir = glm::vec3(dist(engine), dist(engine), dist(engine));
+		}
+
+		query.origin = eyePosition;
+		query.direction = glm::normalize(dir);
+		query.maxDistance = range;
+	}
+
+	std::vector<RayQueryResult> results;
+
+	const unsigned int maxThreadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+	for (unsigned int threadCount = 1; threadCount <= maxThreadCount; threadCount++)
+	{
+		// Calling thread also casts rays.
+		ThreadPool pool(threadCount - 1);
+
+		// Warm up
+		chunkMap->raycastBlocks(queries, results, &pool);
+
+		auto start = Utility::Time::now();
+		chunkMap->raycastBlocks(queries, results, &pool);
+		auto end = Utility::Time::now();
+
+		const double seconds = std::chrono::duration<double>(end - start).count();
+		const double raysPerSecond = (seconds > 0.0) ? (static_cast<double>(rayCount) / seconds) : 0.0;
+
+		unsigned int hitCount = 0;
+		for (auto& result : results)
+		{
+			if (result.block)
+			{
+				hitCount++;
+			}
+		}
+
+		std::string log = "Raycast " + std::to_string(rayCount) + " rays, threads: " + std::to_string(threadCount) + ", rays/s: " + std::to_string(static_cast<long long>(raysPerSecond)) + ", hits: " + std::to_string(hitCount);
+		std::cout << "[DebugConsole] " << log << "\n";
+		executedCommandHistory.push_back(log);
+	}
+}
+
 void Voxel::DebugConsole::addCommandHistory(const std::string & command)
 {
 	lastCommands.push_front(command);
@@ -1564,6 +1883,8 @@ void Voxel::DebugConsole::update(const float delta)
 		}
 	}
 
+	profilerView->update(delta);
+
 	debugCanvas->update(delta);
 }
 
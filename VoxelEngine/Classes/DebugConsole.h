@@ -26,9 +26,12 @@ namespace Voxel
 	class Player;
 	class GameScene;
 	class ChunkMap;
+	class ChunkWorkManager;
 	class World;
 	class Setting;
 	class Calendar;
+	class WeatherSystem;
+	class FrameProfilerView;
 
 	class DebugConsole
 	{
@@ -72,12 +75,21 @@ namespace Voxel
 		UI::InputField* cmdInputField;
 		UI::Text* commandHistorys;
 
+		// Timeline of slowest frame in FrameProfiler's history
+		FrameProfilerView* profilerView;
+
 		std::list<std::string> executedCommandHistory;
 		std::list<std::string> lastCommands;
 
 		bool executeCommand(const std::string& command);
 		void addCommandHistory(const std::string& command);
 		void updateCommandHistory();
+
+		/**
+		*	Casts random rays from player's eye with ChunkMap::raycastBlocks and prints rays per second for each thread count, from 1 to hardware concurrency.
+		*	@param rayCount Number of rays in a batch.
+		*/
+		void runRaycastBenchmark(const unsigned int rayCount);
 	public:
 		DebugConsole();
 		~DebugConsole();
@@ -87,8 +99,10 @@ namespace Voxel
 		GameScene* game;
 		World* world;
 		ChunkMap* chunkMap;
+		ChunkWorkManager* chunkWorkManager;
 		Setting* settingPtr;
 		Calendar* calendar;
+		WeatherSystem* weatherSystem;
 
 		void init();
 
@@ -6,6 +6,7 @@
 // voxel
 #include "Application.h"
 #include "SpriteSheet.h"
+#include "AssetLoader.h"
 #include "MenuScene.h"
 #include "GameScene.h"
 #if V_DEBUG
@@ -45,9 +46,14 @@ Voxel::Director::~Director()
 
 	if (nextScene)
 	{
-		nextScene->onExit();
-		nextScene->onExitFinished();
-		nextScene->release();
+		// Next scene is not initialized until fade in finishes
+		if (fadeState != FadeState::FADE_IN && fadeState != FadeState::FADE_IN_FINISHED)
+		{
+			nextScene->onExit();
+			nextScene->onExitFinished();
+			nextScene->release();
+		}
+
 		delete nextScene;
 	}
 
@@ -70,13 +76,11 @@ Voxel::Scene * Voxel::Director::createScene(const SceneName sceneName)
 	case Voxel::Director::SceneName::MENU_SCENE:
 	{
 		newScene = new MenuScene();
-		newScene->init();
 	}
 		break;
 	case Voxel::Director::SceneName::GAME_SCENE:
 	{
 		newScene = new GameScene();
-		newScene->init();
 	}
 		break;
 #if V_DEBUG
@@ -84,7 +88,6 @@ Voxel::Scene * Voxel::Director::createScene(const SceneName sceneName)
 	case Voxel::Director::SceneName::EDITOR_SCENE:
 	{
 		newScene = new EditorScene();
-		newScene->init();
 	}
 	break;
 #endif
@@ -92,7 +95,6 @@ Voxel::Scene * Voxel::Director::createScene(const SceneName sceneName)
 	case Voxel::Director::SceneName::PARTICLE_SYSTEM_EDITOR_SCENE:
 	{
 		newScene = new ParticleSystemEditorScene();
-		newScene->init();
 	}
 	break;
 #endif
@@ -100,7 +102,6 @@ Voxel::Scene * Voxel::Director::createScene(const SceneName sceneName)
 	case Voxel::Director::SceneName::UI_TEST_SCENE:
 	{
 		newScene = new UITestScene();
-		newScene->init();
 	}
 	break;
 #endif
@@ -140,6 +141,13 @@ void Voxel::Director::runScene(const SceneName sceneName)
 	}
 
 	currentScene = createScene(sceneName);
+
+	// No transition to hide loading. Load assets in parallel and wait.
+	std::vector<std::shared_ptr<AssetHandle>> assets;
+	currentScene->preload(assets);
+	AssetLoader::getInstance().wait(assets);
+
+	currentScene->init();
 	currentScene->onEnter();
 	currentScene->onEnterFinished();
 }
@@ -158,6 +166,10 @@ void Voxel::Director::replaceScene(const SceneName sceneName, const float durati
 		{
 			nextScene = newScene;
 
+			// Start loading assets. Scene is initialized after fade in.
+			nextSceneAssets.clear();
+			nextScene->preload(nextSceneAssets);
+
 			state = State::TRANSITIONING;
 			fadeState = FadeState::FADE_IN;
 
@@ -209,14 +221,18 @@ void Voxel::Director::update(const float delta)
 		}
 		else if (fadeState == FadeState::FADE_IN_FINISHED)
 		{
-			// Fade in is finished. Give 0.2 seconds delay.
-			if (elapsedTime >= ((duration * 0.5f) + 0.2f))
+			// Fade in is finished. Give 0.2 seconds delay and wait until next scene's assets are loaded.
+			if (elapsedTime >= ((duration * 0.5f) + 0.2f) && AssetLoader::isDone(nextSceneAssets))
 			{
-				// Delay finished. 
-				elapsedTime -= 0.2f;
+				// Delay finished. Fade out starts from half of duration no matter how long it waited.
+				elapsedTime = duration * 0.5f;
 				// Update state
 				fadeState = FadeState::SWAP_SCENE;
 
+				// Assets are in managers. Screen is fully faded, so initialization isn't visible.
+				nextSceneAssets.clear();
+				nextScene->init();
+
 				// current scene finished exit
 				currentScene->onExitFinished();
 
@@ -3,6 +3,8 @@
 
 // cpp
 #include <list>
+#include <vector>
+#include <memory>
 
 // voxel
 #include <Config.h>
@@ -17,6 +19,9 @@
 
 namespace Voxel
 {
+	// foward declaration
+	class AssetHandle;
+
 	/**
 	*	@class Director
 	*	@brief A director that decides which to update and which to render.
@@ -24,8 +29,9 @@ namespace Voxel
 	*	Director manages multiple scenes in the game.
 	*	Like real director, it directs update and render to specific scene.
 	*	Scene can be title scene, menu scene, etc.
-	*	
-	*	
+	*
+	*	When scene is replaced, next scene's assets are loaded in background by AssetLoader while fade plays.
+	*	Next scene is initialized once screen is fully faded and all its assets are ready.
 	*/
 	class Director
 	{
@@ -84,7 +90,10 @@ namespace Voxel
 		Voxel::UI::Canvas* canvas;
 		Voxel::UI::Image* fadeImage;
 
-		// create scene
+		// Assets that next scene requested. Next scene is initialized when all are done.
+		std::vector<std::shared_ptr<AssetHandle>> nextSceneAssets;
+
+		// create scene. Scene is not initialized.
 		Scene* createScene(const SceneName sceneName);
 
 		// init fade quad
@@ -120,7 +129,7 @@ namespace Voxel
 		// run scene. This switches current scene to new scene without transition or waiting.
 		void runScene(const SceneName sceneName);
 
-		// Replace scene with transition. If scene is transitioing, rejects.
+		// Replace scene with transition. Next scene's assets are loaded during fade. If scene is transitioing, rejects.
 		void replaceScene(const SceneName sceneName, const float duration, const glm::vec3& fadeColor = glm::vec3(0.0f));
 
 		// pop current scene
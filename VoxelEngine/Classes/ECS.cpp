@@ -3,1080 +3,802 @@
 
 #include "ECS.h"
 
+// cpp
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+
 using namespace ECS;
 
 std::unique_ptr<Manager, ECS::Deleter<Manager>> ECS::Manager::instance = nullptr;
+ECS::Manager* ECS::System::manager = nullptr;
 
-ECS::Manager::Manager()
-{
-	// Create default entity pool
-	this->entityPools.insert(std::pair<std::string, std::unique_ptr<ECS::Manager::EntityPool>>(ECS::DEFAULT_ENTITY_POOL_NAME, std::unique_ptr<ECS::Manager::EntityPool>(new ECS::Manager::EntityPool())));
-
-	for (unsigned int i = 0; i < ECS::DEFAULT_ENTITY_POOL_SIZE; i++)
-	{
-		this->entityPools.begin()->second->pool.push_back(std::unique_ptr<ECS::Entity, ECS::Deleter<ECS::Entity>>(new ECS::Entity(), ECS::Deleter<ECS::Entity>()));
-		this->entityPools.begin()->second->pool.back()->entityPoolName = ECS::DEFAULT_ENTITY_POOL_NAME;
-		this->entityPools.begin()->second->pool.back()->index = i;
-		this->entityPools.begin()->second->nextIndicies.push_back(i);
-	}
+// ================================== COMPONENT REGISTRY ==================================
 
-	this->entityPools.begin()->second->idCounter = 0;
+std::vector<ComponentInfo>& ECS::ComponentRegistry::getInfos()
+{
+	// Function static, so it's initialized before any component type registers on static init.
+	static std::vector<ComponentInfo> infos;
+	return infos;
 }
 
-ECS::Manager::~Manager()
+std::mutex & ECS::ComponentRegistry::getMutex()
 {
-	// Unique ptr will release all for us
-	this->entityPools.clear();
-	this->components.clear();
-	this->systems.clear();
-	this->C_UNIQUE_IDMap.clear();
+	static std::mutex mutex;
+	return mutex;
 }
 
-Manager* ECS::Manager::getInstance()
+C_UNIQUE_ID ECS::ComponentRegistry::registerType(const ComponentInfo & info)
 {
-	if (ECS::Manager::instance == nullptr)
-	{
-		ECS::Manager::instance = std::unique_ptr<Manager, ECS::Deleter<Manager>>(new Manager(), ECS::Deleter<Manager>());
+	std::unique_lock<std::mutex> lock(getMutex());
 
-		ECS::Entity::manager = ECS::Manager::instance.get();
-		ECS::Component::manager = ECS::Manager::instance.get();
-		ECS::System::manager = ECS::Manager::instance.get();
+	auto& infos = getInfos();
+
+	if (infos.size() >= ECS::MAX_C_UNIQUE_ID)
+	{
+		// Signature can't have more types
+		return ECS::INVALID_C_UNIQUE_ID;
 	}
 
-	return ECS::Manager::instance.get();
-}
+	// Column memory is only aligned to default new alignment
+	assert(info.align <= alignof(std::max_align_t));
 
-void ECS::Manager::deleteInstance()
-{
-	if (ECS::Manager::instance != nullptr)
+	if (infos.empty())
 	{
-		instance->clear();
-		Manager* managerPtr = ECS::Manager::instance.release();
-		ECS::Manager::instance = nullptr;
-		if (managerPtr != nullptr)
-		{
-			delete managerPtr;
-		}
-		managerPtr = nullptr;
+		// Reserve all, so info pointers that columns keep are never invalidated.
+		infos.reserve(ECS::MAX_C_UNIQUE_ID);
 	}
+
+	infos.push_back(info);
+
+	return static_cast<C_UNIQUE_ID>(infos.size() - 1);
 }
 
-bool ECS::Manager::isValid()
+const ComponentInfo & ECS::ComponentRegistry::getInfo(const C_UNIQUE_ID cUniqueId)
 {
-	return ECS::Manager::instance != nullptr;
+	return getInfos()[cUniqueId];
 }
 
-void ECS::Manager::update(const float delta)
+unsigned int ECS::ComponentRegistry::getCount()
 {
-	// Main update.
+	std::unique_lock<std::mutex> lock(getMutex());
+	return static_cast<unsigned int>(getInfos().size());
+}
 
-	// Update system by priority.
-	for (auto& system : this->systems)
-	{
-		if (system.second->active)
-		{
-			std::vector<ECS::Entity*> entities;
-			for (auto poolName : system.second->entityPoolNames)
-			{
-				if (this->hasEntityPoolName(poolName))
-				{
-					if (poolName == ECS::DEFAULT_ENTITY_POOL_NAME)
-					{
-						if (system.second->queriesDefaultPool == false)
-						{
-							continue;
-						}
-					}
+// ==================================== BLOCK ALLOCATOR ===================================
 
-					for (auto& entity : this->entityPools[poolName]->pool)
-					{
-						if (entity->alive)
-						{
-							const Signature cmpSig = entity->signature & system.second->signature;
-							if (cmpSig == system.second->signature)
-							{
-								entities.push_back(entity.get());
-							}
-						}
-					}
-				}
-			}
+ECS::BlockAllocator::BlockAllocator()
+	: freeLists(ECS::BLOCK_SIZE_CLASS_COUNT, nullptr)
+	, reservedBytes(0)
+	, usedBytes(0)
+{}
 
-			system.second->update(delta, entities);
-		}
-	}
+ECS::BlockAllocator::~BlockAllocator()
+{
+	assert(usedBytes == 0);
 
+	releaseFreeBlocks();
 }
 
-void ECS::Manager::wrapEntityPoolIdCounter(const std::string& poolName)
+unsigned int ECS::BlockAllocator::getSizeClass(const size_t bytes)
 {
-	if (this->hasEntityPoolName(poolName))
-	{
-		if (this->entityPools.at(poolName)->idCounter >= ECS::MAX_E_ID)
-		{
-			this->entityPools.at(poolName)->idCounter = 0;
-		}
-	}
-}
+	unsigned int sizeClass = 0;
+	size_t blockSize = ECS::MIN_BLOCK_SIZE;
 
-void ECS::Manager::wrapComponentUniqueIdCounter(const C_UNIQUE_ID cUniqueId)
-{
-	try
+	while (blockSize < bytes)
 	{
-		if (this->components.at(cUniqueId)->idCounter >= ECS::MAX_C_UNIQUE_ID)
-		{
-			this->components.at(cUniqueId)->idCounter = 0;
-		}
+		blockSize <<= 1;
+		sizeClass++;
 	}
-	catch (...)
-	{
-		return;
-	}
-}
 
-const bool ECS::Manager::hasEntityPoolName(const std::string & name)
-{
-	// Check if there is a pool with same name.
-	return this->entityPools.find(name) != this->entityPools.end();
+	return sizeClass;
 }
 
-std::vector<std::string> ECS::Manager::getEntityPoolNames()
+void * ECS::BlockAllocator::allocate(const size_t bytes, size_t & blockSize)
 {
-	std::vector<std::string> names;
+	const unsigned int sizeClass = getSizeClass(bytes);
+	assert(sizeClass < ECS::BLOCK_SIZE_CLASS_COUNT);
 
-	for (auto& ep : this->entityPools)
-	{
-		names.push_back(ep.first);
-	}
+	blockSize = ECS::MIN_BLOCK_SIZE << sizeClass;
 
-	return names;
-}
+	void* block = freeLists[sizeClass];
 
-const unsigned int ECS::Manager::getEntityPoolSize(const std::string & name)
-{
-	auto find_it = this->entityPools.find(name);
-	if(find_it != this->entityPools.end())
+	if (block)
 	{
-		return find_it->second->pool.size();
+		// Pop from free list
+		freeLists[sizeClass] = *static_cast<void**>(block);
 	}
 	else
 	{
-		return 0;
-	}
-}
+		block = std::malloc(blockSize);
 
-const unsigned int ECS::Manager::getAliveEntityCountInEntityPool(const std::string & name)
-{
-	unsigned int count = 0;
-	auto find_it = this->entityPools.find(name);
-	if (find_it != this->entityPools.end())
-	{
-		for (auto& e : find_it->second->pool)
+		if (block == nullptr)
 		{
-			if (e->alive)
-			{
-				count++;
-			}
+			throw std::bad_alloc();
 		}
 
-		return count;
-	}
-	else
-	{
-		return 0;
+		reservedBytes += blockSize;
 	}
-}
 
-const bool ECS::Manager::isPowerOfTwo(const unsigned int n)
-{
-	return ((n != 0) && !(n & (n - 1)));
-}
+	usedBytes += blockSize;
 
-void ECS::Manager::roundToNearestPowerOfTwo(unsigned int& n)
-{
-	n = static_cast<unsigned int>(pow(2, ceil(log(static_cast<double>(n)) / log(2))));
+	return block;
 }
 
-const bool ECS::Manager::createEntityPool(const std::string& name, const int maxSize)
+void ECS::BlockAllocator::deallocate(void * block, const size_t blockSize)
 {
-	if (maxSize <= 0)
+	if (block == nullptr)
 	{
-		return false;
+		return;
 	}
 
-	if (name.empty() || name == DEFAULT_ENTITY_POOL_NAME)
-	{
-		// Pool name can't be empty or default
-		return false;
-	}
+	const unsigned int sizeClass = getSizeClass(blockSize);
 
-	if (this->hasEntityPoolName(name))
-	{
-		// There is a pool with same name
-		return false;
-	}
+	// Push to free list
+	*static_cast<void**>(block) = freeLists[sizeClass];
+	freeLists[sizeClass] = block;
 
-	unsigned int poolSize = maxSize;
+	usedBytes -= blockSize;
+}
 
-	if (this->isPowerOfTwo(poolSize) == false)
+void ECS::BlockAllocator::releaseFreeBlocks()
+{
+	for (unsigned int i = 0; i < ECS::BLOCK_SIZE_CLASS_COUNT; i++)
 	{
-		this->roundToNearestPowerOfTwo(poolSize);
-	}
+		void* block = freeLists[i];
 
-	// Create new
-	ECS::Manager::EntityPool* newPool = new ECS::Manager::EntityPool();
+		while (block)
+		{
+			void* next = *static_cast<void**>(block);
+			std::free(block);
+			reservedBytes -= (ECS::MIN_BLOCK_SIZE << i);
+			block = next;
+		}
 
-	for (unsigned int i = 0; i < poolSize; i++)
-	{
-		newPool->pool.push_back(std::unique_ptr<ECS::Entity, ECS::Deleter<ECS::Entity>>(new ECS::Entity(), ECS::Deleter<ECS::Entity>()));
-		newPool->nextIndicies.push_back(i);
-		newPool->pool.back()->entityPoolName = name;
-		newPool->pool.back()->index = i;
+		freeLists[i] = nullptr;
 	}
+}
 
-	newPool->idCounter = 0;
-
-	this->entityPools.insert(std::pair<std::string, std::unique_ptr<ECS::Manager::EntityPool>>(name, std::unique_ptr<ECS::Manager::EntityPool>(newPool)));
-	return true;
+size_t ECS::BlockAllocator::getReservedBytes() const
+{
+	return reservedBytes;
 }
 
-const bool ECS::Manager::deleteEntityPool(const std::string& name)
+size_t ECS::BlockAllocator::getUsedBytes() const
 {
-	if (name.empty() || name == DEFAULT_ENTITY_POOL_NAME)
-	{
-		// Can't delete with empty pool name or default name
-		return false;
-	}
+	return usedBytes;
+}
 
-	auto it = this->entityPools.begin();
-	for (; it != this->entityPools.end(); )
-	{
-		if ((*it).first == name)
-		{
-			this->entityPools.erase(it);
-			return true;
-		}
-        
-        it++;
-	}
+// ======================================== COLUMN ========================================
 
-	return false;
+ECS::Column::Column(const C_UNIQUE_ID cUniqueId, BlockAllocator* allocator)
+	: cUniqueId(cUniqueId)
+	, info(&ECS::ComponentRegistry::getInfo(cUniqueId))
+	, allocator(allocator)
+	, data(nullptr)
+	, blockSize(0)
+	, size(0)
+	, capacity(0)
+{}
+
+ECS::Column::Column(Column && arg)
+	: cUniqueId(arg.cUniqueId)
+	, info(arg.info)
+	, allocator(arg.allocator)
+	, data(arg.data)
+	, blockSize(arg.blockSize)
+	, size(arg.size)
+	, capacity(arg.capacity)
+{
+	arg.data = nullptr;
+	arg.blockSize = 0;
+	arg.size = 0;
+	arg.capacity = 0;
 }
 
-const bool ECS::Manager::resizeEntityPool(const std::string& entityPoolName, const unsigned int size)
+ECS::Column::~Column()
 {
-	if (!this->hasEntityPoolName(entityPoolName))
+	clear();
+
+	if (data)
 	{
-		return false;
+		allocator->deallocate(data, blockSize);
+		data = nullptr;
 	}
+}
 
-	unsigned int newSize = size;
-	if (!this->isPowerOfTwo(newSize))
+void ECS::Column::reserve(const unsigned int newCapacity)
+{
+	if (newCapacity <= capacity)
 	{
-		this->roundToNearestPowerOfTwo(newSize);
+		return;
 	}
 
-	const unsigned int curSize = this->entityPools.at(entityPoolName)->pool.size();
+	size_t newBlockSize = 0;
+	unsigned char* newData = static_cast<unsigned char*>(allocator->allocate(newCapacity * info->size, newBlockSize));
 
-	if (curSize < newSize)
+	if (data)
 	{
-		// expand
-		for (unsigned int i = curSize; i < newSize; i++)
+		if (info->trivial)
 		{
-			this->entityPools.at(entityPoolName)->pool.push_back(std::unique_ptr<ECS::Entity, ECS::Deleter<ECS::Entity>>(new ECS::Entity(), ECS::Deleter<ECS::Entity>()));
-			this->entityPools.at(entityPoolName)->pool.back()->entityPoolName = ECS::DEFAULT_ENTITY_POOL_NAME;
-			this->entityPools.at(entityPoolName)->pool.back()->index = i;
-			this->entityPools.at(entityPoolName)->nextIndicies.push_back(i);
+			std::memcpy(newData, data, size * info->size);
 		}
-
-		assert(this->entityPools.at(entityPoolName)->pool.size() == newSize);
-	}
-	else if (curSize > newSize)
-	{
-		this->entityPools.at(entityPoolName)->nextIndicies.clear();
-		this->entityPools.at(entityPoolName)->pool.resize(newSize);
-
-		for (unsigned int i = 0; i < this->entityPools.at(entityPoolName)->pool.size(); i++)
+		else
 		{
-			if (this->entityPools.at(entityPoolName)->pool.at(i)->alive == false)
+			for (unsigned int i = 0; i < size; i++)
 			{
-				this->entityPools.at(entityPoolName)->nextIndicies.push_back(i);
+				void* src = data + (i * info->size);
+				info->moveConstruct(newData + (i * info->size), src);
+				info->destroy(src);
 			}
 		}
+
+		allocator->deallocate(data, blockSize);
 	}
 
-	return true;
+	data = newData;
+	blockSize = newBlockSize;
+	// Block can be larger than requested
+	capacity = static_cast<unsigned int>(newBlockSize / std::max(info->size, static_cast<size_t>(1)));
 }
 
-ECS::Entity* ECS::Manager::createEntity(const std::string& poolName)
+void * ECS::Column::pushUninitialized()
 {
-	if (poolName.empty())
+	if (size == capacity)
 	{
-		// Pool name can't be empty
-		return nullptr;
+		// Grow by double
+		reserve(capacity == 0 ? ECS::DEFAULT_COLUMN_CAPACITY : capacity * 2);
 	}
 
-	auto find_it = this->entityPools.find(poolName);
+	void* ptr = get(size);
+	size++;
 
-	if (find_it == this->entityPools.end())
-	{
-		return nullptr;
-	}
+	return ptr;
+}
 
-	if (find_it->second->nextIndicies.empty())
+void ECS::Column::swapRemove(const unsigned int row)
+{
+	assert(row < size);
+
+	const unsigned int last = size - 1;
+
+	if (info->trivial)
 	{
-		// queue is empty. Pool is full
-		return nullptr;
+		if (row != last)
+		{
+			std::memcpy(get(row), get(last), info->size);
+		}
 	}
 	else
 	{
-		unsigned int index = find_it->second->nextIndicies.front();
-		find_it->second->nextIndicies.pop_front();
-
-		// Assume index is always valid.
-		find_it->second->pool.at(index)->revive(find_it->second->idCounter);
-		find_it->second->idCounter++;
-		this->wrapEntityPoolIdCounter(poolName);
-		return find_it->second->pool.at(index).get();
+		info->destroy(get(row));
+
+		if (row != last)
+		{
+			info->moveConstruct(get(row), get(last));
+			info->destroy(get(last));
+		}
 	}
 
-	// failed to find pool
-	return nullptr;
+	size--;
 }
 
-ECS::Entity* ECS::Manager::getEntityById(const E_ID entityId)
+void ECS::Column::clear()
 {
-	if (entityId == ECS::INVALID_E_ID)
-	{
-		return nullptr;
-	}
-
-	// Iterate all EntityPool and find it
-	for (auto& entityPool : this->entityPools)
+	if (!info->trivial)
 	{
-		for (auto& entity : entityPool.second->pool)
+		for (unsigned int i = 0; i < size; i++)
 		{
-			if (entity->id == entityId)
-			{
-				return entity.get();
-			}
+			info->destroy(get(i));
 		}
 	}
 
-	// Entity not found
-	return nullptr;
+	size = 0;
+}
+
+C_UNIQUE_ID ECS::Column::getComponentUniqueId() const
+{
+	return cUniqueId;
+}
+
+unsigned int ECS::Column::getSize() const
+{
+	return size;
 }
 
-void ECS::Manager::getAllEntitiesInPool(std::vector<ECS::Entity*>& entities, const std::string & poolName)
+// ======================================= ARCHETYPE ======================================
+
+ECS::Archetype::Archetype(const Signature & signature, BlockAllocator* allocator)
+	: signature(signature)
+	, columnIndices(ECS::MAX_C_UNIQUE_ID, ECS::INVALID_COLUMN_INDEX)
 {
-	if (this->hasEntityPoolName(poolName))
+	columns.reserve(signature.count());
+
+	// Sorted by unique id
+	for (unsigned int i = 0; i < ECS::MAX_C_UNIQUE_ID; i++)
 	{
-		for (auto& entity : this->entityPools[poolName]->pool)
+		if (signature.test(i))
 		{
-			if (entity->alive)
-			{
-				entities.push_back(entity.get());
-			}
+			columnIndices[i] = static_cast<unsigned int>(columns.size());
+			columns.push_back(Column(i, allocator));
 		}
 	}
 }
 
-const bool ECS::Manager::moveEntityToEntityPool(ECS::Entity*& entity, const std::string& entityPoolName)
+unsigned int ECS::Archetype::pushEntity(const E_ID entityId)
 {
-	if (entity == nullptr) return false;
-	if (entity->id == ECS::INVALID_E_ID) return false;
-
-	if (this->hasEntityPoolName(entityPoolName) && this->hasEntityPoolName(entity->entityPoolName))
+	for (auto& column : columns)
 	{
-		ECS::Entity* target = this->createEntity(entityPoolName);
-		if (target == nullptr)
-		{
-			return false;
-		}
+		column.pushUninitialized();
+	}
 
-		for (auto& e : this->entityPools[entity->entityPoolName]->pool)
-		{
-			if (e->id == entity->id)
-			{
-				target->signature = e->signature;
-				target->componentIndicies = e->componentIndicies;
-				target->sleep = e->sleep;
+	entities.push_back(entityId);
 
-				// Reassing owner for components
-				for (auto pair : e->componentIndicies)
-				{
-					const C_UNIQUE_ID cUniqueId = pair.first;
-					for (auto cIndex : pair.second)
-					{
-						this->components.at(cUniqueId)->pool.at(cIndex)->ownerId = target->id;
-					}
-				}
+	return static_cast<unsigned int>(entities.size() - 1);
+}
 
-				e->signature = 0;
-				e->alive = false;
-				e->componentIndicies.clear();
-				e->sleep = false;
-				e->id = ECS::INVALID_E_ID;
-				this->entityPools[e->entityPoolName]->nextIndicies.push_front(e->index);
+E_ID ECS::Archetype::swapRemove(const unsigned int row)
+{
+	for (auto& column : columns)
+	{
+		column.swapRemove(row);
+	}
 
-				entity = nullptr;
+	const unsigned int last = static_cast<unsigned int>(entities.size() - 1);
 
-				entity = target;
+	E_ID movedEntityId = ECS::INVALID_E_ID;
 
-				return true;
-			}
-		}
+	if (row != last)
+	{
+		movedEntityId = entities[last];
+		entities[row] = movedEntityId;
 	}
 
-	return false;
+	entities.pop_back();
+
+	return movedEntityId;
 }
 
-std::vector<Component*> ECS::Manager::getAllComponents(const C_UNIQUE_ID cUniqueID)
+const Signature & ECS::Archetype::getSignature() const
 {
-	std::vector<Component*> components;
-	
-	if (cUniqueID == INVALID_C_UNIQUE_ID)
-	{
-		return components;
-	}
-	else
-	{
-		for (auto& uPtr : this->components[cUniqueID]->pool)
-		{
-			components.push_back(uPtr.get());
-		}
+	return signature;
+}
 
-		return components;
-	}
+unsigned int ECS::Archetype::getSize() const
+{
+	return static_cast<unsigned int>(entities.size());
 }
 
-const bool ECS::Manager::killEntity(ECS::Entity* e)
+const E_ID * ECS::Archetype::getEntities() const
 {
-	if (e == nullptr) return false;
-	if (e->id == ECS::INVALID_E_ID) return false;
-	if (e->entityPoolName.empty()) return false;
+	return entities.data();
+}
+
+bool ECS::Archetype::hasColumn(const C_UNIQUE_ID cUniqueId) const
+{
+	return cUniqueId < ECS::MAX_C_UNIQUE_ID && columnIndices[cUniqueId] != ECS::INVALID_COLUMN_INDEX;
+}
 
-	if (this->hasEntityPoolName(e->entityPoolName))
+Column * ECS::Archetype::getColumn(const C_UNIQUE_ID cUniqueId)
+{
+	if (!hasColumn(cUniqueId))
 	{
-		assert(e->index != ECS::MAX_E_ID);
+		return nullptr;
+	}
 
-		// Wipe everything
-		for (auto componentIndicies : this->entityPools[e->entityPoolName]->pool.at(e->index)->componentIndicies)
-		{
-			const C_UNIQUE_ID cUnqiueId = componentIndicies.first;
-			for (auto cIndex : componentIndicies.second)
-			{
-				if (this->components.at(cUnqiueId)->pool.at(cIndex) != nullptr)
-				{
-					if (this->components.at(cUnqiueId)->pool.at(cIndex)->ownerId == e->id)
-					{
-						Component* c = this->components.at(cUnqiueId)->pool.at(cIndex).release();
-						this->components.at(cUnqiueId)->pool.at(cIndex) = nullptr;
-						this->components.at(cUnqiueId)->nextIndicies.push_front(cIndex);
-						delete c;
-						c = nullptr;
-					}
-				}
-			}
-		}
+	return &columns[columnIndices[cUniqueId]];
+}
 
-		this->entityPools[e->entityPoolName]->nextIndicies.push_front(e->index);
-		this->entityPools[e->entityPoolName]->pool.at(e->index)->componentIndicies.clear();
-		this->entityPools[e->entityPoolName]->pool.at(e->index)->id = ECS::INVALID_E_ID;
-		this->entityPools[e->entityPoolName]->pool.at(e->index)->alive = false;
-		this->entityPools[e->entityPoolName]->pool.at(e->index)->sleep = false;
-		this->entityPools[e->entityPoolName]->pool.at(e->index)->signature = 0;
+// ======================================== MANAGER =======================================
 
-		return true;
-	}
-	else
-	{
-		return false;
-	}
+ECS::Manager::Manager()
+	: entityRecordCount(0)
+	, freeRecordHead(ECS::INVALID_E_ID)
+	, freeRecordTail(ECS::INVALID_E_ID)
+	, aliveEntityCount(0)
+	, emptyArchetype(nullptr)
+	, systemIdCounter(0)
+	, scheduleDirty(true)
+	, threadPool(nullptr)
+{
+	emptyArchetype = getOrCreateArchetype(Signature());
 }
 
-const C_ID ECS::Manager::getComponentUniqueId(const std::type_info& t)
+ECS::Manager::~Manager()
 {
-	const std::type_index typeIndex = std::type_index(t);
-	try
-	{
-		return this->C_UNIQUE_IDMap.at(typeIndex);
-	}
-	catch (...)//(const std::out_of_range& oor)
-	{
-		//std::cout << oor.what() << std::endl;
-		return ECS::INVALID_C_UNIQUE_ID;
-	}
+	// Unique ptr will release all for us
+	this->systems.clear();
+	this->archetypeMap.clear();
+	this->archetypes.clear();
+	this->entityRecordPages.clear();
 }
 
-const S_ID ECS::Manager::getSystemId(const std::type_info & t)
+Manager* ECS::Manager::getInstance()
 {
-	const std::type_index typeIndex = std::type_index(t);
-	auto find_it = this->S_IDMap.find(typeIndex);
-	if (find_it != this->S_IDMap.end())
-	{
-		return find_it->second;
-	}
-	else
+	if (ECS::Manager::instance == nullptr)
 	{
-		return INVALID_S_ID;
+		ECS::Manager::instance = std::unique_ptr<Manager, ECS::Deleter<Manager>>(new Manager(), ECS::Deleter<Manager>());
+
+		ECS::System::manager = ECS::Manager::instance.get();
 	}
+
+	return ECS::Manager::instance.get();
 }
 
-const C_UNIQUE_ID ECS::Manager::registerComponent(const std::type_info& t)
+void ECS::Manager::deleteInstance()
 {
-	C_UNIQUE_ID cUniqueID = this->getComponentUniqueId(t);
-	if (cUniqueID == ECS::INVALID_C_UNIQUE_ID)
+	if (ECS::Manager::instance != nullptr)
 	{
-		// This is new type of component.
-		cUniqueID = Component::uniqueIdCounter++;
-		if (cUniqueID == ECS::MAX_C_UNIQUE_ID)
+		instance->clear();
+		Manager* managerPtr = ECS::Manager::instance.release();
+		ECS::Manager::instance = nullptr;
+		if (managerPtr != nullptr)
 		{
-			// Reached maximum number of component type. 
-			Component::uniqueIdCounter--;
-			return ECS::INVALID_C_UNIQUE_ID;
+			delete managerPtr;
 		}
+		managerPtr = nullptr;
 
-		// Add new unique id with type_index key to map
-		this->C_UNIQUE_IDMap.insert(std::pair<std::type_index, C_UNIQUE_ID>(std::type_index(t), cUniqueID));
-
-		// Add new component pool
-		auto newPool = new ECS::Manager::ComponentPool();
-		newPool->idCounter = 0;
-		newPool->nextIndicies.clear();
-		newPool->pool.clear();
-		this->components.push_back(std::unique_ptr<ECS::Manager::ComponentPool>(std::unique_ptr<ECS::Manager::ComponentPool>(newPool)));
+		ECS::System::manager = nullptr;
 	}
+}
 
-	return cUniqueID;
+bool ECS::Manager::isValid()
+{
+	return ECS::Manager::instance != nullptr;
 }
 
-const bool ECS::Manager::deleteComponent(Component*& c, const std::type_info& t)
+void ECS::Manager::update(const float delta)
 {
-	// Check component
-	if (c == nullptr)
-	{
-		return false;
-	}
+	// Main update.
 
-	if (c->uniqueId == ECS::INVALID_C_UNIQUE_ID)
+	if (this->scheduleDirty)
 	{
-		// Unique id is invalid
-		delete c;
-		c = nullptr;
-		return true;
+		buildSchedule();
 	}
-	else
+
+	// Update stages in order. Systems query their own entities with forEach.
+	for (auto& stage : this->schedule)
 	{
-		if (c->ownerId == ECS::INVALID_E_ID)
+		if (this->threadPool == nullptr || stage.size() == 1)
 		{
-			// Doesn't have owner
-			delete c;
-			c = nullptr;
-			return true;
+			// By priority
+			for (auto system : stage)
+			{
+				if (system->active)
+				{
+					system->update(delta);
+				}
+			}
 		}
 		else
 		{
-			// Get owner
-			ECS::Entity* e = this->getEntityById(c->ownerId);
-			if (e == nullptr)
-			{
-				// Owner doesn't exists
-				delete c;
-				c = nullptr;
-				return true;
-			}
-			else
+			// Systems in stage don't conflict. Each range is single system.
+			this->threadPool->parallelFor(static_cast<unsigned int>(stage.size()), 1, [&stage, delta](const unsigned int begin, const unsigned int end)
 			{
-				// have owner. Check if manager has this component
-				C_INDEX index = ECS::INVALID_C_INDEX;
-				for (auto& component : this->components[c->uniqueId]->pool)
+				for (unsigned int i = begin; i < end; i++)
 				{
-					if (c == component.get())
+					if (stage[i]->active)
 					{
-						// save index
-						index = c->index;
-
-						// Remove from signature
-						e->signature[c->uniqueId] = 0;
-						// Remove from indcies vector
-						e->componentIndicies[c->uniqueId].erase(index);
-						
-						// Delete the component
-						delete component.release();
-
-						// Make it null
-						component = nullptr;
-
-						c = nullptr;
-						return true;
+						stage[i]->update(delta);
 					}
 				}
-
-				if (index == ECS::INVALID_C_INDEX)
-				{
-					// Failed to find same component
-					delete c;
-					c = nullptr;
-					return true;
-				}
-
-				return true;
-			}
+			});
 		}
 	}
 }
 
-const bool ECS::Manager::hasComponent(Entity* e, const std::type_info& t)
+void ECS::Manager::buildSchedule()
 {
-	if (e == nullptr) return false;
+	this->schedule.clear();
 
-	const ECS::C_UNIQUE_ID cUniqueId = this->getComponentUniqueId(t);
+	// Stage of each system that is already scheduled
+	std::vector<std::pair<ECS::System*, unsigned int>> scheduled;
 
-	if (cUniqueId == ECS::INVALID_C_UNIQUE_ID)
-	{
-		// This type of component is unknown.
-		return false;
-	}
-	else
+	// Systems are visited by priority, so system always runs after higher priority system that it conflicts with.
+	for (auto& system : this->systems)
 	{
-		Signature& s = e->signature;
+		ECS::System* systemPtr = system.second.get();
+
+		unsigned int stage = 0;
 
-		try
+		for (auto& prev : scheduled)
 		{
-			s.test(cUniqueId);
-			if (s[cUniqueId] == true)
-			{
-				return true;
-			}
-			else
+			if (systemPtr->conflictsWith(*prev.first))
 			{
-				return false;
+				stage = std::max(stage, prev.second + 1);
 			}
 		}
-		catch (...)
+
+		if (stage >= this->schedule.size())
 		{
-			return false;
+			this->schedule.resize(stage + 1);
 		}
+
+		this->schedule.at(stage).push_back(systemPtr);
+		scheduled.push_back(std::pair<ECS::System*, unsigned int>(systemPtr, stage));
 	}
+
+	this->scheduleDirty = false;
 }
 
-const bool ECS::Manager::hasComponent(Entity* e, const std::type_info& t, Component* c)
+Manager::EntityRecord * ECS::Manager::getEntityRecord(const E_ID entityId)
 {
-	if (e == nullptr) return false;
-	if (c == nullptr) return false;
-	if (c->id == ECS::INVALID_C_ID) return false;
-	if (c->index == ECS::INVALID_C_INDEX) return false;
-	if (c->uniqueId != this->getComponentUniqueId(t)) return false;
+	const unsigned int index = ECS::getEntityIndex(entityId);
 
-	if (hasComponent(e, t))
+	if (index >= this->entityRecordCount)
 	{
-		for (auto cIndex : e->componentIndicies[this->getComponentUniqueId(t)])
-		{
-			if (c->index == cIndex)
-			{
-				return true;
-			}
-		}
-
-		return false;
+		return nullptr;
 	}
-	else
+
+	EntityRecord* record = &getRecordAt(index);
+
+	if (record->archetype == nullptr || record->generation != ECS::getEntityGeneration(entityId))
 	{
-		return false;
+		// Dead or stale id
+		return nullptr;
 	}
+
+	return record;
 }
 
-Component* ECS::Manager::getComponent(Entity* e, const std::type_info& t)
+E_ID ECS::Manager::allocateEntity(Archetype * archetype)
 {
-	if (e == nullptr) return nullptr;
+	unsigned int index;
 
-	// Get unique id
-	const ECS::C_UNIQUE_ID cUniqueId = this->getComponentUniqueId(t);
-	if (cUniqueId == ECS::INVALID_C_UNIQUE_ID)
+	if (this->freeRecordHead != ECS::INVALID_E_ID)
 	{
-		// This type of component is unknown.
-		return nullptr;
+		// Pop oldest
+		index = this->freeRecordHead;
+		this->freeRecordHead = getRecordAt(index).row;
+
+		if (this->freeRecordHead == ECS::INVALID_E_ID)
+		{
+			this->freeRecordTail = ECS::INVALID_E_ID;
+		}
 	}
 	else
 	{
-		// This type of component is already known. We have unique id and pool ready.
-		std::unordered_set<C_INDEX>& cIndicies = e->componentIndicies.at(cUniqueId);
-		// Get C_INDEXs
-		//e->getComponentIndiicesByUniqueId(cUniqueId, cIndicies);
-
-		if (cIndicies.empty())
+		if (this->entityRecordCount >= ECS::MAX_E_ID)
 		{
-			// Doesn't have any. hmm..
-			return nullptr;
+			return ECS::INVALID_E_ID;
 		}
-		else
-		{
-			// Because this is getComponent not getComponents, return first one
-			const C_INDEX firstIndex = (*cIndicies.begin());
 
-			Component* c = this->components[cUniqueId]->pool.at(firstIndex).get();
-			if (c->ownerId == e->id)
-			{
-				return c;
-			}
-			else
-			{
-				return nullptr;
-			}
+		index = this->entityRecordCount;
+
+		if (index % ECS::ENTITY_RECORD_PAGE_SIZE == 0)
+		{
+			// New page
+			this->entityRecordPages.push_back(std::unique_ptr<EntityRecord[]>(new EntityRecord[ECS::ENTITY_RECORD_PAGE_SIZE]));
 		}
+
+		getRecordAt(index).generation = 0;
+		this->entityRecordCount++;
 	}
+
+	EntityRecord& record = getRecordAt(index);
+	const E_ID entityId = ECS::makeEntityId(index, record.generation);
+
+	record.archetype = archetype;
+	record.row = archetype->pushEntity(entityId);
+
+	this->aliveEntityCount++;
+
+	return entityId;
 }
 
-std::vector<Component*> ECS::Manager::getComponents(Entity* e, const std::type_info& t)
+void ECS::Manager::pushFreeRecord(const unsigned int index)
 {
-	std::vector<Component*> ret;
+	EntityRecord& record = getRecordAt(index);
+	record.archetype = nullptr;
+	record.row = ECS::INVALID_E_ID;
 
-	if (e == nullptr) return ret;
-
-	const ECS::C_UNIQUE_ID cUniqueId = this->getComponentUniqueId(t);
-	if (cUniqueId == ECS::INVALID_C_UNIQUE_ID)
+	if (this->freeRecordTail == ECS::INVALID_E_ID)
 	{
-		// This type of component is unknown.
-		return ret;
+		this->freeRecordHead = index;
 	}
 	else
 	{
-		// This type of component is already known. We have unique id and pool ready.
-		std::unordered_set<C_INDEX> cIndicies;
-		// Get C_INDEXs
-		e->getComponentIndiicesByUniqueId(cUniqueId, cIndicies);
-
-		if (cIndicies.empty())
-		{
-			// Doesn't have any. hmm..
-			return ret;
-		}
-		else
-		{
-			// Return all components
-			for (auto& component : this->components.at(cUniqueId)->pool)
-			{
-				if (component != nullptr)
-				{
-					ret.push_back(component.get());
-				}
-			}
-
-			return ret;
-		}
+		getRecordAt(this->freeRecordTail).row = index;
 	}
+
+	this->freeRecordTail = index;
 }
 
-const bool ECS::Manager::addComponent(Entity* e, const std::type_info& t, Component* c)
+Archetype * ECS::Manager::getOrCreateArchetype(const Signature & signature)
 {
-	if (e == nullptr) return false;
-
-	// Reject null component
-	if (c == nullptr) return false;
-
-	// Get component unique id
-	C_UNIQUE_ID cUniqueId = c->uniqueId;
-	if (cUniqueId == ECS::INVALID_C_UNIQUE_ID)
+	auto find_it = this->archetypeMap.find(signature);
+	if (find_it != this->archetypeMap.end())
 	{
-		// Bad component type
-		return false;
+		return find_it->second;
 	}
 
-	// Check if manager already has the same entity. Reject if there is same one
-	for (auto& component : this->components.at(cUniqueId)->pool)
+	Archetype* newArchetype = new Archetype(signature, &this->blockAllocator);
+
+	this->archetypes.push_back(std::unique_ptr<Archetype>(newArchetype));
+	this->archetypeMap.emplace(signature, newArchetype);
+
+	return newArchetype;
+}
+
+Archetype * ECS::Manager::getAddEdge(Archetype * archetype, const C_UNIQUE_ID cUniqueId)
+{
+	auto find_it = archetype->addEdges.find(cUniqueId);
+	if (find_it != archetype->addEdges.end())
 	{
-		if (component != nullptr)
-		{
-			if (component->getId() == c->getId())
-			{
-				return false;
-			}
-		}
+		return find_it->second;
 	}
 
-	// Component is valid.
-	// Add component
-	this->components.at(cUniqueId)->pool.push_back(std::unique_ptr<Component, Deleter<Component>>(c, Deleter<Component>()));
+	Signature signature = archetype->signature;
+	signature.set(cUniqueId);
 
-	// Get index. pool size - 1
-	const C_INDEX cIndex = this->components.at(cUniqueId)->pool.size() - 1;
+	Archetype* target = getOrCreateArchetype(signature);
 
-	// Add index to entity
-	e->componentIndicies[cUniqueId].insert(cIndex);
+	// Cache both way
+	archetype->addEdges.emplace(cUniqueId, target);
+	target->removeEdges.emplace(cUniqueId, archetype);
 
-	// update signature
-	e->signature[cUniqueId] = 1;
+	return target;
+}
 
-	// Update component indicies
-	auto find_it = e->componentIndicies.find(cUniqueId);
-	if (find_it == e->componentIndicies.end())
+Archetype * ECS::Manager::getRemoveEdge(Archetype * archetype, const C_UNIQUE_ID cUniqueId)
+{
+	auto find_it = archetype->removeEdges.find(cUniqueId);
+	if (find_it != archetype->removeEdges.end())
 	{
-		e->componentIndicies.insert(std::pair<C_UNIQUE_ID, std::unordered_set<C_INDEX>>(cUniqueId, std::unordered_set<C_INDEX>()));
+		return find_it->second;
 	}
-	e->componentIndicies[cUniqueId].insert(cIndex);
-
-	// Assign unique id
-	c->uniqueId = cUniqueId;
-	// Assign id
-	c->id = this->components.at(cUniqueId)->idCounter++;
-	// Store index
-	c->index = cIndex;
-	// Set owner id
-	c->ownerId = e->getId();
-	// wrap counter 
-	this->wrapComponentUniqueIdCounter(cUniqueId);
 
-	return true;
+	Signature signature = archetype->signature;
+	signature.reset(cUniqueId);
+
+	Archetype* target = getOrCreateArchetype(signature);
+
+	// Cache both way
+	archetype->removeEdges.emplace(cUniqueId, target);
+	target->addEdges.emplace(cUniqueId, archetype);
+
+	return target;
 }
 
-const bool ECS::Manager::removeComponent(Entity* e, const std::type_info& t, const C_ID componentId)
+unsigned int ECS::Manager::moveEntity(const E_ID entityId, EntityRecord & record, Archetype * target)
 {
-	if (e == nullptr) return false;
+	Archetype* source = record.archetype;
+	const unsigned int sourceRow = record.row;
 
-	// Reject null component
-	if (componentId == ECS::INVALID_C_ID) return false;
+	const unsigned int targetRow = target->pushEntity(entityId);
 
-	// Get component unique id
-	C_UNIQUE_ID cUniqueId = this->getComponentUniqueId(t);
-	if (cUniqueId == ECS::INVALID_C_UNIQUE_ID)
+	// Move components that both have
+	for (auto& column : target->columns)
 	{
-		// Bad component type
-		return false;
-	}
+		Column* sourceColumn = source->getColumn(column.cUniqueId);
 
-	// Find component
-	unsigned int index = 0;
-	for (auto& component : this->components[cUniqueId]->pool)
-	{
-		if (component == nullptr)
+		if (sourceColumn)
 		{
-			continue;
+			column.info->moveConstruct(column.get(targetRow), sourceColumn->get(sourceRow));
 		}
+	}
 
-		if (component->id == componentId)
-		{
-			// Found the component. 
-			if (component->ownerId == e->id)
-			{
-				// Owner match
-				Component* c = component.release();
-				component = nullptr;
-				this->components[cUniqueId]->nextIndicies.push_front(index);
-				delete c;
-				e->componentIndicies.at(cUniqueId).erase(index);
-
-				if (e->componentIndicies.at(cUniqueId).empty())
-				{
-					e->signature[cUniqueId] = 0;
-				}
+	// Destroys moved from components and components that target doesn't have
+	const E_ID movedEntityId = source->swapRemove(sourceRow);
 
-				return true;
-			}
-			else
-			{
-				return false;
-			}
-		}
-
-		index++;
+	if (movedEntityId != ECS::INVALID_E_ID)
+	{
+		getRecordAt(ECS::getEntityIndex(movedEntityId)).row = sourceRow;
 	}
 
-	return false;
+	record.archetype = target;
+	record.row = targetRow;
+
+	return targetRow;
 }
 
-const bool ECS::Manager::removeComponent(Entity* e, const std::type_info& t, Component* c)
+E_ID ECS::Manager::createEntity()
 {
-	if (e == nullptr) return false;
-
-	if (c == nullptr) return false;
-	if (c->id == ECS::INVALID_C_ID) return false;
-	if (c->index == ECS::INVALID_C_INDEX) return false;
-	if (c->uniqueId != this->getComponentUniqueId(t)) return false;
-	if (c->ownerId != e->id) return false;
-
-	// Get component unique id
-	C_UNIQUE_ID cUniqueId = c->uniqueId;
+	return allocateEntity(this->emptyArchetype);
+}
 
-	if (e->signature[cUniqueId] == 0)
+const bool ECS::Manager::killEntity(const E_ID entityId)
+{
+	EntityRecord* record = getEntityRecord(entityId);
+	if (record == nullptr)
 	{
 		return false;
 	}
 
-	if (this->components[cUniqueId]->pool.at(c->index) != nullptr)
-	{
-		auto comp = this->components[cUniqueId]->pool.at(c->index).release();
-		this->components[cUniqueId]->pool.at(c->index) = nullptr;
-		delete comp;
-		this->components[cUniqueId]->nextIndicies.push_front(c->index);
-		e->componentIndicies.at(cUniqueId).erase(c->index);
+	const E_ID movedEntityId = record->archetype->swapRemove(record->row);
 
-		if (e->componentIndicies.at(cUniqueId).empty())
-		{
-			e->signature[cUniqueId] = 0;
-		}
-	}
-	else
+	if (movedEntityId != ECS::INVALID_E_ID)
 	{
-		return false;
+		getRecordAt(ECS::getEntityIndex(movedEntityId)).row = record->row;
 	}
 
+	// Ids that still point this entity are stale from now
+	record->generation = (record->generation + 1) & ECS::E_ID_GENERATION_MASK;
+	pushFreeRecord(ECS::getEntityIndex(entityId));
+
+	this->aliveEntityCount--;
+
 	return true;
 }
 
-const bool ECS::Manager::removeComponents(Entity* e, const std::type_info& t)
+const bool ECS::Manager::isAlive(const E_ID entityId)
 {
-	if (e == nullptr) return false;
+	return getEntityRecord(entityId) != nullptr;
+}
 
-	// Get component unique id
-	C_UNIQUE_ID cUniqueId = this->getComponentUniqueId(t);
-	if (cUniqueId == ECS::INVALID_C_UNIQUE_ID)
-	{
-		// Bad component type
-		return false;
-	}
+const unsigned int ECS::Manager::getEntityCount()
+{
+	return this->aliveEntityCount;
+}
 
-	if (e->signature[cUniqueId] == 0)
+const Signature ECS::Manager::getSignature(const E_ID entityId)
+{
+	EntityRecord* record = getEntityRecord(entityId);
+	if (record == nullptr)
 	{
-		return false;
+		return Signature();
 	}
 
-	std::unordered_set<C_INDEX> cIndicies;
-	e->getComponentIndiicesByUniqueId(cUniqueId, cIndicies);
+	return record->archetype->signature;
+}
 
-	if (cIndicies.empty())
-	{
-		return false;
-	}
-	else
+void ECS::Manager::getMatchingArchetypes(const Signature & signature, std::vector<Archetype*>& matchingArchetypes)
+{
+	matchingArchetypes.clear();
+
+	for (auto& archetype : this->archetypes)
 	{
-		for (C_INDEX index : cIndicies)
+		if ((archetype->signature & signature) == signature)
 		{
-			if (this->components[cUniqueId]->pool.at(index) != nullptr)
-			{
-				Component* c = this->components[cUniqueId]->pool.at(index).release();
-				this->components[cUniqueId]->pool.at(index) = nullptr;
-				delete c;
-			}
+			matchingArchetypes.push_back(archetype.get());
 		}
-
-		e->signature[cUniqueId] = 0;
-		e->componentIndicies.erase(cUniqueId);
 	}
-
-	return true;
 }
 
-const S_ID ECS::Manager::registerSystem(const std::type_info & t)
+const unsigned int ECS::Manager::getArchetypeCount()
 {
-	S_ID systemId = this->getSystemId(t);
-	if (systemId == ECS::INVALID_S_ID)
-	{
-		systemId = System::idCounter++;
-		if (systemId == ECS::MAX_S_ID)
-		{
-			System::idCounter--;
-			return ECS::INVALID_S_ID;
-		}
+	return static_cast<unsigned int>(this->archetypes.size());
+}
 
-		this->S_IDMap.insert(std::pair<std::type_index, S_ID>(std::type_index(t), systemId));
-	}
-	else
-	{
-		// Reject same system going in
-		for (auto& system : this->systems)
-		{
-			if (system.second->getId() == systemId)
-			{
-				return ECS::INVALID_S_ID;
-			}
-		}
-	}
+const size_t ECS::Manager::getComponentMemoryUsage()
+{
+	return this->blockAllocator.getReservedBytes();
+}
 
-	return systemId;
+void ECS::Manager::releaseFreeMemory()
+{
+	this->blockAllocator.releaseFreeBlocks();
 }
 
-const bool ECS::Manager::deleteSystem(System*& s, const std::type_info& t)
+bool ECS::Manager::deleteSystem(System * system)
 {
-	if (s == nullptr)
+	if (system == nullptr)
 	{
 		return false;
 	}
 
-	if (s->getId() == ECS::INVALID_S_ID)
-	{
-		delete s;
-		s = nullptr;
-		return true;
-	}
-	else
+	auto find_it = this->systems.find(system->priority);
+	if (find_it != this->systems.end() && find_it->second.get() == system)
 	{
-		auto it = this->systems.begin();
-		for (; it != this->systems.end(); )
-		{ 
-			if ((*it).second->getId() == s->getId())
-			{
-				// found
-				this->systems.erase(it);
-				s = nullptr;
-				return true;
-			}
-		}
-
-		// not found
-		delete s;
-		s = nullptr;
+		this->systems.erase(find_it);
+		this->scheduleDirty = true;
 		return true;
 	}
 
 	return false;
 }
 
-const bool ECS::Manager::hasSystem(const std::type_info& t)
-{
-    const S_ID sId = this->getSystemId(t);
-    
-    for (auto& system : this->systems)
-    {
-        if (system.second->getId() == sId)
-        {
-            return true;
-        }
-    }
-    
-    return false;
-}
-
-const bool ECS::Manager::hasSystem(ECS::System *s, const std::type_info &t)
-{
-    if (s == nullptr || s->getId() == ECS::INVALID_S_ID)
-    {
-        return false;
-    }
-    
-    for (auto& system : this->systems)
-    {
-        if(system.second->getId() == s->getId())
-        {
-            return true;
-        }
-    }
-    
-    return false;
-}
-
-ECS::System* ECS::Manager::getSystem(const std::type_info &t)
-{
-    const S_ID sId = this->getSystemId(t);
-    for(auto& system :  this->systems)
-    {
-        if(system.second->getId() == sId)
-        {
-            return system.second.get();
-        }
-    }
-    
-    return nullptr;
+System * ECS::Manager::getSystem(const S_ID systemId)
+{
+	for (auto& system : this->systems)
+	{
+		if (system.second->id == systemId)
+		{
+			return system.second.get();
+		}
+	}
+
+	return nullptr;
 }
 
 std::map<int, S_ID> ECS::Manager::getSystemUpdateOrder()
@@ -1085,228 +807,126 @@ std::map<int, S_ID> ECS::Manager::getSystemUpdateOrder()
 
 	for (auto& system : this->systems)
 	{
-		order.insert(std::pair<int, S_ID>(system.first, system.second->getId()));
+		order.emplace(system.first, system.second->id);
 	}
 
 	return order;
 }
 
-void ECS::Manager::clear()
+std::vector<std::vector<S_ID>> ECS::Manager::getSystemSchedule()
 {
-	ECS::Manager::EntityPool* defaultPool = this->entityPools.at(ECS::DEFAULT_ENTITY_POOL_NAME).release();
-	this->entityPools.clear();
-
-	defaultPool->nextIndicies.clear();
-
-	const unsigned int size = defaultPool->pool.size();
-
-	for (unsigned int i = 0; i < size; i++)
+	if (this->scheduleDirty)
 	{
-		defaultPool->pool.at(i)->id = ECS::INVALID_E_ID;
-		defaultPool->pool.at(i)->componentIndicies.clear();
-		defaultPool->pool.at(i)->signature = 0;
-		defaultPool->pool.at(i)->index = i;
-		defaultPool->pool.at(i)->alive = false;
-		defaultPool->nextIndicies.push_back(i);
+		buildSchedule();
 	}
 
-	defaultPool->idCounter = 0;
-
-	this->entityPools.insert(std::pair<std::string, std::unique_ptr<ECS::Manager::EntityPool>>(ECS::DEFAULT_ENTITY_POOL_NAME, std::unique_ptr<ECS::Manager::EntityPool>(defaultPool)));
-
-	this->components.clear();
-	this->C_UNIQUE_IDMap.clear();
-
-	this->systems.clear();
-	this->S_IDMap.clear();
-
-	System::idCounter = 0;
-	Component::uniqueIdCounter = 0;
-}
-
-void ECS::Manager::printComponentsInfo()
-{
-	std::cout << std::endl;
-	std::cout << "ECS::Printing Components informations" << std::endl;
-	std::cout << "Total Component types: " << this->C_UNIQUE_IDMap.size() << std::endl;
-	std::cout << "Types -------------------------------" << std::endl;
+	std::vector<std::vector<S_ID>> stages;
 
-	for (auto type : this->C_UNIQUE_IDMap)
+	for (auto& stage : this->schedule)
 	{
-		const unsigned int size = this->components.at(type.second)->pool.size();
-		int aliveCount = 0;
-		for (auto& c : this->components.at(type.second)->pool)
-		{
-			if (c != nullptr)
-			{
-				aliveCount++;
-			}
-		}
+		stages.push_back(std::vector<S_ID>());
 
-		std::cout << "Name: " << type.first.name() << ", Unique ID: " << type.second << ", Count/Size: " << aliveCount << "/" << size << std::endl;
-		std::cout << "-- Component details. Unique ID: " << type.second << " --" << std::endl;
-		for (unsigned int i = 0; i < size; i++)
+		for (auto system : stage)
 		{
-			if (this->components.at(type.second)->pool.at(i) == nullptr)
-			{
-				std::cout << "__EMPTY__" << std::endl;
-			}
-			else
-			{
-				std::cout << "ID: " << this->components.at(type.second)->pool.at(i)->getId() << ", Owner ID = " << this->components.at(type.second)->pool.at(i)->ownerId << std::endl;
-			}
+			stages.back().push_back(system->id);
 		}
-		std::cout << "-------------------------------------" << std::endl;
 	}
 
-	std::cout << "-------------------------------------" << std::endl;
-	std::cout << std::endl;
+	return stages;
 }
 
-//============================================================================================
-
-ECS::Manager* ECS::Entity::manager = nullptr;
-
-ECS::Entity::Entity()
-: alive(false)
-, sleep(false)
-, id(ECS::INVALID_E_ID)
-, index(-1)
-, signature(0)
-, entityPoolName(std::string())
-{}
-
-void ECS::Entity::getComponentIndiicesByUniqueId(const C_UNIQUE_ID cUniqueId, std::unordered_set<C_INDEX>& cIndicies)
+void ECS::Manager::setThreadPool(Voxel::ThreadPool * threadPool)
 {
-	try
-	{
-		//for (auto index : this->componentIndicies.at(cUniqueId))
-		//{
-		//	cIndicies.insert(index);
-		//}
-		cIndicies = this->componentIndicies.at(cUniqueId);
-	}
-	catch (...)// (const std::out_of_range& oor)
-	{
-		// Doesn't exist. return.
-		///std::cout << oor.what() << std::endl;
-		return;
-	}
+	this->threadPool = threadPool;
 }
 
-void ECS::Entity::revive(const E_ID newId)
+Voxel::ThreadPool * ECS::Manager::getThreadPool()
 {
-	this->alive = true;
-	this->sleep = false;
-	this->id = newId;
+	return this->threadPool;
 }
 
-void ECS::Entity::kill()
+void ECS::Manager::clear()
 {
-	ECS::Manager* m = Manager::getInstance();
-	m->killEntity(this);
-}
+	this->systems.clear();
+	this->schedule.clear();
+	this->scheduleDirty = true;
 
-const E_ID ECS::Entity::getId()
-{
-	return this->id;
-}
+	// Destroys all components
+	this->archetypeMap.clear();
+	this->archetypes.clear();
 
-const std::string ECS::Entity::getEntityPoolName()
-{
-	return this->entityPoolName;
-}
+	// Keep records, so ids from before clear stay stale. All records become free in index order.
+	this->freeRecordHead = ECS::INVALID_E_ID;
+	this->freeRecordTail = ECS::INVALID_E_ID;
 
-const bool ECS::Entity::isAlive()
-{
-	return this->alive;
-}
+	for (unsigned int i = 0; i < this->entityRecordCount; i++)
+	{
+		EntityRecord& record = getRecordAt(i);
 
-const Signature ECS::Entity::getSignature()
-{
-	return this->signature;
-}
+		if (record.archetype)
+		{
+			record.generation = (record.generation + 1) & ECS::E_ID_GENERATION_MASK;
+		}
 
-//============================================================================================
+		pushFreeRecord(i);
+	}
 
-C_ID ECS::Component::uniqueIdCounter = 0;
-ECS::Manager* ECS::Component::manager = nullptr;
+	this->aliveEntityCount = 0;
 
-Component::Component() 
-: id(INVALID_C_ID) 
-, index(INVALID_C_INDEX)
-, uniqueId(INVALID_C_UNIQUE_ID)
-, ownerId(INVALID_E_ID)
-{}
+	this->emptyArchetype = getOrCreateArchetype(Signature());
+}
 
-void ECS::Component::wrapUniqueIdCounter()
+void ECS::Manager::printArchetypesInfo()
 {
-	if (Component::uniqueIdCounter >= INVALID_C_UNIQUE_ID)
+	std::cout << "[ECS] Entities: " << this->aliveEntityCount << ", archetypes: " << this->archetypes.size() << ", component memory: " << this->blockAllocator.getUsedBytes() << " / " << this->blockAllocator.getReservedBytes() << " bytes\n";
+
+	for (auto& archetype : this->archetypes)
 	{
-		Component::uniqueIdCounter = 0;
+		std::cout << "  Archetype (" << archetype->getSize() << " entities):";
+
+		for (auto& column : archetype->columns)
+		{
+			std::cout << " " << column.info->name;
+		}
+
+		std::cout << "\n";
 	}
 }
 
-const C_ID ECS::Component::getId()
+void ECS::Manager::printSystemSchedule()
 {
-	return this->id;
-}
+	auto stages = getSystemSchedule();
 
-const C_UNIQUE_ID ECS::Component::getUniqueId()
-{
-	return this->uniqueId;
-}
+	std::cout << "[ECS] System stages: " << stages.size() << "\n";
 
-const E_ID ECS::Component::getOwnerId()
-{
-	return this->ownerId;
-}
+	for (unsigned int i = 0; i < stages.size(); i++)
+	{
+		std::cout << "  Stage " << i << ":";
 
-//============================================================================================
+		for (auto systemId : stages.at(i))
+		{
+			std::cout << " " << systemId;
+		}
 
-S_ID ECS::System::idCounter = 0;
-ECS::Manager* ECS::System::manager = nullptr;
+		std::cout << "\n";
+	}
+}
+
+// ======================================== SYSTEM ========================================
 
 ECS::System::System(const int priority)
-: id(ECS::INVALID_S_ID)
-, signature(0)
-, entityPoolNames({ ECS::DEFAULT_ENTITY_POOL_NAME })
-, priority(priority)
-, active(true)
-, queriesDefaultPool(true)
+	: id(ECS::INVALID_S_ID)
+	, priority(priority)
+	, active(true)
+	, exclusive(false)
 {}
 
-ECS::System::System(const int priority, std::initializer_list<C_UNIQUE_ID> componentUniqueIds, std::initializer_list<std::string> entityPoolNames)
-: id(ECS::INVALID_S_ID)
-, signature(0)
-, entityPoolNames(entityPoolNames)
-, priority(priority)
-, active(true)
-, queriesDefaultPool(true)
+void ECS::System::invalidateSchedule()
 {
-	for (auto cId : componentUniqueIds)
-	{
-		try
-		{
-			signature.test(cId);
-			signature[cId] = 1;
-		}
-		catch (...)// (const std::out_of_range& oor)
-		{
-			//std::cout << oor.what() << std::endl;
-			continue;
-		}
-	}
-
-	for (auto poolName : this->entityPoolNames)
+	if (ECS::System::manager)
 	{
-		if (poolName == ECS::DEFAULT_ENTITY_POOL_NAME)
-		{
-			return;
-		}
+		ECS::System::manager->scheduleDirty = true;
 	}
-
-	this->entityPoolNames.push_back(ECS::DEFAULT_ENTITY_POOL_NAME);
 }
 
 const S_ID ECS::System::getId()
@@ -1324,43 +944,36 @@ const int ECS::System::getPriority()
 	return this->priority;
 }
 
-void ECS::System::disbaleDefafultEntityPool()
+const Signature ECS::System::getReadSignature()
 {
-	this->queriesDefaultPool = false;
+	return this->readSignature;
 }
 
-void ECS::System::enableDefaultEntityPool()
+const Signature ECS::System::getWriteSignature()
 {
-	this->queriesDefaultPool = true;
+	return this->writeSignature;
 }
 
-const bool ECS::System::addEntityPoolName(const std::string& entityPoolName)
+void ECS::System::setExclusive(const bool exclusive)
 {
-	auto find_it = std::find(this->entityPoolNames.begin(), this->entityPoolNames.end(), entityPoolName);
-	if (find_it == this->entityPoolNames.end())
-	{
-		this->entityPoolNames.push_back(entityPoolName);
-		return true;
-	}
-	else
-	{
-		return false;
-	}
+	this->exclusive = exclusive;
+	this->invalidateSchedule();
 }
 
-const bool ECS::System::removeEntityPoolName(const std::string & entityPoolName)
+const bool ECS::System::isExclusive()
 {
-	auto it = this->entityPoolNames.begin();
-	for (; it != this->entityPoolNames.end();)
+	return this->exclusive;
+}
+
+const bool ECS::System::conflictsWith(const System & other) const
+{
+	if (this->exclusive || other.exclusive)
 	{
-		if ((*it) == entityPoolName)
-		{
-			this->entityPoolNames.erase(it);
-			return true;
-		}
+		return true;
 	}
 
-	return false;
+	// Write conflicts with any read or write of same type. Reads don't conflict each other.
+	return (this->writeSignature & other.signature).any() || (other.writeSignature & this->signature).any();
 }
 
 void ECS::System::deactivate()
@@ -3,32 +3,32 @@
 
 // containers
 #include <vector>
-#include <list>
-#include <deque>
+#include <map>
 #include <unordered_map>
-#include <unordered_set>	
-#include <map>  
+#include <tuple>
 
 // Util
 #include <memory>			   // unique_ptr
-#include <functional>		   // Error handling
+#include <new>				  // placement new
+#include <cstdlib>			  // malloc
 #include <bitset>			   // Signature
 #include <limits>
-#include <stdexcept>
-#include <cmath>				// power of 2
+#include <mutex>				// Component type registry
+#include <utility>			  // index_sequence
+#include <type_traits>
+#include <typeinfo>
 #include <iostream>
-#include <initializer_list>
-#include <chrono>
+#include <cassert>
 
-// Component
-#include <typeinfo>
-#include <typeindex>
+// voxel
+#include "ThreadPool.h"
 
 namespace ECS
 {
 	// Classes
-	class Entity;
-	class Component;
+	class BlockAllocator;
+	class Column;
+	class Archetype;
 	class Manager;
 	class System;
 }
@@ -36,63 +36,350 @@ namespace ECS
 namespace ECS
 {
 	// Const
-	// Maximum number of component id.
-	const unsigned int MAX_C_ID = std::numeric_limits<unsigned int>::max();
-	// Invalid component id
-	const unsigned int INVALID_C_ID = MAX_C_ID;
-
-	// Maximum number of component index
-	const unsigned int MAX_C_INDEX = std::numeric_limits<unsigned int>::max();
-	// Invalid component index
-	const unsigned int INVALID_C_INDEX = MAX_C_INDEX;
-
 	// Maximum number of component unique id
 	const unsigned int MAX_C_UNIQUE_ID = 256;
 	// Invalid component unique id
 	const unsigned int INVALID_C_UNIQUE_ID = MAX_C_UNIQUE_ID;
 
-	// Maximum number of entity id
-	const unsigned long MAX_E_ID = std::numeric_limits<unsigned long>::max();
+	// Invalid column index in archetype
+	const unsigned int INVALID_COLUMN_INDEX = std::numeric_limits<unsigned int>::max();
+
+	// Number of low bits in entity id that is index of entity record. Rest of bits are generation.
+	const unsigned int E_ID_INDEX_BITS = 20;
+	const unsigned int E_ID_INDEX_MASK = (1u << E_ID_INDEX_BITS) - 1;
+	const unsigned int E_ID_GENERATION_MASK = (1u << (32 - E_ID_INDEX_BITS)) - 1;
+	// Maximum number of entities. Last index is reserved for invalid id.
+	const unsigned int MAX_E_ID = E_ID_INDEX_MASK;
 	// Invalid entity id
-	const unsigned long INVALID_E_ID = MAX_E_ID;
+	const unsigned int INVALID_E_ID = std::numeric_limits<unsigned int>::max();
+
+	// Number of entity records in each page
+	const unsigned int ENTITY_RECORD_PAGE_SIZE = 4096;
 
 	// maximum number of system id
 	const unsigned int MAX_S_ID = std::numeric_limits<unsigned int>::max();
-	// Invalid component id
+	// Invalid system id
 	const unsigned int INVALID_S_ID = MAX_S_ID;
 
-	// Default pool string name
-	const std::string DEFAULT_ENTITY_POOL_NAME = "DEFAULT";
-	// Default EntityPool size
-	const unsigned int DEFAULT_ENTITY_POOL_SIZE = 2048;
-	// Default ComponentPool size
-	const unsigned int DEFAULT_COMPONENT_POOL_SIZE = 4096;
+	// Number of rows that column reserves on first push
+	const unsigned int DEFAULT_COLUMN_CAPACITY = 64;
+
+	// Smallest block that block allocator gives. Size classes are power of two from this.
+	const size_t MIN_BLOCK_SIZE = 256;
+	// Number of block size classes
+	const unsigned int BLOCK_SIZE_CLASS_COUNT = 40;
+
+	// Number of rows that each range of parallelForEach handles by default
+	const unsigned int DEFAULT_PARALLEL_GRAIN_SIZE = 1024;
 
 	// Typedefs
-	typedef unsigned long E_ID;						 // Entity ID. 
-	typedef unsigned int E_INDEX;					   // Entity Index
-	typedef unsigned int C_ID;						  // Component ID
-	typedef unsigned int C_UNIQUE_ID;				   // Component unique ID
-	typedef unsigned int C_INDEX;					   // Component Index
+	typedef unsigned int E_ID;						  // Entity ID. Index of entity record and generation.
+	typedef unsigned int C_UNIQUE_ID;				   // Component unique ID. Same for all components of same type.
 	typedef unsigned int S_ID;						  // System id
 	typedef std::bitset<MAX_C_UNIQUE_ID> Signature;
 
+	// Get index of entity record from entity id
+	inline unsigned int getEntityIndex(const E_ID entityId) { return entityId & E_ID_INDEX_MASK; }
+	// Get generation from entity id
+	inline unsigned int getEntityGeneration(const E_ID entityId) { return entityId >> E_ID_INDEX_BITS; }
+	// Builds entity id from record index and generation
+	inline E_ID makeEntityId(const unsigned int index, const unsigned int generation) { return ((generation & E_ID_GENERATION_MASK) << E_ID_INDEX_BITS) | (index & E_ID_INDEX_MASK); }
+
 	// Custom deleter for unique_ptr.
 	// By making this, user can't call destructor(delete) on any instances.
 	template<class T> class Deleter
 	{
 		friend std::unique_ptr<ECS::Manager, Deleter>;
-		friend std::unique_ptr<ECS::Entity, Deleter>;
-		friend std::unique_ptr<ECS::Component, Deleter>;
 		friend std::unique_ptr<ECS::System, Deleter>;
 	private:
 		void operator()(T* t) { delete t; }
 	};
 
+	/**
+	*  @struct ComponentInfo
+	*  @brief Type erased information of component type. Column uses this to move and destroy components without knowing the type.
+	*  @note Function pointers are only called when entity changes archetype or column grows. Iteration never calls them.
+	*/
+	struct ComponentInfo
+	{
+		// sizeof
+		size_t size;
+		// alignof
+		size_t align;
+		// True if component can be moved with memcpy and doesn't need destructor
+		bool trivial;
+		// Move constructs component from src to uninitialized dst.
+		void(*moveConstruct)(void* dst, void* src);
+		// Calls destructor
+		void(*destroy)(void* ptr);
+		// Type name for debug
+		const char* name;
+	};
+
+	/**
+	*  @class ComponentRegistry
+	*  @brief Gives unique id to each component type.
+	*
+	*  Each component type gets its id on first call of getComponentUniqueId<T>() and keeps it until end of program.
+	*  Ids are dense starting from 0, so they can be used as index of signature and arrays.
+	*/
+	class ComponentRegistry
+	{
+	private:
+		// Info of all registered types. Index is unique id.
+		static std::vector<ComponentInfo>& getInfos();
+
+		// Lock for registering. Types can be registered from any thread.
+		static std::mutex& getMutex();
+	public:
+		// Registers new type and returns its unique id. Returns INVALID_C_UNIQUE_ID if there are too many types.
+		static C_UNIQUE_ID registerType(const ComponentInfo& info);
+
+		// Get info of registered type. Id must be valid.
+		static const ComponentInfo& getInfo(const C_UNIQUE_ID cUniqueId);
+
+		// Get number of registered types
+		static unsigned int getCount();
+	};
+
+	// Builds component info of type
+	template<class T> ComponentInfo makeComponentInfo()
+	{
+		ComponentInfo info;
+		info.size = sizeof(T);
+		info.align = alignof(T);
+		info.trivial = std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value;
+		info.moveConstruct = [](void* dst, void* src) { new (dst) T(std::move(*static_cast<T*>(src))); };
+		info.destroy = [](void* ptr) { static_cast<T*>(ptr)->~T(); };
+		info.name = typeid(T).name();
+		return info;
+	}
+
+	// Get unique id of component type. Resolved once per type. No map lookup.
+	template<class T> C_UNIQUE_ID getComponentUniqueId()
+	{
+		static const C_UNIQUE_ID cUniqueId = ComponentRegistry::registerType(makeComponentInfo<T>());
+		return cUniqueId;
+	}
+
+	// Builds signature of component types
+	template<class... Ts> Signature makeSignature()
+	{
+		Signature signature;
+		// Expands to set() for each type
+		int expand[] = { 0, (signature.set(getComponentUniqueId<Ts>()), 0)... };
+		(void)expand;
+		return signature;
+	}
+
+	/**
+	*  @class BlockAllocator
+	*  @brief Gives power of two sized memory blocks and recycles them.
+	*
+	*  Deallocated block goes to free list of its size class and is given again on next allocation of same class.
+	*  Memory only goes back to system on releaseFreeBlocks() or destruction, so once columns are warmed up,
+	*  spawning and killing entities never touches general allocator.
+	*  Not thread safe. Only used on structural changes, which never run concurrently.
+	*/
+	class BlockAllocator
+	{
+	private:
+		// Head of free list of each size class. Size class i has blocks of MIN_BLOCK_SIZE << i bytes.
+		// Free block stores pointer to next free block in its first bytes.
+		std::vector<void*> freeLists;
+
+		// Bytes of all blocks that are allocated from system
+		size_t reservedBytes;
+
+		// Bytes of blocks that are in use
+		size_t usedBytes;
+
+		// Get smallest size class that fits bytes
+		static unsigned int getSizeClass(const size_t bytes);
+	public:
+		// Constructor
+		BlockAllocator();
+
+		// Destructor. Releases free blocks. All blocks must be deallocated before.
+		~BlockAllocator();
+
+		// Disable copy
+		BlockAllocator(const BlockAllocator& arg) = delete;
+		BlockAllocator& operator=(const BlockAllocator& arg) = delete;
+
+		/**
+		*  Allocates block. Reuses free block if there is one.
+		*  @param bytes Minimum size of block.
+		*  @param blockSize Actual size of block. Pass same size to deallocate.
+		*  @return Pointer to block. Aligned to default new alignment.
+		*/
+		void* allocate(const size_t bytes, size_t& blockSize);
+
+		// Returns block to free list
+		void deallocate(void* block, const size_t blockSize);
+
+		// Returns all free blocks to system
+		void releaseFreeBlocks();
+
+		// Get bytes of all blocks that are allocated from system
+		size_t getReservedBytes() const;
+
+		// Get bytes of blocks that are in use
+		size_t getUsedBytes() const;
+	};
+
+	/**
+	*  @class Column
+	*  @brief Contiguous array of single component type in archetype.
+	*
+	*  Memory is raw bytes from block allocator. Components are constructed in place and moved with ComponentInfo.
+	*  Row i of every column in archetype belongs to same entity.
+	*/
+	class Column
+	{
+		friend class Archetype;
+		friend class Manager;
+	private:
+		// Type of component
+		C_UNIQUE_ID cUniqueId;
+		const ComponentInfo* info;
+
+		// Allocator that gives memory
+		BlockAllocator* allocator;
+
+		// Raw memory. Aligned to default new alignment.
+		unsigned char* data;
+
+		// Size of memory block in bytes
+		size_t blockSize;
+
+		// Number of components
+		unsigned int size;
+
+		// Number of components that can be stored without reallocating
+		unsigned int capacity;
+
+		// Reallocates memory and moves all components
+		void reserve(const unsigned int newCapacity);
+	public:
+		// Constructor
+		Column(const C_UNIQUE_ID cUniqueId, BlockAllocator* allocator);
+
+		// Destructor. Destroys all components and returns memory to allocator
+		~Column();
+
+		// Disable copy. Allow move so archetype can keep columns in vector.
+		Column(const Column& arg) = delete;
+		Column& operator=(const Column& arg) = delete;
+		Column(Column&& arg);
+		Column& operator=(Column&& arg) = delete;
+
+		// Get pointer to component at row
+		inline void* get(const unsigned int row) { return data + (row * info->size); }
+
+		// Adds uninitialized row at the end and returns pointer to it. Caller must construct component.
+		void* pushUninitialized();
+
+		// Destroys component at row and moves last component to row.
+		void swapRemove(const unsigned int row);
+
+		// Destroys all components. Keeps memory.
+		void clear();
+
+		// Get component unique id
+		C_UNIQUE_ID getComponentUniqueId() const;
+
+		// Get number of components
+		unsigned int getSize() const;
+	};
+
+	/**
+	*  @class Archetype
+	*  @brief Storage of all entities that have exactly same signature.
+	*
+	*  Each component type in signature has its own column. Entities are packed in rows [0, size).
+	*  Adding or removing component moves entity to other archetype. Edges to other archetypes are cached,
+	*  so finding next archetype is single map lookup after first time.
+	*/
+	class Archetype
+	{
+		friend class Manager;
+	private:
+		// Constructor
+		Archetype(const Signature& signature, BlockAllocator* allocator);
+
+		// Component types in this archetype
+		Signature signature;
+
+		// One column per component type. Sorted by unique id.
+		std::vector<Column> columns;
+
+		// Component unique id to column index. INVALID_COLUMN_INDEX if archetype doesn't have type.
+		std::vector<unsigned int> columnIndices;
+
+		// Entity of each row
+		std::vector<E_ID> entities;
+
+		// Cached archetype that entity moves to when component is added or removed.
+		std::unordered_map<C_UNIQUE_ID, Archetype*> addEdges;
+		std::unordered_map<C_UNIQUE_ID, Archetype*> removeEdges;
+
+		// Adds entity at the end. All columns get uninitialized row.
+		unsigned int pushEntity(const E_ID entityId);
+
+		// Removes row. Returns entity that moved to row. INVALID_E_ID if row was last.
+		E_ID swapRemove(const unsigned int row);
+	public:
+		// Destructor
+		~Archetype() = default;
+
+		// Disable copy
+		Archetype(const Archetype& arg) = delete;
+		Archetype& operator=(const Archetype& arg) = delete;
+
+		// Get signature
+		const Signature& getSignature() const;
+
+		// Get number of entities
+		unsigned int getSize() const;
+
+		// Get entity ids in row order
+		const E_ID* getEntities() const;
+
+		// Check if archetype has component type
+		bool hasColumn(const C_UNIQUE_ID cUniqueId) const;
+
+		// Get column by component unique id. nullptr if archetype doesn't have type.
+		Column* getColumn(const C_UNIQUE_ID cUniqueId);
+
+		// Get contiguous array of component. nullptr if archetype doesn't have type.
+		template<class T> T* getComponents()
+		{
+			const C_UNIQUE_ID cUniqueId = ECS::getComponentUniqueId<T>();
+			const unsigned int columnIndex = columnIndices[cUniqueId];
+
+			if (columnIndex == INVALID_COLUMN_INDEX)
+			{
+				return nullptr;
+			}
+
+			return static_cast<T*>(columns[columnIndex].get(0));
+		}
+	};
+
 	/**
 	*  @class Manager
 	*  @brief The manager class that manages entire ECS.
 	*  @note This is singleton class. The instance automtically released on end of program.
+	*
+	*  Components are plain types (no base class) stored by value in archetypes. Entities with same signature
+	*  share contiguous component arrays, so iterating with forEach() is linear in memory and never calls virtual function.
+	*  Queries never throw. Missing entity or component returns nullptr or false.
+	*
+	*  Entity id is index of entity record plus generation. Killing entity increases generation of record,
+	*  so ids of killed entity are detected as dead even after record is reused.
+	*  Records live in fixed size pages and columns get memory from block allocator. Both are kept and reused,
+	*  so mass spawn and kill don't allocate after warm-up.
 	*/
 	class Manager
 	{
@@ -114,55 +401,95 @@ namespace ECS
 		static std::unique_ptr<Manager, ECS::Deleter<Manager>> instance;
 
 		// ==================================== ENTITY ====================================
-		// Simple struct for entity pool.
-		struct EntityPool
-		{
-			std::vector<std::unique_ptr<ECS::Entity, ECS::Deleter<ECS::Entity>>> pool;
-			std::deque<unsigned int> nextIndicies;
-			int idCounter;
+		// Where entity's components are
+		struct EntityRecord
+		{
+			// nullptr if entity is dead
+			Archetype* archetype;
+			// Row in archetype. If entity is dead, index of next free record.
+			unsigned int row;
+			// Increased on kill, so ids of killed entity don't match anymore.
+			unsigned int generation;
 		};
 
-		std::unordered_map<std::string, std::unique_ptr<EntityPool>> entityPools;
-		void wrapEntityPoolIdCounter(const std::string& poolName);
+		// Records in fixed size pages. Index is index of entity id. Pages never move, so growing doesn't copy records.
+		std::vector<std::unique_ptr<EntityRecord[]>> entityRecordPages;
+		// Number of records that are created
+		unsigned int entityRecordCount;
+		// Dead records are linked through row. Oldest one is reused first so generation wraps as late as possible.
+		unsigned int freeRecordHead;
+		unsigned int freeRecordTail;
+		// Number of alive entities
+		unsigned int aliveEntityCount;
+
+		// Get record by index
+		inline EntityRecord& getRecordAt(const unsigned int index) { return entityRecordPages[index / ENTITY_RECORD_PAGE_SIZE][index % ENTITY_RECORD_PAGE_SIZE]; }
+		// Get record of alive entity. nullptr if id is invalid, entity is dead or id is from killed entity.
+		EntityRecord* getEntityRecord(const E_ID entityId);
+		// Takes free record and adds entity to archetype. All columns get uninitialized row. Returns INVALID_E_ID if there are too many entities.
+		E_ID allocateEntity(Archetype* archetype);
+		// Links record to end of free list
+		void pushFreeRecord(const unsigned int index);
 		// ================================================================================
 
-		// =================================== COMPONENT ==================================
-		struct ComponentPool
+		// =================================== ARCHETYPE ==================================
+		// Memory of all columns. Declared before archetypes so it's destroyed after them.
+		BlockAllocator blockAllocator;
+		// All archetypes. Never deleted until clear.
+		std::vector<std::unique_ptr<Archetype>> archetypes;
+		// Signature to archetype
+		std::unordered_map<Signature, Archetype*> archetypeMap;
+		// Archetype with no component. New entities start here.
+		Archetype* emptyArchetype;
+
+		// Get archetype with signature. Creates new one if doesn't exists.
+		Archetype* getOrCreateArchetype(const Signature& signature);
+
+		// Get archetype that entity moves when component is added or removed
+		Archetype* getAddEdge(Archetype* archetype, const C_UNIQUE_ID cUniqueId);
+		Archetype* getRemoveEdge(Archetype* archetype, const C_UNIQUE_ID cUniqueId);
+
+		/**
+		*  Moves entity to other archetype. Components that both archetype have are moved.
+		*  Components that only target archetype has are left uninitialized in new row.
+		*  @return Row in target archetype.
+		*/
+		unsigned int moveEntity(const E_ID entityId, EntityRecord& record, Archetype* target);
+
+		// Iterates rows [begin, end) in archetype
+		template<class... Ts, class Func, size_t... I> static void forEachInArchetype(Archetype& archetype, Func& func, const unsigned int begin, const unsigned int end, std::index_sequence<I...>)
 		{
-			std::vector<std::unique_ptr<ECS::Component, ECS::Deleter<ECS::Component>>> pool;
-			std::deque<unsigned int> nextIndicies;
-			unsigned int idCounter;
-		};
+			// Base pointer of each column. Resolved once per archetype.
+			auto columns = std::make_tuple(archetype.getComponents<Ts>()...);
+			const E_ID* ids = archetype.getEntities();
 
-		std::vector<std::unique_ptr<ComponentPool>> components;
-		//class type_index <---> CID
-		std::unordered_map<std::type_index, C_UNIQUE_ID> C_UNIQUE_IDMap;
-		void wrapComponentUniqueIdCounter(const C_UNIQUE_ID cUniqueId);
-
-		const C_UNIQUE_ID getComponentUniqueId(const std::type_info& t);
-		const C_UNIQUE_ID registerComponent(const std::type_info& t);
-		const bool deleteComponent(ECS::Component*& c, const std::type_info& t);
-		const bool hasComponent(ECS::Entity* e, const std::type_info& t);
-		const bool hasComponent(ECS::Entity* e, const std::type_info& t, ECS::Component* c);
-		Component* getComponent(ECS::Entity* e, const std::type_info& t);
-		std::vector<ECS::Component*> getComponents(Entity* e, const std::type_info& t);
-		const bool addComponent(ECS::Entity* e, const std::type_info& t, ECS::Component* c);
-		const bool removeComponent(ECS::Entity* e, const std::type_info& t, const C_ID componentId);
-		const bool removeComponent(ECS::Entity* e, const std::type_info& t, ECS::Component* c);
-		const bool removeComponents(ECS::Entity* e, const std::type_info& t);
+			for (unsigned int i = begin; i < end; i++)
+			{
+				func(ids[i], std::get<I>(columns)[i]...);
+			}
+		}
 		// ================================================================================
 
 		// ==================================== SYSTEM ====================================
 		std::map<int/*priority*/, std::unique_ptr<ECS::System, ECS::Deleter<ECS::System>>> systems;
-		// class type_index <---> SID
-		std::unordered_map<std::type_index, S_ID> S_IDMap;
-		const S_ID getSystemId(const std::type_info& t);
-
-		const S_ID registerSystem(const std::type_info& t);
-		const bool deleteSystem(System*& s, const std::type_info& t);
-		const bool hasSystem(const std::type_info& t);
-		const bool hasSystem(System* s, const std::type_info& t);
-		ECS::System* getSystem(const std::type_info& t);
+		// Counter for system id
+		S_ID systemIdCounter;
+		// System id by type. Resolved once per type.
+		template<class T> static S_ID& getSystemTypeId()
+		{
+			static S_ID systemId = INVALID_S_ID;
+			return systemId;
+		}
+
+		// Systems grouped in stages. Systems in same stage don't conflict and run concurrently. Stages run in order.
+		std::vector<std::vector<ECS::System*>> schedule;
+		// True if systems or their component types changed since schedule was built
+		bool scheduleDirty;
+		// Thread pool that runs stages and parallelForEach. nullptr runs everything on calling thread.
+		Voxel::ThreadPool* threadPool;
+
+		// Builds schedule from systems' read and write component types
+		void buildSchedule();
 		// ================================================================================
 	public:
 		// Get instance.
@@ -174,253 +501,275 @@ namespace ECS
 		// Update function. Call this every tick.
 		void update(const float delta);
 
-		// Creates new EntityPool
-		const bool createEntityPool(const std::string& name, const int maxSize = ECS::DEFAULT_ENTITY_POOL_SIZE);
-		// Deletes entitty pool
-		const bool deleteEntityPool(const std::string& name);
-		// Resize entity pool
-		const bool resizeEntityPool(const std::string& entityPoolName, const unsigned int size);
-		// Check if there is pool with same name
-		const bool hasEntityPoolName(const std::string& name);
-		// Get all entity pool names
-		std::vector<std::string> getEntityPoolNames();
-		// Get size of entity Pool
-		const unsigned int getEntityPoolSize(const std::string& name = ECS::DEFAULT_ENTITY_POOL_NAME);
-		// Get alive entity count of entity pool
-		const unsigned int getAliveEntityCountInEntityPool(const std::string& name = ECS::DEFAULT_ENTITY_POOL_NAME);
-		// Check is number is power of 2
-		const bool isPowerOfTwo(const unsigned int n);
-		// Round up the number to power of 2
-		void roundToNearestPowerOfTwo(unsigned int & n);
-
-		// Creates entity and adds to entity pool
-		Entity* createEntity(const std::string& poolName = ECS::DEFAULT_ENTITY_POOL_NAME);
-		// Kill entity
-		const bool killEntity(ECS::Entity* e);
-		// Get entity by id. Returns nullptr if anything is invalid
-		Entity* getEntityById(const E_ID entityId);
-		// Get all entity in pool
-		void getAllEntitiesInPool(std::vector<ECS::Entity*>& entities, const std::string& poolName = ECS::DEFAULT_ENTITY_POOL_NAME);
-		// Get all entities that system updates
-		template<class T>void getAllEntitiesForSystem(std::vector<ECS::Entity*>& entities)
+		// Creates entity with no component
+		E_ID createEntity();
+		/**
+		*  Creates entity with components. Entity is placed directly in its archetype, so components are never moved.
+		*  Component types must be unique.
+		*  @return Entity id. INVALID_E_ID if there are too many entities.
+		*/
+		template<class T, class... Ts> E_ID createEntity(T&& component, Ts&&... components)
 		{
-			unsigned int totalSize = 0;
-			auto system = this->getSystem<T>();
-			if (system != nullptr)
-			{
-				for (auto poolName : system->entityPoolNames)
-				{
-					unsigned int size = this->getAliveEntityCountInEntityPool(poolName);
-					totalSize += size;
-				}
+			const Signature signature = ECS::makeSignature<typename std::decay<T>::type, typename std::decay<Ts>::type...>();
+			assert(signature.count() == sizeof...(Ts) + 1);
 
-				entities.clear();
-				entities.reserve(totalSize);
+			Archetype* archetype = getOrCreateArchetype(signature);
 
-				for (auto poolName : system->entityPoolNames)
-				{
-					std::vector<ECS::Entity*> eVec;
-					this->getAllEntitiesInPool(eVec, poolName);
-					entities.insert(entities.end(), eVec.begin(), eVec.end());
-				}
+			const E_ID entityId = allocateEntity(archetype);
+			if (entityId == INVALID_E_ID)
+			{
+				return INVALID_E_ID;
 			}
+
+			const unsigned int row = getRecordAt(ECS::getEntityIndex(entityId)).row;
+
+			// Expands to placement new for each component
+			new (archetype->getColumn(ECS::getComponentUniqueId<typename std::decay<T>::type>())->get(row)) typename std::decay<T>::type(std::forward<T>(component));
+			int expand[] = { 0, (new (archetype->getColumn(ECS::getComponentUniqueId<typename std::decay<Ts>::type>())->get(row)) typename std::decay<Ts>::type(std::forward<Ts>(components)), 0)... };
+			(void)expand;
+
+			return entityId;
 		}
-		// Move entity to Entity pool
-		const bool moveEntityToEntityPool(ECS::Entity*& entity, const std::string& entityPoolName);
+		// Kill entity. Destroys all components.
+		const bool killEntity(const E_ID entityId);
+		// Check if entity is alive
+		const bool isAlive(const E_ID entityId);
+		// Get number of alive entities
+		const unsigned int getEntityCount();
+		// Get signature of entity. Empty if entity is dead.
+		const Signature getSignature(const E_ID entityId);
 
-		// Create component.
-		template<class T> T* createComponent()
+		// Add component to entity. Constructs component with args. If entity already has component, it's replaced.
+		// @return Pointer to component. nullptr if entity is dead. Pointer is valid until entity changes archetype.
+		template<class T, class... Args> T* addComponent(const E_ID entityId, Args&&... args)
 		{
-			T* t = new T();
-			const C_UNIQUE_ID cUniqueId = this->registerComponent(typeid(T));
+			EntityRecord* record = getEntityRecord(entityId);
+			if (record == nullptr)
+			{
+				return nullptr;
+			}
+
+			const C_UNIQUE_ID cUniqueId = ECS::getComponentUniqueId<T>();
 			if (cUniqueId == INVALID_C_UNIQUE_ID)
 			{
-				delete t;
 				return nullptr;
 			}
-			else
+
+			if (record->archetype->hasColumn(cUniqueId))
 			{
-				t->uniqueId = cUniqueId;
-				return t;
+				// Replace
+				T* component = static_cast<T*>(record->archetype->getColumn(cUniqueId)->get(record->row));
+				*component = T(std::forward<Args>(args)...);
+				return component;
 			}
+
+			Archetype* target = getAddEdge(record->archetype, cUniqueId);
+			const unsigned int row = moveEntity(entityId, *record, target);
+
+			// Only new component is left uninitialized
+			return new (target->getColumn(cUniqueId)->get(row)) T(std::forward<Args>(args)...);
 		}
-		// Delete component.
-		template<class T> bool deleteComponent(T*& component)
+		// Remove component from entity. Returns false if entity doesn't have component.
+		template<class T> const bool removeComponent(const E_ID entityId)
 		{
-			ECS::Component* c = component;
-			bool ret = this->deleteComponent(c, typeid(T));
-			if (ret)
+			EntityRecord* record = getEntityRecord(entityId);
+			if (record == nullptr)
 			{
-				component = nullptr;
+				return false;
 			}
-			return ret;
-		}
-		// Check if entity has this type of component
-		template<class T> bool hasComponent(Entity* e)
-		{
-			return this->hasComponent(e, typeid(T));
-		}
-		// Check if entity has specific component
-		template<class T> bool hasComponent(Entity* e, Component* c)
-		{
-			return this->hasComponent(e, typeid(T), c);
-		}
-		// Check if manager has component type pool
-		template<class T> bool hasComponentType()
-		{
-			return getComponentUniqueId(typeid(T)) != INVALID_C_UNIQUE_ID;
-		}
-		// Get component of this type on entity. Will only return first one if there are more than one smae types of component
-		template<class T> T* getComponent(Entity* e)
-		{
-			return static_cast<T*>(this->getComponent(e, typeid(T)));
-		}
-		// Get all componets of this type on enttiy.
-		template<class T> std::vector<T*> getComponents(Entity* e)
-		{
-			std::vector<T*> ret;
-			std::vector<Component*> component = this->getComponents(e, typeid(T));
 
-			for (auto c : component)
+			const C_UNIQUE_ID cUniqueId = ECS::getComponentUniqueId<T>();
+			if (!record->archetype->hasColumn(cUniqueId))
 			{
-				ret.push_back(static_cast<T*>(c));
+				return false;
 			}
 
-			return ret;
+			moveEntity(entityId, *record, getRemoveEdge(record->archetype, cUniqueId));
+			return true;
 		}
-		// Get all components 
-		template<class T> std::vector<Component*> getAllComponents()
+		// Get component of entity. nullptr if entity is dead or doesn't have component. Pointer is valid until entity changes archetype.
+		template<class T> T* getComponent(const E_ID entityId)
 		{
-			std::vector<Component*> components;
-
-			auto cUniqueID = getComponentUniqueId(typeid(T));
-
-			if (cUniqueID == INVALID_C_UNIQUE_ID)
+			EntityRecord* record = getEntityRecord(entityId);
+			if (record == nullptr)
 			{
-				return components;
+				return nullptr;
 			}
-			else
-			{
-				for (auto& uPtr : this->components[cUniqueID]->pool)
-				{
-					components.push_back(uPtr.get());
-				}
 
-				return components;
+			Column* column = record->archetype->getColumn(ECS::getComponentUniqueId<T>());
+			if (column == nullptr)
+			{
+				return nullptr;
 			}
-		}
-		// Get all component by c unique id
-		std::vector<Component*> getAllComponents(const C_UNIQUE_ID cUniqueID);
 
-		// Add new component to entity.
-		template<class T> bool addComponent(Entity* e)
-		{
-			return this->addComponent(e, typeid(T), createComponent<T>());
-		}
-		// Add existing component to entity
-		template<class T>  const bool addComponent(Entity* e, Component* c)
-		{
-			return this->addComponent(e, typeid(T), c);
-		}
-		// Checks if entity has entity component of this type with id
-		template<class T> bool removeComponent(Entity* e, const C_ID componentId)
-		{
-			return this->removeComponent(e, typeid(T), componentId);
+			return static_cast<T*>(column->get(record->row));
 		}
-		// Remove specific component from entity
-		template<class T> bool removeComponent(Entity* e, Component* c)
+		// Check if entity has component
+		template<class T> const bool hasComponent(const E_ID entityId)
 		{
-			return this->removeComponent(e, typeid(T), c);
+			EntityRecord* record = getEntityRecord(entityId);
+			return record != nullptr && record->archetype->hasColumn(ECS::getComponentUniqueId<T>());
 		}
-		// Remove all compoennts of type
-		template<class T> bool removeComponents(Entity* e)
-		{
-			return this->removeComponents(e, typeid(T));
-		}
-		// Get number of components of type that manager has
-		template<class T> const unsigned int getComponentCount()
+
+		/**
+		*  Calls func(E_ID, Ts&...) for every entity that has all component types.
+		*  Iterates each matching archetype linearly. Do not add, remove component or kill entity in func.
+		*/
+		template<class... Ts, class Func> void forEach(Func&& func)
 		{
-			C_UNIQUE_ID cUniqueId = this->getComponentUniqueId(typeid(T));
-			if (cUniqueId != ECS::INVALID_C_UNIQUE_ID)
+			const Signature signature = ECS::makeSignature<Ts...>();
+
+			for (auto& archetype : archetypes)
 			{
-				const unsigned int poolSize = this->components.at(cUniqueId)->pool.size();
-				const unsigned int nextIndiciesSize = this->components.at(cUniqueId)->nextIndicies.size();
-				return poolSize - nextIndiciesSize;
+				if (archetype->getSize() == 0 || (archetype->signature & signature) != signature)
+				{
+					continue;
+				}
+
+				forEachInArchetype<Ts...>(*archetype, func, 0, archetype->getSize(), std::index_sequence_for<Ts...>{});
 			}
-			else
+		}
+		/**
+		*  Same as forEach, but splits each archetype in ranges and runs them on thread pool.
+		*  func is called from multiple threads, so it must only touch components of entity it gets.
+		*  Runs on calling thread if manager doesn't have thread pool or archetype is smaller than grain size.
+		*  @param func Function to call with (E_ID, Ts&...).
+		*  @param grainSize Number of entities that each range handles.
+		*/
+		template<class... Ts, class Func> void parallelForEach(Func&& func, const unsigned int grainSize = DEFAULT_PARALLEL_GRAIN_SIZE)
+		{
+			const Signature signature = ECS::makeSignature<Ts...>();
+
+			for (auto& archetype : archetypes)
 			{
-				return 0;
+				const unsigned int size = archetype->getSize();
+
+				if (size == 0 || (archetype->signature & signature) != signature)
+				{
+					continue;
+				}
+
+				if (threadPool == nullptr || size <= grainSize)
+				{
+					forEachInArchetype<Ts...>(*archetype, func, 0, size, std::index_sequence_for<Ts...>{});
+				}
+				else
+				{
+					Archetype* archetypePtr = archetype.get();
+
+					threadPool->parallelFor(size, grainSize, [archetypePtr, &func](const unsigned int begin, const unsigned int end)
+					{
+						forEachInArchetype<Ts...>(*archetypePtr, func, begin, end, std::index_sequence_for<Ts...>{});
+					});
+				}
 			}
 		}
+		// Get all archetypes that has all component types in signature
+		void getMatchingArchetypes(const Signature& signature, std::vector<Archetype*>& matchingArchetypes);
+		// Get number of archetypes
+		const unsigned int getArchetypeCount();
+		// Get bytes that component columns reserved. Includes free blocks.
+		const size_t getComponentMemoryUsage();
+		// Returns free component memory to system. Next spawns allocate again.
+		void releaseFreeMemory();
 
-		// Creates new system and adds to manager
+		// Creates new system and adds to manager. Returns nullptr if system with same type or priority exists.
 		template<class T> T* createSystem()
 		{
+			S_ID& systemId = getSystemTypeId<T>();
+
+			if (systemId != INVALID_S_ID && this->hasSystem<T>())
+			{
+				// Already exists
+				return nullptr;
+			}
+
 			T* t = new T();
-			const S_ID systemId = this->registerSystem(typeid(T));
-			if (systemId == ECS::INVALID_S_ID)
+
+			auto find_it = this->systems.find(t->priority);
+			if (find_it != this->systems.end())
 			{
+				// Already have other system with same priority.
 				delete t;
 				return nullptr;
 			}
-			else
+
+			if (systemId == INVALID_S_ID)
 			{
-				t->id = systemId;
+				systemId = systemIdCounter++;
+			}
 
-				auto find_it = this->systems.find(t->priority);
-				if (find_it != this->systems.end())
-				{
-					// Already have other system with same priority.
-					delete t;
-					return nullptr;
-				}
+			t->id = systemId;
 
-				this->systems.insert(std::pair<int, std::unique_ptr<ECS::System, ECS::Deleter<ECS::System>>>(t->priority, std::unique_ptr<ECS::System, ECS::Deleter<ECS::System>>(t, ECS::Deleter<ECS::System>())));
+			this->systems.insert(std::pair<int, std::unique_ptr<ECS::System, ECS::Deleter<ECS::System>>>(t->priority, std::unique_ptr<ECS::System, ECS::Deleter<ECS::System>>(t, ECS::Deleter<ECS::System>())));
+			this->scheduleDirty = true;
 
-				return t;
-			}
+			return t;
 		}
 		// Deletes system
 		template<class T> bool deleteSystem(T*& system)
 		{
 			ECS::System* s = system;
-			bool ret = this->deleteSystem(s, typeid(T));
+			bool ret = this->deleteSystem(s);
 			if (ret)
 			{
 				system = nullptr;
 			}
 			return ret;
 		}
+		// Deletes system
+		bool deleteSystem(System* system);
 		// Check if manager has this type of system
 		template<class T> bool hasSystem()
 		{
-			return this->hasSystem(typeid(T));
+			return this->getSystem<T>() != nullptr;
 		}
-		// Check if manager has specific system
-		template<class T> bool hasSystem(ECS::System* system)
-		{
-			return this->hasSystem(system, typeid(T));
-		}
-		// Get system
+		// Get system. nullptr if manager doesn't have system
 		template<class T> T* getSystem()
 		{
-			ECS::System* s = this->getSystem(typeid(T));
-			return static_cast<T*>(s);
+			const S_ID systemId = getSystemTypeId<T>();
+			if (systemId == INVALID_S_ID)
+			{
+				return nullptr;
+			}
+
+			return static_cast<T*>(this->getSystem(systemId));
 		}
+		// Get system by id. nullptr if manager doesn't have system
+		System* getSystem(const S_ID systemId);
 		// Get system update order
 		std::map<int, S_ID> getSystemUpdateOrder();
+		// Get system ids in each stage. Systems in same stage run concurrently.
+		std::vector<std::vector<S_ID>> getSystemSchedule();
+
+		/**
+		*  Set thread pool that runs systems and parallelForEach. Manager doesn't own pool.
+		*  @param threadPool Thread pool. nullptr to run everything on calling thread.
+		*/
+		void setThreadPool(Voxel::ThreadPool* threadPool);
+		// Get thread pool. nullptr if manager runs on calling thread.
+		Voxel::ThreadPool* getThreadPool();
 
 		// Clear manager and resets. Everything gets wiped
 		void clear();
 
-		// Print component information. For debug
-		void printComponentsInfo();
+		// Print archetype information. For debug
+		void printArchetypesInfo();
+		// Print stages of system schedule. For debug
+		void printSystemSchedule();
 	};
 
 
 	/**
 	*  @class System
 	*  @brief Contains logic and process entities.
+	*
+	*  System iterates entities with Manager::forEach in update. Signature tells which component types system uses.
+	*
+	*  System declares component types that it reads and writes. Manager runs systems that don't write
+	*  what other system reads or writes in same stage on thread pool. Systems that conflict run in priority order.
+	*  System that creates or kills entity, or adds or removes component must be exclusive, because it moves
+	*  components that other systems are iterating.
 	*/
 	class System
 	{
@@ -430,22 +779,16 @@ namespace ECS
 	protected:
 		/**
 		*  @name System
-		*  @brief Default constructor
+		*  @brief Constructor
+		*  @param priority Update order. Lower updates first. Must be unique.
 		*/
 		System(const int priority);
-		/**
-		*  @name System
-		*  @brief Constructor for system.
-		*  @param componentUniqueIds Component unique ids that this system uses.
-		*  @param entityPoolNames Entity Pool names that this system will query. Automatically queries default pool. @see disableDefaultEntityPool to disable.
-		*/
-		System(const int priority, std::initializer_list<C_UNIQUE_ID> componentUniqueIds, std::initializer_list<std::string> entityPoolNames);
 
 		// ptr to manager
 		static ECS::Manager* manager;
 
 		// override new and delete to prevent user creating system on their side.
-		void* operator new(size_t sz) throw (std::bad_alloc)
+		void* operator new(size_t sz)
 		{
 			void* mem = std::malloc(sz);
 			if (mem)
@@ -458,13 +801,20 @@ namespace ECS
 			std::free(ptr);
 		}
 	private:
-		static S_ID idCounter;
 		S_ID id;
+		// All component types that system uses. Union of read and write.
 		Signature signature;
-		bool queriesDefaultPool;
-		std::list<std::string> entityPoolNames;
+		// Component types that system only reads
+		Signature readSignature;
+		// Component types that system modifies
+		Signature writeSignature;
 		int priority;
 		bool active;
+		// True if system runs alone in its stage
+		bool exclusive;
+
+		// Marks manager's schedule to be rebuilt
+		void invalidateSchedule();
 	public:
 		// Virtual destructor
 		virtual ~System() = default;
@@ -474,253 +824,80 @@ namespace ECS
 		const Signature getSignature();
 		// Get system priority
 		const int getPriority();
-		// Toggle system to use default entity pool or not
-		void disbaleDefafultEntityPool();
-		void enableDefaultEntityPool();
-		// Add or remove entity pool name that this system will process
-		const bool addEntityPoolName(const std::string& entityPoolName);
-		const bool removeEntityPoolName(const std::string& entityPoolName);
-
-		// Add component type to this system.
+
+		// Get component types that system reads
+		const Signature getReadSignature();
+		// Get component types that system writes
+		const Signature getWriteSignature();
+
+		// Add component type to this system. Same as addWriteComponentType.
 		template<class T> const bool addComponentType()
 		{
-			auto cUniqueId = ECS::System::manager->getComponentUniqueId(typeid(T));
-			try
+			return this->addWriteComponentType<T>();
+		}
+		// Add component type that system only reads. Systems that read same type can run concurrently.
+		template<class T> const bool addReadComponentType()
+		{
+			auto cUniqueId = ECS::getComponentUniqueId<T>();
+			if (cUniqueId == INVALID_C_UNIQUE_ID)
 			{
-				this->signature.test(cUniqueId);
-				this->signature[cUniqueId] = 1;
-				return true;
+				return false;
 			}
-			catch (...)
+
+			if (!this->writeSignature.test(cUniqueId))
+			{
+				this->readSignature.set(cUniqueId);
+			}
+
+			this->signature.set(cUniqueId);
+			this->invalidateSchedule();
+			return true;
+		}
+		// Add component type that system modifies. System doesn't run concurrently with other systems that use same type.
+		template<class T> const bool addWriteComponentType()
+		{
+			auto cUniqueId = ECS::getComponentUniqueId<T>();
+			if (cUniqueId == INVALID_C_UNIQUE_ID)
 			{
 				return false;
 			}
+
+			this->readSignature.reset(cUniqueId);
+			this->writeSignature.set(cUniqueId);
+			this->signature.set(cUniqueId);
+			this->invalidateSchedule();
+			return true;
 		}
 		// Remove component type to this system
 		template<class T> const bool removeComponentType()
 		{
-			auto cUniqueId = ECS::System::manager->getComponentUniqueId(typeid(T));
-			try
-			{
-				this->signature.test(cUniqueId);
-				this->signature[cUniqueId] = 0;
-				return true;
-			}
-			catch (...)
+			auto cUniqueId = ECS::getComponentUniqueId<T>();
+			if (cUniqueId == INVALID_C_UNIQUE_ID)
 			{
 				return false;
 			}
+
+			this->signature.reset(cUniqueId);
+			this->readSignature.reset(cUniqueId);
+			this->writeSignature.reset(cUniqueId);
+			this->invalidateSchedule();
+			return true;
 		}
 
+		// Set exclusive. Exclusive system never runs concurrently with other systems.
+		void setExclusive(const bool exclusive);
+		// Check if system is exclusive
+		const bool isExclusive();
+		// Check if system can't run concurrently with other system
+		const bool conflictsWith(const System& other) const;
+
 		// Toggle actiovation. Disabled system will not be updated.
 		void deactivate();
 		void activate();
 		// Check if system is active
 		const bool isActive();
-		// Update system
-		virtual void update(const float delta, std::vector<ECS::Entity*>& entities) = 0;
-	};
-
-
-	/**
-	*   @class Component
-	*   @brief Base class for all components.
-	*   @note Derive this class to create component.
-	*
-	*   Component class is base class for all component classes you derive.
-	*   Unlike Entity or EntityPool, Components are created on user side rather than in manager class.
-	*   Therefore, there are no way that manager can tell which components exists untill they see one.
-	*   New derived components won't have unique id until they get added to entity.
-	*/
-	class Component
-	{
-		// Friends
-		friend class Manager;
-		friend class Deleter<Component>;
-
-		// Comparator operator
-		friend bool operator==(const Component& a, const Component& b)
-		{
-			return ((a.id == b.id) &&
-				(a.uniqueId == b.uniqueId) &&
-				(a.index == b.index) &&
-				(a.ownerId == b.ownerId));
-		}
-		friend bool operator!=(const Component& a, const Component& b)
-		{
-			return ((a.id != b.id) ||
-				(a.uniqueId != b.uniqueId) ||
-				(a.index != b.index) ||
-				(a.ownerId != b.ownerId));
-		}
-	protected:
-		// Protected constructor. Can't create bass class from out side
-		Component();
-
-		// ptr to manager
-		static ECS::Manager* manager;
-
-		// override new and delete so that user can't create components on their side
-		void* operator new(size_t sz) throw (std::bad_alloc)
-		{
-			void* mem = std::malloc(sz);
-			if (mem)
-				return mem;
-			else
-				throw std::bad_alloc();
-		}
-		void operator delete(void* ptr) throw()
-		{
-			std::free(ptr);
-		}
-	private:
-		// Component Id
-		C_ID id;
-		// Index 
-		C_INDEX index;
-
-		// counter
-		static C_UNIQUE_ID uniqueIdCounter;
-		// ID counter. Starts from 0
-		static void wrapUniqueIdCounter();
-
-		// Unique id number of this component type
-		C_UNIQUE_ID uniqueId;
-		// Owner of this component
-		E_ID ownerId;
-	public:
-		// Public virtual destructor. Default.
-		virtual ~Component() = default;
-
-		// Disable all other constructors.
-		Component(const Component& arg) = delete;				   // Copy constructor
-		Component(const Component&& arg) = delete;				  // Move constructor
-		Component& operator=(const Component& arg) = delete;		// Assignment operator
-		Component& operator=(const Component&& arg) = delete;	   // Move operator
-
-																   // Get component Id
-		const C_ID getId();
-		// Get unique id
-		const C_UNIQUE_ID getUniqueId();
-		// Get owner entity id of this component
-		const E_ID getOwnerId();
-	};
-
-	/**
-	*  @class Entity
-	*  @brief Entity is simply an pack of numbers.
-	*  @note Entity doesn't carries Components.
-	*/
-	class Entity
-	{
-		// Friends
-		friend class Manager;
-		friend class EntityPool;
-		friend class Deleter<Entity>;
-	private:
-		// Constructor
-		Entity();
-
-		// User can't call delete on entity. Must call kill.
-		~Entity() = default;
-
-		// Disable all other constructors.
-		Entity(const Entity& arg) = delete;							 // Copy constructor
-		Entity(const Entity&& arg) = delete;							// Move constructor
-		Entity& operator=(const Entity& arg) = delete;				  // Assignment operator
-		Entity& operator=(const Entity&& arg) = delete;				 // Move operator
-
-																	 // ptr to manager
-		static ECS::Manager* manager;
-
-		// Signature.
-		Signature signature;
-
-		// Component Index map
-		std::unordered_map<C_UNIQUE_ID, std::unordered_set<C_INDEX>> componentIndicies;
-
-		// ID of entity.
-		E_ID id;
-
-		// Index of entity pool for fast access. This is fixed.
-		E_INDEX index;
-
-		// Pool name that this entity lives
-		std::string entityPoolName;
-
-		// If entity is only visible if it's alive. Dead entities will not be queried or accessible.
-		bool alive;
-
-		// If entity is in sleep, it doesn't get updated by manager. 
-		bool sleep;
-
-		// Revive this entity and get ready to use
-		void revive(const E_ID newId);
-
-		// get C_INDEX by C_UNIQUE_ID
-		void getComponentIndiicesByUniqueId(const C_UNIQUE_ID cId, std::unordered_set<C_INDEX>& cIndicies);
-
-	public:
-		// Kill entity. Once this is called, this entity will not be functional anymore.
-		void kill();
-
-		// Get entity Id
-		const E_ID getId();
-
-		// Get EntityPool name that this entity lives
-		const std::string getEntityPoolName();
-
-		// Check if this entity is alive
-		const bool isAlive();
-
-		// Get signature
-		const Signature getSignature();
-
-		// Check if Entity has Component
-		template<class T> const bool hasComponent()
-		{
-			return ECS::Entity::manager->hasComponent<T>(this);
-		}
-		// has specific component
-		template<class T> const bool hasComponent(Component* c)
-		{
-			return ECS::Entity::manager->hasComponent<T>(this, c);
-		}
-		// Get first component of the type
-		template<class T> T* getComponent()
-		{
-			return ECS::Entity::manager->getComponent<T>(this);
-		}
-		// Get all components of the type
-		template<class T> std::vector<T*> getComponents()
-		{
-			return ECS::Entity::manager->getComponents<T>(this);
-		}
-		// Add new component of the type
-		template<class T> const bool addComponent()
-		{
-			return ECS::Entity::manager->addComponent<T>(this);
-		}
-		// Add specific component
-		template<class T> const bool addComponent(Component* c)
-		{
-			return ECS::Entity::manager->addComponent<T>(this, c);
-		}
-		// Remove component by id
-		template<class T> const bool removeComponent(const C_ID componentId)
-		{
-			return ECS::Entity::manager->removeComponent<T>(this, componentId);
-		}
-		// Remove specific component
-		template<class T> const bool removeComponent(Component* c)
-		{
-			return ECS::Entity::manager->removeComponent<T>(this, c);
-		}
-		// Remove all component type
-		template<class T> const bool removeComponents()
-		{
-			return ECS::Entity::manager->removeComponents<T>(this);
-		}
+		// Update system. Iterate entities with manager->forEach.
+		virtual void update(const float delta) = 0;
 	};
 };
 #endif
@@ -0,0 +1,491 @@
+// pch
+#include "PreCompiled.h"
+
+#include "ECSBenchmark.h"
+
+// cpp
+#include <random>
+#include <memory>
+#include <algorithm>
+
+// voxel
+#include "ECS.h"
+#include "Benchmark.h"
+#include "Utility.h"
+
+using namespace Voxel;
+
+namespace
+{
+	const float Delta = 1.0f / 60.0f;
+
+	// Updates of ECS and pointer storage must agree within this, relative to value
+	const float Epsilon = 1e-4f;
+
+	// Life span of entities in churn run. Every entity has died at least once after warm-up.
+	const float MinChurnLifeSpan = 0.1f;
+	const float MaxChurnLifeSpan = 1.0f;
+	const int WarmUpFrames = 60;
+
+	// Components
+	struct Position
+	{
+		float x, y, z;
+	};
+
+	struct Velocity
+	{
+		float x, y, z;
+	};
+
+	struct Life
+	{
+		float remaining;
+		float span;
+	};
+
+	struct Color
+	{
+		float r, g, b, a;
+	};
+
+	// Never added to any entity
+	struct Unused
+	{
+		int value;
+	};
+
+	// Same update on both storages. Life span loops, so no entity dies.
+	inline void move(Position& position, const Velocity& velocity, Life& life)
+	{
+		position.x += velocity.x * Delta;
+		position.y += velocity.y * Delta;
+		position.z += velocity.z * Delta;
+
+		life.remaining -= Delta;
+
+		if (life.remaining < 0.0f)
+		{
+			life.remaining += life.span;
+		}
+	}
+
+	// Entity as heap object with virtual update. Same as storing each component behind pointer.
+	class Object
+	{
+	public:
+		virtual ~Object() = default;
+		virtual void update() = 0;
+	};
+
+	class MovingObject : public Object
+	{
+	public:
+		Position position;
+		Velocity velocity;
+		Life life;
+
+		void update() override
+		{
+			move(position, velocity, life);
+		}
+	};
+
+	bool compare(const char* name, const unsigned int index, const float value, const float expected, std::string& error)
+	{
+		if (glm::abs(value - expected) <= Epsilon * glm::max(1.0f, glm::abs(expected)))
+		{
+			return true;
+		}
+
+		error = std::string(name) + " of entity #" + std::to_string(index) + " is " + std::to_string(value) + " instead of " + std::to_string(expected);
+		return false;
+	}
+}
+
+Voxel::ECSBenchmark::ECSBenchmark(const unsigned int entityCount, const int frames)
+	: entityCount(entityCount)
+	, frames(frames)
+{}
+
+ECSBenchmark::IterationResult Voxel::ECSBenchmark::runIteration()
+{
+	auto manager = ECS::Manager::getInstance();
+	manager->clear();
+
+	IterationResult result;
+	result.entityCount = entityCount;
+
+	std::mt19937 engine(4096);
+	std::uniform_real_distribution<float> velocityDist(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> spanDist(0.5f, 4.0f);
+
+	// Matching entities in order of creation, and heap object of each.
+	std::vector<ECS::E_ID> ids;
+	std::vector<std::unique_ptr<MovingObject>> objects;
+
+	// Entities that only have position. forEach must skip them.
+	std::vector<ECS::E_ID> staticIds;
+
+	ids.reserve(entityCount);
+	objects.reserve(entityCount);
+
+	for (unsigned int i = 0; i < entityCount; i++)
+	{
+		const Position position = { 0.0f, 0.0f, 0.0f };
+		const Velocity velocity = { velocityDist(engine), velocityDist(engine), velocityDist(engine) };
+		const float span = spanDist(engine);
+		const Life life = { span, span };
+
+		ECS::E_ID id;
+
+		if ((i % 4) == 3)
+		{
+			id = manager->createEntity(position, velocity, life, Color{ 1.0f, 1.0f, 1.0f, 1.0f });
+		}
+		else
+		{
+			id = manager->createEntity(position, velocity, life);
+		}
+
+		if ((i % 8) == 0)
+		{
+			staticIds.push_back(manager->createEntity(position));
+		}
+
+		ids.push_back(id);
+
+		objects.push_back(std::unique_ptr<MovingObject>(new MovingObject()));
+		objects.back()->position = position;
+		objects.back()->velocity = velocity;
+		objects.back()->life = life;
+	}
+
+	result.archetypeCount = manager->getArchetypeCount();
+
+	// Heap objects are visited in shuffled order, like pointers to components that were allocated over time.
+	std::vector<Object*> shuffled;
+	shuffled.reserve(objects.size());
+
+	for (auto& object : objects)
+	{
+		shuffled.push_back(object.get());
+	}
+
+	std::shuffle(shuffled.begin(), shuffled.end(), engine);
+
+	// Check visits before timing. Each matching entity once, with its own components.
+	std::vector<unsigned int> visits(ids.size() + staticIds.size() + 1, 0);
+	unsigned long long visitCount = 0;
+
+	manager->forEach<Position, Velocity, Life>([&](const ECS::E_ID id, Position& position, Velocity& velocity, Life& life)
+	{
+		const unsigned int index = ECS::getEntityIndex(id);
+
+		if (index < visits.size())
+		{
+			visits.at(index)++;
+		}
+
+		visitCount++;
+
+		if (result.error.empty() && (manager->getComponent<Position>(id) != &position || manager->getComponent<Life>(id) != &life))
+		{
+			result.error = "forEach gave entity #" + std::to_string(index) + " components of other entity";
+		}
+	});
+
+	if (result.archetypeCount < 3)
+	{
+		result.error = "only " + std::to_string(result.archetypeCount) + " archetypes";
+	}
+
+	if (result.error.empty() && visitCount != ids.size())
+	{
+		result.error = "forEach visited " + std::to_string(visitCount) + " of " + std::to_string(ids.size()) + " entities";
+	}
+
+	for (unsigned int i = 0; i < ids.size() && result.error.empty(); i++)
+	{
+		if (visits.at(ECS::getEntityIndex(ids.at(i))) != 1)
+		{
+			result.error = "forEach visited entity #" + std::to_string(i) + " " + std::to_string(visits.at(ECS::getEntityIndex(ids.at(i)))) + " times";
+		}
+		else if (manager->getComponent<Unused>(ids.at(i)) != nullptr || manager->hasComponent<Unused>(ids.at(i)))
+		{
+			result.error = "entity #" + std::to_string(i) + " has component that was never added";
+		}
+	}
+
+	for (unsigned int i = 0; i < staticIds.size() && result.error.empty(); i++)
+	{
+		if (visits.at(ECS::getEntityIndex(staticIds.at(i))) != 0)
+		{
+			result.error = "forEach visited entity without velocity";
+		}
+	}
+
+	// ECS
+	float ecsMilliSeconds = 0.0f;
+
+	for (int frame = 0; frame < frames; frame++)
+	{
+		unsigned int frameVisits = 0;
+
+		auto start = Utility::Time::now();
+
+		manager->forEach<Position, Velocity, Life>([&frameVisits](const ECS::E_ID id, Position& position, Velocity& velocity, Life& life)
+		{
+			move(position, velocity, life);
+			frameVisits++;
+		});
+
+		auto end = Utility::Time::now();
+
+		ecsMilliSeconds += Benchmark::toMilliSeconds(start, end);
+
+		if (result.error.empty() && frameVisits != ids.size())
+		{
+			result.error = "forEach visited " + std::to_string(frameVisits) + " of " + std::to_string(ids.size()) + " entities on frame " + std::to_string(frame);
+		}
+	}
+
+	// Pointer
+	float pointerMilliSeconds = 0.0f;
+
+	for (int frame = 0; frame < frames; frame++)
+	{
+		auto start = Utility::Time::now();
+
+		for (auto object : shuffled)
+		{
+			object->update();
+		}
+
+		auto end = Utility::Time::now();
+
+		pointerMilliSeconds += Benchmark::toMilliSeconds(start, end);
+	}
+
+	const float updates = static_cast<float>(frames) * static_cast<float>(glm::max(1u, entityCount));
+
+	result.ecsNanoSecondsPerEntity = (ecsMilliSeconds * 1000000.0f) / updates;
+	result.pointerNanoSecondsPerEntity = (pointerMilliSeconds * 1000000.0f) / updates;
+
+	// Both storages ran same update same number of times
+	for (unsigned int i = 0; i < ids.size() && result.error.empty(); i++)
+	{
+		auto position = manager->getComponent<Position>(ids.at(i));
+		auto life = manager->getComponent<Life>(ids.at(i));
+		auto& expected = *objects.at(i);
+
+		if (position == nullptr || life == nullptr)
+		{
+			result.error = "entity #" + std::to_string(i) + " lost its components";
+			break;
+		}
+
+		if (!compare("position x", i, position->x, expected.position.x, result.error)
+			|| !compare("position y", i, position->y, expected.position.y, result.error)
+			|| !compare("position z", i, position->z, expected.position.z, result.error)
+			|| !compare("life", i, life->remaining, expected.life.remaining, result.error))
+		{
+			break;
+		}
+	}
+
+	manager->clear();
+
+	return result;
+}
+
+ECSBenchmark::ChurnResult Voxel::ECSBenchmark::runChurn()
+{
+	// New manager, so records are only created by this run
+	ECS::Manager::deleteInstance();
+	auto manager = ECS::Manager::getInstance();
+
+	ChurnResult result;
+	result.entityCount = entityCount;
+	result.churnCount = 0;
+	result.warmMemory = 0;
+
+	std::mt19937 engine(8192);
+	std::uniform_real_distribution<float> velocityDist(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> spanDist(MinChurnLifeSpan, MaxChurnLifeSpan);
+
+	auto spawn = [&]()
+	{
+		const float span = spanDist(engine);
+		return manager->createEntity(Position{ 0.0f, 0.0f, 0.0f }, Velocity{ velocityDist(engine), velocityDist(engine), velocityDist(engine) }, Life{ span, span });
+	};
+
+	for (unsigned int i = 0; i < entityCount; i++)
+	{
+		spawn();
+	}
+
+	// Killed entities of frame. Reserved, so collecting doesn't allocate.
+	std::vector<ECS::E_ID> expired;
+	expired.reserve(entityCount);
+
+	float churnMilliSeconds = 0.0f;
+
+	for (int frame = 0; frame < WarmUpFrames + frames && result.error.empty(); frame++)
+	{
+		expired.clear();
+
+		// Entity can't be killed while iterating
+		manager->forEach<Position, Velocity, Life>([&expired](const ECS::E_ID id, Position& position, Velocity& velocity, Life& life)
+		{
+			position.x += velocity.x * Delta;
+			position.y += velocity.y * Delta;
+			position.z += velocity.z * Delta;
+
+			life.remaining -= Delta;
+
+			if (life.remaining <= 0.0f)
+			{
+				expired.push_back(id);
+			}
+		});
+
+		auto start = Utility::Time::now();
+
+		for (auto id : expired)
+		{
+			manager->killEntity(id);
+		}
+
+		unsigned int reused = 0;
+
+		for (unsigned int i = 0; i < expired.size(); i++)
+		{
+			const ECS::E_ID id = spawn();
+
+			if (ECS::getEntityIndex(id) >= entityCount)
+			{
+				result.error = "new record #" + std::to_string(ECS::getEntityIndex(id)) + " was created while " + std::to_string(expired.size()) + " records were free";
+			}
+
+			if (ECS::getEntityIndex(id) == ECS::getEntityIndex(expired.at(i)))
+			{
+				reused++;
+			}
+		}
+
+		auto end = Utility::Time::now();
+
+		if (frame == WarmUpFrames)
+		{
+			result.warmMemory = manager->getComponentMemoryUsage();
+		}
+
+		if (frame >= WarmUpFrames)
+		{
+			churnMilliSeconds += Benchmark::toMilliSeconds(start, end);
+			result.churnCount += expired.size();
+		}
+
+		if (!result.error.empty())
+		{
+			break;
+		}
+
+		// Killed first, so free records are reused oldest first in same order
+		if (reused != expired.size())
+		{
+			result.error = "only " + std::to_string(reused) + " of " + std::to_string(expired.size()) + " spawns reused record of killed entity";
+			break;
+		}
+
+		if (manager->getEntityCount() != entityCount)
+		{
+			result.error = std::to_string(manager->getEntityCount()) + " entities alive instead of " + std::to_string(entityCount);
+			break;
+		}
+
+		// Records are reused now. Old ids must not reach new entities.
+		for (auto id : expired)
+		{
+			if (manager->isAlive(id) || manager->getComponent<Position>(id) != nullptr || manager->killEntity(id))
+			{
+				result.error = "id of killed entity #" + std::to_string(ECS::getEntityIndex(id)) + " reaches entity that reused its record";
+				break;
+			}
+		}
+
+		if (frame >= WarmUpFrames && manager->getComponentMemoryUsage() != result.warmMemory)
+		{
+			result.error = "component memory grew from " + std::to_string(result.warmMemory) + " to " + std::to_string(manager->getComponentMemoryUsage()) + " bytes after warm-up";
+		}
+	}
+
+	result.endMemory = manager->getComponentMemoryUsage();
+
+	result.churnPerFrame = static_cast<float>(result.churnCount) / static_cast<float>(frames);
+	result.nanoSecondsPerChurn = result.churnCount > 0 ? (churnMilliSeconds * 1000000.0f) / static_cast<float>(result.churnCount) : 0.0f;
+
+	if (result.error.empty() && result.churnCount == 0)
+	{
+		result.error = "no entity died";
+	}
+
+	manager->clear();
+
+	return result;
+}
+
+void Voxel::ECSBenchmark::printResult(const IterationResult & result)
+{
+	Benchmark::ResultLine("ECSBenchmark", "iteration")
+		.add("entities", result.entityCount)
+		.add("archetypes", result.archetypeCount)
+		.add("ecs", result.ecsNanoSecondsPerEntity, "ns")
+		.add("pointer", result.pointerNanoSecondsPerEntity, "ns")
+		.addChecks(result.error)
+		.print();
+}
+
+void Voxel::ECSBenchmark::printResult(const ChurnResult & result)
+{
+	Benchmark::ResultLine("ECSBenchmark", "churn")
+		.add("entities", result.entityCount)
+		.add("killed and spawned", result.churnCount)
+		.add("per frame", result.churnPerFrame)
+		.add("kill + spawn", result.nanoSecondsPerChurn, "ns")
+		.add("component memory", result.endMemory / 1024, "KB")
+		.addChecks(result.error)
+		.print();
+}
+
+bool Voxel::ECSBenchmark::run()
+{
+	std::cout << "[ECSBenchmark] Entities: " << entityCount << ", frames: " << frames << "\n";
+
+	auto iteration = runIteration();
+	printResult(iteration);
+
+	auto churn = runChurn();
+	printResult(churn);
+
+	ECS::Manager::deleteInstance();
+
+	return iteration.error.empty() && churn.error.empty();
+}
+
+int Voxel::ECSBenchmark::runFromCommandLine(const int argc, const char * argv[])
+{
+	// argv[0] is exe, argv[1] is --ecs-bench
+	int entityCount = 100000;
+	int frames = 100;
+
+	if (!Benchmark::parseArguments(argc, argv, { { &entityCount, 1 }, { &frames, 1 } }, "[entities] [frames]"))
+	{
+		return 1;
+	}
+
+	ECSBenchmark benchmark(static_cast<unsigned int>(entityCount), frames);
+
+	return benchmark.run() ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+#ifndef ECS_BENCHMARK_H
+#define ECS_BENCHMARK_H
+
+// cpp
+#include <string>
+
+namespace Voxel
+{
+	/**
+	*	@class ECSBenchmark
+	*	@brief Measures ECS component storage without window or OpenGL context.
+	*
+	*	Iteration run: creates entities with position, velocity and life span. Every 4th entity also has color, so they are
+	*	in other archetype, and some entities only have position, so they don't match. Then moves all matching entities
+	*	with Manager::forEach on every frame. Same update on heap object per entity with virtual call, visited in shuffled order,
+	*	is measured to compare with pointer based storage.
+	*
+	*	Checks that forEach visits every matching entity once per frame with its own components, skips entities that don't match,
+	*	that components match reference update and that query of missing component returns nullptr.
+	*
+	*	Churn run: keeps same number of short lived entities alive like particles. Every frame kills entities whose life span ended
+	*	and spawns same number of new ones, which reuse records of killed entities.
+	*	Checks that ids of killed entities are stale (not alive, no component, can't be killed again) after their records are reused,
+	*	that no new record is created and component memory doesn't grow after warm-up.
+	*
+	*	Returns non zero exit code if any check fails.
+	*
+	*	Run with: VoxelEngine.exe --ecs-bench [entities] [frames]
+	*/
+	class ECSBenchmark
+	{
+	public:
+		struct IterationResult
+		{
+			unsigned int entityCount;
+			unsigned int archetypeCount;
+			// Mean time of single entity update
+			float ecsNanoSecondsPerEntity;
+			float pointerNanoSecondsPerEntity;
+			// Empty if all checks passed
+			std::string error;
+		};
+
+		struct ChurnResult
+		{
+			unsigned int entityCount;
+			// Number of entities that were killed and spawned after warm-up
+			unsigned long long churnCount;
+			float churnPerFrame;
+			// Mean time of killing and spawning single entity
+			float nanoSecondsPerChurn;
+			// Component memory after warm-up and at end
+			size_t warmMemory;
+			size_t endMemory;
+			// Empty if all checks passed
+			std::string error;
+		};
+	private:
+		unsigned int entityCount;
+		int frames;
+
+		IterationResult runIteration();
+		ChurnResult runChurn();
+
+		void printResult(const IterationResult& result);
+		void printResult(const ChurnResult& result);
+	public:
+		/**
+		*	Constructor
+		*	@param entityCount Number of entities that match iteration and number of alive entities in churn run.
+		*	@param frames Number of updates per run.
+		*/
+		ECSBenchmark(const unsigned int entityCount, const int frames);
+
+		// Destructor
+		~ECSBenchmark() = default;
+
+		/**
+		*	Runs benchmark on ECS manager instance. Manager is cleared before and after.
+		*	@return true if all checks passed.
+		*/
+		bool run();
+
+		/**
+		*	Parses arguments after --ecs-bench and runs benchmark.
+		*	@return Exit code for process.
+		*/
+		static int runFromCommandLine(const int argc, const char* argv[]);
+	};
+}
+
+#endif
@@ -6,6 +6,7 @@
 // voxel
 #include "Application.h"
 #include "SpriteSheet.h"
+#include "AssetLoader.h"
 #include "InputHandler.h"
 #include "Cursor.h"
 #include "Director.h"
@@ -77,6 +78,11 @@ EditorScene::~EditorScene()
 {
 }
 
+void Voxel::EditorScene::preload(std::vector<std::shared_ptr<AssetHandle>>& handles)
+{
+	handles.push_back(AssetLoader::getInstance().loadSpriteSheetAsync("EditorUISpriteSheet.json"));
+}
+
 void Voxel::EditorScene::init()
 {
 	Application::getInstance().getGLView()->setClearColor(glm::vec3(0.4375f));
@@ -84,8 +90,8 @@ void Voxel::EditorScene::init()
 	auto program = ProgramManager::getInstance().getProgram(ProgramManager::PROGRAM_NAME::POLYGON_SHADER);
 	program->use(true);
 
-	program->setUniformMat4("projMat", Camera::mainCamera->getProjection());
-	program->setUniformMat4("viewMat", Camera::mainCamera->getViewMat());
+	program->setUniformMat4(SID("projMat"), Camera::mainCamera->getProjection());
+	program->setUniformMat4(SID("viewMat"), Camera::mainCamera->getViewMat());
 
 	initEditor();
 	initUI();
@@ -473,7 +479,7 @@ void Voxel::EditorScene::release()
 
 	auto& sm = SpriteSheetManager::getInstance();
 
-	sm.removeSpriteSheetByKey("EditorUISpriteSheet");
+	sm.removeSpriteSheetByKey(SID("EditorUISpriteSheet"));
 
 	releaseFloor();
 
@@ -1162,9 +1168,9 @@ void Voxel::EditorScene::render()
 	{
 		auto lineProgram = ProgramManager::getInstance().getProgram(ProgramManager::PROGRAM_NAME::LINE_SHADER);
 		lineProgram->use(true);
-		lineProgram->setUniformMat4("viewMat", Camera::mainCamera->getViewMat() * Camera::mainCamera->getWorldMat());
-		lineProgram->setUniformMat4("modelMat", floorModelMat);
-		lineProgram->setUniformVec4("lineColor", glm::vec4(1.0f));
+		lineProgram->setUniformMat4(SID("viewMat"), Camera::mainCamera->getViewMat() * Camera::mainCamera->getWorldMat());
+		lineProgram->setUniformMat4(SID("modelMat"), floorModelMat);
+		lineProgram->setUniformVec4(SID("lineColor"), glm::vec4(1.0f));
 
 		glBindVertexArray(axisLineVao);
 		glDrawArrays(GL_LINES, 0, 6);
@@ -1175,9 +1181,9 @@ void Voxel::EditorScene::render()
 
 	if (floorVao)
 	{
-		program->setUniformMat4("viewMat", Camera::mainCamera->getViewMat() * Camera::mainCamera->getWorldMat());
-		program->setUniformMat4("modelMat", floorModelMat);
-		program->setUniformVec4("color", floorColor);
+		program->setUniformMat4(SID("viewMat"), Camera::mainCamera->getViewMat() * Camera::mainCamera->getWorldMat());
+		program->setUniformMat4(SID("modelMat"), floorModelMat);
+		program->setUniformVec4(SID("color"), floorColor);
 
 		glBindVertexArray(floorVao);
 		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
@@ -1186,8 +1192,8 @@ void Voxel::EditorScene::render()
 	if (faceIndicatorVisibility)
 	{
 		glClear(GL_DEPTH_BUFFER_BIT);
-		program->setUniformMat4("modelMat", faceIndicatorModelMat);
-		program->setUniformVec4("color", faceIndicatorColor);
+		program->setUniformMat4(SID("modelMat"), faceIndicatorModelMat);
+		program->setUniformVec4(SID("color"), faceIndicatorColor);
 
 		glBindVertexArray(faceIndicatorVao);
 		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
@@ -193,6 +193,7 @@ namespace Voxel
 		~EditorScene();
 
 		// overrides
+		void preload(std::vector<std::shared_ptr<AssetHandle>>& handles) override;
 		void init() override;
 		void onEnter() override;
 		void onEnterFinished() override;
@@ -99,6 +99,35 @@ void Voxel::FileSystem::createEmptyFile(const std::string & path)
 	}
 }
 
+bool Voxel::FileSystem::createDirectory(const std::string & path)
+{
+	boost::system::error_code ec;
+
+	fs::create_directories(fs::path(path), ec);
+
+	return fs::is_directory(fs::path(path));
+}
+
+unsigned long long Voxel::FileSystem::getFileSize(const std::string & path) const
+{
+	if (fs::is_regular_file(path))
+	{
+		return static_cast<unsigned long long>(fs::file_size(path));
+	}
+
+	return 0;
+}
+
+long long Voxel::FileSystem::getLastWriteTime(const std::string & path) const
+{
+	if (fs::is_regular_file(path))
+	{
+		return static_cast<long long>(fs::last_write_time(path));
+	}
+
+	return 0;
+}
+
 bool Voxel::FileSystem::openFile(const std::string & path)
 {
 	if (ofs.is_open())
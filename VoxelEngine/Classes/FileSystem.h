@@ -64,6 +64,15 @@ namespace Voxel
 		// create empty file
 		void createEmptyFile(const std::string& path);
 
+		// Create directory and all missing parent directories. Returns true if directory exists after call.
+		bool createDirectory(const std::string& path);
+
+		// Get size of file in bytes. Returns 0 if file doesn't exist
+		unsigned long long getFileSize(const std::string& path) const;
+
+		// Get last write time of file. Returns 0 if file doesn't exist
+		long long getLastWriteTime(const std::string& path) const;
+
 		// open file
 		bool openFile(const std::string& path);
 
@@ -0,0 +1,82 @@
+// pch
+#include "PreCompiled.h"
+
+#include "FixedTimeStep.h"
+
+// cpp
+#include <algorithm>
+
+using namespace Voxel;
+
+const int FixedTimeStep::DefaultTickRate = 60;
+const int FixedTimeStep::MinTickRate = 20;
+const int FixedTimeStep::MaxTickRate = 240;
+const int FixedTimeStep::MaxTicksPerFrame = 8;
+
+Voxel::FixedTimeStep::FixedTimeStep(const int tickRate)
+	: tickRate(0)
+	, tickDelta(0)
+	, accumulator(0)
+	, tickCount(0)
+{
+	setTickRate(tickRate);
+}
+
+void Voxel::FixedTimeStep::setTickRate(const int tickRate)
+{
+	this->tickRate = std::max(MinTickRate, std::min(tickRate, MaxTickRate));
+	tickDelta = 1.0f / static_cast<float>(this->tickRate);
+}
+
+int Voxel::FixedTimeStep::getTickRate() const
+{
+	return tickRate;
+}
+
+float Voxel::FixedTimeStep::getTickDelta() const
+{
+	return tickDelta;
+}
+
+int Voxel::FixedTimeStep::advance(const float delta)
+{
+	if (delta > 0.0f)
+	{
+		accumulator += delta;
+	}
+
+	int ticks = 0;
+
+	while (accumulator >= tickDelta)
+	{
+		accumulator -= tickDelta;
+		ticks++;
+
+		if (ticks == MaxTicksPerFrame)
+		{
+			// Too far behind. Drop rest of time instead of catching up.
+			accumulator = std::min(accumulator, tickDelta * 0.999f);
+			break;
+		}
+	}
+
+	tickCount += static_cast<unsigned long long>(ticks);
+
+	return ticks;
+}
+
+float Voxel::FixedTimeStep::getAlpha() const
+{
+	return accumulator / tickDelta;
+}
+
+unsigned long long Voxel::FixedTimeStep::getTickCount() const
+{
+	return tickCount;
+}
+
+void Voxel::FixedTimeStep::reset()
+{
+	accumulator = 0;
+	tickCount = 0;
+}
@@ -0,0 +1,80 @@
+#ifndef FIXED_TIME_STEP_H
+#define FIXED_TIME_STEP_H
+
+namespace Voxel
+{
+	/**
+	*	@class FixedTimeStep
+	*	@brief Accumulates frame time and splits it into fixed size simulation ticks.
+	*
+	*	Simulation (movement, physics, calendar) runs with same delta every tick regardless of frame rate, so it behaves same on 30 fps and 300 fps.
+	*	Left over time that isn't enough for a tick stays in accumulator. Alpha (accumulator / tick delta) tells how far rendering is between last tick and next tick.
+	*	Doesn't depend on rendering or window, so it can drive simulation without window (headless) or from other thread.
+	*/
+	class FixedTimeStep
+	{
+	public:
+		// Default tick rate in Hz
+		static const int DefaultTickRate;
+		// Min and max tick rate in Hz
+		static const int MinTickRate;
+		static const int MaxTickRate;
+		// Max number of ticks that can run in single frame. Prevents spiral of death when frame takes too long.
+		static const int MaxTicksPerFrame;
+	private:
+		// Number of ticks per second
+		int tickRate;
+
+		// Time of single tick. 1 / tickRate
+		float tickDelta;
+
+		// Elapsed time that isn't consumed by tick yet
+		float accumulator;
+
+		// Total number of ticks ran
+		unsigned long long tickCount;
+	public:
+		/**
+		*	Constructor
+		*	@param tickRate Number of ticks per second. Clamped to [MinTickRate, MaxTickRate].
+		*/
+		FixedTimeStep(const int tickRate = DefaultTickRate);
+
+		// Destructor
+		~FixedTimeStep() = default;
+
+		/**
+		*	Set tick rate. Doesn't reset accumulator.
+		*	@param tickRate Number of ticks per second. Clamped to [MinTickRate, MaxTickRate].
+		*/
+		void setTickRate(const int tickRate);
+
+		// Get tick rate in Hz
+		int getTickRate() const;
+
+		// Get delta time of single tick in seconds.
+		float getTickDelta() const;
+
+		/**
+		*	Adds elapsed frame time to accumulator and consumes it as ticks.
+		*	Time over MaxTicksPerFrame ticks is dropped.
+		*	@param delta Elapsed time on current frame.
+		*	@return Number of ticks to run on current frame. Can be 0.
+		*/
+		int advance(const float delta);
+
+		/**
+		*	Get interpolation alpha between last tick and next tick.
+		*	@return Value in [0, 1).
+		*/
+		float getAlpha() const;
+
+		// Get total number of ticks ran since construction or reset
+		unsigned long long getTickCount() const;
+
+		// Clears accumulator and tick count. Call after long stall (loading, etc) so simulation doesn't catch up.
+		void reset();
+	};
+}
+
+#endif
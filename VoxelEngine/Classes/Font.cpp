@@ -3,33 +3,62 @@
 
 #include "Font.h"
 
+// cpp
+#include <cstring>
+#include <thread>
+#include <atomic>
+
 // voxel
 #include "Application.h"
 #include "Utility.h"
 #include "Texture2D.h"
-#include "Utility.h"
 #include "FileSystem.h"
 #include "Logger.h"
 #include "ErrorCode.h"
 #include "BinPacker.h"
+#include "ThreadPool.h"
+#include "Config.h"
 
 using namespace Voxel;
 
 FT_Library Font::library = nullptr;
 
 const int Font::MIN_FONT_SIZE = 10;
+const int Font::MAX_TEXTURE_SIZE = 2048;
 const std::string Font::DEFAULT_FONT_PATH = "fonts/";
+const std::string Font::CACHE_PATH = "cache/fonts/";
+const int Font::CACHE_VERSION = 1;
 
 Font::Font()
-	: fontSize(0)
+	: face(nullptr)
+	, fontSize(0)
 	, linespace(0)
-	, textureSize(0)
+	, locale(Voxel::Localization::Tag::en_US)
 	, texture(nullptr)
+	, textureSize(0)
 	, outlineSize(0)
+	, binPacker(nullptr)
+	, atlasVersion(0)
+	, useCounter(0)
+	, frameCounter(1)
+	, evictionPending(false)
 {
 	initLibrary();
 }
 
+Voxel::Font::~Font()
+{
+	if (face)
+	{
+		FT_Done_Face(face);
+	}
+
+	if (binPacker)
+	{
+		delete binPacker;
+	}
+}
+
 void Voxel::Font::initLibrary()
 {
 	if (!library)
@@ -60,7 +89,8 @@ int Voxel::Font::getTextureSizeByLocale(const Voxel::Localization::Tag locale) c
 		}
 		break;
 	case Voxel::Localization::Tag::ko_KR:
-		size = 2048;
+		// Starts small. Only glyphs that are used get rasterized.
+		size = 512;
 		break;
 	default:
 		// Bad locale
@@ -71,10 +101,10 @@ int Voxel::Font::getTextureSizeByLocale(const Voxel::Localization::Tag locale) c
 	return size;
 }
 
-Font* Font::create(const std::string& fontName, const int fontSize, const Voxel::Localization::Tag locale)
+Font* Font::create(const std::string& fontName, const int fontSize, const Voxel::Localization::Tag locale, const bool preload)
 {
 	auto newFont = new Font();
-	if (newFont->init(fontName, fontSize, 0, locale))
+	if (newFont->init(fontName, fontSize, 0, locale, preload))
 	{
 		return newFont;
 	}
@@ -85,10 +115,10 @@ Font* Font::create(const std::string& fontName, const int fontSize, const Voxel:
 	}
 }
 
-Font * Voxel::Font::createWithOutline(const std::string & fontName, const int fontSize, const int outlineSize, const Voxel::Localization::Tag locale)
+Font * Voxel::Font::createWithOutline(const std::string & fontName, const int fontSize, const int outlineSize, const Voxel::Localization::Tag locale, const bool preload)
 {
 	auto newFont = new Font();
-	if (newFont->init(fontName, fontSize, outlineSize, locale))
+	if (newFont->init(fontName, fontSize, outlineSize, locale, preload))
 	{
 		return newFont;
 	}
@@ -99,23 +129,17 @@ Font * Voxel::Font::createWithOutline(const std::string & fontName, const int fo
 	}
 }
 
-bool Voxel::Font::init(const std::string & fontName, const int fontSize, const int outlineSize, const Voxel::Localization::Tag locale)
+bool Voxel::Font::init(const std::string & fontName, const int fontSize, const int outlineSize, const Voxel::Localization::Tag locale, const bool preload)
 {
 	auto start = Utility::Time::now();
 
-	// Load the font with freetype2
-	FT_Face face;
-
 	this->fontName = fontName;
 
 	this->outlineSize = outlineSize;
 
-	std::string fontPath = FileSystem::getInstance().getWorkingDirectory() + "/" + DEFAULT_FONT_PATH + fontName;
+	this->locale = locale;
 
-	if (FT_New_Face(library, fontPath.c_str(), 0, &face))
-	{
-		throw std::runtime_error(std::to_string(Voxel::Error::Code::ERROR_FAILED_TO_LOAD_FONT_FILE) + "\nInvalid font file: \"" + fontPath + "\"");
-	}
+	fontPath = FileSystem::getInstance().getWorkingDirectory() + "/" + DEFAULT_FONT_PATH + fontName;
 
 	// save font size
 	this->fontSize = fontSize;
@@ -124,14 +148,12 @@ bool Voxel::Font::init(const std::string & fontName, const int fontSize, const i
 	{
 		this->fontSize = MIN_FONT_SIZE;
 	}
-	
-	// Set font size. Larger size = Higher font texture
-	FT_Set_Pixel_Sizes(face, 0, this->fontSize);
 
-	// Todo: Each language need different size of texture
+	// Initial texture size. Grows when it's full.
 	textureSize = getTextureSizeByLocale(locale);
 	
-	std::string textureName = Utility::String::removeFileExtFromFileName(fontName) + "_" + std::to_string(fontSize);
+	// Each locale has own atlas
+	std::string textureName = Utility::String::removeFileExtFromFileName(fontName) + "_" + std::to_string(fontSize) + "_" + Voxel::Localization::toString(locale);
 
 	if (outlineSize != 0)
 	{
@@ -141,241 +163,827 @@ bool Voxel::Font::init(const std::string & fontName, const int fontSize, const i
 	texture = Texture2D::createFontTexture(textureName, textureSize, textureSize, GL_TEXTURE_2D);
 	texture->setLocationOnProgram(ProgramManager::PROGRAM_NAME::UI_TEXT_SHADER);
 
-	// bind font texture
-	texture->bind();
+	binPacker = new Voxel::Bin::BinPacker();
+	binPacker->init(glm::vec2(static_cast<float>(textureSize)));
 
-	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-	// iterate over char map (whitespace to tilde) again. 
+	bool cached = false;
 
-	auto startBinPack = Utility::Time::now();
-	switch (locale)
+#if V_FONT_DISK_CACHE
+	if (preload)
 	{
-	case Voxel::Localization::Tag::en_US:
-		initEnUS(face);
-		break;
-	case Voxel::Localization::Tag::ko_KR:
-		initKoKR(face);
-		break;
-	default:
-		assert(false);
-		break;
+		cached = loadCache();
 	}
-	auto endBinPack = Utility::Time::now();
+#endif
 
-	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	if (!cached)
+	{
+		// Load the font with freetype2. Face is released in destructor
+		if (!openFace())
+		{
+			throw std::runtime_error(std::to_string(Voxel::Error::Code::ERROR_FAILED_TO_LOAD_FONT_FILE) + "\nInvalid font file: \"" + fontPath + "\"");
+		}
+
+		std::vector<Glyph*> packedGlyphs;
+		std::vector<unsigned char> image;
+
+		// False if preload failed. Glyphs are loaded on demand.
+		bool preloaded = false;
+
+		if (preload)
+		{
+			preloaded = preloadGlyphs(getPreloadCharacters(locale), packedGlyphs, image);
+		}
+
+		initDefaultCharacters();
+
+#if V_FONT_DISK_CACHE
+		// Don't cache failed preload. It would be loaded as is next time.
+		if (preloaded)
+		{
+			saveCache(packedGlyphs, image);
+		}
+#endif
+	}
 
 	auto end = Utility::Time::now();
 
 #if V_DEBUG && V_DEBUG_CONSOLE
-	Voxel::Logger::getInstance().consoleInfo("[Font] Texture generation took: " + Utility::Time::toMicroSecondString(start, end) + ", bin packing took: " + Utility::Time::toMicroSecondString(startBinPack, endBinPack));
+	Voxel::Logger::getInstance().consoleInfo("[Font] Font initialization took: " + Utility::Time::toMicroSecondString(start, end) + (cached ? " (cached)" : "") + ", glyphs: " + std::to_string(glyphMap.size()));
 #endif
 
-#if V_DEBUG
-	//texture->saveToPNG();
-#endif
+	return true;
+}
+
+bool Voxel::Font::openFace()
+{
+	if (face)
+	{
+		return true;
+	}
+
+	if (FT_New_Face(library, fontPath.c_str(), 0, &face))
+	{
+		face = nullptr;
+		return false;
+	}
 
-	//make sure release face.
-	FT_Done_Face(face);
+	// Set font size. Larger size = Higher font texture
+	FT_Set_Pixel_Sizes(face, 0, this->fontSize);
 
 	return true;
 }
 
-bool Voxel::Font::initDefaultCharacters(FT_Face & face)
+bool Voxel::Font::initDefaultCharacters()
 {
-	return false;
+	Glyph* whitespace = getGlyph(32/* whitespace */);
+
+	if (whitespace == nullptr)
+	{
+		return false;
+	}
+
+	// Whitespace's height is used as height of empty line. Use font's full height because not all glyphs are loaded.
+	whitespace->height = static_cast<int>((face->size->metrics.ascender - face->size->metrics.descender) >> 6);
+
+	linespace = face->size->metrics.height >> 6;
+
+	return true;
 }
 
-bool Voxel::Font::initEnUS(FT_Face& face)
+std::vector<int> Voxel::Font::getPreloadCharacters(const Voxel::Localization::Tag locale) const
 {
-	FT_GlyphSlot glyphSlot = face->glyph;
+	std::vector<int> unicodes;
 
-	auto logger = &Voxel::Logger::getInstance();
+	// All locales use ascii table. whitespace to tilde
+	for (int unicode = 32; unicode <= 126; unicode++)
+	{
+		unicodes.push_back(unicode);
+	}
 
-	int whitespaceHeight = 0;
-	
-	const int padding = 1;
-	const float padF = static_cast<float>(padding);
-	const int totalPad = padding + outlineSize;
-	const float totalPadF = static_cast<float>(totalPad);
-	const float textureSizeF = static_cast<float>(textureSize);
+	switch (locale)
+	{
+	case Voxel::Localization::Tag::ko_KR:
+		// Hangul syllables
+		for (int unicode = 44032; unicode <= 55203; unicode++)
+		{
+			unicodes.push_back(unicode);
+		}
+		break;
+	default:
+		break;
+	}
+
+	return unicodes;
+}
+
+bool Voxel::Font::preloadGlyphs(const std::vector<int>& unicodes, std::vector<Glyph*>& packedGlyphs, std::vector<unsigned char>& image)
+{
+	const unsigned int count = static_cast<unsigned int>(unicodes.size());
+
+	if (count == 0)
+	{
+		return false;
+	}
+
+	auto startRaster = Utility::Time::now();
+
+	// Step 1. Rasterize on multiple threads. ------------
+
+	std::vector<Glyph> glyphs(count);
+	std::vector<char> loaded(count, 0);
+
+	// Set if any range failed to open font. Its glyphs aren't missing from font, so they must not be marked as invalid.
+	std::atomic<bool> failed(false);
+
+	// Opening face per thread isn't free. Don't split small set too much.
+	const unsigned int minGlyphsPerThread = 128;
+	const unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+	const unsigned int grain = std::max(minGlyphsPerThread, (count + hardwareThreads - 1) / hardwareThreads);
+	const unsigned int threadCount = (count + grain - 1) / grain;
 
-	Voxel::Bin::BinPacker bp;
-	bp.init(glm::vec2(textureSizeF, textureSizeF));
-	
-	// en-US load characters in ascii table.
-	for (int unicode = 32/* whitespace */; unicode <= 126/* ~ */; unicode++)
 	{
-		if (FT_Load_Char(face, unicode, FT_LOAD_RENDER))
+		// Calling thread also works
+		ThreadPool pool(threadCount - 1);
+
+		pool.parallelFor(count, grain, [&](const unsigned int begin, const unsigned int end)
 		{
+			// FT_Library and FT_Face aren't thread safe. Each range uses own.
+			FT_Library threadLibrary = nullptr;
+			FT_Face threadFace = nullptr;
+
+			if (FT_Init_FreeType(&threadLibrary))
+			{
+				failed.store(true);
+				return;
+			}
+
+			if (FT_New_Face(threadLibrary, fontPath.c_str(), 0, &threadFace))
+			{
+				FT_Done_FreeType(threadLibrary);
+				failed.store(true);
+				return;
+			}
+
+			FT_Set_Pixel_Sizes(threadFace, 0, fontSize);
+
+			for (unsigned int i = begin; i < end; i++)
+			{
+				loaded.at(i) = rasterizeGlyph(threadFace, unicodes.at(i), glyphs.at(i)) ? 1 : 0;
+			}
+
+			FT_Done_Face(threadFace);
+			FT_Done_FreeType(threadLibrary);
+		});
+	}
+
+	auto endRaster = Utility::Time::now();
+
+	if (failed.load())
+	{
+		// Nothing is added. All glyphs are loaded on demand instead.
 #if V_DEBUG && V_DEBUG_LOG_CONSOLE
-			//logger->consoleWarn("[Font] \"" + fontName + " failed to load character: " + std::to_string(static_cast<char>(unicode)));
+		Voxel::Logger::getInstance().consoleWarn("[Font] \"" + fontName + "\" failed to open font on preload thread. Glyphs are loaded on demand.");
 #endif
-			continue;
-		}
+		return false;
+	}
 
-		// create glyph data
-		glyphMap.emplace(unicode, Glyph());
+	// Step 2. Merge in to glyph map. ------------
 
-		auto& glyph = glyphMap[unicode];
+	std::vector<Glyph*> atlasGlyphs;
 
-		glyph.valid = true;
-		glyph.unicode = unicode;
-		glyph.metrics = glyphSlot->metrics;
-		glyph.height = glyphSlot->metrics.height >> 6;
-		glyph.width = glyphSlot->metrics.width >> 6;
-		glyph.bearingX = glyphSlot->metrics.horiBearingX >> 6;
-		glyph.bearingY = glyphSlot->metrics.horiBearingY >> 6;
-		//std::cout << c << " " << glyph.height << ", " << glyph.bearingY << std::endl;
-		glyph.botY = glyph.height - glyph.bearingY;
-		glyph.advance = glyphSlot->metrics.horiAdvance >> 6;
-
-		if (whitespaceHeight < glyph.height)
+	for (unsigned int i = 0; i < count; i++)
+	{
+		const int unicode = unicodes.at(i);
+
+		auto find_it = glyphMap.find(unicode);
+		if (find_it != glyphMap.end())
 		{
-			whitespaceHeight = glyph.height;
+			// Already loaded
+			continue;
 		}
 
-		const float charX = (totalPadF * 2.0f) + static_cast<float>(glyphSlot->bitmap.width);
-
-		const float charY = (totalPadF * 2.0f) + static_cast<float>(glyphSlot->bitmap.rows);
+		Glyph& glyph = glyphMap.emplace(unicode, std::move(glyphs.at(i))).first->second;
 
-		Voxel::Bin::ItemNode* itemNode = bp.insert(glm::vec2(charX, charY));
+		glyph.unicode = unicode;
+		glyph.lastUsed = 0;
+		glyph.lastUsedFrame = 0;
 
-		if (itemNode)
+		if (loaded.at(i))
 		{
-			// substitude bitmap buffer to texture
+			glyph.resident = true;
 
-			if (unicode == 32/* whitespace */)
+			if (glyph.bitmap.empty())
 			{
-				glyph.uvTopLeft.x = 0.0f;
-				glyph.uvTopLeft.y = 0.0f;
-
-				glyph.uvBotRight.x = 0.0f;
-				glyph.uvBotRight.y = 0.0f;
+				glyph.atlasPosition = glm::ivec2(-1);
+				glyph.uvTopLeft = glm::vec2(0.0f);
+				glyph.uvBotRight = glm::vec2(0.0f);
 			}
 			else
 			{
-				glTexSubImage2D(GL_TEXTURE_2D, 0, static_cast<int>(itemNode->area.origin.x) + totalPad, static_cast<int>(itemNode->area.origin.y) + totalPad, glyphSlot->bitmap.width, glyphSlot->bitmap.rows, GL_RED, GL_UNSIGNED_BYTE, glyphSlot->bitmap.buffer);
+				atlasGlyphs.push_back(&glyph);
+			}
+		}
+		else
+		{
+			// Font doesn't have character
+			glyph.valid = false;
+			glyph.resident = false;
+			glyph.bitmapWidth = 0;
+			glyph.bitmapHeight = 0;
+		}
+	}
+
+	// Step 3. Pack all glyphs in single pass. Grow until everything fits. ------------
 
-				glyph.uvTopLeft.x = (itemNode->area.origin.x + padF) / textureSizeF;
-				glyph.uvTopLeft.y = ((itemNode->area.origin.y + padF) / textureSizeF);
+	// Taller glyphs first packs tighter
+	std::sort(atlasGlyphs.begin(), atlasGlyphs.end(), [](const Glyph* lhs, const Glyph* rhs) { return lhs->bitmapHeight > rhs->bitmapHeight; });
+
+	std::vector<glm::vec2> origins;
+	std::vector<glm::vec2> sizes;
+
+	while (true)
+	{
+		binPacker->init(glm::vec2(static_cast<float>(textureSize)));
 
-				glyph.uvBotRight.x = ((itemNode->area.origin.x + itemNode->area.size.x) - padF) / textureSizeF;
-				glyph.uvBotRight.y = (((itemNode->area.origin.y + itemNode->area.size.y) - padF) / textureSizeF);
+		origins.clear();
+		sizes.clear();
+
+		for (auto glyph : atlasGlyphs)
+		{
+			Voxel::Bin::ItemNode* itemNode = binPacker->insert(glm::vec2(static_cast<float>(glyph->bitmapWidth), static_cast<float>(glyph->bitmapHeight)));
+
+			if (itemNode == nullptr)
+			{
+				break;
 			}
+
+			origins.push_back(itemNode->area.origin);
+			sizes.push_back(itemNode->area.size);
 		}
-		else
+
+		if (origins.size() == atlasGlyphs.size() || textureSize >= MAX_TEXTURE_SIZE)
 		{
-			// todo: remove this on release
-			assert(false);
+			break;
 		}
+
+		textureSize = std::min(textureSize * 2, MAX_TEXTURE_SIZE);
 	}
-	
-	glyphMap[32/* whtiesapce */].height = whitespaceHeight;
 
-	linespace = face->size->metrics.height >> 6;
+	// Glyphs that didn't fit in max size are loaded on demand.
+	for (size_t i = origins.size(); i < atlasGlyphs.size(); i++)
+	{
+		atlasGlyphs.at(i)->resident = false;
+		atlasGlyphs.at(i)->bitmap.clear();
+	}
+
+	atlasGlyphs.resize(origins.size());
+
+	// Step 4. Copy to atlas image and upload once. ------------
+
+	image.assign(textureSize * textureSize, 0);
+
+	const size_t len = atlasGlyphs.size();
+	for (size_t i = 0; i < len; i++)
+	{
+		Glyph* glyph = atlasGlyphs.at(i);
+
+		setAtlasPosition(*glyph, origins.at(i), sizes.at(i));
+
+		for (int y = 0; y < glyph->bitmapHeight; y++)
+		{
+			std::memcpy(&image[((glyph->atlasPosition.y + y) * textureSize) + glyph->atlasPosition.x], &glyph->bitmap[y * glyph->bitmapWidth], glyph->bitmapWidth);
+		}
+	}
+
+	if (texture->getTextureSize().x != textureSize)
+	{
+		texture->resizeFontTexture(textureSize, textureSize);
+	}
+
+	texture->bind();
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, textureSize, textureSize, GL_RED, GL_UNSIGNED_BYTE, image.data());
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	atlasVersion++;
+
+	packedGlyphs = atlasGlyphs;
+
+	auto endPack = Utility::Time::now();
+
+#if V_DEBUG && V_DEBUG_LOG_CONSOLE
+	Voxel::Logger::getInstance().consoleInfo("[Font] \"" + fontName + "\" preloaded " + std::to_string(count) + " glyphs on " + std::to_string(threadCount) + " threads. Rasterize: " + Utility::Time::toMicroSecondString(startRaster, endRaster) + ", pack: " + Utility::Time::toMicroSecondString(endRaster, endPack) + ", atlas size: " + std::to_string(textureSize));
+#endif
 
 	return true;
 }
 
-bool Voxel::Font::initKoKR(FT_Face & face)
+bool Voxel::Font::rasterizeGlyph(FT_Face face, const int unicode, Glyph & glyph) const
 {
+	if (FT_Get_Char_Index(face, unicode) == 0)
+	{
+		// Font doesn't have character
+		return false;
+	}
+
+	if (FT_Load_Char(face, unicode, FT_LOAD_RENDER))
+	{
+#if V_DEBUG && V_DEBUG_LOG_CONSOLE
+		Voxel::Logger::getInstance().consoleWarn("[Font] \"" + fontName + " failed to load character: " + std::to_string(unicode));
+#endif
+		return false;
+	}
+
 	FT_GlyphSlot glyphSlot = face->glyph;
 
-	auto logger = &Voxel::Logger::getInstance();
+	glyph.valid = true;
+	glyph.unicode = unicode;
+	glyph.metrics = glyphSlot->metrics;
+	glyph.height = glyphSlot->metrics.height >> 6;
+	glyph.width = glyphSlot->metrics.width >> 6;
+	glyph.bearingX = glyphSlot->metrics.horiBearingX >> 6;
+	glyph.bearingY = glyphSlot->metrics.horiBearingY >> 6;
+	glyph.botY = glyph.height - glyph.bearingY;
+	glyph.advance = glyphSlot->metrics.horiAdvance >> 6;
 
-	int whitespaceHeight = 0;
+	const int width = static_cast<int>(glyphSlot->bitmap.width);
+	const int rows = static_cast<int>(glyphSlot->bitmap.rows);
 
-	const int padding = 1;
-	const float padF = static_cast<float>(padding);
-	const int totalPad = padding + outlineSize;
-	const float totalPadF = static_cast<float>(totalPad);
-	const float textureSizeF = static_cast<float>(textureSize);
+	if (width == 0 || rows == 0)
+	{
+		// Nothing to render (whitespace). Doesn't take space in atlas.
+		glyph.bitmapWidth = 0;
+		glyph.bitmapHeight = 0;
+		glyph.bitmap.clear();
+		return true;
+	}
+
+	// Copy bitmap with padding. Padding is uploaded as well, so previous glyph in same area doesn't bleed in to outline.
+	const int totalPad = 1 + outlineSize;
+
+	glyph.bitmapWidth = width + (totalPad * 2);
+	glyph.bitmapHeight = rows + (totalPad * 2);
+	glyph.bitmap.assign(glyph.bitmapWidth * glyph.bitmapHeight, 0);
 
-	Voxel::Bin::BinPacker bp;
-	bp.init(glm::vec2(textureSizeF, textureSizeF));
+	const int pitch = std::abs(glyphSlot->bitmap.pitch);
 
-	for (int unicode = 44032; unicode <= 55203; unicode++)
+	for (int y = 0; y < rows; y++)
 	{
-		auto ci = FT_Get_Char_Index(face, unicode);
-		if (ci == 0)
+		std::memcpy(&glyph.bitmap[((y + totalPad) * glyph.bitmapWidth) + totalPad], glyphSlot->bitmap.buffer + (y * pitch), width);
+	}
+
+	return true;
+}
+
+void Voxel::Font::addToAtlas(Glyph & glyph)
+{
+	glyph.resident = true;
+
+	if (glyph.bitmap.empty())
+	{
+		glyph.atlasPosition = glm::ivec2(-1);
+		glyph.uvTopLeft = glm::vec2(0.0f);
+		glyph.uvBotRight = glm::vec2(0.0f);
+		return;
+	}
+
+	while (!packGlyph(glyph))
+	{
+		if (textureSize < MAX_TEXTURE_SIZE)
 		{
-			continue;
+			growAtlas();
 		}
+		else if (glyph.bitmapWidth <= MAX_TEXTURE_SIZE && glyph.bitmapHeight <= MAX_TEXTURE_SIZE)
+		{
+			// Atlas is full. Evicting now can remove glyphs that text being built already used, so wait for update().
+			// Glyph renders nothing until then. Bitmap is rasterized again after eviction.
+			glyph.resident = false;
+			glyph.bitmap.clear();
+			glyph.atlasPosition = glm::ivec2(-1);
+			glyph.uvTopLeft = glm::vec2(0.0f);
+			glyph.uvBotRight = glm::vec2(0.0f);
+
+			evictionPending = true;
+			break;
+		}
+		else
+		{
+			// Glyph is larger than entire atlas. Keep metric, but render nothing.
+#if V_DEBUG && V_DEBUG_LOG_CONSOLE
+			Voxel::Logger::getInstance().consoleWarn("[Font] \"" + fontName + "\" glyph doesn't fit in atlas: " + std::to_string(glyph.unicode));
+#endif
+			glyph.bitmap.clear();
+			glyph.atlasPosition = glm::ivec2(-1);
+			glyph.uvTopLeft = glm::vec2(0.0f);
+			glyph.uvBotRight = glm::vec2(0.0f);
+			break;
+		}
+	}
+}
+
+bool Voxel::Font::packGlyph(Glyph & glyph)
+{
+	Voxel::Bin::ItemNode* itemNode = binPacker->insert(glm::vec2(static_cast<float>(glyph.bitmapWidth), static_cast<float>(glyph.bitmapHeight)));
+
+	if (itemNode == nullptr)
+	{
+		return false;
+	}
+
+	setAtlasPosition(glyph, itemNode->area.origin, itemNode->area.size);
+
+	// substitude bitmap buffer to texture
+	texture->bind();
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, glyph.atlasPosition.x, glyph.atlasPosition.y, glyph.bitmapWidth, glyph.bitmapHeight, GL_RED, GL_UNSIGNED_BYTE, glyph.bitmap.data());
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	return true;
+}
+
+void Voxel::Font::setAtlasPosition(Glyph & glyph, const glm::vec2 & origin, const glm::vec2 & size)
+{
+	const float padF = 1.0f;
+	const float textureSizeF = static_cast<float>(textureSize);
+
+	glyph.atlasPosition = glm::ivec2(origin);
+
+	glyph.uvTopLeft.x = (origin.x + padF) / textureSizeF;
+	glyph.uvTopLeft.y = (origin.y + padF) / textureSizeF;
+
+	glyph.uvBotRight.x = ((origin.x + size.x) - padF) / textureSizeF;
+	glyph.uvBotRight.y = ((origin.y + size.y) - padF) / textureSizeF;
+}
+
+void Voxel::Font::growAtlas()
+{
+	textureSize = std::min(textureSize * 2, MAX_TEXTURE_SIZE);
+
+	texture->resizeFontTexture(textureSize, textureSize);
 
-		if (FT_Load_Char(face, unicode, FT_LOAD_RENDER))
+	std::vector<Glyph*> glyphs;
+
+	for (auto& e : glyphMap)
+	{
+		if (e.second.resident && !e.second.bitmap.empty())
 		{
+			glyphs.push_back(&e.second);
+		}
+	}
+
+	repackAtlas(glyphs);
+
 #if V_DEBUG && V_DEBUG_LOG_CONSOLE
-			logger->consoleWarn("[Font] \"" + fontName + " failed to load character: " + std::to_string(unicode));
+	Voxel::Logger::getInstance().consoleInfo("[Font] \"" + fontName + "\" atlas grew to " + std::to_string(textureSize) + " with " + std::to_string(glyphs.size()) + " glyphs");
 #endif
-			continue;
+}
+
+bool Voxel::Font::evictAtlas()
+{
+	std::vector<Glyph*> glyphs;
+
+	for (auto& e : glyphMap)
+	{
+		if (e.second.resident && !e.second.bitmap.empty())
+		{
+			glyphs.push_back(&e.second);
 		}
+	}
 
-		// create glyph data
-		glyphMap.emplace(unicode, Glyph());
+	// Most recently used first
+	std::sort(glyphs.begin(), glyphs.end(), [](const Glyph* lhs, const Glyph* rhs) { return lhs->lastUsed > rhs->lastUsed; });
 
-		auto& glyph = glyphMap[unicode];
+	// Keep half, but never evict glyphs that are used in current frame. Mesh of visible texts use them.
+	size_t keepCount = glyphs.size() / 2;
 
-		glyph.valid = true;
-		glyph.unicode = unicode;
-		glyph.metrics = glyphSlot->metrics;
-		glyph.height = glyphSlot->metrics.height >> 6;
-		glyph.width = glyphSlot->metrics.width >> 6;
-		glyph.bearingX = glyphSlot->metrics.horiBearingX >> 6;
-		glyph.bearingY = glyphSlot->metrics.horiBearingY >> 6;
-		//std::cout << c << " " << glyph.height << ", " << glyph.bearingY << std::endl;
-		glyph.botY = glyph.height - glyph.bearingY;
-		glyph.advance = glyphSlot->metrics.horiAdvance >> 6;
-
-		if (whitespaceHeight < glyph.height)
+	while (keepCount < glyphs.size() && glyphs.at(keepCount)->lastUsedFrame == frameCounter)
+	{
+		keepCount++;
+	}
+
+	if (keepCount == glyphs.size())
+	{
+		// Every glyph is in use.
+		return false;
+	}
+
+	for (size_t i = keepCount; i < glyphs.size(); i++)
+	{
+		Glyph* glyph = glyphs.at(i);
+
+		glyph->resident = false;
+		glyph->bitmap.clear();
+		glyph->bitmap.shrink_to_fit();
+	}
+
+	glyphs.resize(keepCount);
+
+	repackAtlas(glyphs);
+
+#if V_DEBUG && V_DEBUG_LOG_CONSOLE
+	Voxel::Logger::getInstance().consoleInfo("[Font] \"" + fontName + "\" atlas evicted glyphs. Kept " + std::to_string(keepCount) + " glyphs");
+#endif
+
+	return true;
+}
+
+void Voxel::Font::repackAtlas(std::vector<Glyph*>& glyphs)
+{
+	binPacker->init(glm::vec2(static_cast<float>(textureSize)));
+
+	// Taller glyphs first packs tighter
+	std::sort(glyphs.begin(), glyphs.end(), [](const Glyph* lhs, const Glyph* rhs) { return lhs->bitmapHeight > rhs->bitmapHeight; });
+
+	for (auto glyph : glyphs)
+	{
+		if (!packGlyph(*glyph))
 		{
-			whitespaceHeight = glyph.height;
+			// Doesn't fit after repack. Rasterize again when it's used.
+			glyph->resident = false;
+			glyph->bitmap.clear();
 		}
+	}
 
-		const float charX = (totalPadF * 2.0f) + static_cast<float>(glyphSlot->bitmap.width);
+	atlasVersion++;
+}
+
+std::string Voxel::Font::getCachePath() const
+{
+	return FileSystem::getInstance().getUserDirectory() + "/" + CACHE_PATH + Utility::String::removeFileExtFromFileName(fontName) + "_" + std::to_string(fontSize) + "_" + std::to_string(outlineSize) + "_" + Voxel::Localization::toString(locale) + ".bin";
+}
+
+bool Voxel::Font::loadCache()
+{
+	auto& fileSystem = FileSystem::getInstance();
 
-		const float charY = (totalPadF * 2.0f) + static_cast<float>(glyphSlot->bitmap.rows);
+	std::ifstream file(getCachePath(), std::ios::in | std::ios::binary);
 
-		Voxel::Bin::ItemNode* itemNode = bp.insert(glm::vec2(charX, charY));
+	if (!file.is_open())
+	{
+		return false;
+	}
 
-		if (itemNode)
+	// Header. Must match current font file and settings.
+	int version = 0;
+	unsigned long long fontFileSize = 0;
+	long long fontFileTime = 0;
+	int cachedFontSize = 0;
+	int cachedOutlineSize = 0;
+	int cachedTextureSize = 0;
+	int cachedLinespace = 0;
+	unsigned int glyphCount = 0;
+
+	if (!readValue(file, version) || version != CACHE_VERSION) return false;
+	if (!readValue(file, fontFileSize) || fontFileSize != fileSystem.getFileSize(fontPath)) return false;
+	if (!readValue(file, fontFileTime) || fontFileTime != fileSystem.getLastWriteTime(fontPath)) return false;
+	if (!readValue(file, cachedFontSize) || cachedFontSize != fontSize) return false;
+	if (!readValue(file, cachedOutlineSize) || cachedOutlineSize != outlineSize) return false;
+	if (!readValue(file, cachedTextureSize) || cachedTextureSize <= 0 || cachedTextureSize > MAX_TEXTURE_SIZE) return false;
+	if (!readValue(file, cachedLinespace)) return false;
+	if (!readValue(file, glyphCount)) return false;
+
+	// Glyphs. Glyphs in atlas comes first, in packed order.
+	std::vector<Glyph> glyphs(glyphCount);
+
+	for (auto& glyph : glyphs)
+	{
+		int valid = 0;
+		int resident = 0;
+
+		bool result = readValue(file, glyph.unicode)
+			&& readValue(file, valid)
+			&& readValue(file, resident)
+			&& readValue(file, glyph.width)
+			&& readValue(file, glyph.height)
+			&& readValue(file, glyph.bearingX)
+			&& readValue(file, glyph.bearingY)
+			&& readValue(file, glyph.botY)
+			&& readValue(file, glyph.advance)
+			&& readValue(file, glyph.metrics)
+			&& readValue(file, glyph.bitmapWidth)
+			&& readValue(file, glyph.bitmapHeight)
+			&& readValue(file, glyph.atlasPosition.x)
+			&& readValue(file, glyph.atlasPosition.y);
+
+		if (!result)
 		{
-			// substitude bitmap buffer to texture
-			const glm::vec2 origin = itemNode->area.origin;
-			const glm::vec2 size = itemNode->area.size;
+			return false;
+		}
+
+		// Valid glyph that isn't resident is rasterized when it's used.
+		glyph.valid = (valid != 0);
+		glyph.resident = glyph.valid && (resident != 0);
+		glyph.lastUsed = 0;
+		glyph.lastUsedFrame = 0;
+	}
 
-			glTexSubImage2D(GL_TEXTURE_2D, 0, static_cast<int>(origin.x) + totalPad, static_cast<int>(origin.y) + totalPad, glyphSlot->bitmap.width, glyphSlot->bitmap.rows, GL_RED, GL_UNSIGNED_BYTE, glyphSlot->bitmap.buffer);
+	std::vector<unsigned char> image(cachedTextureSize * cachedTextureSize);
 
-			glyph.uvTopLeft.x = (itemNode->area.origin.x + padF) / textureSizeF;
-			glyph.uvTopLeft.y = ((itemNode->area.origin.y + padF) / textureSizeF);
+	file.read(reinterpret_cast<char*>(image.data()), image.size());
 
-			glyph.uvBotRight.x = ((itemNode->area.origin.x + itemNode->area.size.x) - padF) / textureSizeF;
-			glyph.uvBotRight.y = (((itemNode->area.origin.y + itemNode->area.size.y) - padF) / textureSizeF);
+	if (!file.good())
+	{
+		return false;
+	}
+
+	// Replay packing so bin packer knows used area. Position must match with cache.
+	textureSize = cachedTextureSize;
+	binPacker->init(glm::vec2(static_cast<float>(textureSize)));
+
+	for (auto& glyph : glyphs)
+	{
+		if (!glyph.resident || glyph.atlasPosition.x < 0)
+		{
+			glyph.atlasPosition = glm::ivec2(-1);
+			glyph.uvTopLeft = glm::vec2(0.0f);
+			glyph.uvBotRight = glm::vec2(0.0f);
+			continue;
 		}
-		else
+
+		Voxel::Bin::ItemNode* itemNode = binPacker->insert(glm::vec2(static_cast<float>(glyph.bitmapWidth), static_cast<float>(glyph.bitmapHeight)));
+
+		if (itemNode == nullptr || glm::ivec2(itemNode->area.origin) != glyph.atlasPosition)
 		{
-			// todo: remove this on release
-			abort();
+			// Packer changed. Cache is outdated.
+			textureSize = getTextureSizeByLocale(locale);
+			binPacker->init(glm::vec2(static_cast<float>(textureSize)));
+			return false;
+		}
+
+		setAtlasPosition(glyph, itemNode->area.origin, itemNode->area.size);
+
+		// Copy bitmap back from atlas, so atlas can be repacked later.
+		glyph.bitmap.resize(glyph.bitmapWidth * glyph.bitmapHeight);
+
+		for (int y = 0; y < glyph.bitmapHeight; y++)
+		{
+			std::memcpy(&glyph.bitmap[y * glyph.bitmapWidth], &image[((glyph.atlasPosition.y + y) * textureSize) + glyph.atlasPosition.x], glyph.bitmapWidth);
 		}
 	}
 
-	glyphMap[' '].height = whitespaceHeight;
+	for (auto& glyph : glyphs)
+	{
+		const int unicode = glyph.unicode;
+		glyphMap.emplace(unicode, std::move(glyph));
+	}
 
-	linespace = face->size->metrics.height >> 6;
+	linespace = cachedLinespace;
+
+	if (texture->getTextureSize().x != textureSize)
+	{
+		texture->resizeFontTexture(textureSize, textureSize);
+	}
+
+	texture->bind();
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, textureSize, textureSize, GL_RED, GL_UNSIGNED_BYTE, image.data());
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	atlasVersion++;
 
 	return true;
 }
 
+bool Voxel::Font::saveCache(const std::vector<Glyph*>& packedGlyphs, const std::vector<unsigned char>& image)
+{
+	auto& fileSystem = FileSystem::getInstance();
+
+	if (!fileSystem.createDirectory(fileSystem.getUserDirectory() + "/" + CACHE_PATH))
+	{
+		return false;
+	}
+
+	std::ofstream file(getCachePath(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	// Glyphs in atlas in packed order, then rest (whitespace, missing characters)
+	std::vector<const Glyph*> glyphs(packedGlyphs.begin(), packedGlyphs.end());
+
+	for (auto& e : glyphMap)
+	{
+		if (e.second.bitmap.empty() || !e.second.resident)
+		{
+			glyphs.push_back(&e.second);
+		}
+	}
+
+	writeValue(file, CACHE_VERSION);
+	writeValue(file, fileSystem.getFileSize(fontPath));
+	writeValue(file, fileSystem.getLastWriteTime(fontPath));
+	writeValue(file, fontSize);
+	writeValue(file, outlineSize);
+	writeValue(file, textureSize);
+	writeValue(file, linespace);
+	writeValue(file, static_cast<unsigned int>(glyphs.size()));
+
+	for (auto glyph : glyphs)
+	{
+		// Glyphs that aren't in atlas are written without position
+		const bool inAtlas = glyph->resident && !glyph->bitmap.empty();
+		const glm::ivec2 atlasPosition = inAtlas ? glyph->atlasPosition : glm::ivec2(-1);
+
+		writeValue(file, glyph->unicode);
+		writeValue(file, glyph->valid ? 1 : 0);
+		writeValue(file, glyph->resident ? 1 : 0);
+		writeValue(file, glyph->width);
+		writeValue(file, glyph->height);
+		writeValue(file, glyph->bearingX);
+		writeValue(file, glyph->bearingY);
+		writeValue(file, glyph->botY);
+		writeValue(file, glyph->advance);
+		writeValue(file, glyph->metrics);
+		writeValue(file, glyph->bitmapWidth);
+		writeValue(file, glyph->bitmapHeight);
+		writeValue(file, atlasPosition.x);
+		writeValue(file, atlasPosition.y);
+	}
+
+	file.write(reinterpret_cast<const char*>(image.data()), image.size());
+
+	return file.good();
+}
+
 Glyph * Voxel::Font::getGlyph(const int unicode)
 {
 	auto find_it = glyphMap.find(unicode);
+
 	if (find_it == glyphMap.end())
+	{
+		// First time. Rasterize glyph. Glyph that font doesn't have is also added as invalid glyph, so it doesn't query freetype again.
+		find_it = glyphMap.emplace(unicode, Glyph()).first;
+
+		Glyph& glyph = find_it->second;
+
+		glyph.valid = false;
+		glyph.unicode = unicode;
+		glyph.resident = false;
+		glyph.lastUsed = 0;
+		glyph.lastUsedFrame = 0;
+		glyph.bitmapWidth = 0;
+		glyph.bitmapHeight = 0;
+
+		if (openFace() && rasterizeGlyph(face, unicode, glyph))
+		{
+			addToAtlas(glyph);
+		}
+	}
+	else if (find_it->second.valid && !find_it->second.resident && !evictionPending)
+	{
+		// Evicted. Rasterize again.
+		Glyph& glyph = find_it->second;
+
+		if (openFace() && rasterizeGlyph(face, unicode, glyph))
+		{
+			addToAtlas(glyph);
+		}
+		else
+		{
+			glyph.valid = false;
+		}
+	}
+
+	Glyph& glyph = find_it->second;
+
+	if (!glyph.valid)
 	{
 		return nullptr;
 	}
-	else
+
+	glyph.lastUsed = ++useCounter;
+	glyph.lastUsedFrame = frameCounter;
+
+	return &glyph;
+}
+
+void Voxel::Font::update()
+{
+	if (evictionPending)
 	{
-		return &(find_it->second);
+		evictionPending = false;
+
+#if V_DEBUG && V_DEBUG_LOG_CONSOLE
+		if (!evictAtlas())
+		{
+			Voxel::Logger::getInstance().consoleWarn("[Font] \"" + fontName + "\" atlas is full with glyphs in use");
+		}
+#else
+		evictAtlas();
+#endif
 	}
+
+	frameCounter++;
+}
+
+unsigned int Voxel::Font::getAtlasVersion() const
+{
+	return atlasVersion;
 }
 
 int Voxel::Font::getLineSpace()
@@ -12,6 +12,8 @@
 // cpp
 #include <unordered_map>
 #include <string>
+#include <vector>
+#include <fstream>
 
 // voxel
 #include "LocalizationTags.h"
@@ -20,6 +22,11 @@ namespace Voxel
 {
 	class Texture2D;
 
+	namespace Bin
+	{
+		class BinPacker;
+	}
+
 	/**
 	*	@class Glyph
 	*	@brief Contains each character's glyph metric and texture data in font.
@@ -48,22 +55,53 @@ namespace Voxel
 		// Texture coordinates
 		glm::vec2 uvTopLeft;
 		glm::vec2 uvBotRight;
+		// True if glyph is packed in font texture and uv is valid. Evicted glyph keeps metrics and gets rasterized again when used.
+		bool resident;
+		// Font's use counter when this glyph was last requested. Used for eviction.
+		unsigned int lastUsed;
+		// Font's frame counter when this glyph was last requested. Glyphs used in current frame are pinned in atlas.
+		unsigned int lastUsedFrame;
+		// Top left position of bitmap in atlas. Only valid while resident
+		glm::ivec2 atlasPosition;
+		// Size of bitmap including padding
+		int bitmapWidth;
+		int bitmapHeight;
+		// Rasterized bitmap including padding. Kept while resident so atlas can be repacked when it grows.
+		std::vector<unsigned char> bitmap;
 	};
 
 	/**
 	*	@class Font
 	*	@brief Loads TTF font using Freetype 2
+	*
+	*	Glyphs are rasterized on demand, when getGlyph is called with unicode for the first time.
+	*	Rasterized glyphs are packed in single font texture (atlas). Atlas starts small and doubles its size
+	*	up to MAX_TEXTURE_SIZE when it's full. If it's full at max size, least recently used glyphs are evicted.
+	*	Growing and evicting repacks atlas, which invalidates uvs. Check atlas version to see if uvs are still valid.
+	*
+	*	Fonts that are used right away (menu, debug) can preload locale's characters. Preloading rasterizes
+	*	on multiple threads, each with own FT_Library and FT_Face, and packs all glyphs in single pass.
+	*	If V_FONT_DISK_CACHE is enabled, packed atlas and metrics are saved to user directory and
+	*	next launch loads them without FreeType. Cache is invalidated when font file changes.
 	*/
 	class Font
 	{
 	public:
 		// constants
 		const static int MIN_FONT_SIZE;
+		const static int MAX_TEXTURE_SIZE;
 		const static std::string DEFAULT_FONT_PATH;
+		const static std::string CACHE_PATH;
 	private:
+		// Increase when cache file format changes
+		const static int CACHE_VERSION;
+
 		// Freetype library. Reads library.
 		static FT_Library library;
 
+		// Font face. Kept open to rasterize glyphs on demand
+		FT_Face face;
+
 		// size of font
 		int fontSize;
 
@@ -73,6 +111,12 @@ namespace Voxel
 		// font name
 		std::string fontName;
 
+		// Full path of font file
+		std::string fontPath;
+
+		// Locale that font was created for
+		Voxel::Localization::Tag locale;
+
 		// Font texture
 		Texture2D* texture;
 
@@ -82,19 +126,92 @@ namespace Voxel
 		// outline size in pixel
 		int outlineSize;
 
-		// Glyph map
+		// Glyph map. Glyphs are never removed from map, so pointer to glyph stays valid.
 		std::unordered_map<int/*unicode*/, Glyph> glyphMap;
 
+		// Packs glyphs in font texture
+		Voxel::Bin::BinPacker* binPacker;
+
+		// Increases every time atlas is repacked.
+		unsigned int atlasVersion;
+
+		// Increases every time glyph is requested.
+		unsigned int useCounter;
+
+		// Increases every frame in update().
+		unsigned int frameCounter;
+
+		// True if atlas is full and glyph couldn't be packed. Atlas is evicted in update(), between text builds.
+		bool evictionPending;
+
 		// constructor
 		Font();
 
 		// initialize font
-		bool init(const std::string& fontName, const int fontSize, const int outlineSize, const Voxel::Localization::Tag locale);
+		bool init(const std::string& fontName, const int fontSize, const int outlineSize, const Voxel::Localization::Tag locale, const bool preload);
+
+		// Open font face. Face isn't opened if font was loaded from cache until new glyph is needed.
+		bool openFace();
+
+		// Load whitespace and line space. Other characters are loaded on demand.
+		bool initDefaultCharacters();
+
+		// Get characters to preload for locale
+		std::vector<int> getPreloadCharacters(const Voxel::Localization::Tag locale) const;
 
-		// initialize by localization
-		bool initDefaultCharacters(FT_Face& face);
-		bool initEnUS(FT_Face& face);
-		bool initKoKR(FT_Face& face);
+		/**
+		*	Rasterize glyphs on multiple threads and pack in single pass.
+		*	@param unicodes Characters to rasterize.
+		*	@param packedGlyphs Glyphs that are packed in atlas, in packed order.
+		*	@param image Atlas image. Size of textureSize * textureSize.
+		*	@return false if font couldn't be opened on preload thread. Nothing is added and glyphs are loaded on demand.
+		*/
+		bool preloadGlyphs(const std::vector<int>& unicodes, std::vector<Glyph*>& packedGlyphs, std::vector<unsigned char>& image);
+
+		// Rasterize glyph with freetype. Fills metrics and bitmap. Thread safe if each thread uses own face.
+		bool rasterizeGlyph(FT_Face face, const int unicode, Glyph& glyph) const;
+
+		// Set position and uv of glyph in atlas
+		void setAtlasPosition(Glyph& glyph, const glm::vec2& origin, const glm::vec2& size);
+
+		// Get path of cache file. Keyed by font name, size, outline and locale.
+		std::string getCachePath() const;
+
+		// Load atlas and glyphs from cache file. Returns false if cache doesn't exist or is outdated.
+		bool loadCache();
+
+		// Save preloaded atlas and glyphs to cache file.
+		bool saveCache(const std::vector<Glyph*>& packedGlyphs, const std::vector<unsigned char>& image);
+
+		// Write value to cache file as is. Cache is only read by same build, so layout doesn't have to be portable.
+		template<typename T>
+		static void writeValue(std::ofstream& file, const T& value)
+		{
+			file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		// Read value from cache file. Returns false if file doesn't have enough data.
+		template<typename T>
+		static bool readValue(std::ifstream& file, T& value)
+		{
+			file.read(reinterpret_cast<char*>(&value), sizeof(T));
+			return file.good();
+		}
+
+		// Add rasterized glyph to atlas. Grows atlas if it's full. If atlas can't grow, glyph stays non-resident and eviction is requested for next update().
+		void addToAtlas(Glyph& glyph);
+
+		// Insert glyph's bitmap in bin packer and upload to texture. Returns false if there is no space.
+		bool packGlyph(Glyph& glyph);
+
+		// Double the texture size and repack all resident glyphs
+		void growAtlas();
+
+		// Evict least recently used half of resident glyphs and repack rest. Glyphs used in current frame are never evicted. Returns false if nothing could be evicted.
+		bool evictAtlas();
+
+		// Clear bin packer and pack glyphs again.
+		void repackAtlas(std::vector<Glyph*>& glyphs);
 
 		// init FreeType
 		void initLibrary();
@@ -102,18 +219,24 @@ namespace Voxel
 		// Get texture size based on locale
 		int getTextureSizeByLocale(const Voxel::Localization::Tag locale) const;
 	public:
-		// creates font
-		static Font* create(const std::string& fontName, const int fontSize, const Voxel::Localization::Tag locale);
+		// creates font. If preload is true, rasterizes all characters of locale at creation.
+		static Font* create(const std::string& fontName, const int fontSize, const Voxel::Localization::Tag locale, const bool preload = false);
 
-		// creates font with outline
-		static Font* createWithOutline(const std::string& fontName, const int fontSize, const int outlineSize, const Voxel::Localization::Tag locale);
+		// creates font with outline. If preload is true, rasterizes all characters of locale at creation.
+		static Font* createWithOutline(const std::string& fontName, const int fontSize, const int outlineSize, const Voxel::Localization::Tag locale, const bool preload = false);
 
 		// destructor
-		~Font() = default;
+		~Font();
 
-		// Get glyph for specific char
+		// Get glyph for specific char. Rasterizes glyph if it's not loaded. Returns nullptr if font doesn't have character.
 		Glyph* getGlyph(const int unicode);
 
+		// Update font once per frame, after all texts are built and rendered. Evicts atlas if it was full during frame.
+		void update();
+
+		// Get atlas version. Uv of glyphs that were queried with different version can be invalid.
+		unsigned int getAtlasVersion() const;
+
 		// Get line space
 		int getLineSpace();
 
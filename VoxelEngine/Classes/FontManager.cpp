@@ -19,7 +19,7 @@ FontManager::~FontManager()
 }
 
 
-int FontManager::addFont(const std::string& fontName, const int fontSize, int outline, const Voxel::Localization::Tag locale)
+int FontManager::addFont(const std::string& fontName, const int fontSize, int outline, const Voxel::Localization::Tag locale, const bool preload)
 {
 	Font* newFont = nullptr; 
 
@@ -30,11 +30,11 @@ int FontManager::addFont(const std::string& fontName, const int fontSize, int ou
 
 	if (outline == 0)
 	{
-		newFont = Font::create(fontName, fontSize, locale);
+		newFont = Font::create(fontName, fontSize, locale, preload);
 	}
 	else
 	{
-		newFont = Font::createWithOutline(fontName, fontSize, outline, locale);
+		newFont = Font::createWithOutline(fontName, fontSize, outline, locale, preload);
 	}
 
 	if (newFont)
@@ -88,6 +88,17 @@ Font* FontManager::getFont(const int id)
 	return nullptr;
 }
 
+void Voxel::FontManager::update()
+{
+	for (auto font : fonts)
+	{
+		if (font.second)
+		{
+			font.second->update();
+		}
+	}
+}
+
 void Voxel::FontManager::clear()
 {
 	for (auto font : fonts)
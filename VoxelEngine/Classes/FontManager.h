@@ -47,11 +47,15 @@ namespace Voxel
 
 		// Add font. Returns integer font ID or -1 if fails to load font.
 		// Id starts from 1. 0 is used by default font
-		int addFont(const std::string& fontName, const int fontSize, int outlineSize, const Voxel::Localization::Tag locale);
+		// If preload is true, all characters in locale are rasterized (or loaded from cache) at creation. Else, characters are rasterized when they are used.
+		int addFont(const std::string& fontName, const int fontSize, int outlineSize, const Voxel::Localization::Tag locale, const bool preload = false);
 
 		// Get font by id
 		Font* getFont(const int id);
 
+		// Update all fonts. Call once per frame after render.
+		void update();
+
 		// Clear all fonts
 		void clear();
 	};
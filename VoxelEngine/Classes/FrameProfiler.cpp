@@ -0,0 +1,389 @@
+// pch
+#include "PreCompiled.h"
+
+#include "FrameProfiler.h"
+
+// cpp
+#include <cstdio>
+
+using namespace Voxel;
+
+const unsigned int Voxel::FrameProfiler::RING_CAPACITY = 8192;
+std::atomic<bool> Voxel::FrameProfiler::enabled(false);
+
+namespace
+{
+	// Ring of thread. Released when thread ends so other thread can reuse it.
+	struct ProfileThreadRing
+	{
+		Voxel::ThreadEventRing<Voxel::ProfileEvent>* ring = nullptr;
+
+		~ProfileThreadRing()
+		{
+			if (ring)
+			{
+				ring->release();
+			}
+		}
+	};
+
+	thread_local ProfileThreadRing profileThreadRing;
+
+	// Number of zones open on thread
+	thread_local unsigned int zoneDepth = 0;
+}
+
+Voxel::FrameProfiler::FrameProfiler()
+	: startTime(std::chrono::steady_clock::now())
+	, nextThreadIndex(0)
+	, frames(FRAME_HISTORY)
+	, frameCursor(0)
+	, frameCount(0)
+	, frameStart(0)
+	, mainThreadIndex(0)
+	, droppedCount(0)
+{}
+
+ThreadEventRing<ProfileEvent>* Voxel::FrameProfiler::getThreadRing()
+{
+	if (profileThreadRing.ring)
+	{
+		return profileThreadRing.ring;
+	}
+
+	std::unique_lock<std::mutex> lock(ringMutex);
+
+	const unsigned int threadIndex = nextThreadIndex++;
+	threadNames.resize(nextThreadIndex);
+
+	// Reuse ring of thread that ended
+	for (auto& ring : rings)
+	{
+		if (ring->isReleased() && ring->empty())
+		{
+			ring->acquire(threadIndex);
+			profileThreadRing.ring = ring.get();
+
+			return profileThreadRing.ring;
+		}
+	}
+
+	rings.push_back(std::unique_ptr<ThreadEventRing<ProfileEvent>>(new ThreadEventRing<ProfileEvent>(RING_CAPACITY)));
+	rings.back()->acquire(threadIndex);
+
+	profileThreadRing.ring = rings.back().get();
+
+	return profileThreadRing.ring;
+}
+
+void Voxel::FrameProfiler::clear()
+{
+	{
+		std::unique_lock<std::mutex> lock(ringMutex);
+
+		for (auto& ring : rings)
+		{
+			ring->skip();
+			ring->takeDropped();
+		}
+	}
+
+	for (auto& frame : frames)
+	{
+		frame.events.clear();
+	}
+
+	frameCursor = 0;
+	frameCount = 0;
+	frameStart = now();
+	droppedCount = 0;
+}
+
+void Voxel::FrameProfiler::setEnabled(const bool enabled)
+{
+	if (enabled)
+	{
+		clear();
+	}
+
+	FrameProfiler::enabled.store(enabled);
+}
+
+long long Voxel::FrameProfiler::now() const
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void Voxel::FrameProfiler::record(const char * name, const long long start, const long long end, const unsigned int depth)
+{
+	auto ring = getThreadRing();
+
+	ProfileEvent* e = ring->beginWrite();
+
+	if (e)
+	{
+		e->name = name;
+		e->start = start;
+		e->end = end;
+		e->threadIndex = ring->getThreadIndex();
+		e->depth = depth;
+
+		ring->commit();
+	}
+}
+
+void Voxel::FrameProfiler::setThreadName(const std::string & name)
+{
+	const unsigned int threadIndex = getThreadRing()->getThreadIndex();
+
+	std::unique_lock<std::mutex> lock(ringMutex);
+	threadNames.at(threadIndex) = name;
+}
+
+std::string Voxel::FrameProfiler::getThreadName(const unsigned int threadIndex) const
+{
+	{
+		std::unique_lock<std::mutex> lock(ringMutex);
+
+		if (threadIndex < threadNames.size() && !threadNames.at(threadIndex).empty())
+		{
+			return threadNames.at(threadIndex);
+		}
+	}
+
+	return "Thread #" + std::to_string(threadIndex);
+}
+
+unsigned int Voxel::FrameProfiler::getThreadCount() const
+{
+	std::unique_lock<std::mutex> lock(ringMutex);
+
+	return nextThreadIndex;
+}
+
+unsigned int Voxel::FrameProfiler::getMainThreadIndex() const
+{
+	return mainThreadIndex;
+}
+
+void Voxel::FrameProfiler::endFrame()
+{
+	if (!isEnabled())
+	{
+		return;
+	}
+
+	mainThreadIndex = getThreadRing()->getThreadIndex();
+
+	const long long frameEnd = now();
+
+	{
+		std::unique_lock<std::mutex> lock(ringMutex);
+
+		drainingRings.clear();
+
+		for (auto& ring : rings)
+		{
+			drainingRings.push_back(ring.get());
+		}
+	}
+
+	// Reuses vector of oldest frame
+	auto& frame = frames.at(frameCursor);
+	frame.index = frameCount;
+	frame.start = frameStart;
+	frame.end = frameEnd;
+	frame.events.clear();
+
+	for (auto ring : drainingRings)
+	{
+		ring->drain(frame.events);
+		droppedCount += ring->takeDropped();
+	}
+
+	// Parent starts before child. Same start means parent is shallower.
+	std::sort(frame.events.begin(), frame.events.end(), [](const ProfileEvent& a, const ProfileEvent& b)
+	{
+		return (a.start == b.start) ? (a.depth < b.depth) : (a.start < b.start);
+	});
+
+	frameCursor = (frameCursor + 1) % FRAME_HISTORY;
+	frameCount++;
+	frameStart = frameEnd;
+}
+
+unsigned int Voxel::FrameProfiler::getFrameCount() const
+{
+	return static_cast<unsigned int>(std::min(frameCount, static_cast<unsigned long long>(FRAME_HISTORY)));
+}
+
+const FrameProfiler::Frame * Voxel::FrameProfiler::getFrame(const unsigned int age) const
+{
+	if (age >= getFrameCount())
+	{
+		return nullptr;
+	}
+
+	return &frames.at((frameCursor + FRAME_HISTORY - 1 - age) % FRAME_HISTORY);
+}
+
+const FrameProfiler::Frame * Voxel::FrameProfiler::getSlowestFrame() const
+{
+	const Frame* slowest = nullptr;
+
+	const unsigned int count = getFrameCount();
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		auto frame = getFrame(i);
+
+		if (slowest == nullptr || (frame->end - frame->start) > (slowest->end - slowest->start))
+		{
+			slowest = frame;
+		}
+	}
+
+	return slowest;
+}
+
+unsigned long long Voxel::FrameProfiler::getDroppedCount() const
+{
+	return droppedCount;
+}
+
+std::vector<std::string> Voxel::FrameProfiler::getSummary() const
+{
+	std::vector<std::string> lines;
+
+	const unsigned int count = getFrameCount();
+
+	if (count == 0)
+	{
+		lines.push_back("No frames recorded");
+		return lines;
+	}
+
+	struct ZoneTime
+	{
+		double totalMilliSeconds;
+		double maxMilliSeconds;
+	};
+
+	// Sum of zone in each frame. Zone can run multiple times in frame.
+	std::map<std::string, ZoneTime> zoneTimes;
+	std::map<std::string, double> frameTimes;
+
+	double totalFrameMilliSeconds = 0;
+	double maxFrameMilliSeconds = 0;
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		auto frame = getFrame(i);
+
+		const double frameMilliSeconds = static_cast<double>(frame->end - frame->start) / 1000000.0;
+		totalFrameMilliSeconds += frameMilliSeconds;
+		maxFrameMilliSeconds = std::max(maxFrameMilliSeconds, frameMilliSeconds);
+
+		frameTimes.clear();
+
+		for (auto& e : frame->events)
+		{
+			frameTimes[e.name] += static_cast<double>(e.end - e.start) / 1000000.0;
+		}
+
+		for (auto& entry : frameTimes)
+		{
+			auto& zoneTime = zoneTimes[entry.first];
+			zoneTime.totalMilliSeconds += entry.second;
+			zoneTime.maxMilliSeconds = std::max(zoneTime.maxMilliSeconds, entry.second);
+		}
+	}
+
+	std::vector<std::pair<std::string, ZoneTime>> sorted(zoneTimes.begin(), zoneTimes.end());
+	std::sort(sorted.begin(), sorted.end(), [](const std::pair<std::string, ZoneTime>& a, const std::pair<std::string, ZoneTime>& b) { return a.second.totalMilliSeconds > b.second.totalMilliSeconds; });
+
+	char line[256];
+
+	std::snprintf(line, sizeof(line), "Frame: mean %.3f ms, max %.3f ms (%u frames, %llu dropped)", totalFrameMilliSeconds / count, maxFrameMilliSeconds, count, droppedCount);
+	lines.push_back(line);
+
+	for (auto& entry : sorted)
+	{
+		std::snprintf(line, sizeof(line), "%s: mean %.3f ms, max %.3f ms", entry.first.c_str(), entry.second.totalMilliSeconds / count, entry.second.maxMilliSeconds);
+		lines.push_back(line);
+	}
+
+	return lines;
+}
+
+bool Voxel::FrameProfiler::exportChromeTrace(const std::string & path) const
+{
+	std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	// Complete events ("ph": "X") in micro seconds. Each thread is a row.
+	file << "{\"traceEvents\":[\n";
+
+	const unsigned int threadCount = getThreadCount();
+
+	for (unsigned int i = 0; i < threadCount; i++)
+	{
+		file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << i << ",\"args\":{\"name\":\"" << getThreadName(i) << "\"}},\n";
+	}
+
+	file << std::fixed << std::setprecision(3);
+
+	const unsigned int count = getFrameCount();
+	bool first = true;
+
+	// Oldest first
+	for (unsigned int i = count; i-- > 0;)
+	{
+		auto frame = getFrame(i);
+
+		if (!first)
+		{
+			file << ",\n";
+		}
+
+		first = false;
+
+		file << "{\"name\":\"Frame\",\"cat\":\"frame\",\"ph\":\"X\""
+			<< ",\"ts\":" << static_cast<double>(frame->start) / 1000.0
+			<< ",\"dur\":" << static_cast<double>(frame->end - frame->start) / 1000.0
+			<< ",\"pid\":0,\"tid\":" << mainThreadIndex
+			<< ",\"args\":{\"frame\":" << frame->index << "}}";
+
+		for (auto& e : frame->events)
+		{
+			file << ",\n{\"name\":\"" << e.name << "\",\"cat\":\"zone\",\"ph\":\"X\""
+				<< ",\"ts\":" << static_cast<double>(e.start) / 1000.0
+				<< ",\"dur\":" << static_cast<double>(e.end - e.start) / 1000.0
+				<< ",\"pid\":0,\"tid\":" << e.threadIndex << "}";
+		}
+	}
+
+	file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+	file.close();
+
+	return true;
+}
+
+void Voxel::ProfileZone::begin()
+{
+	start = FrameProfiler::getInstance().now();
+	zoneDepth++;
+}
+
+void Voxel::ProfileZone::end()
+{
+	zoneDepth--;
+
+	auto& profiler = FrameProfiler::getInstance();
+	profiler.record(name, start, profiler.now(), zoneDepth);
+}
@@ -0,0 +1,236 @@
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+// cpp
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+// voxel
+#include "Config.h"
+#include "ThreadEventRing.h"
+
+namespace Voxel
+{
+	/**
+	*	@struct ProfileEvent
+	*	@brief Single zone that ended. Times are nano seconds since profiler was created.
+	*/
+	struct ProfileEvent
+	{
+	public:
+		// Must be string literal
+		const char* name;
+		long long start;
+		long long end;
+		unsigned int threadIndex;
+		// Number of zones that were open on same thread when zone started
+		unsigned int depth;
+	};
+
+	/**
+	*	@class FrameProfiler
+	*	@brief Collects scoped zones from all threads and groups them by frame.
+	*
+	*	Zones are recorded with V_PROFILE_ZONE("name") (see ProfileZone). Each thread writes ended zones to its own ring
+	*	without lock. Main thread calls endFrame() once per frame, which drains all rings and stores zones as frame.
+	*	Keeps last FRAME_HISTORY frames. Zones of worker threads belong to frame that they ended in.
+	*
+	*	Disabled by default. While disabled, zone costs single relaxed atomic load.
+	*	Compiled out if V_PROFILER is 0.
+	*	Frames are only touched by main thread (endFrame, getters, export), so they aren't locked.
+	*/
+	class FrameProfiler
+	{
+	public:
+		// Number of frames to keep
+		static const unsigned int FRAME_HISTORY = 120;
+
+		struct Frame
+		{
+			unsigned long long index;
+			long long start;
+			long long end;
+			// Sorted by start time
+			std::vector<ProfileEvent> events;
+		};
+	private:
+		// Constructor
+		FrameProfiler();
+
+		// Destructor
+		~FrameProfiler() = default;
+
+		// Number of zones in each thread's ring
+		static const unsigned int RING_CAPACITY;
+
+		// Checked by every zone
+		static std::atomic<bool> enabled;
+
+		// Time when profiler was created. Event time is relative to this.
+		const std::chrono::steady_clock::time_point startTime;
+
+		// All rings. Rings are never deleted, so main thread can drain them without lock.
+		std::vector<std::unique_ptr<ThreadEventRing<ProfileEvent>>> rings;
+		// Name of each thread. Indexed by thread index.
+		std::vector<std::string> threadNames;
+		mutable std::mutex ringMutex;
+
+		// Index for next thread that records
+		unsigned int nextThreadIndex;
+
+		// Rolling history. Oldest frame is overwritten.
+		std::vector<Frame> frames;
+		// Index in frames where next frame is stored
+		unsigned int frameCursor;
+		// Number of frames ended since enabled
+		unsigned long long frameCount;
+		// Start of current frame
+		long long frameStart;
+		// Thread that ends frames
+		unsigned int mainThreadIndex;
+
+		// Total number of zones dropped because ring was full
+		unsigned long long droppedCount;
+
+		// Rings to drain. Main thread only.
+		std::vector<ThreadEventRing<ProfileEvent>*> drainingRings;
+
+		// Get ring of calling thread. Creates or reuses one on first call of thread.
+		ThreadEventRing<ProfileEvent>* getThreadRing();
+
+		// Drop everything in rings and history
+		void clear();
+	public:
+		static FrameProfiler& getInstance()
+		{
+			static FrameProfiler instance;
+			return instance;
+		}
+
+		FrameProfiler(FrameProfiler const&) = delete;             // Copy construct
+		FrameProfiler(FrameProfiler&&) = delete;                  // Move construct
+		FrameProfiler& operator=(FrameProfiler const&) = delete;  // Copy assign
+		FrameProfiler& operator=(FrameProfiler &&) = delete;      // Move assign
+
+		// Check if zones are recorded. Doesn't create instance.
+		static inline bool isEnabled()
+		{
+			return enabled.load(std::memory_order_relaxed);
+		}
+
+		// Enable or disable. Enabling clears history.
+		void setEnabled(const bool enabled);
+
+		// Get nano seconds since profiler was created
+		long long now() const;
+
+		/**
+		*	Record zone that ended on calling thread. Called by ProfileZone.
+		*	@param name String literal.
+		*	@param start Start time from now().
+		*	@param end End time from now().
+		*	@param depth Number of zones that were open on thread.
+		*/
+		void record(const char* name, const long long start, const long long end, const unsigned int depth);
+
+		// Name calling thread. Shown in flame view and trace.
+		void setThreadName(const std::string& name);
+
+		// Get name of thread. Returns "Thread #n" if thread wasn't named.
+		std::string getThreadName(const unsigned int threadIndex) const;
+
+		// Get number of threads that recorded
+		unsigned int getThreadCount() const;
+
+		// Get index of thread that ends frames
+		unsigned int getMainThreadIndex() const;
+
+		// Mark end of frame. Call once per frame on main thread.
+		void endFrame();
+
+		// Get number of frames in history
+		unsigned int getFrameCount() const;
+
+		/**
+		*	Get frame in history.
+		*	@param age 0 is last frame, 1 is frame before it.
+		*	@return nullptr if there isn't such frame.
+		*/
+		const Frame* getFrame(const unsigned int age) const;
+
+		// Get frame that took longest in history. nullptr if history is empty.
+		const Frame* getSlowestFrame() const;
+
+		// Get total number of zones dropped because ring was full
+		unsigned long long getDroppedCount() const;
+
+		// Get multi line summary of zones in history. Mean and max time per frame of each zone, slowest first.
+		std::vector<std::string> getSummary() const;
+
+		/**
+		*	Export frames in history to Chrome trace json.
+		*	@param path Path of json file.
+		*	@return true if file was written.
+		*/
+		bool exportChromeTrace(const std::string& path) const;
+	};
+
+	/**
+	*	@class ProfileZone
+	*	@brief Records time between construction and destruction as zone. Use V_PROFILE_ZONE.
+	*/
+	class ProfileZone
+	{
+	private:
+		const char* name;
+		long long start;
+		bool active;
+
+		void begin();
+		void end();
+	public:
+		// Constructor. Name must be string literal.
+		ProfileZone(const char* name)
+			: name(name)
+			, start(0)
+			, active(FrameProfiler::isEnabled())
+		{
+			if (active)
+			{
+				begin();
+			}
+		}
+
+		// Destructor
+		~ProfileZone()
+		{
+			if (active)
+			{
+				end();
+			}
+		}
+
+		ProfileZone(ProfileZone const&) = delete;
+		ProfileZone& operator=(ProfileZone const&) = delete;
+	};
+}
+
+#define V_PROFILE_CONCAT_INNER(a, b) a##b
+#define V_PROFILE_CONCAT(a, b) V_PROFILE_CONCAT_INNER(a, b)
+
+// Profile rest of scope. Name must be string literal.
+#if V_PROFILER
+#define V_PROFILE_ZONE(name) Voxel::ProfileZone V_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define V_PROFILE_END_FRAME() Voxel::FrameProfiler::getInstance().endFrame()
+#define V_PROFILE_THREAD_NAME(name) Voxel::FrameProfiler::getInstance().setThreadName(name)
+#else
+#define V_PROFILE_ZONE(name) ((void)0)
+#define V_PROFILE_END_FRAME() ((void)0)
+#define V_PROFILE_THREAD_NAME(name) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,330 @@
+// pch
+#include "PreCompiled.h"
+
+#include "FrameProfilerView.h"
+
+#if V_DEBUG && V_DEBUG_CONSOLE
+
+// cpp
+#include <cstdio>
+
+// voxel
+#include "FrameProfiler.h"
+#include "StringID.h"
+
+using namespace Voxel;
+
+const unsigned int Voxel::FrameProfilerView::MAX_BARS = 256;
+const unsigned int Voxel::FrameProfilerView::MAX_LABELS = 12;
+const unsigned int Voxel::FrameProfilerView::MAX_ROWS = 16;
+const float Voxel::FrameProfilerView::WIDTH = 600.0f;
+const float Voxel::FrameProfilerView::ROW_HEIGHT = 16.0f;
+const float Voxel::FrameProfilerView::GRAPH_HEIGHT = 50.0f;
+const float Voxel::FrameProfilerView::TITLE_HEIGHT = 22.0f;
+const float Voxel::FrameProfilerView::REFRESH_INTERVAL = 0.25f;
+
+namespace
+{
+	// Space between background and content
+	const float PADDING = 5.0f;
+
+	// Frame time that fills graph
+	const double GRAPH_MAX_MILLISECONDS = 1000.0 / 30.0;
+
+	// Zones wider than this are labeled
+	const float LABEL_MIN_WIDTH = 80.0f;
+
+	// Zone color is picked by hash of name so same zone keeps same color
+	const glm::vec3 ZONE_COLORS[] =
+	{
+		glm::vec3(0.90f, 0.45f, 0.25f),
+		glm::vec3(0.30f, 0.60f, 0.90f),
+		glm::vec3(0.55f, 0.80f, 0.30f),
+		glm::vec3(0.85f, 0.35f, 0.60f),
+		glm::vec3(0.95f, 0.75f, 0.25f),
+		glm::vec3(0.40f, 0.80f, 0.75f),
+		glm::vec3(0.65f, 0.50f, 0.90f),
+		glm::vec3(0.75f, 0.60f, 0.45f),
+	};
+
+	const unsigned int ZONE_COLOR_COUNT = sizeof(ZONE_COLORS) / sizeof(ZONE_COLORS[0]);
+}
+
+Voxel::FrameProfilerView::FrameProfilerView()
+	: node(nullptr)
+	, background(nullptr)
+	, title(nullptr)
+	, visible(false)
+	, elapsedTime(0.0f)
+{}
+
+void Voxel::FrameProfilerView::init(UI::Canvas * canvas)
+{
+	const glm::vec3 outlineColor = glm::vec3(0.0f);
+	const int fontID = 2;
+
+	const float height = TITLE_HEIGHT + GRAPH_HEIGHT + PADDING + (ROW_HEIGHT * static_cast<float>(MAX_ROWS)) + (PADDING * 2.0f);
+
+	// Children are placed in pixels from top left of view. Node has no size, so its position is origin of children.
+	node = UI::Node::create("profilerView");
+	node->setCoordinateOrigin(glm::vec2(0.5f, 0.5f));
+	node->setPosition(glm::vec2(-WIDTH - (PADDING * 3.0f), -PADDING * 3.0f));
+	node->setVisibility(false);
+
+	background = UI::Image::createFromSpriteSheet("profilerBg", "GlobalSpriteSheet", "1x1_white.png");
+	background->setPivot(glm::vec2(-0.5f, 0.5f));
+	background->setPosition(glm::vec2(-PADDING, PADDING));
+	background->setScale(glm::vec2(WIDTH + (PADDING * 2.0f), height));
+	background->setColor(glm::vec3(0.0f));
+	background->setOpacity(0.6f);
+	node->addChild(background);
+
+	title = UI::Text::createWithOutline("profilerTitle", "Profiler", fontID, outlineColor);
+	title->setPivot(glm::vec2(-0.5f, 0.5f));
+	node->addChild(title);
+
+	// Frame graph. Newest frame is on right.
+	const float frameBarWidth = WIDTH / static_cast<float>(FrameProfiler::FRAME_HISTORY);
+
+	for (unsigned int i = 0; i < FrameProfiler::FRAME_HISTORY; i++)
+	{
+		auto bar = UI::Image::createFromSpriteSheet("profilerFrame" + std::to_string(i), "GlobalSpriteSheet", "1x1_white.png");
+		bar->setPivot(glm::vec2(-0.5f, -0.5f));
+		bar->setPosition(glm::vec2(frameBarWidth * static_cast<float>(i), -(TITLE_HEIGHT + GRAPH_HEIGHT)));
+		bar->setVisibility(false);
+		node->addChild(bar);
+
+		frameBars.push_back(bar);
+	}
+
+	for (unsigned int i = 0; i < MAX_BARS; i++)
+	{
+		auto bar = UI::Image::createFromSpriteSheet("profilerZone" + std::to_string(i), "GlobalSpriteSheet", "1x1_white.png");
+		bar->setPivot(glm::vec2(-0.5f, 0.5f));
+		bar->setVisibility(false);
+		node->addChild(bar);
+
+		zoneBars.push_back(bar);
+	}
+
+	// Labels are added last so they are drawn above bars
+	for (unsigned int i = 0; i < MAX_LABELS; i++)
+	{
+		auto label = UI::Text::createWithOutline("profilerLabel" + std::to_string(i), "zone 00.00 ms", fontID, outlineColor);
+		label->setPivot(glm::vec2(-0.5f, 0.5f));
+		label->setVisibility(false);
+		node->addChild(label);
+
+		labels.push_back(label);
+	}
+
+	canvas->addChild(node, 0);
+}
+
+void Voxel::FrameProfilerView::setVisibility(const bool visibility)
+{
+	visible = visibility;
+
+	if (node)
+	{
+		node->setVisibility(visibility);
+	}
+
+	if (visibility)
+	{
+		refresh();
+		elapsedTime = 0.0f;
+	}
+}
+
+bool Voxel::FrameProfilerView::getVisibility() const
+{
+	return visible;
+}
+
+void Voxel::FrameProfilerView::update(const float delta)
+{
+	if (!visible)
+	{
+		return;
+	}
+
+	elapsedTime += delta;
+
+	if (elapsedTime >= REFRESH_INTERVAL)
+	{
+		elapsedTime = 0.0f;
+		refresh();
+	}
+}
+
+void Voxel::FrameProfilerView::refresh()
+{
+	if (node == nullptr)
+	{
+		return;
+	}
+
+	auto& profiler = FrameProfiler::getInstance();
+
+	// Frame graph
+	const unsigned int frameCount = profiler.getFrameCount();
+
+	for (unsigned int i = 0; i < FrameProfiler::FRAME_HISTORY; i++)
+	{
+		auto bar = frameBars.at(i);
+		auto frame = profiler.getFrame(FrameProfiler::FRAME_HISTORY - 1 - i);
+
+		if (frame == nullptr)
+		{
+			bar->setVisibility(false);
+			continue;
+		}
+
+		const double ms = static_cast<double>(frame->end - frame->start) / 1000000.0;
+		const float ratio = static_cast<float>(std::min(ms / GRAPH_MAX_MILLISECONDS, 1.0));
+
+		bar->setScale(glm::vec2(std::max(WIDTH / static_cast<float>(FrameProfiler::FRAME_HISTORY) - 1.0f, 1.0f), std::max(GRAPH_HEIGHT * ratio, 1.0f)));
+
+		if (ms <= GRAPH_MAX_MILLISECONDS * 0.5)
+		{
+			bar->setColor(glm::vec3(0.3f, 0.85f, 0.3f));
+		}
+		else if (ms <= GRAPH_MAX_MILLISECONDS)
+		{
+			bar->setColor(glm::vec3(0.95f, 0.8f, 0.2f));
+		}
+		else
+		{
+			bar->setColor(glm::vec3(0.95f, 0.25f, 0.2f));
+		}
+
+		bar->setVisibility(true);
+	}
+
+	auto slowest = profiler.getSlowestFrame();
+
+	if (slowest == nullptr)
+	{
+		title->setText(FrameProfiler::isEnabled() ? "Profiler: waiting for frames" : "Profiler: disabled (profiler true)");
+
+		for (auto bar : zoneBars)
+		{
+			bar->setVisibility(false);
+		}
+
+		for (auto label : labels)
+		{
+			label->setVisibility(false);
+		}
+
+		return;
+	}
+
+	const long long frameDuration = std::max(slowest->end - slowest->start, 1LL);
+	const double frameMilliSeconds = static_cast<double>(frameDuration) / 1000000.0;
+
+	// First row of each thread. Main thread is on top, then other threads in order they started recording.
+	const unsigned int threadCount = profiler.getThreadCount();
+	const unsigned int mainThreadIndex = profiler.getMainThreadIndex();
+
+	std::vector<unsigned int> rowCounts(threadCount, 0);
+
+	for (auto& e : slowest->events)
+	{
+		if (e.threadIndex < threadCount)
+		{
+			rowCounts.at(e.threadIndex) = std::max(rowCounts.at(e.threadIndex), e.depth + 1);
+		}
+	}
+
+	std::vector<unsigned int> firstRows(threadCount, 0);
+	unsigned int rowCount = (mainThreadIndex < threadCount) ? rowCounts.at(mainThreadIndex) : 0;
+
+	for (unsigned int i = 0; i < threadCount; i++)
+	{
+		if (i == mainThreadIndex)
+		{
+			continue;
+		}
+
+		firstRows.at(i) = rowCount;
+		rowCount += rowCounts.at(i);
+	}
+
+	const float rowsTop = -(TITLE_HEIGHT + GRAPH_HEIGHT + PADDING);
+
+	unsigned int barIndex = 0;
+	unsigned int labelIndex = 0;
+	unsigned int hiddenCount = 0;
+
+	for (auto& e : slowest->events)
+	{
+		if (e.threadIndex >= threadCount)
+		{
+			continue;
+		}
+
+		const unsigned int row = firstRows.at(e.threadIndex) + e.depth;
+
+		if (row >= MAX_ROWS || barIndex >= MAX_BARS)
+		{
+			hiddenCount++;
+			continue;
+		}
+
+		// Zones of worker threads can start before frame started
+		const long long start = std::max(e.start, slowest->start) - slowest->start;
+		const long long end = std::min(e.end, slowest->end) - slowest->start;
+
+		const float x = static_cast<float>(static_cast<double>(start) / static_cast<double>(frameDuration)) * WIDTH;
+		const float width = std::max(static_cast<float>(static_cast<double>(std::max(end - start, 0LL)) / static_cast<double>(frameDuration)) * WIDTH, 1.0f);
+		const float y = rowsTop - (ROW_HEIGHT * static_cast<float>(row));
+
+		auto bar = zoneBars.at(barIndex);
+		bar->setPosition(glm::vec2(x, y));
+		bar->setScale(glm::vec2(width, ROW_HEIGHT - 1.0f));
+		bar->setColor(ZONE_COLORS[StringID::hash(e.name) % ZONE_COLOR_COUNT]);
+		bar->setVisibility(true);
+
+		barIndex++;
+
+		if (width >= LABEL_MIN_WIDTH && labelIndex < MAX_LABELS)
+		{
+			char text[128];
+			std::snprintf(text, sizeof(text), "%s %.2f ms", e.name, static_cast<double>(e.end - e.start) / 1000000.0);
+
+			auto label = labels.at(labelIndex);
+			label->setText(text);
+			label->setPosition(glm::vec2(x + 2.0f, y));
+			label->setVisibility(true);
+
+			labelIndex++;
+		}
+	}
+
+	for (unsigned int i = barIndex; i < MAX_BARS; i++)
+	{
+		zoneBars.at(i)->setVisibility(false);
+	}
+
+	for (unsigned int i = labelIndex; i < MAX_LABELS; i++)
+	{
+		labels.at(i)->setVisibility(false);
+	}
+
+	char text[256];
+
+	if (hiddenCount > 0)
+	{
+		std::snprintf(text, sizeof(text), "Slowest of %u frames: #%llu %.2f ms, %u zones (%u hidden)", frameCount, slowest->index, frameMilliSeconds, static_cast<unsigned int>(slowest->events.size()), hiddenCount);
+	}
+	else
+	{
+		std::snprintf(text, sizeof(text), "Slowest of %u frames: #%llu %.2f ms, %u zones", frameCount, slowest->index, frameMilliSeconds, static_cast<unsigned int>(slowest->events.size()));
+	}
+
+	title->setText(text);
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef FRAME_PROFILER_VIEW_H
+#define FRAME_PROFILER_VIEW_H
+
+// voxel
+#include "Config.h"
+
+#if V_DEBUG && V_DEBUG_CONSOLE
+
+// cpp
+#include <vector>
+
+// voxel
+#include "UI.h"
+
+namespace Voxel
+{
+	/**
+	*	@class FrameProfilerView
+	*	@brief Draws FrameProfiler's history in debug console.
+	*
+	*	Top row is frame time of each frame in history (green under 16.6 ms, yellow under 33.3 ms, red above).
+	*	Below is timeline of slowest frame in history. Main thread's zones are stacked by depth, then each other thread has own rows.
+	*	Widest zones are labeled with name and time.
+	*	Uses fixed pool of 1x1 images and texts, and refreshes few times per second, so drawing doesn't distort what it shows.
+	*/
+	class FrameProfilerView
+	{
+	private:
+		static const unsigned int MAX_BARS;
+		static const unsigned int MAX_LABELS;
+		static const unsigned int MAX_ROWS;
+		static const float WIDTH;
+		static const float ROW_HEIGHT;
+		static const float GRAPH_HEIGHT;
+		static const float TITLE_HEIGHT;
+		static const float REFRESH_INTERVAL;
+
+		// Parent of all ui. Top right of canvas.
+		UI::Node* node;
+		UI::Image* background;
+		UI::Text* title;
+
+		// Frame time of each frame in history
+		std::vector<UI::Image*> frameBars;
+		// Zones of slowest frame
+		std::vector<UI::Image*> zoneBars;
+		std::vector<UI::Text*> labels;
+
+		bool visible;
+
+		// Time since last refresh
+		float elapsedTime;
+
+		// Rebuild bars from profiler
+		void refresh();
+	public:
+		// Constructor
+		FrameProfilerView();
+
+		// Destructor. UI is owned by canvas.
+		~FrameProfilerView() = default;
+
+		// Create ui and add to canvas
+		void init(UI::Canvas* canvas);
+
+		void setVisibility(const bool visibility);
+		bool getVisibility() const;
+
+		// Refresh if visible and refresh interval has passed
+		void update(const float delta);
+	};
+}
+
+#endif
+
+#endif
@@ -18,6 +18,8 @@
 #include "Terrain.h"
 
 #include "Physics.h"
+#include "FixedTimeStep.h"
+#include "Simulation.h"
 
 #include "Setting.h"
 
@@ -26,6 +28,7 @@
 #include "Frustum.h"
 
 #include "SpriteSheet.h"
+#include "AssetLoader.h"
 
 #include "UI.h"
 #include "UIActions.h"
@@ -41,6 +44,10 @@
 #include "Player.h"
 #include "Skybox.h"
 #include "Calendar.h"
+#include "WorldParticleSystem.h"
+#include "WeatherSystem.h"
+#include "ThreadPool.h"
+#include "FrameProfiler.h"
 
 #include "Application.h"
 #include "GLView.h"
@@ -54,24 +61,30 @@ using namespace Voxel;
 
 GameScene::GameScene()
 	: Scene()
+	, loadingState(LoadingState::INITIALIZING)
+	, reloadState(ReloadState::NONE)
+	, gameState(GameState::IDLE)
 	, world(nullptr)
-	, cursor(&Voxel::Cursor::getInstance())
 	, chunkMap(nullptr)
 	, chunkMeshGenerator(nullptr)
-	, input(&InputHandler::getInstance())
-	, player(nullptr)
 	, chunkWorkManager(nullptr)
-	, staticCanvas(nullptr)
-	, dynamicCanvas(nullptr)
-	, timeLabel(nullptr)
-	, loadingCanvas(nullptr)
+	, simulationStep(nullptr)
+	, simulation(nullptr)
+	, jumpRequested(false)
+	, player(nullptr)
 	, skybox(nullptr)
 	, calendar(nullptr)
+	, worldParticleSystem(nullptr)
+	, weatherSystem(nullptr)
+	, threadPool(nullptr)
 	, settingPtr(nullptr)
 	, worldMap(nullptr)
-	, loadingState(LoadingState::INITIALIZING)
-	, reloadState(ReloadState::NONE)
-	, gameState(GameState::IDLE)
+	, input(&InputHandler::getInstance())
+	, staticCanvas(nullptr)
+	, dynamicCanvas(nullptr)
+	, timeLabel(nullptr)
+	, loadingCanvas(nullptr)
+	, cursor(&Voxel::Cursor::getInstance())
 	, skipUpdate(false)
 #if V_DEBUG
 #if V_DEBUG_CONSOLE
@@ -87,20 +100,39 @@ GameScene::GameScene()
 GameScene::~GameScene()
 {}
 
+void Voxel::GameScene::preload(std::vector<std::shared_ptr<AssetHandle>>& handles)
+{
+	// Same as initSpriteSheets
+	handles.push_back(AssetLoader::getInstance().loadSpriteSheetAsync("UISpriteSheet.json"));
+
+	// Noise is used by tiled world. Init before world task starts.
+	initRandoms();
+
+	// World is only data, so it's built on loader thread while transition fades in.
+	world = new World();
+
+	World* newWorld = world;
+	const bool tiled = Setting::getInstance().isWorldTiled();
+	const std::string seed = globalSeed;
+
+	worldHandle = AssetLoader::getInstance().runAsync("World", [newWorld, tiled, seed]()
+	{
+		return buildWorld(newWorld, tiled, seed);
+	});
+
+	handles.push_back(worldHandle);
+}
+
 void Voxel::GameScene::init()
 {
 	Application::getInstance().getGLView()->setClearColor(glm::vec3(0.0f));
 	
-	// Init random first
-	initRandoms();
-
 	settingPtr = &Setting::getInstance();
 
 	// init spritesheet
 	initSpriteSheets();
 	
-	// Init world
-	world = new World();
+	// World is created in preload
 
 	// Init world map
 	worldMap = new WorldMap();
@@ -116,6 +148,9 @@ void Voxel::GameScene::init()
 	// init physics
 	physics = new Physics();
 
+	// Fixed time step for simulation
+	simulationStep = new FixedTimeStep(settingPtr->getSimulationTickRate());
+
 	// player
 	player = new Player();
 
@@ -125,18 +160,18 @@ void Voxel::GameScene::init()
 	program->use(true);
 
 	// Lights
-	program->setUniformVec4("ambientColor", glm::vec4(1.0f));
-	program->setUniformFloat("pointLights[0].lightIntensity", 5.0f);
-	program->setUniformVec4("pointLights[0].lightColor", glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+	program->setUniformVec4(SID("ambientColor"), glm::vec4(1.0f));
+	program->setUniformFloat(SID("pointLights[0].lightIntensity"), 5.0f);
+	program->setUniformVec4(SID("pointLights[0].lightColor"), glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
 
 	// Skybox
 	initSkyBox();
 
 	// Initialize fog uniforms
-	program->setUniformVec3("playerPosition", player->getPosition());
-	program->setUniformFloat("fogDistance", skybox->getFogDistance());
-	program->setUniformBool("fogEnabled", skybox->isFogEnabled());
-	program->setUniformFloat("fogLength", skybox->getFogLength());
+	program->setUniformVec3(SID("playerPosition"), player->getPosition());
+	program->setUniformFloat(SID("fogDistance"), skybox->getFogDistance());
+	program->setUniformBool(SID("fogEnabled"), skybox->isFogEnabled());
+	program->setUniformFloat(SID("fogLength"), skybox->getFogLength());
 
 	// stop use
 	program->use(false);
@@ -145,6 +180,14 @@ void Voxel::GameScene::init()
 	calendar = new Calendar();
 	calendar->init();
 
+	// Simulation tick. Reads movement from MovementInput, not from input devices.
+	simulation = new Simulation(player, physics, chunkMap, calendar);
+
+	// World particles. Chunk work manager already uses threads, so only use half of hardware threads. Calling thread also works.
+	threadPool = new ThreadPool(std::max(std::thread::hardware_concurrency() / 2, 1u) - 1);
+	worldParticleSystem = new WorldParticleSystem(262144);
+	weatherSystem = new WeatherSystem();
+
 	// UI & font
 	initUI();
 
@@ -283,8 +326,8 @@ void Voxel::GameScene::releaseSpriteSheets()
 {
 	auto& ssm = SpriteSheetManager::getInstance();
 
-	ssm.removeSpriteSheetByKey("UISpriteSheet");
-	//ssm.removeSpriteSheetByKey("EnvironmentSpriteSheet");
+	ssm.removeSpriteSheetByKey(SID("UISpriteSheet"));
+	//ssm.removeSpriteSheetByKey(SID("EnvironmentSpriteSheet"));
 
 	std::cout << "GameScene released spritesheet\n";
 	ssm.print(false);
@@ -343,6 +386,10 @@ void Voxel::GameScene::release()
 	// Delete physics. 
 	if (physics) delete physics;
 
+	// Delete simulation time step and tick.
+	if (simulationStep) delete simulationStep;
+	if (simulation) delete simulation;
+
 	// Release player. Possible vao release if some debugs are enabled
 	if (player)	delete player;
 
@@ -352,6 +399,13 @@ void Voxel::GameScene::release()
 	// Release calendar
 	if (calendar) delete calendar;
 
+	// Release weather and world particles. Releases particle buffers.
+	if (weatherSystem) delete weatherSystem;
+	if (worldParticleSystem) delete worldParticleSystem;
+
+	// Release thread pool. Joins all threads.
+	if (threadPool) delete threadPool;
+
 	// Release world
 	if (world) delete world;
 
@@ -447,11 +501,56 @@ void GameScene::createChunkMap()
 	std::cout << "[ChunkMap] ElapsedTime: " << Utility::Time::toMilliSecondString(start, end) << std::endl;
 }
 
-void Voxel::GameScene::createWorld()
+bool Voxel::GameScene::buildWorld(World * world, const bool tiled, const std::string & seed)
 {
 	world->setTemperature(0.5f, 1.5f);
 	world->setMoisture(0.5f, 1.5f);
-	world->init(10, 10, 0, globalSeed);
+
+	if (tiled)
+	{
+		// Regions are built per tile when chunks reach them. World map doesn't draw tiled world.
+		world->initTiled(0, seed);
+	}
+	else
+	{
+		world->init(10, 10, 0, seed);
+	}
+
+	return world->getCurrentRegion() != nullptr;
+}
+
+void Voxel::GameScene::createWorld()
+{
+	// World is built in preload. Director waits for it before init, but don't touch world while task can still run.
+	if (worldHandle && !worldHandle->isDone())
+	{
+		AssetLoader::getInstance().wait({ worldHandle });
+	}
+
+	if (worldHandle == nullptr || !worldHandle->isReady())
+	{
+		// Task threw or didn't find starting region. World can be half built, so start over on main thread.
+		std::cout << "[GameScene] Failed to build world on loader thread. Building on main thread.\n";
+
+		if (world)
+		{
+			delete world;
+		}
+
+		world = new World();
+
+		if (!buildWorld(world, settingPtr->isWorldTiled(), globalSeed))
+		{
+			throw std::runtime_error("Failed to build world. World doesn't have starting region.");
+		}
+	}
+
+	worldHandle = nullptr;
+
+	// Only debug diagram needs OpenGL
+#if V_DEBUG && V_DEBUG_VORONOI_LINE
+	world->initVoronoiDebug();
+#endif
 
 	auto startingRegionSitePos = world->getCurrentRegion()->getSitePosition();
 	//startingRegionSitePos = world->getRegion(31)->getSitePosition();
@@ -490,6 +589,8 @@ void Voxel::GameScene::teleportPlayer(const glm::vec3 & position)
 
 void GameScene::update(const float delta)
 {
+	V_PROFILE_ZONE("GameScene::update");
+
 	if (loadingState == LoadingState::INITIALIZING)
 	{
 		loadingCanvas->update(delta);
@@ -556,6 +657,9 @@ void GameScene::update(const float delta)
 				// Chunk generation is done. Replace player if player teleported
 				replacePlayerToTopY();
 
+				// Loading took long time. Don't let simulation catch up.
+				simulationStep->reset();
+
 				// Reset states
 				loadingState = LoadingState::FINISHED;
 				reloadState = ReloadState::NONE;
@@ -590,17 +694,24 @@ void GameScene::update(const float delta)
 		// Check if there is a chunk to unload on main thread
 		checkUnloadedChunks();
 
-		// Update physics
-		updatePhysics(delta);
+		// Run simulation in fixed ticks. Rendering uses whatever state last tick left.
+		const int ticks = simulationStep->advance(delta);
+		const float tickDelta = simulationStep->getTickDelta();
+
+		{
+			V_PROFILE_ZONE("Simulation");
 
-		// Resolve collision in game
-		//updateCollisionResolution();
+			for (int i = 0; i < ticks; i++)
+			{
+				updateSimulation(tickDelta);
+			}
+		}
 
 		bool playerMoved = player->didMoveThisFrame();
 		bool playerRotated = player->didRotateThisFrame();
 
-		// After resolving collision and updating physics, update player's movement
-		player->updateMovement(delta);
+		// After resolving collision and updating physics, update player's movement. Interpolated between last two ticks.
+		player->updateMovement(simulationStep->getAlpha());
 
 		// First check visible chunk
 		Camera::mainCamera->getFrustum()->updateFrustumPlanes(player->getViewMatrix() * player->getWorldMatrix());
@@ -641,7 +752,7 @@ void GameScene::update(const float delta)
 
 			auto program = ProgramManager::getInstance().getProgram(ProgramManager::PROGRAM_NAME::BLOCK_SHADER);
 			program->use(true);
-			program->setUniformVec3("playerPosition", playerPos);
+			program->setUniformVec3(SID("playerPosition"), playerPos);
 		}
 
 		player->update(delta);
@@ -653,11 +764,17 @@ void GameScene::update(const float delta)
 		
 		player->updateCameraDistanceZ(delta);
 
-		calendar->update(delta);
-
 		skybox->update(delta);
 		skybox->updateColor(calendar->getHour(), calendar->getMinutes(), calendar->getSeconds());
 
+		{
+			V_PROFILE_ZONE("Particles");
+
+			// Weather emits drops first, so new drops are simulated on same frame
+			weatherSystem->update(delta, player->getPosition(), worldParticleSystem);
+			worldParticleSystem->update(delta, chunkMap, player->getPosition(), threadPool);
+		}
+
 		//timeLabel->setText(calendar->getTimeInStr(false));
 
 #if V_DEBUG && V_DEBUG_CONSOLE
@@ -786,7 +903,7 @@ void Voxel::GameScene::updateKeyboardInput(const float delta)
 	if(input->getKeyDown(GLFW_KEY_T, true))
 	{
 		/*
-		staticCanvas->removeChild("timeLabel");
+		staticCanvas->removeChild(SID("timeLabel"));
 
 		timeLabel = UI::Text::createWithOutline("timeLabel", calendar->getTimeInStr(false), 2, glm::vec4(0, 0, 0, 1), UI::Text::ALIGN::LEFT);
 		timeLabel->setPosition(-200.0f, -5.0f);
@@ -939,44 +1056,12 @@ void Voxel::GameScene::updateKeyboardInput(const float delta)
 #endif
 	if (!cursor->isVisible())
 	{
-		if (input->getKeyDown(InputHandler::KEY_INPUT::MOVE_FOWARD))
-		{
-			player->moveFoward(delta);
-		}
-		else if (input->getKeyDown(InputHandler::KEY_INPUT::MOVE_BACKWARD))
-		{
-			player->moveBackward(delta);
-		}
-
-		if (input->getKeyDown(InputHandler::KEY_INPUT::MOVE_LEFT))
-		{
-			player->moveLeft(delta);
-		}
-		else if (input->getKeyDown(InputHandler::KEY_INPUT::MOVE_RIGHT))
+		// Movement keys are polled on simulation tick. Jump key is only down for a single frame, so keep it until next tick.
+		if (!player->isFlying() && player->isOnGround())
 		{
-			player->moveRight(delta);
-		}
-
-		if (player->isFlying())
-		{
-			if (input->getKeyDown(InputHandler::KEY_INPUT::MOVE_UP))
-			{
-				player->moveUp(delta);
-			}
-			else if (input->getKeyDown(InputHandler::KEY_INPUT::MOVE_DOWN))
-			{
-				player->moveDown(delta);
-			}
-		}
-		else
-		{
-			if (player->isOnGround())
+			if (input->getKeyDown(InputHandler::KEY_INPUT::JUMP, true))
 			{
-				if (input->getKeyDown(InputHandler::KEY_INPUT::JUMP, true))
-				{
-					player->jump();
-					physics->applyJumpForceToPlayer(glm::vec3(0, 2.2f, 0));
-				}
+				jumpRequested = true;
 			}
 		}
 	}
@@ -1158,6 +1243,8 @@ void Voxel::GameScene::updateMouseClickInput()
 			{
 				auto lookingBlock = player->getLookingBlock();
 				auto blockPos = player->getLookingBlock()->getWorldCoordinate();
+				// Block is deleted on remove. Emit debris first.
+				worldParticleSystem->emitBlockDebris(blockPos, lookingBlock->getColor3(), lookingBlock->isLeaves());
 				chunkMap->removeBlockAt(blockPos, chunkWorkManager);
 				updatePlayerRaycast();
 			}
@@ -1207,56 +1294,7 @@ void Voxel::GameScene::updateControllerInput(const float delta)
 {
 	if (input->hasController())
 	{
-		auto valueLeftAxisX = input->getAxisValue(GAMEPAD::XBOX_360::AXIS::L_AXIS_X);
-		if (valueLeftAxisX  > 0.0f)
-		{
-			// Right
-			player->moveRight(delta);
-		}
-		else if (valueLeftAxisX < 0.0f)
-		{
-			player->moveLeft(delta);
-		}
-		// Else, didn't move
-
-		auto valueLeftAxisY = input->getAxisValue(GAMEPAD::XBOX_360::AXIS::L_AXIS_Y);
-		if (valueLeftAxisY > 0.0f)
-		{
-			//foward
-			player->moveFoward(delta);
-		}
-		else if (valueLeftAxisY < 0.0f)
-		{
-			// back
-			player->moveBackward(delta);
-		}
-
-		if (player->isFlying())
-		{
-			auto valueLeftTrigger = input->getAxisValue(GAMEPAD::XBOX_360::AXIS::LT);
-			if (valueLeftTrigger > 0.0f)
-			{
-				player->moveUp(delta);
-			}
-
-			auto valueRightTrigger = input->getAxisValue(GAMEPAD::XBOX_360::AXIS::RT);
-			if (valueRightTrigger > 0.0f)
-			{
-				player->moveDown(delta);
-			}
-		}
-		else
-		{
-			if (player->isOnGround())
-			{
-				if (input->isControllerButtonDown(Voxel::GAMEPAD::XBOX_360::BUTTON::B))
-				{
-					// Todo: Controller manager doesn't have feature to check if button was pressed only current frame.
-					player->jump();
-					physics->applyJumpForceToPlayer(glm::vec3(0, 2.2f, 0));
-				}
-			}
-		}
+		// Left stick and triggers are polled on simulation tick.
 
 		auto valueRightAxisX = input->getAxisValue(GAMEPAD::XBOX_360::AXIS::R_AXIS_X);
 		if (valueRightAxisX != 0.0f)
@@ -1274,123 +1312,64 @@ void Voxel::GameScene::updateControllerInput(const float delta)
 	}
 }
 
-void Voxel::GameScene::updatePhysics(const float delta)
+void Voxel::GameScene::updateSimulation(const float delta)
 {
-	// Don't update if player is flying
-	if (player->isFlying()) return;
-
-	// Update player's jump force
-	bool jumping = physics->updatePlayerJumpForce(player, delta);
-
-	/*
-	// debug
-	auto state = player->getJumpState();
-
-	switch (state)
-	{
-	case Voxel::Player::JumpState::IDLE:
-		std::cout << "JS: IDLE\n";
-		break;
-	case Voxel::Player::JumpState::JUMPING:
-		std::cout << "JS: JUMPING\n";
-		break;
-	case Voxel::Player::JumpState::FALLING:
-		std::cout << "JS: FALLING\n";
-		break;
-	default:
-		break;
-	}
-	*/
-
-	if (!jumping)
-	{
-		// Only apply when player is not jumping
-		physics->applyGravity(player, delta);
-	}
+	MovementInput movementInput;
 
-	auto start = Utility::Time::now();
+	// Movement input
+	updateMovementInput(movementInput);
 
-	std::vector<Block*> collidableBlocks;
+	// Movement, physics and calendar
+	simulation->tick(movementInput, delta);
+}
 
-	bool autoJumped = false;
+void Voxel::GameScene::updateMovementInput(MovementInput& movementInput)
+{
+	// Jump request is only valid for next tick.
+	const bool jump = jumpRequested;
+	jumpRequested = false;
 
-	// Check if player can auto jump
-	if (player->isOnGround())
+#if V_DEBUG && V_DEBUG_CAMERA_MODE
+	if (cameraControlMode)
 	{
-		// Can auto jump only if player is on ground
-
-		// Query near by block in XZ axis
-		chunkMap->queryNearByCollidableBlocksInXZ(player->getNextPosition(), collidableBlocks);
-
-		// resolve auto jump
-		autoJumped = physics->resolveAutoJump(player, collidableBlocks);
-
-		if (autoJumped)
-		{
-			// If auto jump, it means there isn't anything that collides player. 
-			return;
-		}
-		else
-		{
-			// Didn't auto jumped. Don't need to query blocks again
-			
-			// Reoslve XZ
-			physics->resolvePlayerAndBlockCollisionInXZAxis(player, collidableBlocks);
-		}
+		// Keys moves camera
+		return;
 	}
-	else
-	{
-		// Either jumping or falling. Both need to resolve collision between in axis XZ first
-
-		// Query near by block in XZ axis
-		chunkMap->queryNearByCollidableBlocksInXZ(player->getNextPosition(), collidableBlocks);
-
-		// Reoslve XZ
-		physics->resolvePlayerAndBlockCollisionInXZAxis(player, collidableBlocks);
-
-		// clear list
-		collidableBlocks.clear();
-
-		if (player->isJumping())
-		{
-			// query again in negative Y 
-			chunkMap->queryTopCollidableBlocksInY(player->getNextPosition(), collidableBlocks);
-
-			// At this moment, player won't have any blocks that are colliding in XZ direction. Check bottom y. If so, player hit the ground.
-			physics->resolvePlayerTopCollision(player, collidableBlocks);
-		}
-		else if (player->isFalling())
-		{
-			// query again in negative Y 
-			chunkMap->queryBottomCollidableBlocksInY(player->getNextPosition(), collidableBlocks);
+#endif
 
-			// At this moment, player won't have any blocks that are colliding in XZ direction. Check bottom y. If so, player hit the ground.
-			physics->resolvePlayerBottomCollision(player, collidableBlocks);
-		}
+	if (!cursor->isVisible())
+	{
+		movementInput.forward = input->getKeyDown(InputHandler::KEY_INPUT::MOVE_FOWARD);
+		movementInput.backward = input->getKeyDown(InputHandler::KEY_INPUT::MOVE_BACKWARD);
+		movementInput.left = input->getKeyDown(InputHandler::KEY_INPUT::MOVE_LEFT);
+		movementInput.right = input->getKeyDown(InputHandler::KEY_INPUT::MOVE_RIGHT);
+		movementInput.up = input->getKeyDown(InputHandler::KEY_INPUT::MOVE_UP);
+		movementInput.down = input->getKeyDown(InputHandler::KEY_INPUT::MOVE_DOWN);
+		movementInput.jump = jump;
 	}
 
-	// Keep track if player is on ground or not. If player is jumping, skip
-
-	if (!jumping)
+	if (input->hasController())
 	{
-		// clear list
-		collidableBlocks.clear();
+		auto valueLeftAxisX = input->getAxisValue(GAMEPAD::XBOX_360::AXIS::L_AXIS_X);
+		movementInput.right = movementInput.right || valueLeftAxisX > 0.0f;
+		movementInput.left = movementInput.left || valueLeftAxisX < 0.0f;
 
-		// query again in negative Y 
-		auto pos = player->getPosition();
-		//pos.y = player->getNextPosition().y;
-		chunkMap->queryBottomCollidableBlocksInY(pos, collidableBlocks);
+		auto valueLeftAxisY = input->getAxisValue(GAMEPAD::XBOX_360::AXIS::L_AXIS_Y);
+		movementInput.forward = movementInput.forward || valueLeftAxisY > 0.0f;
+		movementInput.backward = movementInput.backward || valueLeftAxisY < 0.0f;
 
-		// At this moment, player won't have any blocks that are colliding in XZ direction. Check bottom y. If so, player hit the ground.
-		physics->checkIfPlayerIsFalling(player, collidableBlocks);
-	}
+		movementInput.up = movementInput.up || input->getAxisValue(GAMEPAD::XBOX_360::AXIS::LT) > 0.0f;
+		movementInput.down = movementInput.down || input->getAxisValue(GAMEPAD::XBOX_360::AXIS::RT) > 0.0f;
 
-	auto end = Utility::Time::now();
-	//std::cout << "Player vs blocks collision resolution took: " << Utility::Time::toMicroSecondString(start, end) << std::endl;
+		// Todo: Controller manager doesn't have feature to check if button was pressed only current frame.
+		movementInput.jump = movementInput.jump || input->isControllerButtonDown(Voxel::GAMEPAD::XBOX_360::BUTTON::B);
+	}
 }
 
 void Voxel::GameScene::updateChunks()
 {
+	V_PROFILE_ZONE("GameScene::updateChunks");
+
 	// Update chunk.
 	// Based on player position, check if player moved to new chunk
 	// If so, we need to load new chunks. 
@@ -1447,7 +1426,7 @@ void Voxel::GameScene::updatePlayerRaycast()
 
 void Voxel::GameScene::updatePlayerCameraCollision()
 {
-	// auto start = Utility::Time::now();
+	V_PROFILE_ZONE("Camera collision");
 
 	// update camera ray
 	auto playerEyePos = player->getNextEyePosition();
@@ -1546,9 +1525,8 @@ void Voxel::GameScene::updatePlayerCameraCollision()
 
 	while (minCamDist >= 0)
 	{
-		std::vector<Block*> nearByBlock;
-		chunkMap->queryNearByBlocks(camPos, nearByBlock);
-		bool result = physics->checkSphereCollisionWithBlocks(Shape::Sphere(0.5f, camPos), nearByBlock);
+		// Camera is a block sized box. Queried from chunk storage, same as player collision.
+		bool result = physics->isAABBColliding(chunkMap, Shape::AABB(camPos, glm::vec3(1.0f)));
 
 		if (result == false)
 		{
@@ -1609,9 +1587,6 @@ void Voxel::GameScene::updatePlayerCameraCollision()
 	}
 
 	player->setResolvedCameraDistanceZ(minCamDist);
-
-	//auto end = Utility::Time::now();
-	//std::cout << "t: " << Utility::Time::toMicroSecondString(start, end) << "\n";
 }
 
 void Voxel::GameScene::openWorldMap()
@@ -1742,6 +1717,8 @@ void Voxel::GameScene::rebuildWorld()
 
 void GameScene::render()
 {
+	V_PROFILE_ZONE("GameScene::render");
+
 	if (loadingState == LoadingState::INITIALIZING || loadingState == LoadingState::RELOADING)
 	{
 		renderLoadingScreen();
@@ -1785,6 +1762,8 @@ void Voxel::GameScene::renderGame()
 
 void Voxel::GameScene::renderWorld()
 {
+	V_PROFILE_ZONE("GameScene::renderWorld");
+
 	// Render world.
 
 	// Get program manager
@@ -1837,25 +1816,28 @@ void Voxel::GameScene::renderWorld()
 #endif
 
 	// set view matrix.
-	program->setUniformMat4("viewMat", viewMat);
+	program->setUniformMat4(SID("viewMat"), viewMat);
 	
 	// Update light
 	float ambientValue = skybox->getAmbientColor(calendar->getHour(), calendar->getMinutes(), calendar->getSeconds());
-	program->setUniformVec4("ambientColor", glm::vec4(ambientValue, ambientValue, ambientValue, 1.0f));
-	program->setUniformVec3("pointLights[0].lightPosition", player->getEyePosition());
+	program->setUniformVec4(SID("ambientColor"), glm::vec4(ambientValue, ambientValue, ambientValue, 1.0f));
+	program->setUniformVec3(SID("pointLights[0].lightPosition"), player->getEyePosition());
 
 	// Check if fog is enabled. Todo: Make fog always on.
 	if (skybox->isFogEnabled())
 	{
 		// Enable fog
-		program->setUniformBool("fogEnabled", true);
+		program->setUniformBool(SID("fogEnabled"), true);
 		// Set current fog color
-		program->setUniformVec4("fogColor", glm::vec4(skybox->getMidBlendColor(), 1.0f));
+		program->setUniformVec4(SID("fogColor"), glm::vec4(skybox->getMidBlendColor(), 1.0f));
 	}
 
 	// Render chunk map. Uses block shader. Updates each chunk's model matrix based on distance between player and chunk's world position.
 	chunkMap->render(centerPos);
 
+	// Render world particles. Same as chunk map, rendered relative to center.
+	worldParticleSystem->render(viewMat, centerPos);
+
 	// Update skybox's matrix. 
 	skybox->updateMatrix(Camera::mainCamera->getProjection() * viewMat * worldMat * player->getSkyboxMat(true));
 	// Render skybox. 
@@ -1867,7 +1849,7 @@ void Voxel::GameScene::renderWorld()
 	lineProgram->use(true);	
 
 	// Use viewmat first
-	lineProgram->setUniformMat4("viewMat", viewMat);
+	lineProgram->setUniformMat4(SID("viewMat"), viewMat);
 	
 #if V_DEBUG
 	// Debug mode
@@ -1889,7 +1871,7 @@ void Voxel::GameScene::renderWorld()
 	if (cameraMode)
 	{
 		// Change view mat for other lines
-		lineProgram->setUniformMat4("viewMat", viewMat * worldMat * glm::inverse(player->getWorldMatrix()));
+		lineProgram->setUniformMat4(SID("viewMat"), viewMat * worldMat * glm::inverse(player->getWorldMatrix()));
 
 #if V_DEBUG_FRUSTUM_LINE
 		Camera::mainCamera->getFrustum()->render(player->getFrustumViewMatrix(), lineProgram);
@@ -1939,9 +1921,9 @@ void Voxel::GameScene::renderWorldMap()
 		auto lineProgram = ProgramManager::getInstance().getProgram(ProgramManager::PROGRAM_NAME::LINE_SHADER);
 		lineProgram->use(true);
 
-		lineProgram->setUniformMat4("viewMat", viewMat);
-		lineProgram->setUniformMat4("modelMat", glm::mat4(1.0f));
-		lineProgram->setUniformVec4("lineColor", glm::vec4(1.0f));
+		lineProgram->setUniformMat4(SID("viewMat"), viewMat);
+		lineProgram->setUniformMat4(SID("modelMat"), glm::mat4(1.0f));
+		lineProgram->setUniformVec4(SID("lineColor"), glm::vec4(1.0f));
 
 		worldMap->renderCenterLine();
 		worldMap->renderRay();
@@ -1991,12 +1973,12 @@ void Voxel::GameScene::setFogEnabled(const bool enabled)
 	// fog
 	if (skybox->isFogEnabled())
 	{
-		program->setUniformBool("fogEnabled", true);
-		program->setUniformFloat("fogDistance", skybox->getFogDistance());
+		program->setUniformBool(SID("fogEnabled"), true);
+		program->setUniformFloat(SID("fogDistance"), skybox->getFogDistance());
 	}
 	else
 	{
-		program->setUniformBool("fogEnabled", false);
+		program->setUniformBool(SID("fogEnabled"), false);
 	}
 	program->use(false);
 }
@@ -2014,8 +1996,10 @@ void Voxel::GameScene::initDebugConsole()
 	debugConsole->player = player;
 	debugConsole->game = this;
 	debugConsole->chunkMap = chunkMap;
+	debugConsole->chunkWorkManager = chunkWorkManager;
 	debugConsole->world = world;
 	debugConsole->calendar = calendar;
+	debugConsole->weatherSystem = weatherSystem;
 }
 
 void Voxel::GameScene::renderDebugConsole()
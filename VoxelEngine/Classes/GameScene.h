@@ -31,10 +31,16 @@ namespace Voxel
 	class Calendar;
 	class World;
 	class Physics;
+	class FixedTimeStep;
+	class Simulation;
+	struct MovementInput;
 	class Setting;
 	class WorldMap;
 	class GameMenu;
 	class Cursor;
+	class WorldParticleSystem;
+	class WeatherSystem;
+	class ThreadPool;
 
 	namespace UI
 	{
@@ -93,6 +99,9 @@ namespace Voxel
 		// World
 		World* world;
 
+		// Task that builds world on loader thread. Started in preload.
+		std::shared_ptr<AssetHandle> worldHandle;
+
 		// Chunks
 		ChunkMap* chunkMap;
 		ChunkMeshGenerator* chunkMeshGenerator;
@@ -101,6 +110,15 @@ namespace Voxel
 		// physics
 		Physics* physics;
 
+		// Fixed time step that runs simulation (movement, physics, calendar)
+		FixedTimeStep* simulationStep;
+
+		// Runs simulation tick
+		Simulation* simulation;
+
+		// True if jump key was pressed since last simulation tick
+		bool jumpRequested;
+
 		// Player
 		Player* player;
 
@@ -109,6 +127,15 @@ namespace Voxel
 
 		// Calendar
 		Calendar* calendar;
+
+		// Particles in world. Debris, rain, snow, leaves.
+		WorldParticleSystem* worldParticleSystem;
+
+		// Weather. Emits rain and snow to world particle system.
+		WeatherSystem* weatherSystem;
+
+		// Thread pool for tasks that run in parallel on main loop (world particles)
+		ThreadPool* threadPool;
 		
 		// Setting instance ptr
 		Setting* settingPtr;
@@ -154,6 +181,12 @@ namespace Voxel
 		// Create world
 		void createWorld();
 
+		/**
+		*	Set biome theme and build regions of world. Doesn't use OpenGL, so it can run on loader thread.
+		*	@return true if world has starting region.
+		*/
+		static bool buildWorld(World* world, const bool tiled, const std::string& seed);
+
 		// Initialize everything that uses random
 		void initRandoms();
 
@@ -203,11 +236,17 @@ namespace Voxel
 		void updateControllerInput(const float delta);
 
 		/**
-		*	Updates physics.
-		*	Applies gravity and resolve collisions
-		*	@param delta Elapsed time on current frame.
+		*	Runs single simulation tick. Movement, physics and calendar.
+		*	Reads input to MovementInput and passes it to Simulation, so tick itself doesn't depend on window or input devices.
+		*	@param delta Fixed tick delta.
+		*/
+		void updateSimulation(const float delta);
+
+		/**
+		*	Reads held movement keys and controller stick. Called on every simulation tick.
+		*	@param movementInput Movement on this tick.
 		*/
-		void updatePhysics(const float delta);
+		void updateMovementInput(MovementInput& movementInput);
 
 		// Updates chunk map
 		void updateChunks();
@@ -237,6 +276,7 @@ namespace Voxel
 		~GameScene();
 
 		// Initialize all sub system and instances
+		void preload(std::vector<std::shared_ptr<AssetHandle>>& handles) override;
 		void init() override;
 		void onEnter() override;
 		void onEnterFinished() override;
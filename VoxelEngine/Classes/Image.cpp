@@ -169,7 +169,7 @@ bool Voxel::UI::Image::updateMouseMove(const glm::vec2 & mousePosition, const gl
 				// Check if one of child has mouse move event
 				for (auto& child : children)
 				{
-					bool result = (child.second)->updateMouseMove(mousePosition, mouseDelta);
+					bool result = (child.second)->updateMouseMoveCulled(mousePosition, mouseDelta);
 					if (result)
 					{
 						childHovered = true;
@@ -479,6 +479,11 @@ void Voxel::UI::Image::build(const std::array<float, 12>& vertices, const std::a
 	glDeleteBuffers(1, &uvbo);
 	glDeleteBuffers(1, &ibo);
 
+	// Keep copy for batch
+	batchVertices.assign(vertices.begin(), vertices.end());
+	batchUVs.assign(uvs.begin(), uvs.end());
+	batchIndices.assign(indices.begin(), indices.end());
+
 #if V_DEBUG && V_DEBUG_DRAW_UI_BOUNDING_BOX && V_DEBUG_DRAW_IMAGE_BOUNDING_BOX
 	createDebugBoundingBoxLine();
 #endif
@@ -491,9 +496,9 @@ void Voxel::UI::Image::renderSelf()
 	if (program == nullptr) return;
 
 	program->use(true);
-	program->setUniformMat4("modelMat", glm::scale(modelMat, glm::vec3(scale, 1)));
-	program->setUniformFloat("opacity", opacity);
-	program->setUniformVec3("color", color);
+	program->setUniformMat4(SID("modelMat"), glm::scale(modelMat, glm::vec3(scale, 1)));
+	program->setUniformFloat(SID("opacity"), opacity);
+	program->setUniformVec3(SID("color"), color);
 
 	texture->activate(GL_TEXTURE0);
 	texture->bind();
@@ -523,9 +528,9 @@ void Voxel::UI::Image::renderSelf()
 			mat = getParentMatrix() * mat;
 		}
 
-		lineProgram->setUniformMat4("modelMat", mat);
-		lineProgram->setUniformMat4("viewMat", glm::mat4(1.0f));
-		lineProgram->setUniformVec4("lineColor", glm::vec4(1.0f));
+		lineProgram->setUniformMat4(SID("modelMat"), mat);
+		lineProgram->setUniformMat4(SID("viewMat"), glm::mat4(1.0f));
+		lineProgram->setUniformVec4(SID("lineColor"), glm::vec4(1.0f));
 
 		glBindVertexArray(bbVao);
 		glDrawArrays(GL_LINES, 0, 8);
@@ -243,7 +243,7 @@ bool Voxel::UI::InputField::updateMouseMove(const glm::vec2 & mousePosition, con
 			auto rit = children.rbegin();
 			for (; rit != children.rend();)
 			{
-				bool result = (rit->second)->updateMouseMove(mousePosition, mouseDelta);
+				bool result = (rit->second)->updateMouseMoveCulled(mousePosition, mouseDelta);
 				if (result)
 				{
 					// child hovered
@@ -263,7 +263,7 @@ bool Voxel::UI::InputField::updateMouseMove(const glm::vec2 & mousePosition, con
 
 				for (; rit != children.rend(); rit++)
 				{
-					(rit->second)->updateMouseMoveFalse();
+					(rit->second)->updateMouseMoveFalseCulled();
 				}
 
 				updateMouseMoveFalse();
@@ -628,6 +628,11 @@ void Voxel::UI::InputField::setOnEditStartCallback(const std::function<void(Voxe
 	onEditStart = func;
 }
 
+bool Voxel::UI::InputField::appendBatch(BatchRenderer & batchRenderer)
+{
+	return false;
+}
+
 void Voxel::UI::InputField::renderSelf()
 {
 	Voxel::UI::Text::renderSelf();
@@ -639,9 +644,9 @@ void Voxel::UI::InputField::renderSelf()
 		if (cursorProgram == nullptr) return;
 
 		cursorProgram->use(true);
-		cursorProgram->setUniformMat4("modelMat", glm::scale(cursorModelMat, glm::vec3(scale, 1)));
-		cursorProgram->setUniformFloat("opacity", opacity);
-		cursorProgram->setUniformVec3("color", color);
+		cursorProgram->setUniformMat4(SID("modelMat"), glm::scale(cursorModelMat, glm::vec3(scale, 1)));
+		cursorProgram->setUniformFloat(SID("opacity"), opacity);
+		cursorProgram->setUniformVec3(SID("color"), color);
 
 		cursorTexture->activate(GL_TEXTURE0);
 		cursorTexture->bind();
@@ -125,6 +125,9 @@ namespace Voxel
 			bool updateMousePress(const glm::vec2& mousePosition, const int button) override;
 			bool updateMouseRelease(const glm::vec2& mousePosition, const int button) override;
 
+			// Cursor uses different texture. Renders self instead of batching text.
+			bool appendBatch(BatchRenderer& batchRenderer) override;
+
 			// render text and cursor
 			void renderSelf() override;
 		};
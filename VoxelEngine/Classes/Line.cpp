@@ -92,10 +92,10 @@ void Voxel::UI::Line::renderSelf()
 			glBindVertexArray(vao);
 
 			program->use(true);
-			program->setUniformMat4("projMat", Camera::mainCamera->getProjection());
-			program->setUniformMat4("viewMat", glm::mat4(1.0f));
-			program->setUniformMat4("modelMat", modelMat);
-			program->setUniformVec4("lineColor", lineColor);
+			program->setUniformMat4(SID("projMat"), Camera::mainCamera->getProjection());
+			program->setUniformMat4(SID("viewMat"), glm::mat4(1.0f));
+			program->setUniformMat4(SID("modelMat"), modelMat);
+			program->setUniformVec4(SID("lineColor"), lineColor);
 			glDrawArrays(GL_LINES, 0, 2);
 		}
 	}
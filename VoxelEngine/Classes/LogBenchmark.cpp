@@ -0,0 +1,233 @@
+// pch
+#include "PreCompiled.h"
+
+#include "LogBenchmark.h"
+
+// cpp
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+// voxel
+#include "AsyncLogger.h"
+#include "Benchmark.h"
+#include "Utility.h"
+
+using namespace Voxel;
+
+Voxel::LogBenchmark::LogBenchmark(const unsigned int logsPerThread, const int threadCount, const unsigned int workNanoSeconds)
+	: logsPerThread(logsPerThread)
+	, threadCount(threadCount)
+	, workNanoSeconds(workNanoSeconds)
+{}
+
+LogBenchmark::Result Voxel::LogBenchmark::runThreads(const std::function<void(const int, const unsigned int)>& logCall, const unsigned int work)
+{
+	std::vector<std::vector<float>> samples(threadCount);
+
+	std::atomic<bool> go(false);
+	std::atomic<int> ready(0);
+
+	std::vector<std::thread> threads;
+
+	for (int t = 0; t < threadCount; t++)
+	{
+		threads.push_back(std::thread([&, t]()
+		{
+			auto& threadSamples = samples.at(t);
+			threadSamples.reserve(logsPerThread);
+
+			ready.fetch_add(1);
+
+			while (!go.load())
+			{
+				std::this_thread::yield();
+			}
+
+			for (unsigned int i = 0; i < logsPerThread; i++)
+			{
+				auto callStart = Utility::Time::now();
+				logCall(t, i);
+				auto callEnd = Utility::Time::now();
+
+				threadSamples.push_back(Benchmark::toNanoSeconds(callStart, callEnd));
+
+				// Chunk work
+				if (work > 0)
+				{
+					const auto workEnd = callEnd + std::chrono::nanoseconds(work);
+
+					while (Utility::Time::now() < workEnd)
+					{}
+				}
+			}
+		}));
+	}
+
+	while (ready.load() < threadCount)
+	{
+		std::this_thread::yield();
+	}
+
+	go.store(true);
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	Result result;
+	result.threadCount = threadCount;
+	result.workNanoSeconds = work;
+	result.callCount = static_cast<unsigned long long>(logsPerThread) * static_cast<unsigned long long>(threadCount);
+	result.writtenCount = 0;
+	result.droppedCount = 0;
+	result.drainMilliSeconds = 0;
+
+	std::vector<float> allSamples;
+	allSamples.reserve(static_cast<size_t>(result.callCount));
+
+	double totalNanoSeconds = 0;
+
+	for (auto& threadSamples : samples)
+	{
+		for (auto ns : threadSamples)
+		{
+			totalNanoSeconds += ns;
+		}
+
+		allSamples.insert(allSamples.end(), threadSamples.begin(), threadSamples.end());
+	}
+
+	result.nanoSecondsPerCall = static_cast<float>(totalNanoSeconds / static_cast<double>(result.callCount));
+
+	std::sort(allSamples.begin(), allSamples.end());
+
+	if (allSamples.empty())
+	{
+		result.p50NanoSeconds = 0;
+		result.p99NanoSeconds = 0;
+		result.maxNanoSeconds = 0;
+	}
+	else
+	{
+		const size_t last = allSamples.size() - 1;
+
+		result.p50NanoSeconds = allSamples.at(last / 2);
+		result.p99NanoSeconds = allSamples.at(last * 99 / 100);
+		result.maxNanoSeconds = allSamples.back();
+	}
+
+	return result;
+}
+
+LogBenchmark::Result Voxel::LogBenchmark::runStream(const unsigned int work)
+{
+	// Same as std::cout. Every thread formats into single stream while holding its lock.
+	std::mutex streamMutex;
+	std::ostringstream stream;
+	unsigned long long lineCount = 0;
+
+	auto result = runThreads([&](const int thread, const unsigned int i)
+	{
+		std::unique_lock<std::mutex> lock(streamMutex);
+
+		stream << "[ChunkWorkManager] Build mesh (" << thread << ", " << static_cast<int>(i) << ") took " << (i & 1023) << " us\n";
+		lineCount++;
+
+		// Don't grow forever
+		if ((lineCount & 4095) == 0)
+		{
+			stream.str(std::string());
+		}
+	}, work);
+
+	result.name = "stream";
+	result.writtenCount = lineCount;
+
+	return result;
+}
+
+LogBenchmark::Result Voxel::LogBenchmark::runAsync(const unsigned int work)
+{
+	auto& asyncLogger = AsyncLogger::getInstance();
+
+	// Keep output so formatting cost is paid on flusher like real sink
+	unsigned long long outputSize = 0;
+
+	asyncLogger.start([&outputSize](const LogLevel, const std::string& line)
+	{
+		outputSize += line.size();
+	});
+
+	auto result = runThreads([&asyncLogger](const int thread, const unsigned int i)
+	{
+		asyncLogger.log(LogLevel::INFO, "[ChunkWorkManager] Build mesh {} took {} us", glm::ivec2(thread, static_cast<int>(i)), i & 1023);
+	}, work);
+
+	auto start = Utility::Time::now();
+
+	asyncLogger.stop();
+
+	auto end = Utility::Time::now();
+
+	auto stats = asyncLogger.getStats();
+
+	result.name = "async";
+	result.writtenCount = stats.flushedCount;
+	result.droppedCount = stats.droppedCount;
+	result.drainMilliSeconds = Benchmark::toMilliSeconds(start, end);
+
+	return result;
+}
+
+void Voxel::LogBenchmark::printResult(const Result & result)
+{
+	Benchmark::ResultLine("LogBenchmark", result.name)
+		.add("threads", result.threadCount)
+		.add("work", result.workNanoSeconds, "ns")
+		.add("calls", result.callCount)
+		.add("mean", result.nanoSecondsPerCall, "ns")
+		.add("p50", result.p50NanoSeconds, "ns")
+		.add("p99", result.p99NanoSeconds, "ns")
+		.add("max", result.maxNanoSeconds, "ns")
+		.add("written", result.writtenCount)
+		.add("dropped", result.droppedCount)
+		.add("drain", result.drainMilliSeconds, "ms")
+		.print();
+}
+
+void Voxel::LogBenchmark::run()
+{
+	std::cout << "[LogBenchmark] Logs per thread: " << logsPerThread << ", threads: " << threadCount << "\n";
+
+	// Burst
+	printResult(runStream(0));
+	printResult(runAsync(0));
+
+	// Paced
+	if (workNanoSeconds > 0)
+	{
+		printResult(runStream(workNanoSeconds));
+		printResult(runAsync(workNanoSeconds));
+	}
+}
+
+int Voxel::LogBenchmark::runFromCommandLine(const int argc, const char * argv[])
+{
+	// argv[0] is exe, argv[1] is --log-bench
+	int logsPerThread = 100000;
+	int threadCount = 8;
+	int workNanoSeconds = 5000;
+
+	if (!Benchmark::parseArguments(argc, argv, { { &logsPerThread, 1 }, { &threadCount, 1 }, { &workNanoSeconds, 0 } }, "[logs per thread] [thread count] [work ns between logs]"))
+	{
+		return 1;
+	}
+
+	LogBenchmark benchmark(static_cast<unsigned int>(logsPerThread), threadCount, static_cast<unsigned int>(workNanoSeconds));
+	benchmark.run();
+
+	return 0;
+}
@@ -0,0 +1,81 @@
+#ifndef LOG_BENCHMARK_H
+#define LOG_BENCHMARK_H
+
+// cpp
+#include <string>
+#include <functional>
+
+namespace Voxel
+{
+	/**
+	*	@class LogBenchmark
+	*	@brief Measures cost of logging from concurrent chunk worker threads without window or OpenGL context.
+	*
+	*	Each thread logs chunk events. Compares writing to shared stream under lock, which is what std::cout does, with AsyncLogger.
+	*	Burst run logs as fast as possible. Paced run spins between logs like worker doing chunk work.
+	*	Every call is timed, so times include cost of reading clock.
+	*
+	*	Run with: VoxelEngine.exe --log-bench [logs per thread] [thread count] [work ns between logs]
+	*/
+	class LogBenchmark
+	{
+	public:
+		struct Result
+		{
+			std::string name;
+			int threadCount;
+			unsigned int workNanoSeconds;
+			unsigned long long callCount;
+			float nanoSecondsPerCall;
+			float p50NanoSeconds;
+			float p99NanoSeconds;
+			float maxNanoSeconds;
+			// Lines that reached output and lines that were dropped
+			unsigned long long writtenCount;
+			unsigned long long droppedCount;
+			// Time to flush remaining lines after all threads finished
+			float drainMilliSeconds;
+		};
+	private:
+		unsigned int logsPerThread;
+		int threadCount;
+		unsigned int workNanoSeconds;
+
+		/**
+		*	Run threads that call log.
+		*	@param logCall Called with thread index and call index.
+		*	@param work Nano seconds to spin between calls.
+		*/
+		Result runThreads(const std::function<void(const int, const unsigned int)>& logCall, const unsigned int work);
+
+		// Shared stream with lock
+		Result runStream(const unsigned int work);
+
+		// AsyncLogger
+		Result runAsync(const unsigned int work);
+
+		void printResult(const Result& result);
+	public:
+		/**
+		*	Constructor
+		*	@param logsPerThread Number of logs each thread writes.
+		*	@param threadCount Number of logging threads.
+		*	@param workNanoSeconds Time to spin between logs in paced run.
+		*/
+		LogBenchmark(const unsigned int logsPerThread, const int threadCount, const unsigned int workNanoSeconds);
+
+		// Destructor
+		~LogBenchmark() = default;
+
+		// Run burst and paced
+		void run();
+
+		/**
+		*	Parses arguments after --log-bench and runs benchmark.
+		*	@return Exit code for process.
+		*/
+		static int runFromCommandLine(const int argc, const char* argv[]);
+	};
+}
+
+#endif
@@ -6,6 +6,7 @@
 // voxel
 #include "Application.h"
 #include "SpriteSheet.h"
+#include "AssetLoader.h"
 #include "Cursor.h"
 #include "InputHandler.h"
 #include "UIActions.h"
@@ -23,6 +24,11 @@ Voxel::MenuScene::MenuScene()
 Voxel::MenuScene::~MenuScene()
 {}
 
+void Voxel::MenuScene::preload(std::vector<std::shared_ptr<AssetHandle>>& handles)
+{
+	handles.push_back(AssetLoader::getInstance().loadSpriteSheetAsync("MenuSceneUISpriteSheet.json"));
+}
+
 void Voxel::MenuScene::init()
 {
 	// Initialize menu scene
@@ -116,7 +122,7 @@ void Voxel::MenuScene::release()
 
 	auto& sm = SpriteSheetManager::getInstance();
 
-	sm.removeSpriteSheetByKey("MenuSceneUISpriteSheet");
+	sm.removeSpriteSheetByKey(SID("MenuSceneUISpriteSheet"));
 
 	std::cout << "MenuScene released spritesheet\n";
 	sm.print(false);
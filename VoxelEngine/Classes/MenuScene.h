@@ -103,6 +103,7 @@ namespace Voxel
 		~MenuScene();
 
 		// overrides
+		void preload(std::vector<std::shared_ptr<AssetHandle>>& handles) override;
 		void init() override;
 		void onEnter() override;
 		void onEnterFinished() override;
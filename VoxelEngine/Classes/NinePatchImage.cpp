@@ -230,6 +230,11 @@ void Voxel::UI::NinePatchImage::build(const std::array<float, 48>& vertices, con
 	glDeleteBuffers(1, &uvbo);
 	glDeleteBuffers(1, &ibo);
 
+	// Keep copy for batch
+	batchVertices.assign(vertices.begin(), vertices.end());
+	batchUVs.assign(uvs.begin(), uvs.end());
+	batchIndices.assign(indices.begin(), indices.end());
+
 #if V_DEBUG && V_DEBUG_DRAW_UI_BOUNDING_BOX && V_DEBUG_DRAW_NINE_PATH_IMAGE_BOUNDING_BOX
 	createDebugBoundingBoxLine();
 #endif
@@ -257,9 +262,9 @@ void Voxel::UI::NinePatchImage::renderSelf()
 	if (program == nullptr) return;
 
 	program->use(true);
-	program->setUniformMat4("modelMat", glm::scale(modelMat, glm::vec3(scale, 1)));
-	program->setUniformFloat("opacity", opacity);
-	program->setUniformVec3("color", color);
+	program->setUniformMat4(SID("modelMat"), glm::scale(modelMat, glm::vec3(scale, 1)));
+	program->setUniformFloat(SID("opacity"), opacity);
+	program->setUniformVec3(SID("color"), color);
 
 	texture->activate(GL_TEXTURE0);
 	texture->bind();
@@ -276,9 +281,9 @@ void Voxel::UI::NinePatchImage::renderSelf()
 	{
 		auto lineProgram = ProgramManager::getInstance().getProgram(Voxel::ProgramManager::PROGRAM_NAME::LINE_SHADER);
 		lineProgram->use(true);
-		lineProgram->setUniformMat4("modelMat", modelMat);
-		lineProgram->setUniformMat4("viewMat", glm::mat4(1.0f));
-		lineProgram->setUniformVec4("lineColor", glm::vec4(1.0f));
+		lineProgram->setUniformMat4(SID("modelMat"), modelMat);
+		lineProgram->setUniformMat4(SID("viewMat"), glm::mat4(1.0f));
+		lineProgram->setUniformVec4(SID("lineColor"), glm::vec4(1.0f));
 
 		glBindVertexArray(bbVao);
 		glDrawArrays(GL_LINES, 0, 8);
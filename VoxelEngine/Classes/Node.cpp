@@ -3,6 +3,9 @@
 
 #include "Node.h"
 
+// voxel
+#include "BatchRenderer.h"
+
 Voxel::UI::Node::Node(const std::string & name)
 	: TransformNode(name)
 {}
@@ -29,3 +32,14 @@ void Voxel::UI::Node::render()
 		}
 	}
 }
+
+void Voxel::UI::Node::buildBatch(BatchRenderer & batchRenderer)
+{
+	if (visibility)
+	{
+		for (auto& child : children)
+		{
+			(child.second)->buildBatch(batchRenderer);
+		}
+	}
+}
@@ -29,6 +29,9 @@ namespace Voxel
 
 			// render override
 			void render() override;
+
+			// Add children to batch
+			void buildBatch(BatchRenderer& batchRenderer) override;
 		};
 	}
 }
@@ -0,0 +1,259 @@
+// pch
+#include "PreCompiled.h"
+
+#include "ParticlePool.h"
+
+// cpp
+#include <xmmintrin.h>
+
+const unsigned int Voxel::UI::ParticlePool::LANE_SIZE = 4;
+
+Voxel::UI::ParticlePool::ParticlePool()
+	: capacity(0)
+	, size(0)
+{}
+
+void Voxel::UI::ParticlePool::setCapacity(const unsigned int capacity)
+{
+	this->capacity = capacity;
+
+	if (size > capacity)
+	{
+		size = capacity;
+	}
+
+	const unsigned int padded = getPaddedCapacity();
+
+	for (unsigned int i = 0; i < ATTRIBUTE_COUNT; i++)
+	{
+		// Padding lanes have life span of 1 so kernel doesn't divide by 0
+		attributes.at(i).resize(padded, (i == LIFE_SPAN) ? 1.0f : 0.0f);
+	}
+}
+
+unsigned int Voxel::UI::ParticlePool::getPaddedCapacity() const
+{
+	return ((capacity + LANE_SIZE - 1) / LANE_SIZE) * LANE_SIZE;
+}
+
+float * Voxel::UI::ParticlePool::get(const Attribute attribute)
+{
+	return attributes[attribute].data();
+}
+
+unsigned int Voxel::UI::ParticlePool::add()
+{
+	assert(size < capacity);
+
+	return size++;
+}
+
+void Voxel::UI::ParticlePool::remove(const unsigned int index)
+{
+	assert(index < size);
+
+	const unsigned int last = size - 1;
+
+	if (index != last)
+	{
+		for (auto& attribute : attributes)
+		{
+			attribute[index] = attribute[last];
+		}
+	}
+
+	size--;
+}
+
+void Voxel::UI::ParticlePool::removeDead()
+{
+	const float* lifeSpan = get(LIFE_SPAN);
+	const float* livedTime = get(LIVED_TIME);
+
+	unsigned int i = 0;
+
+	while (i < size)
+	{
+		if (livedTime[i] >= lifeSpan[i])
+		{
+			// Last particle moves to i. Check i again.
+			remove(i);
+		}
+		else
+		{
+			i++;
+		}
+	}
+}
+
+void Voxel::UI::ParticlePool::clear()
+{
+	size = 0;
+}
+
+void Voxel::UI::ParticlePool::update(const UpdateParams & params, float * posOut, float * scaleRotOut, float * colorOut)
+{
+	if (size == 0) return;
+
+	float* posX = get(POS_X);
+	float* posY = get(POS_Y);
+	float* emitPosX = get(EMIT_POS_X);
+	float* emitPosY = get(EMIT_POS_Y);
+	float* dirX = get(DIR_X);
+	float* dirY = get(DIR_Y);
+	const float* accelRad = get(ACCEL_RAD);
+	const float* accelTan = get(ACCEL_TAN);
+	const float* lifeSpan = get(LIFE_SPAN);
+	float* livedTime = get(LIVED_TIME);
+	const float* startSize = get(START_SIZE);
+	const float* endSize = get(END_SIZE);
+	const float* startAngle = get(START_ANGLE);
+	const float* endAngle = get(END_ANGLE);
+	const float* startR = get(START_COLOR_R);
+	const float* startG = get(START_COLOR_G);
+	const float* startB = get(START_COLOR_B);
+	const float* startA = get(START_COLOR_A);
+	const float* endR = get(END_COLOR_R);
+	const float* endG = get(END_COLOR_G);
+	const float* endB = get(END_COLOR_B);
+	const float* endA = get(END_COLOR_A);
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 delta = _mm_set1_ps(params.delta);
+	const __m128 gravityX = _mm_set1_ps(params.gravity.x);
+	const __m128 gravityY = _mm_set1_ps(params.gravity.y);
+	const __m128 groupEmitX = _mm_set1_ps(params.emitPos.x);
+	const __m128 groupEmitY = _mm_set1_ps(params.emitPos.y);
+	const __m128 inverseTextureSize = _mm_set1_ps(params.inverseTextureSize);
+	const __m128 toRadians = _mm_set1_ps(glm::pi<float>() / 180.0f);
+
+	// Scale and angle of 4 lanes. Rotation is done in scalar because SSE doesn't have sin and cos.
+	alignas(16) float scales[4];
+	alignas(16) float angles[4];
+
+	// Include padding lanes. Their output is never drawn.
+	const unsigned int end = ((size + LANE_SIZE - 1) / LANE_SIZE) * LANE_SIZE;
+
+	for (unsigned int i = 0; i < end; i += LANE_SIZE)
+	{
+		// Life time. Clamp to life span. Particle that reached life span is still drawn this frame and removed on next update.
+		const __m128 life = _mm_loadu_ps(lifeSpan + i);
+		const __m128 lived = _mm_min_ps(_mm_add_ps(_mm_loadu_ps(livedTime + i), delta), life);
+		_mm_storeu_ps(livedTime + i, lived);
+
+		const __m128 ratio = _mm_div_ps(lived, life);
+
+		// Normalized position for radial direction. 0 if particle is on emit position.
+		__m128 x = _mm_loadu_ps(posX + i);
+		__m128 y = _mm_loadu_ps(posY + i);
+
+		const __m128 lengthSq = _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y));
+		const __m128 nonZero = _mm_cmpgt_ps(lengthSq, zero);
+		const __m128 inverseLength = _mm_and_ps(nonZero, _mm_div_ps(one, _mm_sqrt_ps(_mm_max_ps(lengthSq, _mm_set1_ps(std::numeric_limits<float>::min())))));
+
+		const __m128 radialX = _mm_mul_ps(x, inverseLength);
+		const __m128 radialY = _mm_mul_ps(y, inverseLength);
+
+		// radial * accelRad + (-radial.y, radial.x) * accelTan + gravity
+		const __m128 rad = _mm_loadu_ps(accelRad + i);
+		const __m128 tan = _mm_loadu_ps(accelTan + i);
+
+		const __m128 accelX = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(radialX, rad), _mm_mul_ps(radialY, tan)), gravityX);
+		const __m128 accelY = _mm_add_ps(_mm_add_ps(_mm_mul_ps(radialY, rad), _mm_mul_ps(radialX, tan)), gravityY);
+
+		// Direction
+		const __m128 dx = _mm_add_ps(_mm_loadu_ps(dirX + i), _mm_mul_ps(accelX, delta));
+		const __m128 dy = _mm_add_ps(_mm_loadu_ps(dirY + i), _mm_mul_ps(accelY, delta));
+		_mm_storeu_ps(dirX + i, dx);
+		_mm_storeu_ps(dirY + i, dy);
+
+		// Position
+		x = _mm_add_ps(x, _mm_mul_ps(dx, delta));
+		y = _mm_add_ps(y, _mm_mul_ps(dy, delta));
+		_mm_storeu_ps(posX + i, x);
+		_mm_storeu_ps(posY + i, y);
+
+		__m128 emitX;
+		__m128 emitY;
+
+		if (params.grouped)
+		{
+			// Grouped position type particles move together when emitter.
+			emitX = groupEmitX;
+			emitY = groupEmitY;
+			_mm_storeu_ps(emitPosX + i, emitX);
+			_mm_storeu_ps(emitPosY + i, emitY);
+		}
+		else
+		{
+			emitX = _mm_loadu_ps(emitPosX + i);
+			emitY = _mm_loadu_ps(emitPosY + i);
+		}
+
+		// Position buffer (x0, y0, x1, y1, ...)
+		const __m128 worldX = _mm_add_ps(emitX, x);
+		const __m128 worldY = _mm_add_ps(emitY, y);
+		_mm_storeu_ps(posOut + (i * 2), _mm_unpacklo_ps(worldX, worldY));
+		_mm_storeu_ps(posOut + (i * 2) + 4, _mm_unpackhi_ps(worldX, worldY));
+
+		// Size to scale. lerp(a, b, t) = a + (b - a) * t
+		const __m128 startSizes = _mm_loadu_ps(startSize + i);
+		const __m128 curSize = _mm_add_ps(startSizes, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(endSize + i), startSizes), ratio));
+		_mm_store_ps(scales, _mm_mul_ps(curSize, inverseTextureSize));
+
+		// Angle in radian
+		const __m128 startAngles = _mm_loadu_ps(startAngle + i);
+		const __m128 curAngle = _mm_add_ps(startAngles, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(endAngle + i), startAngles), ratio));
+		_mm_store_ps(angles, _mm_mul_ps(curAngle, toRadians));
+
+		// Color
+		__m128 r = _mm_loadu_ps(startR + i);
+		__m128 g = _mm_loadu_ps(startG + i);
+		__m128 b = _mm_loadu_ps(startB + i);
+		__m128 a = _mm_loadu_ps(startA + i);
+
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(endR + i), r), ratio));
+		g = _mm_add_ps(g, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(endG + i), g), ratio));
+		b = _mm_add_ps(b, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(endB + i), b), ratio));
+		a = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(endA + i), a), ratio));
+
+		// rrrr, gggg, bbbb, aaaa to rgba * 4
+		_MM_TRANSPOSE4_PS(r, g, b, a);
+
+		_mm_storeu_ps(colorOut + (i * 4), r);
+		_mm_storeu_ps(colorOut + (i * 4) + 4, g);
+		_mm_storeu_ps(colorOut + (i * 4) + 8, b);
+		_mm_storeu_ps(colorOut + (i * 4) + 12, a);
+
+		// Scale * rotation matrix. Only first two row and column.
+		for (unsigned int lane = 0; lane < LANE_SIZE; lane++)
+		{
+			const float cos = glm::cos(angles[lane]);
+			const float sin = glm::sin(angles[lane]);
+			const float s = scales[lane];
+
+			float* scaleRot = scaleRotOut + ((i + lane) * 4);
+
+			scaleRot[0] = s * cos;
+			scaleRot[1] = s * sin;
+			scaleRot[2] = -s * sin;
+			scaleRot[3] = s * cos;
+		}
+	}
+}
+
+unsigned int Voxel::UI::ParticlePool::getSize() const
+{
+	return size;
+}
+
+unsigned int Voxel::UI::ParticlePool::getCapacity() const
+{
+	return capacity;
+}
+
+bool Voxel::UI::ParticlePool::isFull() const
+{
+	return size >= capacity;
+}
@@ -0,0 +1,133 @@
+#ifndef PARTICLE_POOL_H
+#define PARTICLE_POOL_H
+
+// cpp
+#include <array>
+#include <vector>
+
+// glm
+#include <glm\glm.hpp>
+
+namespace Voxel
+{
+	// foward declaration
+	class ParticlePoolBenchmark;
+
+	namespace UI
+	{
+		/**
+		*	@class ParticlePool
+		*	@brief Stores particles as structure of arrays.
+		*
+		*	Each attribute has own contiguous array and living particles are packed in [0, size).
+		*	Particle that dies is replaced by last living particle (swap remove), so order of particles isn't preserved.
+		*	Arrays are padded to multiple of 4 so update kernel can process 4 particles at once with SSE without scalar tail.
+		*	Only ParticleSystem (and ParticlePoolBenchmark) can access.
+		*/
+		class ParticlePool
+		{
+			// Only particle system can access to particle pool
+			friend class ParticleSystem;
+			// Runs pool without window
+			friend class Voxel::ParticlePoolBenchmark;
+		public:
+			enum Attribute : unsigned int
+			{
+				POS_X = 0,			// Position relative to emit position
+				POS_Y,
+				EMIT_POS_X,			// Emit position. Set when particle get spawned
+				EMIT_POS_Y,
+				DIR_X,				// Direction * speed
+				DIR_Y,
+				ACCEL_RAD,			// Radial acceleration
+				ACCEL_TAN,			// Tangential acceleration
+				LIFE_SPAN,
+				LIVED_TIME,
+				START_SIZE,
+				END_SIZE,
+				START_ANGLE,
+				END_ANGLE,
+				START_COLOR_R,
+				START_COLOR_G,
+				START_COLOR_B,
+				START_COLOR_A,
+				END_COLOR_R,
+				END_COLOR_G,
+				END_COLOR_B,
+				END_COLOR_A,
+				ATTRIBUTE_COUNT
+			};
+
+			// Values that are same for all particles in single update
+			struct UpdateParams
+			{
+				float delta;
+				glm::vec2 gravity;
+				// True if particles move together with emitter
+				bool grouped;
+				glm::vec2 emitPos;
+				// 1 / texture size. Converts particle size to scale.
+				float inverseTextureSize;
+			};
+
+			// Number of particles that update kernel process at once
+			static const unsigned int LANE_SIZE;
+		private:
+			// Constructor
+			ParticlePool();
+
+			// Attribute arrays. All array has same size.
+			std::array<std::vector<float>, ATTRIBUTE_COUNT> attributes;
+
+			// Max number of particles
+			unsigned int capacity;
+
+			// Number of living particles
+			unsigned int size;
+
+			// Set max number of particles. Living particles out of new capacity are removed.
+			void setCapacity(const unsigned int capacity);
+
+			// Get padded size of arrays. Instance buffers need to be this size.
+			unsigned int getPaddedCapacity() const;
+
+			// Get pointer to attribute array
+			float* get(const Attribute attribute);
+
+			// Add particle at the end. Returns index of new particle. Caller must set all attributes.
+			unsigned int add();
+
+			// Removes particle by moving last particle to index.
+			void remove(const unsigned int index);
+
+			// Removes all particles that lived full life span on last update.
+			void removeDead();
+
+			// Removes all particles
+			void clear();
+
+			/**
+			*	Updates all living particles and writes instance data.
+			*	@param params Values for all particles.
+			*	@param posOut Position buffer. vec2 per particle. Must have padded capacity.
+			*	@param scaleRotOut Scale and rotation buffer. vec4 (2x2 matrix) per particle. Must have padded capacity.
+			*	@param colorOut Color buffer. vec4 per particle. Must have padded capacity.
+			*/
+			void update(const UpdateParams& params, float* posOut, float* scaleRotOut, float* colorOut);
+		public:
+			// Destructor
+			~ParticlePool() = default;
+
+			// Get number of living particles
+			unsigned int getSize() const;
+
+			// Get max number of particles
+			unsigned int getCapacity() const;
+
+			// Check if pool can't add more particle
+			bool isFull() const;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,319 @@
+// pch
+#include "PreCompiled.h"
+
+#include "ParticlePoolBenchmark.h"
+
+// voxel
+#include "ParticlePool.h"
+#include "Random.h"
+#include "Benchmark.h"
+#include "Utility.h"
+
+using namespace Voxel;
+using Voxel::UI::ParticlePool;
+
+namespace
+{
+	const float Delta = 1.0f / 60.0f;
+	const float InverseTextureSize = 1.0f / 32.0f;
+	const glm::vec2 Gravity = glm::vec2(0.0f, -98.0f);
+
+	// Short life span so pool churns. Mean life span is 24 frames at 60 fps.
+	const float MinLifeSpan = 0.1f;
+	const float MaxLifeSpan = 0.7f;
+
+	// Output is compared on this many frames at start of run. Rest of run only compares time.
+	const int CompareFrames = 16;
+
+	// Kernel and scalar reference must agree within this, relative to value
+	const float Epsilon = 1e-4f;
+
+	// Compare single output value. Returns false with error if values don't match.
+	bool compare(const char* name, const unsigned int index, const float value, const float expected, std::string& error)
+	{
+		if (glm::abs(value - expected) <= Epsilon * glm::max(1.0f, glm::abs(expected)))
+		{
+			return true;
+		}
+
+		error = std::string(name) + " of particle #" + std::to_string(index) + " is " + std::to_string(value) + " instead of " + std::to_string(expected);
+		return false;
+	}
+}
+
+Voxel::ParticlePoolBenchmark::ParticlePoolBenchmark(const int frames)
+	: frames(frames)
+{}
+
+void Voxel::ParticlePoolBenchmark::spawn(UI::ParticlePool & pool, Random & rand)
+{
+	const unsigned int index = pool.add();
+
+	// Same ranges as particle system with wide variance
+	const float angle = glm::radians(rand.randRangeFloat(0.0f, 360.0f));
+	const float speed = rand.randRangeFloat(20.0f, 200.0f);
+
+	pool.get(ParticlePool::POS_X)[index] = 0.0f;
+	pool.get(ParticlePool::POS_Y)[index] = 0.0f;
+	pool.get(ParticlePool::EMIT_POS_X)[index] = rand.randRangeFloat(-100.0f, 100.0f);
+	pool.get(ParticlePool::EMIT_POS_Y)[index] = rand.randRangeFloat(-100.0f, 100.0f);
+	pool.get(ParticlePool::DIR_X)[index] = glm::cos(angle) * speed;
+	pool.get(ParticlePool::DIR_Y)[index] = glm::sin(angle) * speed;
+	pool.get(ParticlePool::ACCEL_RAD)[index] = rand.randRangeFloat(-50.0f, 50.0f);
+	pool.get(ParticlePool::ACCEL_TAN)[index] = rand.randRangeFloat(-50.0f, 50.0f);
+	pool.get(ParticlePool::LIFE_SPAN)[index] = rand.randRangeFloat(MinLifeSpan, MaxLifeSpan);
+	pool.get(ParticlePool::LIVED_TIME)[index] = 0.0f;
+	pool.get(ParticlePool::START_SIZE)[index] = rand.randRangeFloat(8.0f, 32.0f);
+	pool.get(ParticlePool::END_SIZE)[index] = rand.randRangeFloat(0.0f, 16.0f);
+	pool.get(ParticlePool::START_ANGLE)[index] = rand.randRangeFloat(0.0f, 360.0f);
+	pool.get(ParticlePool::END_ANGLE)[index] = rand.randRangeFloat(-360.0f, 360.0f);
+
+	for (unsigned int i = 0; i < 4; i++)
+	{
+		pool.get(static_cast<ParticlePool::Attribute>(ParticlePool::START_COLOR_R + i))[index] = rand.randRangeFloat(0.0f, 1.0f);
+		pool.get(static_cast<ParticlePool::Attribute>(ParticlePool::END_COLOR_R + i))[index] = rand.randRangeFloat(0.0f, 1.0f);
+	}
+}
+
+void Voxel::ParticlePoolBenchmark::updateScalar(std::vector<std::vector<float>>& attributes, const unsigned int end, const float delta, float * posOut, float * scaleRotOut, float * colorOut)
+{
+	auto& posX = attributes.at(ParticlePool::POS_X);
+	auto& posY = attributes.at(ParticlePool::POS_Y);
+	auto& dirX = attributes.at(ParticlePool::DIR_X);
+	auto& dirY = attributes.at(ParticlePool::DIR_Y);
+	auto& livedTime = attributes.at(ParticlePool::LIVED_TIME);
+
+	const auto& emitPosX = attributes.at(ParticlePool::EMIT_POS_X);
+	const auto& emitPosY = attributes.at(ParticlePool::EMIT_POS_Y);
+	const auto& accelRad = attributes.at(ParticlePool::ACCEL_RAD);
+	const auto& accelTan = attributes.at(ParticlePool::ACCEL_TAN);
+	const auto& lifeSpan = attributes.at(ParticlePool::LIFE_SPAN);
+	const auto& startSize = attributes.at(ParticlePool::START_SIZE);
+	const auto& endSize = attributes.at(ParticlePool::END_SIZE);
+	const auto& startAngle = attributes.at(ParticlePool::START_ANGLE);
+	const auto& endAngle = attributes.at(ParticlePool::END_ANGLE);
+
+	for (unsigned int i = 0; i < end; i++)
+	{
+		livedTime[i] = glm::min(livedTime[i] + delta, lifeSpan[i]);
+
+		const float ratio = livedTime[i] / lifeSpan[i];
+
+		glm::vec2 pos = glm::vec2(posX[i], posY[i]);
+		glm::vec2 radial = glm::vec2(0.0f);
+
+		const float lengthSq = glm::dot(pos, pos);
+
+		if (lengthSq > 0.0f)
+		{
+			radial = pos / glm::sqrt(lengthSq);
+		}
+
+		const glm::vec2 tangential = glm::vec2(-radial.y, radial.x);
+		const glm::vec2 accel = radial * accelRad[i] + tangential * accelTan[i] + Gravity;
+
+		dirX[i] += accel.x * delta;
+		dirY[i] += accel.y * delta;
+
+		posX[i] += dirX[i] * delta;
+		posY[i] += dirY[i] * delta;
+
+		posOut[i * 2] = emitPosX[i] + posX[i];
+		posOut[i * 2 + 1] = emitPosY[i] + posY[i];
+
+		const float scale = (startSize[i] + (endSize[i] - startSize[i]) * ratio) * InverseTextureSize;
+		const float angle = glm::radians(startAngle[i] + (endAngle[i] - startAngle[i]) * ratio);
+
+		const float cos = glm::cos(angle);
+		const float sin = glm::sin(angle);
+
+		scaleRotOut[i * 4] = scale * cos;
+		scaleRotOut[i * 4 + 1] = scale * sin;
+		scaleRotOut[i * 4 + 2] = -scale * sin;
+		scaleRotOut[i * 4 + 3] = scale * cos;
+
+		for (unsigned int c = 0; c < 4; c++)
+		{
+			const float start = attributes.at(ParticlePool::START_COLOR_R + c)[i];
+			const float finish = attributes.at(ParticlePool::END_COLOR_R + c)[i];
+
+			colorOut[i * 4 + c] = start + (finish - start) * ratio;
+		}
+	}
+}
+
+ParticlePoolBenchmark::Result Voxel::ParticlePoolBenchmark::runOnce(const unsigned int capacity)
+{
+	Result result;
+	result.capacity = capacity;
+	result.kernelMicroSeconds = 0.0f;
+	result.scalarMicroSeconds = 0.0f;
+	result.spawnedPerFrame = 0.0f;
+
+	// Same particles on every run
+	Random rand("PARTICLE");
+
+	ParticlePool pool;
+	pool.setCapacity(capacity);
+
+	const unsigned int padded = pool.getPaddedCapacity();
+
+	std::vector<float> pos(padded * 2, 0.0f);
+	std::vector<float> scaleRot(padded * 4, 0.0f);
+	std::vector<float> color(padded * 4, 0.0f);
+
+	std::vector<float> expectedPos(padded * 2, 0.0f);
+	std::vector<float> expectedScaleRot(padded * 4, 0.0f);
+	std::vector<float> expectedColor(padded * 4, 0.0f);
+
+	ParticlePool::UpdateParams params;
+	params.delta = Delta;
+	params.gravity = Gravity;
+	params.grouped = false;
+	params.emitPos = glm::vec2(0.0f);
+	params.inverseTextureSize = InverseTextureSize;
+
+	while (!pool.isFull())
+	{
+		spawn(pool, rand);
+	}
+
+	std::vector<std::vector<float>> copy(ParticlePool::ATTRIBUTE_COUNT);
+
+	unsigned long long spawned = 0;
+
+	for (int frame = 0; frame < frames; frame++)
+	{
+		// Same order as ParticleSystem::update. Dead particles make room for new particles first.
+		pool.removeDead();
+
+		const float* lifeSpan = pool.get(ParticlePool::LIFE_SPAN);
+		const float* livedTime = pool.get(ParticlePool::LIVED_TIME);
+
+		for (unsigned int i = 0; i < pool.getSize() && result.error.empty(); i++)
+		{
+			if (livedTime[i] >= lifeSpan[i])
+			{
+				result.error = "dead particle #" + std::to_string(i) + " is still in pool on frame " + std::to_string(frame);
+			}
+		}
+
+		// Emitter with emission rate of capacity / life span replaces every dead particle
+		const unsigned int dead = capacity - pool.getSize();
+
+		for (unsigned int i = 0; i < dead; i++)
+		{
+			spawn(pool, rand);
+		}
+
+		spawned += dead;
+
+		if (!pool.isFull() && result.error.empty())
+		{
+			result.error = "pool has " + std::to_string(pool.getSize()) + " of " + std::to_string(capacity) + " particles after spawn on frame " + std::to_string(frame);
+		}
+
+		// Reference runs on copy of same particles. Kernel also updates padding lanes, so copy whole arrays.
+		const unsigned int laneEnd = ((pool.getSize() + ParticlePool::LANE_SIZE - 1) / ParticlePool::LANE_SIZE) * ParticlePool::LANE_SIZE;
+
+		for (unsigned int a = 0; a < ParticlePool::ATTRIBUTE_COUNT; a++)
+		{
+			copy.at(a) = pool.attributes.at(a);
+		}
+
+		auto start = Utility::Time::now();
+
+		pool.update(params, pos.data(), scaleRot.data(), color.data());
+
+		auto kernelEnd = Utility::Time::now();
+
+		updateScalar(copy, laneEnd, Delta, expectedPos.data(), expectedScaleRot.data(), expectedColor.data());
+
+		auto scalarEnd = Utility::Time::now();
+
+		result.kernelMicroSeconds += Benchmark::toMicroSeconds(start, kernelEnd);
+		result.scalarMicroSeconds += Benchmark::toMicroSeconds(kernelEnd, scalarEnd);
+
+		if (frame >= CompareFrames || !result.error.empty())
+		{
+			continue;
+		}
+
+		for (unsigned int i = 0; i < pool.getSize(); i++)
+		{
+			if (!compare("position x", i, pos[i * 2], expectedPos[i * 2], result.error)
+				|| !compare("position y", i, pos[i * 2 + 1], expectedPos[i * 2 + 1], result.error)
+				|| !compare("lived time", i, pool.get(ParticlePool::LIVED_TIME)[i], copy.at(ParticlePool::LIVED_TIME)[i], result.error))
+			{
+				break;
+			}
+
+			bool matched = true;
+
+			for (unsigned int c = 0; c < 4 && matched; c++)
+			{
+				matched = compare("scale rotation", i, scaleRot[i * 4 + c], expectedScaleRot[i * 4 + c], result.error)
+					&& compare("color", i, color[i * 4 + c], expectedColor[i * 4 + c], result.error);
+			}
+
+			if (!matched)
+			{
+				break;
+			}
+		}
+	}
+
+	if (frames > 0)
+	{
+		result.kernelMicroSeconds /= static_cast<float>(frames);
+		result.scalarMicroSeconds /= static_cast<float>(frames);
+		result.spawnedPerFrame = static_cast<float>(spawned) / static_cast<float>(frames);
+	}
+
+	return result;
+}
+
+void Voxel::ParticlePoolBenchmark::printResult(const Result & result)
+{
+	Benchmark::ResultLine("ParticlePoolBenchmark")
+		.add("particles", result.capacity)
+		.add("spawned per frame", result.spawnedPerFrame)
+		.add("kernel", result.kernelMicroSeconds, "us")
+		.add("scalar", result.scalarMicroSeconds, "us")
+		.add("speedup", result.kernelMicroSeconds > 0.0f ? result.scalarMicroSeconds / result.kernelMicroSeconds : 0.0f, "x")
+		.addChecks(result.error)
+		.print();
+}
+
+bool Voxel::ParticlePoolBenchmark::run(const std::vector<int>& capacities)
+{
+	std::cout << "[ParticlePoolBenchmark] Frames: " << frames << "\n";
+
+	bool passed = true;
+
+	for (auto capacity : capacities)
+	{
+		auto result = runOnce(static_cast<unsigned int>(capacity));
+		printResult(result);
+
+		passed = passed && result.error.empty();
+	}
+
+	return passed;
+}
+
+int Voxel::ParticlePoolBenchmark::runFromCommandLine(const int argc, const char * argv[])
+{
+	// argv[0] is exe, argv[1] is --ui-particle-bench
+	int maxParticles = 65536;
+	int frames = 600;
+
+	if (!Benchmark::parseArguments(argc, argv, { { &maxParticles, 1 }, { &frames, 1 } }, "[max particles] [frames]"))
+	{
+		return 1;
+	}
+
+	ParticlePoolBenchmark benchmark(frames);
+
+	return benchmark.run(Benchmark::doublingSteps(1024, maxParticles)) ? 0 : 1;
+}
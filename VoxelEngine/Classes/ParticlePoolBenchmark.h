@@ -0,0 +1,90 @@
+#ifndef PARTICLE_POOL_BENCHMARK_H
+#define PARTICLE_POOL_BENCHMARK_H
+
+// cpp
+#include <string>
+#include <vector>
+
+namespace Voxel
+{
+	// foward declaration
+	class Random;
+
+	namespace UI
+	{
+		class ParticlePool;
+	}
+
+	/**
+	*	@class ParticlePoolBenchmark
+	*	@brief Measures UI particle pool update kernel without window or OpenGL context.
+	*
+	*	Fills ParticlePool to capacity with particles of short life span, so many particles die on every frame.
+	*	Each frame removes dead particles and then spawns same as ParticleSystem::update, then runs SSE update kernel.
+	*	Same frame is also updated by scalar reference of kernel on copy of particles to compare time and output.
+	*
+	*	Checks that spawning after removing dead particles refills full pool on every frame (no spawn is dropped under load),
+	*	that no dead particle is left in pool and that kernel output matches scalar reference.
+	*	Returns non zero exit code if any check fails.
+	*
+	*	Run with: VoxelEngine.exe --ui-particle-bench [max particles] [frames]
+	*/
+	class ParticlePoolBenchmark
+	{
+	public:
+		// Result of single run
+		struct Result
+		{
+			unsigned int capacity;
+			// Mean time of single update
+			float kernelMicroSeconds;
+			float scalarMicroSeconds;
+			// Mean number of particles spawned per frame
+			float spawnedPerFrame;
+			// Empty if all checks passed
+			std::string error;
+		};
+	private:
+		// Number of updates per run
+		int frames;
+
+		// Adds particle with random attributes. Pool must not be full.
+		void spawn(UI::ParticlePool& pool, Random& rand);
+
+		/**
+		*	Scalar version of ParticlePool::update on attribute arrays. Updates attributes and writes instance data.
+		*	@param attributes Attribute arrays of pool. Padded.
+		*	@param end Number of particles to update. Multiple of lane size.
+		*/
+		void updateScalar(std::vector<std::vector<float>>& attributes, const unsigned int end, const float delta, float* posOut, float* scaleRotOut, float* colorOut);
+
+		// Runs pool with given capacity
+		Result runOnce(const unsigned int capacity);
+
+		// Print result of single run
+		void printResult(const Result& result);
+	public:
+		/**
+		*	Constructor
+		*	@param frames Number of updates per run.
+		*/
+		ParticlePoolBenchmark(const int frames);
+
+		// Destructor
+		~ParticlePoolBenchmark() = default;
+
+		/**
+		*	Runs benchmark for each capacity.
+		*	@return true if all checks passed.
+		*/
+		bool run(const std::vector<int>& capacities);
+
+		/**
+		*	Parses arguments after --ui-particle-bench and runs benchmark with capacity 1024, 2048, ... up to max.
+		*	@return Exit code for process.
+		*/
+		static int runFromCommandLine(const int argc, const char* argv[]);
+	};
+}
+
+#endif
@@ -4,7 +4,6 @@
 #include "ParticleSystem.h"
 
 // voxel
-#include "Particle.h"
 #include "DataTree.h"
 #include "FileSystem.h"
 #include "SpriteSheet.h"
@@ -63,16 +62,6 @@ Voxel::UI::ParticleSystem::ParticleSystem(const std::string & name)
 
 Voxel::UI::ParticleSystem::~ParticleSystem()
 {
-	for(auto particle : particles)
-	{
-		if (particle)
-		{
-			delete particle;
-		}
-	}
-
-	particles.clear();
-
 	if (rand)
 	{
 		delete rand;
@@ -145,11 +134,7 @@ bool Voxel::UI::ParticleSystem::init(Voxel::DataTree* particleSystemDataTree)
 	setAttributesWithFile(particleSystemDataTree);
 
 	// init particles
-	for (unsigned int i = 0; i < totalParticles + ExtraParticlesInPool; ++i)
-	{
-		// all new particle data are default.
-		particles.push_back(new Particle());
-	}
+	resizePool();
 
 	// activate
 	state = State::RUNNING;
@@ -505,30 +490,17 @@ void Voxel::UI::ParticleSystem::setTotalParticles(const unsigned int totalPartic
 	}
 	else if (this->totalParticles < totalParticles)
 	{
-		auto amount = totalParticles - this->totalParticles;
-
-		for (unsigned int i = 0; i < amount; i++)
-		{
-			particles.push_back(new Particle());
-		}
-
 		reallocate = true;
 	}
-	else
-	{
-		auto amount = this->totalParticles - totalParticles;
 
-		for (unsigned int i = 0; i < amount; i++)
-		{
-			delete particles.back();
-			particles.pop_back();
-		}
-	}
+	this->totalParticles = totalParticles;
+
+	resizePool();
 
 	// particles shoudl always have 10 more in pool
-	assert((particles.size() - totalParticles) == ExtraParticlesInPool);
+	assert((pool.getCapacity() - totalParticles) == ExtraParticlesInPool);
 
-	this->totalParticles = totalParticles;
+	livingParticleNumber = pool.getSize();
 
 	if(reallocate)
 	{
@@ -787,15 +759,20 @@ bool Voxel::UI::ParticleSystem::setTexture(const std::string & spriteSheetName,
 	return true;
 }
 
+void Voxel::UI::ParticleSystem::resizePool()
+{
+	pool.setCapacity(totalParticles + ExtraParticlesInPool);
+
+	const unsigned int padded = pool.getPaddedCapacity();
+
+	posBuffer.resize(padded * 2, 0.0f);
+	scaleRotBuffer.resize(padded * 4, 0.0f);
+	colorBuffer.resize(padded * 4, 0.0f);
+}
+
 void Voxel::UI::ParticleSystem::reset()
 {
-	for (auto particle : particles)
-	{
-		if (particle->alive)
-		{
-			particle->alive = false;
-		}
-	}
+	pool.clear();
 
 	livingParticleNumber = 0;
 
@@ -830,6 +807,9 @@ void Voxel::UI::ParticleSystem::update(const float delta)
 		}
 	}
 	
+	// Particles that reached life span on last update are dead. Remove before spawning, so full pool doesn't drop new particles.
+	pool.removeDead();
+
 	if (actualTime != 0.0f)
 	{
 		spawnPoint += (emissionRate * actualTime);
@@ -843,147 +823,17 @@ void Voxel::UI::ParticleSystem::update(const float delta)
 		// Else, nothing to spawn
 	}
 
-	// buffer
-	std::vector<float> posBuffer;
-	std::vector<float> scaleRotBuffer;
-	std::vector<float> colorBuffer;
-	
-	auto p_it = particles.begin();
-	auto p_last = std::prev(particles.end());
-
-	int curLivingParticleNum = 0;
-		
-	for (; p_it != particles.end();)
-	{
-		Particle* curP = (*p_it);
-
-		if (curP->lifeSpan == 0.0f)
-		{
-			p_it++;
-			continue;
-		}
-
-		if (curP->alive == false)
-		{
-			break;
-		}
-
-		if (curP->alive && curP->livedTime >= curP->lifeSpan)
-		{
-			Particle* deadParticle = curP;
-			
-			deadParticle->alive = false;
-
-			p_it = particles.erase(p_it);
-
-			deadParticles.push_back(deadParticle);
-		}
-		else
-		{
-			// add time
-			curP->livedTime += delta;
-
-			// check if it's dead
-			if (curP->livedTime >= curP->lifeSpan)
-			{
-				// dead. match time with life span
-				curP->livedTime = curP->lifeSpan;
-				// yet, treat this particle and living particle
-			}
-
-			// count living particle
-			curLivingParticleNum++;
-
-			// calculate particle position
-
-			// temp vars
-			glm::vec2 tmp(0.0f);
-			glm::vec2 radial(0.0f);
-			glm::vec2 tangential(0.0f);
-
-			// radial acceleration
-			curP->normalizePoint(radial);
-
-			// copy
-			tangential = radial;
-
-			// apply radial acceleration
-			radial *= curP->accelRad;
-
-			// tengential acceleration
-			std::swap(tangential.x, tangential.y);
-
-			// apply tengential acceleration
-			tangential.x *= -(curP->accelTan);
-			tangential.y *= curP->accelTan;
-
-			// sum up gravity + radial + tengential. Apply time
-			tmp = (radial + tangential + gravity) * delta;
-
-			//tmp.x = radial.x + tangential.x + gravity.x;
-			//tmp.y = radial.y + tangential.y + gravity.y;
-			//tmp *= delta;
-
-			// sum new direction to current direction vector
-			curP->dirVec += tmp;
-
-			// Update position
-			curP->pos += (curP->dirVec * delta);
-
-			if (positionType == PositionType::PT_GROUPED)
-			{
-				// Grouped position type particles move together when emitter.
-				curP->emitPos = emitPos;
-			}
-			// else, Position type  is relative. Doens't move together with emitter.
-
-			// Add to position buffer.
-			posBuffer.push_back(curP->emitPos.x + curP->pos.x);
-			posBuffer.push_back(curP->emitPos.y + curP->pos.y);
-
-			//std::cout << "pos (" << curP->pos.x << ", " << curP->pos.y << ")\n";
-
-			const float lifeTimeRatio = curP->livedTime / curP->lifeSpan;
-
-			// size
-			float curSize = glm::lerp(curP->startSize, curP->endSize, lifeTimeRatio);
-
-			// to scale
-			float scale = curSize / textureSize;
-
-			// angle
-			float curAngle = glm::lerp(curP->startAngle, curP->endAngle, lifeTimeRatio);
-
-			// to matrix
-			auto scaleRotMat = glm::rotate(glm::scale(glm::mat4(1.0f), glm::vec3(scale, scale, 1.0f)), glm::radians(curAngle), glm::vec3(0.0f, 0.0f, 1.0f));
-
-			// Particle transformation in vec4 buffer
-			// we only need first two row and column for scale and rotation matrix
-			scaleRotBuffer.push_back(scaleRotMat[0][0]);
-			scaleRotBuffer.push_back(scaleRotMat[0][1]);
-			scaleRotBuffer.push_back(scaleRotMat[1][0]);
-			scaleRotBuffer.push_back(scaleRotMat[1][1]);
-
-			// Color buffer (rgba)
-			glm::vec4 curColor = glm::lerp(curP->startColor, curP->endColor, lifeTimeRatio);
-
-			// to buffer
-			colorBuffer.push_back(curColor.r);
-			colorBuffer.push_back(curColor.g);
-			colorBuffer.push_back(curColor.b);
-			colorBuffer.push_back(curColor.a);
-
-			p_it++;
-		}
-	}
-
-	livingParticleNumber = curLivingParticleNum;
+	ParticlePool::UpdateParams params;
+	params.delta = delta;
+	params.gravity = gravity;
+	params.grouped = (positionType == PositionType::PT_GROUPED);
+	params.emitPos = emitPos;
+	params.inverseTextureSize = (textureSize != 0.0f) ? (1.0f / textureSize) : 0.0f;
 
-	particles.insert(particles.end(), deadParticles.begin(), deadParticles.end());
+	// Updates all living particles and writes instance data at once
+	pool.update(params, posBuffer.data(), scaleRotBuffer.data(), colorBuffer.data());
 
-	deadParticles.clear();
-
-	assert((particles.size() - totalParticles) == ExtraParticlesInPool);
+	livingParticleNumber = pool.getSize();
 
 	if ((duration != -1) && (elapsedTime >= duration) && (livingParticleNumber == 0))
 	{
@@ -1045,68 +895,53 @@ void Voxel::UI::ParticleSystem::spawnNewParticles(const int count)
 				continue;
 			}
 
-			Particle* lastParticle = particles.back();
-
-			if (lastParticle->alive)
+			if (pool.isFull())
 			{
 				counter--;
 				continue;
-				//std::cout << "Reusing alive particle\n";
 			}
 
-			lastParticle->alive = true;
-
-			lastParticle->id = Voxel::UI::Particle::idCounter++;
+			const unsigned int index = pool.add();
 
 			const float randEmitAngle = rand->randRangeFloat(emitAngle - emitAngleVar, emitAngle + emitAngleVar);
+			const float randSpeed = rand->randRangeFloat(speed - speedVar, speed + speedVar);
 
-			lastParticle->dirVec.x = glm::cos(glm::radians(randEmitAngle));
-			lastParticle->dirVec.y = glm::sin(glm::radians(randEmitAngle));
+			pool.get(ParticlePool::DIR_X)[index] = glm::cos(glm::radians(randEmitAngle)) * randSpeed;
+			pool.get(ParticlePool::DIR_Y)[index] = glm::sin(glm::radians(randEmitAngle)) * randSpeed;
 
-			lastParticle->speed = rand->randRangeFloat(speed - speedVar, speed + speedVar);
+			pool.get(ParticlePool::POS_X)[index] = rand->randRangeFloat(-emitPosVar.x, emitPosVar.x);
+			pool.get(ParticlePool::POS_Y)[index] = rand->randRangeFloat(-emitPosVar.y, emitPosVar.y);
 
-			lastParticle->dirVec *= lastParticle->speed;
-
-			//lastParticle->pos.x = rand->randRangeFloat(emitPos.x - emitPosVar.x, emitPos.x + emitPosVar.x);
-			//lastParticle->pos.y = rand->randRangeFloat(emitPos.y - emitPosVar.y, emitPos.y + emitPosVar.y);
-			lastParticle->pos.x = rand->randRangeFloat(-emitPosVar.x, emitPosVar.x);
-			lastParticle->pos.y = rand->randRangeFloat(-emitPosVar.y, emitPosVar.y);
-
-			lastParticle->emitPos = emitPos;
+			pool.get(ParticlePool::EMIT_POS_X)[index] = emitPos.x;
+			pool.get(ParticlePool::EMIT_POS_Y)[index] = emitPos.y;
 
 			glm::vec4 startMinColor = glm::clamp(startColor - startColorVar, 0.0f, 1.0f);
 			glm::vec4 startMaxColor = glm::clamp(startColor + startColorVar, 0.0f, 1.0f);
 
-			lastParticle->startColor.r = rand->randRangeFloat(startMinColor.r, startMaxColor.r);
-			lastParticle->startColor.g = rand->randRangeFloat(startMinColor.g, startMaxColor.g);
-			lastParticle->startColor.b = rand->randRangeFloat(startMinColor.b, startMaxColor.b);
-			lastParticle->startColor.a = rand->randRangeFloat(startMinColor.a, startMaxColor.a);
+			pool.get(ParticlePool::START_COLOR_R)[index] = rand->randRangeFloat(startMinColor.r, startMaxColor.r);
+			pool.get(ParticlePool::START_COLOR_G)[index] = rand->randRangeFloat(startMinColor.g, startMaxColor.g);
+			pool.get(ParticlePool::START_COLOR_B)[index] = rand->randRangeFloat(startMinColor.b, startMaxColor.b);
+			pool.get(ParticlePool::START_COLOR_A)[index] = rand->randRangeFloat(startMinColor.a, startMaxColor.a);
 
 			glm::vec4 endMinColor = glm::clamp(endColor - endColorVar, 0.0f, 1.0f);
 			glm::vec4 endMaxColor = glm::clamp(endColor + endColorVar, 0.0f, 1.0f);
 
-			lastParticle->endColor.r = rand->randRangeFloat(endMinColor.r, endMaxColor.r);
-			lastParticle->endColor.g = rand->randRangeFloat(endMinColor.g, endMaxColor.g);
-			lastParticle->endColor.b = rand->randRangeFloat(endMinColor.b, endMaxColor.b);
-			lastParticle->endColor.a = rand->randRangeFloat(endMinColor.a, endMaxColor.a);
-
-			lastParticle->accelRad = rand->randRangeFloat(accelRad - accelRadVar, accelRad + accelRadVar);
-			lastParticle->accelTan = rand->randRangeFloat(accelTan - accelTanVar, accelTan + accelTanVar);
-
-			lastParticle->lifeSpan = randLifeSpan;
-			lastParticle->livedTime = 0.0f;
-
-			lastParticle->startSize = rand->randRangeFloat(startSize - startSizeVar, startSize + startSizeVar);
-			lastParticle->endSize = rand->randRangeFloat(endSize - endSizeVar, endSize + endSizeVar);
+			pool.get(ParticlePool::END_COLOR_R)[index] = rand->randRangeFloat(endMinColor.r, endMaxColor.r);
+			pool.get(ParticlePool::END_COLOR_G)[index] = rand->randRangeFloat(endMinColor.g, endMaxColor.g);
+			pool.get(ParticlePool::END_COLOR_B)[index] = rand->randRangeFloat(endMinColor.b, endMaxColor.b);
+			pool.get(ParticlePool::END_COLOR_A)[index] = rand->randRangeFloat(endMinColor.a, endMaxColor.a);
 
-			lastParticle->startAngle = rand->randRangeFloat(startAngle - startAngleVar, startAngle + startAngleVar);
-			lastParticle->endAngle = rand->randRangeFloat(endAngle - endAngleVar, endAngle + endAngleVar);
+			pool.get(ParticlePool::ACCEL_RAD)[index] = rand->randRangeFloat(accelRad - accelRadVar, accelRad + accelRadVar);
+			pool.get(ParticlePool::ACCEL_TAN)[index] = rand->randRangeFloat(accelTan - accelTanVar, accelTan + accelTanVar);
 
-			particles.pop_back();
+			pool.get(ParticlePool::LIFE_SPAN)[index] = randLifeSpan;
+			pool.get(ParticlePool::LIVED_TIME)[index] = 0.0f;
 
-			particles.push_front(lastParticle);
+			pool.get(ParticlePool::START_SIZE)[index] = rand->randRangeFloat(startSize - startSizeVar, startSize + startSizeVar);
+			pool.get(ParticlePool::END_SIZE)[index] = rand->randRangeFloat(endSize - endSizeVar, endSize + endSizeVar);
 
-			//std::cout << "Particle spawned #" + std::to_string(lastParticle->id) + "\n";
+			pool.get(ParticlePool::START_ANGLE)[index] = rand->randRangeFloat(startAngle - startAngleVar, startAngle + startAngleVar);
+			pool.get(ParticlePool::END_ANGLE)[index] = rand->randRangeFloat(endAngle - endAngleVar, endAngle + endAngleVar);
 
 			counter--;
 		}
@@ -1122,9 +957,9 @@ void Voxel::UI::ParticleSystem::renderSelf()
 	if (program == nullptr) return;
 
 	program->use(true);
-	program->setUniformMat4("modelMat", glm::scale(modelMat, glm::vec3(scale, 1)));
-	program->setUniformFloat("opacity", opacity);
-	program->setUniformVec3("color", color);
+	program->setUniformMat4(SID("modelMat"), glm::scale(modelMat, glm::vec3(scale, 1)));
+	program->setUniformFloat(SID("opacity"), opacity);
+	program->setUniformVec3(SID("color"), color);
 
 	texture->activate(GL_TEXTURE0);
 	texture->bind();
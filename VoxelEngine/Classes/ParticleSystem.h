@@ -3,13 +3,11 @@
 
 // voxel
 #include "RenderNode.h"
+#include "ParticlePool.h"
 
 // glm
 #include <glm\glm.hpp>
 
-// cpp
-#include <list>
-
 namespace Voxel
 {
 	// Foward delcaration
@@ -18,9 +16,6 @@ namespace Voxel
 
 	namespace UI
 	{
-		// Foward delcaration
-		class Particle;
-
 		/**
 		*	@class ParticleSystem
 		*	@brief Renders particle system in UI(2D) space.
@@ -68,9 +63,13 @@ namespace Voxel
 			// Position type
 			PositionType positionType;
 
-			// list of particles
-			std::list<Particle*> particles;
-			std::list<Particle*> deadParticles;
+			// Particles in structure of arrays
+			ParticlePool pool;
+
+			// Instance data that is loaded to buffer objects. Written by pool on update.
+			std::vector<float> posBuffer;
+			std::vector<float> scaleRotBuffer;
+			std::vector<float> colorBuffer;
 
 			// number of living particles
 			unsigned int livingParticleNumber;
@@ -213,6 +212,9 @@ namespace Voxel
 
 			// spawn new particles
 			void spawnNewParticles(const int count);
+
+			// Resize particle pool and instance data to total particles
+			void resizePool();
 		public:
 			// Destructor
 			~ParticleSystem();
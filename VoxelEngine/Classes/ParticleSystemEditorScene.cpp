@@ -6,6 +6,7 @@
 // voxel
 #include "Application.h"
 #include "SpriteSheet.h"
+#include "AssetLoader.h"
 #include "InputHandler.h"
 #include "Cursor.h"
 #include "Director.h"
@@ -70,6 +71,14 @@ Voxel::ParticleSystemEditorScene::~ParticleSystemEditorScene()
 {
 }
 
+void Voxel::ParticleSystemEditorScene::preload(std::vector<std::shared_ptr<AssetHandle>>& handles)
+{
+	auto& loader = AssetLoader::getInstance();
+
+	handles.push_back(loader.loadSpriteSheetAsync("EditorUISpriteSheet.json"));
+	handles.push_back(loader.loadSpriteSheetAsync("ParticleSpriteSheet.json"));
+}
+
 void Voxel::ParticleSystemEditorScene::init()
 {
 	Application::getInstance().getGLView()->setClearColor(glm::vec3(0.4375f));
@@ -619,8 +628,8 @@ void Voxel::ParticleSystemEditorScene::release()
 
 	auto& sm = SpriteSheetManager::getInstance();
 	
-	sm.removeSpriteSheetByKey("EditorUISpriteSheet");
-	sm.removeSpriteSheetByKey("ParticleSpriteSheet");
+	sm.removeSpriteSheetByKey(SID("EditorUISpriteSheet"));
+	sm.removeSpriteSheetByKey(SID("ParticleSpriteSheet"));
 }
 
 void Voxel::ParticleSystemEditorScene::updateKey()
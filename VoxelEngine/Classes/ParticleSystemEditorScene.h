@@ -268,6 +268,7 @@ namespace Voxel
 		~ParticleSystemEditorScene();
 
 		// overrides
+		void preload(std::vector<std::shared_ptr<AssetHandle>>& handles) override;
 		void init() override;
 		void onEnter() override;
 		void onEnterFinished() override;
@@ -5,15 +5,13 @@
 
 // voxel
 #include "Player.h"
-#include "Block.h"
+#include "ChunkMap.h"
 
 using namespace Voxel;
 
-const unsigned int Physics::X_AXIS = 0;
-const unsigned int Physics::Z_AXIS = 1;
-
 const float Physics::Gravity = 9.80665f;
 const float Physics::GravityModifier = 3.0f;
+const float Physics::MaxSweepStep = 0.45f;
 
 Voxel::Physics::Physics()
 	: playerJumpForce(0.0f)
@@ -100,623 +98,203 @@ Shape::AABB Voxel::Physics::getIntersectingAABB(const Shape::AABB & A, const Sha
 	return Shape::AABB(iMin + (iSize * 0.5f), iSize);
 }
 
-bool Voxel::Physics::resolveAutoJump(Player * player, const std::vector<Block*>& collidableBlocks)
+float Voxel::Physics::sweepAABBAxis(ChunkMap * map, const glm::vec3 & bbMin, const glm::vec3 & bbMax, const int axis, const float distance) const
 {
-	if (collidableBlocks.empty()) return false;
+	// Small skin, so AABB that is touching block isn't considered as overlapping it
+	const float skin = 0.0001f;
 
-	// position that player tried to move
-	auto playerNextPos = player->getNextPosition();
-	
-	// Resolving position
-	auto resolvingPos = playerNextPos;
+	// Block range that AABB covers on other 2 axes
+	const int u = (axis + 1) % 3;
+	const int v = (axis + 2) % 3;
+
+	glm::ivec3 rangeMin(0);
+	glm::ivec3 rangeMax(0);
 
-	// init player bounding box
-	auto pBB = player->getBoundingBox(resolvingPos);
+	rangeMin[u] = static_cast<int>(glm::floor(bbMin[u] + skin));
+	rangeMax[u] = static_cast<int>(glm::floor(bbMax[u] - skin));
+	rangeMin[v] = static_cast<int>(glm::floor(bbMin[v] + skin));
+	rangeMax[v] = static_cast<int>(glm::floor(bbMax[v] - skin));
 
-	// First, check if player was on ground and collided with block on the side. And if that block doesn't have any other block above, move player up (auto jump)
-	for (auto block : collidableBlocks)
+	if (distance > 0.0f)
 	{
-		// Get block Bounding box
-		auto blockBB = block->getBoundingBox();
+		// Check layers of blocks that leading face enters, from closest
+		const int first = static_cast<int>(glm::floor(bbMax[axis] - skin)) + 1;
+		const int last = static_cast<int>(glm::floor(bbMax[axis] + distance - skin));
 
-		// Check intersection
-		if (blockBB.doesIntersectsWith(pBB))
+		for (int layer = first; layer <= last; layer++)
 		{
-			// Get intersecting Bounding box
-			auto intersectingAABB = getIntersectingAABB(pBB, blockBB);
-			// Get size
-			auto iSize = intersectingAABB.getSize();
+			rangeMin[axis] = layer;
+			rangeMax[axis] = layer;
 
-			if (iSize.y == blockBB.getSize().y)
+			if (map->isAnyBlockOccupiedInRange(rangeMin, rangeMax))
 			{
-				// block's bounding box y axis is in player's bounding box y axis
-				if (pBB.getMin().y == blockBB.getMin().y)
-				{
-					// player is at same level with colliding block
-					auto upResolvingPos = resolvingPos;
-					upResolvingPos.y += 1.0f;
-
-					// get bounding box with 1 block higher
-					auto upPBB = player->getBoundingBox(upResolvingPos);
-
-					bool canAutoJump = true;
-
-					// Iterate blocks again and check again if it collides anything
-					for (auto upBlock : collidableBlocks)
-					{
-						// Get bounding box
-						auto upBlockBB = upBlock->getBoundingBox();
-						if (upBlockBB.doesIntersectsWith(upPBB))
-						{
-							// Intersects
-							auto iBB = getIntersectingAABB(upPBB, upBlockBB);
-							if (iBB.getSize().y > 0)
-							{
-								// Can't intersect
-								canAutoJump = false;
-								break;
-							}
-						}
-					}
-
-					if (canAutoJump)
-					{
-						std::cout << "auto jump. p.y = " << player->getPosition().y << ", np.y = " << playerNextPos.y << ", sizeY = " << iSize.y << std::endl;
-						player->autoJump(iSize.y);
-
-						//resolvingPos.y += 1.0f;
-
-						//player->autoJump(resolvingPos);
-						player->setOnGround(true);
-						player->setJumpState(Player::JumpState::IDLE);
-						//autoJumped = true;
- 						return true;
-					}
-					else
-					{
-						// there is a block above current block. can't auto jump
-					}
-				}
+				// Stop at block's face
+				return glm::max(static_cast<float>(layer) - bbMax[axis], 0.0f);
 			}
 		}
 	}
-
-	return false;
-}
-
-bool Voxel::Physics::resolvePlayerXAndBlockCollision(Player * player, glm::vec3& resolvingPos, const glm::vec3& movedDist, const std::vector<Block*>& collidableBlocks)
-{
-	if (collidableBlocks.empty()) return false;
-
-	// Get player boundinb box based on resolving position
-	auto pBB = player->getBoundingBox(resolvingPos);
-
-	bool resolved = false;
-
-	float pad = 0.0f;
-
-	// iterate blocks and resolve
-	for (auto block : collidableBlocks)
+	else if (distance < 0.0f)
 	{
-		auto blockBB = block->getBoundingBox();
+		const int first = static_cast<int>(glm::floor(bbMin[axis] + skin)) - 1;
+		const int last = static_cast<int>(glm::floor(bbMin[axis] + distance + skin));
 
-		if (blockBB.doesIntersectsWith(pBB))
+		for (int layer = first; layer >= last; layer--)
 		{
-			auto intersectingAABB = getIntersectingAABB(pBB, blockBB);
+			rangeMin[axis] = layer;
+			rangeMax[axis] = layer;
 
-			// intersecting AABB muse not be zero in all axis
-			if (!intersectingAABB.isAnyZero())
+			if (map->isAnyBlockOccupiedInRange(rangeMin, rangeMax))
 			{
-				//auto bPos = block->getWorldCoordinate();
-				//std::cout << "bPos = (" << bPos.x << ", " << bPos.y << ", " << bPos.z << ")\n";
-				//std::cout << "playerY = " << player->getPosition().y << std::endl;
-				//std::cout << "iSize.y = " << intersectingAABB.getSize().y << std::endl;
-				//std::cout << "Resolving pos = (" << resolvingPos.x << ", " << resolvingPos.y << ", " << resolvingPos.z << ")\n";
-
-				if (movedDist.x > 0.0f)
-				{
-					// Moved to east (positive x)
-					resolvingPos.x -= (intersectingAABB.getSize().x + pad);
-					resolved = true;
-					pBB = player->getBoundingBox(resolvingPos);
-					//std::cout << "Player moved east (positive x). resolved\n";
-				}
-				else if (movedDist.x < 0.0f)
-				{
-					// Moved to west (negative x)
-					resolvingPos.x += (intersectingAABB.getSize().x + pad);
-					resolved = true;
-					pBB = player->getBoundingBox(resolvingPos);
-					//std::cout << "Player moved west (negative x). resolved\n";
-				}
-				//std::cout << "Resolved pos = (" << resolvingPos.x << ", " << resolvingPos.y << ", " << resolvingPos.z << ")\n";
+				return glm::min(static_cast<float>(layer + 1) - bbMin[axis], 0.0f);
 			}
 		}
 	}
 
-	return resolved;
+	// Nothing blocks
+	return distance;
 }
 
-bool Voxel::Physics::resolvePlayerZAndBlockCollision(Player * player, glm::vec3& resolvingPos, const glm::vec3& movedDist, const std::vector<Block*>& collidableBlocks)
+glm::vec3 Voxel::Physics::sweepAABB(ChunkMap * map, const Shape::AABB & boundingBox, const glm::vec3 & displacement, glm::bvec3 & collided) const
 {
-	if (collidableBlocks.empty()) return false;
-
-	// Get player boundinb box based on resolving position
-	auto pBB = player->getBoundingBox(resolvingPos);
+	collided = glm::bvec3(false);
 
-	bool resolved = false;
+	glm::vec3 moved(0.0f);
 
-	float pad = 0.0f;
-
-	// iterate blocks and resolve
-	for (auto block : collidableBlocks)
+	if (map == nullptr)
 	{
-		auto blockBB = block->getBoundingBox();
-
-		if (blockBB.doesIntersectsWith(pBB))
-		{
-			auto intersectingAABB = getIntersectingAABB(pBB, blockBB);
-
-			// intersecting AABB muse not be zero in all axis
-			if (!intersectingAABB.isAnyZero())
-			{
-				//auto bPos = block->getWorldCoordinate();
-				//std::cout << "bPos = (" << bPos.x << ", " << bPos.y << ", " << bPos.z << ")\n";
-				//std::cout << "playerY = " << player->getPosition().y << std::endl;
-				//std::cout << "iSize.y = " << intersectingAABB.getSize().y << std::endl;
-				//std::cout << "Resolving pos = (" << resolvingPos.x << ", " << resolvingPos.y << ", " << resolvingPos.z << ")\n";
-
-				if (movedDist.z > 0.0f)
-				{
-					// Moved to south (positive z)
-					resolvingPos.z -= (intersectingAABB.getSize().z + pad);
-					resolved = true;
-					pBB = player->getBoundingBox(resolvingPos);
-					//std::cout << "Player moved south (positive z). resolved\n";
-				}
-				else if (movedDist.z < 0.0f)
-				{
-					// Moved to north (negative z)
-					resolvingPos.z += (intersectingAABB.getSize().z + pad);
-					resolved = true;
-					pBB = player->getBoundingBox(resolvingPos);
-					//std::cout << "Player moved north (negative z). resolved\n";
-				}
-				//std::cout << "Resolved pos = (" << resolvingPos.x << ", " << resolvingPos.y << ", " << resolvingPos.z << ")\n";
-			}
-		}
+		return moved;
 	}
 
-	return resolved;
-}
-
-/*
-void Voxel::Physics::resolvePlayerAndBlockCollision(Player * player, const std::vector<Block*>& collidableBlocks)
-{
-	if (collidableBlocks.empty()) return;
-
-	// current position
-	auto playerPos = player->getPosition();
-	// position that player tried to move
-	auto playerNextPos = player->getNextPosition();
+	glm::vec3 bbMin = boundingBox.getMin();
+	glm::vec3 bbMax = boundingBox.getMax();
 
-	// get moved distance
-	auto movedDist = playerNextPos - playerPos;
+	// Divide displacement in steps that are shorter than a block
+	const glm::vec3 absDisplacement = glm::abs(displacement);
+	const float maxDistance = glm::max(absDisplacement.x, glm::max(absDisplacement.y, absDisplacement.z));
+	const int stepCount = glm::max(1, static_cast<int>(glm::ceil(maxDistance / Physics::MaxSweepStep)));
+	const glm::vec3 step = displacement / static_cast<float>(stepCount);
 
-	// Resolving position
-	auto resolvingPos = glm::vec3(playerPos.x, playerNextPos.y, playerPos.z);
+	// Resolve x and z first, larger one first. Then y.
+	const int firstAxis = (absDisplacement.x >= absDisplacement.z) ? 0 : 2;
+	const int axisOrder[3] = { firstAxis, 2 - firstAxis, 1 };
 
-	bool resolved = false;
-	
-	// init player bounding box
-	auto pBB = player->getBoundingBox(resolvingPos);
-	
-	// Now iterate blocks again and resolve y again
-	bool inMidAir = true;
-
-	// Check if player is jumping
-	if (!player->isJumping())
+	for (int i = 0; i < stepCount; i++)
 	{
-		// not jumping
-		for (auto block : collidableBlocks)
+		for (int j = 0; j < 3; j++)
 		{
-			auto blockBB = block->getBoundingBox();
+			const int axis = axisOrder[j];
 
-			if (blockBB.doesIntersectsWith(pBB))
+			if (collided[axis] || step[axis] == 0.0f)
 			{
-				auto intersectingAABB = getIntersectingBoundingBox(pBB, blockBB);
-				float sizeY = intersectingAABB.getSize().y;
-				if (sizeY == 0.0f)
-				{
-					// block and player isn't intersecting in y axis. They might touching. Check y.
-					if (pBB.getMin().y == blockBB.getMax().y)
-					{
-						// touching
-						inMidAir = false;
-						continue;
-					}
-					else
-					{
-						continue;
-					}
-				}
-				else
-				{
-					// block and player is intersecting in y axis
-					if (sizeY == blockBB.getSize().y)
-					{
-						// block is completly inside of player's bounding box in y axis. skip					
-						continue;
-					}
-					else
-					{
-						if (!intersectingAABB.isZero(false))
-						{
-							// player and block is intersecting partialy.
-							if (movedDist.y > 0.0f)
-							{
-								// moved up
-								resolvingPos.y -= (intersectingAABB.getSize().y);
-								resolved = true;
-								pBB = player->getBoundingBox(resolvingPos);
-								std::cout << "Player moved up. resolved\n";
-							}
-							else if (movedDist.y < 0.0f)
-							{
-								if (pBB.getMin().y == blockBB.getMax().y)
-								{
-								}
-								// moved down
-
-
-								std::cout << "position y = " << resolvingPos.y << std::endl;
-								resolvingPos.y += (intersectingAABB.getSize().y);
-								std::cout << "resolving y = " << resolvingPos.y << std::endl;
-								resolved = true;
-								inMidAir = false;
-								pBB = player->getBoundingBox(resolvingPos);
-								player->setOnGround(true);
-								std::cout << "Player moved down. resolved\n";
-							}
-						}
-					}
-				}
+				continue;
 			}
-		}
-	}
 
-	bool resolvedXZ = false;
+			const float dist = sweepAABBAxis(map, bbMin, bbMax, axis, step[axis]);
 
-	if (true)
-	{
-		resolvingPos.x = playerPos.x;
-		resolvingPos.z = playerPos.z;
-
-		glm::vec3 absMovedDist = glm::abs(movedDist);
-
-		if (absMovedDist.x != 0 || absMovedDist.z != 0)
-		{
-			if (absMovedDist.x >= absMovedDist.z)
+			if (dist != step[axis])
 			{
-				//std::cout << "0\n";
-				resolvingPos.x = playerNextPos.x;
-				bool result = false;
-				result = resolvePlayerXAndBlockCollision(player, resolvingPos, movedDist, collidableBlocks);
-				if (result) resolvedXZ = true;
-				resolvingPos.z = playerNextPos.z;
-				result = resolvePlayerZAndBlockCollision(player, resolvingPos, movedDist, collidableBlocks);
-				if (result) resolvedXZ = true;
+				collided[axis] = true;
 			}
-			else
-			{
-				// resolve z first
-				resolvingPos.z = playerNextPos.z;
-				bool result = false;
-				result = resolvePlayerZAndBlockCollision(player, resolvingPos, movedDist, collidableBlocks);
-				if (result) resolvedXZ = true;
-				resolvingPos.x = playerNextPos.x;
-				result = resolvePlayerXAndBlockCollision(player, resolvingPos, movedDist, collidableBlocks);
-				if (result) resolvedXZ = true;
-				//std::cout << "1\n";
-			}
-		}
-	}
-
-	if (inMidAir)
-	{
-		player->setOnGround(false);
-	}
-
-	if (resolved || resolvedXZ)
-	{
-		player->setNextPosition(resolvingPos);
-	}
-}
-*/
-
-void Voxel::Physics::resolvePlayerAndBlockCollisionInXZAxis(Player * player, const std::vector<Block*>& collidableBlocks)
-{
-	if (collidableBlocks.empty()) return;
-
-	// current position
-	auto playerPos = player->getPosition();
-	// position that player tried to move
-	auto playerNextPos = player->getNextPosition();
-
-	// get moved distance
-	auto movedDist = playerNextPos - playerPos;
-
-	// Resolving position
-	auto resolvingPos = playerPos;
-
-	bool resolved = false;
-
-	glm::vec3 absMovedDist = glm::abs(movedDist);
-
-	if (absMovedDist.x != 0 || absMovedDist.z != 0)
-	{
-		if (absMovedDist.x >= absMovedDist.z)
-		{
-			// resolve x first
-			//std::cout << "0\n";
-
-			bool result = false;
-
-			resolvingPos.x = playerNextPos.x;
-
-			result = resolvePlayerXAndBlockCollision(player, resolvingPos, movedDist, collidableBlocks);
-			
-			if (result) 
-				resolved = true;
-
-			resolvingPos.z = playerNextPos.z;
-
-			result = resolvePlayerZAndBlockCollision(player, resolvingPos, movedDist, collidableBlocks);
-			
-			if (result) 
-				resolved = true;
-		}
-		else
-		{
-			// resolve z first
-			//std::cout << "1\n";
-			bool result = false;
-
-			resolvingPos.z = playerNextPos.z;
-
-			result = resolvePlayerZAndBlockCollision(player, resolvingPos, movedDist, collidableBlocks);
-
-			if (result) 
-				resolved = true;
 
-			resolvingPos.x = playerNextPos.x;
-
-			result = resolvePlayerXAndBlockCollision(player, resolvingPos, movedDist, collidableBlocks);
-			
-			if (result) 
-				resolved = true;
+			bbMin[axis] += dist;
+			bbMax[axis] += dist;
+			moved[axis] += dist;
 		}
 	}
 
-	if (resolved)
-	{
-		//std::cout << "XZ resolved from (" << playerNextPos.x << ", " << playerNextPos.y << ", " << playerNextPos.z << ") to (" << resolvingPos.x << ", " << playerNextPos.y << ", " << resolvingPos.z << ")\n";
-		player->setResolvedNextPosition(glm::vec3(resolvingPos.x, playerNextPos.y, resolvingPos.z));
-	}
+	return moved;
 }
 
-void Voxel::Physics::resolvePlayerBottomCollision(Player * player, const std::vector<Block*>& collidableBlocks)
+bool Voxel::Physics::isAABBColliding(ChunkMap * map, const Shape::AABB & boundingBox) const
 {
-	if (collidableBlocks.empty()) return;
-
-	// current position
-	auto playerPos = player->getPosition();
-	// position that player tried to move
-	auto playerNextPos = player->getNextPosition();
-
-	// get moved distance
-	auto movedDist = playerNextPos - playerPos;
-
-	if (movedDist.y >= 0.0f)
+	if (map == nullptr)
 	{
-		// player didn't move downward. 
-		//std::cout << "Player didn't move downward" << std::endl;
-		return;
+		return false;
 	}
 
-	// Resolving position
-	auto resolvingPos = playerNextPos;
-
-	// init player bounding box
-	auto pBB = player->getBoundingBox(resolvingPos);
-
-	for (auto block : collidableBlocks)
-	{
-		auto blockBB = block->getBoundingBox();
-
-		// Check intersection
-		if (blockBB.doesIntersectsWith(pBB))
-		{
-			// intersects with block
-			auto intersectingAABB = getIntersectingAABB(pBB, blockBB);
-
-			// get y size
-			float sizeY = intersectingAABB.getSize().y;// block i
-
-			//if (!intersectingAABB.isZero(false))
-			if(sizeY > 0)
-			{
-				// player and block is intersecting
-				//std::cout << "playerPos y = " << playerPos.y << std::endl;
-				//std::cout << "playerNextPos y = " << playerNextPos.y << std::endl;
-				//std::cout << "r position y = " << resolvingPos.y << std::endl;
-				resolvingPos.y += (intersectingAABB.getSize().y);
-				//std::cout << "resolving y = " << resolvingPos.y << std::endl;
+	const float skin = 0.0001f;
 
-				//pBB = player->getBoundingBox(resolvingPos);
- 				//player->setOnGround(true);
-				//player->setJumpState(Player::JumpState::IDLE);
+	const glm::ivec3 rangeMin = glm::ivec3(glm::floor(boundingBox.getMin() + skin));
+	const glm::ivec3 rangeMax = glm::ivec3(glm::floor(boundingBox.getMax() - skin));
 
-				player->setResolvedNextPosition(resolvingPos);
-
-				//std::cout << "Player moved down. resolved\n";
-
-				return;
-			}
-		}
-	}
-
- 	//player->setOnGround(false);
-	//player->setAsFalling();
+	return map->isAnyBlockOccupiedInRange(rangeMin, rangeMax);
 }
 
-void Voxel::Physics::resolvePlayerTopCollision(Player * player, const std::vector<Block*>& collidableBlocks)
+void Voxel::Physics::resolvePlayerCollision(Player * player, ChunkMap * map)
 {
-	if (collidableBlocks.empty()) return;
-
-	// current position
-	auto playerPos = player->getPosition();
+	// position at start of tick. Not rendered position, which is interpolated per frame.
+	auto playerPos = player->getPrevTickPosition();
 	// position that player tried to move
 	auto playerNextPos = player->getNextPosition();
 
 	// get moved distance
-	auto movedDistY = playerNextPos.y - playerPos.y;
-
-	if (movedDistY <= 0.0f)
-	{
-		// player didn't move upward;
-		//std::cout << "Player didn't move upward" << std::endl;
-		return;
-	}
-
-	// Resolving position
-	auto resolvingPos = playerNextPos;
-
-	// init player bounding box
-	auto pBB = player->getBoundingBox(resolvingPos);
-
-	for (auto block : collidableBlocks)
-	{
-		auto blockBB = block->getBoundingBox();
-
-		// Check intersection
-		if (blockBB.doesIntersectsWith(pBB))
-		{
-			// intersects with block
-			auto intersectingAABB = getIntersectingAABB(pBB, blockBB);
-
-			// get y size
-			float sizeY = intersectingAABB.getSize().y;// block i
-
-			//if (!intersectingAABB.isZero(false))
-			if (sizeY > 0)
-			{
-				// Player bumped on block. Cancel jump.
-				playerJumpForce.y = 0.0f;
-				player->setJumpState(Player::JumpState::FALLING);
-				// player and block is intersecting
-				//std::cout << "position y = " << playerPos.y << std::endl;
-				//std::cout << "r position y = " << resolvingPos.y << std::endl;
-				resolvingPos.y -= (intersectingAABB.getSize().y);
-				//std::cout << "resolving y = " << resolvingPos.y << std::endl;
-				
-				player->setResolvedNextPosition(resolvingPos);
-
-				//std::cout << "Player moved up. resolved\n";
-
-				return;
-			}
-		}
-	}
-}
-
-void Voxel::Physics::checkIfPlayerIsFalling(Player * player, const std::vector<Block*>& collidableBlocks)
-{
-	if (collidableBlocks.empty()) return;
-
-	// Get next player pos because it's all resolved at this point
-	auto playerPos = player->getPosition();
-	//std::cout << "-- playerPos: (" << playerPos.x << ", " << playerPos.y << ", " << playerPos.z << ")\n";
-	//playerPos.y = player->getNextPosition().y;
-	//std::cout << "-- pos: (" << playerPos.x << ", " << playerPos.y << ", " << playerPos.z << ")\n";
-
+	auto movedDist = playerNextPos - playerPos;
 
-	// init player bounding box
-	auto pBB = player->getBoundingBox(playerPos);
+	glm::bvec3 collided(false);
 
-	for (auto block : collidableBlocks)
+	// Check if player can auto jump. Can auto jump only if player is on ground
+	if (player->isOnGround() && (movedDist.x != 0.0f || movedDist.z != 0.0f))
 	{
-		auto blockBB = block->getBoundingBox();
+		// Move in XZ axis only
+		sweepAABB(map, player->getBoundingBox(playerPos), glm::vec3(movedDist.x, 0.0f, movedDist.z), collided);
 
-		if (blockBB.getMax().y >= pBB.getMin().y)
+		if (collided.x || collided.z)
 		{
-			//std::cout << "block max y: " << blockBB.getMax().y << ", player min y " << pBB.getMin().y << std::endl;
-			auto resolvingPos = playerPos;
-			resolvingPos.y -= 0.1f;
+			// Collided with block on the side. If there is no block above that block, move player up (auto jump)
+			auto upResolvingPos = playerNextPos;
+			upResolvingPos.y += 1.0f;
 
-			auto resolvedPlayerBB = player->getBoundingBox(resolvingPos);
-
-			if (resolvedPlayerBB.doesIntersectsWith(blockBB))
+			if (!isAABBColliding(map, player->getBoundingBox(upResolvingPos)))
 			{
-				// player and block is intersecting
-				//std::cout << "Player is on ground" << std::endl;
+				player->autoJump(1.0f);
 				player->setOnGround(true);
 				player->setJumpState(Player::JumpState::IDLE);
 				return;
 			}
+			// Else, there is a block above. can't auto jump
 		}
 	}
 
-	player->setOnGround(false);
-	/*
-	if (playerJumpForce.y > 0.0f)
-	{
-		player->setJumpState(Player::JumpState::JUMPING);
-	}
-	else
+	auto resolvedDist = sweepAABB(map, player->getBoundingBox(playerPos), movedDist, collided);
+	auto resolvingPos = playerPos + resolvedDist;
+
+	if (collided.y && movedDist.y > 0.0f)
 	{
+		// Player bumped on block. Cancel jump.
+		playerJumpForce.y = 0.0f;
 		player->setJumpState(Player::JumpState::FALLING);
 	}
-	*/
 
-	if (player->isJumpStateIdle())
+	if (collided.x || collided.y || collided.z)
 	{
-		player->setJumpState(Voxel::Player::JumpState::FALLING);
+		player->setResolvedNextPosition(resolvingPos);
 	}
 
-	//std::cout << "Player is NOT on ground" << std::endl;
-}
-
-bool Voxel::Physics::checkCollisionWithBlocks(const Shape::AABB & boundingBox, const std::vector<Block*>& nearByBlocks)
-{
-	for (auto block : nearByBlocks)
+	// Keep track if player is on ground or not. If player is jumping, skip
+	if (player->isJumping())
 	{
-		auto blockBB = block->getBoundingBox();
-
-		// Check intersection
-		if (blockBB.doesIntersectsWith(boundingBox))
-		{
-			return true;
-		}
+		return;
 	}
 
-	return false;
-}
+	// Check slightly below player
+	auto groundPos = resolvingPos;
+	groundPos.y -= 0.1f;
 
-bool Voxel::Physics::checkSphereCollisionWithBlocks(const Shape::Sphere& sphere, const std::vector<Block*>& nearByBlocks)
-{
-	for (auto block : nearByBlocks)
+	if (isAABBColliding(map, player->getBoundingBox(groundPos)))
+	{
+		// player is on ground
+		player->setOnGround(true);
+		player->setJumpState(Player::JumpState::IDLE);
+	}
+	else
 	{
-		auto blockBB = block->getBoundingBox();
+		player->setOnGround(false);
 
-		// Check intersection
-		if (blockBB.doesIntersectsWith(sphere))
+		if (player->isJumpStateIdle())
 		{
-			return true;
+			player->setJumpState(Voxel::Player::JumpState::FALLING);
 		}
 	}
-
-	return false;
 }
 
 void Voxel::Physics::applyJumpForceToPlayer(const glm::vec3 & force)
@@ -4,16 +4,13 @@
 // glm
 #include <glm\glm.hpp>
 
-// cpp
-#include <vector>
-
 // voxel
 #include "Shape.h"
 
 namespace Voxel
 {
 	class Player;
-	class Block;
+	class ChunkMap;
 
 	/**
 	*	@class Physics
@@ -22,11 +19,18 @@ namespace Voxel
 	class Physics
 	{
 	private:
-		// for collision resolution. We divide step to x axis and z axis
-		static const unsigned int X_AXIS;
-		static const unsigned int Z_AXIS;
-
 		glm::vec3 playerJumpForce;
+
+		/**
+		*	Moves AABB in single axis and stops at first block that isn't air.
+		*	@param map ChunkMap to query blocks.
+		*	@param bbMin Minimum point of AABB.
+		*	@param bbMax Maximum point of AABB.
+		*	@param axis Axis to move. 0 for x, 1 for y, 2 for z.
+		*	@param distance Distance to move. Must be less than 1 block.
+		*	@return Distance that AABB can move without colliding.
+		*/
+		float sweepAABBAxis(ChunkMap* map, const glm::vec3& bbMin, const glm::vec3& bbMax, const int axis, const float distance) const;
 	public:
 		// Gravity. Same as earth.
 		static const float Gravity;
@@ -35,10 +39,9 @@ namespace Voxel
 		
 		// Player jump distance (1 block by default)
 		static const float PlayerJumpDistance;
-		// 
 
-		bool resolvePlayerXAndBlockCollision(Player* player, glm::vec3& resolvingPos, const glm::vec3& movedDist, const std::vector<Block*>& collidableBlocks);
-		bool resolvePlayerZAndBlockCollision(Player* player, glm::vec3& resolvingPos, const glm::vec3& movedDist, const std::vector<Block*>& collidableBlocks);
+		// Maximum distance that AABB moves in single sweep step. Less than 1 block, so fast moving AABB never skips block.
+		static const float MaxSweepStep;
 	public:
 		Physics();
 		~Physics() = default;
@@ -66,33 +69,36 @@ namespace Voxel
 		Shape::AABB getIntersectingAABB(const Shape::AABB& A, const Shape::AABB& B);
 
 		/**
-		*	Resolves auto jump feature
-		*	Auto jump is a feature that player can automatically move up the block without jumping
-		*	
-		*	@param [in] player A player pointer.
-		*	@param [in] collidableBlocks A vector of Blocks that is collidable.
+		*	Sweeps AABB through block grid and stops at blocks that aren't air.
+		*	Displacement is divided in steps no longer than MaxSweepStep, and each step moves x, z and y axis in order.
+		*	Axis that collides stops moving for the rest of steps, so AABB slides along the other axes.
+		*	Queries block directly from chunk storage. Doesn't allocate. Safe to call for any number of entities.
+		*
+		*	@param [in] map ChunkMap to query blocks.
+		*	@param [in] boundingBox AABB at starting position.
+		*	@param [in] displacement Distance that AABB tries to move.
+		*	@param [out] collided Set true for each axis that AABB collided.
+		*	@return Distance that AABB can move without colliding.
 		*/
-		bool resolveAutoJump(Player* player, const std::vector<Block*>& collidableBlocks);
+		glm::vec3 sweepAABB(ChunkMap* map, const Shape::AABB& boundingBox, const glm::vec3& displacement, glm::bvec3& collided) const;
 
 		/**
-		*	Resolves collistion between player and blocks.
+		*	Checks if there is any block that isn't air inside of AABB.
+		*	@param [in] map ChunkMap to query blocks.
+		*	@param [in] boundingBox AABB to check.
+		*	@return true if AABB overlaps any block.
+		*/
+		bool isAABBColliding(ChunkMap* map, const Shape::AABB& boundingBox) const;
+
+		/**
+		*	Resolves collision between player and blocks.
+		*	Sweeps player's bounding box from position to next position, handles auto jump, 
+		*	bump on ceiling and updates player's on ground and jump state.
 		*
 		*	@param [in] player A player pointer.
-		*	@param [in] collidableBlocks A vector of Blocks that is collidable.
+		*	@param [in] map ChunkMap to query blocks.
 		*/
-		void resolvePlayerAndBlockCollision(Player* player, const std::vector<Block*>& collidableBlocks);
-
-		void resolvePlayerAndBlockCollisionInXZAxis(Player* player, const std::vector<Block*>& collidableBlocks);
-
-		void resolvePlayerBottomCollision(Player* player, const std::vector<Block*>& collidableBlocks);
-
-		// Resolves collision between blocks above player. Only resolves in Y axis. Only called while jupming.
-		void resolvePlayerTopCollision(Player* player, const std::vector<Block*>& collidableBlocks);
-
-		void checkIfPlayerIsFalling(Player* player, const std::vector<Block*>& collidableBlocks);
-
-		bool checkCollisionWithBlocks(const Shape::AABB& boundingBox, const std::vector<Block*>& nearByBlocks);
-		bool checkSphereCollisionWithBlocks(const Shape::Sphere& sphere, const std::vector<Block*>& nearByBlocks);
+		void resolvePlayerCollision(Player* player, ChunkMap* map);
 
 		bool updatePlayerJumpForce(Player* player, const float delta);
 	};
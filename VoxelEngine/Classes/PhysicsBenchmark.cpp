@@ -0,0 +1,296 @@
+// pch
+#include "PreCompiled.h"
+
+#include "PhysicsBenchmark.h"
+
+// cpp
+#include <thread>
+#include <chrono>
+#include <memory>
+
+// voxel
+#include "World.h"
+#include "Region.h"
+#include "ChunkMap.h"
+#include "ChunkUtil.h"
+#include "ChunkMeshGenerator.h"
+#include "ChunkWorkManager.h"
+#include "SimplexNoise.h"
+#include "Player.h"
+#include "Physics.h"
+#include "Simulation.h"
+#include "FixedTimeStep.h"
+#include "Benchmark.h"
+#include "Utility.h"
+
+using namespace Voxel;
+
+namespace
+{
+	// Radius of generated chunks around starting region
+	const int ChunkRadius = 4;
+	// Bodies spawn this many chunks from center, so walking never leaves generated chunks
+	const int SpawnChunkRadius = 2;
+	// Seconds that bodies only fall at start and only stand at end
+	const int FallSeconds = 8;
+	const int SettleSeconds = 2;
+	// Seconds that bodies walk in one direction
+	const int WalkSeconds = 2;
+}
+
+Voxel::PhysicsBenchmark::PhysicsBenchmark(const unsigned int bodyCount, const int seconds, const int tickRate)
+	: bodyCount(bodyCount)
+	, seconds(seconds)
+	, tickRate(FixedTimeStep(tickRate).getTickRate())
+{}
+
+void Voxel::PhysicsBenchmark::getScriptedInput(const unsigned int bodyIndex, const unsigned long long tick, const unsigned long long totalTicks, MovementInput & input) const
+{
+	input.clear();
+
+	const unsigned long long rate = static_cast<unsigned long long>(tickRate);
+
+	if (tick < rate * FallSeconds || tick + rate * SettleSeconds >= totalTicks)
+	{
+		// Falling or settling
+		return;
+	}
+
+	const unsigned long long walkTick = tick - rate * FallSeconds;
+
+	// Back and forth, so bodies stay near spawn
+	if (((walkTick / (rate * WalkSeconds)) % 2) == 0)
+	{
+		input.forward = true;
+	}
+	else
+	{
+		input.backward = true;
+	}
+
+	// Sideways on some bodies
+	input.left = (bodyIndex % 3) == 1;
+
+	// Jump once per second. Bodies jump on different ticks.
+	input.jump = (tick % rate) == (bodyIndex % rate);
+}
+
+PhysicsBenchmark::Result Voxel::PhysicsBenchmark::runOnce(ChunkMap * chunkMap, const glm::vec2 & spawnCenter, const std::string & pacing, const std::vector<float>& frameDeltas)
+{
+	std::vector<std::unique_ptr<Player>> players;
+	std::vector<std::unique_ptr<Physics>> physics;
+
+	const float spawnRange = static_cast<float>(SpawnChunkRadius * Constant::CHUNK_SECTION_WIDTH);
+	// Top of world. Falls fast enough to hit max fall distance per tick.
+	const float spawnY = static_cast<float>(Constant::HEIGHEST_BLOCK_Y - 4);
+
+	for (unsigned int i = 0; i < bodyCount; i++)
+	{
+		// Spread bodies on grid in spawn area. Same positions on every run.
+		const float u = static_cast<float>((i * 2654435761u) % 1024) / 1023.0f;
+		const float v = static_cast<float>((i * 40503u + 17u) % 1024) / 1023.0f;
+
+		players.push_back(std::unique_ptr<Player>(new Player()));
+		players.back()->setPosition(glm::vec3(spawnCenter.x + (u * 2.0f - 1.0f) * spawnRange, spawnY, spawnCenter.y + (v * 2.0f - 1.0f) * spawnRange), false);
+		players.back()->setRotation(glm::vec3(0.0f, static_cast<float>((i * 37) % 360), 0.0f), false);
+
+		physics.push_back(std::unique_ptr<Physics>(new Physics()));
+	}
+
+	FixedTimeStep step(tickRate);
+
+	const unsigned long long totalTicks = static_cast<unsigned long long>(seconds) * static_cast<unsigned long long>(step.getTickRate());
+
+	Result result;
+	result.pacing = pacing;
+	result.bodyCount = bodyCount;
+	result.tickCount = 0;
+	result.totalMilliSeconds = 0.0f;
+
+	MovementInput input;
+	double frameTime = 0.0;
+	unsigned long long advancedTicks = 0;
+	unsigned int frame = 0;
+
+	while (result.tickCount < totalTicks)
+	{
+		const float frameDelta = frameDeltas.at(frame % frameDeltas.size());
+		frame++;
+
+		frameTime += static_cast<double>(frameDelta);
+
+		const int ticks = step.advance(frameDelta);
+		advancedTicks += static_cast<unsigned long long>(ticks);
+
+		auto start = Utility::Time::now();
+
+		for (int t = 0; t < ticks && result.tickCount < totalTicks; t++)
+		{
+			for (unsigned int i = 0; i < bodyCount; i++)
+			{
+				getScriptedInput(i, result.tickCount, totalTicks, input);
+				Simulation::tickPlayer(players.at(i).get(), physics.at(i).get(), chunkMap, input, step.getTickDelta());
+			}
+
+			result.tickCount++;
+		}
+
+		auto end = Utility::Time::now();
+
+		result.totalMilliSeconds += Benchmark::toMilliSeconds(start, end);
+	}
+
+	result.microSecondsPerTick = result.tickCount > 0 ? (result.totalMilliSeconds * 1000.0f) / static_cast<float>(result.tickCount) : 0.0f;
+	result.nanoSecondsPerBodyTick = (result.tickCount > 0 && bodyCount > 0) ? (result.totalMilliSeconds * 1000000.0f) / static_cast<float>(result.tickCount * bodyCount) : 0.0f;
+
+	// Frame time must be consumed as ticks. Only remainder less than single tick stays in accumulator.
+	const double tickTime = static_cast<double>(advancedTicks) * static_cast<double>(step.getTickDelta());
+
+	if (step.getTickCount() != advancedTicks)
+	{
+		result.error = "tick count " + std::to_string(step.getTickCount()) + " != " + std::to_string(advancedTicks);
+	}
+	else if (frameTime - tickTime >= static_cast<double>(step.getTickDelta()) * 1.01 || tickTime - frameTime > 0.001)
+	{
+		result.error = "ticks cover " + std::to_string(tickTime) + "s of " + std::to_string(frameTime) + "s";
+	}
+
+	Physics query;
+
+	for (unsigned int i = 0; i < bodyCount; i++)
+	{
+		auto player = players.at(i).get();
+		auto position = player->getNextPosition();
+
+		result.positions.push_back(position);
+
+		if (!result.error.empty())
+		{
+			continue;
+		}
+
+		if (position.y < 0.0f)
+		{
+			result.error = "body #" + std::to_string(i) + " fell through world";
+		}
+		else if (query.isAABBColliding(chunkMap, player->getBoundingBox(position)))
+		{
+			result.error = "body #" + std::to_string(i) + " overlaps block at " + Utility::Log::vec3ToStr(position);
+		}
+		else if (!player->isOnGround())
+		{
+			result.error = "body #" + std::to_string(i) + " isn't on ground at " + Utility::Log::vec3ToStr(position);
+		}
+	}
+
+	return result;
+}
+
+void Voxel::PhysicsBenchmark::printResult(const Result & result)
+{
+	Benchmark::ResultLine("PhysicsBenchmark", result.pacing)
+		.add("bodies", result.bodyCount)
+		.add("ticks", result.tickCount)
+		.add("time", result.totalMilliSeconds, "ms")
+		.add("tick", result.microSecondsPerTick, "us")
+		.add("body tick", result.nanoSecondsPerBodyTick, "ns")
+		.addChecks(result.error)
+		.print();
+}
+
+bool Voxel::PhysicsBenchmark::run()
+{
+	std::cout << "[PhysicsBenchmark] Bodies: " << bodyCount << ", seconds: " << seconds << ", tick rate: " << tickRate << "\n";
+
+	// Same as WorldGenBenchmark
+	const std::string seed = "ENGINE";
+
+	Noise::Manager::init(seed);
+
+	World* world = new World();
+	world->setTemperature(0.5f, 1.5f);
+	world->setMoisture(0.5f, 1.5f);
+	world->init(10, 10, 0, seed);
+
+	auto startingRegionSitePos = glm::vec2(glm::ivec2(world->getCurrentRegion()->getSitePosition())) + 0.5f;
+
+	ChunkMap* chunkMap = new ChunkMap();
+
+	ChunkMeshGenerator* chunkMeshGenerator = new ChunkMeshGenerator();
+	chunkMeshGenerator->setBlockShadeMode(2);
+
+	ChunkWorkManager* chunkWorkManager = new ChunkWorkManager();
+
+	auto chunkCoordinates = chunkMap->initChunkNearPlayer(glm::vec3(startingRegionSitePos.x, 0.0f, startingRegionSitePos.y), ChunkRadius);
+	chunkMap->initActiveChunks();
+
+	for (auto xz : chunkCoordinates)
+	{
+		chunkWorkManager->addPreGenerateWork(glm::ivec2(xz));
+	}
+
+	chunkWorkManager->run();
+	chunkWorkManager->spawnThreads(chunkMap, chunkMeshGenerator, world, std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+
+	while (!chunkWorkManager->isIdle())
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	// Simulation runs after workers stopped, so nothing else touches chunks
+	chunkWorkManager->stop();
+	chunkWorkManager->joinThread();
+
+	// Center of chunk that player would stand on
+	auto spawnCenter = glm::vec2(chunkCoordinates.front()) * Constant::CHUNK_BORDER_SIZE + Constant::CHUNK_BORDER_SIZE_HALF;
+
+	auto steady = runOnce(chunkMap, spawnCenter, "30 fps", { 1.0f / 30.0f });
+	printResult(steady);
+
+	auto uneven = runOnce(chunkMap, spawnCenter, "144 / 50 fps", { 1.0f / 144.0f, 1.0f / 144.0f, 1.0f / 50.0f });
+
+	if (uneven.error.empty())
+	{
+		if (uneven.tickCount != steady.tickCount)
+		{
+			uneven.error = "tick count differs from 30 fps";
+		}
+		else
+		{
+			for (unsigned int i = 0; i < uneven.positions.size(); i++)
+			{
+				if (uneven.positions.at(i) != steady.positions.at(i))
+				{
+					uneven.error = "body #" + std::to_string(i) + " ended at " + Utility::Log::vec3ToStr(uneven.positions.at(i)) + " instead of " + Utility::Log::vec3ToStr(steady.positions.at(i));
+					break;
+				}
+			}
+		}
+	}
+
+	printResult(uneven);
+
+	delete chunkWorkManager;
+	delete chunkMap;
+	delete chunkMeshGenerator;
+	delete world;
+
+	return steady.error.empty() && uneven.error.empty();
+}
+
+int Voxel::PhysicsBenchmark::runFromCommandLine(const int argc, const char * argv[])
+{
+	// argv[0] is exe, argv[1] is --physics-bench
+	int bodyCount = 1000;
+	int seconds = 20;
+	int tickRate = FixedTimeStep::DefaultTickRate;
+
+	if (!Benchmark::parseArguments(argc, argv, { { &bodyCount, 1 }, { &seconds, FallSeconds + SettleSeconds + WalkSeconds }, { &tickRate, FixedTimeStep::MinTickRate } }, "[bodies] [seconds] [tick rate]"))
+	{
+		return 1;
+	}
+
+	PhysicsBenchmark benchmark(static_cast<unsigned int>(bodyCount), seconds, tickRate);
+
+	return benchmark.run() ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+#ifndef PHYSICS_BENCHMARK_H
+#define PHYSICS_BENCHMARK_H
+
+// cpp
+#include <string>
+#include <vector>
+
+// glm
+#include <glm\glm.hpp>
+
+namespace Voxel
+{
+	// foward declaration
+	class ChunkMap;
+	struct MovementInput;
+
+	/**
+	*	@class PhysicsBenchmark
+	*	@brief Measures fixed tick simulation without window or OpenGL context.
+	*
+	*	Generates chunks around starting region like WorldGenBenchmark, then drops bodies (Player with own Physics)
+	*	from top of world and runs Simulation::tickPlayer with scripted MovementInput. Bodies fall, walk back and forth and jump.
+	*	Ticks are driven by FixedTimeStep from two different frame rates: steady 30 fps and uneven 144 / 50 fps.
+	*
+	*	After each run, checks that FixedTimeStep consumed all frame time and that every body stands on ground without overlapping block.
+	*	Bodies must end at same position on both frame rates, because simulation only depends on tick count.
+	*	Returns non zero exit code if any check fails.
+	*
+	*	Run with: VoxelEngine.exe --physics-bench [bodies] [seconds] [tick rate]
+	*/
+	class PhysicsBenchmark
+	{
+	public:
+		// Result of single run
+		struct Result
+		{
+			std::string pacing;
+			unsigned int bodyCount;
+			unsigned long long tickCount;
+			// Time spent on ticks
+			float totalMilliSeconds;
+			float microSecondsPerTick;
+			float nanoSecondsPerBodyTick;
+			// Position of each body after last tick
+			std::vector<glm::vec3> positions;
+			// Empty if all checks passed
+			std::string error;
+		};
+	private:
+		// Number of bodies
+		unsigned int bodyCount;
+
+		// Simulated time in seconds
+		int seconds;
+
+		// Ticks per second
+		int tickRate;
+
+		// Get scripted movement of body on tick
+		void getScriptedInput(const unsigned int bodyIndex, const unsigned long long tick, const unsigned long long totalTicks, MovementInput& input) const;
+
+		/**
+		*	Runs simulation once from same starting state.
+		*	@param chunkMap Generated chunks.
+		*	@param spawnCenter Center of spawn area in world position.
+		*	@param pacing Name of frame pacing.
+		*	@param frameDeltas Frame times that repeat until simulated time ends.
+		*/
+		Result runOnce(ChunkMap* chunkMap, const glm::vec2& spawnCenter, const std::string& pacing, const std::vector<float>& frameDeltas);
+
+		// Print result of single run
+		void printResult(const Result& result);
+	public:
+		/**
+		*	Constructor
+		*	@param bodyCount Number of bodies to simulate.
+		*	@param seconds Simulated time per run.
+		*	@param tickRate Ticks per second. Clamped by FixedTimeStep.
+		*/
+		PhysicsBenchmark(const unsigned int bodyCount, const int seconds, const int tickRate);
+
+		// Destructor
+		~PhysicsBenchmark() = default;
+
+		/**
+		*	Generates chunks and runs simulation on each frame pacing.
+		*	@return true if all checks passed.
+		*/
+		bool run();
+
+		/**
+		*	Parses arguments after --physics-bench and runs benchmark.
+		*	@return Exit code for process.
+		*/
+		static int runFromCommandLine(const int argc, const char* argv[]);
+	};
+}
+
+#endif
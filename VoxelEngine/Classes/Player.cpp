@@ -18,32 +18,33 @@ const float Player::EyeHeight = 1.5f;
 Player::Player()
 	: position(0)
 	, nextPosition(0)
+	, prevTickPosition(0)
 	, rotation(0)
 	, rotationTarget(0)
+	, direction(0)
+	, xzVelocity(0)
+	, xzAcceleration(glm::vec2(0.05f, 0.05f))
+	, xzElapsedTime(0)
+	, rayRange(0)
+	, viewMode(ViewMode::FIRST_PERSON_VIEW)
+	, jumpState(JumpState::FALLING)
+	, viewMatrix(mat4(1.0f))
+	, dirMatrix(mat4(1.0f))
 	, movementSpeed(7.0f)
 	, rotationSpeed(15.0f)
+	, cameraY(Player::EyeHeight)
+	, cameraDistanceZ(Player::MaxCameraDistanceX)
+	, cameraDistanceTargetZ(Player::MaxCameraDistanceX)
+	, cameraColliding(false)
 	, fly(false)
-	, mainCamera(Camera::mainCamera)
-	, viewMatrix(mat4(1.0f))
-	, dirMatrix(mat4(1.0f))
 	, moved(false)
 	, rotated(false)
-	, direction(0)
-	, rayRange(0)
-	, lookingBlock(nullptr)
-	, lookingFace(Cube::Face::NONE)
 	, fallDuration(0)
 	, fallDistance(0)
 	, onGround(false)
-	, cameraY(Player::EyeHeight)
-	, cameraDistanceZ(Player::MaxCameraDistanceX)
-	, cameraDistanceTargetZ(Player::MaxCameraDistanceX)
-	, viewMode(ViewMode::FIRST_PERSON_VIEW)
-	, jumpState(JumpState::FALLING)
-	, cameraColliding(false)
-	, xzVelocity(0)
-	, xzAcceleration(glm::vec2(0.05f, 0.05f))
-	, xzElapsedTime(0)
+	, lookingBlock(nullptr)
+	, lookingFace(Cube::Face::NONE)
+	, mainCamera(Camera::mainCamera)
 #if V_DEBUG
 #if V_DEBUG_PLAYER_DIR_LINE
 	, yLineVao(0)
@@ -498,6 +499,7 @@ void Voxel::Player::autoJump(const float y)
 {
 	position.y += y;
 	nextPosition.y += y;
+	prevTickPosition.y += y;
 	cameraY -= y;
 
 	// Not sure why I added. this. Removing this solves weird stutter looking after auto jump
@@ -511,6 +513,7 @@ void Voxel::Player::autoJump(const glm::vec3 & resolvedPosition)
 {
 	position = resolvedPosition;
 	nextPosition = resolvedPosition;
+	prevTickPosition = resolvedPosition;
 	cameraY -= resolvedPosition.y;
 
 	moved = true;
@@ -674,46 +677,23 @@ void Voxel::Player::update(const float delta)
 	}
 }
 
-void Voxel::Player::updateMovement(const float delta)
+void Voxel::Player::beginTick()
 {
-	// Updates player movement. Call this after resolving collision.
-	
-	if (position.x != nextPosition.x)
-	{
-		position.x = glm::lerp(position.x, nextPosition.x, 20.0f * delta);
+	prevTickPosition = nextPosition;
+}
 
-		if (glm::abs(position.x - nextPosition.x) <= 0.01f)
-		{
-			position.x = nextPosition.x;
-		}
-	}
+void Voxel::Player::updateMovement(const float alpha)
+{
+	// Updates player movement. Call this after resolving collision.
+	// Simulation moves next position once per tick. Rendering interpolates between last two ticks, so movement is smooth on any frame rate.
 
-	if (position.z != nextPosition.z)
-	{
-		position.z = glm::lerp(position.z, nextPosition.z, 20.0f * delta);
+	// First save current Y for cameraY.
+	const float curY = position.y;
 
-		if (glm::abs(position.z - nextPosition.z) <= 0.01f)
-		{
-			position.z = nextPosition.z;
-		}
-	}
+	position = glm::mix(prevTickPosition, nextPosition, glm::clamp(alpha, 0.0f, 1.0f));
 
-	if (position.y != nextPosition.y)
+	if (position.y != curY)
 	{
-		// Current position and next position is different. lerp to next position.
-
-		// First save current Y for cameraY.
-		const float curY = position.y;
-
-		// Lerp it
-		position.y = glm::lerp(position.y, nextPosition.y, 20.0f * delta);
-		
-		if (glm::abs(position.y - nextPosition.y) <= 0.05f)
-		{
-			// Check distance between. If it's less than 0.001f, just use next position.
-			position.y = nextPosition.y;
-		}
-		
 		// Add y offset to cameraY to give smooth camera following effect.
 		addCameraY((curY - position.y) * 0.5f);
 	}
@@ -751,6 +731,7 @@ void Voxel::Player::setPosition(const glm::vec3 & newPosition, const bool smooth
 	{
 		position = newPosition;
 		nextPosition = newPosition;
+		prevTickPosition = newPosition;
 
 		moved = true;
 	}
@@ -782,6 +763,7 @@ void Voxel::Player::addCameraY(const float y)
 void Voxel::Player::applyNextPosition()
 {
 	position = nextPosition;
+	prevTickPosition = nextPosition;
 }
 
 glm::vec3 Voxel::Player::getNextPosition()
@@ -789,6 +771,11 @@ glm::vec3 Voxel::Player::getNextPosition()
 	return nextPosition;
 }
 
+glm::vec3 Voxel::Player::getPrevTickPosition()
+{
+	return prevTickPosition;
+}
+
 glm::vec3 Voxel::Player::getEyePosition()
 {
 	return glm::vec3(position.x, position.y + Player::EyeHeight, position.z);
@@ -903,8 +890,8 @@ void Voxel::Player::renderDebugLines(Program* lineProgram)
 	{
 		glBindVertexArray(yLineVao);
 
-		lineProgram->setUniformMat4("modelMat", glm::mat4(1.0f));
-		lineProgram->setUniformVec4("lineColor", glm::vec4(1.0f));
+		lineProgram->setUniformMat4(SID("modelMat"), glm::mat4(1.0f));
+		lineProgram->setUniformVec4(SID("lineColor"), glm::vec4(1.0f));
 		glDrawArrays(GL_LINES, 0, 2);
 
 		drawCall++;
@@ -921,8 +908,8 @@ void Voxel::Player::renderDebugLines(Program* lineProgram)
 		rayMat = glm::rotate(rayMat, glm::radians(rotation.x), glm::vec3(1, 0, 0));
 		rayMat = glm::rotate(rayMat, glm::radians(-rotation.z), glm::vec3(0, 0, 1));
 
-		lineProgram->setUniformMat4("modelMat", rayMat);
-		lineProgram->setUniformVec4("lineColor", glm::vec4(1.0f));
+		lineProgram->setUniformMat4(SID("modelMat"), rayMat);
+		lineProgram->setUniformVec4(SID("lineColor"), glm::vec4(1.0f));
 		glDrawArrays(GL_LINES, 0, 2);
 
 		drawCall++;
@@ -934,8 +921,8 @@ void Voxel::Player::renderDebugLines(Program* lineProgram)
 	if (boundingBoxVao)
 	{
 		glBindVertexArray(boundingBoxVao);
-		lineProgram->setUniformMat4("modelMat", glm::mat4(1.0f));
-		lineProgram->setUniformVec4("lineColor", glm::vec4(1.0f));
+		lineProgram->setUniformMat4(SID("modelMat"), glm::mat4(1.0f));
+		lineProgram->setUniformVec4(SID("lineColor"), glm::vec4(1.0f));
 		glDrawArrays(GL_LINES, 0, 24);
 
 		drawCall++;
@@ -50,6 +50,8 @@ namespace Voxel
 		glm::vec3 position;
 		// For collision resolution
 		glm::vec3 nextPosition;
+		// Next position at start of last simulation tick. Rendered position is between this and next position.
+		glm::vec3 prevTickPosition;
 		// player's rotation angle in degree
 		glm::vec3 rotation;
 		// For smooth rotation
@@ -132,6 +134,8 @@ namespace Voxel
 		void addCameraY(const float y);
 		void applyNextPosition();
 		glm::vec3 getNextPosition();
+		// Next position at start of current simulation tick. Collision sweeps from here.
+		glm::vec3 getPrevTickPosition();
 		glm::vec3 getEyePosition();
 		glm::vec3 getNextEyePosition();
 
@@ -159,7 +163,15 @@ namespace Voxel
 		void updateDirection();
 
 		void update(const float delta);
-		void updateMovement(const float delta);
+
+		// Save next position as start of tick. Call before each simulation tick.
+		void beginTick();
+
+		/**
+		*	Set rendered position between last two simulation ticks. Call after all ticks of frame.
+		*	@param alpha Interpolation alpha from FixedTimeStep::getAlpha().
+		*/
+		void updateMovement(const float alpha);
 		void updateCameraDistanceZ(const float delta);
 		void renderDebugLines(Program* lineProgram);
 
@@ -0,0 +1,190 @@
+// pch
+#include "PreCompiled.h"
+
+#include "ProfilerBenchmark.h"
+
+// cpp
+#include <thread>
+#include <atomic>
+
+// voxel
+#include "FrameProfiler.h"
+#include "Benchmark.h"
+#include "Utility.h"
+
+using namespace Voxel;
+
+namespace
+{
+	// Work inside each zone. Volatile so loop isn't optimized out.
+	volatile unsigned int benchmarkSink = 0;
+
+	void benchmarkWork(const unsigned int i)
+	{
+		benchmarkSink = benchmarkSink + (i * 2654435761u);
+	}
+}
+
+Voxel::ProfilerBenchmark::ProfilerBenchmark(const unsigned int frameCount, const unsigned int zonesPerFrame, const int workerCount)
+	: frameCount(frameCount)
+	, zonesPerFrame(zonesPerFrame)
+	, workerCount(workerCount)
+{}
+
+ProfilerBenchmark::Result Voxel::ProfilerBenchmark::runFrames(const std::string & name, const bool useZones, const bool enable)
+{
+	auto& profiler = FrameProfiler::getInstance();
+	profiler.setEnabled(enable);
+
+	const unsigned long long droppedBefore = profiler.getDroppedCount();
+
+	// Workers record zones until frames are done
+	std::atomic<bool> running(true);
+	std::vector<std::thread> workers;
+
+	for (int t = 0; t < workerCount; t++)
+	{
+		workers.push_back(std::thread([&, t]()
+		{
+			V_PROFILE_THREAD_NAME("Benchmark worker #" + std::to_string(t));
+
+			unsigned int i = 0;
+
+			while (running.load())
+			{
+				if (useZones)
+				{
+					V_PROFILE_ZONE("Worker zone");
+					benchmarkWork(i);
+				}
+				else
+				{
+					benchmarkWork(i);
+				}
+
+				i++;
+
+				// Like chunk worker, doesn't record back to back forever
+				if ((i & 255) == 0)
+				{
+					std::this_thread::yield();
+				}
+			}
+		}));
+	}
+
+	double zoneNanoSeconds = 0;
+	double endFrameMicroSeconds = 0;
+
+	for (unsigned int frame = 0; frame < frameCount; frame++)
+	{
+		auto start = Utility::Time::now();
+
+		if (useZones)
+		{
+			V_PROFILE_ZONE("Frame zone");
+
+			for (unsigned int i = 0; i < zonesPerFrame; i++)
+			{
+				V_PROFILE_ZONE("Zone");
+				benchmarkWork(i);
+			}
+		}
+		else
+		{
+			for (unsigned int i = 0; i < zonesPerFrame; i++)
+			{
+				benchmarkWork(i);
+			}
+		}
+
+		auto end = Utility::Time::now();
+
+		if (useZones)
+		{
+			V_PROFILE_END_FRAME();
+		}
+
+		auto endFrameEnd = Utility::Time::now();
+
+		zoneNanoSeconds += Benchmark::toNanoSeconds(start, end);
+		endFrameMicroSeconds += Benchmark::toMicroSeconds(end, endFrameEnd);
+	}
+
+	running.store(false);
+
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+
+	// Collect zones that workers recorded after last frame
+	if (useZones)
+	{
+		V_PROFILE_END_FRAME();
+	}
+
+	Result result;
+	result.name = name;
+	result.zoneCount = static_cast<unsigned long long>(frameCount) * static_cast<unsigned long long>(zonesPerFrame + 1);
+	result.nanoSecondsPerZone = static_cast<float>(zoneNanoSeconds / static_cast<double>(result.zoneCount));
+	result.endFrameMicroSeconds = static_cast<float>(endFrameMicroSeconds / static_cast<double>(frameCount));
+	result.droppedCount = profiler.getDroppedCount() - droppedBefore;
+
+	profiler.setEnabled(false);
+
+	return result;
+}
+
+void Voxel::ProfilerBenchmark::printResult(const Result & result, const float baselineNanoSeconds)
+{
+	Benchmark::ResultLine("ProfilerBenchmark", result.name)
+		.add("zones", result.zoneCount)
+		.add("per zone", result.nanoSecondsPerZone, "ns")
+		.add("overhead", std::max(result.nanoSecondsPerZone - baselineNanoSeconds, 0.0f), "ns")
+		.add("end frame", result.endFrameMicroSeconds, "us")
+		.add("dropped", result.droppedCount)
+		.print();
+}
+
+void Voxel::ProfilerBenchmark::run()
+{
+	std::cout << "[ProfilerBenchmark] Frames: " << frameCount << ", zones per frame: " << zonesPerFrame << ", worker threads: " << workerCount << "\n";
+
+#if V_PROFILER
+	auto baseline = runFrames("no zones", false, false);
+	printResult(baseline, baseline.nanoSecondsPerZone);
+
+	printResult(runFrames("disabled", true, false), baseline.nanoSecondsPerZone);
+	printResult(runFrames("enabled", true, true), baseline.nanoSecondsPerZone);
+
+	// Summary of enabled run
+	auto& profiler = FrameProfiler::getInstance();
+	auto lines = profiler.getSummary();
+
+	for (auto& line : lines)
+	{
+		std::cout << "[ProfilerBenchmark] " << line << "\n";
+	}
+#else
+	std::cout << "[ProfilerBenchmark] V_PROFILER is 0. Zones are compiled out.\n";
+#endif
+}
+
+int Voxel::ProfilerBenchmark::runFromCommandLine(const int argc, const char * argv[])
+{
+	// argv[0] is exe, argv[1] is --profiler-bench
+	int frameCount = 1000;
+	int zonesPerFrame = 2000;
+	int workerCount = 4;
+
+	if (!Benchmark::parseArguments(argc, argv, { { &frameCount, 1 }, { &zonesPerFrame, 1 }, { &workerCount, 0 } }, "[frames] [zones per frame] [worker threads]"))
+	{
+		return 1;
+	}
+
+	ProfilerBenchmark benchmark(static_cast<unsigned int>(frameCount), static_cast<unsigned int>(zonesPerFrame), workerCount);
+	benchmark.run();
+
+	return 0;
+}
@@ -0,0 +1,62 @@
+#ifndef PROFILER_BENCHMARK_H
+#define PROFILER_BENCHMARK_H
+
+// cpp
+#include <string>
+
+namespace Voxel
+{
+	/**
+	*	@class ProfilerBenchmark
+	*	@brief Measures cost of FrameProfiler zones without window or OpenGL context.
+	*
+	*	Main thread runs frames of short nested zones and ends each frame. Worker threads record zones at same time, like chunk workers.
+	*	Runs same loop without zones, with profiler disabled and with profiler enabled. Difference from loop without zones is cost of zone.
+	*
+	*	Run with: VoxelEngine.exe --profiler-bench [frames] [zones per frame] [worker threads]
+	*/
+	class ProfilerBenchmark
+	{
+	public:
+		struct Result
+		{
+			std::string name;
+			unsigned long long zoneCount;
+			float nanoSecondsPerZone;
+			// Mean time of endFrame
+			float endFrameMicroSeconds;
+			unsigned long long droppedCount;
+		};
+	private:
+		unsigned int frameCount;
+		unsigned int zonesPerFrame;
+		int workerCount;
+
+		// Run frames. Zones are compiled in only if useZones is true.
+		Result runFrames(const std::string& name, const bool useZones, const bool enable);
+
+		void printResult(const Result& result, const float baselineNanoSeconds);
+	public:
+		/**
+		*	Constructor
+		*	@param frameCount Number of frames.
+		*	@param zonesPerFrame Number of zones main thread records each frame.
+		*	@param workerCount Number of threads that record zones while frames run.
+		*/
+		ProfilerBenchmark(const unsigned int frameCount, const unsigned int zonesPerFrame, const int workerCount);
+
+		// Destructor
+		~ProfilerBenchmark() = default;
+
+		// Run without zones, disabled and enabled
+		void run();
+
+		/**
+		*	Parses arguments after --profiler-bench and runs benchmark.
+		*	@return Exit code for process.
+		*/
+		static int runFromCommandLine(const int argc, const char* argv[]);
+	};
+}
+
+#endif
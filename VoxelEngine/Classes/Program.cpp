@@ -98,6 +98,12 @@ void Voxel::Program::findAllUniforms()
 
 				//std::cout << "Uniform: " << uniformName << ", location: " << location << std::endl;
 
+				if (location < 0)
+				{
+					// Uniform in uniform block
+					continue;
+				}
+
 				UniformValue uv;
 				uv.type = type;
 
@@ -137,8 +143,17 @@ void Voxel::Program::findAllUniforms()
 					break;
 				}
 
-				uniformLocations.emplace(std::string(uniformName), location);
-				uniformValues.emplace(location, uv);
+				uniformLocations.emplace(StringID(std::string(uniformName)), location);
+
+				if (location >= static_cast<GLint>(uniformValues.size()))
+				{
+					UniformValue unused;
+					unused.type = GL_ZERO;
+
+					uniformValues.resize(location + 1, unused);
+				}
+
+				uniformValues.at(location) = uv;
 			}
 
 			delete[] uniformName;
@@ -146,6 +161,27 @@ void Voxel::Program::findAllUniforms()
 	}
 }
 
+UniformValue * Voxel::Program::findUniformValue(const GLint location)
+{
+	if (location < 0 || location >= static_cast<GLint>(uniformValues.size()) || uniformValues[location].type == GL_ZERO)
+	{
+		return nullptr;
+	}
+
+	return &uniformValues[location];
+}
+
+GLint Voxel::Program::findUniformLocation(const StringID name) const
+{
+	auto find_it = uniformLocations.find(name);
+	if (find_it == uniformLocations.end())
+	{
+		return -1;
+	}
+
+	return find_it->second;
+}
+
 GLuint Program::getObject() const
 {
 	return programObject;
@@ -185,8 +221,8 @@ GLint Program::getUniformLocation(const GLchar * uniformName)
 
 void Voxel::Program::setUniformBool(const GLint location, const bool boolean)
 {
-	auto find_it = uniformValues.find(location);
-	if (find_it == uniformValues.end())
+	auto uniformValue = findUniformValue(location);
+	if (uniformValue == nullptr)
 	{
 #if V_DEBUG && V_DEBUG_LOG_CONSOLE
 		Voxel::Logger::getInstance().consoleError("[Program] Failed to find uniform boolean location: " + std::to_string(location) + ", bool: " + std::string(boolean ? "True" : "False"));
@@ -195,13 +231,12 @@ void Voxel::Program::setUniformBool(const GLint location, const bool boolean)
 	}
 	else
 	{
-		auto& uniformValue = find_it->second;
-		if (uniformValue.type == GL_BOOL)
+		if (uniformValue->type == GL_BOOL)
 		{
-			if (uniformValue.value.boolValue != boolean)
+			if (uniformValue->value.boolValue != boolean)
 			{
 				glUniform1i(location, boolean);
-				uniformValue.value.boolValue = boolean;
+				uniformValue->value.boolValue = boolean;
 			}
 			else
 			{
@@ -215,7 +250,7 @@ void Voxel::Program::setUniformBool(const GLint location, const bool boolean)
 	}
 }
 
-void Voxel::Program::setUniformBool(const std::string & name, const bool boolean)
+void Voxel::Program::setUniformBool(const StringID name, const bool boolean)
 {
 	auto find_it = uniformLocations.find(name);
 	if (find_it == uniformLocations.end())
@@ -230,8 +265,8 @@ void Voxel::Program::setUniformBool(const std::string & name, const bool boolean
 
 void Voxel::Program::setUniformInt(const GLint location, const int integer)
 {
-	auto find_it = uniformValues.find(location);
-	if (find_it == uniformValues.end())
+	auto uniformValue = findUniformValue(location);
+	if (uniformValue == nullptr)
 	{
 #if V_DEBUG && V_DEBUG_LOG_CONSOLE
 		Voxel::Logger::getInstance().consoleError("[Program] Failed to find uniform int location: " + std::to_string(location) + ", int: " + std::to_string(integer));
@@ -240,13 +275,12 @@ void Voxel::Program::setUniformInt(const GLint location, const int integer)
 	}
 	else
 	{
-		auto& uniformValue = find_it->second;
-		if (uniformValue.type == GL_INT)
+		if (uniformValue->type == GL_INT)
 		{
-			if (uniformValue.value.intValue != integer)
+			if (uniformValue->value.intValue != integer)
 			{
 				glUniform1i(location, integer);
-				uniformValue.value.intValue = integer;
+				uniformValue->value.intValue = integer;
 			}
 			else
 			{
@@ -260,7 +294,7 @@ void Voxel::Program::setUniformInt(const GLint location, const int integer)
 	}
 }
 
-void Voxel::Program::setUniformInt(const std::string & name, const int integer)
+void Voxel::Program::setUniformInt(const StringID name, const int integer)
 {
 	auto find_it = uniformLocations.find(name);
 	if (find_it == uniformLocations.end())
@@ -275,8 +309,8 @@ void Voxel::Program::setUniformInt(const std::string & name, const int integer)
 
 void Voxel::Program::setUniformFloat(const GLint location, const float val)
 {
-	auto find_it = uniformValues.find(location);
-	if (find_it == uniformValues.end())
+	auto uniformValue = findUniformValue(location);
+	if (uniformValue == nullptr)
 	{
 #if V_DEBUG && V_DEBUG_LOG_CONSOLE
 		Voxel::Logger::getInstance().consoleError("[Program] Failed to find uniform float location: " + std::to_string(location) + ", float: " + std::to_string(val));
@@ -285,13 +319,12 @@ void Voxel::Program::setUniformFloat(const GLint location, const float val)
 	}
 	else
 	{
-		auto& uniformValue = find_it->second;
-		if (uniformValue.type == GL_FLOAT)
+		if (uniformValue->type == GL_FLOAT)
 		{
-			if (uniformValue.value.floatValue != val)
+			if (uniformValue->value.floatValue != val)
 			{
 				glUniform1f(location, val);
-				uniformValue.value.floatValue = val;
+				uniformValue->value.floatValue = val;
 			}
 			else
 			{
@@ -305,7 +338,7 @@ void Voxel::Program::setUniformFloat(const GLint location, const float val)
 	}
 }
 
-void Voxel::Program::setUniformFloat(const std::string & name, const float val)
+void Voxel::Program::setUniformFloat(const StringID name, const float val)
 {
 	auto find_it = uniformLocations.find(name);
 	if (find_it == uniformLocations.end())
@@ -320,8 +353,8 @@ void Voxel::Program::setUniformFloat(const std::string & name, const float val)
 
 void Voxel::Program::setUniformVec2(const GLint location, const glm::vec2 & val)
 {
-	auto find_it = uniformValues.find(location);
-	if (find_it == uniformValues.end())
+	auto uniformValue = findUniformValue(location);
+	if (uniformValue == nullptr)
 	{
 #if V_DEBUG && V_DEBUG_LOG_CONSOLE
 		Voxel::Logger::getInstance().consoleError("[Program] Failed to find uniform vec2 location: " + std::to_string(location) + ", vec2: (" + std::to_string(val.x) + ", " + std::to_string(val.y) + ")");
@@ -330,15 +363,14 @@ void Voxel::Program::setUniformVec2(const GLint location, const glm::vec2 & val)
 	}
 	else
 	{
-		auto& uniformValue = find_it->second;
-		if (uniformValue.type == GL_FLOAT_VEC2)
+		if (uniformValue->type == GL_FLOAT_VEC2)
 		{
-			glm::vec2 v2 = glm::make_vec2(uniformValue.value.v2Value);
+			glm::vec2 v2 = glm::make_vec2(uniformValue->value.v2Value);
 			if (v2 != val)
 			{
 				glUniform2f(location, val.x, val.y);
-				uniformValue.value.v2Value[0] = val.x;
-				uniformValue.value.v2Value[1] = val.y;
+				uniformValue->value.v2Value[0] = val.x;
+				uniformValue->value.v2Value[1] = val.y;
 			}
 			else
 			{
@@ -352,7 +384,7 @@ void Voxel::Program::setUniformVec2(const GLint location, const glm::vec2 & val)
 	}
 }
 
-void Voxel::Program::setUniformVec2(const std::string & name, const glm::vec2 & val)
+void Voxel::Program::setUniformVec2(const StringID name, const glm::vec2 & val)
 {
 	auto find_it = uniformLocations.find(name);
 	if (find_it == uniformLocations.end())
@@ -367,8 +399,8 @@ void Voxel::Program::setUniformVec2(const std::string & name, const glm::vec2 &
 
 void Voxel::Program::setUniformVec3(const GLint location, const glm::vec3 & val)
 {
-	auto find_it = uniformValues.find(location);
-	if (find_it == uniformValues.end())
+	auto uniformValue = findUniformValue(location);
+	if (uniformValue == nullptr)
 	{
 #if V_DEBUG && V_DEBUG_LOG_CONSOLE
 		Voxel::Logger::getInstance().consoleError("[Program] Failed to find uniform vec3 location: " + std::to_string(location) + ", vec3: (" + std::to_string(val.x) + ", " + std::to_string(val.y) + ", " + std::to_string(val.z) + ")");
@@ -377,16 +409,15 @@ void Voxel::Program::setUniformVec3(const GLint location, const glm::vec3 & val)
 	}
 	else
 	{
-		auto& uniformValue = find_it->second;
-		if (uniformValue.type == GL_FLOAT_VEC3)
+		if (uniformValue->type == GL_FLOAT_VEC3)
 		{
-			glm::vec3 v3 = glm::make_vec3(uniformValue.value.v3Value);
+			glm::vec3 v3 = glm::make_vec3(uniformValue->value.v3Value);
 			if (v3 != val)
 			{
 				glUniform3f(location, val.x, val.y, val.z);
-				uniformValue.value.v3Value[0] = val.x;
-				uniformValue.value.v3Value[1] = val.y;
-				uniformValue.value.v3Value[2] = val.z;
+				uniformValue->value.v3Value[0] = val.x;
+				uniformValue->value.v3Value[1] = val.y;
+				uniformValue->value.v3Value[2] = val.z;
 			}
 			else
 			{
@@ -400,7 +431,7 @@ void Voxel::Program::setUniformVec3(const GLint location, const glm::vec3 & val)
 	}
 }
 
-void Voxel::Program::setUniformVec3(const std::string & name, const glm::vec3 & val)
+void Voxel::Program::setUniformVec3(const StringID name, const glm::vec3 & val)
 {
 	auto find_it = uniformLocations.find(name);
 	if (find_it == uniformLocations.end())
@@ -415,8 +446,8 @@ void Voxel::Program::setUniformVec3(const std::string & name, const glm::vec3 &
 
 void Voxel::Program::setUniformVec4(const GLint location, const glm::vec4 & val)
 {
-	auto find_it = uniformValues.find(location);
-	if (find_it == uniformValues.end())
+	auto uniformValue = findUniformValue(location);
+	if (uniformValue == nullptr)
 	{
 #if V_DEBUG && V_DEBUG_LOG_CONSOLE
 		Voxel::Logger::getInstance().consoleError("[Program] Failed to find uniform vec4 location: " + std::to_string(location) + ", vec4: (" + std::to_string(val.x) + ", " + std::to_string(val.y) + ", " + std::to_string(val.z) + ", " + std::to_string(val.w) + ")");
@@ -425,17 +456,16 @@ void Voxel::Program::setUniformVec4(const GLint location, const glm::vec4 & val)
 	}
 	else
 	{
-		auto& uniformValue = find_it->second;
-		if (uniformValue.type == GL_FLOAT_VEC4)
+		if (uniformValue->type == GL_FLOAT_VEC4)
 		{
-			glm::vec4 v4 = glm::make_vec4(uniformValue.value.v4Value);
+			glm::vec4 v4 = glm::make_vec4(uniformValue->value.v4Value);
 			if (v4 != val)
 			{
 				glUniform4f(location, val.x, val.y, val.z, val.w);
-				uniformValue.value.v4Value[0] = val.x;
-				uniformValue.value.v4Value[1] = val.y;
-				uniformValue.value.v4Value[2] = val.z;
-				uniformValue.value.v4Value[3] = val.w;
+				uniformValue->value.v4Value[0] = val.x;
+				uniformValue->value.v4Value[1] = val.y;
+				uniformValue->value.v4Value[2] = val.z;
+				uniformValue->value.v4Value[3] = val.w;
 			}
 			else
 			{
@@ -449,7 +479,7 @@ void Voxel::Program::setUniformVec4(const GLint location, const glm::vec4 & val)
 	}
 }
 
-void Voxel::Program::setUniformVec4(const std::string & name, const glm::vec4 & val)
+void Voxel::Program::setUniformVec4(const StringID name, const glm::vec4 & val)
 {
 	auto find_it = uniformLocations.find(name);
 	if (find_it == uniformLocations.end())
@@ -464,8 +494,8 @@ void Voxel::Program::setUniformVec4(const std::string & name, const glm::vec4 &
 
 void Program::setUniformMat4(const GLint location, const mat4 & mat)
 {
-	auto find_it = uniformValues.find(location);
-	if (find_it == uniformValues.end())
+	auto uniformValue = findUniformValue(location);
+	if (uniformValue == nullptr)
 	{
 #if V_DEBUG && V_DEBUG_LOG_CONSOLE
 		Voxel::Logger::getInstance().consoleError("[Program] Failed to find uniform mat4 location: " + std::to_string(location));
@@ -474,16 +504,15 @@ void Program::setUniformMat4(const GLint location, const mat4 & mat)
 	}
 	else
 	{
-		auto& uniformValue = find_it->second;
-		if (uniformValue.type == GL_FLOAT_MAT4)
+		if (uniformValue->type == GL_FLOAT_MAT4)
 		{
-			glm::mat4 mat4 = glm::make_mat4(uniformValue.value.mat4Value);
+			glm::mat4 mat4 = glm::make_mat4(uniformValue->value.mat4Value);
 
 			if (mat4 != mat)
 			{
 				glUniformMatrix4fv(location, 1, GL_FALSE, value_ptr(mat));
 
-				memcpy(uniformValue.value.mat4Value, glm::value_ptr(mat), sizeof(float) * 16);
+				memcpy(uniformValue->value.mat4Value, glm::value_ptr(mat), sizeof(float) * 16);
 			}
 			else
 			{
@@ -497,7 +526,7 @@ void Program::setUniformMat4(const GLint location, const mat4 & mat)
 	}
 }
 
-void Program::setUniformMat4(const std::string & name, const mat4 & mat)
+void Program::setUniformMat4(const StringID name, const mat4 & mat)
 {
 	auto find_it = uniformLocations.find(name);
 	if (find_it == uniformLocations.end())
@@ -8,6 +8,10 @@
 // cpp
 #include <string>
 #include <unordered_map>
+#include <vector>
+
+// voxel
+#include "StringID.h"
 
 using namespace glm;
 
@@ -50,10 +54,13 @@ namespace Voxel
 		static GLuint lastProgramObject;
 
 		// Uniform location by name
-		std::unordered_map<std::string, GLint> uniformLocations;
+		std::unordered_map<StringID, GLint> uniformLocations;
+
+		// Uniform values indexed by location. Type is GL_ZERO if location isn't active uniform.
+		std::vector<UniformValue> uniformValues;
 
-		// Uniform locations by location id
-		std::unordered_map<GLint, UniformValue> uniformValues;
+		// Get uniform value of location. nullptr if location isn't active uniform.
+		UniformValue* findUniformValue(const GLint location);
 
 		// Initialize program
 		bool init(Shader* vertexShader, Shader* fragmentShader);
@@ -83,26 +90,34 @@ namespace Voxel
 		GLint getAttribLocation(const GLchar* attributeName);
 		GLint getUniformLocation(const GLchar* uniformName);
 
+		/**
+		*	Find location of active uniform without querying OpenGL.
+		*	Cache location for uniform that is set many times in frame (e.g. modelMat per chunk) and set it by location.
+		*	@param name Uniform name. Use SID().
+		*	@return Location of uniform. -1 if program doesn't have uniform.
+		*/
+		GLint findUniformLocation(const StringID name) const;
+
 		void setUniformBool(const GLint location, const bool boolean);
-		void setUniformBool(const std::string& name, const bool boolean);
+		void setUniformBool(const StringID name, const bool boolean);
 
 		void setUniformInt(const GLint location, const int integer);
-		void setUniformInt(const std::string& name, const int integer);
+		void setUniformInt(const StringID name, const int integer);
 
 		void setUniformFloat(const GLint location, const float val);
-		void setUniformFloat(const std::string& name, const float val);
+		void setUniformFloat(const StringID name, const float val);
 
 		void setUniformVec2(const GLint location, const glm::vec2& val);
-		void setUniformVec2(const std::string& name, const glm::vec2& val);
+		void setUniformVec2(const StringID name, const glm::vec2& val);
 
 		void setUniformVec3(const GLint location, const glm::vec3& val);
-		void setUniformVec3(const std::string& name, const glm::vec3& val);
+		void setUniformVec3(const StringID name, const glm::vec3& val);
 
 		void setUniformVec4(const GLint location, const glm::vec4& val);
-		void setUniformVec4(const std::string& name, const glm::vec4& val);
+		void setUniformVec4(const StringID name, const glm::vec4& val);
 
 		void setUniformMat4(const GLint location, const mat4& mat);
-		void setUniformMat4(const std::string& name, const mat4& mat);
+		void setUniformMat4(const StringID name, const mat4& mat);
 
 		void use(const bool use);
 	};
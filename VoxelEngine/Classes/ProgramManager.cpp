@@ -62,6 +62,22 @@ void Voxel::ProgramManager::initPrograms()
 	auto voxelShaderParticleSystemFrag = shaderManager.createShader("voxelShaderParticleSystem", "shaders/voxelShaderParticleSystem.frag", Voxel::Shader::Type::FRAGMENT);
 	auto voxelShaderParticleSystemProgram = Program::create(voxelShaderParticleSystemVert, voxelShaderParticleSystemFrag);
 	programs.emplace(PROGRAM_NAME::UI_PARTICLE_SYSTEM_SHADER, voxelShaderParticleSystemProgram);
+
+	auto voxelShaderBatchVert = shaderManager.createShader("voxelShaderUIBatch", "shaders/voxelShaderUIBatch.vert", Voxel::Shader::Type::VERTEX);
+	auto voxelShaderBatchFrag = shaderManager.createShader("voxelShaderUIBatch", "shaders/voxelShaderUIBatch.frag", Voxel::Shader::Type::FRAGMENT);
+	auto voxelShaderBatchProgram = Program::create(voxelShaderBatchVert, voxelShaderBatchFrag);
+	programs.emplace(PROGRAM_NAME::UI_BATCH_SHADER, voxelShaderBatchProgram);
+
+	// Batched text. Vertices are already in canvas space, so uses batch vertex shader with text fragment shader.
+	auto voxelShaderTextBatchVert = shaderManager.createShader("voxelShaderUITextBatch", "shaders/voxelShaderUIBatch.vert", Voxel::Shader::Type::VERTEX);
+	auto voxelShaderTextBatchFrag = shaderManager.createShader("voxelShaderUITextBatch", "shaders/voxelShaderUIText.frag", Voxel::Shader::Type::FRAGMENT);
+	auto voxelShaderTextBatchProgram = Program::create(voxelShaderTextBatchVert, voxelShaderTextBatchFrag);
+	programs.emplace(PROGRAM_NAME::UI_TEXT_BATCH_SHADER, voxelShaderTextBatchProgram);
+
+	auto voxelShaderWorldParticleVert = shaderManager.createShader("voxelShaderWorldParticle", "shaders/voxelShaderWorldParticle.vert", Voxel::Shader::Type::VERTEX);
+	auto voxelShaderWorldParticleFrag = shaderManager.createShader("voxelShaderWorldParticle", "shaders/voxelShaderWorldParticle.frag", Voxel::Shader::Type::FRAGMENT);
+	auto voxelShaderWorldParticleProgram = Program::create(voxelShaderWorldParticleVert, voxelShaderWorldParticleFrag);
+	programs.emplace(PROGRAM_NAME::WORLD_PARTICLE_SHADER, voxelShaderWorldParticleProgram);
 	
 	// Don't need shader anymore if it's attached to program
 	shaderManager.releaseAll();
@@ -82,31 +98,40 @@ Program * Voxel::ProgramManager::getProgram(const PROGRAM_NAME programID)
 void Voxel::ProgramManager::updateProjMat(const glm::mat4 & projMat)
 {
 	programs.at(PROGRAM_NAME::LINE_SHADER)->use(true);
-	programs.at(PROGRAM_NAME::LINE_SHADER)->setUniformMat4("projMat", projMat);
+	programs.at(PROGRAM_NAME::LINE_SHADER)->setUniformMat4(SID("projMat"), projMat);
 
 	programs.at(PROGRAM_NAME::BLOCK_SHADER)->use(true);
-	programs.at(PROGRAM_NAME::BLOCK_SHADER)->setUniformMat4("projMat", projMat);
+	programs.at(PROGRAM_NAME::BLOCK_SHADER)->setUniformMat4(SID("projMat"), projMat);
 
 	programs.at(PROGRAM_NAME::POLYGON_SHADER)->use(true);
-	programs.at(PROGRAM_NAME::POLYGON_SHADER)->setUniformMat4("projMat", projMat);
+	programs.at(PROGRAM_NAME::POLYGON_SHADER)->setUniformMat4(SID("projMat"), projMat);
 
 	programs.at(PROGRAM_NAME::POLYGON_SIDE_SHADER)->use(true);
-	programs.at(PROGRAM_NAME::POLYGON_SIDE_SHADER)->setUniformMat4("projMat", projMat);
+	programs.at(PROGRAM_NAME::POLYGON_SIDE_SHADER)->setUniformMat4(SID("projMat"), projMat);
+
+	programs.at(PROGRAM_NAME::WORLD_PARTICLE_SHADER)->use(true);
+	programs.at(PROGRAM_NAME::WORLD_PARTICLE_SHADER)->setUniformMat4(SID("projMat"), projMat);
 }
 
 void Voxel::ProgramManager::updateUIProjMat(const glm::mat4 & uiProjMat)
 {
 	programs.at(PROGRAM_NAME::UI_TEXTURE_SHADER)->use(true);
-	programs.at(PROGRAM_NAME::UI_TEXTURE_SHADER)->setUniformMat4("projMat", uiProjMat);
+	programs.at(PROGRAM_NAME::UI_TEXTURE_SHADER)->setUniformMat4(SID("projMat"), uiProjMat);
 
 	programs.at(PROGRAM_NAME::UI_TEXT_SHADER)->use(true);
-	programs.at(PROGRAM_NAME::UI_TEXT_SHADER)->setUniformMat4("projMat", uiProjMat);
+	programs.at(PROGRAM_NAME::UI_TEXT_SHADER)->setUniformMat4(SID("projMat"), uiProjMat);
 
 	programs.at(PROGRAM_NAME::UI_COLOR_PICKER_SHADER)->use(true);
-	programs.at(PROGRAM_NAME::UI_COLOR_PICKER_SHADER)->setUniformMat4("projMat", uiProjMat);
+	programs.at(PROGRAM_NAME::UI_COLOR_PICKER_SHADER)->setUniformMat4(SID("projMat"), uiProjMat);
 
 	programs.at(PROGRAM_NAME::UI_PARTICLE_SYSTEM_SHADER)->use(true);
-	programs.at(PROGRAM_NAME::UI_PARTICLE_SYSTEM_SHADER)->setUniformMat4("projMat", uiProjMat);
+	programs.at(PROGRAM_NAME::UI_PARTICLE_SYSTEM_SHADER)->setUniformMat4(SID("projMat"), uiProjMat);
+
+	programs.at(PROGRAM_NAME::UI_BATCH_SHADER)->use(true);
+	programs.at(PROGRAM_NAME::UI_BATCH_SHADER)->setUniformMat4(SID("projMat"), uiProjMat);
+
+	programs.at(PROGRAM_NAME::UI_TEXT_BATCH_SHADER)->use(true);
+	programs.at(PROGRAM_NAME::UI_TEXT_BATCH_SHADER)->setUniformMat4(SID("projMat"), uiProjMat);
 }
 
 void ProgramManager::releaseAll()
@@ -33,6 +33,9 @@ namespace Voxel
 			UI_TEXT_SHADER,
 			UI_COLOR_PICKER_SHADER,
 			UI_PARTICLE_SYSTEM_SHADER,
+			UI_BATCH_SHADER,
+			UI_TEXT_BATCH_SHADER,
+			WORLD_PARTICLE_SHADER,
 			SHADER_MAX_COUNT
 		};
 	private:
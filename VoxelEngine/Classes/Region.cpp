@@ -13,6 +13,16 @@ using namespace Voxel;
 
 Voxel::Region::Region(Voronoi::Cell * cell)
 	: cell(cell)
+	, id(cell->getID())
+	, difficulty(-1)
+	, randColor(Color::getRandomColor255())
+{
+	initBoundingBox();
+}
+
+Voxel::Region::Region(Voronoi::Cell * cell, const unsigned int id)
+	: cell(cell)
+	, id(id)
 	, difficulty(-1)
 	, randColor(Color::getRandomColor255())
 {
@@ -27,7 +37,7 @@ void Voxel::Region::initBoundingBox()
 {
 	if (cell->isValid())
 	{
-		auto& edges = cell->getEdges();
+		auto edges = cell->getEdges();
 		auto id = cell->getID();
 
 		float minX = std::numeric_limits<float>::max();
@@ -38,9 +48,9 @@ void Voxel::Region::initBoundingBox()
 		float minZ = minX;
 		float maxZ = maxX;
 
-		for (auto e : edges)
+		for (auto& e : edges)
 		{
-			glm::vec2 e0 = e->getStart() + shift;
+			glm::vec2 e0 = e.getStart() + shift;
 
 			if (e0.x < minX)
 			{
@@ -128,7 +138,7 @@ glm::vec2 Voxel::Region::getSitePosition()
 void Voxel::Region::setAsStartingRegion()
 {
 	difficulty = 0;
-	std::cout << "Setting region #" << cell->getID() << " to starting region.\n";
+	std::cout << "Setting region #" << id << " to starting region.\n";
 }
 
 void Voxel::Region::initBiomeType(const float minT, const float maxT, const float minM, const float maxM, std::mt19937& engine)
@@ -179,12 +189,12 @@ Terrain Voxel::Region::getTerrainType()
 
 bool Voxel::Region::isPointIsInRegion(const glm::vec2 & point, Voronoi::Cell * cell)
 {
-	auto& edges = cell->getEdges();
+	auto edges = cell->getEdges();
 
 	std::vector<glm::vec2> vertices;
-	for (auto e : edges)
+	for (auto& e : edges)
 	{
-		vertices.push_back(e->getStart());
+		vertices.push_back(e.getStart());
 	}
 
 	int nvert = static_cast<int>(vertices.size());
@@ -210,9 +220,10 @@ bool Voxel::Region::isPointIsInRegionNeighbor(const glm::vec2 & point, unsigned
 	auto& nc = cell->getNeighbors();
 	for (auto neighbor : nc)
 	{
-		if (isPointIsInRegion(point, neighbor))
+		// Neighbor cell may not have region if it's in margin of tile (RegionTileMap)
+		if (neighbor->getRegion() && isPointIsInRegion(point, neighbor))
 		{
-			neighborID = neighbor->getID();
+			neighborID = neighbor->getRegion()->getID();
 			return true;
 		}
 		else
@@ -236,7 +247,10 @@ std::vector<unsigned int> Voxel::Region::getNeighborRegionIDList()
 
 	for (auto nc : nCells)
 	{
-		ids.push_back(nc->getRegion()->getID());
+		if (nc->getRegion())
+		{
+			ids.push_back(nc->getRegion()->getID());
+		}
 	}
 
 	return ids;
@@ -244,19 +258,19 @@ std::vector<unsigned int> Voxel::Region::getNeighborRegionIDList()
 
 void Voxel::Region::getVoronoiEdgePoints(std::vector<glm::vec2>& edgePoints)
 {
-	auto& edges = cell->getEdges();
+	auto edges = cell->getEdges();
 
 	edgePoints.clear();
 
 	for (auto& edge : edges)
 	{
-		edgePoints.push_back(edge->getStart());
+		edgePoints.push_back(edge.getStart());
 	}
 }
 
 unsigned int Voxel::Region::getID()
 {
-	return cell->getID();
+	return id;
 }
 
 bool Voxel::Region::isBorder()
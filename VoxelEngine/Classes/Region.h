@@ -28,6 +28,9 @@ namespace Voxel
 		// Cell data
 		Voronoi::Cell* cell;
 
+		// Region ID. Same as cell ID unless given.
+		unsigned int id;
+
 		// The difficulty of region.
 		int difficulty;
 
@@ -50,6 +53,7 @@ namespace Voxel
 	public:
 		Region() = delete;
 		Region(Voronoi::Cell* cell);
+		Region(Voronoi::Cell* cell, const unsigned int id);
 		~Region();
 
 		// For debug. region random color
@@ -84,7 +88,7 @@ namespace Voxel
 
 		void getVoronoiEdgePoints(std::vector<glm::vec2>& edgePoints);
 
-		// Get cell id
+		// Get region id
 		unsigned int getID();
 
 		bool isBorder();
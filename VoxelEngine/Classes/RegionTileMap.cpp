@@ -0,0 +1,318 @@
+// pch
+#include "PreCompiled.h"
+
+#include "RegionTileMap.h"
+
+// cpp
+#include <random>
+
+// voxel
+#include "Region.h"
+#include "SimplexNoise.h"
+
+using namespace Voxel;
+
+const int Voxel::RegionTileMap::SITE_INTERVAL = 1000;
+const int Voxel::RegionTileMap::TILE_SITE_COUNT = 8;
+const int Voxel::RegionTileMap::TILE_MARGIN = 2;
+const unsigned int Voxel::RegionTileMap::DEFAULT_CAPACITY = 16;
+const float Voxel::RegionTileMap::DIFFICULTY_DISTANCE = 1000.0f;
+const int Voxel::RegionTileMap::MAX_DIFFICULTY = 5;
+const float Voxel::RegionTileMap::WARP_FREQUENCY = 0.0025f;
+const float Voxel::RegionTileMap::WARP_AMPLITUDE = 100.0f;
+
+Voxel::RegionTileMap::Tile::Tile(const glm::ivec2 & coordinate)
+	: coordinate(coordinate)
+	, firstSiteCoordinate((coordinate * TILE_SITE_COUNT) - TILE_MARGIN)
+{}
+
+Voxel::RegionTileMap::Tile::~Tile()
+{
+	regions.clear();
+}
+
+glm::ivec2 Voxel::RegionTileMap::Tile::getCoordinate() const
+{
+	return coordinate;
+}
+
+Region * Voxel::RegionTileMap::Tile::getRegion(const glm::ivec2 & siteCoordinate) const
+{
+	const glm::ivec2 local = siteCoordinate - (coordinate * TILE_SITE_COUNT);
+
+	if (local.x < 0 || local.y < 0 || local.x >= TILE_SITE_COUNT || local.y >= TILE_SITE_COUNT)
+	{
+		return nullptr;
+	}
+
+	return regions.at((local.x * TILE_SITE_COUNT) + local.y).get();
+}
+
+glm::vec2 Voxel::RegionTileMap::Tile::getSitePosition(const glm::ivec2 & siteCoordinate) const
+{
+	const int extendedCount = TILE_SITE_COUNT + (TILE_MARGIN * 2);
+	const glm::ivec2 local = siteCoordinate - firstSiteCoordinate;
+
+	assert(local.x >= 0 && local.y >= 0 && local.x < extendedCount && local.y < extendedCount);
+
+	return sitePositions.at((local.x * extendedCount) + local.y);
+}
+
+Voxel::RegionTileMap::RegionTileMap(const std::string & seed, const float minTemperature, const float maxTemperature, const float minMoisture, const float maxMoisture, const unsigned int capacity)
+	: seed(seed)
+	, seedHash(static_cast<unsigned long long>(std::hash<std::string>{}(seed)))
+	, minTemperature(minTemperature)
+	, maxTemperature(maxTemperature)
+	, minMoisture(minMoisture)
+	, maxMoisture(maxMoisture)
+	, capacity(std::max(1u, capacity))
+	, builtTileCount(0)
+{}
+
+std::shared_ptr<RegionTileMap::Tile> Voxel::RegionTileMap::buildTile(const glm::ivec2 & coordinate) const
+{
+	auto tile = std::make_shared<Tile>(coordinate);
+
+	const int extendedCount = TILE_SITE_COUNT + (TILE_MARGIN * 2);
+
+	// Sites of tile and margin. Cell ID is index of site.
+	std::vector<Voronoi::Site> sites;
+	sites.reserve(extendedCount * extendedCount);
+	tile->sitePositions.reserve(extendedCount * extendedCount);
+
+	for (int x = 0; x < extendedCount; x++)
+	{
+		for (int z = 0; z < extendedCount; z++)
+		{
+			const glm::vec2 position = generateSitePosition(tile->firstSiteCoordinate + glm::ivec2(x, z));
+
+			tile->sitePositions.push_back(position);
+			sites.push_back(Voronoi::Site(position, Voronoi::Site::Type::MARKED));
+		}
+	}
+
+	// Bound is only used to clip infinite edges of outer margin cells.
+	const glm::ivec2 farCorner = glm::abs(tile->firstSiteCoordinate) + extendedCount;
+	const float bound = static_cast<float>((glm::max(farCorner.x, farCorner.y) + 1) * SITE_INTERVAL);
+
+	tile->diagram.construct(sites, -bound, bound);
+	tile->diagram.buildGraph();
+
+	auto& cells = tile->diagram.getCells();
+
+	const unsigned int startingRegionID = getStartingRegionID();
+	const glm::vec2 startingSitePosition = generateSitePosition(glm::ivec2(0));
+
+	tile->regions.reserve(TILE_SITE_COUNT * TILE_SITE_COUNT);
+
+	for (int x = 0; x < TILE_SITE_COUNT; x++)
+	{
+		for (int z = 0; z < TILE_SITE_COUNT; z++)
+		{
+			const glm::ivec2 siteCoordinate = (coordinate * TILE_SITE_COUNT) + glm::ivec2(x, z);
+			const unsigned int regionID = toRegionID(siteCoordinate);
+
+			auto cell = &cells.at(((x + TILE_MARGIN) * extendedCount) + (z + TILE_MARGIN));
+
+			// Margin is wide enough that all cells of tile are closed
+			assert(cell->isValid());
+
+			Region* newRegion = new Region(cell, regionID);
+			cell->setRegion(newRegion);
+			newRegion->setSeed(seed);
+
+			// Same as World::initRegionBiomeAndTerrain
+			std::mt19937 engine(std::hash<std::string>{}(newRegion->getSeed()));
+
+			newRegion->initBiomeType(minTemperature, maxTemperature, minMoisture, maxMoisture, engine);
+			newRegion->initTerrainType(engine);
+
+			if (regionID == startingRegionID)
+			{
+				newRegion->setAsStartingRegion();
+			}
+			else
+			{
+				// No graph to search on unbounded plane. Difficulty grows with distance from starting site.
+				const float distance = glm::distance(cell->getSitePosition(), startingSitePosition);
+				newRegion->setDifficulty(glm::min(MAX_DIFFICULTY, static_cast<int>(glm::round(distance / DIFFICULTY_DISTANCE))));
+			}
+
+			tile->regions.push_back(std::unique_ptr<Region>(newRegion));
+		}
+	}
+
+	return tile;
+}
+
+glm::vec2 Voxel::RegionTileMap::generateSitePosition(const glm::ivec2 & siteCoordinate) const
+{
+	// splitmix64 of seed and grid coordinate
+	unsigned long long hash = seedHash ^ ((static_cast<unsigned long long>(static_cast<unsigned int>(siteCoordinate.x)) << 32) | static_cast<unsigned long long>(static_cast<unsigned int>(siteCoordinate.y)));
+
+	hash += 0x9E3779B97F4A7C15ull;
+	hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+	hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+	hash = hash ^ (hash >> 31);
+
+	// Same padding as World's bounded layout
+	const int pad = SITE_INTERVAL / 10;
+	const int randMax = (SITE_INTERVAL - (pad * 2)) / 2;
+	const unsigned long long range = static_cast<unsigned long long>((randMax * 2) + 1);
+
+	const int randX = static_cast<int>((hash & 0xFFFFFFFFull) % range) - randMax;
+	const int randZ = static_cast<int>((hash >> 32) % range) - randMax;
+
+	// Boost voronoi takes integer sites
+	return glm::vec2((siteCoordinate * SITE_INTERVAL) + (SITE_INTERVAL / 2) + glm::ivec2(randX, randZ));
+}
+
+glm::vec2 Voxel::RegionTileMap::warpPoint(const glm::vec2 & point) const
+{
+	auto noise = Noise::Manager::getWorldNoise();
+
+	const glm::vec2 p = point * WARP_FREQUENCY;
+
+	// Offset second sample so x and z are not same
+	return point + (glm::vec2(noise->noise(p), noise->noise(p + glm::vec2(57.3f, -31.9f))) * WARP_AMPLITUDE);
+}
+
+unsigned long long Voxel::RegionTileMap::toTileKey(const glm::ivec2 & coordinate)
+{
+	return (static_cast<unsigned long long>(static_cast<unsigned int>(coordinate.x)) << 32) | static_cast<unsigned long long>(static_cast<unsigned int>(coordinate.y));
+}
+
+int Voxel::RegionTileMap::floorDiv(const int value, const int divisor)
+{
+	return (value >= 0) ? (value / divisor) : (((value + 1) / divisor) - 1);
+}
+
+std::shared_ptr<RegionTileMap::Tile> Voxel::RegionTileMap::getTile(const glm::ivec2 & coordinate)
+{
+	const unsigned long long key = toTileKey(coordinate);
+
+	{
+		std::unique_lock<std::mutex> lock(tileMutex);
+
+		auto find_it = tileMap.find(key);
+		if (find_it != tileMap.end())
+		{
+			// Move to front
+			tiles.splice(tiles.begin(), tiles, find_it->second);
+			return tiles.front();
+		}
+	}
+
+	// Build without lock so other workers can use cached tiles meanwhile
+	auto tile = buildTile(coordinate);
+
+	std::unique_lock<std::mutex> lock(tileMutex);
+
+	auto find_it = tileMap.find(key);
+	if (find_it != tileMap.end())
+	{
+		// Other worker built same tile first. Use that one.
+		tiles.splice(tiles.begin(), tiles, find_it->second);
+		return tiles.front();
+	}
+
+	tiles.push_front(tile);
+	tileMap.emplace(key, tiles.begin());
+	builtTileCount++;
+
+	// Evict least recently used. Tile is released when last holder releases it.
+	while (tiles.size() > capacity)
+	{
+		tileMap.erase(toTileKey(tiles.back()->getCoordinate()));
+		tiles.pop_back();
+	}
+
+	return tile;
+}
+
+std::shared_ptr<RegionTileMap::Tile> Voxel::RegionTileMap::getTileOfRegion(const unsigned int regionID)
+{
+	return getTile(toTileCoordinate(toSiteCoordinate(regionID)));
+}
+
+unsigned int Voxel::RegionTileMap::findRegionIDAtPoint(const glm::vec2 & point)
+{
+	const glm::vec2 warped = warpPoint(point);
+	const glm::ivec2 gridCoordinate = glm::ivec2(glm::floor(warped / static_cast<float>(SITE_INTERVAL)));
+
+	auto tile = getTile(toTileCoordinate(gridCoordinate));
+
+	// Site can move up to 40% of interval from center of grid cell, so closest site is always in 5 x 5 grid cells around point.
+	// Tile's margin covers them.
+	float minDist = std::numeric_limits<float>::max();
+	glm::ivec2 closest = gridCoordinate;
+
+	for (int x = -2; x <= 2; x++)
+	{
+		for (int z = -2; z <= 2; z++)
+		{
+			const glm::ivec2 siteCoordinate = gridCoordinate + glm::ivec2(x, z);
+			const glm::vec2 d = tile->getSitePosition(siteCoordinate) - warped;
+			const float dist = glm::dot(d, d);
+
+			if (dist < minDist)
+			{
+				minDist = dist;
+				closest = siteCoordinate;
+			}
+		}
+	}
+
+	return toRegionID(closest);
+}
+
+unsigned int Voxel::RegionTileMap::getStartingRegionID() const
+{
+	return toRegionID(glm::ivec2(0));
+}
+
+void Voxel::RegionTileMap::clear()
+{
+	std::unique_lock<std::mutex> lock(tileMutex);
+
+	tileMap.clear();
+	tiles.clear();
+}
+
+unsigned int Voxel::RegionTileMap::getTileCount()
+{
+	std::unique_lock<std::mutex> lock(tileMutex);
+
+	return static_cast<unsigned int>(tiles.size());
+}
+
+unsigned int Voxel::RegionTileMap::getBuiltTileCount()
+{
+	std::unique_lock<std::mutex> lock(tileMutex);
+
+	return builtTileCount;
+}
+
+unsigned int Voxel::RegionTileMap::getCapacity() const
+{
+	return capacity;
+}
+
+unsigned int Voxel::RegionTileMap::toRegionID(const glm::ivec2 & siteCoordinate)
+{
+	// 0xFFFFFFFF is invalid region ID. (32767, 32767) is not allowed.
+	assert(siteCoordinate.x >= -32768 && siteCoordinate.x <= 32766);
+	assert(siteCoordinate.y >= -32768 && siteCoordinate.y <= 32766);
+
+	return (static_cast<unsigned int>(siteCoordinate.x + 32768) << 16) | static_cast<unsigned int>(siteCoordinate.y + 32768);
+}
+
+glm::ivec2 Voxel::RegionTileMap::toSiteCoordinate(const unsigned int regionID)
+{
+	return glm::ivec2(static_cast<int>(regionID >> 16) - 32768, static_cast<int>(regionID & 0xFFFF) - 32768);
+}
+
+glm::ivec2 Voxel::RegionTileMap::toTileCoordinate(const glm::ivec2 & siteCoordinate)
+{
+	return glm::ivec2(floorDiv(siteCoordinate.x, TILE_SITE_COUNT), floorDiv(siteCoordinate.y, TILE_SITE_COUNT));
+}
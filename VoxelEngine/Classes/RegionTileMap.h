@@ -0,0 +1,206 @@
+#ifndef REGION_TILE_MAP_H
+#define REGION_TILE_MAP_H
+
+// cpp
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// glm
+#include <glm\glm.hpp>
+
+// voxel
+#include "Voronoi.h"
+
+namespace Voxel
+{
+	// foward declaration
+	class Region;
+
+	/**
+	*	@class RegionTileMap
+	*	@brief Region layout on unbounded plane. Generates voronoi cells per tile on demand and keeps recently used tiles in LRU cache.
+	*
+	*	Plane is divided in to grid with one site per grid cell. Site position is hash of world seed and grid coordinate,
+	*	so every tile can generate its sites and its neighbor's sites without knowing any other tile.
+	*	Tile is TILE_SITE_COUNT x TILE_SITE_COUNT sites. Voronoi diagram of tile is built from tile's sites and TILE_MARGIN rings of
+	*	neighbor sites, which is enough for cells of tile's own sites to be exact. Only those cells become regions.
+	*
+	*	Region ID is packed grid coordinate of site, so any chunk worker can find region of any block without shared state.
+	*	Memory and cost of tile doesn't depend on how far it is from origin. Cache is shared by all chunk workers.
+	*	Region pointer is valid while caller holds its tile. Keep capacity larger than number of tiles that can be used at the same time.
+	*
+	*	Unlike World's bounded layout, there are no border cells and shared edges are not made noisy because noise has to match
+	*	between tiles. Instead, query point is warped with simplex noise before finding closest site.
+	*/
+	class RegionTileMap
+	{
+	public:
+		// Distance between sites in grid. Same as World's bounded layout.
+		static const int SITE_INTERVAL;
+
+		// Number of sites in x and z of tile
+		static const int TILE_SITE_COUNT;
+
+		// Number of neighbor site rings included in tile's voronoi diagram
+		static const int TILE_MARGIN;
+
+		// Default number of tiles in cache
+		static const unsigned int DEFAULT_CAPACITY;
+
+		// Distance from starting site for each difficulty level
+		static const float DIFFICULTY_DISTANCE;
+
+		// Max difficulty. Same as World's bounded layout.
+		static const int MAX_DIFFICULTY;
+
+		/**
+		*	@class Tile
+		*	@brief Voronoi diagram and regions of single tile. Immutable after build.
+		*/
+		class Tile
+		{
+			friend class RegionTileMap;
+		private:
+			// Tile coordinate
+			glm::ivec2 coordinate;
+
+			// Grid coordinate of first site including margin
+			glm::ivec2 firstSiteCoordinate;
+
+			// Diagram of tile's sites and margin sites
+			Voronoi::Diagram diagram;
+
+			// Site positions including margin. [x][z] order.
+			std::vector<glm::vec2> sitePositions;
+
+			// Regions of tile's sites. [x][z] order.
+			std::vector<std::unique_ptr<Region>> regions;
+		public:
+			Tile(const glm::ivec2& coordinate);
+			~Tile();
+
+			// Delete copy and move
+			Tile(Tile const&) = delete;
+			Tile& operator=(Tile const&) = delete;
+
+			// Get tile coordinate
+			glm::ivec2 getCoordinate() const;
+
+			// Get region of site. nullptr if site is not in tile.
+			Region* getRegion(const glm::ivec2& siteCoordinate) const;
+
+			// Get position of site. Site must be in tile or margin.
+			glm::vec2 getSitePosition(const glm::ivec2& siteCoordinate) const;
+		};
+	private:
+		// Seed of world
+		std::string seed;
+		unsigned long long seedHash;
+
+		// Frequency and amplitude of noise that warps query point
+		static const float WARP_FREQUENCY;
+		static const float WARP_AMPLITUDE;
+
+		// Biome theme
+		float minTemperature;
+		float maxTemperature;
+		float minMoisture;
+		float maxMoisture;
+
+		// Max number of tiles in cache
+		unsigned int capacity;
+
+		// Most recently used tile is at front
+		std::list<std::shared_ptr<Tile>> tiles;
+
+		// Tile coordinate key to tile in list
+		std::unordered_map<unsigned long long, std::list<std::shared_ptr<Tile>>::iterator> tileMap;
+
+		// Guards tiles and tileMap. Tiles are built without lock.
+		std::mutex tileMutex;
+
+		// Number of tiles built. For debug.
+		unsigned int builtTileCount;
+
+		// Build voronoi diagram and regions of tile
+		std::shared_ptr<Tile> buildTile(const glm::ivec2& coordinate) const;
+
+		// Get position of site from seed
+		glm::vec2 generateSitePosition(const glm::ivec2& siteCoordinate) const;
+
+		// Warps point with noise so region border isn't straight line
+		glm::vec2 warpPoint(const glm::vec2& point) const;
+
+		// Convert tile coordinate to cache key
+		static unsigned long long toTileKey(const glm::ivec2& coordinate);
+
+		// Floor division for negative coordinates
+		static int floorDiv(const int value, const int divisor);
+	public:
+		/**
+		*	Constructor
+		*	@param seed World seed.
+		*	@param minTemperature Min temperature of biome theme.
+		*	@param maxTemperature Max temperature of biome theme.
+		*	@param minMoisture Min moisture of biome theme.
+		*	@param maxMoisture Max moisture of biome theme.
+		*	@param capacity Max number of tiles in cache.
+		*/
+		RegionTileMap(const std::string& seed, const float minTemperature, const float maxTemperature, const float minMoisture, const float maxMoisture, const unsigned int capacity = DEFAULT_CAPACITY);
+
+		// Destructor
+		~RegionTileMap() = default;
+
+		// Delete copy and move
+		RegionTileMap(RegionTileMap const&) = delete;
+		RegionTileMap& operator=(RegionTileMap const&) = delete;
+
+		/**
+		*	Get tile from cache. Builds tile if it's not in cache and evicts least recently used tile if cache is full.
+		*	Thread safe.
+		*	@param coordinate Tile coordinate.
+		*	@return Tile. Stays valid while caller holds it even if tile is evicted.
+		*/
+		std::shared_ptr<Tile> getTile(const glm::ivec2& coordinate);
+
+		// Get tile that has region. Thread safe. Hold tile while using its region, because tile can be evicted by other threads.
+		std::shared_ptr<Tile> getTileOfRegion(const unsigned int regionID);
+
+		/**
+		*	Find region that point is in. Thread safe.
+		*	@param point World position in x and z.
+		*	@return ID of region.
+		*/
+		unsigned int findRegionIDAtPoint(const glm::vec2& point);
+
+		// Get region that game starts. Region of site at grid (0, 0).
+		unsigned int getStartingRegionID() const;
+
+		// Removes all tiles from cache
+		void clear();
+
+		// Get number of tiles in cache
+		unsigned int getTileCount();
+
+		// Get number of tiles built since construction
+		unsigned int getBuiltTileCount();
+
+		// Get max number of tiles in cache
+		unsigned int getCapacity() const;
+
+		// Convert site's grid coordinate to region ID. Grid coordinate must be in [-32768, 32766].
+		static unsigned int toRegionID(const glm::ivec2& siteCoordinate);
+
+		// Convert region ID to site's grid coordinate
+		static glm::ivec2 toSiteCoordinate(const unsigned int regionID);
+
+		// Get tile coordinate that has site
+		static glm::ivec2 toTileCoordinate(const glm::ivec2& siteCoordinate);
+	};
+}
+
+#endif
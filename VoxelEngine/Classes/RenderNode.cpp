@@ -3,6 +3,9 @@
 
 #include "RenderNode.h"
 
+// voxel
+#include "BatchRenderer.h"
+
 Voxel::UI::RenderNode::RenderNode(const std::string & name)
 	: TransformNode(name)
 	, program(nullptr)
@@ -77,4 +80,41 @@ void Voxel::UI::RenderNode::render()
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+
+bool Voxel::UI::RenderNode::appendBatch(BatchRenderer & batchRenderer)
+{
+	if (texture == nullptr || batchIndices.empty())
+	{
+		return false;
+	}
+
+	batchRenderer.appendGeometry(texture, batchVertices, batchUVs, batchIndices, 0, static_cast<unsigned int>(batchIndices.size()), glm::scale(modelMat, glm::vec3(scale, 1)), glm::vec4(color, opacity));
+
+	return true;
+}
+
+void Voxel::UI::RenderNode::buildBatch(BatchRenderer & batchRenderer)
+{
+	if (!visibility) return;
+
+	auto children_it = children.begin();
+
+	// negative ordered children
+	for (; children_it != children.end() && ((children_it)->first).getGlobalZOrder() < 0; children_it++)
+	{
+		((children_it)->second)->buildBatch(batchRenderer);
+	}
+
+	// Self
+	if (!appendBatch(batchRenderer))
+	{
+		batchRenderer.addRenderSelf(this);
+	}
+
+	// positive
+	for (; children_it != children.end(); children_it++)
+	{
+		((children_it)->second)->buildBatch(batchRenderer);
+	}
+}
@@ -37,6 +37,18 @@ namespace Voxel
 
 			// Color of object
 			glm::vec3 color;
+
+			// Copy of geometry that is loaded to vao. Empty if node can't be batched.
+			std::vector<float> batchVertices;
+			std::vector<float> batchUVs;
+			std::vector<unsigned int> batchIndices;
+
+			/**
+			*	Append geometry to batch renderer.
+			*	By default, appends all indices in batch geometry with model matrix, color and opacity.
+			*	@return true if appended. false if node can't be batched and needs to render with renderSelf().
+			*/
+			virtual bool appendBatch(BatchRenderer& batchRenderer);
 		public:
 			virtual ~RenderNode();
 
@@ -60,6 +72,11 @@ namespace Voxel
 			*	Render self and children
 			*/
 			void render() override;
+
+			/**
+			*	Add self and children to batch renderer in same order as render()
+			*/
+			void buildBatch(BatchRenderer& batchRenderer) override;
 		};
 	}
 }
@@ -1,8 +1,15 @@
 #ifndef SCENE_H
 #define SCENE_H
 
+// cpp
+#include <vector>
+#include <memory>
+
 namespace Voxel
 {
+	// foward declaration
+	class AssetHandle;
+
 	/**
 	*	@class Scene
 	*	@brief Base class for all scene.
@@ -20,6 +27,13 @@ namespace Voxel
 		// Destructor
 		virtual ~Scene() = default;
 
+		/**
+		*	Request assets that init() needs to AssetLoader. Called before init() when Director replaces scene.
+		*	Director calls init() after all handles are done, so init() finds assets in their managers.
+		*	@param handles Add handles of requested assets.
+		*/
+		virtual void preload(std::vector<std::shared_ptr<AssetHandle>>& handles) {}
+
 		// Init. Called when scene is created by Director
 		virtual void init() = 0;
 
@@ -9,11 +9,13 @@
 #include "Application.h"
 #include "Logger.h"
 #include "GLView.h"
+#include "FixedTimeStep.h"
 
 using namespace Voxel;
 
 Setting::Setting()
 	: modified(false)
+	, localizationTag(Voxel::Localization::Tag::en_US)
 	// Video setting
 	, windowMode(1)
 	, monitorIndex(0)
@@ -22,7 +24,8 @@ Setting::Setting()
 	, renderDistance(0)
 	, fieldOfView(0)
 	, blockShadeMode(0)
-	, localizationTag(Voxel::Localization::Tag::en_US)
+	, simulationTickRate(FixedTimeStep::DefaultTickRate)
+	, tiledWorld(false)
 {
 	// Initialize setting
 
@@ -78,6 +81,8 @@ Setting::Setting()
 		userSetting->setInt("videoSetting.renderDistance", renderDistance);
 		userSetting->setInt("videoSetting.fieldOfView", fieldOfView);
 		userSetting->setInt("videoSetting.blockShade", blockShadeMode);
+		userSetting->setInt("simulation.tickRate", simulationTickRate);
+		userSetting->setBool("world.tiled", tiledWorld);
 
 		// save
 		userSetting->save(userSettingFilePath);
@@ -107,6 +112,18 @@ Setting::Setting()
 	}
 
 	autoJump = userSetting->getBool("control.autoJump");
+
+	// Older setting file doesn't have tick rate. Keep default.
+	int tickRate = userSetting->getInt("simulation.tickRate");
+	if (tickRate > 0)
+	{
+		simulationTickRate = tickRate;
+	}
+
+	logger->info("[System] Simulation tick rate: " + std::to_string(simulationTickRate));
+
+	// Older setting file doesn't have it. Missing key reads false, which is bounded world.
+	tiledWorld = userSetting->getBool("world.tiled");
 }
 
 Setting::~Setting()
@@ -185,6 +202,16 @@ void Voxel::Setting::setAutoJumpMode(const bool mode)
 	autoJump = mode;
 }
 
+int Voxel::Setting::getSimulationTickRate() const
+{
+	return simulationTickRate;
+}
+
+bool Voxel::Setting::isWorldTiled() const
+{
+	return tiledWorld;
+}
+
 std::string Voxel::Setting::getString(const std::string & key)
 {
 	return userSetting->getString(key);
@@ -65,6 +65,12 @@ namespace Voxel
 		// Control
 		bool autoJump;
 
+		// Simulation
+		int simulationTickRate;			// Fixed simulation ticks per second
+
+		// World
+		bool tiledWorld;				// true = unbounded world built per tile, false = bounded 10 x 10 world
+
 		// Set localization to default (enUS)
 		void setLocalizationToDefault();
 		// Set video mode to default setting
@@ -90,6 +96,10 @@ namespace Voxel
 		bool getAutoJumpMode() const;
 		void setAutoJumpMode(const bool mode);
 
+		int getSimulationTickRate() const;
+
+		bool isWorldTiled() const;
+
 		std::string getString(const std::string& key);
 
 		Localization::Tag getLocalizationTag() const;
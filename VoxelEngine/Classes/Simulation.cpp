@@ -0,0 +1,106 @@
+// pch
+#include "PreCompiled.h"
+
+#include "Simulation.h"
+
+// voxel
+#include "Player.h"
+#include "Physics.h"
+#include "ChunkMap.h"
+#include "Calendar.h"
+#include "FrameProfiler.h"
+
+using namespace Voxel;
+
+Voxel::MovementInput::MovementInput()
+{
+	clear();
+}
+
+void Voxel::MovementInput::clear()
+{
+	forward = false;
+	backward = false;
+	left = false;
+	right = false;
+	up = false;
+	down = false;
+	jump = false;
+}
+
+Voxel::Simulation::Simulation(Player * player, Physics * physics, ChunkMap * chunkMap, Calendar * calendar)
+	: player(player)
+	, physics(physics)
+	, chunkMap(chunkMap)
+	, calendar(calendar)
+{}
+
+void Voxel::Simulation::tick(const MovementInput & input, const float delta)
+{
+	tickPlayer(player, physics, chunkMap, input, delta);
+
+	// Time in game
+	if (calendar)
+	{
+		calendar->update(delta);
+	}
+}
+
+void Voxel::Simulation::tickPlayer(Player * player, Physics * physics, ChunkMap * chunkMap, const MovementInput & input, const float delta)
+{
+	// Rendered position is interpolated from here
+	player->beginTick();
+
+	if (input.forward)
+	{
+		player->moveFoward(delta);
+	}
+	else if (input.backward)
+	{
+		player->moveBackward(delta);
+	}
+
+	if (input.left)
+	{
+		player->moveLeft(delta);
+	}
+	else if (input.right)
+	{
+		player->moveRight(delta);
+	}
+
+	if (player->isFlying())
+	{
+		if (input.up)
+		{
+			player->moveUp(delta);
+		}
+		else if (input.down)
+		{
+			player->moveDown(delta);
+		}
+
+		// Flying player doesn't fall or collide
+		return;
+	}
+
+	if (input.jump && player->isOnGround())
+	{
+		player->jump();
+		physics->applyJumpForceToPlayer(glm::vec3(0, 2.2f, 0));
+	}
+
+	V_PROFILE_ZONE("Simulation::tickPlayer");
+
+	// Update player's jump force
+	bool jumping = physics->updatePlayerJumpForce(player, delta);
+
+	if (!jumping)
+	{
+		// Only apply when player is not jumping
+		physics->applyGravity(player, delta);
+	}
+
+	// Sweep player from position to next position against blocks.
+	physics->resolvePlayerCollision(player, chunkMap);
+}
@@ -0,0 +1,86 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+namespace Voxel
+{
+	// foward declaration
+	class Player;
+	class Physics;
+	class ChunkMap;
+	class Calendar;
+
+	/**
+	*	@struct MovementInput
+	*	@brief Movement that player wants on single simulation tick.
+	*
+	*	Filled from keyboard and controller by GameScene, or scripted without window.
+	*	Simulation only reads this, so it never touches input devices or cursor.
+	*/
+	struct MovementInput
+	{
+	public:
+		bool forward;
+		bool backward;
+		bool left;
+		bool right;
+		// Only used while flying
+		bool up;
+		bool down;
+		// Only used while on ground and not flying
+		bool jump;
+
+		MovementInput();
+
+		// Clear all movement
+		void clear();
+	};
+
+	/**
+	*	@class Simulation
+	*	@brief Runs single fixed simulation tick. Movement, physics and calendar.
+	*
+	*	Driven by FixedTimeStep. Doesn't touch rendering, window or input devices, so it runs same with or without window.
+	*	Rendering interpolates player between last two ticks (see Player::updateMovement).
+	*/
+	class Simulation
+	{
+	private:
+		Player* player;
+		Physics* physics;
+		ChunkMap* chunkMap;
+		// Can be nullptr
+		Calendar* calendar;
+	public:
+		/**
+		*	Constructor
+		*	@param player Player to simulate.
+		*	@param physics Physics of player. Keeps jump force of player.
+		*	@param chunkMap ChunkMap to collide with.
+		*	@param calendar Calendar to advance. Can be nullptr.
+		*/
+		Simulation(Player* player, Physics* physics, ChunkMap* chunkMap, Calendar* calendar);
+
+		// Destructor
+		~Simulation() = default;
+
+		/**
+		*	Runs single tick.
+		*	@param input Movement on this tick.
+		*	@param delta Fixed tick delta.
+		*/
+		void tick(const MovementInput& input, const float delta);
+
+		/**
+		*	Moves player by input, applies jump force and gravity, then resolves collision against blocks.
+		*	Each player needs own Physics because Physics keeps jump force.
+		*	@param player Player to move.
+		*	@param physics Physics of player.
+		*	@param chunkMap ChunkMap to collide with.
+		*	@param input Movement on this tick.
+		*	@param delta Fixed tick delta.
+		*/
+		static void tickPlayer(Player* player, Physics* physics, ChunkMap* chunkMap, const MovementInput& input, const float delta);
+	};
+}
+
+#endif
@@ -354,8 +354,8 @@ void Voxel::Skybox::updateColor(const int hour, const int minute, const float se
 
 	skyboxProgram->use(true);
 	
-	skyboxProgram->setUniformVec3("topColor", topColor);
-	skyboxProgram->setUniformVec3("bottomColor", bottomColor);
+	skyboxProgram->setUniformVec3(SID("topColor"), topColor);
+	skyboxProgram->setUniformVec3(SID("bottomColor"), bottomColor);
 
 	midBlend = glm::mix(topColor, bottomColor, 0.5f);
 	//midBlend = bottomColor;
@@ -369,7 +369,7 @@ void Voxel::Skybox::updateMatrix(const glm::mat4 & mat)
 void Voxel::Skybox::render()
 {
 	skyboxProgram->use(true);
-	skyboxProgram->setUniformMat4("MVP_Matrix", MVP_Matrix);
+	skyboxProgram->setUniformMat4(SID("MVP_Matrix"), MVP_Matrix);
 
 	glBindVertexArray(vao);
 	glDrawElements(GL_TRIANGLES, indicesSize, GL_UNSIGNED_INT, 0);
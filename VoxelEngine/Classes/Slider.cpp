@@ -460,6 +460,17 @@ void Voxel::UI::Slider::updateButtonPos()
 		buttonBoundingBox.center.y -= (barSize.y * scale.y * 0.5f);
 		buttonBoundingBox.center.y += (((currentValue - minValue) / (maxValue - minValue)) * barBoundingBox.size.y);
 	}
+
+	markBoundingVolumeDirty();
+}
+
+Voxel::Shape::Rect Voxel::UI::Slider::getHitBoundingBox() const
+{
+	// Slider doesn't use own bounding box. Mouse is tested with bar and button.
+	auto min = glm::min(barBoundingBox.getMin(), buttonBoundingBox.getMin());
+	auto max = glm::max(barBoundingBox.getMax(), buttonBoundingBox.getMax());
+
+	return Voxel::Shape::Rect((min + max) * 0.5f, max - min);
 }
 
 void Voxel::UI::Slider::updateBoundingBox()
@@ -633,7 +644,7 @@ bool Voxel::UI::Slider::updateMouseMove(const glm::vec2 & mousePosition, const g
 				auto rit = children.rbegin();
 				for (; rit != children.rend();)
 				{
-					bool result = (rit->second)->updateMouseMove(mousePosition, mouseDelta);
+					bool result = (rit->second)->updateMouseMoveCulled(mousePosition, mouseDelta);
 					if (result)
 					{
 						// child hovered.
@@ -655,7 +666,7 @@ bool Voxel::UI::Slider::updateMouseMove(const glm::vec2 & mousePosition, const g
 
 					for (; rit != children.rend(); rit++)
 					{
-						(rit->second)->updateMouseMoveFalse();
+						(rit->second)->updateMouseMoveFalseCulled();
 					}
 
 					updateMouseMoveFalse();
@@ -862,9 +873,9 @@ void Voxel::UI::Slider::renderSelf()
 	if (program == nullptr) return;
 
 	program->use(true);
-	program->setUniformMat4("modelMat", glm::scale(modelMat, glm::vec3(scale, 1)));
-	program->setUniformFloat("opacity", opacity);
-	program->setUniformVec3("color", color);
+	program->setUniformMat4(SID("modelMat"), glm::scale(modelMat, glm::vec3(scale, 1)));
+	program->setUniformFloat(SID("opacity"), opacity);
+	program->setUniformVec3(SID("color"), color);
 
 	texture->activate(GL_TEXTURE0);
 	texture->bind();
@@ -878,11 +889,11 @@ void Voxel::UI::Slider::renderSelf()
 
 	if (type == Type::HORIZONTAL)
 	{
-		program->setUniformMat4("modelMat", glm::scale(modelMat * glm::translate(glm::mat4(1.0f), glm::vec3(buttonBoundingBox.center.x - barBoundingBox.center.x, 0.0f, 0.0f)), glm::vec3(scale, 1)));
+		program->setUniformMat4(SID("modelMat"), glm::scale(modelMat * glm::translate(glm::mat4(1.0f), glm::vec3(buttonBoundingBox.center.x - barBoundingBox.center.x, 0.0f, 0.0f)), glm::vec3(scale, 1)));
 	}
 	else
 	{
-		program->setUniformMat4("modelMat", glm::scale(modelMat * glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, buttonBoundingBox.center.y - barBoundingBox.center.y, 0.0f)), glm::vec3(scale, 1)));
+		program->setUniformMat4(SID("modelMat"), glm::scale(modelMat * glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, buttonBoundingBox.center.y - barBoundingBox.center.y, 0.0f)), glm::vec3(scale, 1)));
 	}
 
 	if (buttonVao)
@@ -896,9 +907,9 @@ void Voxel::UI::Slider::renderSelf()
 	{
 		auto lineProgram = ProgramManager::getInstance().getProgram(Voxel::ProgramManager::PROGRAM_NAME::LINE_SHADER);
 		lineProgram->use(true);
-		lineProgram->setUniformMat4("modelMat", modelMat);
-		lineProgram->setUniformMat4("viewMat", glm::mat4(1.0f));
-		lineProgram->setUniformVec4("lineColor", glm::vec4(1.0f));
+		lineProgram->setUniformMat4(SID("modelMat"), modelMat);
+		lineProgram->setUniformMat4(SID("viewMat"), glm::mat4(1.0f));
+		lineProgram->setUniformVec4(SID("lineColor"), glm::vec4(1.0f));
 
 		glBindVertexArray(bbVao);
 		glDrawArrays(GL_LINES, 0, 24);
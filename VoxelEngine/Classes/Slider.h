@@ -96,6 +96,9 @@ namespace Voxel
 
 			// Update button pos
 			void updateButtonPos();
+
+			// Union of bar and button bounding box
+			Voxel::Shape::Rect getHitBoundingBox() const override;
 		public:
 			// Destructor
 			~Slider();
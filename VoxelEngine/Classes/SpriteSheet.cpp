@@ -9,6 +9,7 @@
 #include "FileSystem.h"
 #include "Logger.h"
 #include "Config.h"
+#include "CookedSpriteSheet.h"
 
 using namespace Voxel;
 using json = nlohmann::json;
@@ -42,11 +43,21 @@ SpriteSheet * Voxel::SpriteSheet::create(const std::string & dataFileName)
 
 bool Voxel::SpriteSheet::hasImage(const std::string & imageName)
 {
+	if (!cookedEntries.empty())
+	{
+		return findCookedEntry(imageName) != nullptr;
+	}
+
 	return imageEntryMap.find(imageName) != imageEntryMap.end();
 }
 
 const ImageEntry* Voxel::SpriteSheet::getImageEntry(const std::string & imageName)
 {
+	if (!cookedEntries.empty())
+	{
+		return findCookedEntry(imageName);
+	}
+
 	if (hasImage(imageName))
 	{
 		return &imageEntryMap[imageName];
@@ -78,7 +89,12 @@ void Voxel::SpriteSheet::print()
 		logger->consoleWarn("[SpriteSheet] Texture doesn't eixsts.");
 	}
 
-	logger->consoleInfo("[SpriteSheet] " + std::to_string(imageEntryMap.size()) + " images in spritesheet");
+	logger->consoleInfo("[SpriteSheet] " + std::to_string(imageEntryMap.size() + cookedEntries.size()) + " images in spritesheet");
+
+	if (!cookedEntries.empty())
+	{
+		logger->consoleInfo("[SpriteSheet] Cooked");
+	}
 
 	for (auto& ie : imageEntryMap)
 	{
@@ -92,7 +108,7 @@ void Voxel::SpriteSheet::print()
 #endif
 }
 
-bool Voxel::SpriteSheet::init(const std::string & dataFileName)
+bool Voxel::SpriteSheet::parse(const std::string & dataFileName, Data & data)
 {
 	const std::string wd = FileSystem::getInstance().getWorkingDirectory();
 
@@ -113,10 +129,93 @@ bool Voxel::SpriteSheet::init(const std::string & dataFileName)
 	
 	auto& textureInfo = j.at("texture");
 
-	std::string textureName = textureInfo.at("path");
+	data.textureName = textureInfo.at("path").get<std::string>();
+
+	auto& frames = j.at("frames");
+
+	data.frames.clear();
+	data.frames.reserve(frames.size());
+
+	for (auto& e : frames)
+	{
+		// Assume all images aren't roated and pivot is center.
+		auto& frame = e.at("frame");
+
+		Data::Frame newFrame;
+		newFrame.imageName = e.at("filename").get<std::string>();
+		newFrame.position.x = frame.at("x");
+		newFrame.position.y = frame.at("y");
+		newFrame.width = frame.at("w");
+		newFrame.height = frame.at("h");
+
+		data.frames.push_back(newFrame);
+	}
+
+	return true;
+}
+
+SpriteSheet * Voxel::SpriteSheet::createFromData(const Data & data, const Texture2D::DecodedImage & image)
+{
+	auto newSS = new SpriteSheet();
+
+	newSS->texture = Texture2D::createFromDecodedImage(data.textureName, image, GL_TEXTURE_2D, true);
+
+	if (newSS->initImageEntries(data))
+	{
+		return newSS;
+	}
+
+	delete newSS;
+	return nullptr;
+}
+
+SpriteSheet * Voxel::SpriteSheet::createFromCooked(const CookedSpriteSheet & cooked)
+{
+	auto newSS = new SpriteSheet();
+
+	Texture2D::DecodedImage image;
+	cooked.getImage(image);
+
+	newSS->texture = Texture2D::createFromDecodedImage(cooked.getTextureName(), image, GL_TEXTURE_2D, true);
+
+	if (newSS->initImageEntries(cooked))
+	{
+		return newSS;
+	}
+
+	delete newSS;
+	return nullptr;
+}
+
+bool Voxel::SpriteSheet::init(const std::string & dataFileName)
+{
+	// Use cooked file if it's up to date. Skips json parsing and png decoding.
+	std::unique_ptr<CookedSpriteSheet> cooked(CookedSpriteSheet::openForDataFile(dataFileName));
+
+	if (cooked)
+	{
+		Texture2D::DecodedImage image;
+		cooked->getImage(image);
+
+		texture = Texture2D::createFromDecodedImage(cooked->getTextureName(), image, GL_TEXTURE_2D, true);
+
+		return initImageEntries(*cooked);
+	}
+
+	Data data;
+
+	if (!parse(dataFileName, data))
+	{
+		return false;
+	}
+
+	texture = Texture2D::createSpriteSheetTexture(data.textureName, GL_TEXTURE_2D);
 
-	texture = Texture2D::createSpriteSheetTexture(textureName, GL_TEXTURE_2D);
+	return initImageEntries(data);
+}
 
+bool Voxel::SpriteSheet::initImageEntries(const Data & data)
+{
 	if (!texture)
 	{
 		return false;
@@ -129,28 +228,12 @@ bool Voxel::SpriteSheet::init(const std::string & dataFileName)
 	const float textureWidth = static_cast<float>(textureSize.x);
 	const float textureHeight = static_cast<float>(textureSize.y);
 
-	auto& frames = j.at("frames");
-
-	for (auto& e : frames)
+	for (auto& frame : data.frames)
 	{
-		// Assume all images aren't roated and pivot is center.
-		std::string imageName = e.at("filename");
-
-		auto& frame = e.at("frame");
-
 		ImageEntry newEntry;
-		newEntry.position.x = frame.at("x");
-		newEntry.position.y = frame.at("y");
-		newEntry.width = frame.at("w");
-		newEntry.height = frame.at("h");
-		
-		/*
-		newEntry.uvOrigin.x = ((newEntry.position.x + newEntry.width) / textureWidth);
-		newEntry.uvOrigin.y = ((newEntry.position.y + newEntry.height) / textureHeight);
-
-		newEntry.uvEnd.x = (newEntry.position.x / textureWidth);
-		newEntry.uvEnd.y = (newEntry.position.y / textureHeight);
-		*/
+		newEntry.position = frame.position;
+		newEntry.width = frame.width;
+		newEntry.height = frame.height;
 
 		// Texture's y is flipped when it's read by stb_image. So we assign y as flipped
 
@@ -160,12 +243,67 @@ bool Voxel::SpriteSheet::init(const std::string & dataFileName)
 		newEntry.uvEnd.x = ((newEntry.position.x + newEntry.width) / textureWidth);
 		newEntry.uvEnd.y = (newEntry.position.y / textureHeight);
 
-		imageEntryMap.emplace(imageName, newEntry);
+		imageEntryMap.emplace(frame.imageName, newEntry);
+	}
+
+	return true;
+}
+
+bool Voxel::SpriteSheet::initImageEntries(const CookedSpriteSheet & cooked)
+{
+	if (!texture)
+	{
+		return false;
+	}
+
+	texture->setLocationOnProgram(ProgramManager::PROGRAM_NAME::UI_TEXTURE_SHADER);
+
+	const unsigned int entryCount = cooked.getEntryCount();
+
+	auto displacements = cooked.getDisplacements();
+	auto entries = cooked.getEntries();
+
+	// Copy out of mapped file so file can be unmapped.
+	cookedDisplacements.assign(displacements, displacements + entryCount);
+
+	cookedNames.clear();
+	cookedNames.reserve(entryCount);
+
+	cookedEntries.clear();
+	cookedEntries.reserve(entryCount);
+
+	for (unsigned int i = 0; i < entryCount; i++)
+	{
+		auto& entry = entries[i];
+
+		// UV is computed by cooker
+		ImageEntry newEntry;
+		newEntry.position = glm::vec2(entry.x, entry.y);
+		newEntry.width = entry.width;
+		newEntry.height = entry.height;
+		newEntry.uvOrigin = glm::vec2(entry.uvOriginX, entry.uvOriginY);
+		newEntry.uvEnd = glm::vec2(entry.uvEndX, entry.uvEndY);
+
+		cookedNames.push_back(cooked.getEntryName(entry));
+		cookedEntries.push_back(newEntry);
 	}
 
 	return true;
 }
 
+const ImageEntry * Voxel::SpriteSheet::findCookedEntry(const std::string & imageName) const
+{
+	const unsigned int entryCount = static_cast<unsigned int>(cookedEntries.size());
+	const unsigned int slot = CookedSpriteSheet::findSlot(cookedDisplacements.data(), entryCount, imageName.c_str(), static_cast<unsigned int>(imageName.size()));
+
+	if (slot < entryCount && cookedNames.at(slot) == imageName)
+	{
+		return &cookedEntries.at(slot);
+	}
+
+	return nullptr;
+}
+
 
 
 
@@ -186,14 +324,16 @@ bool Voxel::SpriteSheetManager::addSpriteSheet(const std::string & jsonFileName)
 		ext = ".json";
 	}
 	
-	auto find_it = spriteSheetMap.find(fileName);
+	const StringID key(fileName);
+
+	auto find_it = spriteSheetMap.find(key);
 
 	if (find_it == spriteSheetMap.end())
 	{
 		auto ss = SpriteSheet::create(fileName + ext);
 		if (ss)
 		{
-			spriteSheetMap.emplace(fileName, ss);
+			spriteSheetMap.emplace(key, ss);
 			return true;
 		}
 		else
@@ -207,7 +347,32 @@ bool Voxel::SpriteSheetManager::addSpriteSheet(const std::string & jsonFileName)
 	}
 }
 
-bool Voxel::SpriteSheetManager::removeSpriteSheetByKey(const std::string & key)
+bool Voxel::SpriteSheetManager::addSpriteSheet(const std::string & jsonFileName, SpriteSheet * spriteSheet)
+{
+	if (spriteSheet == nullptr)
+	{
+		return false;
+	}
+
+	const StringID key(Utility::String::removeFileExtFromFileName(jsonFileName));
+
+	if (spriteSheetMap.find(key) == spriteSheetMap.end())
+	{
+		spriteSheetMap.emplace(key, spriteSheet);
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+bool Voxel::SpriteSheetManager::hasSpriteSheet(const std::string & jsonFileName)
+{
+	return spriteSheetMap.find(StringID(Utility::String::removeFileExtFromFileName(jsonFileName))) != spriteSheetMap.end();
+}
+
+bool Voxel::SpriteSheetManager::removeSpriteSheetByKey(const StringID key)
 {
 	auto find_it = spriteSheetMap.find(key);
 
@@ -233,7 +398,7 @@ bool Voxel::SpriteSheetManager::removeSpriteSheetByName(const std::string & json
 	return removeSpriteSheetByKey(Utility::String::removeFileExtFromFileName(jsonFileName));
 }
 
-SpriteSheet * Voxel::SpriteSheetManager::getSpriteSheetByKey(const std::string & key)
+SpriteSheet * Voxel::SpriteSheetManager::getSpriteSheetByKey(const StringID key)
 {
 	auto find_it = spriteSheetMap.find(key);
 
@@ -277,7 +442,7 @@ void Voxel::SpriteSheetManager::print(const bool detail)
 	{
 		if (ss.second)
 		{
-			logger->consoleInfo("[SpriteSheetManager] Key: " + ss.first);
+			logger->consoleInfo("[SpriteSheetManager] Key: " + (ss.first).toString());
 
 			if (detail)
 			{
@@ -4,18 +4,23 @@
 // cpp
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 // json
 #include <json.hpp>
 
 // voxel
 #include "Texture2D.h"
+#include "StringID.h"
 
 // glm
 #include <glm\glm.hpp>
 
 namespace Voxel
 {
+	// foward declaration
+	class CookedSpriteSheet;
+
 	/**
 	*	@struct ImageEntry
 	*	@breif Contains frame data for image in sprite sheet
@@ -38,6 +43,28 @@ namespace Voxel
 	*/
 	class SpriteSheet
 	{
+	public:
+		/**
+		*	@struct Data
+		*	@brief Parsed data file. Parsing doesn't use OpenGL, so it can be done on any thread (AssetLoader).
+		*/
+		struct Data
+		{
+		public:
+			struct Frame
+			{
+				std::string imageName;
+				glm::vec2 position;
+				float width;
+				float height;
+			};
+
+			// Texture file name
+			std::string textureName;
+
+			// All images in sprite sheet
+			std::vector<Frame> frames;
+		};
 	private:
 		// Constructor
 		SpriteSheet();
@@ -48,8 +75,22 @@ namespace Voxel
 		// image entries. Contains each sprite's data
 		std::unordered_map<std::string/*image file name*/, ImageEntry> imageEntryMap;
 
+		// Image entries of cooked sprite sheet in perfect hash slot order. Used instead of imageEntryMap if sprite sheet is cooked.
+		std::vector<int> cookedDisplacements;
+		std::vector<std::string> cookedNames;
+		std::vector<ImageEntry> cookedEntries;
+
 		// initailize 
 		bool init(const std::string& dataFileName);
+
+		// Initialize image entries with parsed data. Texture must be created.
+		bool initImageEntries(const Data& data);
+
+		// Initialize image entries with cooked sprite sheet. Texture must be created.
+		bool initImageEntries(const CookedSpriteSheet& cooked);
+
+		// Find image entry in cooked entries. nullptr if doesn't exist.
+		const ImageEntry* findCookedEntry(const std::string& imageName) const;
 	public:
 		// destructor
 		~SpriteSheet();
@@ -57,6 +98,27 @@ namespace Voxel
 		// create sprite sheet
 		static SpriteSheet* create(const std::string& dataFileName);
 
+		/**
+		*	Read and parse data file. Thread safe.
+		*	@param dataFileName Json file name in sprite sheet directory.
+		*	@param data Parsed data.
+		*	@return true if data file is parsed.
+		*/
+		static bool parse(const std::string& dataFileName, Data& data);
+
+		/**
+		*	Create sprite sheet with parsed data and decoded texture image. Must be called on main thread.
+		*	@param data Data parsed by parse().
+		*	@param image Texture image decoded by Texture2D::decodeImage().
+		*/
+		static SpriteSheet* createFromData(const Data& data, const Texture2D::DecodedImage& image);
+
+		/**
+		*	Create sprite sheet with cooked sprite sheet. Texture is uploaded from mapped file. Call CookedSpriteSheet::prefetch on loading thread first, so upload doesn't wait for disk. Must be called on main thread.
+		*	@param cooked Cooked sprite sheet. Can be released after call.
+		*/
+		static SpriteSheet* createFromCooked(const CookedSpriteSheet& cooked);
+
 		// check if sprite sheet has specific image(sprite)
 		bool hasImage(const std::string& imageName);
 		
@@ -90,8 +152,8 @@ namespace Voxel
 		SpriteSheetManager& operator=(SpriteSheetManager const&) = delete;  // Copy assign
 		SpriteSheetManager& operator=(SpriteSheetManager &&) = delete;      // Move assign
 
-		// map of sprite sheets with name by key. Since we don't query sprite sheet a lot, string key is fine.
-		std::unordered_map<std::string, SpriteSheet*> spriteSheetMap;
+		// map of sprite sheets with interned name by key.
+		std::unordered_map<StringID, SpriteSheet*> spriteSheetMap;
 
 	public:
 		// Get singleton instance
@@ -108,13 +170,24 @@ namespace Voxel
 		*	@return true if successfully adds sprite sheet. Else, false.
 		*/
 		bool addSpriteSheet(const std::string& jsonFileName);
+
+		/**
+		*	Add sprite sheet that is already created. Used by AssetLoader.
+		*	@param jsonFileName Json file name for sprite sheet.
+		*	@param spriteSheet Sprite sheet to add. Manager owns it if added.
+		*	@return true if successfully adds sprite sheet. False if sprite sheet with same key exists.
+		*/
+		bool addSpriteSheet(const std::string& jsonFileName, SpriteSheet* spriteSheet);
+
+		// Check if sprite sheet with json file name exists
+		bool hasSpriteSheet(const std::string& jsonFileName);
 		
 		/**
 		*	Remove sprite sheet by key. Key equals to sprite sheet name without .json extention.
 		*	@param key String key for spritesheet.
 		*	@return true if successfully removes sprite shset. Else, false.
 		*/
-		bool removeSpriteSheetByKey(const std::string& key);
+		bool removeSpriteSheetByKey(const StringID key);
 
 		/**
 		*	Remove sprite sheet by file name.
@@ -128,7 +201,7 @@ namespace Voxel
 		*	@param key String key for spritesheet.
 		*	@return SpriteSheet instance if sprite sheet exists. Else, nullptr.
 		*/
-		SpriteSheet* getSpriteSheetByKey(const std::string& key);
+		SpriteSheet* getSpriteSheetByKey(const StringID key);
 
 		/**
 		*	Get sprite sheet by file name
@@ -0,0 +1,223 @@
+// pch
+#include "PreCompiled.h"
+
+#include "SpriteSheetCooker.h"
+
+// cpp
+#include <memory>
+
+// voxel
+#include "SpriteSheet.h"
+#include "CookedSpriteSheet.h"
+#include "Texture2D.h"
+#include "FileSystem.h"
+#include "Benchmark.h"
+#include "Utility.h"
+
+using namespace Voxel;
+
+SpriteSheetCooker::Result Voxel::SpriteSheetCooker::cook(const std::string & dataFileName)
+{
+	Result result;
+	result.dataFileName = dataFileName;
+	result.success = false;
+	result.entryCount = 0;
+	result.cookedSize = 0;
+	result.sourceSize = 0;
+	result.parseMilliSeconds = 0;
+	result.decodeMilliSeconds = 0;
+	result.writeMilliSeconds = 0;
+
+	auto& fs = FileSystem::getInstance();
+
+	SpriteSheet::Data data;
+	Texture2D::DecodedImage image;
+
+	try
+	{
+		auto start = Utility::Time::now();
+
+		if (!SpriteSheet::parse(dataFileName, data))
+		{
+			std::cout << "[SpriteSheetCooker] Failed to read " << dataFileName << "\n";
+			return result;
+		}
+
+		auto parsed = Utility::Time::now();
+
+		if (!Texture2D::decodeImage(data.textureName, image))
+		{
+			std::cout << "[SpriteSheetCooker] Failed to decode " << data.textureName << "\n";
+			return result;
+		}
+
+		auto decoded = Utility::Time::now();
+
+		result.parseMilliSeconds = Benchmark::toMilliSeconds(start, parsed);
+		result.decodeMilliSeconds = Benchmark::toMilliSeconds(parsed, decoded);
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << "[SpriteSheetCooker] " << dataFileName << ": " << e.what() << "\n";
+		return result;
+	}
+
+	result.entryCount = static_cast<unsigned int>(data.frames.size());
+	result.sourceSize = fs.getFileSize(fs.getWorkingDirectory() + "/spritesheets/" + dataFileName) + fs.getFileSize(fs.getWorkingDirectory() + "/" + Texture2D::DEFAULT_TEXTURE_PATH + data.textureName);
+
+	const std::string cookedFilePath = CookedSpriteSheet::getCookedFilePath(dataFileName);
+
+	auto start = Utility::Time::now();
+
+	result.cookedSize = CookedSpriteSheet::write(cookedFilePath, data, image);
+
+	result.writeMilliSeconds = Benchmark::toMilliSeconds(start, Utility::Time::now());
+
+	if (result.cookedSize == 0)
+	{
+		std::cout << "[SpriteSheetCooker] Failed to write " << cookedFilePath << "\n";
+		return result;
+	}
+
+	std::vector<std::string> imageNames;
+	imageNames.reserve(data.frames.size());
+
+	for (auto& frame : data.frames)
+	{
+		imageNames.push_back(frame.imageName);
+	}
+
+	result.success = verify(cookedFilePath, imageNames);
+
+	if (!result.success)
+	{
+		// Don't leave broken file. Runtime falls back to json and png.
+		fs.deleteFile(cookedFilePath);
+	}
+
+	return result;
+}
+
+bool Voxel::SpriteSheetCooker::verify(const std::string & cookedFilePath, const std::vector<std::string>& imageNames)
+{
+	std::unique_ptr<CookedSpriteSheet> cooked(CookedSpriteSheet::open(cookedFilePath));
+
+	if (cooked == nullptr)
+	{
+		std::cout << "[SpriteSheetCooker] Failed to map " << cookedFilePath << "\n";
+		return false;
+	}
+
+	if (cooked->getEntryCount() != static_cast<unsigned int>(imageNames.size()))
+	{
+		std::cout << "[SpriteSheetCooker] Entry count mismatch in " << cookedFilePath << "\n";
+		return false;
+	}
+
+	for (auto& imageName : imageNames)
+	{
+		if (cooked->findEntry(imageName) == nullptr)
+		{
+			std::cout << "[SpriteSheetCooker] Can't find " << imageName << " in " << cookedFilePath << "\n";
+			return false;
+		}
+	}
+
+	// Name that isn't in sprite sheet must not be found
+	if (cooked->findEntry("") != nullptr)
+	{
+		std::cout << "[SpriteSheetCooker] Found empty name in " << cookedFilePath << "\n";
+		return false;
+	}
+
+	return true;
+}
+
+void Voxel::SpriteSheetCooker::printResult(const Result & result)
+{
+	if (!result.success)
+	{
+		std::cout << "[SpriteSheetCooker] " << result.dataFileName << ": FAILED\n";
+		return;
+	}
+
+	Benchmark::ResultLine("SpriteSheetCooker", result.dataFileName)
+		.add("images", result.entryCount)
+		.add("source", result.sourceSize / 1024.0f, "KB")
+		.add("cooked", result.cookedSize / 1024.0f, "KB")
+		.add("parse", result.parseMilliSeconds, "ms")
+		.add("decode", result.decodeMilliSeconds, "ms")
+		.add("write", result.writeMilliSeconds, "ms")
+		.print();
+}
+
+int Voxel::SpriteSheetCooker::run(const std::vector<std::string>& dataFileNames)
+{
+	int failed = 0;
+
+	for (auto& dataFileName : dataFileNames)
+	{
+		auto result = cook(dataFileName);
+
+		printResult(result);
+
+		if (!result.success)
+		{
+			failed++;
+		}
+	}
+
+	std::cout << "[SpriteSheetCooker] Cooked " << (dataFileNames.size() - failed) << " / " << dataFileNames.size() << " sprite sheets\n";
+
+	return failed;
+}
+
+std::vector<std::string> Voxel::SpriteSheetCooker::findDataFiles()
+{
+	std::vector<std::string> dataFileNames;
+
+	const fs::path dir(FileSystem::getInstance().getWorkingDirectory() + "/spritesheets");
+
+	if (!fs::is_directory(dir))
+	{
+		return dataFileNames;
+	}
+
+	for (auto& e : fs::directory_iterator(dir))
+	{
+		if (fs::is_regular_file(e.path()) && e.path().extension() == ".json")
+		{
+			dataFileNames.push_back(e.path().filename().string());
+		}
+	}
+
+	std::sort(dataFileNames.begin(), dataFileNames.end());
+
+	return dataFileNames;
+}
+
+int Voxel::SpriteSheetCooker::runFromCommandLine(const int argc, const char * argv[])
+{
+	// argv[0] is exe, argv[1] is --cook-sprite-sheets
+	std::vector<std::string> dataFileNames;
+
+	for (int i = 2; i < argc; i++)
+	{
+		dataFileNames.push_back(std::string(argv[i]));
+	}
+
+	if (dataFileNames.empty())
+	{
+		dataFileNames = findDataFiles();
+	}
+
+	if (dataFileNames.empty())
+	{
+		std::cout << "Usage: --cook-sprite-sheets [json file names...]\n";
+		return 1;
+	}
+
+	SpriteSheetCooker cooker;
+
+	return cooker.run(dataFileNames) == 0 ? 0 : 1;
+}
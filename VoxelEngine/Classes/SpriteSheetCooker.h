@@ -0,0 +1,74 @@
+#ifndef SPRITE_SHEET_COOKER_H
+#define SPRITE_SHEET_COOKER_H
+
+// cpp
+#include <string>
+#include <vector>
+
+namespace Voxel
+{
+	/**
+	*	@class SpriteSheetCooker
+	*	@brief Cooks sprite sheet json and png to CookedSpriteSheet file without window or OpenGL context.
+	*
+	*	Parses json, decodes png and writes .vss file next to json in sprite sheet directory.
+	*	Each cooked file is mapped back and every image is looked up with perfect hash to verify it.
+	*	Run after TexturePacker and jsonTrim.py (see Tools/publishSpritesheets.bat).
+	*
+	*	Run with: VoxelEngine.exe --cook-sprite-sheets [json file names...]
+	*	Cooks all json files in sprite sheet directory if no file is given.
+	*	Returns non zero if any sprite sheet failed to cook.
+	*/
+	class SpriteSheetCooker
+	{
+	public:
+		// Result of single sprite sheet
+		struct Result
+		{
+			std::string dataFileName;
+			bool success;
+			unsigned int entryCount;
+			// Size of cooked file in bytes
+			unsigned long long cookedSize;
+			// Size of json and png in bytes
+			unsigned long long sourceSize;
+			// Times in milliseconds
+			float parseMilliSeconds;
+			float decodeMilliSeconds;
+			float writeMilliSeconds;
+		};
+	private:
+		// Cook single sprite sheet
+		Result cook(const std::string& dataFileName);
+
+		// Map cooked file and check all entries can be found
+		bool verify(const std::string& cookedFilePath, const std::vector<std::string>& imageNames);
+
+		// Print result of single sprite sheet
+		void printResult(const Result& result);
+	public:
+		// Constructor
+		SpriteSheetCooker() = default;
+
+		// Destructor
+		~SpriteSheetCooker() = default;
+
+		/**
+		*	Cooks sprite sheets.
+		*	@param dataFileNames Json file names in sprite sheet directory.
+		*	@return Number of sprite sheets that failed.
+		*/
+		int run(const std::vector<std::string>& dataFileNames);
+
+		// Get all json file names in sprite sheet directory
+		static std::vector<std::string> findDataFiles();
+
+		/**
+		*	Parses arguments after --cook-sprite-sheets and cooks sprite sheets.
+		*	@return Exit code for process.
+		*/
+		static int runFromCommandLine(const int argc, const char* argv[]);
+	};
+}
+
+#endif
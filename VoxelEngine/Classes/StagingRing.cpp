@@ -0,0 +1,186 @@
+// pch
+#include "PreCompiled.h"
+
+#include "StagingRing.h"
+
+using namespace Voxel;
+
+const unsigned int Voxel::StagingRing::ALIGNMENT = 16;
+
+Voxel::StagingRing::StagingRing(const unsigned int capacity)
+	: data(((capacity + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT)
+	, head(0)
+	, tail(0)
+	, usedSize(0)
+	, peakUsedSize(0)
+	, liveBlockCount(0)
+	, frontId(0)
+	, allocationCount(0)
+	, failedAllocationCount(0)
+{}
+
+void Voxel::StagingRing::pushRecord(const unsigned int offset, const unsigned int size, const bool released)
+{
+	Record record;
+	record.offset = offset;
+	record.size = size;
+	record.released = released;
+
+	records.push_back(record);
+
+	usedSize += size;
+}
+
+bool Voxel::StagingRing::allocate(const unsigned int size, Block & block)
+{
+	const unsigned int capacity = static_cast<unsigned int>(data.size());
+	const unsigned int alignedSize = ((size + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+
+	std::unique_lock<std::mutex> lock(ringMutex);
+
+	if (alignedSize == 0 || alignedSize > capacity)
+	{
+		failedAllocationCount++;
+		return false;
+	}
+
+	unsigned int offset = 0;
+
+	if (records.empty())
+	{
+		head = 0;
+		tail = 0;
+		offset = 0;
+	}
+	else if (head == tail)
+	{
+		// Full
+		failedAllocationCount++;
+		return false;
+	}
+	else if (head > tail)
+	{
+		if (alignedSize <= capacity - head)
+		{
+			offset = head;
+		}
+		else if (alignedSize <= tail)
+		{
+			// Doesn't fit at the end. Skip the rest and wrap.
+			pushRecord(head, capacity - head, true);
+			offset = 0;
+		}
+		else
+		{
+			failedAllocationCount++;
+			return false;
+		}
+	}
+	else
+	{
+		// Wrapped. Free space is between head and tail.
+		if (alignedSize <= tail - head)
+		{
+			offset = head;
+		}
+		else
+		{
+			failedAllocationCount++;
+			return false;
+		}
+	}
+
+	block.offset = offset;
+	block.size = alignedSize;
+	block.id = frontId + records.size();
+
+	pushRecord(offset, alignedSize, false);
+
+	head = offset + alignedSize;
+
+	if (head == capacity)
+	{
+		head = 0;
+	}
+
+	liveBlockCount++;
+	allocationCount++;
+	peakUsedSize = std::max(peakUsedSize, usedSize);
+
+	return true;
+}
+
+void Voxel::StagingRing::release(Block & block)
+{
+	if (!block.isValid())
+	{
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(ringMutex);
+
+		auto& record = records.at(static_cast<size_t>(block.id - frontId));
+
+		assert(!record.released);
+		assert(record.offset == block.offset);
+
+		record.released = true;
+		liveBlockCount--;
+
+		// Reclaim space of released blocks from tail
+		while (!records.empty() && records.front().released)
+		{
+			auto& front = records.front();
+
+			tail = front.offset + front.size;
+			usedSize -= front.size;
+
+			records.pop_front();
+			frontId++;
+		}
+
+		if (tail == static_cast<unsigned int>(data.size()))
+		{
+			tail = 0;
+		}
+
+		if (records.empty())
+		{
+			head = 0;
+			tail = 0;
+		}
+	}
+
+	block = Block();
+}
+
+char * Voxel::StagingRing::getData(const Block & block)
+{
+	return &data.at(block.offset);
+}
+
+const char * Voxel::StagingRing::getData(const Block & block) const
+{
+	return &data.at(block.offset);
+}
+
+unsigned int Voxel::StagingRing::getCapacity() const
+{
+	return static_cast<unsigned int>(data.size());
+}
+
+StagingRing::Stats Voxel::StagingRing::getStats() const
+{
+	std::unique_lock<std::mutex> lock(ringMutex);
+
+	Stats stats;
+	stats.capacity = static_cast<unsigned int>(data.size());
+	stats.usedSize = usedSize;
+	stats.peakUsedSize = peakUsedSize;
+	stats.liveBlockCount = liveBlockCount;
+	stats.allocationCount = allocationCount;
+	stats.failedAllocationCount = failedAllocationCount;
+
+	return stats;
+}
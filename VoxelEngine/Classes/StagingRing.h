@@ -0,0 +1,113 @@
+#ifndef STAGING_RING_H
+#define STAGING_RING_H
+
+// cpp
+#include <vector>
+#include <deque>
+#include <mutex>
+
+namespace Voxel
+{
+	/**
+	*	@class StagingRing
+	*	@brief Fixed size ring of memory where worker threads write data that main thread uploads later.
+	*
+	*	Replaces per object heap copies that live until upload. Blocks are handed out in ring order and
+	*	can be released in any order. Space is reclaimed once every older block is released,
+	*	so a block that is never released stalls the ring and allocate() fails until it is.
+	*	Caller falls back to own memory when allocate() fails.
+	*
+	*	Thread safe. Data of a block must only be touched by one thread at a time.
+	*/
+	class StagingRing
+	{
+	public:
+		// Alignment of block offset and size in bytes
+		static const unsigned int ALIGNMENT;
+
+		struct Block
+		{
+			unsigned int offset;
+			unsigned int size;
+			unsigned long long id;
+
+			Block() : offset(0), size(0), id(0) {}
+
+			// Check if block is allocated from ring
+			bool isValid() const { return size > 0; }
+		};
+
+		struct Stats
+		{
+			unsigned int capacity;
+			// Bytes between tail and head. Includes released blocks that wait for older blocks and padding.
+			unsigned int usedSize;
+			unsigned int peakUsedSize;
+			unsigned int liveBlockCount;
+			unsigned long long allocationCount;
+			unsigned long long failedAllocationCount;
+		};
+	private:
+		struct Record
+		{
+			unsigned int offset;
+			unsigned int size;
+			bool released;
+		};
+
+		// Memory
+		std::vector<char> data;
+
+		// Next write position
+		unsigned int head;
+		// Start of oldest unreleased record
+		unsigned int tail;
+		unsigned int usedSize;
+		unsigned int peakUsedSize;
+		unsigned int liveBlockCount;
+
+		// Records in allocation order. Id of front record is frontId.
+		std::deque<Record> records;
+		unsigned long long frontId;
+
+		unsigned long long allocationCount;
+		unsigned long long failedAllocationCount;
+
+		mutable std::mutex ringMutex;
+
+		// Append record. Doesn't lock.
+		void pushRecord(const unsigned int offset, const unsigned int size, const bool released);
+	public:
+		/**
+		*	Constructor
+		*	@param capacity Size of ring in bytes. Rounded up to alignment.
+		*/
+		StagingRing(const unsigned int capacity);
+
+		// Destructor
+		~StagingRing() = default;
+
+		/**
+		*	Allocate block.
+		*	@param size Size in bytes.
+		*	@param block Allocated block.
+		*	@return false if ring doesn't have contiguous space.
+		*/
+		bool allocate(const unsigned int size, Block& block);
+
+		// Release block. Memory is reused once all older blocks are released.
+		void release(Block& block);
+
+		// Get memory of block
+		char* getData(const Block& block);
+		const char* getData(const Block& block) const;
+
+		// Get capacity in bytes
+		unsigned int getCapacity() const;
+
+		// Get stats
+		Stats getStats() const;
+	};
+}
+
+#endif
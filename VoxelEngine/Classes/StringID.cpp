@@ -0,0 +1,70 @@
+// pch
+#include "PreCompiled.h"
+
+#include "StringID.h"
+
+using namespace Voxel;
+
+Voxel::StringID::StringID(const std::string & str)
+	: id(StringTable::getInstance().intern(str).getID())
+{}
+
+std::string Voxel::StringID::toString() const
+{
+	std::string str;
+
+	if (StringTable::getInstance().find(*this, str))
+	{
+		return str;
+	}
+
+	std::stringstream ss;
+	ss << "#" << std::hex << id;
+
+	return ss.str();
+}
+
+StringID Voxel::StringTable::intern(const std::string & str)
+{
+	const StringID sid(StringID::hash(str.c_str()));
+
+	std::unique_lock<std::mutex> lock(stringMutex);
+
+	auto find_it = strings.find(sid.getID());
+
+	if (find_it == strings.end())
+	{
+		strings.emplace(sid.getID(), str);
+	}
+	else if (find_it->second != str)
+	{
+		// Two strings share id. Rename one of them.
+		std::cout << "[StringTable] Hash collision between \"" << find_it->second << "\" and \"" << str << "\"\n";
+		assert(false);
+	}
+
+	return sid;
+}
+
+bool Voxel::StringTable::find(const StringID id, std::string & str) const
+{
+	std::unique_lock<std::mutex> lock(stringMutex);
+
+	auto find_it = strings.find(id.getID());
+
+	if (find_it == strings.end())
+	{
+		return false;
+	}
+
+	str = find_it->second;
+
+	return true;
+}
+
+unsigned int Voxel::StringTable::size() const
+{
+	std::unique_lock<std::mutex> lock(stringMutex);
+
+	return static_cast<unsigned int>(strings.size());
+}
@@ -0,0 +1,133 @@
+#ifndef STRING_ID_H
+#define STRING_ID_H
+
+// cpp
+#include <string>
+#include <unordered_map>
+#include <mutex>
+#include <type_traits>
+
+namespace Voxel
+{
+	/**
+	*	@class StringID
+	*	@brief Interned string. 32 bit FNV-1a hash of string.
+	*
+	*	Comparing and hashing StringID is single integer operation, so use it as key instead of std::string in hot paths
+	*	(uniform names, sprite sheet keys, ui node names).
+	*	Use SID("name") for string literal. Hash is computed at compile time.
+	*	StringID made from std::string is hashed at run time and string is registered to StringTable for debug print.
+	*/
+	class StringID
+	{
+	private:
+		// FNV-1a
+		static const unsigned int OFFSET_BASIS = 2166136261u;
+		static const unsigned int PRIME = 16777619u;
+
+		// Hash value
+		unsigned int id;
+	public:
+		// Constructor. Invalid id
+		constexpr StringID() : id(0) {}
+
+		// Constructor with hash value
+		constexpr explicit StringID(const unsigned int id) : id(id) {}
+
+		// Constructor with string literal. Compile time if it's constant expression. See SID().
+		constexpr StringID(const char* str) : id(hash(str)) {}
+
+		// Constructor with string. Registers string to StringTable.
+		StringID(const std::string& str);
+
+		// Hash string. Recursive so it's constexpr in C++11
+		static constexpr unsigned int hash(const char* str, const unsigned int value = OFFSET_BASIS)
+		{
+			return (*str == '\0') ? value : hash(str + 1, (value ^ static_cast<unsigned int>(static_cast<unsigned char>(*str))) * PRIME);
+		}
+
+		// Get hash value
+		constexpr unsigned int getID() const { return id; }
+
+		// Check if id is valid
+		constexpr bool isValid() const { return id != 0; }
+
+		// Get interned string. Returns hash value in hex if string isn't registered.
+		std::string toString() const;
+
+		constexpr bool operator==(const StringID& other) const { return id == other.id; }
+		constexpr bool operator!=(const StringID& other) const { return id != other.id; }
+		constexpr bool operator<(const StringID& other) const { return id < other.id; }
+	};
+
+	/**
+	*	@class StringTable
+	*	@brief Registry of interned strings. Maps StringID back to string and detects hash collision.
+	*
+	*	Thread safe.
+	*/
+	class StringTable
+	{
+	private:
+		// Constructor
+		StringTable() = default;
+
+		// Destructor
+		~StringTable() = default;
+
+		// Delete copy, move, assign operators
+		StringTable(StringTable const&) = delete;             // Copy construct
+		StringTable(StringTable&&) = delete;                  // Move construct
+		StringTable& operator=(StringTable const&) = delete;  // Copy assign
+		StringTable& operator=(StringTable &&) = delete;      // Move assign
+
+		// Strings by id
+		std::unordered_map<unsigned int, std::string> strings;
+
+		// Mutex for strings
+		mutable std::mutex stringMutex;
+	public:
+		// Get singleton instance
+		static StringTable& getInstance()
+		{
+			static StringTable instance;
+			return instance;
+		}
+
+		/**
+		*	Register string.
+		*	@param str String to intern.
+		*	@return Id of string.
+		*/
+		StringID intern(const std::string& str);
+
+		/**
+		*	Get string of id.
+		*	@param id Id to find.
+		*	@param str Interned string.
+		*	@return true if id is registered.
+		*/
+		bool find(const StringID id, std::string& str) const;
+
+		// Get number of registered strings
+		unsigned int size() const;
+	};
+}
+
+// Hash of StringID is the id itself
+namespace std
+{
+	template<>
+	struct hash<Voxel::StringID>
+	{
+		size_t operator()(const Voxel::StringID& sid) const
+		{
+			return static_cast<size_t>(sid.getID());
+		}
+	};
+}
+
+// StringID of string literal. Forces hash to be computed at compile time.
+#define SID(str) (Voxel::StringID(std::integral_constant<unsigned int, Voxel::StringID::hash(str)>::value))
+
+#endif
@@ -9,21 +9,27 @@
 #include "ProgramManager.h"
 #include "Program.h"
 #include "Texture2D.h"
+#include "BatchRenderer.h"
 
 Voxel::UI::Text::Text(const std::string& name)
 	: RenderNode(name)
 	, text("")
-	, align(ALIGN::LEFT)
-	, indicesSize(0)
-	, outlined(false)
-	, color(1.0f)
-	, outlineColor(0.0f)
 	, vbo(0)
 	, cbo(0)
 	, uvbo(0)
 	, ibo(0)
+	, indicesSize(0)
+	, color(1.0f)
+	, outlineColor(0.0f)
+	, align(ALIGN::LEFT)
+	, outlined(false)
 	, textSize(0)
 	, totalLines(0)
+	, atlasVersion(0)
+	, quadCount(0)
+	, bufferCapacity(0)
+	, dirtyBegin(std::numeric_limits<unsigned int>::max())
+	, dirtyEnd(0)
 	, state(State::IDLE)
 #if V_DEBUG && V_DEBUG_DRAW_UI_BOUNDING_BOX && V_DEBUG_DRAW_TEXT_BOUNDING_BOX
 	, lineIndicesSize(0)
@@ -109,14 +115,20 @@ bool Voxel::UI::Text::initWithOutline(const std::string & text, const int fontID
 	return buildMesh(true);
 }
 
-void Voxel::UI::Text::setText(const std::string & text)
+unsigned int Voxel::UI::Text::getQuadCount(const boost::string_view & text)
+{
+	// Font has glyph per char, so each char is single quad. New line only moves pen.
+	return static_cast<unsigned int>(text.size() - std::count(text.begin(), text.end(), '\n'));
+}
+
+void Voxel::UI::Text::setText(const boost::string_view & text)
 {
 	// Check if text is empty
 	if (text.empty())
 	{
 		// It's empty. Clear the text.
 		//clear();
-		this->text = text;
+		this->text.clear();
 		this->contentSize.x = 0.0f;
 		this->contentSize.y = 0.0f;
 		this->boundingBox.size.x = 0.0f;
@@ -132,27 +144,27 @@ void Voxel::UI::Text::setText(const std::string & text)
 	else
 	{
 		// Not empty. Check if it's different.
-		if (text != this->text)
+		if (text != boost::string_view(this->text))
 		{
 			bool update = false;
 
-			// Check if new text is longer than current text. if so, we have to reallocate the buffer. Else, do nothing
-			if (text.size() > textSize)
+			// Check if new text can exceed buffer capacity. if so, we have to reallocate the buffer. Else, only changed characters are uploaded.
+			if (getQuadCount(text) > bufferCapacity)
 			{
-				// new text is larger than current text
+				// new text is larger than buffer
 				update = true;
 			}
-			// Else, it's same length or shorter.
+			// Else, it fits in buffer.
 
-			// Different. rebuild text
-			this->text = text;
+			// Different. rebuild text. Assign keeps string's capacity.
+			this->text.assign(text.data(), text.size());
 
 			bool result = buildMesh(update);
 
 			if (!result)
 			{
 				// failed update mesh
-				this->text = "";
+				this->text.clear();
 				this->contentSize.x = 0.0f;
 				this->boundingBox.size.x = 0.0f;
 			}
@@ -216,6 +228,8 @@ void Voxel::UI::Text::clear()
 		glDeleteBuffers(1, &ibo);
 		ibo = 0;
 	}
+
+	bufferCapacity = 0;
 	
 	// vao is released on RenderNode
 
@@ -326,7 +340,7 @@ bool Voxel::UI::Text::updateMouseMove(const glm::vec2 & mousePosition, const glm
 			auto rit = children.rbegin();
 			for (; rit != children.rend();)
 			{
-				bool result = (rit->second)->updateMouseMove(mousePosition, mouseDelta);
+				bool result = (rit->second)->updateMouseMoveCulled(mousePosition, mouseDelta);
 				if (result)
 				{
 					// child hovered
@@ -346,7 +360,7 @@ bool Voxel::UI::Text::updateMouseMove(const glm::vec2 & mousePosition, const glm
 
 				for (; rit != children.rend(); rit++)
 				{
-					(rit->second)->updateMouseMoveFalse();
+					(rit->second)->updateMouseMoveFalseCulled();
 				}
 
 				updateMouseMoveFalse();
@@ -446,7 +460,7 @@ bool Voxel::UI::Text::updateMouseRelease(const glm::vec2 & mousePosition, const
 }
 
 
-bool Voxel::UI::Text::computeLineSizes(std::vector<std::string>& lines, std::vector<LineSize>& lineSizes, int & maxWidth)
+bool Voxel::UI::Text::computeLineSizes(std::vector<LineSize>& lineSizes, int & maxWidth)
 {
 	// get white space advance
 	Glyph* glyph = font->getGlyph(32);
@@ -454,23 +468,47 @@ bool Voxel::UI::Text::computeLineSizes(std::vector<std::string>& lines, std::vec
 	if (glyph == nullptr) return false;
 
 	const int whiteSpaceAdvnace = glyph->advance;
+	const int whiteSpaceHeight = glyph->height;
+
+	// Count lines. Same as splitting text with getline, last new line char doesn't make empty line.
+	const unsigned int textLength = static_cast<unsigned int>(text.size());
+	unsigned int lineCount = static_cast<unsigned int>(std::count(text.begin(), text.end(), '\n'));
+
+	if (textLength > 0 && text.back() != '\n')
+	{
+		lineCount++;
+	}
+
+	// Resize instead of clear. Line sizes that remain keep their sub line size buffer.
+	lineSizes.resize(lineCount);
+
+	// Start of current line in text
+	unsigned int lineBegin = 0;
 
 	// Iterate per line. Find the maximum width and height
-	for (auto& line : lines)
+	for (auto& lineSize : lineSizes)
 	{
-		// create line size
-		lineSizes.push_back(LineSize());
+		// Find end of line
+		unsigned int lineEnd = lineBegin;
+		while (lineEnd < textLength && text[lineEnd] != '\n')
+		{
+			lineEnd++;
+		}
 
-		// get ref
-		LineSize& lineSize = lineSizes.back();
+		// reset
+		lineSize.subLineSizes.clear();
+		lineSize.maxX = 0;
+		lineSize.maxBearingY = 0;
+		lineSize.maxBotY = 0;
 
-		if (line.empty())
+		if (lineBegin == lineEnd)
 		{
 			lineSize.subLineSizes.push_back(SubLineSize());
 			lineSize.subLineSizes.back().width = 0;
-			lineSize.subLineSizes.back().maxBearingY = font->getGlyph(32/* whitespace */)->height;
+			lineSize.subLineSizes.back().maxBearingY = whiteSpaceHeight;
 			lineSize.subLineSizes.back().maxBotY = 0;
-			lineSize.subLineSizes.back().text = "";
+			lineSize.subLineSizes.back().textBegin = lineBegin;
+			lineSize.subLineSizes.back().textEnd = lineBegin;
 
 			lineSize.maxX = 0;
 			lineSize.maxBearingY = lineSize.subLineSizes.back().maxBearingY;
@@ -485,9 +523,6 @@ bool Voxel::UI::Text::computeLineSizes(std::vector<std::string>& lines, std::vec
 		int maxBearingY = 0;
 		int maxBotY = 0;
 
-		// get length of line
-		unsigned int len = line.size();
-		
 		// Mesure size of the word.
 		unsigned int currentWordWith = 0;
 
@@ -498,13 +533,13 @@ bool Voxel::UI::Text::computeLineSizes(std::vector<std::string>& lines, std::vec
 		int currentMaxBearingY = 0;
 		int currentMaxBotY = 0;
 
-		// sub line text
-		std::string subLineText = "";
-		std::string currentWord = "";
+		// Start of current sub line and current word in text
+		unsigned int subLineBegin = lineBegin;
+		unsigned int wordBegin = lineBegin;
 
-		for (unsigned int i = 0; i < len; i++)
+		for (unsigned int i = lineBegin; i < lineEnd; i++)
 		{
-			const char c = line[i];
+			const char c = text[i];
 			Glyph* glyph = font->getGlyph((int)c);
 
 			// Advance value is the distance between pen position of each character in horizontal layout
@@ -522,7 +557,7 @@ bool Voxel::UI::Text::computeLineSizes(std::vector<std::string>& lines, std::vec
 			}
 			else
 			{
-				if (i == (len - 1))
+				if (i == (lineEnd - 1))
 				{
 					// If character is
 					charWidth = (glyph->bearingX + glyph->width);
@@ -538,8 +573,6 @@ bool Voxel::UI::Text::computeLineSizes(std::vector<std::string>& lines, std::vec
 			{
 				// if char is not whitespace, measure world size
 				currentWordWith += charWidth;
-				// append char to current word
-				currentWord.append(1, c);
 			}
 
 			// First, check if word can even fit on line break with. If so, continue. Else, invalid text. If line break width is smaller than single word's width, we can't render anything.
@@ -564,26 +597,23 @@ bool Voxel::UI::Text::computeLineSizes(std::vector<std::string>& lines, std::vec
 				{
 					// last char added was whitespace. This means all words in this sub line fits line break width. 
 					sls.width = currentLineWidth - charWidth;
-					if (subLineText.empty())
-					{
-						sls.text = currentWord;
-					}
-					else
-					{
-						sls.text = subLineText + " " + currentWord;
-					}
-					currentWord = "";
+					sls.textBegin = subLineBegin;
+					sls.textEnd = i;
+					subLineBegin = i + 1;
 					currentLineWidth = 0;
 				}
 				else
 				{
 					// last char add wasn't whitesapce. sub line's width is current line with widhotu current word width
 					sls.width = currentLineWidth - currentWordWith;
-					if (subLineText.empty() == false)
+					if (wordBegin > subLineBegin)
 					{
 						sls.width -= whiteSpaceAdvnace;
 					}
-					sls.text = subLineText;
+					// Sub line ends before whitespace in front of current word.
+					sls.textBegin = subLineBegin;
+					sls.textEnd = (wordBegin > subLineBegin) ? (wordBegin - 1) : subLineBegin;
+					subLineBegin = wordBegin;
 					currentLineWidth = currentWordWith;
 				}
 
@@ -596,8 +626,6 @@ bool Voxel::UI::Text::computeLineSizes(std::vector<std::string>& lines, std::vec
 				sls.maxBearingY = currentMaxBearingY;
 				sls.maxBotY = currentMaxBotY;
 
-				subLineText = "";
-
 				maxX = glm::max(sls.width, maxX);
 
 				currentMaxBearingY = 0;
@@ -616,21 +644,12 @@ bool Voxel::UI::Text::computeLineSizes(std::vector<std::string>& lines, std::vec
 			maxBotY = glm::max(maxBotY, glyph->botY);
 			currentMaxBotY = glm::max(currentMaxBotY, glyph->botY);
 
-			// If char was whitespace, reset world size and word str
+			// If char was whitespace, reset world size and word start
 			if (whitespace)
 			{
 				charWidth = 0;
 
-				if (subLineText.empty())
-				{
-					subLineText = currentWord;
-				}
-				else
-				{
-					subLineText += (" " + currentWord);
-				}
-
-				currentWord = "";
+				wordBegin = i + 1;
 				currentWordWith = 0;
 			}
 		}
@@ -651,14 +670,8 @@ bool Voxel::UI::Text::computeLineSizes(std::vector<std::string>& lines, std::vec
 		sls.maxBearingY = currentMaxBearingY;
 		sls.maxBotY = currentMaxBotY;
 
-		if (subLineText.empty())
-		{
-			sls.text = currentWord;
-		}
-		else
-		{
-			sls.text = subLineText + " " + currentWord;
-		}
+		sls.textBegin = subLineBegin;
+		sls.textEnd = lineEnd;
 
 		maxX = glm::max(sls.width, maxX);
 
@@ -685,6 +698,9 @@ bool Voxel::UI::Text::computeLineSizes(std::vector<std::string>& lines, std::vec
 		maxWidth = glm::max(maxX, maxWidth);
 
 		totalLines += lineSize.subLineSizes.size();
+
+		// Next line starts after new line char
+		lineBegin = lineEnd + 1;
 	
 		// end of current line size
 	}
@@ -748,41 +764,22 @@ bool Voxel::UI::Text::buildMesh(const bool reallocate)
 		// set texture
 		texture = font->getTexture();
 
+		// Glyphs are rasterized while building mesh, which can repack atlas. Render checks this and rebuilds.
+		atlasVersion = font->getAtlasVersion();
+
 		totalLines = 0;
 		
 		// Step 0 done.
 
 
 
-		// Step 1. Split text by new line ------------
-
-		// Split text label by line
-		std::vector<std::string> split;
-		// Turn the string into a stream.
-		std::stringstream ss(text);
-		// token (line)
-		std::string tok;
-
-		// iterate and get line by new line char
-		while (getline(ss, tok, '\n'))
-		{
-			split.push_back(tok);
-		}
-
-		// Step 1 done.
-
-
-
-
 		// Step 2. Compute line sizes, max width and total height ------------
 
 		// This is where we store each line's size so we can properly reposition all character based on align type
 		int maxWidth = 0;
 
-		// Compute line sizes
-		lineSizes.clear();
-
-		bool result = computeLineSizes(split, lineSizes, maxWidth);
+		// Compute line sizes. Lines are read from text directly.
+		bool result = computeLineSizes(lineSizes, maxWidth);
 
 		if (!result)
 		{
@@ -842,6 +839,8 @@ bool Voxel::UI::Text::buildMesh(const bool reallocate)
 
 		contentSize = boundingBox.size;
 
+		markBoundingVolumeDirty();
+
 		// Step 3 done.
 
 
@@ -855,15 +854,10 @@ bool Voxel::UI::Text::buildMesh(const bool reallocate)
 
 
 
-		// We have pen position for each line. Iterate line and build vertices based on 
-		int penPosIndex = 0;
+		// Step 5. Build quads ------------
 
-		std::vector<float> vertices;
-		// colors, indices and uv doesn't have to be tralsated later.
-		std::vector<float> colors;
-		std::vector<unsigned int> indices;
-		std::vector<float> uvVertices;
-		unsigned int indicesIndex = 0;
+		// We have pen position for each line. Iterate line and build quads. Quads are written over previous mesh, so only changed quads are uploaded.
+		unsigned int quadIndex = 0;
 
 		textSize = 0;	// Doesn't include escaped keys like new line
 
@@ -874,14 +868,12 @@ bool Voxel::UI::Text::buildMesh(const bool reallocate)
 				float penPosX = subLineSize.penPosition.x;
 				float penPosY = subLineSize.penPosition.y;
 
-				unsigned int len = subLineSize.text.size();
-
-				textSize += len;
+				textSize += (subLineSize.textEnd - subLineSize.textBegin);
 
-				for (unsigned int i = 0; i < len; i++)
+				for (unsigned int i = subLineSize.textBegin; i < subLineSize.textEnd; i++)
 				{
 					// Build quad for each character
-					const char c = subLineSize.text[i];
+					const char c = text[i];
 					Glyph* glyph = font->getGlyph((int)c);
 
 					// Empty pos. p1 = left bottom, p2 = right top. z == 0
@@ -906,46 +898,24 @@ bool Voxel::UI::Text::buildMesh(const bool reallocate)
 					// Advnace pen pos x to next char
 					penPosX += glyph->advance;
 
-					// Store left bttom and right top vertices pos
-					vertices.push_back(leftBottom.x); vertices.push_back(leftBottom.y); vertices.push_back(0);	// left bottom
-					vertices.push_back(leftBottom.x); vertices.push_back(rightTop.y); vertices.push_back(0);	// left top
-					vertices.push_back(rightTop.x); vertices.push_back(leftBottom.y); vertices.push_back(0);		// right bottom
-					vertices.push_back(rightTop.x); vertices.push_back(rightTop.y); vertices.push_back(0);		// right top
-
 					// add char bounding box relative to origin
 					// Todo: Support character bounding box check for input field. 
 					//subLineSize.characterBoundingBoxes.push_back(Voxel::Shape::Rect(glm::vec2(leftBottom.x + (rightTop.x * 0.5f)), glm::abs(rightTop - leftBottom)));
 
-					// color
-					for (int j = 0; j < 4; j++)
-					{
-						colors.push_back(color.r);
-						colors.push_back(color.g);
-						colors.push_back(color.b);
-					}
-
-					// uv.
-					uvVertices.push_back(glyph->uvTopLeft.x); uvVertices.push_back(glyph->uvBotRight.y);	// Left bottom
-					uvVertices.push_back(glyph->uvTopLeft.x); uvVertices.push_back(glyph->uvTopLeft.y);		// Left top
-					uvVertices.push_back(glyph->uvBotRight.x); uvVertices.push_back(glyph->uvBotRight.y);	// right bottom
-					uvVertices.push_back(glyph->uvBotRight.x); uvVertices.push_back(glyph->uvTopLeft.y);	// right top
-
-					// indices. range of 4 per quad.
-					indices.push_back(indicesIndex * 4);
-					indices.push_back(indicesIndex * 4 + 1);
-					indices.push_back(indicesIndex * 4 + 2);
-					indices.push_back(indicesIndex * 4 + 1);
-					indices.push_back(indicesIndex * 4 + 2);
-					indices.push_back(indicesIndex * 4 + 3);
+					setQuad(quadIndex, leftBottom, rightTop, glyph->uvTopLeft, glyph->uvBotRight);
 
 					// inc index
-					indicesIndex++;
+					quadIndex++;
 				}
 			}
 		}
+
+		quadCount = quadIndex;
+
+		// Step 5 done.
 		
 		// load buffer
-		loadBuffers(vertices, colors, uvVertices, indices, reallocate);
+		loadBuffers(reallocate);
 
 		updateModelMatrix();
 		updateBoundingBox();
@@ -964,13 +934,92 @@ bool Voxel::UI::Text::buildMesh(const bool reallocate)
 	}
 }
 
-void Voxel::UI::Text::loadBuffers(const std::vector<float>& vertices, const std::vector<float>& colors, const std::vector<float>& uvs, const std::vector<unsigned int>& indices, const bool reallocate)
+void Voxel::UI::Text::setQuad(const unsigned int index, const glm::vec2 & leftBottom, const glm::vec2 & rightTop, const glm::vec2 & uvTopLeft, const glm::vec2 & uvBotRight)
+{
+	const unsigned int vertexOffset = index * 12;
+	const unsigned int uvOffset = index * 8;
+
+	bool changed = false;
+
+	if (meshVertices.size() < vertexOffset + 12)
+	{
+		// New quad. Buffers only grow
+		meshVertices.resize(vertexOffset + 12, 0.0f);
+		meshColors.resize(vertexOffset + 12, 0.0f);
+		meshUVs.resize(uvOffset + 8, 0.0f);
+
+		changed = true;
+	}
+
+	const float vertices[12] =
+	{
+		leftBottom.x, leftBottom.y, 0.0f,	// left bottom
+		leftBottom.x, rightTop.y, 0.0f,		// left top
+		rightTop.x, leftBottom.y, 0.0f,		// right bottom
+		rightTop.x, rightTop.y, 0.0f,		// right top
+	};
+
+	const float uvs[8] =
+	{
+		uvTopLeft.x, uvBotRight.y,		// Left bottom
+		uvTopLeft.x, uvTopLeft.y,		// Left top
+		uvBotRight.x, uvBotRight.y,		// right bottom
+		uvBotRight.x, uvTopLeft.y,		// right top
+	};
+
+	// Compare with previous build while writing
+	for (unsigned int i = 0; i < 12; i++)
+	{
+		const float c = color[i % 3];
+
+		if (meshVertices[vertexOffset + i] != vertices[i] || meshColors[vertexOffset + i] != c)
+		{
+			meshVertices[vertexOffset + i] = vertices[i];
+			meshColors[vertexOffset + i] = c;
+			changed = true;
+		}
+	}
+
+	for (unsigned int i = 0; i < 8; i++)
+	{
+		if (meshUVs[uvOffset + i] != uvs[i])
+		{
+			meshUVs[uvOffset + i] = uvs[i];
+			changed = true;
+		}
+	}
+
+	if (changed)
+	{
+		dirtyBegin = glm::min(dirtyBegin, index);
+		dirtyEnd = glm::max(dirtyEnd, index + 1);
+	}
+}
+
+void Voxel::UI::Text::loadBuffers(const bool reallocate)
 {
-	if (reallocate)
+	if (reallocate || quadCount > bufferCapacity || vao == 0)
 	{
 		// reallocate buffer
 		//clear();
 
+		// Reserve some space, so text that grows by few characters (numbers, etc) doesn't reallocate
+		bufferCapacity = glm::max(((quadCount + 15) / 16) * 16, 16u);
+
+		// Indices never change. Fill for entire capacity and upload only here.
+		meshIndices.reserve(bufferCapacity * 6);
+
+		for (unsigned int i = static_cast<unsigned int>(meshIndices.size()) / 6; i < bufferCapacity; i++)
+		{
+			// indices. range of 4 per quad.
+			meshIndices.push_back(i * 4);
+			meshIndices.push_back(i * 4 + 1);
+			meshIndices.push_back(i * 4 + 2);
+			meshIndices.push_back(i * 4 + 1);
+			meshIndices.push_back(i * 4 + 2);
+			meshIndices.push_back(i * 4 + 3);
+		}
+
 		// check program
 		if (program == nullptr)
 		{
@@ -1001,16 +1050,19 @@ void Voxel::UI::Text::loadBuffers(const std::vector<float>& vertices, const std:
 		// bind
 		glBindBuffer(GL_ARRAY_BUFFER, vbo);
 
-		// Allocate empty buffer for max length. 12 vertices(4 vec3) per char * max length
-		glBufferData(GL_ARRAY_BUFFER, sizeof(float) * textSize * 12, nullptr, GL_DYNAMIC_DRAW);
+		// Allocate empty buffer for capacity. 12 vertices(4 vec3) per char * capacity
+		glBufferData(GL_ARRAY_BUFFER, sizeof(float) * bufferCapacity * 12, nullptr, GL_DYNAMIC_DRAW);
 		// fill buffer
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float) * vertices.size(), &vertices.front());
+		if (quadCount > 0)
+		{
+			glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float) * quadCount * 12, &meshVertices.front());
+		}
 		// enable location
 		glEnableVertexAttribArray(vertLoc);
-		// set
+		// Set attribute
 		glVertexAttribPointer(vertLoc, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
 
-		// get color location
+		// Get color location
 		GLint colorLoc = program->getAttribLocation("color");
 
 		// if cbo is 0, gen
@@ -1023,10 +1075,13 @@ void Voxel::UI::Text::loadBuffers(const std::vector<float>& vertices, const std:
 		// bind
 		glBindBuffer(GL_ARRAY_BUFFER, cbo);
 
-		// Allocate empty buffer for max length. 12 vertices(4 vec3) per char * max length
-		glBufferData(GL_ARRAY_BUFFER, sizeof(float) * textSize * 12, nullptr, GL_DYNAMIC_DRAW);
+		// Allocate empty buffer for capacity. 12 vertices(4 vec3) per char * capacity
+		glBufferData(GL_ARRAY_BUFFER, sizeof(float) * bufferCapacity * 12, nullptr, GL_DYNAMIC_DRAW);
 		// fill buffer
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float) * colors.size(), &colors.front());
+		if (quadCount > 0)
+		{
+			glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float) * quadCount * 12, &meshColors.front());
+		}
 		// enable location
 		glEnableVertexAttribArray(colorLoc);
 		// set
@@ -1045,10 +1100,13 @@ void Voxel::UI::Text::loadBuffers(const std::vector<float>& vertices, const std:
 		// bind
 		glBindBuffer(GL_ARRAY_BUFFER, uvbo);
 
-		// Allocate empty buffer for max length. 8 verticies (4 vec2) per char * max len
-		glBufferData(GL_ARRAY_BUFFER, sizeof(float) * textSize * 8, nullptr, GL_DYNAMIC_DRAW);
+		// Allocate empty buffer for capacity. 8 verticies (4 vec2) per char * capacity
+		glBufferData(GL_ARRAY_BUFFER, sizeof(float) * bufferCapacity * 8, nullptr, GL_DYNAMIC_DRAW);
 		// fill buffer
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float) * uvs.size(), &uvs.front());
+		if (quadCount > 0)
+		{
+			glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float) * quadCount * 8, &meshUVs.front());
+		}
 		// enable
 		glEnableVertexAttribArray(uvVertLoc);
 		// set
@@ -1064,44 +1122,37 @@ void Voxel::UI::Text::loadBuffers(const std::vector<float>& vertices, const std:
 		// bind
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
 
-		// Allocate empty buffer for max length. 6 indices ( 2 tri) per char * max len
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * textSize * 8, nullptr, GL_DYNAMIC_DRAW);
-		// fill buffer
-		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(unsigned int) * indices.size(), &indices.front());
+		// Indices for entire capacity. 6 indices (2 tri) per char
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * bufferCapacity * 6, &meshIndices.front(), GL_DYNAMIC_DRAW);
 		// indices don't have to enable and set.
 
-		// get size
-		indicesSize = indices.size();
-
 		// unbind
 		glBindVertexArray(0);
 	}
-	else
+	else if (dirtyBegin < dirtyEnd)
 	{
-		// No need to reallocate buffer.
-
-		// bind vao
-		glBindVertexArray(vao);
+		// No need to reallocate buffer. Only upload quads that changed.
+		const unsigned int dirtyCount = dirtyEnd - dirtyBegin;
 
 		// bind vbo
 		glBindBuffer(GL_ARRAY_BUFFER, vbo);
 		// update data
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float) * vertices.size(), &vertices.front());
+		glBufferSubData(GL_ARRAY_BUFFER, sizeof(float) * dirtyBegin * 12, sizeof(float) * dirtyCount * 12, &meshVertices[dirtyBegin * 12]);
 
 		glBindBuffer(GL_ARRAY_BUFFER, cbo);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float) * colors.size(), &colors.front());
+		glBufferSubData(GL_ARRAY_BUFFER, sizeof(float) * dirtyBegin * 12, sizeof(float) * dirtyCount * 12, &meshColors[dirtyBegin * 12]);
 
 		glBindBuffer(GL_ARRAY_BUFFER, uvbo);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float) * uvs.size(), &uvs.front());
-
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
-		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(float) * indices.size(), &indices.front());
+		glBufferSubData(GL_ARRAY_BUFFER, sizeof(float) * dirtyBegin * 8, sizeof(float) * dirtyCount * 8, &meshUVs[dirtyBegin * 8]);
+	}
+	// Else, nothing changed.
 
-		// update size
-		indicesSize = indices.size();
+	// update size
+	indicesSize = quadCount * 6;
 
-		glBindVertexArray(0);
-	}
+	// Everything is uploaded
+	dirtyBegin = std::numeric_limits<unsigned int>::max();
+	dirtyEnd = 0;
 
 #if V_DEBUG && V_DEBUG_DRAW_UI_BOUNDING_BOX && V_DEBUG_DRAW_TEXT_BOUNDING_BOX
 	if (bbVao)
@@ -1291,6 +1342,45 @@ std::vector<glm::vec2> Voxel::UI::Text::computeOrigins(Font * font, const std::v
 	return originList;
 }
 
+bool Voxel::UI::Text::appendBatch(BatchRenderer & batchRenderer)
+{
+#if V_DEBUG && V_DEBUG_DRAW_UI_BOUNDING_BOX && V_DEBUG_DRAW_TEXT_BOUNDING_BOX
+	// Bounding box is drawn in renderSelf
+	return false;
+#else
+	if (text.empty() || font == nullptr || texture == nullptr || textSize == 0)
+	{
+		// Nothing to draw. Doesn't break batch.
+		return true;
+	}
+
+	if (atlasVersion != font->getAtlasVersion())
+	{
+		// Atlas was repacked after prepareBatch by another text. Uvs are invalid. Skip this frame and rebuild on next prepareBatch.
+		return true;
+	}
+
+	if (indicesSize == 0) return true;
+
+	batchRenderer.appendTextGeometry(texture, meshVertices, meshColors, meshUVs, meshIndices, indicesSize, glm::scale(modelMat, glm::vec3(scale, 1)), opacity, outlined, outlineColor);
+
+	return true;
+#endif
+}
+
+void Voxel::UI::Text::prepareBatch()
+{
+	if (!visibility) return;
+
+	if (font && !text.empty() && atlasVersion != font->getAtlasVersion())
+	{
+		// Font atlas has been repacked since mesh was built. Uvs are invalid. Rebuilding uploads buffers, so it can't be done while building batch.
+		buildMesh(false);
+	}
+
+	TransformNode::prepareBatch();
+}
+
 void Voxel::UI::Text::renderSelf()
 {
 	if (indicesSize == 0) return;
@@ -1300,10 +1390,16 @@ void Voxel::UI::Text::renderSelf()
 	if (program == nullptr) return;
 	if (textSize == 0) return;
 
+	if (atlasVersion != font->getAtlasVersion())
+	{
+		// Font atlas has been repacked since mesh was built. Uvs are invalid.
+		buildMesh(false);
+	}
+
 	program->use(true);
-	program->setUniformMat4("modelMat", glm::scale(modelMat, glm::vec3(scale, 1)));
-	program->setUniformFloat("opacity", opacity);
-	program->setUniformVec3("color", color);
+	program->setUniformMat4(SID("modelMat"), glm::scale(modelMat, glm::vec3(scale, 1)));
+	program->setUniformFloat(SID("opacity"), opacity);
+	program->setUniformVec3(SID("color"), color);
 
 	texture->activate(GL_TEXTURE0);
 	texture->bind();
@@ -1311,17 +1407,17 @@ void Voxel::UI::Text::renderSelf()
 
 	if (outlined)
 	{
-		program->setUniformBool("outlined", true);
-		program->setUniformInt("outlineSize", 2);
-		program->setUniformVec3("outlineColor", outlineColor);
+		program->setUniformBool(SID("outlined"), true);
+		program->setUniformInt(SID("outlineSize"), 2);
+		program->setUniformVec3(SID("outlineColor"), outlineColor);
 
 		auto textureSize = texture->getTextureSize();
-		program->setUniformFloat("textureWidth", static_cast<float>(textureSize.x));
-		program->setUniformFloat("textureHeight", static_cast<float>(textureSize.y));
+		program->setUniformFloat(SID("textureWidth"), static_cast<float>(textureSize.x));
+		program->setUniformFloat(SID("textureHeight"), static_cast<float>(textureSize.y));
 	}
 	else
 	{
-		program->setUniformBool("outlined", false);
+		program->setUniformBool(SID("outlined"), false);
 	}
 
 	if (vao)
@@ -1335,9 +1431,9 @@ void Voxel::UI::Text::renderSelf()
 	{
 		auto lineProgram = ProgramManager::getInstance().getProgram(Voxel::ProgramManager::PROGRAM_NAME::LINE_SHADER);
 		lineProgram->use(true);
-		lineProgram->setUniformMat4("modelMat", modelMat);
-		lineProgram->setUniformMat4("viewMat", glm::mat4(1.0f));
-		lineProgram->setUniformVec4("lineColor", glm::vec4(1.0f));
+		lineProgram->setUniformMat4(SID("modelMat"), modelMat);
+		lineProgram->setUniformMat4(SID("viewMat"), glm::mat4(1.0f));
+		lineProgram->setUniformVec4(SID("lineColor"), glm::vec4(1.0f));
 
 		glBindVertexArray(bbVao);
 		glDrawArrays(GL_LINES, 0, lineIndicesSize);
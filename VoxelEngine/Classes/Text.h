@@ -1,6 +1,9 @@
 #ifndef TEXT_H
 #define TEXT_H
 
+// boost
+#include <boost\utility\string_view.hpp>
+
 // voxel
 #include "RenderNode.h"
 
@@ -43,15 +46,16 @@ namespace Voxel
 			{
 			public:
 				// Constructor
-				SubLineSize() : width(0), maxBearingY(0), maxBotY(0), penPosition(0.0f) {}
+				SubLineSize() : width(0), maxBearingY(0), maxBotY(0), textBegin(0), textEnd(0), penPosition(0.0f) {}
 				// width
 				int width;
 				// max bearing of line
 				int maxBearingY;
 				// max bot of line
 				int maxBotY;
-				// line text
-				std::string text;
+				// Range of line text in text. [textBegin, textEnd)
+				unsigned int textBegin;
+				unsigned int textEnd;
 				// pen position
 				glm::vec2 penPosition;
 				// Character bounding box
@@ -109,6 +113,28 @@ namespace Voxel
 			// total lines
 			unsigned int totalLines;
 
+			// Font's atlas version when mesh was built. Mesh is rebuilt if font repacked atlas.
+			unsigned int atlasVersion;
+
+			// Mesh data. Kept between builds, so updating text doesn't allocate and only quads that changed are uploaded.
+			std::vector<float> meshVertices;
+			std::vector<float> meshColors;
+			std::vector<float> meshUVs;
+			std::vector<unsigned int> meshIndices;
+
+			// Number of quads in mesh
+			unsigned int quadCount;
+
+			// Number of quads that gl buffers can hold
+			unsigned int bufferCapacity;
+
+			// Get number of quads that text builds. Each character except new line is a quad.
+			static unsigned int getQuadCount(const boost::string_view& text);
+
+			// Range of quads that changed since last upload. [dirtyBegin, dirtyEnd)
+			unsigned int dirtyBegin;
+			unsigned int dirtyEnd;
+
 			// line sizes
 			std::vector<LineSize> lineSizes;
 
@@ -137,9 +163,10 @@ namespace Voxel
 			/**
 			*	Compute line size and max width
 			*	Each line size contains width, max bearing y and max bot y.
+			*	Line sizes are resized, not cleared, so sub line sizes reuse their buffers.
 			*	@return true if successfully computed line sizes. false if text can't fit in lineBreakWidth
 			*/
-			bool computeLineSizes(std::vector<std::string>& lines, std::vector<LineSize>& lineSizes, int& maxWidth);
+			bool computeLineSizes(std::vector<LineSize>& lineSizes, int& maxWidth);
 
 			/**
 			*	Compute pen position.
@@ -155,14 +182,21 @@ namespace Voxel
 			bool buildMesh(const bool reallocate);
 
 			/**
-			*	Load buffers.
-			*	@param vertices Text vertices.
-			*	@param color Text colors.
-			*	@param uvs Texture coordinates for each character
-			*	@param indices Indices for rendering
+			*	Write quad to mesh data. Marks quad dirty if it's different from previous build.
+			*	@param index Index of quad.
+			*	@param leftBottom Left bottom position of quad.
+			*	@param rightTop Right top position of quad.
+			*	@param uvTopLeft Top left texture coordinate.
+			*	@param uvBotRight Bottom right texture coordinate.
+			*/
+			void setQuad(const unsigned int index, const glm::vec2& leftBottom, const glm::vec2& rightTop, const glm::vec2& uvTopLeft, const glm::vec2& uvBotRight);
+
+			/**
+			*	Load mesh data to buffers.
+			*	Reallocates if requested or quads exceed buffer capacity. Else, only uploads dirty quads.
 			*	@param reallocate true if it needs to reallocate buffer. Else, false.
 			*/
-			void loadBuffers(const std::vector<float>& vertices, const std::vector<float>& colors, const std::vector<float>& uvs, const std::vector<unsigned int>& indices, const bool reallocate);
+			void loadBuffers(const bool reallocate);
 			
 			// Update text mouse move
 			bool updateTextMouseMove(const glm::vec2& mousePosition, const glm::vec2& mouseDelta);
@@ -195,10 +229,10 @@ namespace Voxel
 
 			/**
 			*	Sets text.
-			*	Rebuild buffer and updates
-			*	@param text A string text to set.
+			*	Rebuild buffer and updates. Text is copied in to existing string, so it doesn't allocate unless text gets longer than before.
+			*	@param text A string text to set. Can be std::string or const char*.
 			*/
-			void setText(const std::string& text);
+			void setText(const boost::string_view& text);
 
 			/**
 			*	Get text
@@ -244,6 +278,16 @@ namespace Voxel
 			bool updateMouseRelease(const glm::vec2& mousePosition, const int button) override;
 			void updateMouseMoveFalse() override;
 
+			/**
+			*	Append glyph quads to batch with text shader.
+			*/
+			bool appendBatch(BatchRenderer& batchRenderer) override;
+
+			/**
+			*	Rebuild mesh if font atlas was repacked since mesh was built.
+			*/
+			void prepareBatch() override;
+
 			/**
 			*	Render self
 			*/
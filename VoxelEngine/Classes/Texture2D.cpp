@@ -16,6 +16,22 @@ using namespace Voxel;
 
 const std::string Texture2D::DEFAULT_TEXTURE_PATH = "textures/";
 
+Voxel::Texture2D::DecodedImage::DecodedImage()
+	: data(nullptr)
+	, width(0)
+	, height(0)
+	, channel(0)
+	, ownsData(true)
+{}
+
+Voxel::Texture2D::DecodedImage::~DecodedImage()
+{
+	if (data && ownsData)
+	{
+		stbi_image_free(data);
+	}
+}
+
 Texture2D::Texture2D()
 	: textureObject(0)
 	, textureLocation(-1)
@@ -72,7 +88,7 @@ Texture2D * Voxel::Texture2D::createSpriteSheetTexture(const std::string & textu
 		if (newTexture->initUISpriteSheetTexture(textureName, textureTarget))
 		{
 			newTexture->name = rawName;
-			tm.addTexture(textureName, newTexture);
+			tm.addTexture(rawName, newTexture);
 			return newTexture;
 		}
 		else
@@ -108,11 +124,56 @@ Texture2D * Voxel::Texture2D::createFontTexture(const std::string& textureName,
 	}
 }
 
+bool Voxel::Texture2D::decodeImage(const std::string & textureName, DecodedImage & image)
+{
+	image.data = loadImage(textureName, image.width, image.height, image.channel);
+
+	return image.data != nullptr && image.width != 0 && image.height != 0 && image.channel != 0;
+}
+
+Texture2D * Voxel::Texture2D::createFromDecodedImage(const std::string & textureName, const DecodedImage & image, GLenum textureTarget, const bool spriteSheet)
+{
+	auto& tm = TextureManager::getInstance();
+
+	std::string rawName = Utility::String::removeFileExtFromFileName(textureName);
+
+	if (tm.hasTexture(rawName))
+	{
+		return tm.getTexture(rawName).get();
+	}
+	else
+	{
+		auto newTexture = new Texture2D();
+		if (newTexture->initWithDecodedImage(image, textureTarget, spriteSheet))
+		{
+			newTexture->name = rawName;
+			tm.addTexture(rawName, newTexture);
+			return newTexture;
+		}
+		else
+		{
+			delete newTexture;
+			return nullptr;
+		}
+	}
+}
+
 glm::ivec2 Voxel::Texture2D::getTextureSize()
 {
 	return glm::ivec2(width, height);
 }
 
+void Voxel::Texture2D::resizeFontTexture(const int width, const int height)
+{
+	glBindTexture(GL_TEXTURE_2D, this->textureObject);
+
+	// Same format as initFontTexture
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, 0);
+
+	this->width = width;
+	this->height = height;
+}
+
 void Voxel::Texture2D::setLocationOnProgram(ProgramManager::PROGRAM_NAME programName)
 {
 	//ProgramManager::getInstance().getDefaultProgram(programName)->use(true);
@@ -391,6 +452,30 @@ bool Voxel::Texture2D::initUISpriteSheetTexture(const std::string & textureName,
 	}
 }
 
+bool Voxel::Texture2D::initWithDecodedImage(const DecodedImage & image, GLenum textureTarget, const bool spriteSheet)
+{
+	if (image.data == nullptr || image.width == 0 || image.height == 0 || image.channel == 0)
+	{
+		return false;
+	}
+
+	this->width = image.width;
+	this->height = image.height;
+	this->channel = image.channel;
+	this->textureTarget = textureTarget;
+
+	if (spriteSheet)
+	{
+		generate2DUISpriteSheetTexture(width, height, channel, image.data);
+	}
+	else
+	{
+		generate2DTexture(width, height, channel, image.data);
+	}
+
+	return true;
+}
+
 bool Voxel::Texture2D::initFontTexture(const int width, const int height, GLenum textureTarget)
 {
 	//allocate blank texture.
@@ -34,6 +34,31 @@ namespace Voxel
 		};
 
 		const static std::string DEFAULT_TEXTURE_PATH;
+
+		/**
+		*	@struct DecodedImage
+		*	@brief Pixels of image file that is decoded but not uploaded to GPU.
+		*
+		*	Decoding doesn't touch OpenGL, so it can be done on any thread (AssetLoader). Upload must be done on main thread.
+		*/
+		struct DecodedImage
+		{
+		public:
+			unsigned char* data;
+			int width;
+			int height;
+			int channel;
+
+			// False if data points to memory that image doesn't own (CookedSpriteSheet)
+			bool ownsData;
+
+			DecodedImage();
+			~DecodedImage();
+
+			// Delete copy
+			DecodedImage(DecodedImage const&) = delete;
+			DecodedImage& operator=(DecodedImage const&) = delete;
+		};
 	private:
 		// Constructor
 		Texture2D();
@@ -53,8 +78,8 @@ namespace Voxel
 		// channel of texture
 		int channel;
 
-		// load image file
-		unsigned char* loadImage(const std::string& textureFilePath, int& width, int& height, int& channel);
+		// load image file. Doesn't use OpenGL.
+		static unsigned char* loadImage(const std::string& textureFilePath, int& width, int& height, int& channel);
 
 		// flip the image file vertically
 		void flipImage(unsigned char* data);
@@ -69,6 +94,9 @@ namespace Voxel
 		// initialize UI sprite sheet texture
 		bool initUISpriteSheetTexture(const std::string& textureName, GLenum textureTarget);
 
+		// initialize with decoded image
+		bool initWithDecodedImage(const DecodedImage& image, GLenum textureTarget, const bool spriteSheet);
+
 		// initialize font texture
 		bool initFontTexture(const int width, const int height, GLenum textureTarget);
 	public:
@@ -84,9 +112,30 @@ namespace Voxel
 		// create font texture
 		static Texture2D* createFontTexture(const std::string& textureName, const int width, const int height, GLenum textureTarget);
 
+		/**
+		*	Decode image file without uploading to GPU. Thread safe.
+		*	@param textureName Image file name in texture directory.
+		*	@param image Decoded image.
+		*	@return true if image is decoded.
+		*/
+		static bool decodeImage(const std::string& textureName, DecodedImage& image);
+
+		/**
+		*	Create texture with image that is decoded by decodeImage(). Must be called on main thread.
+		*	Returns existing texture if texture with same name already exists.
+		*	@param textureName Image file name. Same name that is used for decodeImage().
+		*	@param image Decoded image.
+		*	@param textureTarget OpenGL texture target.
+		*	@param spriteSheet true to create with UI sprite sheet filter and wrap. See createSpriteSheetTexture().
+		*/
+		static Texture2D* createFromDecodedImage(const std::string& textureName, const DecodedImage& image, GLenum textureTarget, const bool spriteSheet);
+
 		// get size of texture
 		glm::ivec2 getTextureSize();
 
+		// Reallocate font texture with new size. Previous content is discarded.
+		void resizeFontTexture(const int width, const int height);
+
 		// set texture's location on shader
 		void setLocationOnProgram(ProgramManager::PROGRAM_NAME programName);
 		void setLocationOnProgram(const GLint textureLocation);
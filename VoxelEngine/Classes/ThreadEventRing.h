@@ -0,0 +1,156 @@
+#ifndef THREAD_EVENT_RING_H
+#define THREAD_EVENT_RING_H
+
+// cpp
+#include <vector>
+#include <atomic>
+#include <cassert>
+
+namespace Voxel
+{
+	/**
+	*	@class ThreadEventRing
+	*	@brief Single producer single consumer ring buffer. Each thread that records events owns one.
+	*
+	*	Producer is thread that records and consumer is thread that collects (flusher, main thread),
+	*	so both sides only use atomic load and store. Never blocks producer. Events are dropped and counted while ring is full.
+	*	Ring of thread that ended can be given to new thread after it's drained. See acquire() and release().
+	*	Used by AsyncLogger and FrameProfiler.
+	*/
+	template<typename T>
+	class ThreadEventRing
+	{
+	private:
+		std::vector<T> events;
+		const unsigned int mask;
+
+		// Index of next event to write. Written by producer.
+		std::atomic<unsigned int> head;
+		// Keeps head and tail in different cache lines. alignas isn't honored by new before C++17.
+		char padding[64];
+		// Index of next event to read. Written by consumer.
+		std::atomic<unsigned int> tail;
+
+		// Number of events dropped because ring was full
+		std::atomic<unsigned long long> dropped;
+		// Dropped count that consumer took
+		unsigned long long reportedDropped;
+
+		// Index of thread that owns ring
+		std::atomic<unsigned int> threadIndex;
+
+		// True if thread that owned ring ended. Ring can be reused after it's drained.
+		std::atomic<bool> released;
+	public:
+		/**
+		*	Constructor
+		*	@param capacity Number of events. Must be power of 2.
+		*/
+		ThreadEventRing(const unsigned int capacity)
+			: events(capacity)
+			, mask(capacity - 1)
+			, head(0)
+			, tail(0)
+			, dropped(0)
+			, reportedDropped(0)
+			, threadIndex(0)
+			, released(false)
+		{
+			assert((capacity & mask) == 0);
+		}
+
+		// Destructor
+		~ThreadEventRing() = default;
+
+		/**
+		*	Get event to write. Returns nullptr if ring is full. Producer only.
+		*	Event is visible to consumer after commit().
+		*/
+		T* beginWrite()
+		{
+			const unsigned int h = head.load(std::memory_order_relaxed);
+
+			if (h - tail.load(std::memory_order_acquire) > mask)
+			{
+				// Full. Don't wait for consumer.
+				dropped.fetch_add(1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			return &events[h & mask];
+		}
+
+		// Publish event returned by beginWrite(). Producer only.
+		void commit()
+		{
+			head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		}
+
+		/**
+		*	Copy all committed events to end of out. Consumer only.
+		*	@return Number of events read.
+		*/
+		unsigned int drain(std::vector<T>& out)
+		{
+			const unsigned int t = tail.load(std::memory_order_relaxed);
+			const unsigned int h = head.load(std::memory_order_acquire);
+
+			for (unsigned int i = t; i != h; i++)
+			{
+				out.push_back(events[i & mask]);
+			}
+
+			tail.store(h, std::memory_order_release);
+
+			return h - t;
+		}
+
+		// Drop all committed events. Consumer only.
+		void skip()
+		{
+			tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+		}
+
+		// Check if there is no event to read
+		bool empty() const
+		{
+			return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+		}
+
+		// Take ownership for new thread
+		void acquire(const unsigned int threadIndex)
+		{
+			this->threadIndex.store(threadIndex);
+			released.store(false);
+		}
+
+		// Give up ownership. Called when thread ends.
+		void release()
+		{
+			released.store(true);
+		}
+
+		bool isReleased() const
+		{
+			return released.load();
+		}
+
+		unsigned int getThreadIndex() const
+		{
+			return threadIndex.load(std::memory_order_relaxed);
+		}
+
+		// Get number of dropped events since last call. Consumer only.
+		unsigned long long takeDropped()
+		{
+			const unsigned long long total = dropped.load(std::memory_order_relaxed);
+			const unsigned long long count = total - reportedDropped;
+
+			reportedDropped = total;
+
+			return count;
+		}
+	};
+}
+
+#endif
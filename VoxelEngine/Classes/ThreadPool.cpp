@@ -0,0 +1,170 @@
+// pch
+#include "PreCompiled.h"
+
+#include "ThreadPool.h"
+
+// cpp
+#include <memory>
+
+using namespace Voxel;
+
+Voxel::ThreadPool::ThreadPool(const unsigned int threadCount)
+{
+	running.store(true);
+
+	for (unsigned int i = 0; i < threadCount; i++)
+	{
+		workerThreads.push_back(std::thread(&ThreadPool::work, this));
+	}
+}
+
+Voxel::ThreadPool::~ThreadPool()
+{
+	{
+		// Scope lock
+		std::unique_lock<std::mutex> lock(queueMutex);
+
+		running.store(false);
+		taskQueue.clear();
+	}
+
+	cv.notify_all();
+
+	for (auto& thread : workerThreads)
+	{
+		if (thread.joinable())
+		{
+			thread.join();
+		}
+	}
+}
+
+void Voxel::ThreadPool::work()
+{
+	while (running)
+	{
+		std::function<void()> task;
+
+		{
+			// Scope lock
+			std::unique_lock<std::mutex> lock(queueMutex);
+
+			// wait if queue is empty. Must be running.
+			while (running && taskQueue.empty())
+			{
+				cv.wait(lock);
+			}
+
+			if (running == false)
+			{
+				// quit
+				break;
+			}
+
+			task = std::move(taskQueue.front());
+			taskQueue.pop_front();
+		}
+
+		task();
+	}
+}
+
+void Voxel::ThreadPool::addTask(const std::function<void()>& task)
+{
+	{
+		// Scope lock
+		std::unique_lock<std::mutex> lock(queueMutex);
+
+		taskQueue.push_back(task);
+	}
+
+	cv.notify_one();
+}
+
+void Voxel::ThreadPool::parallelFor(const unsigned int count, const unsigned int grainSize, const std::function<void(const unsigned int begin, const unsigned int end)>& func)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	const unsigned int grain = std::max(grainSize, 1u);
+	const unsigned int rangeCount = (count + grain - 1) / grain;
+
+	if (rangeCount == 1 || workerThreads.empty())
+	{
+		// Not worth to wake threads.
+		func(0, count);
+		return;
+	}
+
+	// Shared between calling thread and helper tasks. Helper task that starts after all ranges are done only reads counter, so calling thread doesn't wait for it.
+	struct State
+	{
+		std::function<void(const unsigned int, const unsigned int)> func;
+		std::atomic<unsigned int> nextRange;
+		std::atomic<unsigned int> doneRange;
+		std::mutex doneMutex;
+		std::condition_variable doneCV;
+	};
+
+	auto state = std::make_shared<State>();
+	state->func = func;
+	state->nextRange.store(0);
+	state->doneRange.store(0);
+
+	auto runRanges = [state, grain, count, rangeCount]()
+	{
+		unsigned int range = state->nextRange.fetch_add(1);
+
+		while (range < rangeCount)
+		{
+			const unsigned int begin = range * grain;
+			const unsigned int end = std::min(begin + grain, count);
+
+			state->func(begin, end);
+
+			if (state->doneRange.fetch_add(1) + 1 == rangeCount)
+			{
+				// Last range. Wake calling thread.
+				std::unique_lock<std::mutex> lock(state->doneMutex);
+				state->doneCV.notify_all();
+			}
+
+			range = state->nextRange.fetch_add(1);
+		}
+	};
+
+	// Calling thread takes 1 range, so only need rangeCount - 1 helpers at most.
+	const unsigned int helperCount = std::min(static_cast<unsigned int>(workerThreads.size()), rangeCount - 1);
+
+	{
+		// Scope lock
+		std::unique_lock<std::mutex> lock(queueMutex);
+
+		for (unsigned int i = 0; i < helperCount; i++)
+		{
+			taskQueue.push_back(runRanges);
+		}
+	}
+
+	cv.notify_all();
+
+	// Calling thread works too
+	runRanges();
+
+	{
+		// Wait for other threads to finish their ranges
+		std::unique_lock<std::mutex> lock(state->doneMutex);
+
+		while (state->doneRange.load() < rangeCount)
+		{
+			state->doneCV.wait(lock);
+		}
+	}
+}
+
+unsigned int Voxel::ThreadPool::getThreadCount() const
+{
+	return static_cast<unsigned int>(workerThreads.size());
+}
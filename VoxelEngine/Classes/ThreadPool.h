@@ -0,0 +1,77 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+// cpp
+#include <list>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+
+namespace Voxel
+{
+	/**
+	*	@class ThreadPool
+	*	@brief Fixed number of worker threads that runs general tasks.
+	*
+	*	Unlike ChunkWorkManager, which only processes chunk works in order, ThreadPool runs any task.
+	*	Use parallelFor to split large amount of independent work (raycasts, etc) across all threads.
+	*	Calling thread also works on parallelFor, so pool with 0 thread runs everything on calling thread.
+	*/
+	class ThreadPool
+	{
+	private:
+		// Worker threads
+		std::vector<std::thread> workerThreads;
+
+		// Queue of tasks that are waiting to be run
+		std::list<std::function<void()>> taskQueue;
+
+		// Mutex for task queue
+		std::mutex queueMutex;
+
+		// Condition variable that makes thread to wait if there is no task
+		std::condition_variable cv;
+
+		// True if pool is running.
+		std::atomic<bool> running;
+
+		// Worker thread loop
+		void work();
+	public:
+		/**
+		*	Constructor. Spawns threads.
+		*	@param threadCount Number of worker threads to spawn. Can be 0.
+		*/
+		ThreadPool(const unsigned int threadCount);
+
+		// Destructor. Stops and joins all threads. Tasks that are not started are dropped.
+		~ThreadPool();
+
+		// Delete copy and move
+		ThreadPool(ThreadPool const&) = delete;
+		ThreadPool& operator=(ThreadPool const&) = delete;
+
+		/**
+		*	Add task to queue. Locked by queueMutex
+		*	@param task Task to run in worker thread.
+		*/
+		void addTask(const std::function<void()>& task);
+
+		/**
+		*	Runs func over [0, count) in ranges of grainSize on worker threads and calling thread.
+		*	Blocks until all ranges are done.
+		*	@param count Total number of items.
+		*	@param grainSize Number of items that each range handles.
+		*	@param func Function to call with range [begin, end).
+		*/
+		void parallelFor(const unsigned int count, const unsigned int grainSize, const std::function<void(const unsigned int begin, const unsigned int end)>& func);
+
+		// Get number of worker threads. Doesn't include calling thread.
+		unsigned int getThreadCount() const;
+	};
+}
+
+#endif
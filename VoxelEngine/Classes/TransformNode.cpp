@@ -15,6 +15,7 @@
 #include "Utility.h"
 #include "Canvas.h"
 #include "UIActions.h"
+#include "BatchRenderer.h"
 #include "Logger.h"
 
 Voxel::UI::TransformNode::TransformNode(const std::string & name)
@@ -31,6 +32,10 @@ Voxel::UI::TransformNode::TransformNode(const std::string & name)
 	, zOrder()
 	, boundingBox(glm::vec2(0.0), glm::vec2(0.0f))
 	, needToUpdateModelMat(false)
+	, needToUpdateBoundingBox(false)
+	, boundingVolume(glm::vec2(0.0f), glm::vec2(0.0f))
+	, needToUpdateBoundingVolume(true)
+	, mouseMoveActive(false)
 	, parent(nullptr)
 	, interaction(0)
 	, actionPaused(false)
@@ -225,6 +230,10 @@ void Voxel::UI::TransformNode::updateBoundingBox()
 	{
 		updateBoundingBox(getParentMatrix());
 	}
+	else
+	{
+		needToUpdateBoundingBox = false;
+	}
 }
 
 void Voxel::UI::TransformNode::updateBoundingBox(const glm::mat4 & parentMatrix)
@@ -287,6 +296,10 @@ void Voxel::UI::TransformNode::updateBoundingBox(const glm::mat4 & parentMatrix)
 
 	boundingBox.size = size;
 
+	needToUpdateBoundingBox = false;
+
+	markBoundingVolumeDirty();
+
 #if V_DEBUG && V_DEBUG_DRAW_UI_BOUNDING_BOX
 	createDebugBoundingBoxLine();
 #endif
@@ -296,6 +309,52 @@ void Voxel::UI::TransformNode::setBoundingBox(const glm::vec2 & center, const gl
 {
 	boundingBox.center = center;
 	boundingBox.size = size;
+
+	markBoundingVolumeDirty();
+}
+
+Voxel::Shape::Rect Voxel::UI::TransformNode::getHitBoundingBox() const
+{
+	return boundingBox;
+}
+
+void Voxel::UI::TransformNode::markBoundingVolumeDirty()
+{
+	// Stop at first dirty node. Its parents are already dirty.
+	auto node = this;
+
+	while (node && !node->needToUpdateBoundingVolume)
+	{
+		node->needToUpdateBoundingVolume = true;
+		node = node->parent;
+	}
+}
+
+Voxel::Shape::Rect Voxel::UI::TransformNode::getBoundingVolume()
+{
+	if (needToUpdateBoundingVolume)
+	{
+		auto hitBB = getHitBoundingBox();
+
+		glm::vec2 min = hitBB.getMin();
+		glm::vec2 max = hitBB.getMax();
+
+		for (auto& e : children)
+		{
+			// Updates child's bounding volume too if it's dirty
+			auto childVolume = (e.second)->getBoundingVolume();
+
+			min = glm::min(min, childVolume.getMin());
+			max = glm::max(max, childVolume.getMax());
+		}
+
+		boundingVolume.center = (min + max) * 0.5f;
+		boundingVolume.size = max - min;
+
+		needToUpdateBoundingVolume = false;
+	}
+
+	return boundingVolume;
 }
 
 Voxel::Shape::Rect Voxel::UI::TransformNode::getBoundingBox() const
@@ -305,6 +364,11 @@ Voxel::Shape::Rect Voxel::UI::TransformNode::getBoundingBox() const
 	return scaled;
 }
 
+bool Voxel::UI::TransformNode::isMouseMoveActive() const
+{
+	return mouseMoveActive;
+}
+
 void Voxel::UI::TransformNode::setZorder(const ZOrder & zOrder)
 {
 	this->zOrder = zOrder;
@@ -425,16 +489,18 @@ bool Voxel::UI::TransformNode::addChild(Voxel::UI::TransformNode * child, Voxel:
 		child->updateModelMatrix();
 		child->updateBoundingBox();
 
+		markBoundingVolumeDirty();
+
 		return true;
 	}
 }
 
-bool Voxel::UI::TransformNode::removeChild(const std::string & name, const bool releaseChild)
+bool Voxel::UI::TransformNode::removeChild(const StringID name, const bool releaseChild)
 {
 	auto it = children.begin();
-	for (; it != children.end();)
+	for (; it != children.end(); ++it)
 	{
-		if ((it->second)->getName() == name)
+		if ((it->second)->getNameID() == name)
 		{
 			if (releaseChild)
 			{
@@ -446,6 +512,8 @@ bool Voxel::UI::TransformNode::removeChild(const std::string & name, const bool
 
 			children.erase(it);
 
+			markBoundingVolumeDirty();
+
 			return true;
 		}
 	}
@@ -456,7 +524,7 @@ bool Voxel::UI::TransformNode::removeChild(const std::string & name, const bool
 bool Voxel::UI::TransformNode::removeChild(const unsigned int id, const bool releaseChild)
 {
 	auto it = children.begin();
-	for (; it != children.end();)
+	for (; it != children.end(); ++it)
 	{
 		if ((it->second)->getID() == id)
 		{
@@ -470,6 +538,8 @@ bool Voxel::UI::TransformNode::removeChild(const unsigned int id, const bool rel
 
 			children.erase(it);
 
+			markBoundingVolumeDirty();
+
 			return true;
 		}
 	}
@@ -498,6 +568,8 @@ bool Voxel::UI::TransformNode::removeChild(TransformNode * child, const bool rel
 
 		children.erase(find_it);
 
+		markBoundingVolumeDirty();
+
 		return true;
 	}
 }
@@ -582,11 +654,11 @@ bool Voxel::UI::TransformNode::getNextZOrder(Voxel::ZOrder & curZOrder)
 	}
 }
 
-Voxel::UI::TransformNode * Voxel::UI::TransformNode::getChild(const std::string & name)
+Voxel::UI::TransformNode * Voxel::UI::TransformNode::getChild(const StringID name)
 {
 	for (auto& e : children)
 	{
-		if ((e.second)->name == name)
+		if ((e.second)->nameID == name)
 		{
 			return (e.second);
 		}
@@ -663,6 +735,25 @@ void Voxel::UI::TransformNode::stopAllActions()
 	actions.clear();
 }
 
+void Voxel::UI::TransformNode::buildBatch(BatchRenderer & batchRenderer)
+{
+	if (visibility)
+	{
+		batchRenderer.addRender(this);
+	}
+}
+
+void Voxel::UI::TransformNode::prepareBatch()
+{
+	if (visibility)
+	{
+		for (auto& e : children)
+		{
+			(e.second)->prepareBatch();
+		}
+	}
+}
+
 glm::vec2 Voxel::UI::TransformNode::getContentSize() const
 {
 	return contentSize;
@@ -698,15 +789,40 @@ void Voxel::UI::TransformNode::updateMouseMoveFalse()
 	{
 		if (!children.empty())
 		{
-			bool moved = false;
 			for (auto& child : children)
 			{
-				(child.second)->updateMouseMoveFalse();
+				(child.second)->updateMouseMoveFalseCulled();
 			}
 		}
 	}
 }
 
+bool Voxel::UI::TransformNode::updateMouseMoveCulled(const glm::vec2 & mousePosition, const glm::vec2 & mouseDelta)
+{
+	const bool inVolume = getBoundingVolume().containsPoint(mousePosition);
+
+	if (!inVolume && !mouseMoveActive)
+	{
+		// Mouse wasn't on this ui and still isn't. Nothing to update on self or children.
+		return false;
+	}
+
+	bool result = updateMouseMove(mousePosition, mouseDelta);
+
+	// Keep updating while it handles mouse move, even if mouse is out of volume (dragging). Also need one more update when mouse leaves.
+	mouseMoveActive = inVolume || result;
+
+	return result;
+}
+
+void Voxel::UI::TransformNode::updateMouseMoveFalseCulled()
+{
+	if (mouseMoveActive)
+	{
+		updateMouseMoveFalse();
+	}
+}
+
 void Voxel::UI::TransformNode::updateModelMatrix()
 {
 	// Update model matrix
@@ -719,6 +835,10 @@ void Voxel::UI::TransformNode::updateModelMatrix()
 		modelMat = getModelMatrix();
 	}
 
+	// Updated with parent or by self. Bounding box follows on next update
+	needToUpdateModelMat = false;
+	needToUpdateBoundingBox = true;
+
 	// Check if this node has children
 	if (hasChildren())
 	{
@@ -734,6 +854,9 @@ void Voxel::UI::TransformNode::updateModelMatrix(const glm::mat4 & parentMatrix)
 {
 	modelMat = parentMatrix * getModelMatrix();
 
+	needToUpdateModelMat = false;
+	needToUpdateBoundingBox = true;
+
 	// Check if this node has children
 	if (hasChildren())
 	{
@@ -789,11 +912,16 @@ void Voxel::UI::TransformNode::update(const float delta)
 		}
 	}
 
+	// Single top down pass. If parent was dirty, it already updated this node's model matrix, so subtree is updated only once per frame.
 	if (needToUpdateModelMat)
 	{
 		updateModelMatrix();
+	}
+
+	// Bounding box is updated whenever self or any parent changed transformation
+	if (needToUpdateBoundingBox)
+	{
 		updateBoundingBox();
-		needToUpdateModelMat = false;
 	}
 
 	for (auto& e : children)
@@ -834,7 +962,7 @@ bool Voxel::UI::TransformNode::updateMouseMove(const glm::vec2 & mousePosition,
 			bool moved = false;
 			for (auto& child : children)
 			{
-				bool result = (child.second)->updateMouseMove(mousePosition, mouseDelta);
+				bool result = (child.second)->updateMouseMoveCulled(mousePosition, mouseDelta);
 				if (result)
 				{
 					moved = true;
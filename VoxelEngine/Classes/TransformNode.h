@@ -9,6 +9,9 @@ namespace Voxel
 {
 	namespace UI
 	{
+		// foward declaration
+		class BatchRenderer;
+
 		/**
 		*	@class TransformNode
 		*	@brief A node that can be transformed. Derived from Node class.
@@ -30,6 +33,9 @@ namespace Voxel
 			// updates model matrix if it's true
 			bool needToUpdateModelMat;
 
+			// updates bounding box if it's true. Set when model matrix is updated by self or parent.
+			bool needToUpdateBoundingBox;
+
 			// Find next ZOrder
 			bool getNextZOrder(ZOrder& curZOrder);
 		protected:
@@ -79,6 +85,21 @@ namespace Voxel
 			// Bounding box
 			Voxel::Shape::Rect boundingBox;
 
+			// Bounding volume. Union of hit bounding box of self and bounding volume of all children in screen space.
+			Voxel::Shape::Rect boundingVolume;
+
+			// True if bounding volume of self or any children changed. If child is dirty, all parents are dirty too.
+			bool needToUpdateBoundingVolume;
+
+			// True if mouse was in bounding volume or node handled mouse move on last update.
+			bool mouseMoveActive;
+
+			// Marks bounding volume of self and all parents dirty
+			void markBoundingVolumeDirty();
+
+			// Get bounding box that is used to hit test mouse. Bounding box by default.
+			virtual Voxel::Shape::Rect getHitBoundingBox() const;
+
 			// Action sequence
 			std::list<Voxel::UI::Action*> actions;
 
@@ -237,6 +258,17 @@ namespace Voxel
 			*/
 			virtual Voxel::Shape::Rect getBoundingBox() const;
 
+			/**
+			*	Get bounding volume.
+			*	Bounding volume contains bounding box of self and all children in screen space. Recalculated only if self or any children changed.
+			*/
+			Voxel::Shape::Rect getBoundingVolume();
+
+			/**
+			*	Check if mouse was in bounding volume or ui handled mouse move on last update.
+			*/
+			bool isMouseMoveActive() const;
+
 			/**
 			*	Set Z order
 			*	@param zOrder A new z order to set.
@@ -307,8 +339,9 @@ namespace Voxel
 
 			/**
 			*	Remove child by name. Searches the name and remvoes from children.
+			*	@param name Name of ui. Use SID() for string literal.
 			*/
-			bool removeChild(const std::string& name, const bool releaseChild = false);
+			bool removeChild(const StringID name, const bool releaseChild = false);
 
 			/**
 			*	Remove child by id. Searches the id and remvoes from children.
@@ -333,12 +366,12 @@ namespace Voxel
 			void removeParent();
 
 			/**
-			*	Get child by name. This isn't efficient way since it uses string key.
+			*	Get child by name. Compares interned name but still visits all children.
 			*	Use this for debug or incase where performance doesn't matter.
-			*	@param name Name of ui.
+			*	@param name Name of ui. Use SID() for string literal.
 			*	@return First ui child that matches the name. nullptr if doesn't exists
 			*/
-			TransformNode* getChild(const std::string& name);
+			TransformNode* getChild(const StringID name);
 
 			/**
 			*	Check if this node has children
@@ -421,6 +454,20 @@ namespace Voxel
 			*/
 			virtual void updateMouseMoveFalse();
 
+			/**
+			*	Update mouse movement only if mouse can affect this ui or its children.
+			*	Skips whole subtree if mouse is out of bounding volume and ui didn't handle mouse move on last update, so parent only visits children under mouse.
+			*	@param mosuePosition Current position of mouse in screen space
+			*	@param mouseDelta Amount of mouse moved.
+			*	@return Result of updateMouseMove. false if skipped.
+			*/
+			bool updateMouseMoveCulled(const glm::vec2& mousePosition, const glm::vec2& mouseDelta);
+
+			/**
+			*	Update mouse movement false only if ui or its children handled mouse move on last update.
+			*/
+			void updateMouseMoveFalseCulled();
+
 			/**
 			*	Update ui boundary. Checks if ui is out of canvas screen
 			*/
@@ -492,6 +539,19 @@ namespace Voxel
 			// render
 			virtual void render() = 0;
 
+			/**
+			*	Add self and children to batch renderer in render order.
+			*	By default, node renders itself and its children with render() without batching.
+			*	@param batchRenderer Batch renderer to add.
+			*/
+			virtual void buildBatch(BatchRenderer& batchRenderer);
+
+			/**
+			*	Update what needs OpenGL before batch is built, so buildBatch stays CPU only.
+			*	By default, prepares children if visible.
+			*/
+			virtual void prepareBatch();
+
 #if V_DEBUG
 #if V_DEBUG_PRINT
 			void printChildren(const int tab);
@@ -0,0 +1,598 @@
+// pch
+#include "PreCompiled.h"
+
+#include "UIBatchBenchmark.h"
+
+// cpp
+#include <cstdint>
+#include <algorithm>
+#include <random>
+
+// voxel
+#include "RenderNode.h"
+#include "Canvas.h"
+#include "Benchmark.h"
+#include "Utility.h"
+
+using namespace Voxel;
+
+// Glyphs per text
+static const unsigned int TEXT_LENGTH = 12;
+
+namespace
+{
+	// Node that renders itself. Breaks batch.
+	class SelfRenderNode : public UI::RenderNode
+	{
+	public:
+		SelfRenderNode(const std::string& name = "UIBatchBenchmarkNode") : RenderNode(name) {}
+
+		void renderSelf() override {}
+
+#if V_DEBUG && V_DEBUG_DRAW_UI_BOUNDING_BOX
+		// No gl context
+		void createDebugBoundingBoxLine() override {}
+#endif
+	};
+
+	// Node with single quad. Same as Image after it's initialized.
+	class QuadNode : public UI::RenderNode
+	{
+	public:
+		QuadNode(const std::string& name, const std::vector<float>& vertices, const std::vector<float>& uvs, const std::vector<unsigned int>& indices)
+			: RenderNode(name)
+		{
+			batchVertices = vertices;
+			batchUVs = uvs;
+			batchIndices = indices;
+		}
+
+		void setTexture(Texture2D* texture) { this->texture = texture; }
+
+		void renderSelf() override {}
+
+#if V_DEBUG && V_DEBUG_DRAW_UI_BOUNDING_BOX
+		// No gl context
+		void createDebugBoundingBoxLine() override {}
+#endif
+	};
+
+	// Description of node in tree scene. Expected draw order is computed from this, not from Canvas.
+	struct TreeNode
+	{
+		// Quad node if true. Else, renders itself.
+		bool quad;
+		int zOrder;
+		bool visible;
+		// Own texture of quad node when textures aren't shared
+		Texture2D* texture;
+		std::vector<TreeNode> children;
+		// Created node
+		UI::RenderNode* node;
+	};
+
+	// Expected draw. Texture for batch, node for node that renders itself.
+	struct ExpectedDraw
+	{
+		Texture2D* texture;
+		UI::TransformNode* node;
+		unsigned int indexCount;
+	};
+
+	// Create nodes of description and add to parent
+	void createTree(UI::TransformNode* parent, std::vector<TreeNode>& nodes, Texture2D* sharedTexture, const std::vector<float>& vertices, const std::vector<float>& uvs, const std::vector<unsigned int>& indices)
+	{
+		for (auto& desc : nodes)
+		{
+			const std::string name = "UIBatchBenchmarkTree_" + std::to_string(desc.zOrder);
+
+			if (desc.quad)
+			{
+				auto quad = new QuadNode(name, vertices, uvs, indices);
+				quad->setTexture(sharedTexture ? sharedTexture : desc.texture);
+				desc.node = quad;
+			}
+			else
+			{
+				desc.node = new SelfRenderNode(name);
+			}
+
+			desc.node->setVisibility(desc.visible);
+
+			parent->addChild(desc.node, desc.zOrder);
+
+			createTree(desc.node, desc.children, sharedTexture, vertices, uvs, indices);
+		}
+	}
+
+	// Children in z order
+	std::vector<const TreeNode*> sortByZOrder(const std::vector<TreeNode>& nodes)
+	{
+		std::vector<const TreeNode*> sorted;
+
+		for (auto& desc : nodes)
+		{
+			sorted.push_back(&desc);
+		}
+
+		std::sort(sorted.begin(), sorted.end(), [](const TreeNode* lhs, const TreeNode* rhs) { return lhs->zOrder < rhs->zOrder; });
+
+		return sorted;
+	}
+
+	// Negative z order children, self, then rest. Hidden node hides its children.
+	void collectExpectedDraws(const TreeNode& desc, Texture2D* sharedTexture, std::vector<ExpectedDraw>& draws)
+	{
+		if (!desc.visible) return;
+
+		auto children = sortByZOrder(desc.children);
+		auto it = children.begin();
+
+		for (; it != children.end() && (*it)->zOrder < 0; it++)
+		{
+			collectExpectedDraws(**it, sharedTexture, draws);
+		}
+
+		if (desc.quad)
+		{
+			draws.push_back({ sharedTexture ? sharedTexture : desc.texture, nullptr, 6 });
+		}
+		else
+		{
+			draws.push_back({ nullptr, desc.node, 0 });
+		}
+
+		for (; it != children.end(); it++)
+		{
+			collectExpectedDraws(**it, sharedTexture, draws);
+		}
+	}
+
+	// Compare draws of batch renderer with expected draws in order. Returns error message or empty string.
+	std::string checkDraws(const UI::BatchRenderer& batchRenderer, const std::vector<ExpectedDraw>& expected)
+	{
+		auto& draws = batchRenderer.getDraws();
+
+		if (draws.size() != expected.size())
+		{
+			return "draw count " + std::to_string(draws.size()) + " != " + std::to_string(expected.size());
+		}
+
+		for (size_t i = 0; i < draws.size(); i++)
+		{
+			auto& draw = draws.at(i);
+			auto& expectedDraw = expected.at(i);
+
+			if (expectedDraw.node)
+			{
+				if (draw.type != UI::BatchRenderer::Draw::Type::RENDER_SELF || draw.node != expectedDraw.node)
+				{
+					return "draw #" + std::to_string(i) + " isn't node that renders itself";
+				}
+			}
+			else if (draw.type != UI::BatchRenderer::Draw::Type::BATCH || draw.texture != expectedDraw.texture)
+			{
+				return "draw #" + std::to_string(i) + " isn't batch of expected texture";
+			}
+			else if (draw.indexCount != expectedDraw.indexCount)
+			{
+				return "draw #" + std::to_string(i) + " has " + std::to_string(draw.indexCount) + " indices instead of " + std::to_string(expectedDraw.indexCount);
+			}
+		}
+
+		return "";
+	}
+
+	// Textures are only compared while building batch, never bound. Fake distinct pointers instead of loading images.
+	Texture2D* fakeTexture(const std::uintptr_t id)
+	{
+		return reinterpret_cast<Texture2D*>(id * 0x100);
+	}
+}
+
+Voxel::UIBatchBenchmark::UIBatchBenchmark(const unsigned int elements, const int frames)
+	: frames(frames)
+	, elements(elements)
+{
+	initGeometry();
+}
+
+void Voxel::UIBatchBenchmark::initGeometry()
+{
+	quadVertices = { -8.0f, -8.0f, 0.0f, -8.0f, 8.0f, 0.0f, 8.0f, -8.0f, 0.0f, 8.0f, 8.0f, 0.0f };
+	quadUVs = { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f, 1.0f };
+	quadIndices = { 0, 1, 2, 1, 2, 3 };
+
+	textVertices.clear();
+	textColors.clear();
+	textUVs.clear();
+	textIndices.clear();
+
+	// Same layout as Text mesh. 4 vertices per glyph.
+	for (unsigned int i = 0; i < TEXT_LENGTH; i++)
+	{
+		const float x = static_cast<float>(i) * 10.0f;
+
+		textVertices.insert(textVertices.end(), { x, 0.0f, 0.0f, x, 12.0f, 0.0f, x + 8.0f, 0.0f, 0.0f, x + 8.0f, 12.0f, 0.0f });
+		textColors.insert(textColors.end(), 12, 1.0f);
+		textUVs.insert(textUVs.end(), { 0.0f, 0.0f, 0.0f, 0.1f, 0.1f, 0.0f, 0.1f, 0.1f });
+
+		const unsigned int v = i * 4;
+		textIndices.insert(textIndices.end(), { v, v + 1, v + 2, v + 1, v + 2, v + 3 });
+	}
+}
+
+std::vector<UIBatchBenchmark::Scene> Voxel::UIBatchBenchmark::createScenes(UI::RenderNode * node)
+{
+	auto sheetA = fakeTexture(1);
+	auto sheetB = fakeTexture(2);
+	auto fontTexture = fakeTexture(3);
+
+	const unsigned int n = elements;
+	const unsigned int textTriangles = TEXT_LENGTH * 2;
+	const unsigned int textVertexCount = TEXT_LENGTH * 4;
+
+	const glm::mat4 modelMat(1.0f);
+	const glm::vec4 color(1.0f);
+	const glm::vec3 black(0.0f);
+
+	// Button has quad for each state and only draws current one
+	std::vector<float> buttonVertices;
+	std::vector<float> buttonUVs;
+	std::vector<unsigned int> buttonIndices;
+
+	for (unsigned int state = 0; state < 4; state++)
+	{
+		buttonVertices.insert(buttonVertices.end(), quadVertices.begin(), quadVertices.end());
+		buttonUVs.insert(buttonUVs.end(), quadUVs.begin(), quadUVs.end());
+
+		for (auto index : quadIndices)
+		{
+			buttonIndices.push_back(index + (state * 4));
+		}
+	}
+
+	std::vector<Scene> scenes;
+
+	scenes.push_back({ "images, 1 sprite sheet", [=](UI::BatchRenderer& batchRenderer)
+	{
+		for (unsigned int i = 0; i < n; i++)
+		{
+			batchRenderer.appendGeometry(sheetA, quadVertices, quadUVs, quadIndices, 0, 6, modelMat, color);
+		}
+	}, { 1, 1, 0, n * 2, n * 4 } });
+
+	scenes.push_back({ "images, 2 sprite sheets", [=](UI::BatchRenderer& batchRenderer)
+	{
+		for (unsigned int i = 0; i < n; i++)
+		{
+			batchRenderer.appendGeometry((i % 2 == 0) ? sheetA : sheetB, quadVertices, quadUVs, quadIndices, 0, 6, modelMat, color);
+		}
+	}, { n, n, 0, n * 2, n * 4 } });
+
+	// Only vertices of current state are appended
+	scenes.push_back({ "buttons", [=](UI::BatchRenderer& batchRenderer)
+	{
+		for (unsigned int i = 0; i < n; i++)
+		{
+			batchRenderer.appendGeometry(sheetA, buttonVertices, buttonUVs, buttonIndices, (i % 4) * 6, 6, modelMat, color);
+		}
+	}, { 1, 1, 0, n * 2, n * 4 } });
+
+	scenes.push_back({ "texts", [=](UI::BatchRenderer& batchRenderer)
+	{
+		for (unsigned int i = 0; i < n; i++)
+		{
+			batchRenderer.appendTextGeometry(fontTexture, textVertices, textColors, textUVs, textIndices, TEXT_LENGTH * 6, modelMat, 1.0f, false, glm::vec3(static_cast<float>(i % 2)));
+		}
+	}, { 1, 1, 0, n * textTriangles, n * textVertexCount } });
+
+	scenes.push_back({ "texts, same outline", [=](UI::BatchRenderer& batchRenderer)
+	{
+		for (unsigned int i = 0; i < n; i++)
+		{
+			batchRenderer.appendTextGeometry(fontTexture, textVertices, textColors, textUVs, textIndices, TEXT_LENGTH * 6, modelMat, 1.0f, true, black);
+		}
+	}, { 1, 1, 0, n * textTriangles, n * textVertexCount } });
+
+	scenes.push_back({ "texts, mixed outline", [=](UI::BatchRenderer& batchRenderer)
+	{
+		for (unsigned int i = 0; i < n; i++)
+		{
+			batchRenderer.appendTextGeometry(fontTexture, textVertices, textColors, textUVs, textIndices, TEXT_LENGTH * 6, modelMat, 1.0f, (i % 2 == 0), black);
+		}
+	}, { n, n, 0, n * textTriangles, n * textVertexCount } });
+
+	// Image and text use different shader even if texture is same
+	scenes.push_back({ "images and texts", [=](UI::BatchRenderer& batchRenderer)
+	{
+		for (unsigned int i = 0; i < n; i++)
+		{
+			batchRenderer.appendGeometry(fontTexture, quadVertices, quadUVs, quadIndices, 0, 6, modelMat, color);
+			batchRenderer.appendTextGeometry(fontTexture, textVertices, textColors, textUVs, textIndices, TEXT_LENGTH * 6, modelMat, 1.0f, false, black);
+		}
+	}, { n * 2, n * 2, 0, n * (2 + textTriangles), n * (4 + textVertexCount) } });
+
+	scenes.push_back({ "images and render self", [=](UI::BatchRenderer& batchRenderer)
+	{
+		for (unsigned int i = 0; i < n; i++)
+		{
+			batchRenderer.appendGeometry(sheetA, quadVertices, quadUVs, quadIndices, 0, 6, modelMat, color);
+			batchRenderer.addRenderSelf(node);
+		}
+	}, { n * 2, n, n, n * 2, n * 4 } });
+
+	// Invalid geometry is skipped and doesn't break batch
+	scenes.push_back({ "invalid geometry", [=](UI::BatchRenderer& batchRenderer)
+	{
+		for (unsigned int i = 0; i < n; i++)
+		{
+			batchRenderer.appendGeometry(sheetA, quadVertices, quadUVs, quadIndices, 0, 6, modelMat, color);
+			batchRenderer.appendGeometry(nullptr, quadVertices, quadUVs, quadIndices, 0, 6, modelMat, color);
+			batchRenderer.appendGeometry(sheetB, quadVertices, quadUVs, quadIndices, 6, 6, modelMat, color);
+			batchRenderer.appendTextGeometry(fontTexture, textVertices, textColors, textUVs, textIndices, 0, modelMat, 1.0f, false, black);
+		}
+	}, { 1, 1, 0, n * 2, n * 4 } });
+
+	return scenes;
+}
+
+std::string Voxel::UIBatchBenchmark::check(const UI::BatchRenderer & batchRenderer, const Expected & expected) const
+{
+	if (batchRenderer.getDrawCount() != expected.drawCount)
+	{
+		return "draw count " + std::to_string(batchRenderer.getDrawCount()) + " != " + std::to_string(expected.drawCount);
+	}
+
+	if (batchRenderer.getBatchCount() != expected.batchCount)
+	{
+		return "batch count " + std::to_string(batchRenderer.getBatchCount()) + " != " + std::to_string(expected.batchCount);
+	}
+
+	if (batchRenderer.getUnbatchedDrawCount() != expected.unbatchedDrawCount)
+	{
+		return "unbatched draw count " + std::to_string(batchRenderer.getUnbatchedDrawCount()) + " != " + std::to_string(expected.unbatchedDrawCount);
+	}
+
+	if (batchRenderer.getTriangleCount() != expected.triangleCount)
+	{
+		return "triangle count " + std::to_string(batchRenderer.getTriangleCount()) + " != " + std::to_string(expected.triangleCount);
+	}
+
+	if (batchRenderer.getVertexCount() != expected.vertexCount)
+	{
+		return "vertex count " + std::to_string(batchRenderer.getVertexCount()) + " != " + std::to_string(expected.vertexCount);
+	}
+
+	return "";
+}
+
+UIBatchBenchmark::Result Voxel::UIBatchBenchmark::runScene(const Scene & scene)
+{
+	UI::BatchRenderer batchRenderer;
+
+	float buildTime = 0;
+
+	Result result;
+	result.name = scene.name;
+
+	for (int frame = 0; frame < frames; frame++)
+	{
+		auto start = Utility::Time::now();
+
+		// Same as Canvas. Cleared and rebuilt every frame.
+		batchRenderer.clear();
+		scene.build(batchRenderer);
+
+		auto end = Utility::Time::now();
+
+		buildTime += Benchmark::toMicroSeconds(start, end);
+
+		if (result.error.empty())
+		{
+			result.error = check(batchRenderer, scene.expected);
+		}
+	}
+
+	result.drawCount = batchRenderer.getDrawCount();
+	result.batchCount = batchRenderer.getBatchCount();
+	result.unbatchedDrawCount = batchRenderer.getUnbatchedDrawCount();
+	result.triangleCount = batchRenderer.getTriangleCount();
+	result.buildMicroSeconds = buildTime / static_cast<float>(frames);
+
+	return result;
+}
+
+UIBatchBenchmark::Result Voxel::UIBatchBenchmark::runTree(const bool sharedTexture)
+{
+	Result result;
+	result.name = sharedTexture ? "node tree, 1 sprite sheet" : "node tree, texture per node";
+
+	// Same tree on both runs
+	std::mt19937 engine(2024);
+
+	Texture2D* sheet = sharedTexture ? fakeTexture(1) : nullptr;
+	std::uintptr_t nextTexture = 100;
+
+	auto describe = [&](const bool quad, const int zOrder, const bool visible)
+	{
+		TreeNode desc;
+		desc.quad = quad;
+		desc.zOrder = zOrder;
+		desc.visible = visible;
+		desc.texture = fakeTexture(nextTexture++);
+		desc.node = nullptr;
+		return desc;
+	};
+
+	// Panel and its items. Z orders are shuffled, so order of adding isn't order of drawing.
+	const int itemsPerPanel = 15;
+	const int panelCount = static_cast<int>(std::max(1u, elements / (itemsPerPanel + 1)));
+
+	std::vector<int> panelZOrders(panelCount);
+	std::vector<int> itemZOrders(itemsPerPanel);
+
+	for (int i = 0; i < panelCount; i++)
+	{
+		panelZOrders.at(i) = i - (panelCount / 2);
+	}
+
+	std::shuffle(panelZOrders.begin(), panelZOrders.end(), engine);
+
+	std::vector<TreeNode> panels;
+
+	for (int p = 0; p < panelCount; p++)
+	{
+		auto panel = describe(true, panelZOrders.at(p), true);
+
+		// Some items are behind panel
+		for (int i = 0; i < itemsPerPanel; i++)
+		{
+			itemZOrders.at(i) = i - 5;
+		}
+
+		std::shuffle(itemZOrders.begin(), itemZOrders.end(), engine);
+
+		for (int i = 0; i < itemsPerPanel; i++)
+		{
+			// Every 8th item renders itself and every 5th is hidden with its children
+			auto item = describe((i % 8) != 7, itemZOrders.at(i), (i % 5) != 4);
+
+			if (i % 3 == 0)
+			{
+				// Icon behind or in front of item
+				item.children.push_back(describe(true, (i % 2 == 0) ? -1 : 1, true));
+			}
+
+			panel.children.push_back(item);
+		}
+
+		panels.push_back(panel);
+	}
+
+	auto canvas = new UI::Canvas(glm::vec2(1920.0f, 1080.0f), glm::vec2(0.0f));
+
+	createTree(canvas, panels, sheet, quadVertices, quadUVs, quadIndices);
+
+	// Canvas draws children in z order and nothing itself
+	std::vector<ExpectedDraw> draws;
+
+	for (auto panel : sortByZOrder(panels))
+	{
+		collectExpectedDraws(*panel, sheet, draws);
+	}
+
+	// Consecutive quads of same texture are merged in to single batch
+	std::vector<ExpectedDraw> expected;
+	unsigned int triangleCount = 0;
+
+	for (auto& draw : draws)
+	{
+		triangleCount += draw.indexCount / 3;
+
+		if (!expected.empty() && draw.node == nullptr && expected.back().node == nullptr && expected.back().texture == draw.texture)
+		{
+			expected.back().indexCount += draw.indexCount;
+		}
+		else
+		{
+			expected.push_back(draw);
+		}
+	}
+
+	float buildTime = 0;
+
+	for (int frame = 0; frame < frames; frame++)
+	{
+		auto start = Utility::Time::now();
+
+		// Same as Canvas::render() without draw
+		canvas->updateBatch();
+
+		auto end = Utility::Time::now();
+
+		buildTime += Benchmark::toMicroSeconds(start, end);
+
+		if (result.error.empty())
+		{
+			result.error = checkDraws(canvas->getBatchRenderer(), expected);
+		}
+
+		if (result.error.empty() && canvas->getBatchRenderer().getTriangleCount() != triangleCount)
+		{
+			result.error = "triangle count " + std::to_string(canvas->getBatchRenderer().getTriangleCount()) + " != " + std::to_string(triangleCount);
+		}
+	}
+
+	auto& batchRenderer = canvas->getBatchRenderer();
+
+	result.drawCount = batchRenderer.getDrawCount();
+	result.batchCount = batchRenderer.getBatchCount();
+	result.unbatchedDrawCount = batchRenderer.getUnbatchedDrawCount();
+	result.triangleCount = batchRenderer.getTriangleCount();
+	result.buildMicroSeconds = buildTime / static_cast<float>(frames);
+
+	// Nodes log on destruction. Keep result lines readable.
+	auto coutBuffer = std::cout.rdbuf(nullptr);
+	delete canvas;
+	std::cout.rdbuf(coutBuffer);
+
+	return result;
+}
+
+void Voxel::UIBatchBenchmark::printResult(const Result & result)
+{
+	Benchmark::ResultLine("UIBatchBenchmark", result.name)
+		.add("draws", result.drawCount)
+		.add("batches", result.batchCount)
+		.add("unbatched", result.unbatchedDrawCount)
+		.add("triangles", result.triangleCount)
+		.add("build", result.buildMicroSeconds, "us per frame")
+		.addChecks(result.error)
+		.print();
+}
+
+bool Voxel::UIBatchBenchmark::run()
+{
+	std::cout << "[UIBatchBenchmark] Elements: " << elements << ", Frames: " << frames << "\n";
+
+	SelfRenderNode node;
+
+	bool passed = true;
+
+	for (auto& scene : createScenes(&node))
+	{
+		auto result = runScene(scene);
+
+		printResult(result);
+
+		passed = passed && result.error.empty();
+	}
+
+	for (auto sharedTexture : { true, false })
+	{
+		auto result = runTree(sharedTexture);
+
+		printResult(result);
+
+		passed = passed && result.error.empty();
+	}
+
+	return passed;
+}
+
+int Voxel::UIBatchBenchmark::runFromCommandLine(const int argc, const char * argv[])
+{
+	// argv[0] is exe, argv[1] is --ui-batch-bench
+	int elements = 200;
+	int frames = 1000;
+
+	if (!Benchmark::parseArguments(argc, argv, { { &elements, 1 }, { &frames, 1 } }, "[elements] [frames]"))
+	{
+		return 1;
+	}
+
+	UIBatchBenchmark benchmark(static_cast<unsigned int>(elements), frames);
+
+	return benchmark.run() ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+#ifndef UI_BATCH_BENCHMARK_H
+#define UI_BATCH_BENCHMARK_H
+
+// cpp
+#include <vector>
+#include <string>
+#include <functional>
+
+// voxel
+#include "BatchRenderer.h"
+
+namespace Voxel
+{
+	namespace UI
+	{
+		// foward declaration
+		class RenderNode;
+	}
+
+	/**
+	*	@class UIBatchBenchmark
+	*	@brief Measures building ui batches and checks batch and draw call counts without window or OpenGL context.
+	*
+	*	Each scene appends same geometry to BatchRenderer every frame like Canvas does when it walks ui tree.
+	*	Scenes cover images on single sprite sheet, images that switch sprite sheet, text with and without outline,
+	*	images mixed with text and nodes that render themselves. Textures are never bound because render() isn't called.
+	*
+	*	After each frame, checks draw, batch, unbatched draw, triangle and vertex count against expected count of scene.
+	*
+	*	Tree scenes build real node tree on Canvas instead: panels with nested children that have negative and positive
+	*	z order, hidden subtrees and nodes that render themselves. Each frame runs Canvas::updateBatch, which walks tree
+	*	same as render(). Draws are checked against order computed from tree description. Once with single sprite sheet,
+	*	where batches must merge across nodes, and once with texture per node, where every draw is checked in order.
+	*	Returns non zero exit code if any check fails.
+	*
+	*	Run with: VoxelEngine.exe --ui-batch-bench [elements] [frames]
+	*/
+	class UIBatchBenchmark
+	{
+	public:
+		// Result of single scene. Time is in microseconds per frame.
+		struct Result
+		{
+			std::string name;
+			unsigned int drawCount;
+			unsigned int batchCount;
+			unsigned int unbatchedDrawCount;
+			unsigned int triangleCount;
+			float buildMicroSeconds;
+			// Empty if all checks passed
+			std::string error;
+		};
+	private:
+		// Counts that batch renderer must report after scene is built
+		struct Expected
+		{
+			unsigned int drawCount;
+			unsigned int batchCount;
+			unsigned int unbatchedDrawCount;
+			unsigned int triangleCount;
+			unsigned int vertexCount;
+		};
+
+		// Ui that is appended to batch renderer each frame
+		struct Scene
+		{
+			std::string name;
+			std::function<void(UI::BatchRenderer&)> build;
+			Expected expected;
+		};
+
+		// Number of frames per scene
+		int frames;
+
+		// Number of ui elements per scene
+		unsigned int elements;
+
+		// Single quad
+		std::vector<float> quadVertices;
+		std::vector<float> quadUVs;
+		std::vector<unsigned int> quadIndices;
+
+		// Quads of single text
+		std::vector<float> textVertices;
+		std::vector<float> textColors;
+		std::vector<float> textUVs;
+		std::vector<unsigned int> textIndices;
+
+		// Build geometry of quad and text
+		void initGeometry();
+
+		// Create scenes. Node is used for nodes that render themselves.
+		std::vector<Scene> createScenes(UI::RenderNode* node);
+
+		// Check batch renderer after scene is built. Returns error message or empty string.
+		std::string check(const UI::BatchRenderer& batchRenderer, const Expected& expected) const;
+
+		// Runs frames with given scene
+		Result runScene(const Scene& scene);
+
+		/**
+		*	Runs frames with node tree on canvas.
+		*	@param sharedTexture true if all nodes use same sprite sheet. Else, each node has own texture.
+		*/
+		Result runTree(const bool sharedTexture);
+
+		// Print result of single scene
+		void printResult(const Result& result);
+	public:
+		/**
+		*	Constructor
+		*	@param elements Number of ui elements per scene.
+		*	@param frames Number of frames per scene.
+		*/
+		UIBatchBenchmark(const unsigned int elements, const int frames);
+
+		// Destructor
+		~UIBatchBenchmark() = default;
+
+		/**
+		*	Runs all scenes.
+		*	@return true if all checks passed.
+		*/
+		bool run();
+
+		/**
+		*	Parses arguments after --ui-batch-bench and runs benchmark.
+		*	@return Exit code for process.
+		*/
+		static int runFromCommandLine(const int argc, const char* argv[]);
+	};
+}
+
+#endif
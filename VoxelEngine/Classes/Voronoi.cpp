@@ -3,6 +3,10 @@
 
 #include "Voronoi.h"
 
+// cpp
+#include <queue>
+#include <functional>
+
 // voxel
 #include "Utility.h"
 #include "ProgramManager.h"
@@ -10,6 +14,8 @@
 #include "Color.h"
 #include "Region.h"
 #include "Application.h"
+#include "ThreadPool.h"
+#include "AsyncLogger.h"
 
 using namespace Voxel;
 using namespace Voxel::Voronoi;
@@ -19,16 +25,17 @@ Voxel::Voronoi::Edge::Edge(const glm::vec2& start, const glm::vec2& end)
 	, end(end)
 	, owner(nullptr)
 	, coOwner(nullptr)
+	, twin(INVALID_EDGE_INDEX)
 {
 	//std::cout << "edge dist = " << glm::abs(glm::distance(start, end)) << std::endl;
 }
 
-glm::vec2 Voxel::Voronoi::Edge::getStart()
+glm::vec2 Voxel::Voronoi::Edge::getStart() const
 {
 	return start;
 }
 
-glm::vec2 Voxel::Voronoi::Edge::getEnd()
+glm::vec2 Voxel::Voronoi::Edge::getEnd() const
 {
 	return end;
 }
@@ -54,7 +61,7 @@ void Voxel::Voronoi::Edge::setOwner(Cell * cell)
 	this->owner = cell;
 }
 
-Cell * Voxel::Voronoi::Edge::getOwner()
+Cell * Voxel::Voronoi::Edge::getOwner() const
 {
 	return owner;
 }
@@ -64,84 +71,105 @@ void Voxel::Voronoi::Edge::setCoOwner(Cell * cell)
 	this->coOwner = cell;
 }
 
-Cell * Voxel::Voronoi::Edge::getCoOwner()
+Cell * Voxel::Voronoi::Edge::getCoOwner() const
 {
 	return coOwner;
 }
 
+unsigned int Voxel::Voronoi::Edge::getTwin() const
+{
+	return twin;
+}
 
 
 
 
-Voxel::Voronoi::Site::Site(const glm::vec2 & position, const Type type)
-	: position(position)
-	, type(type)
+
+Voxel::Voronoi::EdgeRange::EdgeRange(Edge * first, Edge * last)
+	: first(first)
+	, last(last)
 {}
 
-glm::vec2 Voxel::Voronoi::Site::getPosition()
+Edge * Voxel::Voronoi::EdgeRange::begin() const
 {
-	return position;
+	return first;
 }
 
-Site::Type Voxel::Voronoi::Site::getType()
+Edge * Voxel::Voronoi::EdgeRange::end() const
 {
-	return type;
+	return last;
 }
 
-void Voxel::Voronoi::Site::updateType(const Type type)
+Edge & Voxel::Voronoi::EdgeRange::front() const
 {
-	this->type = type;
+	return *first;
 }
 
-bool Voxel::Voronoi::Site::isBorder()
+Edge & Voxel::Voronoi::EdgeRange::back() const
 {
-	return type == Voxel::Voronoi::Site::Type::BORDER;
+	return *(last - 1);
+}
+
+unsigned int Voxel::Voronoi::EdgeRange::size() const
+{
+	return static_cast<unsigned int>(last - first);
 }
 
+bool Voxel::Voronoi::EdgeRange::empty() const
+{
+	return first == last;
+}
 
 
 
 
-Voxel::Voronoi::Cell::Cell(const unsigned int ID)
-	: ID(ID)
-	, site(nullptr)
-	, valid(false)
-	, region(nullptr)
+
+Voxel::Voronoi::Site::Site(const glm::vec2 & position, const Type type)
+	: position(position)
+	, type(type)
 {}
 
-Voxel::Voronoi::Cell::~Cell()
+glm::vec2 Voxel::Voronoi::Site::getPosition() const
 {
-	clearEdges();
-
-	if (site)
-	{
-		delete site;
-	}
+	return position;
 }
 
-void Voxel::Voronoi::Cell::addEdge(Edge * edge)
+Site::Type Voxel::Voronoi::Site::getType() const
 {
-	edges.push_back(std::shared_ptr<Edge>(edge));
+	return type;
 }
 
-glm::vec2 Voxel::Voronoi::Cell::getSitePosition()
+void Voxel::Voronoi::Site::updateType(const Type type)
 {
-	return site->getPosition();
+	this->type = type;
 }
 
-Site::Type Voxel::Voronoi::Cell::getSiteType()
+bool Voxel::Voronoi::Site::isBorder() const
 {
-	return site->getType();
+	return type == Voxel::Voronoi::Site::Type::BORDER;
 }
 
-void Voxel::Voronoi::Cell::setSite(const glm::vec2& position, const Site::Type type)
+
+
+
+
+Voxel::Voronoi::Cell::Cell(const unsigned int ID, const Site& site)
+	: site(site)
+	, edges(nullptr)
+	, edgeCount(0)
+	, ID(ID)
+	, valid(false)
+	, region(nullptr)
+{}
+
+glm::vec2 Voxel::Voronoi::Cell::getSitePosition() const
 {
-	site = new Site(position, type);
+	return site.getPosition();
 }
 
-void Voxel::Voronoi::Cell::setSite(Site * site)
+Site::Type Voxel::Voronoi::Cell::getSiteType() const
 {
-	this->site = site;
+	return site.getType();
 }
 
 void Voxel::Voronoi::Cell::setValidation(const bool valid)
@@ -149,14 +177,14 @@ void Voxel::Voronoi::Cell::setValidation(const bool valid)
 	this->valid = valid;
 }
 
-bool Voxel::Voronoi::Cell::isValid()
+bool Voxel::Voronoi::Cell::isValid() const
 {
 	return valid;
 }
 
-std::list<std::shared_ptr<Edge>>& Voxel::Voronoi::Cell::getEdges()
+EdgeRange Voxel::Voronoi::Cell::getEdges() const
 {
-	return edges;
+	return EdgeRange(edges, edges + edgeCount);
 }
 
 void Voxel::Voronoi::Cell::addNeighbor(Cell * cell)
@@ -164,30 +192,14 @@ void Voxel::Voronoi::Cell::addNeighbor(Cell * cell)
 	neighbors.push_back(cell);
 }
 
-std::list<Cell*>& Voxel::Voronoi::Cell::getNeighbors()
+std::vector<Cell*>& Voxel::Voronoi::Cell::getNeighbors()
 {
 	return neighbors;
 }
 
-unsigned int Voxel::Voronoi::Cell::getNeighborSize()
+unsigned int Voxel::Voronoi::Cell::getNeighborSize() const
 {
-	return this->neighbors.size();
-}
-
-void Voxel::Voronoi::Cell::clearEdges()
-{
-	/*
-	// note: Switched to shared ptr
-	for (auto edge : edges)
-	{
-		if (edge)
-		{
-			delete edge;
-		}
-	}
-	*/
-
-	edges.clear();
+	return static_cast<unsigned int>(this->neighbors.size());
 }
 
 void Voxel::Voronoi::Cell::clearNeighbors()
@@ -195,14 +207,14 @@ void Voxel::Voronoi::Cell::clearNeighbors()
 	this->neighbors.clear();
 }
 
-unsigned int Voxel::Voronoi::Cell::getID()
+unsigned int Voxel::Voronoi::Cell::getID() const
 {
 	return ID;
 }
 
 void Voxel::Voronoi::Cell::updateSiteType(Site::Type type)
 {
-	this->site->updateType(type);
+	this->site.updateType(type);
 }
 
 void Voxel::Voronoi::Cell::setRegion(Region * region)
@@ -215,9 +227,9 @@ Region * Voxel::Voronoi::Cell::getRegion()
 	return region;
 }
 
-bool Voxel::Voronoi::Cell::isSiteBorder()
+bool Voxel::Voronoi::Cell::isSiteBorder() const
 {
-	return site->isBorder();
+	return site.isBorder();
 }
 
 
@@ -245,15 +257,8 @@ Voxel::Voronoi::Diagram::Diagram()
 
 Voxel::Voronoi::Diagram::~Diagram()
 {
-	for (auto cell : cells)
-	{
-		if (cell.second)
-		{
-			delete cell.second;
-		}
-	}
-
 	cells.clear();
+	edges.clear();
 
 #if V_DEBUG && V_DEBUG_VORONOI_LINE
 	if (vao)
@@ -282,7 +287,6 @@ Voxel::Voronoi::Diagram::~Diagram()
 	}
 #endif
 }
-
 void Voxel::Voronoi::Diagram::construct(const std::vector<Site>& randomSites, const float minBound, const float maxBound)
 {
 	auto start = Utility::Time::now();
@@ -329,77 +333,86 @@ void Voxel::Voronoi::Diagram::construct(const std::vector<Site>& randomSites, co
 		
 	auto end = Utility::Time::now();
 
-	std::cout << "Voronoi construction took: " << Utility::Time::toMilliSecondString(start, end) << std::endl;
+	V_LOG_DEBUG("[Voronoi] Voronoi construction took: {}ms", std::chrono::duration<double, std::milli>(end - start).count());
 }
 
-std::vector<Site> Voxel::Voronoi::Diagram::relax()
+
+std::vector<Site> Voxel::Voronoi::Diagram::relax(ThreadPool* threadPool)
 {
-	std::vector<Site> relaxedSites;
+	const unsigned int cellSize = static_cast<unsigned int>(cells.size());
 
-	for (auto& entry : cells)
-	{
-		auto cell = entry.second;
+	// Each cell only writes its own position, so ranges can run in parallel.
+	std::vector<glm::vec2> positions(cellSize);
 
-		if (cell->isValid())
+	auto relaxRange = [this, &positions](const unsigned int begin, const unsigned int end)
+	{
+		for (unsigned int i = begin; i < end; i++)
 		{
-			auto& edges = cell->getEdges();
+			const Cell& cell = cells[i];
 
-			std::vector<glm::vec2> points;
-			points.push_back(edges.front()->getStart());
-			
-			for (auto& edge : edges)
+			if (cell.isValid() && cell.edgeCount >= 3)
 			{
-				points.push_back(edge->getEnd());
+				positions[i] = getCentroid(cell);
 			}
+			else
+			{
+				positions[i] = cell.getSitePosition();
+			}
+		}
+	};
 
-			glm::vec2 centroid(0);
+	if (threadPool)
+	{
+		threadPool->parallelFor(cellSize, 256, relaxRange);
+	}
+	else
+	{
+		relaxRange(0, cellSize);
+	}
 
-			float signedArea = 0.0f;
-			float x0 = 0.0f;
-			float y0 = 0.0f;
-			float x1 = 0.0f;
-			float y1 = 0.0f;
-			float a = 0.0f;
+	std::vector<Site> relaxedSites;
+	relaxedSites.reserve(cellSize);
 
-			auto size = points.size();
+	// Keep cell ID order so site index still matches grid index.
+	for (unsigned int i = 0; i < cellSize; i++)
+	{
+		relaxedSites.push_back(Site(positions[i], cells[i].getSiteType()));
+	}
 
-			unsigned int i = 0;
-			for (i = 0; i < size - 1; i++)
-			{
-				x0 = points[i].x;
-				y0 = points[i].y;
-				x1 = points[i + 1].x;
-				y1 = points[i + 1].y;
-				a = x0*y1 - x1*y0;
-				signedArea += a;
-				centroid.x += (x0 + x1)*a;
-				centroid.y += (y0 + y1)*a;
-			}
+	return relaxedSites;
+}
+
+glm::vec2 Voxel::Voronoi::Diagram::getCentroid(const Cell & cell) const
+{
+	glm::vec2 centroid(0);
+	float signedArea = 0.0f;
 
-			x0 = points[i].x;
-			y0 = points[i].y;
-			x1 = points[0].x;
-			y1 = points[0].y;
-			a = x0 * y1 - x1 * y0;
-			signedArea += a;
-			centroid.x += (x0 + x1) * a;
-			centroid.y += (y0 + y1) * a;
+	const unsigned int size = cell.edgeCount;
 
-			signedArea *= 0.5f;
-			centroid.x /= (6.0f * signedArea);
-			centroid.y /= (6.0f * signedArea);
+	// Edges are in order, so start points form the polygon.
+	for (unsigned int i = 0; i < size; i++)
+	{
+		const glm::vec2 p0 = cell.edges[i].start;
+		const glm::vec2 p1 = cell.edges[(i + 1) % size].start;
 
-			relaxedSites.push_back(Site(centroid, cell->getSiteType()));
-		}
-		else
-		{
-			relaxedSites.push_back(Site(cell->getSitePosition(), cell->getSiteType()));
-		}
+		const float a = p0.x * p1.y - p1.x * p0.y;
+		signedArea += a;
+		centroid.x += (p0.x + p1.x) * a;
+		centroid.y += (p0.y + p1.y) * a;
 	}
 
-	std::reverse(relaxedSites.begin(), relaxedSites.end());
+	signedArea *= 0.5f;
 
-	return relaxedSites;
+	if (glm::abs(signedArea) <= std::numeric_limits<float>::epsilon())
+	{
+		// Degenerated polygon
+		return cell.getSitePosition();
+	}
+
+	centroid.x /= (6.0f * signedArea);
+	centroid.y /= (6.0f * signedArea);
+
+	return centroid;
 }
 
 void Voxel::Voronoi::Diagram::buildCells(boost::polygon::voronoi_diagram<double>& vd)
@@ -408,26 +421,41 @@ void Voxel::Voronoi::Diagram::buildCells(boost::polygon::voronoi_diagram<double>
 
 	totalValidCells = 0;
 
-	if (cells.empty() == false)
-	{
-		for (auto cell : cells)
-		{
-			if (cell.second)
-			{
-				delete cell.second;
-			}
-		}
+	cells.clear();
+	edges.clear();
+
+	const unsigned int siteSize = static_cast<unsigned int>(sitePositions.size());
+
+	// Create all cells first, so cell pointers don't change while edges are added.
+	cells.reserve(siteSize);
 
-		cells.clear();
+	for (unsigned int i = 0; i < siteSize; i++)
+	{
+		cells.push_back(Cell(i, Site(sitePositions.at(i), siteTypes.at(i))));
 	}
 
+	const auto& vdEdges = vd.edges();
+
+	// Index of edge in edge array for each boost's edge. Used to link twin.
+	std::vector<unsigned int> edgeIndices(vdEdges.size(), INVALID_EDGE_INDEX);
+	// Boost's edge for each edge in edge array.
+	std::vector<unsigned int> sourceEdges;
+	sourceEdges.reserve(vdEdges.size());
+	edges.reserve(vdEdges.size());
+
+	// Index of first edge of each cell
+	std::vector<unsigned int> edgeOffsets(siteSize, 0);
+
 	// Iterate cells. Ignore all the cells that contains infinite edge
 	for (auto it = vd.cells().begin(); it != vd.cells().end(); ++it)
 	{
 		const auto& cell = *it;
 
 		// Get cell ID
-		auto cellID = cell.source_index();
+		auto cellID = static_cast<unsigned int>(cell.source_index());
+
+		Cell& newCell = cells.at(cellID);
+		edgeOffsets.at(cellID) = static_cast<unsigned int>(edges.size());
 
 		// Get first edge
 		auto edge = cell.incident_edge();
@@ -435,114 +463,85 @@ void Voxel::Voronoi::Diagram::buildCells(boost::polygon::voronoi_diagram<double>
 		// True if this cell is valid (All edges in boundary)
 		bool valid = true;
 
-		// save edges
-		std::vector<glm::vec2> edges;
-
 		// Iterate all edges
 		do
 		{
 			// Edge must be primary
 			if (edge->is_primary() && edge->is_linear())
 			{
+				glm::vec2 e0, e1;
+
 				// Check if edge is finite or infinite
 				if (edge->is_finite())
 				{
 					// Edge if finite
-					glm::vec2 e0 = glm::vec2(edge->vertex0()->x(), edge->vertex0()->y());
-					glm::vec2 e1 = glm::vec2(edge->vertex1()->x(), edge->vertex1()->y());
-
-					// Check boundary. 
-					/*
-					if (e0.x > maxBound || e0.x < minBound)
-						valid = false;
-					if (e0.y > maxBound || e0.y < minBound)
-						valid = false;
-
-					if (e1.x > maxBound || e1.x < minBound)
-						valid = false;
-					if (e1.y > maxBound || e1.y < minBound)
-						valid = false;
-
-					if (!valid)
-					{
-						// Stop if this cell isn't valid
-						break;
-					}
-					*/
-
-					// Add edge
-					edges.push_back(e0);
-					edges.push_back(e1);
+					e0 = glm::vec2(edge->vertex0()->x(), edge->vertex0()->y());
+					e1 = glm::vec2(edge->vertex1()->x(), edge->vertex1()->y());
 				}
 				else
 				{
+					// Invalid cells can still have edge data
 					valid = false;
 
-					glm::vec2 e0, e1;
 					clipInfiniteEdge(*edge, e0, e1, maxBound);
-
-					edges.push_back(e0);
-					edges.push_back(e1);
 				}
+
+				const unsigned int sourceIndex = static_cast<unsigned int>(edge - &vdEdges.front());
+
+				edgeIndices.at(sourceIndex) = static_cast<unsigned int>(edges.size());
+				sourceEdges.push_back(sourceIndex);
+
+				edges.push_back(Edge(e0, e1));
+				edges.back().owner = &newCell;
 			}
 
 			//edge = edge->rot_next();
 			edge = edge->next();
 		} while (edge != cell.incident_edge());
 
-		// This cell is valid
-		Cell* newCell = new Cell(cellID);
-
-		auto pos = sitePositions.at(cellID);
-
-		// Save site position
-		newCell->setSite(sitePositions.at(cellID), siteTypes.at(cellID));
+		newCell.edgeCount = static_cast<unsigned int>(edges.size()) - edgeOffsets.at(cellID);
+		newCell.setValidation(valid);
 
 		if (valid)
 		{
-			// Create new valid cells
-			auto len = edges.size();
-
-			// iterate through edges.
-			for (unsigned int i = 0; i < len; i += 2)
-			{
-				Edge* newEdge = new Edge(edges.at(i), edges.at(i + 1));
-				newEdge->setOwner(newCell);
-				newCell->addEdge(newEdge);
-			}
-
-			// set valid to true
-			newCell->setValidation(true);
-
 			totalValidCells++;
 		}
-		else
-		{
-			// Create new invalid cells. Invalid cells can still have edge data
-			auto len = edges.size();
+	}
 
-			// iterate through edges.
-			for (unsigned int i = 0; i < len; i += 2)
-			{
-				Edge* newEdge = new Edge(edges.at(i), edges.at(i + 1));
-				newEdge->setOwner(newCell);
-				newCell->addEdge(newEdge);
-			}
+	// Link shared edges with twin of boost's half edge.
+	const unsigned int edgeSize = static_cast<unsigned int>(edges.size());
 
+	for (unsigned int i = 0; i < edgeSize; i++)
+	{
+		const unsigned int twinSource = static_cast<unsigned int>(vdEdges.at(sourceEdges.at(i)).twin() - &vdEdges.front());
+		const unsigned int twin = edgeIndices.at(twinSource);
 
-			// set valid to false
-			newCell->setValidation(false);
+		if (twin != INVALID_EDGE_INDEX)
+		{
+			edges.at(i).twin = twin;
+			edges.at(i).coOwner = edges.at(twin).owner;
 		}
-
-		cells.emplace(cellID, newCell);
 	}
 
-	std::cout << "Cell size = " << cells.size() << std::endl;
-	std::cout << "Valid cell size = " << totalValidCells << std::endl;
+	linkCellEdges(edgeOffsets);
+
+	V_LOG_DEBUG("[Voronoi] Cell size = {}", cells.size());
+	V_LOG_DEBUG("[Voronoi] Valid cell size = {}", totalValidCells);
 
 	auto end = Utility::Time::now();
 
-	std::cout << "Voronoi build took: " << Utility::Time::toMilliSecondString(start, end) << std::endl;
+	V_LOG_DEBUG("[Voronoi] Voronoi build took: {}ms", std::chrono::duration<double, std::milli>(end - start).count());
+}
+
+void Voxel::Voronoi::Diagram::linkCellEdges(const std::vector<unsigned int>& edgeOffsets)
+{
+	const unsigned int cellSize = static_cast<unsigned int>(cells.size());
+
+	for (unsigned int i = 0; i < cellSize; i++)
+	{
+		auto& cell = cells.at(i);
+		cell.edges = (cell.edgeCount > 0) ? (edges.data() + edgeOffsets.at(i)) : nullptr;
+	}
 }
 
 void Voxel::Voronoi::Diagram::randomizeCells(const int w, const int l, std::mt19937& engine)
@@ -584,8 +583,7 @@ void Voxel::Voronoi::Diagram::randomizeCells(const int w, const int l, std::mt19
 	while (omittingCellCount > 0 && index < len)
 	{
 		
-		auto find_it = cells.find(candidates.at(index));
-		if (find_it == cells.end())
+		if (!inRange(candidates.at(index)))
 		{
 			index++;
 			continue;
@@ -593,7 +591,7 @@ void Voxel::Voronoi::Diagram::randomizeCells(const int w, const int l, std::mt19
 		else
 		{
 			// found cell.
-			auto cell = find_it->second;
+			auto cell = &cells.at(candidates.at(index));
 			// only attemp to omit valid cell
 			if (cell->isValid())
 			{
@@ -711,7 +709,7 @@ void Voxel::Voronoi::Diagram::randomizeCells(const int w, const int l, std::mt19
 					totalValidCells--;
 					omittingCellCount--;
 					index++;
-					std::cout << "Omitted cell #" << cell->getID() << std::endl;
+					V_LOG_TRACE("[Voronoi] Omitted cell #{}", cell->getID());
 				}
 			}
 			else
@@ -721,58 +719,70 @@ void Voxel::Voronoi::Diagram::randomizeCells(const int w, const int l, std::mt19
 		}
 	}
 
-	std::cout << "Removed " << totalRemoved << " cells\n";
-	std::cout << "Total valid cell count: " << totalValidCells << std::endl;
+	V_LOG_DEBUG("[Voronoi] Removed {} cells", totalRemoved);
+	V_LOG_DEBUG("[Voronoi] Total valid cell count: {}", totalValidCells);
 }
 
-std::map<unsigned int, Cell*>& Voxel::Voronoi::Diagram::getCells()
+std::vector<Cell>& Voxel::Voronoi::Diagram::getCells()
 {
 	return cells;
 }
 
-void Voxel::Voronoi::Diagram::findShortestPathFromSrc(const unsigned int src, std::vector<float>& dist, std::vector<unsigned int>& prevPath)
+unsigned int Voxel::Voronoi::Diagram::getEdgeCount() const
+{
+	return static_cast<unsigned int>(edges.size());
+}
+
+void Voxel::Voronoi::Diagram::findShortestPathFromSrc(const unsigned int src, std::vector<float>& dist, std::vector<unsigned int>& prevPath, std::vector<unsigned int>& pathSizes)
 {
 	// get size
 	auto cellSize = cells.size();
 	float MAX_FLOAT = std::numeric_limits<float>::max();
 
 	// Initialize dist to some large number that can be considered as infinite number.
-	dist.clear();
-	dist = std::vector<float>(cellSize, MAX_FLOAT);
+	dist.assign(cellSize, MAX_FLOAT);
 	// previous cell id.
-	prevPath.clear();
-	prevPath = std::vector<unsigned int>(cellSize, -1);
+	prevPath.assign(cellSize, -1);
+	// number of cells on path
+	pathSizes.assign(cellSize, 0);
 
-	// Queue
-	std::list<Cell*> queue;
+	if (!inRange(src))
+	{
+		return;
+	}
+
+	// Min heap of (dist, cell id). Cell can be pushed multiple times. Entry that is longer than dist is outdated.
+	typedef std::pair<float, unsigned int> QueueEntry;
+	std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
 
-	// Add src cell to queue
-	queue.push_back(cells.find(src)->second);
-	
 	// Dist from src to src is 0
 	dist.at(src) = 0;
 	// previous cell of src is src
 	prevPath.at(src) = src;
 
+	queue.push(QueueEntry(0.0f, src));
+
 	// find 
 	while (!queue.empty())
 	{
-		auto curCell = queue.front();
-		queue.pop_front();
+		const auto top = queue.top();
+		queue.pop();
 
-		auto curPos = curCell->getSitePosition();
+		auto d = top.first;
+		auto curCellID = top.second;
 
-		auto curCellID = curCell->getID();
-		auto d = dist[curCellID];
+		if (d > dist[curCellID])
+		{
+			// Already visited with shorter dist
+			continue;
+		}
 
-		//std::cout << "CurCell #" << curCellID << " dist: " << d << std::endl;
+		auto& curCell = cells[curCellID];
+		auto curPos = curCell.getSitePosition();
 
-		auto& neighborCells = curCell->getNeighbors();
+		auto& neighborCells = curCell.getNeighbors();
 		for (auto nCell : neighborCells)
 		{
-			if (nCell->isValid())
-			{
-			}
 			glm::vec2 nPos = nCell->getSitePosition();
 			auto distFromCur = glm::abs(glm::distance(curPos, nPos));
 			auto distFromSrc = distFromCur + d;
@@ -780,10 +790,10 @@ void Voxel::Voronoi::Diagram::findShortestPathFromSrc(const unsigned int src, st
 
 			if (distFromSrc < dist[nID])
 			{
-				//std::cout << "nCell is shorter #" << nID << " with dist: " << distFromCur << ", distFromSrc: " << distFromSrc << std::endl;
 				dist[nID] = distFromSrc;
 				prevPath[nID] = curCellID;
-				queue.push_back(nCell);
+				pathSizes[nID] = pathSizes[curCellID] + 1;
+				queue.push(QueueEntry(distFromSrc, nID));
 			}
 		}
 	}
@@ -804,124 +814,33 @@ float Voxel::Voronoi::Diagram::getMaxBound()
 	return maxBound;
 }
 
-void Voxel::Voronoi::Diagram::buildGraph(const int w, const int l)
+void Voxel::Voronoi::Diagram::buildGraph()
 {
 	auto start = Utility::Time::now();
-	// start form 0, 0
-	auto cellSize = cells.size();
 
-	for (int x = 0; x < w; ++x)
+	for (auto& cell : cells)
 	{
-		for (int z = 0; z < l; ++z)
+		// Only valid cells have neighbors. BORDER can still be neighbor.
+		if (!cell.isValid())
 		{
-			auto index = xzToIndex(x, z, w);
-
-			//assert(index >= 0 && index < cellSize);
-
-			auto find_it = cells.find(index);
-			if (find_it == cells.end())
-			{
-				assert(false);
-			}
-			else
-			{
-				// Check if cell is valid
-				auto& cell = find_it->second;
-				auto cellID = cell->getID();
-				auto& edges = cell->getEdges();
-
-				if (cell->isValid())
-				{
-				}
-				else
-				{
-					continue;
-				}
-				// Check all 24 adjacent cells (d == 2)
-				int xStart = x - 2;
-				int zStart = z - 2;
-				int xEnd = x + 2;
-				int zEnd = z + 2;
-
-				for (int cX = xStart; cX <= xEnd; cX++)
-				{
-					for (int cZ = zStart; cZ <= zEnd; cZ++)
-					{
-						if (cX == x && cZ == z)
-						{
-							continue;
-						}
-						else
-						{
-							auto cIndex = xzToIndex(cX, cZ, w);
-							checkNeighborCell(edges, cell, cIndex);
-						}
-					}
-				}
-			}
+			continue;
 		}
-	}
-	auto end = Utility::Time::now();
 
-	std::cout << "graph construction took: " << Utility::Time::toMilliSecondString(start, end) << std::endl;
-}
-
-void Voxel::Voronoi::Diagram::removeDuplicatedEdges()
-{
-	// Because we are comparing smalla mount of edges, vector works fine compared to set or map.
-	// And this function is only called once during initialization, so performance isn't critical.
-	// Todo: Compare speed with set and map.
-	std::vector<Edge*> visited;
+		cell.clearNeighbors();
 
-	auto start = Utility::Time::now();
-
-	for (auto& entry : cells)
-	{
-		auto cell = entry.second;
-
-		auto& edges = cell->getEdges();
-		for (auto& edge : edges)
+		// Two cells share at most one edge, so each shared edge is one neighbor.
+		for (auto& edge : cell.getEdges())
 		{
-			bool skip = false;
-			for (auto vEdge : visited)
+			if (edge.coOwner && edge.coOwner != &cell)
 			{
-				if (vEdge->equal(edge.get()))
-				{
-					skip = true;
-					break;
-				}
-			}
-
-			if (skip)
-			{
-				continue;
-			}
-
-			auto coOwner = edge->getCoOwner();
-			if (coOwner)
-			{
-				visited.push_back(edge.get());
-				auto& coOwnerEdges = coOwner->getEdges();
-				auto size = coOwnerEdges.size();
-
-				for (auto& cEdge : coOwnerEdges)
-				{
-					if (cEdge->equal(edge.get()))
-					{
-						cEdge = edge;
-					}
-				}
-			}
-			else
-			{
-				continue;
+				cell.addNeighbor(edge.coOwner);
 			}
 		}
 	}
 
 	auto end = Utility::Time::now();
 
-	std::cout << "Removing duplicates took: " << Utility::Time::toMicroSecondString(start, end) << std::endl;
+	V_LOG_DEBUG("[Voronoi] Graph construction took: {}ms", std::chrono::duration<double, std::milli>(end - start).count());
 }
 
 unsigned int Voxel::Voronoi::Diagram::xzToIndex(const int x, const int z, const int w)
@@ -931,231 +850,176 @@ unsigned int Voxel::Voronoi::Diagram::xzToIndex(const int x, const int z, const
 
 bool Voxel::Voronoi::Diagram::inRange(const unsigned int index)
 {
-	return (index >= 0) && (index < cells.size());
-}
-
-void Voxel::Voronoi::Diagram::checkNeighborCell(const std::list<std::shared_ptr<Edge>>& edges, Cell* curCell, const unsigned int index)
-{
-	if (inRange(index))
-	{
-		auto nCell = cells.find(index)->second;
-		auto nCellID = nCell->getID();
-		if (isConnected(edges, nCell))
-		{
-			curCell->addNeighbor(nCell);
-		}
-	}
-}
-
-bool Voxel::Voronoi::Diagram::isConnected(const std::list<std::shared_ptr<Edge>>& edges, Cell* neighborCell)
-{
-	if (neighborCell->isValid())
-	{
-	}
-
-	auto& neighborEdges = neighborCell->getEdges();
-	for (auto e : edges)
-	{
-		for (auto& ne : neighborEdges)
-		{
-			if (e->equal(ne.get()))
-			{
-				e->setCoOwner(neighborCell);
-				return true;
-			}
-		}
-	}
-	return false;
+	return index < cells.size();
 }
 
 void Voxel::Voronoi::Diagram::makeSharedEdgesNoisy(std::mt19937& engine)
 {
 	auto start = Utility::Time::now();
-	struct edgeData
-	{
-		std::shared_ptr<Edge> edgePtr;
 
-		std::vector<glm::vec2> points;
+	const unsigned int edgeSize = static_cast<unsigned int>(edges.size());
+
+	// Noisy points of all shared edges in one array. Each edge has range of points that includes start and end.
+	// Only one side of shared edge builds points. Twin uses same points in reversed order.
+	std::vector<glm::vec2> noisyPoints;
+	std::vector<unsigned int> noisyPointsBegin(edgeSize, 0);
+	std::vector<unsigned int> noisyPointsSize(edgeSize, 0);
 
-		bool equal(const unsigned int c0ID, const unsigned int c1ID)
+	// iterate all cells in ID order. Find all shared edge and record the nosiy points
+	for (auto& cell : cells)
+	{
+		// Only for valid cell
+		if (!cell.isValid())
 		{
-			return (edgePtr->getOwner()->getID() == c0ID && edgePtr->getCoOwner()->getID() == c1ID) || (edgePtr->getOwner()->getID() == c1ID && edgePtr->getCoOwner()->getID() == c0ID);
+			continue;
 		}
-	};
 
-	std::vector<edgeData> visited;
+		const unsigned int edgeBegin = static_cast<unsigned int>(cell.edges - edges.data());
+		const unsigned int edgeEnd = edgeBegin + cell.edgeCount;
 
-	// iterate all cells. Find all shared edge and record the nosiy points
-	for (auto& entry : cells)
-	{
-		auto cell = entry.second;
-		// Only for valid cell
-		if (cell->isValid())
+		// iterate edges
+		for (unsigned int i = edgeBegin; i < edgeEnd; i++)
 		{
-			// Get all edges
-			auto& edges = cell->getEdges();
-			auto cellID = cell->getID();
+			auto& edge = edges[i];
 
-			// iterate edges
-			for (auto& edge : edges)
+			// Check coOwner
+			if (edge.coOwner == nullptr || edge.twin == INVALID_EDGE_INDEX || edge.coOwner == &cell)
 			{
-				// Check coOwner
-				auto coOwner = edge->getCoOwner();
-				if (coOwner)
-				{
-					// shared edge. Check if this edge is already visited
-					bool skip = false;
-					auto coOwnerId = coOwner->getID();
-
-					if (coOwnerId == cellID)
-					{
-						continue;
-					}
+				continue;
+			}
 
-					for (auto& pair : visited)
-					{
-						// check cell id
-						if(pair.equal(cellID, coOwnerId))
-						{
-							// Already visited
-							skip = true;
-							break;
-						}
-					}
+			// shared edge. Check if twin already built points
+			if (noisyPointsSize[edge.twin] > 0)
+			{
+				continue;
+			}
 
-					if (skip)
-					{
-						// skip already visited
-						continue;
-					}
-					else
-					{
-						auto e0 = edge->getStart();
-						auto e1 = edge->getEnd();
+			auto e0 = edge.start;
+			auto e1 = edge.end;
 
-						float distanceThreshold = 200.0f;
+			float distanceThreshold = 200.0f;
 
 #if V_DEBUG && V_DEBUG_VORONOI_LINE
-						distanceThreshold *= this->debugSizeScale;
+			distanceThreshold *= this->debugSizeScale;
 #endif
-						if (glm::abs(glm::distance(e0, e1)) < distanceThreshold)
-						{
-							continue;
-						}
+			auto d = glm::abs(glm::distance(e0, e1));
 
-						auto d = glm::abs(glm::distance(e0, e1));
+			if (d < distanceThreshold)
+			{
+				continue;
+			}
 
-						float levelThreadhold = 150.0f;
+			float levelThreadhold = 150.0f;
 
 #if V_DEBUG && V_DEBUG_VORONOI_LINE
-						levelThreadhold *= this->debugSizeScale;
+			levelThreadhold *= this->debugSizeScale;
 #endif
 
-						int level = static_cast<int>(d / levelThreadhold);
+			int level = static_cast<int>(d / levelThreadhold);
 
-						// mark as visited
-						visited.push_back(edgeData());
-						// Add start of edge to points
-						visited.back().points.push_back(edge->getStart());
-						// Add edge
-						visited.back().edgePtr = edge;
+			noisyPointsBegin[i] = static_cast<unsigned int>(noisyPoints.size());
 
-						// Make shared edge noisy
-						buildNoisyEdge(edge->getStart(), edge->getEnd(), cell->getSitePosition(), coOwner->getSitePosition(), visited.back().points, level, level, engine);
-						// add end of edge
-						visited.back().points.push_back(edge->getEnd());
-					}
-				}
-			}
+			// Add start of edge to points
+			noisyPoints.push_back(e0);
+			// Make shared edge noisy
+			buildNoisyEdge(e0, e1, cell.getSitePosition(), edge.coOwner->getSitePosition(), noisyPoints, level, level, engine);
+			// add end of edge
+			noisyPoints.push_back(e1);
+
+			noisyPointsSize[i] = static_cast<unsigned int>(noisyPoints.size()) - noisyPointsBegin[i];
 		}
 	}
 
-	// iterate through visited edge.
-	for (auto& pair : visited)
+	// Number of edges that each edge splits into and index of first one in new edge array
+	auto getSegmentCount = [&](const unsigned int i)
 	{
-		auto owner = pair.edgePtr->getOwner();
-		auto coOwner = pair.edgePtr->getCoOwner();
-
-		// get ids
-		auto ownerID = owner->getID();
-		auto coOwnerID = coOwner->getID();
-
-		if (owner)
+		if (noisyPointsSize[i] > 0)
+		{
+			return noisyPointsSize[i] - 1;
+		}
+		else if (edges[i].twin != INVALID_EDGE_INDEX && noisyPointsSize[edges[i].twin] > 0)
 		{
-			auto& oEdges = owner->getEdges();
+			return noisyPointsSize[edges[i].twin] - 1;
+		}
+		else
+		{
+			return 1u;
+		}
+	};
 
-			auto oEdge_it = oEdges.begin();
+	std::vector<unsigned int> newIndices(edgeSize + 1, 0);
 
-			for (; oEdge_it != oEdges.end();)
-			{
-				auto edgeCoOwner = (*oEdge_it)->getCoOwner();
-				if (edgeCoOwner)
-				{
-					if (edgeCoOwner->getID() == coOwnerID)
-					{
-						oEdge_it = oEdges.erase(oEdge_it);
-						break;
-					}
-				}
+	for (unsigned int i = 0; i < edgeSize; i++)
+	{
+		newIndices[i + 1] = newIndices[i] + getSegmentCount(i);
+	}
 
-				oEdge_it++;
-			}
+	// Rebuild edge array. Noisy edge replaces shared edge in place on both sides, so polygon order is kept.
+	std::vector<Edge> newEdges;
+	newEdges.reserve(newIndices[edgeSize]);
 
-			auto size = pair.points.size() - 1;
-			for (unsigned int i = 0; i < size; i++)
-			{
-				Edge* newEdge = new Edge(pair.points.at(i), pair.points.at(i + 1));
-				newEdge->setOwner(owner);
-				newEdge->setCoOwner(coOwner);
+	for (unsigned int i = 0; i < edgeSize; i++)
+	{
+		const auto& edge = edges[i];
+		const unsigned int count = getSegmentCount(i);
 
-				std::shared_ptr<Edge> ptr(newEdge);
+		if (noisyPointsSize[i] > 0)
+		{
+			// Owner side. Points in order.
+			const glm::vec2* points = noisyPoints.data() + noisyPointsBegin[i];
 
-				oEdges.insert(oEdge_it, ptr);
+			for (unsigned int j = 0; j < count; j++)
+			{
+				newEdges.push_back(Edge(points[j], points[j + 1]));
+				newEdges.back().owner = edge.owner;
+				newEdges.back().coOwner = edge.coOwner;
+				newEdges.back().twin = newIndices[edge.twin] + (count - 1 - j);
 			}
+		}
+		else if (count > 1)
+		{
+			// CoOwner side. Twin's points in reversed order.
+			const glm::vec2* points = noisyPoints.data() + noisyPointsBegin[edge.twin];
 
-			if (coOwner)
+			for (unsigned int j = 0; j < count; j++)
 			{
-				auto& cEdges = coOwner->getEdges();
-
-				// iterators
-				auto cEdge_it = cEdges.begin();
+				newEdges.push_back(Edge(points[count - j], points[count - j - 1]));
+				newEdges.back().owner = edge.owner;
+				newEdges.back().coOwner = edge.coOwner;
+				newEdges.back().twin = newIndices[edge.twin] + (count - 1 - j);
+			}
+		}
+		else
+		{
+			newEdges.push_back(edge);
+			newEdges.back().twin = (edge.twin == INVALID_EDGE_INDEX) ? INVALID_EDGE_INDEX : newIndices[edge.twin];
+		}
+	}
 
-				for (; cEdge_it != cEdges.end();)
-				{
-					auto edgeCoOwner = (*cEdge_it)->getCoOwner();
-					if (edgeCoOwner)
-					{
-						if (edgeCoOwner->getID() == ownerID)
-						{
-							cEdge_it = cEdges.erase(cEdge_it);
-							break;
-						}
-					}
+	// New range of each cell
+	std::vector<unsigned int> edgeOffsets(cells.size(), 0);
 
-					cEdge_it++;
-				}
+	for (auto& cell : cells)
+	{
+		if (cell.edgeCount == 0)
+		{
+			continue;
+		}
 
-				std::vector<glm::vec2> reversedPoints = pair.points;
-				std::reverse(reversedPoints.begin(), reversedPoints.end());
+		const unsigned int edgeBegin = static_cast<unsigned int>(cell.edges - edges.data());
+		const unsigned int edgeEnd = edgeBegin + cell.edgeCount;
 
-				auto reversedSize = reversedPoints.size() - 1;
-				for (unsigned int i = 0; i < reversedSize; i++)
-				{
-					Edge* newEdge = new Edge(reversedPoints.at(i), reversedPoints.at(i + 1));
-					newEdge->setOwner(coOwner);
-					newEdge->setCoOwner(owner);
+		edgeOffsets.at(cell.ID) = newIndices[edgeBegin];
+		cell.edgeCount = newIndices[edgeEnd] - newIndices[edgeBegin];
+	}
 
-					std::shared_ptr<Edge> ptr(newEdge);
+	edges.swap(newEdges);
 
-					cEdges.insert(cEdge_it, ptr);
-				}
-			}
-		}
-	}
+	linkCellEdges(edgeOffsets);
 
 	auto end = Utility::Time::now();
 
-	std::cout << "Edge noise took: " << Utility::Time::toMilliSecondString(start, end) << std::endl;
+	V_LOG_DEBUG("[Voronoi] Edge noise took: {}ms", std::chrono::duration<double, std::milli>(end - start).count());
 }
 
 void Voxel::Voronoi::Diagram::buildNoisyEdge(const glm::vec2 & e0, const glm::vec2 & e1, const glm::vec2 & c0, const glm::vec2 & c1, std::vector<glm::vec2>& points, int level, const int startLevel, std::mt19937& engine)
@@ -1319,28 +1183,28 @@ void Voxel::Voronoi::Diagram::initDebugDiagram(const bool sharedEdges, const boo
 	glPrimitiveRestartIndex(PRIMITIVE_RESTART);
 
 	// Build edges and graph (delaunay triangulation)
-	for (auto&c : cells)
+	for (auto& c : cells)
 	{
 		bool addPolygon = false;
 
-		auto region = (c.second)->getRegion();
+		auto region = c.getRegion();
 		auto difficulty = region->getDifficulty();
 
 		auto difficultyColor = Color::colorU3TocolorV3(Color::getDifficultyColor(difficulty));
 
-		auto& edges = (c.second)->getEdges();
-		for (auto e : edges)
+		auto edges = c.getEdges();
+		for (auto& e : edges)
 		{
-			glm::vec2 e0 = e->getStart();
-			glm::vec2 e1 = e->getEnd();
+			glm::vec2 e0 = e.getStart();
+			glm::vec2 e1 = e.getEnd();
 
-			auto type = (c.second)->getSiteType();
+			auto type = c.getSiteType();
 
 			if (type == Site::Type::MARKED)
 			{
 				if (sharedEdges)
 				{
-					auto coOwner = e->getCoOwner();
+					auto coOwner = e.getCoOwner();
 					if (coOwner)
 					{
 						if (coOwner->getSiteType() == Site::Type::MARKED)
@@ -1419,7 +1283,7 @@ void Voxel::Voronoi::Diagram::initDebugDiagram(const bool sharedEdges, const boo
 				{
 					if (type == Site::Type::OMITTED)
 					{
-						auto coOwner = e->getCoOwner();
+						auto coOwner = e.getCoOwner();
 						if (coOwner)
 						{
 							if (coOwner->getSiteType() == Site::Type::BORDER)
@@ -1453,8 +1317,8 @@ void Voxel::Voronoi::Diagram::initDebugDiagram(const bool sharedEdges, const boo
 
 		if (graph)
 		{
-			auto& neighbors = (c.second)->getNeighbors();
-			auto pos = (c.second)->getSitePosition();
+			auto& neighbors = c.getNeighbors();
+			auto pos = c.getSitePosition();
 
 			for (auto nc : neighbors)
 			{
@@ -1522,10 +1386,10 @@ void Voxel::Voronoi::Diagram::initDebugDiagram(const bool sharedEdges, const boo
 	{
 		for (auto& c : cells)
 		{
-			auto pos = (c.second)->getSitePosition();
-			if ((c.second)->isValid())
+			auto pos = c.getSitePosition();
+			if (c.isValid())
 			{
-				auto type = (c.second)->getSiteType();
+				auto type = c.getSiteType();
 
 				glm::vec3 color;
 				if (type == Site::Type::MARKED)
@@ -1541,7 +1405,7 @@ void Voxel::Voronoi::Diagram::initDebugDiagram(const bool sharedEdges, const boo
 					color = glm::vec3(1.0f);
 				}
 
-				auto difficulty = (c.second)->getRegion()->getDifficulty();
+				auto difficulty = c.getRegion()->getDifficulty();
 
 				float yPad = 1.0f;
 				if (difficulty == 0)
@@ -9,11 +9,11 @@
 
 // cpp
 #include <vector>
-#include <list>
 #include <random>
 #include <unordered_map>
 #include <unordered_set>
 #include <memory>
+#include <limits>
 
 // boost
 #include <polygon\voronoi.hpp>
@@ -27,17 +27,24 @@ using namespace boost::polygon;
 namespace Voxel
 {
 	class Region;
+	class ThreadPool;
 
 	namespace Voronoi
 	{
 		class Cell;
 
+		// Invalid index of edge
+		const unsigned int INVALID_EDGE_INDEX = std::numeric_limits<unsigned int>::max();
+
 		/**
 		*	@class Edge
-		*	@brief A edge in voronoi diagram. 
+		*	@brief A half edge in voronoi diagram. 
+		*
+		*	Edges that two cells share are stored twice, once for each cell, and point each other with twin.
 		*/
 		class Edge
 		{
+			friend class Diagram;
 		private:
 			// Start point of edge
 			glm::vec2 start;
@@ -49,21 +56,44 @@ namespace Voxel
 			// Cell that shares this edge
 			Cell* coOwner;
 
-			// bool 
+			// Index of same edge in coOwner's side. INVALID_EDGE_INDEX if edge isn't shared.
+			unsigned int twin;
 		public:
 			Edge() = delete;
 			Edge(const glm::vec2& start, const glm::vec2& end);
 			~Edge() = default;
 
-			glm::vec2 getStart();
-			glm::vec2 getEnd();
+			glm::vec2 getStart() const;
+			glm::vec2 getEnd() const;
 
 			bool equal(const Edge* edge) const;
 			void setOwner(Cell* cell);
-			Cell* getOwner();
+			Cell* getOwner() const;
 			void setCoOwner(Cell* cell);
-			Cell* getCoOwner();
+			Cell* getCoOwner() const;
+			unsigned int getTwin() const;
+		};
+
+		/**
+		*	@class EdgeRange
+		*	@brief Edges of single cell. Points to contiguous range in diagram's edge array.
+		*/
+		class EdgeRange
+		{
+		private:
+			Edge* first;
+			Edge* last;
+		public:
+			EdgeRange(Edge* first, Edge* last);
+
+			Edge* begin() const;
+			Edge* end() const;
+			Edge& front() const;
+			Edge& back() const;
+			unsigned int size() const;
+			bool empty() const;
 		};
+
 		/**
 		*	@class Site
 		*	@brief A vec2 point in voronoi diagram
@@ -86,10 +116,10 @@ namespace Voxel
 			Site(const glm::vec2& position, const Type type);
 			~Site() = default;
 
-			glm::vec2 getPosition();
-			Type getType();
+			glm::vec2 getPosition() const;
+			Type getType() const;
 			void updateType(const Type type);
-			bool isBorder();
+			bool isBorder() const;
 		};
 
 		/**
@@ -97,46 +127,44 @@ namespace Voxel
 		*	@brief A cell in voronoi diagram. Cell must be surrounded by edges. 
 		*
 		*	Cell works as an node in undirected graph structure of cells.
+		*	Cells are stored by value in diagram, indexed by ID. Edges are range in diagram's edge array.
 		*/
 		class Cell
 		{
+			friend class Diagram;
 		private:
 			// Position of cell in x and z axis
-			Site* site;
-			// List if edges that forms the cell
-			std::list<std::shared_ptr<Edge>> edges;
+			Site site;
+			// First edge that forms the cell and number of edges
+			Edge* edges;
+			unsigned int edgeCount;
 			// Number id
 			unsigned int ID;
 			// True if cell is valid. For now, its only for debugging
 			bool valid;
 			// Neighbors
-			std::list<Cell*> neighbors;
+			std::vector<Cell*> neighbors;
 			// Pointer to region that claims this cell
 			Region* region;
 		public:
 			Cell() = delete;
-			Cell(const unsigned int ID);
-			~Cell();
+			Cell(const unsigned int ID, const Site& site);
+			~Cell() = default;
 
-			void addEdge(Edge* edge);
-
-			glm::vec2 getSitePosition();
-			Site::Type getSiteType();
-			void setSite(const glm::vec2& position, const Site::Type type);
-			void setSite(Site* site);
+			glm::vec2 getSitePosition() const;
+			Site::Type getSiteType() const;
 			void setValidation(const bool valid);
-			bool isValid();
-			std::list<std::shared_ptr<Edge>>& getEdges();
+			bool isValid() const;
+			EdgeRange getEdges() const;
 			void addNeighbor(Cell* cell);
-			std::list<Cell*>& getNeighbors();
-			unsigned int getNeighborSize();
-			void clearEdges();
+			std::vector<Cell*>& getNeighbors();
+			unsigned int getNeighborSize() const;
 			void clearNeighbors();
-			unsigned int getID();
+			unsigned int getID() const;
 			void updateSiteType(Site::Type type);
 			void setRegion(Region* region);
 			Region* getRegion();
-			bool isSiteBorder();
+			bool isSiteBorder() const;
 		};
 
 		class Program;
@@ -154,16 +182,19 @@ namespace Voxel
 		/**
 		*	@class Diagram
 		*	@brief A voronoi diagram. Contains cell and site datas with boost's voronoi diagram
+		*
+		*	Cells and edges are kept in flat arrays. Cell's index equals to its ID, which is index of site.
+		*	Shared edges are linked with boost's half edge twin when cells are built, so finding neighbors doesn't compare edges.
 		*/
 		class Diagram
 		{
 		private:
 			boost::polygon::voronoi_diagram<double> vd;
 
-			// List of cells. key equals to cell's ID that made from boost
-			std::map<unsigned int, Cell*> cells;
-			// Set of all edges
-			std::unordered_set<Edge*> edges;
+			// All cells. Index equals to cell's ID that made from boost
+			std::vector<Cell> cells;
+			// All half edges. Edges of each cell are contiguous.
+			std::vector<Edge> edges;
 
 			// site points
 			std::vector<glm::vec2> sitePositions;
@@ -176,11 +207,15 @@ namespace Voxel
 			// total valid cells
 			int totalValidCells;
 
-			// Build undirected graph between cells
+			// Grid coordinate to cell index
 			unsigned int xzToIndex(const int x, const int z, const int w);
 			bool inRange(const unsigned int index);
-			void checkNeighborCell(const std::list<std::shared_ptr<Edge>>& edges, Cell* curCell, const unsigned int index);
-			bool isConnected(const std::list<std::shared_ptr<Edge>>& edges, Cell* neighborCell);
+
+			// Points cell's edge range to edge array. Call after edge array is rebuilt.
+			void linkCellEdges(const std::vector<unsigned int>& edgeOffsets);
+
+			// Get centroid of cell's polygon
+			glm::vec2 getCentroid(const Cell& cell) const;
 			
 			/**
 			*	helper recursion function for noisy edge
@@ -203,8 +238,12 @@ namespace Voxel
 			//void construct(const std::vector<glm::ivec2>& randomSites);
 			void construct(const std::vector<Site>& randomSites, const float minBound, const float maxBound);
 
-			// Relax voronoi diagram by using Lloyd's relaxation algorithm
-			std::vector<Site> relax();
+			/**
+			*	Relax voronoi diagram by using Lloyd's relaxation algorithm. Moves site of each valid cell to its centroid.
+			*	@param threadPool Thread pool to compute centroids. If nullptr, runs on calling thread.
+			*	@return Relaxed sites in cell ID order. Pass to construct() to rebuild diagram.
+			*/
+			std::vector<Site> relax(ThreadPool* threadPool = nullptr);
 
 			// Build cells with edges. Any cells that has edges out of boundary will be omitted.
 			void buildCells(boost::polygon::voronoi_diagram<double>& vd);
@@ -212,20 +251,26 @@ namespace Voxel
 			// Randomize cells by removing cells
 			void randomizeCells(const int w, const int l, std::mt19937& engine);
 
-			// Build graph based on cells.
-			void buildGraph(const int w, const int l);
-
-			// Remove duplicated edges
-			void removeDuplicatedEdges();
+			// Build graph based on cells. Valid cells are connected to all cells that share edge.
+			void buildGraph();
 
 			// Make edges noisy. Ref: https://www.redblobgames.com/maps/noisy-edges
 			void makeSharedEdgesNoisy(std::mt19937& engine);
 
 			// get cells
-			std::map<unsigned int, Cell*>& getCells();
+			std::vector<Cell>& getCells();
+
+			// Get number of half edges
+			unsigned int getEdgeCount() const;
 
-			// Find shortest path from src to all cell using dijkstra
-			void findShortestPathFromSrc(const unsigned int src, std::vector<float>& dist, std::vector<unsigned int>& prevPath);
+			/**
+			*	Find shortest path from src to all cell using dijkstra with binary heap.
+			*	@param src Source cell ID.
+			*	@param dist Distance from src for each cell. Max float if cell can't be reached.
+			*	@param prevPath Previous cell on shortest path for each cell. src for src, -1 if cell can't be reached.
+			*	@param pathSizes Number of cells on shortest path for each cell, excluding src.
+			*/
+			void findShortestPathFromSrc(const unsigned int src, std::vector<float>& dist, std::vector<unsigned int>& prevPath, std::vector<unsigned int>& pathSizes);
 			
 			// Check if point is in boundary
 			bool isPointInBoundary(const glm::vec2& point);
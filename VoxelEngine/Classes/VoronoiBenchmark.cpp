@@ -0,0 +1,183 @@
+// pch
+#include "PreCompiled.h"
+
+#include "VoronoiBenchmark.h"
+
+// cpp
+#include <thread>
+
+// voxel
+#include "ThreadPool.h"
+#include "Benchmark.h"
+#include "Utility.h"
+
+using namespace Voxel;
+
+Voxel::VoronoiBenchmark::VoronoiBenchmark(const int threadCount)
+	: threadCount(threadCount)
+{}
+
+void Voxel::VoronoiBenchmark::buildSites(const int gridSize, std::mt19937 & engine, std::vector<Voronoi::Site>& sites)
+{
+	// Same values as World::initVoronoi
+	const int interval = 1000;
+	const int intervalHalf = interval / 2;
+
+	const int pad = interval / 10;
+	const int randMax = (interval - (pad * 2)) / 2;
+	const int randMin = randMax * -1;
+
+	std::uniform_int_distribution<> dist(randMin, randMax);
+
+	const int center = gridSize / 2;
+	const int last = gridSize - 1;
+
+	sites.clear();
+	sites.reserve(gridSize * gridSize);
+
+	glm::ivec2 pos = (glm::ivec2(center, center) * interval) - intervalHalf;
+
+	for (int x = 0; x < gridSize; x++)
+	{
+		for (int z = 0; z < gridSize; z++)
+		{
+			if (x == 0 || z == 0 || x == last || z == last)
+			{
+				sites.push_back(Voronoi::Site(glm::vec2(pos), Voronoi::Site::Type::BORDER));
+			}
+			else
+			{
+				const int randX = dist(engine);
+				const int randZ = dist(engine);
+
+				sites.push_back(Voronoi::Site(glm::vec2(pos + glm::ivec2(randX, randZ)), Voronoi::Site::Type::MARKED));
+			}
+
+			pos.y -= interval;
+		}
+
+		pos.y = (center * interval) - intervalHalf;
+		pos.x -= interval;
+	}
+}
+
+VoronoiBenchmark::Result Voxel::VoronoiBenchmark::runOnce(const int gridSize)
+{
+	std::mt19937 engine(static_cast<unsigned int>(gridSize));
+
+	std::vector<Voronoi::Site> sites;
+	buildSites(gridSize, engine, sites);
+
+	const float maxBound = static_cast<float>((gridSize / 2) * 1000);
+	const float minBound = -maxBound;
+
+	// Calling thread also works on parallelFor
+	ThreadPool threadPool(static_cast<unsigned int>(threadCount - 1));
+
+	Voronoi::Diagram diagram;
+
+	Result result;
+	result.gridSize = gridSize;
+
+	auto start = Utility::Time::now();
+
+	diagram.construct(sites, minBound, maxBound);
+
+	auto constructed = Utility::Time::now();
+
+	// Relax once and rebuild from relaxed sites
+	sites = diagram.relax(&threadPool);
+	diagram.construct(sites, minBound, maxBound);
+
+	auto relaxed = Utility::Time::now();
+
+	diagram.buildGraph();
+
+	auto graphBuilt = Utility::Time::now();
+
+	diagram.randomizeCells(gridSize, gridSize, engine);
+
+	auto randomized = Utility::Time::now();
+
+	diagram.makeSharedEdgesNoisy(engine);
+
+	auto noisy = Utility::Time::now();
+
+	std::vector<float> dist;
+	std::vector<unsigned int> prevPath;
+	std::vector<unsigned int> pathSizes;
+
+	const unsigned int centerCell = static_cast<unsigned int>(((gridSize / 2) * gridSize) + (gridSize / 2));
+	diagram.findShortestPathFromSrc(centerCell, dist, prevPath, pathSizes);
+
+	auto end = Utility::Time::now();
+
+	result.cellCount = static_cast<unsigned int>(diagram.getCells().size());
+	result.edgeCount = diagram.getEdgeCount();
+	result.constructMilliSeconds = Benchmark::toMilliSeconds(start, constructed);
+	result.relaxMilliSeconds = Benchmark::toMilliSeconds(constructed, relaxed);
+	result.buildGraphMilliSeconds = Benchmark::toMilliSeconds(relaxed, graphBuilt);
+	result.randomizeMilliSeconds = Benchmark::toMilliSeconds(graphBuilt, randomized);
+	result.noisyEdgeMilliSeconds = Benchmark::toMilliSeconds(randomized, noisy);
+	result.shortestPathMilliSeconds = Benchmark::toMilliSeconds(noisy, end);
+	result.totalMilliSeconds = Benchmark::toMilliSeconds(start, end);
+
+	return result;
+}
+
+void Voxel::VoronoiBenchmark::printResult(const Result & result)
+{
+	Benchmark::ResultLine("VoronoiBenchmark")
+		.add("grid", std::to_string(result.gridSize) + "x" + std::to_string(result.gridSize))
+		.add("cells", result.cellCount)
+		.add("edges", result.edgeCount)
+		.add("construct", result.constructMilliSeconds, "ms")
+		.add("relax", result.relaxMilliSeconds, "ms")
+		.add("graph", result.buildGraphMilliSeconds, "ms")
+		.add("randomize", result.randomizeMilliSeconds, "ms")
+		.add("noisy edges", result.noisyEdgeMilliSeconds, "ms")
+		.add("shortest path", result.shortestPathMilliSeconds, "ms")
+		.add("total", result.totalMilliSeconds, "ms")
+		.print();
+}
+
+void Voxel::VoronoiBenchmark::run(const std::vector<int>& gridSizes)
+{
+	std::cout << "[VoronoiBenchmark] Threads: " << threadCount << "\n";
+
+	for (auto gridSize : gridSizes)
+	{
+		printResult(runOnce(gridSize));
+	}
+}
+
+int Voxel::VoronoiBenchmark::runFromCommandLine(const int argc, const char * argv[])
+{
+	// argv[0] is exe, argv[1] is --voronoi-bench
+	int maxGridSize = 200;
+	int threadCount = static_cast<int>(std::thread::hardware_concurrency());
+
+	// randomizeCells needs at least 1 inner ring and 1 cell inside
+	if (!Benchmark::parseArguments(argc, argv, { { &maxGridSize, 5 }, { &threadCount, 1 } }, "[max grid size] [thread count]"))
+	{
+		return 1;
+	}
+
+	// 10, 25, 50, 100, 200, ... and max
+	std::vector<int> gridSizes;
+	for (int gridSize : { 10, 25, 50 })
+	{
+		if (gridSize < maxGridSize)
+		{
+			gridSizes.push_back(gridSize);
+		}
+	}
+
+	auto steps = Benchmark::doublingSteps(100, maxGridSize);
+	gridSizes.insert(gridSizes.end(), steps.begin(), steps.end());
+
+	VoronoiBenchmark benchmark(threadCount);
+	benchmark.run(gridSizes);
+
+	return 0;
+}
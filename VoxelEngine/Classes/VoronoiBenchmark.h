@@ -0,0 +1,76 @@
+#ifndef VORONOI_BENCHMARK_H
+#define VORONOI_BENCHMARK_H
+
+// cpp
+#include <vector>
+#include <random>
+
+// voxel
+#include "Voronoi.h"
+
+namespace Voxel
+{
+	/**
+	*	@class VoronoiBenchmark
+	*	@brief Measures each step of building world layout from voronoi diagram without window or OpenGL context.
+	*
+	*	Generates sites same as World::initVoronoi (jittered grid with border ring) and times construct, relax,
+	*	buildGraph, randomizeCells, makeSharedEdgesNoisy and shortest path from center cell.
+	*	Runs once per grid size so scaling of each step can be compared.
+	*
+	*	Run with: VoxelEngine.exe --voronoi-bench [max grid size] [thread count]
+	*/
+	class VoronoiBenchmark
+	{
+	public:
+		// Result of single run. Times are in milliseconds.
+		struct Result
+		{
+			int gridSize;
+			unsigned int cellCount;
+			unsigned int edgeCount;
+			float constructMilliSeconds;
+			float relaxMilliSeconds;
+			float buildGraphMilliSeconds;
+			float randomizeMilliSeconds;
+			float noisyEdgeMilliSeconds;
+			float shortestPathMilliSeconds;
+			float totalMilliSeconds;
+		};
+	private:
+		// Number of threads for relax. Includes calling thread.
+		int threadCount;
+
+		// Generates sites in grid. Edge of grid is border.
+		void buildSites(const int gridSize, std::mt19937& engine, std::vector<Voronoi::Site>& sites);
+
+		// Runs all steps once with given grid size
+		Result runOnce(const int gridSize);
+
+		// Print result of single run
+		void printResult(const Result& result);
+	public:
+		/**
+		*	Constructor
+		*	@param threadCount Number of threads for relax.
+		*/
+		VoronoiBenchmark(const int threadCount);
+
+		// Destructor
+		~VoronoiBenchmark() = default;
+
+		/**
+		*	Runs benchmark for each grid size.
+		*	@param gridSizes Width and length of grid for each run.
+		*/
+		void run(const std::vector<int>& gridSizes);
+
+		/**
+		*	Parses arguments after --voronoi-bench and runs benchmark with grid size 10, 25, 50, 100, ... up to max.
+		*	@return Exit code for process.
+		*/
+		static int runFromCommandLine(const int argc, const char* argv[]);
+	};
+}
+
+#endif
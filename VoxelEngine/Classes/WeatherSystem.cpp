@@ -3,13 +3,88 @@
 
 #include "WeatherSystem.h"
 
+// voxel
+#include "WorldParticleSystem.h"
+
 using namespace Voxel;
 
 WeatherSystem::WeatherSystem()
+	: weather(Weather::CLEAR)
+	, intensity(0.0f)
+	, spawnAccumulator(0.0f)
+{}
+
+void Voxel::WeatherSystem::setWeather(const Weather weather, const float intensity)
+{
+	this->weather = weather;
+	this->intensity = glm::clamp(intensity, 0.0f, 1.0f);
+
+	spawnAccumulator = 0.0f;
+}
+
+WeatherSystem::Weather Voxel::WeatherSystem::getWeather() const
+{
+	return weather;
+}
+
+float Voxel::WeatherSystem::getIntensity() const
 {
+	return intensity;
 }
 
+void Voxel::WeatherSystem::update(const float delta, const glm::vec3 & center, WorldParticleSystem * particleSystem)
+{
+	if (weather == Weather::CLEAR || particleSystem == nullptr || intensity <= 0.0f)
+	{
+		return;
+	}
+
+	// Drops per second at max intensity
+	const float maxDropsPerSecond = (weather == Weather::RAIN) ? 6000.0f : 2000.0f;
+	// Half size of box in x and z that drops are emitted
+	const float range = 32.0f;
+	// Height of box from center
+	const float height = 24.0f;
+
+	spawnAccumulator += maxDropsPerSecond * intensity * delta;
+
+	const int count = static_cast<int>(spawnAccumulator);
+	spawnAccumulator -= static_cast<float>(count);
+
+	for (int i = 0; i < count; i++)
+	{
+		const glm::vec3 position(center.x + random.randRangeFloat(-range, range), center.y + height + random.randRangeFloat(0.0f, 4.0f), center.z + random.randRangeFloat(-range, range));
+
+		bool emitted = false;
+
+		if (weather == Weather::RAIN)
+		{
+			emitted = particleSystem->emit(WorldParticleSystem::Type::RAIN, position, glm::vec3(0.0f, -18.0f, 0.0f), 3.0f, 0.05f, glm::vec4(0.55f, 0.65f, 0.85f, 0.8f));
+		}
+		else
+		{
+			emitted = particleSystem->emit(WorldParticleSystem::Type::SNOW, position, glm::vec3(0.0f, -1.0f, 0.0f), 25.0f, 0.1f, glm::vec4(1.0f));
+		}
+
+		if (!emitted)
+		{
+			// Pool is full. Try again on next update.
+			break;
+		}
+	}
+}
 
-WeatherSystem::~WeatherSystem()
+std::string Voxel::WeatherSystem::weatherToString(const Weather weather)
 {
+	switch (weather)
+	{
+	case Weather::CLEAR:
+		return "CLEAR";
+	case Weather::RAIN:
+		return "RAIN";
+	case Weather::SNOW:
+		return "SNOW";
+	default:
+		return "ERROR";
+	}
 }
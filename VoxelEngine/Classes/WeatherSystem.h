@@ -1,14 +1,30 @@
 #ifndef WEATHER_SYSTEM_H
 #define WEATHER_SYSTEM_H
 
+// cpp
+#include <string>
+
+// glm
+#include <glm\glm.hpp>
+
+// voxel
+#include "Random.h"
+
 namespace Voxel
 {
+	// foward declaration
+	class WorldParticleSystem;
+
 	/**
 	*	@class WeatherSystem
 	*	@brief System that manages weather in the game.
 	*
 	*	Weather system manages everything that related to weather like rain, snow, thunder, clouds.
 	*
+	*	Rain and snow
+	*	Drops are emitted to WorldParticleSystem in box above the player. Number of drops per second scales with intensity.
+	*	Drops die when they hit block, so weather doesn't own any particle memory.
+	*
 	*	Clouds
 	*	Clouds are treated as entity. It gets updated and floats in the sky. 
 	*	Once cloud are completely out of sight, it repositions itself to opposite site.
@@ -17,9 +33,55 @@ namespace Voxel
 	class WeatherSystem
 	{
 	public:
+		enum class Weather
+		{
+			CLEAR = 0,
+			RAIN,
+			SNOW,
+		};
+	private:
+		// Current weather
+		Weather weather;
+
+		// 0.0 ~ 1.0
+		float intensity;
+
+		// Fraction of drop that wasn't emitted on last update
+		float spawnAccumulator;
+
+		// For drop position
+		Random random;
+	public:
+		// Constructor
 		WeatherSystem();
-		~WeatherSystem();
+
+		// Destructor
+		~WeatherSystem() = default;
+
+		/**
+		*	Set weather.
+		*	@param weather Weather to set.
+		*	@param intensity Intensity of rain or snow. Clamped to [0, 1].
+		*/
+		void setWeather(const Weather weather, const float intensity);
+
+		// Get current weather
+		Weather getWeather() const;
+
+		// Get current intensity
+		float getIntensity() const;
+
+		/**
+		*	Emits rain or snow drops around center.
+		*	@param delta Elapsed time.
+		*	@param center Center of area to emit. Usually player position.
+		*	@param particleSystem Particle system to emit.
+		*/
+		void update(const float delta, const glm::vec3& center, WorldParticleSystem* particleSystem);
+
+		// Get weather in string
+		static std::string weatherToString(const Weather weather);
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -11,16 +11,17 @@
 using namespace Voxel;
 
 World::World()
-	: currentRegion(nullptr)
-	, vd(nullptr)
-	, gridWidth(0)
-	, gridLength(0)
-	, minTemperature(0)
+	: minTemperature(0)
 	, maxTemperature(0)
 	, minMoisture(0)
 	, maxMoisture(0)
-	, renderVoronoiMode(false)
+	, currentRegion(nullptr)
+	, gridWidth(0)
+	, gridLength(0)
 	, id(-1)
+	, vd(nullptr)
+	, tileMap(nullptr)
+	, renderVoronoiMode(false)
 {
 }
 
@@ -31,6 +32,15 @@ World::~World()
 		delete vd;
 	}
 
+	currentRegion = nullptr;
+	currentTile = nullptr;
+	lookupTile = nullptr;
+
+	if (tileMap)
+	{
+		delete tileMap;
+	}
+
 	for (auto& e : regions)
 	{
 		if (e.second)
@@ -63,15 +73,54 @@ void Voxel::World::init(const int gridWidth, const int gridLength, const unsigne
 	initRegionBiomeAndTerrain();
 	printRegionBiomeAndTerrain();
 
-#if V_DEBUG && V_DEBUG_VORONOI_LINE
-	initVoronoiDebug();
-#endif
+	// Debug diagram needs OpenGL, so owner calls initVoronoiDebug on main thread.
 
 	print();
 }
 
+void Voxel::World::initTiled(const unsigned int id, const std::string & globalSeed, const unsigned int tileCacheSize)
+{
+	this->gridWidth = 0;
+	this->gridLength = 0;
+
+	this->seed = globalSeed + "W" + std::to_string(id);
+
+	std::cout << "[World] Using seed: " << seed << " (tiled)\n";
+
+	this->id = id;
+
+	tileMap = new RegionTileMap(this->seed, minTemperature, maxTemperature, minMoisture, maxMoisture, tileCacheSize);
+
+	const unsigned int startingRegionID = tileMap->getStartingRegionID();
+
+	currentTile = tileMap->getTileOfRegion(startingRegionID);
+	currentRegion = currentTile->getRegion(RegionTileMap::toSiteCoordinate(startingRegionID));
+}
+
+bool Voxel::World::isTiled() const
+{
+	return tileMap != nullptr;
+}
+
 void Voxel::World::rebuildWorldMap()
 {
+	if (tileMap)
+	{
+		// Tiles are generated from seed. Drop cache and rebuild starting tile.
+		const unsigned int startingRegionID = tileMap->getStartingRegionID();
+
+		currentRegion = nullptr;
+		currentTile = nullptr;
+		lookupTile = nullptr;
+
+		tileMap->clear();
+
+		currentTile = tileMap->getTileOfRegion(startingRegionID);
+		currentRegion = currentTile->getRegion(RegionTileMap::toSiteCoordinate(startingRegionID));
+
+		return;
+	}
+
 	// By recreating local engine, we can get same result from all random during world initialization
 	std::mt19937 engine(std::hash<std::string>{}(this->seed));
 
@@ -93,6 +142,11 @@ Voronoi::Diagram * Voxel::World::getVoronoi()
 	return vd;
 }
 
+RegionTileMap * Voxel::World::getRegionTileMap()
+{
+	return tileMap;
+}
+
 /*
 bool Voxel::World::findRegionWithAABB(const AABB & boundingBox, unsigned int & regionID) const
 {
@@ -193,6 +247,11 @@ bool Voxel::World::findFirstRegionHasPoint(const glm::vec2 & point, unsigned int
 
 unsigned int Voxel::World::findClosestRegionToPoint(const glm::vec2 & point)
 {
+	if (tileMap)
+	{
+		return tileMap->findRegionIDAtPoint(point);
+	}
+
 	if (vd->isPointInBoundary(point))
 	{
 		float dist = std::numeric_limits<float>::max();
@@ -240,11 +299,79 @@ unsigned int Voxel::World::findRegionHasPoint(const glm::vec2 & point)
 
 bool Voxel::World::isPointInBoundary(const glm::vec2 & point)
 {
+	if (tileMap)
+	{
+		// No boundary
+		return true;
+	}
+
 	return vd->isPointInBoundary(point);
 }
 
+unsigned int Voxel::World::findRegionAtPoint(const glm::vec2 & point)
+{
+	if (tileMap)
+	{
+		// Closest site of warped point. Always in region.
+		return tileMap->findRegionIDAtPoint(point);
+	}
+
+	if (!vd->isPointInBoundary(point))
+	{
+		return -1;
+	}
+
+	// Find cloest region to point
+	unsigned int closestRegionID = findClosestRegionToPoint(point);
+
+	auto region = getRegion(closestRegionID);
+
+	if (region->isBorder())
+	{
+		// Region is border. Just use closest
+		return closestRegionID;
+	}
+
+	// Shared edges are noisy. Closest region might not have the point.
+	if (region->isPointIsInRegion(point))
+	{
+		return closestRegionID;
+	}
+
+	// Check if neighbor regions has point
+	unsigned int regionID = -1;
+	if (region->isPointIsInRegionNeighbor(point, regionID))
+	{
+		return regionID;
+	}
+
+	// Even neighbor regions doesn't have this point. Can't figure out why, assert false it.
+	assert(false);
+	return -1;
+}
+
 Region * Voxel::World::getRegion(const unsigned int regionID)
 {
+	if (tileMap)
+	{
+		const glm::ivec2 siteCoordinate = RegionTileMap::toSiteCoordinate(regionID);
+
+		// Current tile is always held
+		if (currentTile)
+		{
+			Region* region = currentTile->getRegion(siteCoordinate);
+
+			if (region)
+			{
+				return region;
+			}
+		}
+
+		// Hold tile, so region isn't released when tile map evicts it
+		lookupTile = tileMap->getTileOfRegion(regionID);
+		return lookupTile->getRegion(siteCoordinate);
+	}
+
 	auto find_it = regions.find(regionID);
 	if (find_it == regions.end())
 	{
@@ -258,15 +385,70 @@ Region * Voxel::World::getRegion(const unsigned int regionID)
 
 int Voxel::World::getRegionDifficulty(const unsigned int regionID)
 {
-	auto find_it = regions.find(regionID);
-	if (find_it == regions.end())
+	Region* region = nullptr;
+
+	// Hold tile while reading region
+	auto tile = findRegion(regionID, region);
+
+	return region ? region->getDifficulty() : -1;
+}
+
+bool Voxel::World::getRegionTerrainType(const unsigned int regionID, Terrain & terrainType)
+{
+	Region* region = nullptr;
+
+	auto tile = findRegion(regionID, region);
+
+	if (region == nullptr)
 	{
-		return -1;
+		return false;
 	}
-	else
+
+	terrainType = region->getTerrainType();
+	return true;
+}
+
+bool Voxel::World::getRegionBiomeType(const unsigned int regionID, Biome & biomeType)
+{
+	Region* region = nullptr;
+
+	auto tile = findRegion(regionID, region);
+
+	if (region == nullptr)
+	{
+		return false;
+	}
+
+	biomeType = region->getBiomeType();
+	return true;
+}
+
+bool Voxel::World::getRegionSitePosition(const unsigned int regionID, glm::vec2 & sitePosition)
+{
+	Region* region = nullptr;
+
+	auto tile = findRegion(regionID, region);
+
+	if (region == nullptr)
+	{
+		return false;
+	}
+
+	sitePosition = region->getSitePosition();
+	return true;
+}
+
+std::shared_ptr<RegionTileMap::Tile> Voxel::World::findRegion(const unsigned int regionID, Region *& region)
+{
+	if (tileMap)
 	{
-		return (find_it->second)->getDifficulty();
+		auto tile = tileMap->getTileOfRegion(regionID);
+		region = tile->getRegion(RegionTileMap::toSiteCoordinate(regionID));
+		return tile;
 	}
+
+	region = getRegion(regionID);
+	return nullptr;
 }
 
 /*
@@ -324,6 +506,24 @@ bool Voxel::World::updatePlayerPos(const glm::vec3 & playerPos)
 {
 	// Check if player moved to new region
 	auto pos = glm::vec2(playerPos.x, playerPos.z);
+
+	if (tileMap)
+	{
+		// Same lookup as chunk generation so region matches blocks
+		const unsigned int regionID = tileMap->findRegionIDAtPoint(pos);
+
+		if (regionID == currentRegion->getID())
+		{
+			return false;
+		}
+
+		std::cout << "Player moved to region #" << regionID << " from " << currentRegion->getID() << std::endl;
+
+		currentTile = tileMap->getTileOfRegion(regionID);
+		currentRegion = currentTile->getRegion(RegionTileMap::toSiteCoordinate(regionID));
+		return true;
+	}
+
 	if (currentRegion->isPointIsInRegion(pos))
 	{
 		return false;
@@ -392,7 +592,6 @@ void Voxel::World::initVoronoi(std::mt19937& engine)
 
 	const int EMPTY = 0;
 	const int MARKED = 1;
-	const int OMITTED = 2;
 	const int BORDER = 3;
 
 	// Fill with M (1)
@@ -422,35 +621,6 @@ void Voxel::World::initVoronoi(std::mt19937& engine)
 		grid.at(i).back() = BORDER;
 	}
 
-	// print grid
-	for (auto i : grid)
-	{
-		for (auto j : i)
-		{
-			std::string str;
-			switch (j)
-			{
-			case EMPTY:
-				str = "0";
-				break;
-			case MARKED:
-				str = "M";
-				break;
-			case OMITTED:
-				str = "X";
-				break;
-			case BORDER:
-				str = "B";
-				break;
-			default:
-				continue;
-				break;
-			}
-			std::cout << str << " ";
-		}
-		std::cout << std::endl;
-	}
-
 	//based on grid, generate random points
 
 	int xPos = grid.size() / 2;
@@ -472,13 +642,14 @@ void Voxel::World::initVoronoi(std::mt19937& engine)
 	const int omittedRandMin = omittedRandMax * -1;
 
 	std::vector<Voronoi::Site> points;
+	points.reserve(gridWidth * gridLength);
 
 	// dist
 	std::uniform_int_distribution<> dist(randMin, randMax);
 
 	unsigned int index = 0;
 
-	for (auto x : grid)
+	for (auto& x : grid)
 	{
 		for (auto z : x)
 		{
@@ -529,7 +700,6 @@ void Voxel::World::initVoronoi(std::mt19937& engine)
 
 			points.push_back(Voronoi::Site(randPos, type));
 
-			std::cout << "Creating random site pos (" << randPos.x << ", " << randPos.y << "), on id(index) = " << index << "\n";
 			index++;
 
 			pos.y/*z*/ -= interval;
@@ -551,7 +721,7 @@ void Voxel::World::initVoronoi(std::mt19937& engine)
 	//vd->construct(points, minBound, maxBound);
 	//vd->buildCells(minBound, maxBound);
 
-	vd->buildGraph(gridWidth, gridLength);
+	vd->buildGraph();
 	vd->randomizeCells(gridWidth, gridLength, engine);
 
 	//vd->removeDuplicatedEdges();
@@ -588,12 +758,13 @@ void Voxel::World::initRegions(std::mt19937& engine)
 
 	startingRegionID = candidates.at(randIndex);
 
-	for (auto e : cells)
+	regions.reserve(cells.size());
+
+	for (auto& c : cells)
 	{
-		auto cell = e.second;
+		auto cell = &c;
 
 		auto cellID = cell->getID();
-		auto cellSitePos = cell->getSitePosition();
 
 		Region* newRegion = new Region(cell);
 		cell->setRegion(newRegion);
@@ -621,10 +792,11 @@ void Voxel::World::initRegionDifficulty()
 	// from staring region, calculate distance to all region from starting region
 	std::vector<float> dist;
 	std::vector<unsigned int> prevPath;
+	std::vector<unsigned int> pathSizes;
 
 	unsigned int startingRegionID = currentRegion->getID();
 
-	vd->findShortestPathFromSrc(startingRegionID, dist, prevPath);
+	vd->findShortestPathFromSrc(startingRegionID, dist, prevPath, pathSizes);
 
 	// Based on dist and prevPath, calculate difficulty.
 	// Difficulty is defined with number of path point and total distance from starting region
@@ -642,9 +814,9 @@ void Voxel::World::initRegionDifficulty()
 	auto& cells = vd->getCells();
 	std::vector<pair> pairs(cells.size(), { 0, 0 });
 
-	for (auto e : cells)
+	for (auto& c : cells)
 	{
-		auto cell = e.second;
+		auto cell = &c;
 
 		if (cell->isValid())
 		{
@@ -657,14 +829,8 @@ void Voxel::World::initRegionDifficulty()
 
 			pairs.at(cellID).dist = d;
 
-			// Build path. 
-			int pathSize = 0;
-			unsigned int curID = cellID;
-			while (curID != startingRegionID)
-			{
-				curID = prevPath.at(curID);
-				pathSize++;
-			}
+			// Number of cells on path. Counted while finding path.
+			int pathSize = static_cast<int>(pathSizes.at(cellID));
 
 			if (pathSize > maxPathSize)
 			{
@@ -675,9 +841,9 @@ void Voxel::World::initRegionDifficulty()
 		}
 	}
 
-	for (auto e : cells)
+	for (auto& c : cells)
 	{
-		auto cell = e.second;
+		auto cell = &c;
 
 		if (cell->isValid())
 		{
@@ -816,9 +982,9 @@ void Voxel::World::initVoronoiDebug()
 
 void Voxel::World::renderVoronoi(Program* program)
 {
-	if (renderVoronoiMode)
+	if (renderVoronoiMode && vd)
 	{
-		program->setUniformMat4("modelMat", glm::mat4(1.0f));
+		program->setUniformMat4(SID("modelMat"), glm::mat4(1.0f));
 		vd->render();
 	}
 }
@@ -4,20 +4,28 @@
 // cpp
 #include <unordered_map>
 #include <random>
+#include <memory>
 
 // voxel
 #include "Config.h"
 #include "Voronoi.h"
+#include "RegionTileMap.h"
 
 namespace Voxel
 {
 	class Region;
 	class Program;
+	class Biome;
+	class Terrain;
 
 	/**
 	*	@class World
 	*	
 	*	Contains region data built by voronoi diagram
+	*
+	*	World is either bounded or tiled.
+	*	Bounded world builds single voronoi diagram and all regions on init. Edge of grid is border region.
+	*	Tiled world has no boundary. Regions are built per tile on demand by RegionTileMap and released when tile is evicted.
 	*/
 	class World
 	{
@@ -44,9 +52,18 @@ namespace Voxel
 		// World's unique seed
 		std::string seed;
 
-		// Voronoi diagram
+		// Voronoi diagram. nullptr if world is tiled.
 		Voronoi::Diagram* vd;
 
+		// Tiled region layout. nullptr if world is bounded.
+		RegionTileMap* tileMap;
+
+		// Keeps tile of current region in memory while player is in it
+		std::shared_ptr<RegionTileMap::Tile> currentTile;
+
+		// Keeps tile of last region returned by getRegion in memory, if region wasn't in current tile
+		std::shared_ptr<RegionTileMap::Tile> lookupTile;
+
 		// render mode
 		bool renderVoronoiMode;
 
@@ -62,6 +79,9 @@ namespace Voxel
 		void initRegionBiome(std::mt19937& engine);
 		void initRegionTerrain(std::mt19937& engine);
 
+		// Find region. Region is valid while returned tile is held. Returned tile is nullptr if world is bounded.
+		std::shared_ptr<RegionTileMap::Tile> findRegion(const unsigned int regionID, Region*& region);
+
 		// debug
 		void printRegionBiomeAndTerrain();
 	public:
@@ -72,9 +92,21 @@ namespace Voxel
 		void init(const int gridWidth, const int gridLength, const unsigned int id, const std::string& globalSeed);
 		void rebuildWorldMap();
 
+		/**
+		*	Initialize unbounded world. Regions are built per tile when chunk or player reaches it.
+		*	@param id World number id.
+		*	@param globalSeed Game seed.
+		*	@param tileCacheSize Max number of tiles kept in memory.
+		*/
+		void initTiled(const unsigned int id, const std::string& globalSeed, const unsigned int tileCacheSize = RegionTileMap::DEFAULT_CAPACITY);
+
+		// Check if world is tiled
+		bool isTiled() const;
+
 		// Getters
 		Region* getCurrentRegion();
 		Voronoi::Diagram* getVoronoi();
+		RegionTileMap* getRegionTileMap();
 		 
 		// Find region that contains the bounding box and return the region(Cell) id. If success, returns true. Else, false.
 		/*
@@ -87,12 +119,27 @@ namespace Voxel
 		unsigned int findRegionHasPoint(const glm::vec2& point);
 		bool isPointInBoundary(const glm::vec2& point);
 
-		// Get retion
+		// Find region that has point. Returns -1 if point is out of boundary. Thread safe.
+		unsigned int findRegionAtPoint(const glm::vec2& point);
+
+		/**
+		*	Get region. Main thread only.
+		*	On tiled world, region is valid until getRegion is called with region in other tile or world is rebuilt. Other threads must use queries below.
+		*/
 		Region* getRegion(const unsigned int regionID);
 
-		// get region difficulty
+		// get region difficulty. Thread safe.
 		int getRegionDifficulty(const unsigned int regionID);
 
+		// Get region's terrain type. Returns false if region doesn't exist. Thread safe.
+		bool getRegionTerrainType(const unsigned int regionID, Terrain& terrainType);
+
+		// Get region's biome type. Returns false if region doesn't exist. Thread safe.
+		bool getRegionBiomeType(const unsigned int regionID, Biome& biomeType);
+
+		// Get region's site position. Returns false if region doesn't exist. Thread safe.
+		bool getRegionSitePosition(const unsigned int regionID, glm::vec2& sitePosition);
+
 		// Check if point is in region
 		/*
 		bool isPointInRegion(const unsigned int regionID, const glm::vec2& point);
@@ -114,7 +161,7 @@ namespace Voxel
 		// Get world seed
 		std::string getSeed();
 
-		// Get grid size
+		// Get grid size. 0 if world is tiled.
 		unsigned int getGridSize();
 
 		// Renders visible chunk
@@ -0,0 +1,261 @@
+// pch
+#include "PreCompiled.h"
+
+#include "WorldGenBenchmark.h"
+
+// win32. Memory sampling is Windows only.
+#if defined(_WIN32)
+#include <Psapi.h>
+#endif
+
+// cpp
+#include <thread>
+#include <chrono>
+
+// voxel
+#include "World.h"
+#include "Region.h"
+#include "ChunkMap.h"
+#include "Chunk.h"
+#include "ChunkMesh.h"
+#include "ChunkMeshGenerator.h"
+#include "ChunkWorkManager.h"
+#include "SimplexNoise.h"
+#include "Benchmark.h"
+#include "Utility.h"
+
+using namespace Voxel;
+
+Voxel::WorldGenBenchmark::WorldGenBenchmark(const std::string & seed, const int radius, const bool tiled)
+	: seed(seed)
+	, radius(radius)
+	, tiled(tiled)
+{}
+
+bool Voxel::WorldGenBenchmark::run(const std::vector<int>& threadCounts)
+{
+	std::cout << "[WorldGenBenchmark] Seed: " << seed << ", radius: " << radius << (tiled ? ", tiled" : "") << "\n";
+
+	bool success = true;
+
+	for (auto threadCount : threadCounts)
+	{
+		auto result = runOnce(threadCount);
+
+		printResult(result);
+		printProfile(result.profile);
+
+		if (result.generatedChunks < result.expectedChunks)
+		{
+			std::cout << "[WorldGenBenchmark] Error: Generated " << result.generatedChunks << " of " << result.expectedChunks << " chunks\n";
+			success = false;
+		}
+	}
+
+	return success;
+}
+
+WorldGenBenchmark::Result Voxel::WorldGenBenchmark::runOnce(const int threadCount)
+{
+	// Same order as GameScene::initRandoms and createWorld
+	Noise::Manager::init(seed);
+
+	World* world = new World();
+	world->setTemperature(0.5f, 1.5f);
+	world->setMoisture(0.5f, 1.5f);
+	if (tiled)
+	{
+		world->initTiled(0, seed);
+	}
+	else
+	{
+		world->init(10, 10, 0, seed);
+	}
+
+	auto startingRegionSitePos = glm::vec2(glm::ivec2(world->getCurrentRegion()->getSitePosition())) + 0.5f;
+
+	ChunkMap* chunkMap = new ChunkMap();
+
+	ChunkMeshGenerator* chunkMeshGenerator = new ChunkMeshGenerator();
+	// Setting is not available without window. Use default shade mode.
+	chunkMeshGenerator->setBlockShadeMode(2);
+
+	ChunkWorkManager* chunkWorkManager = new ChunkWorkManager();
+
+	// Same as GameScene::createChunkMap, without block outline
+	auto chunkCoordinates = chunkMap->initChunkNearPlayer(glm::vec3(startingRegionSitePos.x, 0.0f, startingRegionSitePos.y), radius);
+	chunkMap->initActiveChunks();
+
+	glm::vec2 p = chunkCoordinates.front();
+	std::sort(chunkCoordinates.begin(), chunkCoordinates.end(), [p](const glm::vec2& lhs, const glm::vec2& rhs) { return glm::distance(p, lhs) < glm::distance(p, rhs); });
+
+	// Stage durations, queue waits and thread utilization. Doesn't depend on FrameProfiler being compiled in.
+	auto profiler = chunkWorkManager->getProfiler();
+	profiler->setEnabled(true);
+
+	auto start = Utility::Time::now();
+
+	for (auto xz : chunkCoordinates)
+	{
+		chunkWorkManager->addPreGenerateWork(glm::ivec2(xz));
+	}
+
+	chunkWorkManager->run();
+	chunkWorkManager->spawnThreads(chunkMap, chunkMeshGenerator, world, threadCount);
+
+	while (!chunkWorkManager->isIdle())
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	auto end = Utility::Time::now();
+
+	Result result;
+	result.profile = profiler->getSnapshot();
+
+	chunkWorkManager->stop();
+	chunkWorkManager->joinThread();
+
+	result.threadCount = threadCount;
+	result.elapsedMilliSeconds = Benchmark::toMilliSeconds(start, end);
+	result.generatedChunks = 0;
+	result.meshedChunks = 0;
+	result.expectedChunks = static_cast<unsigned int>((radius * 2 + 1) * (radius * 2 + 1));
+	result.totalVertices = 0;
+	result.totalIndices = 0;
+	result.builtTileCount = tiled ? world->getRegionTileMap()->getBuiltTileCount() : 0;
+
+	for (auto xz : chunkCoordinates)
+	{
+		auto chunk = chunkMap->getChunkAtXZ(glm::ivec2(xz));
+
+		if (chunk && chunk->isActive() && chunk->isGenerated())
+		{
+			result.generatedChunks++;
+
+			auto mesh = chunk->getMesh();
+			if (mesh && mesh->getVertexCount() > 0)
+			{
+				result.meshedChunks++;
+				result.totalVertices += mesh->getVertexCount();
+				result.totalIndices += mesh->getStagedIndexCount();
+			}
+		}
+	}
+
+	// Measure before release, while all chunks are still in memory
+	queryMemory(result.workingSet, result.peakWorkingSet);
+
+	delete chunkWorkManager;
+	delete chunkMap;
+	delete chunkMeshGenerator;
+	delete world;
+
+	return result;
+}
+
+void Voxel::WorldGenBenchmark::printProfile(const ChunkWorkProfiler::Snapshot & profile)
+{
+	for (int i = 0; i < ChunkWorkProfiler::STAGE_COUNT; i++)
+	{
+		auto& duration = profile.durations.at(i);
+		auto& wait = profile.queueWaits.at(i);
+
+		if (duration.getCount() == 0 && wait.getCount() == 0)
+		{
+			continue;
+		}
+
+		std::cout << "  " << std::left << std::setw(14) << ChunkWorkProfiler::stageToString(static_cast<ChunkWorkProfiler::Stage>(i)) << std::right
+			<< " n: " << std::setw(6) << duration.getCount()
+			<< " total: " << std::setw(7) << (duration.getTotalMicroSeconds() / 1000) << "ms"
+			<< " mean: " << std::setw(7) << static_cast<int>(duration.getMeanMicroSeconds()) << "us"
+			<< " p50: " << std::setw(7) << duration.getPercentile(0.5f) << "us"
+			<< " p90: " << std::setw(7) << duration.getPercentile(0.9f) << "us"
+			<< " p99: " << std::setw(7) << duration.getPercentile(0.99f) << "us"
+			<< " max: " << std::setw(7) << duration.getMaxMicroSeconds() << "us"
+			<< " | wait p50: " << std::setw(8) << wait.getPercentile(0.5f) << "us"
+			<< " p99: " << std::setw(8) << wait.getPercentile(0.99f) << "us\n";
+	}
+
+	std::cout << "  chunk latency p50: " << (profile.chunkLatency.getPercentile(0.5f) / 1000) << "ms"
+		<< " p99: " << (profile.chunkLatency.getPercentile(0.99f) / 1000) << "ms"
+		<< " max: " << (profile.chunkLatency.getMaxMicroSeconds() / 1000) << "ms\n";
+
+	std::cout << "  thread utilization:";
+	for (auto utilization : profile.threadUtilization)
+	{
+		std::cout << " " << static_cast<int>(utilization * 100.0f) << "%";
+	}
+	std::cout << "\n";
+}
+
+void Voxel::WorldGenBenchmark::printResult(const Result & result)
+{
+	const float seconds = result.elapsedMilliSeconds / 1000.0f;
+	const float chunksPerSecond = seconds > 0.0f ? static_cast<float>(result.generatedChunks) / seconds : 0.0f;
+	const unsigned long long averageVertices = result.meshedChunks > 0 ? result.totalVertices / result.meshedChunks : 0;
+
+	Benchmark::ResultLine("WorldGenBenchmark")
+		.add("threads", result.threadCount)
+		.add("chunks", std::to_string(result.generatedChunks) + " / " + std::to_string(result.expectedChunks))
+		.add("time", result.elapsedMilliSeconds, "ms")
+		.add("chunks/s", chunksPerSecond)
+		.print();
+
+	Benchmark::ResultLine("")
+		.add("vertices", result.totalVertices)
+		.add("indices", result.totalIndices)
+		.add("meshed chunks", result.meshedChunks)
+		.add("avg vertices per meshed chunk", averageVertices)
+		.print();
+
+	Benchmark::ResultLine memoryLine("");
+	memoryLine.add("working set", result.workingSet / (1024 * 1024), "MB")
+		.add("process peak", result.peakWorkingSet / (1024 * 1024), "MB");
+
+	if (tiled)
+	{
+		memoryLine.add("region tiles built", result.builtTileCount);
+	}
+
+	memoryLine.print();
+}
+
+void Voxel::WorldGenBenchmark::queryMemory(unsigned long long & workingSet, unsigned long long & peakWorkingSet)
+{
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+	{
+		workingSet = static_cast<unsigned long long>(counters.WorkingSetSize);
+		peakWorkingSet = static_cast<unsigned long long>(counters.PeakWorkingSetSize);
+
+		return;
+	}
+#endif
+
+	// Not available
+	workingSet = 0;
+	peakWorkingSet = 0;
+}
+
+int Voxel::WorldGenBenchmark::runFromCommandLine(const int argc, const char * argv[])
+{
+	// argv[0] is exe, argv[1] is --worldgen-bench
+	int radius = 8;
+	int maxThreadCount = static_cast<int>(std::thread::hardware_concurrency());
+
+	if (!Benchmark::parseArguments(argc, argv, { { &radius, 1 }, { &maxThreadCount, 1 } }, "[radius] [max thread count] [seed] [tiled]"))
+	{
+		return 1;
+	}
+
+	const std::string seed = (argc > 4) ? std::string(argv[4]) : "ENGINE";
+	const bool tiled = (argc > 5) && (std::string(argv[5]) == "tiled");
+
+	WorldGenBenchmark benchmark(seed, radius, tiled);
+
+	return benchmark.run(Benchmark::doublingSteps(1, maxThreadCount)) ? 0 : 1;
+}
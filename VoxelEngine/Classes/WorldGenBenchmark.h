@@ -0,0 +1,100 @@
+#ifndef WORLD_GEN_BENCHMARK_H
+#define WORLD_GEN_BENCHMARK_H
+
+// cpp
+#include <string>
+#include <vector>
+
+// voxel
+#include "ChunkWorkProfiler.h"
+
+namespace Voxel
+{
+	/**
+	*	@class WorldGenBenchmark
+	*	@brief Measures chunk generation throughput without window or OpenGL context.
+	*
+	*	Creates World from seed, initializes chunks in radius around starting region and runs ChunkWorkManager
+	*	from PRE_GENERATE to BUILD_MESH. Mesh buffers are built on CPU but never loaded to GPU.
+	*	Runs once per thread count and prints per stage latency histogram, chunks per second, memory and vertex counts.
+	*	Stage durations, queue waits and thread utilization come from ChunkWorkProfiler, so they are measured even if FrameProfiler is compiled out.
+	*
+	*	Run with: VoxelEngine.exe --worldgen-bench [radius] [max thread count] [seed] [tiled]
+	*	If last argument is "tiled", world is built with RegionTileMap instead of bounded 10 x 10 grid.
+	*	Returns non zero if any run failed to generate all active chunks, so it can be used as regression gate.
+	*/
+	class WorldGenBenchmark
+	{
+	public:
+		// Result of single run
+		struct Result
+		{
+			int threadCount;
+			// Time from first work to idle in milliseconds
+			float elapsedMilliSeconds;
+			// Number of active chunks that has been generated
+			unsigned int generatedChunks;
+			// Number of chunks that has mesh with at least 1 vertex
+			unsigned int meshedChunks;
+			// Number of chunks that should be generated
+			unsigned int expectedChunks;
+			// Total vertices and indices in all chunk meshes
+			unsigned long long totalVertices;
+			unsigned long long totalIndices;
+			// Memory in bytes. 0 if not available (Windows only).
+			unsigned long long workingSet;
+			unsigned long long peakWorkingSet;
+			// Number of region tiles built. 0 if world is bounded.
+			unsigned int builtTileCount;
+			// Stage durations, queue waits, thread utilization and chunk latency
+			ChunkWorkProfiler::Snapshot profile;
+		};
+	private:
+		// Seed for world and noise
+		std::string seed;
+
+		// Number of chunks from center chunk. Same as render distance.
+		int radius;
+
+		// True if world is tiled
+		bool tiled;
+
+		// Runs full generation once with given number of threads
+		Result runOnce(const int threadCount);
+
+		// Print per stage latency of single run
+		void printProfile(const ChunkWorkProfiler::Snapshot& profile);
+
+		// Print result of single run
+		void printResult(const Result& result);
+
+		// Get process working set and peak working set in bytes. Uses Psapi, so it's Windows only. Sets 0 on other platforms.
+		static void queryMemory(unsigned long long& workingSet, unsigned long long& peakWorkingSet);
+	public:
+		/**
+		*	Constructor
+		*	@param seed Seed for world.
+		*	@param radius Chunk radius to generate. Same as render distance.
+		*	@param tiled True to build world with RegionTileMap.
+		*/
+		WorldGenBenchmark(const std::string& seed, const int radius, const bool tiled);
+
+		// Destructor
+		~WorldGenBenchmark() = default;
+
+		/**
+		*	Runs benchmark for each thread count.
+		*	@param threadCounts Number of threads for each run.
+		*	@return true if all runs generated all active chunks.
+		*/
+		bool run(const std::vector<int>& threadCounts);
+
+		/**
+		*	Parses arguments after --worldgen-bench and runs benchmark with thread count 1, 2, 4, ... up to max.
+		*	@return Exit code for process.
+		*/
+		static int runFromCommandLine(const int argc, const char* argv[]);
+	};
+}
+
+#endif
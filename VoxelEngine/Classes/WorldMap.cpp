@@ -144,8 +144,8 @@ void Voxel::RegionMesh::renderPolygon(const glm::mat4& worldModelMat)
 	if (fillVao)
 	{
 		RegionMesh::polygonProgram->use(true);
-		RegionMesh::polygonProgram->setUniformMat4("modelMat", worldModelMat * modelMat);
-		RegionMesh::polygonProgram->setUniformVec4("color", color);
+		RegionMesh::polygonProgram->setUniformMat4(SID("modelMat"), worldModelMat * modelMat);
+		RegionMesh::polygonProgram->setUniformVec4(SID("color"), color);
 
 		glBindVertexArray(fillVao);
 		glDrawElements(GL_TRIANGLES, fillSize, GL_UNSIGNED_INT, 0);
@@ -157,8 +157,8 @@ void Voxel::RegionMesh::renderPolygonSide(const glm::mat4 & worldModelMat)
 	if (sideVao)
 	{
 		RegionMesh::sideProgram->use(true);
-		RegionMesh::sideProgram->setUniformMat4("modelMat", worldModelMat * modelMat);
-		RegionMesh::sideProgram->setUniformVec4("color", sideColor);
+		RegionMesh::sideProgram->setUniformMat4(SID("modelMat"), worldModelMat * modelMat);
+		RegionMesh::sideProgram->setUniformVec4(SID("color"), sideColor);
 
 		glBindVertexArray(sideVao);
 		glDrawElements(GL_TRIANGLES, sideSize, GL_UNSIGNED_INT, 0);
@@ -202,11 +202,11 @@ void Voxel::WorldMap::init()
 	auto& pm = ProgramManager::getInstance();
 	RegionMesh::polygonProgram = pm.getProgram(Voxel::ProgramManager::PROGRAM_NAME::POLYGON_SHADER);
 	RegionMesh::polygonProgram->use(true);
-	RegionMesh::polygonProgram->setUniformMat4("projMat", Camera::mainCamera->getProjection());
+	RegionMesh::polygonProgram->setUniformMat4(SID("projMat"), Camera::mainCamera->getProjection());
 
 	RegionMesh::sideProgram = pm.getProgram(Voxel::ProgramManager::PROGRAM_NAME::POLYGON_SIDE_SHADER);
 	RegionMesh::sideProgram->use(true);
-	RegionMesh::sideProgram->setUniformMat4("projMat", Camera::mainCamera->getProjection());
+	RegionMesh::sideProgram->setUniformMat4(SID("projMat"), Camera::mainCamera->getProjection());
 
 	resetPosAndRot();
 	
@@ -416,19 +416,19 @@ void Voxel::WorldMap::updateViewMatrix()
 	glm::mat4 viewMatrix = getViewMatrix();
 
 	RegionMesh::polygonProgram->use(true);
-	RegionMesh::polygonProgram->setUniformMat4("viewMat", viewMatrix);
+	RegionMesh::polygonProgram->setUniformMat4(SID("viewMat"), viewMatrix);
 
 	RegionMesh::sideProgram->use(true);
-	RegionMesh::sideProgram->setUniformMat4("viewMat", viewMatrix);
+	RegionMesh::sideProgram->setUniformMat4(SID("viewMat"), viewMatrix);
 }
 
 void Voxel::WorldMap::updateWithCamViewMatrix(const glm::mat4 & viewMat)
 {
 	RegionMesh::polygonProgram->use(true);
-	RegionMesh::polygonProgram->setUniformMat4("viewMat", viewMat);
+	RegionMesh::polygonProgram->setUniformMat4(SID("viewMat"), viewMat);
 
 	RegionMesh::sideProgram->use(true);
-	RegionMesh::sideProgram->setUniformMat4("viewMat", viewMat);
+	RegionMesh::sideProgram->setUniformMat4(SID("viewMat"), viewMat);
 }
 
 glm::mat4 Voxel::WorldMap::getViewMatrix()
@@ -0,0 +1,174 @@
+// pch
+#include "PreCompiled.h"
+
+#include "WorldParticleBenchmark.h"
+
+// cpp
+#include <thread>
+
+// voxel
+#include "WorldParticleSystem.h"
+#include "ChunkMap.h"
+#include "Chunk.h"
+#include "ChunkUtil.h"
+#include "ThreadPool.h"
+#include "Random.h"
+#include "Benchmark.h"
+#include "Utility.h"
+
+using namespace Voxel;
+
+Voxel::WorldParticleBenchmark::WorldParticleBenchmark(const unsigned int particleCount, const int frames)
+	: particleCount(particleCount)
+	, frames(frames)
+{}
+
+void Voxel::WorldParticleBenchmark::buildChunkMap(ChunkMap * chunkMap)
+{
+	const int radius = WorldParticleSystem::COLLISION_CHUNK_RADIUS;
+
+	for (int x = -radius; x <= radius; x++)
+	{
+		for (int z = -radius; z <= radius; z++)
+		{
+			chunkMap->generateEmptyChunk(x, z);
+			chunkMap->getChunkAtXZ(x, z)->setActive(true);
+		}
+	}
+
+	const int min = -radius * Constant::CHUNK_SECTION_WIDTH;
+	const int max = ((radius + 1) * Constant::CHUNK_SECTION_WIDTH) - 1;
+
+	for (int x = min; x <= max; x++)
+	{
+		for (int z = min; z <= max; z++)
+		{
+			// Ground
+			for (int y = 0; y < 4; y++)
+			{
+				chunkMap->placeBlockAt(glm::ivec3(x, y, z), Block::BLOCK_ID::STONE, nullptr);
+			}
+
+			// Pillar every 8 blocks
+			if (((x & 7) == 0) && ((z & 7) == 0))
+			{
+				for (int y = 4; y < 12; y++)
+				{
+					chunkMap->placeBlockAt(glm::ivec3(x, y, z), Block::BLOCK_ID::OAK_WOOD, nullptr);
+				}
+			}
+		}
+	}
+}
+
+WorldParticleBenchmark::Result Voxel::WorldParticleBenchmark::runOnce(ChunkMap * chunkMap, const int threadCount)
+{
+	WorldParticleSystem particleSystem(particleCount);
+
+	// Calling thread also works on parallelFor
+	ThreadPool threadPool(static_cast<unsigned int>(threadCount - 1));
+
+	Random random;
+
+	const glm::vec3 center(8.0f, 6.0f, 8.0f);
+	const float range = static_cast<float>(WorldParticleSystem::COLLISION_CHUNK_RADIUS * Constant::CHUNK_SECTION_WIDTH);
+	const float delta = 1.0f / 60.0f;
+
+	Result result;
+	result.threadCount = threadCount;
+	result.maxFrameMilliSeconds = 0.0f;
+
+	float totalMilliSeconds = 0;
+	unsigned long long totalParticles = 0;
+
+	for (int frame = 0; frame < frames; frame++)
+	{
+		// Top up. Not measured.
+		unsigned int i = particleSystem.getSize();
+		while (particleSystem.getSize() < particleCount)
+		{
+			const glm::vec3 position(center.x + random.randRangeFloat(-range, range), random.randRangeFloat(4.0f, 40.0f), center.z + random.randRangeFloat(-range, range));
+
+			switch (i % 4)
+			{
+			case 0:
+			case 1:
+				particleSystem.emit(WorldParticleSystem::Type::RAIN, position, glm::vec3(0.0f, -18.0f, 0.0f), 3.0f, 0.05f, glm::vec4(0.55f, 0.65f, 0.85f, 0.8f));
+				break;
+			case 2:
+				particleSystem.emit(WorldParticleSystem::Type::SNOW, position, glm::vec3(0.0f, -1.0f, 0.0f), 25.0f, 0.1f, glm::vec4(1.0f));
+				break;
+			default:
+				particleSystem.emitBlockDebris(glm::ivec3(position), glm::vec3(0.5f), (i & 4) != 0);
+				break;
+			}
+
+			i++;
+		}
+
+		auto start = Utility::Time::now();
+
+		particleSystem.update(delta, chunkMap, center, &threadPool);
+
+		auto end = Utility::Time::now();
+
+		const float milliSeconds = Benchmark::toMilliSeconds(start, end);
+
+		totalMilliSeconds += milliSeconds;
+		totalParticles += particleSystem.getInstanceCount();
+		result.maxFrameMilliSeconds = std::max(result.maxFrameMilliSeconds, milliSeconds);
+	}
+
+	result.meanFrameMilliSeconds = totalMilliSeconds / static_cast<float>(frames);
+	result.particlesPerSecond = totalMilliSeconds > 0.0f ? static_cast<float>(totalParticles) / (totalMilliSeconds / 1000.0f) : 0.0f;
+	result.meanParticles = static_cast<unsigned int>(totalParticles / frames);
+	result.memoryUsage = particleSystem.getMemoryUsage();
+
+	return result;
+}
+
+void Voxel::WorldParticleBenchmark::printResult(const Result & result)
+{
+	Benchmark::ResultLine("WorldParticleBenchmark")
+		.add("threads", result.threadCount)
+		.add("particles", result.meanParticles)
+		.add("frame mean", result.meanFrameMilliSeconds, "ms")
+		.add("max", result.maxFrameMilliSeconds, "ms")
+		.add("particles/s", static_cast<unsigned long long>(result.particlesPerSecond))
+		.add("memory", result.memoryUsage / 1024, "KB")
+		.print();
+}
+
+void Voxel::WorldParticleBenchmark::run(const std::vector<int>& threadCounts)
+{
+	std::cout << "[WorldParticleBenchmark] Particles: " << particleCount << ", frames: " << frames << "\n";
+
+	ChunkMap* chunkMap = new ChunkMap();
+
+	buildChunkMap(chunkMap);
+
+	for (auto threadCount : threadCounts)
+	{
+		printResult(runOnce(chunkMap, threadCount));
+	}
+
+	delete chunkMap;
+}
+
+int Voxel::WorldParticleBenchmark::runFromCommandLine(const int argc, const char * argv[])
+{
+	// argv[0] is exe, argv[1] is --particle-bench
+	int particleCount = 200000;
+	int maxThreadCount = static_cast<int>(std::thread::hardware_concurrency());
+	int frames = 600;
+
+	if (!Benchmark::parseArguments(argc, argv, { { &particleCount, 1 }, { &maxThreadCount, 1 }, { &frames, 1 } }, "[particle count] [max thread count] [frames]"))
+	{
+		return 1;
+	}
+
+	WorldParticleBenchmark benchmark(static_cast<unsigned int>(particleCount), frames);
+	benchmark.run(Benchmark::doublingSteps(1, maxThreadCount));
+
+	return 0;
+}
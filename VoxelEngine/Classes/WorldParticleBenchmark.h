@@ -0,0 +1,79 @@
+#ifndef WORLD_PARTICLE_BENCHMARK_H
+#define WORLD_PARTICLE_BENCHMARK_H
+
+// cpp
+#include <vector>
+
+namespace Voxel
+{
+	// foward declaration
+	class ChunkMap;
+
+	/**
+	*	@class WorldParticleBenchmark
+	*	@brief Measures WorldParticleSystem simulation throughput without window or OpenGL context.
+	*
+	*	Creates empty chunks around origin with flat ground and pillars, fills particle pool with mix of rain, snow, debris and leaves,
+	*	and runs fixed number of updates. Pool is topped up every frame so number of particles stays at target.
+	*	Runs once per thread count and prints frame time and particles per second.
+	*
+	*	Run with: VoxelEngine.exe --particle-bench [particle count] [max thread count] [frames]
+	*/
+	class WorldParticleBenchmark
+	{
+	public:
+		// Result of single run
+		struct Result
+		{
+			int threadCount;
+			// Mean and max time of single update in milliseconds
+			float meanFrameMilliSeconds;
+			float maxFrameMilliSeconds;
+			// Number of particle updates per second
+			float particlesPerSecond;
+			// Mean number of living particles
+			unsigned int meanParticles;
+			// Bytes that particle system uses
+			unsigned long long memoryUsage;
+		};
+	private:
+		// Target number of living particles
+		unsigned int particleCount;
+
+		// Number of updates per run
+		int frames;
+
+		// Creates chunks with ground and pillars for particles to collide
+		void buildChunkMap(ChunkMap* chunkMap);
+
+		// Runs simulation once with given number of threads
+		Result runOnce(ChunkMap* chunkMap, const int threadCount);
+
+		// Print result of single run
+		void printResult(const Result& result);
+	public:
+		/**
+		*	Constructor
+		*	@param particleCount Number of particles to simulate.
+		*	@param frames Number of updates per run.
+		*/
+		WorldParticleBenchmark(const unsigned int particleCount, const int frames);
+
+		// Destructor
+		~WorldParticleBenchmark() = default;
+
+		/**
+		*	Runs benchmark for each thread count.
+		*	@param threadCounts Number of threads for each run. Includes calling thread.
+		*/
+		void run(const std::vector<int>& threadCounts);
+
+		/**
+		*	Parses arguments after --particle-bench and runs benchmark with thread count 1, 2, 4, ... up to max.
+		*	@return Exit code for process.
+		*/
+		static int runFromCommandLine(const int argc, const char* argv[]);
+	};
+}
+
+#endif
@@ -0,0 +1,541 @@
+// pch
+#include "PreCompiled.h"
+
+#include "WorldParticleSystem.h"
+
+// voxel
+#include "ChunkMap.h"
+#include "Chunk.h"
+#include "ChunkSection.h"
+#include "ChunkUtil.h"
+#include "ThreadPool.h"
+#include "ProgramManager.h"
+#include "Program.h"
+
+using namespace Voxel;
+
+const int Voxel::WorldParticleSystem::COLLISION_CHUNK_RADIUS = 4;
+
+// gravity, drag, bounce, friction, sway, dieOnCollision
+const std::array<WorldParticleSystem::Behavior, static_cast<unsigned int>(WorldParticleSystem::Type::TYPE_COUNT)> Voxel::WorldParticleSystem::behaviors =
+{
+	WorldParticleSystem::Behavior{ -20.0f, 0.5f, 0.3f, 0.6f, 0.0f, false },	// DEBRIS
+	WorldParticleSystem::Behavior{ -30.0f, 0.8f, 0.0f, 0.0f, 0.0f, true },	// RAIN
+	WorldParticleSystem::Behavior{ -2.0f, 2.0f, 0.0f, 0.0f, 0.6f, true },		// SNOW
+	WorldParticleSystem::Behavior{ -3.0f, 2.5f, 0.0f, 0.0f, 1.2f, false },	// LEAF
+};
+
+Voxel::WorldParticleSystem::WorldParticleSystem(const unsigned int capacity)
+	: capacity(capacity)
+	, size(0)
+	, instanceCount(0)
+	, instanceOrigin(0.0f)
+	, collisionMinChunk(0)
+	, vao(0)
+	, vbo(0)
+	, ibo(0)
+{
+	for (auto& attribute : attributes)
+	{
+		attribute.resize(capacity, 0.0f);
+	}
+
+	colors.resize(capacity, 0);
+	types.resize(capacity, Type::DEBRIS);
+	instances.resize(capacity);
+
+	const int width = (COLLISION_CHUNK_RADIUS * 2) + 1;
+	collisionSections.resize(width * width * Constant::TOTAL_CHUNK_SECTION_PER_CHUNK, nullptr);
+}
+
+Voxel::WorldParticleSystem::~WorldParticleSystem()
+{
+	if (vbo)
+	{
+		glDeleteBuffers(1, &vbo);
+	}
+
+	if (ibo)
+	{
+		glDeleteBuffers(1, &ibo);
+	}
+
+	if (vao)
+	{
+		glDeleteVertexArrays(1, &vao);
+	}
+}
+
+void Voxel::WorldParticleSystem::initBuffers()
+{
+	auto program = ProgramManager::getInstance().getProgram(ProgramManager::PROGRAM_NAME::WORLD_PARTICLE_SHADER);
+
+	glGenVertexArrays(1, &vao);
+	glBindVertexArray(vao);
+
+	// Corners of quad. Triangle strip.
+	const std::array<float, 8> corners =
+	{
+		-0.5f, -0.5f,
+		0.5f, -0.5f,
+		-0.5f, 0.5f,
+		0.5f, 0.5f
+	};
+
+	glGenBuffers(1, &vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * corners.size(), corners.data(), GL_STATIC_DRAW);
+
+	GLint cornerLoc = program->getAttribLocation("corner");
+	glEnableVertexAttribArray(cornerLoc);
+	glVertexAttribPointer(cornerLoc, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+	glVertexAttribDivisor(cornerLoc, 0);
+
+	// Instance buffer. Allocated once with capacity.
+	glGenBuffers(1, &ibo);
+	glBindBuffer(GL_ARRAY_BUFFER, ibo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(Instance) * capacity, nullptr, GL_STREAM_DRAW);
+
+	GLint positionSizeLoc = program->getAttribLocation("positionSize");
+	glEnableVertexAttribArray(positionSizeLoc);
+	glVertexAttribPointer(positionSizeLoc, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(offsetof(Instance, positionSize)));
+	glVertexAttribDivisor(positionSizeLoc, 1);
+
+	GLint colorLoc = program->getAttribLocation("color");
+	glEnableVertexAttribArray(colorLoc);
+	glVertexAttribPointer(colorLoc, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Instance), (void*)(offsetof(Instance, color)));
+	glVertexAttribDivisor(colorLoc, 1);
+
+	glBindVertexArray(0);
+}
+
+void Voxel::WorldParticleSystem::buildCollisionGrid(ChunkMap * chunkMap, const glm::vec3 & center)
+{
+	std::fill(collisionSections.begin(), collisionSections.end(), nullptr);
+
+	if (chunkMap == nullptr)
+	{
+		return;
+	}
+
+	// Floor division. Works with negative position.
+	const int centerX = static_cast<int>(glm::floor(center.x / static_cast<float>(Constant::CHUNK_SECTION_WIDTH)));
+	const int centerZ = static_cast<int>(glm::floor(center.z / static_cast<float>(Constant::CHUNK_SECTION_LENGTH)));
+
+	collisionMinChunk = glm::ivec2(centerX - COLLISION_CHUNK_RADIUS, centerZ - COLLISION_CHUNK_RADIUS);
+
+	const int width = (COLLISION_CHUNK_RADIUS * 2) + 1;
+
+	for (int x = 0; x < width; x++)
+	{
+		for (int z = 0; z < width; z++)
+		{
+			auto chunk = chunkMap->getChunkAtXZ(collisionMinChunk.x + x, collisionMinChunk.y + z);
+
+			if (chunk == nullptr || !chunk->isActive() || !chunk->isGenerated())
+			{
+				// Can't access block that is in inactive chunk. Chunk sections of chunk that isn't generated yet can be changed by workers.
+				continue;
+			}
+
+			const int offset = ((x * width) + z) * Constant::TOTAL_CHUNK_SECTION_PER_CHUNK;
+
+			for (int y = 0; y < static_cast<int>(Constant::TOTAL_CHUNK_SECTION_PER_CHUNK); y++)
+			{
+				collisionSections[offset + y] = chunk->getChunkSectionAtY(y);
+			}
+		}
+	}
+}
+
+bool Voxel::WorldParticleSystem::isOccupied(const int x, const int y, const int z) const
+{
+	if (y < 0 || y >= Constant::HEIGHEST_BLOCK_Y)
+	{
+		return false;
+	}
+
+	const int cx = (x >= 0) ? (x / Constant::CHUNK_SECTION_WIDTH) : ((x + 1) / Constant::CHUNK_SECTION_WIDTH) - 1;
+	const int cz = (z >= 0) ? (z / Constant::CHUNK_SECTION_LENGTH) : ((z + 1) / Constant::CHUNK_SECTION_LENGTH) - 1;
+
+	const int gx = cx - collisionMinChunk.x;
+	const int gz = cz - collisionMinChunk.y;
+	const int width = (COLLISION_CHUNK_RADIUS * 2) + 1;
+
+	if (gx < 0 || gx >= width || gz < 0 || gz >= width)
+	{
+		return false;
+	}
+
+	const int cy = y / Constant::CHUNK_SECTION_HEIGHT;
+
+	const ChunkSection* chunkSection = collisionSections[(((gx * width) + gz) * Constant::TOTAL_CHUNK_SECTION_PER_CHUNK) + cy];
+
+	if (chunkSection == nullptr)
+	{
+		return false;
+	}
+
+	return chunkSection->isBlockOccupied(x - (cx * Constant::CHUNK_SECTION_WIDTH), y - (cy * Constant::CHUNK_SECTION_HEIGHT), z - (cz * Constant::CHUNK_SECTION_LENGTH));
+}
+
+void Voxel::WorldParticleSystem::simulate(const unsigned int begin, const unsigned int end, const float delta)
+{
+	float* posX = attributes[POS_X].data();
+	float* posY = attributes[POS_Y].data();
+	float* posZ = attributes[POS_Z].data();
+	float* velX = attributes[VEL_X].data();
+	float* velY = attributes[VEL_Y].data();
+	float* velZ = attributes[VEL_Z].data();
+	const float* lifeSpan = attributes[LIFE_SPAN].data();
+	float* livedTime = attributes[LIVED_TIME].data();
+	const float* phase = attributes[PHASE].data();
+
+	for (unsigned int i = begin; i < end; i++)
+	{
+		livedTime[i] += delta;
+
+		if (livedTime[i] >= lifeSpan[i] || posY[i] < 0.0f)
+		{
+			// Dead. Removed after all ranges are done.
+			livedTime[i] = lifeSpan[i];
+			continue;
+		}
+
+		const Behavior& behavior = behaviors[static_cast<unsigned int>(types[i])];
+
+		velY[i] += behavior.gravity * delta;
+
+		const float damping = glm::max(0.0f, 1.0f - (behavior.drag * delta));
+		velX[i] *= damping;
+		velY[i] *= damping;
+		velZ[i] *= damping;
+
+		// Sway doesn't accumulate to velocity
+		float swayX = 0.0f;
+		float swayZ = 0.0f;
+
+		if (behavior.sway > 0.0f)
+		{
+			const float t = (livedTime[i] * 2.0f) + phase[i];
+			swayX = glm::sin(t) * behavior.sway;
+			swayZ = glm::cos(t * 0.7f) * behavior.sway;
+		}
+
+		// Resolve each axis separately, so particle slides along block it hits.
+		const int bx = static_cast<int>(glm::floor(posX[i]));
+		const int by = static_cast<int>(glm::floor(posY[i]));
+		const int bz = static_cast<int>(glm::floor(posZ[i]));
+
+		bool collided = false;
+
+		const float newY = posY[i] + (velY[i] * delta);
+		const int nby = static_cast<int>(glm::floor(newY));
+
+		if (nby != by && isOccupied(bx, nby, bz))
+		{
+			collided = true;
+
+			if (velY[i] < 0.0f)
+			{
+				// Landed
+				velX[i] *= behavior.friction;
+				velZ[i] *= behavior.friction;
+			}
+
+			velY[i] *= -behavior.bounce;
+		}
+		else
+		{
+			posY[i] = newY;
+		}
+
+		const int curBy = static_cast<int>(glm::floor(posY[i]));
+
+		const float newX = posX[i] + ((velX[i] + swayX) * delta);
+		const int nbx = static_cast<int>(glm::floor(newX));
+
+		if (nbx != bx && isOccupied(nbx, curBy, bz))
+		{
+			collided = true;
+			velX[i] *= -behavior.bounce;
+		}
+		else
+		{
+			posX[i] = newX;
+		}
+
+		const int curBx = static_cast<int>(glm::floor(posX[i]));
+
+		const float newZ = posZ[i] + ((velZ[i] + swayZ) * delta);
+		const int nbz = static_cast<int>(glm::floor(newZ));
+
+		if (nbz != bz && isOccupied(curBx, curBy, nbz))
+		{
+			collided = true;
+			velZ[i] *= -behavior.bounce;
+		}
+		else
+		{
+			posZ[i] = newZ;
+		}
+
+		if (collided && behavior.dieOnCollision)
+		{
+			livedTime[i] = lifeSpan[i];
+		}
+	}
+}
+
+void Voxel::WorldParticleSystem::remove(const unsigned int index)
+{
+	const unsigned int last = size - 1;
+
+	if (index != last)
+	{
+		for (auto& attribute : attributes)
+		{
+			attribute[index] = attribute[last];
+		}
+
+		colors[index] = colors[last];
+		types[index] = types[last];
+	}
+
+	size--;
+}
+
+void Voxel::WorldParticleSystem::removeDead()
+{
+	const float* lifeSpan = attributes[LIFE_SPAN].data();
+	const float* livedTime = attributes[LIVED_TIME].data();
+
+	unsigned int i = 0;
+
+	while (i < size)
+	{
+		if (livedTime[i] >= lifeSpan[i])
+		{
+			// Last particle moves to i. Check i again.
+			remove(i);
+		}
+		else
+		{
+			i++;
+		}
+	}
+}
+
+void Voxel::WorldParticleSystem::buildInstances(const unsigned int begin, const unsigned int end)
+{
+	const float* posX = attributes[POS_X].data();
+	const float* posY = attributes[POS_Y].data();
+	const float* posZ = attributes[POS_Z].data();
+	const float* particleSize = attributes[SIZE].data();
+
+	for (unsigned int i = begin; i < end; i++)
+	{
+		auto& instance = instances[i];
+
+		instance.positionSize.x = posX[i] - instanceOrigin.x;
+		instance.positionSize.y = posY[i] - instanceOrigin.y;
+		instance.positionSize.z = posZ[i] - instanceOrigin.z;
+		instance.positionSize.w = particleSize[i];
+		instance.color = colors[i];
+	}
+}
+
+unsigned int Voxel::WorldParticleSystem::packColor(const glm::vec4 & color)
+{
+	const glm::uvec4 c = glm::uvec4(glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f);
+
+	// Little endian. r is first byte in memory.
+	return c.r | (c.g << 8) | (c.b << 16) | (c.a << 24);
+}
+
+bool Voxel::WorldParticleSystem::emit(const Type type, const glm::vec3 & position, const glm::vec3 & velocity, const float lifeSpan, const float size, const glm::vec4 & color)
+{
+	if (this->size >= capacity || lifeSpan <= 0.0f)
+	{
+		// Pool is full. Drop.
+		return false;
+	}
+
+	const unsigned int index = this->size;
+	this->size++;
+
+	attributes[POS_X][index] = position.x;
+	attributes[POS_Y][index] = position.y;
+	attributes[POS_Z][index] = position.z;
+	attributes[VEL_X][index] = velocity.x;
+	attributes[VEL_Y][index] = velocity.y;
+	attributes[VEL_Z][index] = velocity.z;
+	attributes[LIFE_SPAN][index] = lifeSpan;
+	attributes[LIVED_TIME][index] = 0.0f;
+	attributes[SIZE][index] = size;
+	attributes[PHASE][index] = random.randRangeFloat(0.0f, glm::two_pi<float>());
+
+	colors[index] = packColor(color);
+	types[index] = type;
+
+	return true;
+}
+
+unsigned int Voxel::WorldParticleSystem::emitBlockDebris(const glm::ivec3 & blockWorldCoordinate, const glm::vec3 & color, const bool leaves)
+{
+	const glm::vec3 blockCenter = glm::vec3(blockWorldCoordinate) + 0.5f;
+	const int count = leaves ? 6 : 16;
+
+	unsigned int emitted = 0;
+
+	for (int i = 0; i < count; i++)
+	{
+		const glm::vec3 offset(random.randRangeFloat(-0.4f, 0.4f), random.randRangeFloat(-0.4f, 0.4f), random.randRangeFloat(-0.4f, 0.4f));
+
+		// Slightly darker or brighter than block
+		const glm::vec4 debrisColor(glm::clamp(color * random.randRangeFloat(0.8f, 1.1f), 0.0f, 1.0f), 1.0f);
+
+		bool result = false;
+
+		if (leaves)
+		{
+			const glm::vec3 velocity(random.randRangeFloat(-0.5f, 0.5f), random.randRangeFloat(0.0f, 0.5f), random.randRangeFloat(-0.5f, 0.5f));
+			result = emit(Type::LEAF, blockCenter + offset, velocity, random.randRangeFloat(3.0f, 5.0f), random.randRangeFloat(0.12f, 0.2f), debrisColor);
+		}
+		else
+		{
+			// Burst out from center of block
+			const glm::vec3 velocity = (offset * 6.0f) + glm::vec3(0.0f, random.randRangeFloat(2.0f, 4.0f), 0.0f);
+			result = emit(Type::DEBRIS, blockCenter + offset, velocity, random.randRangeFloat(0.8f, 1.5f), random.randRangeFloat(0.08f, 0.15f), debrisColor);
+		}
+
+		if (result)
+		{
+			emitted++;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	return emitted;
+}
+
+void Voxel::WorldParticleSystem::update(const float delta, ChunkMap * chunkMap, const glm::vec3 & center, ThreadPool * threadPool)
+{
+	if (size == 0)
+	{
+		instanceCount = 0;
+		return;
+	}
+
+	buildCollisionGrid(chunkMap, center);
+
+	// Each range is big enough to amortize scheduling. Particles are independent, so ranges are balanced.
+	const unsigned int grainSize = 4096;
+
+	auto simulateRange = [this, delta](const unsigned int begin, const unsigned int end)
+	{
+		simulate(begin, end, delta);
+	};
+
+	if (threadPool)
+	{
+		threadPool->parallelFor(size, grainSize, simulateRange);
+	}
+	else
+	{
+		simulateRange(0, size);
+	}
+
+	// Compact on calling thread. Swap remove changes index of particles, which can't be done in parallel.
+	removeDead();
+
+	instanceOrigin = center;
+	instanceCount = size;
+
+	auto buildRange = [this](const unsigned int begin, const unsigned int end)
+	{
+		buildInstances(begin, end);
+	};
+
+	if (threadPool)
+	{
+		threadPool->parallelFor(size, grainSize, buildRange);
+	}
+	else
+	{
+		buildRange(0, size);
+	}
+}
+
+void Voxel::WorldParticleSystem::render(const glm::mat4 & viewMat, const glm::vec3 & origin)
+{
+	if (instanceCount == 0) return;
+
+	if (vao == 0)
+	{
+		initBuffers();
+	}
+
+	auto program = ProgramManager::getInstance().getProgram(ProgramManager::PROGRAM_NAME::WORLD_PARTICLE_SHADER);
+	program->use(true);
+	program->setUniformMat4(SID("viewMat"), viewMat);
+	// Instance data is relative to origin of last update. Offset is small, so no precision is lost.
+	program->setUniformVec3(SID("originOffset"), instanceOrigin - origin);
+
+	glBindVertexArray(vao);
+
+	glBindBuffer(GL_ARRAY_BUFFER, ibo);
+	// Orphan previous buffer so driver doesn't wait for previous frame to finish. Size never changes.
+	glBufferData(GL_ARRAY_BUFFER, sizeof(Instance) * capacity, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Instance) * instanceCount, &instances.front());
+
+	glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, instanceCount);
+
+	glBindVertexArray(0);
+}
+
+void Voxel::WorldParticleSystem::clear()
+{
+	size = 0;
+	instanceCount = 0;
+}
+
+const std::vector<WorldParticleSystem::Instance>& Voxel::WorldParticleSystem::getInstances() const
+{
+	return instances;
+}
+
+unsigned int Voxel::WorldParticleSystem::getInstanceCount() const
+{
+	return instanceCount;
+}
+
+unsigned int Voxel::WorldParticleSystem::getSize() const
+{
+	return size;
+}
+
+unsigned int Voxel::WorldParticleSystem::getCapacity() const
+{
+	return capacity;
+}
+
+unsigned long long Voxel::WorldParticleSystem::getMemoryUsage() const
+{
+	unsigned long long bytes = 0;
+
+	for (auto& attribute : attributes)
+	{
+		bytes += attribute.capacity() * sizeof(float);
+	}
+
+	bytes += colors.capacity() * sizeof(unsigned int);
+	bytes += types.capacity() * sizeof(Type);
+	bytes += instances.capacity() * sizeof(Instance);
+	bytes += collisionSections.capacity() * sizeof(ChunkSection*);
+
+	return bytes;
+}
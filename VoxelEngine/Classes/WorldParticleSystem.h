@@ -0,0 +1,226 @@
+#ifndef WORLD_PARTICLE_SYSTEM_H
+#define WORLD_PARTICLE_SYSTEM_H
+
+// cpp
+#include <array>
+#include <vector>
+
+// glm
+#include <glm\glm.hpp>
+
+// gl
+#include <GL\glew.h>
+
+// voxel
+#include "Random.h"
+
+namespace Voxel
+{
+	// foward declaration
+	class ChunkMap;
+	class ChunkSection;
+	class ThreadPool;
+
+	/**
+	*	@class WorldParticleSystem
+	*	@brief Particles in 3D world space. Block breaking debris, rain, snow and falling leaves.
+	*
+	*	Unlike UI::ParticleSystem, which is ui node with single emitter, this is single pool that every world effect emits to.
+	*	All memory is allocated once on construction. Particles that are emitted while pool is full are dropped.
+	*
+	*	Particles are stored as structure of arrays and simulated in ranges on thread pool.
+	*	Before simulation, chunk sections around center are copied to collision grid on calling thread,
+	*	so worker threads only read chunk section's occupancy mask and never lock chunk map.
+	*	Same as ChunkMap::raycastBlocks, do not modify chunk map while update() runs.
+	*
+	*	Simulation and building instance data doesn't need OpenGL context, so it can run headless (WorldParticleBenchmark).
+	*	Buffers are created on first render().
+	*/
+	class WorldParticleSystem
+	{
+	public:
+		enum class Type : unsigned char
+		{
+			DEBRIS = 0,		// Small cube of broken block. Bounces on blocks.
+			RAIN,			// Falls fast. Dies on block.
+			SNOW,			// Falls slow and sways. Dies on block.
+			LEAF,			// Falls slow and sways. Stays on block until life span ends.
+			TYPE_COUNT,
+		};
+
+		// How each type moves
+		struct Behavior
+		{
+			// Acceleration in y axis
+			float gravity;
+			// Ratio of velocity that is lost per second
+			float drag;
+			// Ratio of velocity that is kept when particle hits block
+			float bounce;
+			// Ratio of velocity in x and z that is kept when particle lands on block
+			float friction;
+			// Max speed of swaying in x and z
+			float sway;
+			// True if particle dies when it hits block
+			bool dieOnCollision;
+		};
+
+		// Instance data that is loaded to GPU. Position is relative to origin of last update.
+		struct Instance
+		{
+			// xyz is position, w is size
+			glm::vec4 positionSize;
+			// rgba8
+			unsigned int color;
+		};
+
+		// Number of chunks from center chunk that particle can collide with.
+		static const int COLLISION_CHUNK_RADIUS;
+	private:
+		enum Attribute : unsigned int
+		{
+			POS_X = 0,
+			POS_Y,
+			POS_Z,
+			VEL_X,
+			VEL_Y,
+			VEL_Z,
+			LIFE_SPAN,
+			LIVED_TIME,
+			SIZE,
+			PHASE,			// Random phase of sway
+			ATTRIBUTE_COUNT
+		};
+
+		// Behavior of each type
+		static const std::array<Behavior, static_cast<unsigned int>(Type::TYPE_COUNT)> behaviors;
+
+		// Attribute arrays. All array has size of capacity.
+		std::array<std::vector<float>, ATTRIBUTE_COUNT> attributes;
+		std::vector<unsigned int> colors;
+		std::vector<Type> types;
+
+		// Max number of particles
+		unsigned int capacity;
+
+		// Number of living particles. Living particles are packed in [0, size).
+		unsigned int size;
+
+		// Instance data of living particles. Built on update.
+		std::vector<Instance> instances;
+
+		// Number of instances built on last update. Particles emitted after update are drawn from next update.
+		unsigned int instanceCount;
+
+		// Position that instance data is relative to
+		glm::vec3 instanceOrigin;
+
+		// Chunk sections around center. [x][z][y] order. nullptr if section is air or chunk is inactive.
+		std::vector<ChunkSection*> collisionSections;
+
+		// Chunk coordinate of min corner of collision grid
+		glm::ivec2 collisionMinChunk;
+
+		// For emitting
+		Random random;
+
+		// gl
+		GLuint vao;
+		GLuint vbo;
+		GLuint ibo;
+
+		// Creates vao and buffers with size of capacity
+		void initBuffers();
+
+		// Copies chunk section pointers around center to collision grid
+		void buildCollisionGrid(ChunkMap* chunkMap, const glm::vec3& center);
+
+		// Check if block at world coordinate is occupied. Only reads collision grid. Out of grid is air.
+		bool isOccupied(const int x, const int y, const int z) const;
+
+		// Simulate particles in range
+		void simulate(const unsigned int begin, const unsigned int end, const float delta);
+
+		// Removes particle by moving last particle to index
+		void remove(const unsigned int index);
+
+		// Removes all particles that reached life span
+		void removeDead();
+
+		// Write instance data of particles in range
+		void buildInstances(const unsigned int begin, const unsigned int end);
+
+		// Packs color to rgba8
+		static unsigned int packColor(const glm::vec4& color);
+	public:
+		/**
+		*	Constructor. Allocates all memory.
+		*	@param capacity Max number of particles.
+		*/
+		WorldParticleSystem(const unsigned int capacity);
+
+		// Destructor. Releases buffers.
+		~WorldParticleSystem();
+
+		// Delete copy and move
+		WorldParticleSystem(WorldParticleSystem const&) = delete;
+		WorldParticleSystem& operator=(WorldParticleSystem const&) = delete;
+
+		/**
+		*	Emit single particle.
+		*	@param type Type of particle.
+		*	@param position World position.
+		*	@param velocity Initial velocity.
+		*	@param lifeSpan Life span in seconds.
+		*	@param size Size of quad in world unit.
+		*	@param color Color of particle.
+		*	@return true if emitted. False if pool is full.
+		*/
+		bool emit(const Type type, const glm::vec3& position, const glm::vec3& velocity, const float lifeSpan, const float size, const glm::vec4& color);
+
+		/**
+		*	Emit debris of broken block.
+		*	@param blockWorldCoordinate Block's world coordinate.
+		*	@param color Color of block.
+		*	@param leaves True if block is leaves. Emits falling leaves instead of debris.
+		*	@return Number of particles emitted.
+		*/
+		unsigned int emitBlockDebris(const glm::ivec3& blockWorldCoordinate, const glm::vec3& color, const bool leaves);
+
+		/**
+		*	Simulates all particles and builds instance data. Blocks until all ranges are done.
+		*	@param delta Elapsed time.
+		*	@param chunkMap Chunk map to collide. If nullptr, particles doesn't collide.
+		*	@param center Center of collision grid and origin of instance data. Usually player position.
+		*	@param threadPool Thread pool to run simulation. If nullptr, runs on calling thread.
+		*/
+		void update(const float delta, ChunkMap* chunkMap, const glm::vec3& center, ThreadPool* threadPool = nullptr);
+
+		/**
+		*	Renders all living particles as camera facing quads.
+		*	@param viewMat View matrix of camera.
+		*	@param origin Position that world is rendered relative to. Same as chunk map's render center.
+		*/
+		void render(const glm::mat4& viewMat, const glm::vec3& origin);
+
+		// Removes all particles
+		void clear();
+
+		// Get instance data of living particles. Only first getInstanceCount() are valid.
+		const std::vector<Instance>& getInstances() const;
+
+		// Get number of instances built on last update
+		unsigned int getInstanceCount() const;
+
+		// Get number of living particles
+		unsigned int getSize() const;
+
+		// Get max number of particles
+		unsigned int getCapacity() const;
+
+		// Get bytes that pool and instance data use. Doesn't change after construction.
+		unsigned long long getMemoryUsage() const;
+	};
+}
+
+#endif
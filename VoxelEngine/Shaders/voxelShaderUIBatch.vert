@@ -0,0 +1,17 @@
+#version 430
+
+layout(location = 0) in vec3 vert;
+layout(location = 1) in vec2 uvVert;
+layout(location = 2) in vec4 color;
+
+uniform mat4 projMat;
+
+out vec2 fragTexCoord;
+out vec4 vertColor;
+
+void main()
+{
+	gl_Position = projMat * vec4(vert, 1);
+	vertColor = color;
+	fragTexCoord = uvVert;
+}
\ No newline at end of file
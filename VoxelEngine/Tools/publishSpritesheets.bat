@@ -6,4 +6,5 @@
 "C:\Program Files\CodeAndWeb\TexturePacker\bin\TexturePacker.exe" "%cd%/SpriteSheets/MenuSceneUISpriteSheet.tps"
 "C:\Program Files\CodeAndWeb\TexturePacker\bin\TexturePacker.exe" "%cd%/SpriteSheets/UISpriteSheet.tps"
 "C:\Program Files\CodeAndWeb\TexturePacker\bin\TexturePacker.exe" "%cd%/SpriteSheets/ParticleSpriteSheet.tps"
-"C:\Python27\python.exe" "%cd%/Tools/jsonTrim.py"
\ No newline at end of file
+"C:\Python27\python.exe" "%cd%/Tools/jsonTrim.py"
+"%cd%/../x64/Release/VoxelEngine.exe" --cook-sprite-sheets
\ No newline at end of file
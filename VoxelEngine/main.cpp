@@ -5,6 +5,40 @@
 #include <Application.h>
 #include <FileSystem.h>
 #include <Logger.h>
+#include <Benchmark.h>
+#include <WorldGenBenchmark.h>
+#include <PhysicsBenchmark.h>
+#include <WorldParticleBenchmark.h>
+#include <ParticlePoolBenchmark.h>
+#include <VoronoiBenchmark.h>
+#include <ChunkDrawListBenchmark.h>
+#include <ChunkArenaBenchmark.h>
+#include <SpriteSheetCooker.h>
+#include <DataTreeBenchmark.h>
+#include <DataTreeCooker.h>
+#include <LogBenchmark.h>
+#include <ProfilerBenchmark.h>
+#include <UIBatchBenchmark.h>
+#include <ECSBenchmark.h>
+
+// Modes that run instead of application when flag is first argument
+static const Voxel::Benchmark::Mode headlessModes[] =
+{
+	{ "--worldgen-bench", &Voxel::WorldGenBenchmark::runFromCommandLine },		// chunk generation
+	{ "--physics-bench", &Voxel::PhysicsBenchmark::runFromCommandLine },		// fixed tick simulation and collision
+	{ "--ui-batch-bench", &Voxel::UIBatchBenchmark::runFromCommandLine },		// ui batch and draw call counts
+	{ "--particle-bench", &Voxel::WorldParticleBenchmark::runFromCommandLine },	// world particle simulation
+	{ "--ui-particle-bench", &Voxel::ParticlePoolBenchmark::runFromCommandLine },	// ui particle pool update kernel
+	{ "--voronoi-bench", &Voxel::VoronoiBenchmark::runFromCommandLine },		// voronoi world layout
+	{ "--cook-sprite-sheets", &Voxel::SpriteSheetCooker::runFromCommandLine },	// cook sprite sheets to binary files
+	{ "--drawlist-bench", &Voxel::ChunkDrawListBenchmark::runFromCommandLine },	// chunk draw list build and submit
+	{ "--arena-bench", &Voxel::ChunkArenaBenchmark::runFromCommandLine },		// chunk geometry allocator and staging
+	{ "--datatree-bench", &Voxel::DataTreeBenchmark::runFromCommandLine },		// data tree loading
+	{ "--cook-data-trees", &Voxel::DataTreeCooker::runFromCommandLine },		// compile data trees to binary files
+	{ "--log-bench", &Voxel::LogBenchmark::runFromCommandLine },				// logging from worker threads
+	{ "--profiler-bench", &Voxel::ProfilerBenchmark::runFromCommandLine },		// frame profiler overhead
+	{ "--ecs-bench", &Voxel::ECSBenchmark::runFromCommandLine },				// ecs component iteration and entity churn
+};
 
 int main(int argc, const char * argv[])
 {
@@ -36,6 +70,18 @@ int main(int argc, const char * argv[])
 	std::cout << "\n";
 #endif
 
+	// Headless modes. Doesn't create window.
+	if (argc > 1)
+	{
+		for (auto& mode : headlessModes)
+		{
+			if (std::string(argv[1]) == mode.flag)
+			{
+				return mode.entry(argc, argv);
+			}
+		}
+	}
+
 	// incase of error
 	std::string errorMsg;
 
@@ -3,6 +3,8 @@
 layout(location = 0) in vec3 vert;
 layout(location = 1) in vec4 color;
 layout(location = 2) in vec3 normal;
+// Chunk's origin relative to render center. Per draw. 0 if attribute isn't enabled.
+layout(location = 3) in vec3 chunkOrigin;
 
 uniform mat4 projMat;
 uniform mat4 viewMat;
@@ -14,8 +16,8 @@ out vec4 fragNormal;
 
 void main()
 {
-	gl_Position = projMat * viewMat * modelMat * vec4(vert, 1);
-	worldCoord = modelMat * vec4(vert, 1);
+	worldCoord = modelMat * vec4(vert + chunkOrigin, 1);
+	gl_Position = projMat * viewMat * worldCoord;
 	vertColor = color;
-	fragNormal = modelMat * vec4(normal, 1);
+	fragNormal = modelMat * vec4(normal + chunkOrigin, 1);
 }
\ No newline at end of file
@@ -0,0 +1,10 @@
+#version 430
+
+in vec4 particleColor;
+
+out vec4 fragColor;
+
+void main()
+{
+	fragColor = particleColor;
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#version 430
+
+layout(location = 0) in vec2 corner;
+layout(location = 1) in vec4 positionSize;
+layout(location = 2) in vec4 color;
+
+uniform mat4 projMat;
+uniform mat4 viewMat;
+uniform vec3 originOffset;
+
+out vec4 particleColor;
+
+void main()
+{
+	// Camera's right and up in world space. Quad always faces camera.
+	vec3 right = vec3(viewMat[0][0], viewMat[1][0], viewMat[2][0]);
+	vec3 up = vec3(viewMat[0][1], viewMat[1][1], viewMat[2][1]);
+
+	vec3 pos = positionSize.xyz + originOffset + (((right * corner.x) + (up * corner.y)) * positionSize.w);
+
+	gl_Position = projMat * viewMat * vec4(pos, 1.0f);
+
+	particleColor = color;
+}
\ No newline at end of file